@@ -173,6 +173,81 @@ static int attestation_verify_and_load_rsa_leaf_key (struct attestation_master *
 	return status;
 }
 
+/**
+ * Discard the cached leaf key for a device.
+ *
+ * @param attestation The attestation manager to utilize.
+ * @param device_num The device whose key should be discarded.
+ */
+static void attestation_invalidate_leaf_key (struct attestation_master *attestation,
+	int device_num)
+{
+	struct attestation_master_leaf_key *leaf_key;
+
+	if (device_num >= attestation->num_devices) {
+		return;
+	}
+
+	leaf_key = &attestation->leaf_key[device_num];
+	if (leaf_key->valid) {
+		if (attestation->encryption_algorithm == ATTESTATION_ECDHE_KEY_EXCHANGE) {
+			attestation->ecc->release_key_pair (attestation->ecc, NULL, &leaf_key->key.ecc);
+		}
+
+		leaf_key->valid = false;
+	}
+}
+
+/**
+ * Get the authenticated leaf key for a device certificate chain.  The certificate chain is only
+ * authenticated if there is no cached key for the current chain.
+ *
+ * @param attestation The attestation manager to utilize.
+ * @param device_num The device being attested.
+ * @param chain Certificate chain for the device.
+ * @param leaf_key Output for the authenticated leaf key.
+ *
+ * @return 0 if completed successfully or an error code.
+ */
+static int attestation_get_leaf_key (struct attestation_master *attestation, int device_num,
+	struct device_manager_cert_chain *chain, struct attestation_master_leaf_key **leaf_key)
+{
+	struct attestation_master_leaf_key *cached;
+	int status;
+
+	if (device_num >= attestation->num_devices) {
+		return ATTESTATION_INVALID_DEVICE_NUM;
+	}
+
+	cached = &attestation->leaf_key[device_num];
+	if (cached->valid && (cached->generation == chain->generation)) {
+		*leaf_key = cached;
+		return 0;
+	}
+
+	attestation_invalidate_leaf_key (attestation, device_num);
+
+	if (attestation->encryption_algorithm == ATTESTATION_ECDHE_KEY_EXCHANGE) {
+		status = attestation_verify_and_load_ecc_leaf_key (attestation, chain, &cached->key.ecc);
+	}
+	else if (attestation->encryption_algorithm == ATTESTATION_RSA_KEY_EXCHANGE) {
+		status = attestation_verify_and_load_rsa_leaf_key (attestation, chain, &cached->key.rsa);
+	}
+	else {
+		return ATTESTATION_UNSUPPORTED_ALGORITHM;
+	}
+
+	if (status != 0) {
+		return status;
+	}
+
+	cached->generation = chain->generation;
+	cached->valid = true;
+	*leaf_key = cached;
+
+	return 0;
+}
+
 /**
  * Generate digests for certificates in device certificate chain
  *
@@ -307,6 +382,10 @@ static int attestation_compare_digests (struct attestation_master *attestation,
 		}
 	}
 
+	if (status != 0) {
+		attestation_invalidate_leaf_key (attestation, device_num);
+	}
+
 	platform_free (computed_digests.digest);
 
 	return status;
@@ -337,8 +416,7 @@ static int attestation_store_certificate (struct attestation_master *attestation
 static int attestation_process_challenge_response (struct attestation_master *attestation,
 	uint8_t *buf, int buf_len, uint8_t eid)
 {
-	struct ecc_public_key ecc_key;
-	struct rsa_public_key rsa_key;
+	struct attestation_master_leaf_key *leaf_key;
 	struct device_manager_cert_chain chain;
 	uint8_t challenge[ATTESTATION_NONCE_LEN + 2];
 	uint8_t digest[SHA256_HASH_LENGTH];
@@ -397,28 +475,18 @@ static int attestation_process_challenge_response (struct attestation_master *at
 		goto hash_cancel;
 	}
 
-	if (attestation->encryption_algorithm == ATTESTATION_ECDHE_KEY_EXCHANGE) {
-		status = attestation_verify_and_load_ecc_leaf_key (attestation, &chain, &ecc_key);
-		if (status != 0) {
-			return status;
-		}
-
-		status = attestation->ecc->verify (attestation->ecc, &ecc_key, digest, SHA256_HASH_LENGTH,
-			&buf[buf_len - sig_len], sig_len);
-
-		attestation->ecc->release_key_pair (attestation->ecc, NULL, &ecc_key);
+	status = attestation_get_leaf_key (attestation, device_num, &chain, &leaf_key);
+	if (status != 0) {
+		return status;
 	}
-	else if (attestation->encryption_algorithm == ATTESTATION_RSA_KEY_EXCHANGE) {
-		status = attestation_verify_and_load_rsa_leaf_key (attestation, &chain, &rsa_key);
-		if (status != 0) {
-			return status;
-		}
 
-		status = attestation->rsa->sig_verify (attestation->rsa, &rsa_key, &buf[buf_len - sig_len],
-			sig_len, digest, SHA256_HASH_LENGTH);
+	if (attestation->encryption_algorithm == ATTESTATION_ECDHE_KEY_EXCHANGE) {
+		status = attestation->ecc->verify (attestation->ecc, &leaf_key->key.ecc, digest,
+			SHA256_HASH_LENGTH, &buf[buf_len - sig_len], sig_len);
 	}
 	else {
-		return ATTESTATION_UNSUPPORTED_ALGORITHM;
+		status = attestation->rsa->sig_verify (attestation->rsa, &leaf_key->key.rsa,
+			&buf[buf_len - sig_len], sig_len, digest, SHA256_HASH_LENGTH);
 	}
 
 	if (status == 0) {
@@ -479,6 +547,14 @@ int attestation_master_init (struct attestation_master *attestation,
 		return ATTESTATION_NO_MEMORY;
 	}
 
+	attestation->leaf_key = platform_calloc (device_manager->num_devices,
+		sizeof (struct attestation_master_leaf_key));
+	if (attestation->leaf_key == NULL) {
+		platform_free (attestation->challenge);
+		return ATTESTATION_NO_MEMORY;
+	}
+
+	attestation->num_devices = device_manager->num_devices;
 	attestation->riot = riot;
 	attestation->hash = hash;
 	attestation->ecc = ecc;
@@ -504,7 +580,14 @@ int attestation_master_init (struct attestation_master *attestation,
  */
 void attestation_master_release (struct attestation_master *attestation)
 {
+	int i_device;
+
 	if (attestation) {
+		for (i_device = 0; i_device < attestation->num_devices; ++i_device) {
+			attestation_invalidate_leaf_key (attestation, i_device);
+		}
+
+		platform_free (attestation->leaf_key);
 		platform_free (attestation->challenge);
 	}
 }
@@ -6,6 +6,7 @@
 
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "status/rot_status.h"
 #include "crypto/ecc.h"
 #include "crypto/rsa.h"
@@ -17,6 +18,18 @@
 #include "attestation.h"
 
 
+/**
+ * Authenticated public key from the leaf certificate of a device certificate chain.
+ */
+struct attestation_master_leaf_key {
+	union {
+		struct ecc_public_key ecc;						/**< Leaf key for ECC attestation. */
+		struct rsa_public_key rsa;						/**< Leaf key for RSA attestation. */
+	} key;
+	uint32_t generation;								/**< Generation of the certificate chain for the key. */
+	bool valid;											/**< Flag indicating the key has been loaded. */
+};
+
 struct attestation_master {
 	/**
 	 * Create an authentication challenge request.
@@ -81,6 +94,8 @@ struct attestation_master {
 	struct device_manager *device_manager;				/**< Device manager */
 	struct rsa_engine *rsa;								/**< The RSA engine for attestation authentication operations. */
 	struct attestation_challenge *challenge;			/**< Store challenge sent out to device. */
+	struct attestation_master_leaf_key *leaf_key;		/**< Cached leaf keys for each device. */
+	int num_devices;									/**< Number of devices with challenge and key storage. */
 	uint8_t version;									/**< Authentication protocol version. */
 	uint8_t encryption_algorithm;						/**< Encryption algorithm */
 };
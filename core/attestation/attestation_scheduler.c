@@ -0,0 +1,568 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "attestation_scheduler.h"
+#include "cmd_interface/cerberus_protocol.h"
+
+
+/**
+ * The maximum amount of time to wait between polls when there are devices waiting to be attested
+ * that could not be started due to the limit on active exchanges.
+ */
+#ifndef ATTESTATION_SCHEDULER_BLOCKED_POLL_MS
+#define	ATTESTATION_SCHEDULER_BLOCKED_POLL_MS	10
+#endif
+
+
+/**
+ * Initialize a scheduler for attesting devices.  Buses and devices must be added before any
+ * attestation will be performed.
+ *
+ * @param scheduler The scheduler to initialize.
+ * @param device_mgr The manager for the devices that will be attested.
+ * @param max_outstanding The maximum number of attestation exchanges that can be active at the
+ * same time across all buses.
+ * @param period_ms The amount of time to wait between attestations of the same device.
+ *
+ * @return 0 if the scheduler was successfully initialized or an error code.
+ */
+int attestation_scheduler_init (struct attestation_scheduler *scheduler,
+	struct device_manager *device_mgr, size_t max_outstanding, uint32_t period_ms)
+{
+	if ((scheduler == NULL) || (device_mgr == NULL) || (max_outstanding == 0)) {
+		return ATTESTATION_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	memset (scheduler, 0, sizeof (struct attestation_scheduler));
+
+	scheduler->device_mgr = device_mgr;
+	scheduler->max_outstanding = max_outstanding;
+	scheduler->period_ms = period_ms;
+
+	return platform_mutex_init (&scheduler->lock);
+}
+
+/**
+ * Release the resources used by an attestation scheduler.
+ *
+ * @param scheduler The scheduler to release.
+ */
+void attestation_scheduler_release (struct attestation_scheduler *scheduler)
+{
+	if (scheduler) {
+		platform_mutex_free (&scheduler->lock);
+	}
+}
+
+/**
+ * Add a bus that will be used to communicate with devices being attested.  Responses received on
+ * the bus must be reported to the scheduler.
+ *
+ * Requests are sent while holding the channel lock, so the channel and MCTP handler can be shared
+ * with the task that processes packets received on the bus.
+ *
+ * @param scheduler The scheduler to update.
+ * @param channel The command channel for the bus.
+ * @param mctp The MCTP handler for the channel.
+ *
+ * @return The identifier for the bus or an error code.  Use ROT_IS_ERROR to check the status.
+ */
+int attestation_scheduler_add_bus (struct attestation_scheduler *scheduler,
+	struct cmd_channel *channel, struct mctp_interface *mctp)
+{
+	struct attestation_scheduler_bus *bus;
+	int status;
+
+	if ((scheduler == NULL) || (channel == NULL) || (mctp == NULL)) {
+		return ATTESTATION_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&scheduler->lock);
+
+	if (scheduler->num_buses == ATTESTATION_SCHEDULER_MAX_BUSES) {
+		status = ATTESTATION_SCHEDULER_FULL;
+		goto exit;
+	}
+
+	bus = &scheduler->bus[scheduler->num_buses];
+	bus->channel = channel;
+	bus->mctp = mctp;
+	bus->active = false;
+
+	status = scheduler->num_buses++;
+
+exit:
+	platform_mutex_unlock (&scheduler->lock);
+	return status;
+}
+
+/**
+ * Find the attestation state for a device.
+ *
+ * @param scheduler The scheduler to query.
+ * @param device_num The device manager entry for the device.
+ *
+ * @return The attestation state or null if the device is not being attested.
+ */
+static struct attestation_scheduler_device* attestation_scheduler_find_device (
+	struct attestation_scheduler *scheduler, int device_num)
+{
+	size_t i;
+
+	for (i = 0; i < scheduler->num_devices; i++) {
+		if (scheduler->device[i].device_num == device_num) {
+			return &scheduler->device[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Add a device to be periodically attested.  The first attestation of the device will be started
+ * on the next poll of the scheduler.
+ *
+ * @param scheduler The scheduler to update.
+ * @param device_num The device manager entry for the device.
+ * @param bus The bus used to communicate with the device.
+ *
+ * @return 0 if the device was added or an error code.
+ */
+int attestation_scheduler_add_device (struct attestation_scheduler *scheduler, int device_num,
+	int bus)
+{
+	struct attestation_scheduler_device *device;
+	int status;
+
+	if ((scheduler == NULL) || (bus < 0)) {
+		return ATTESTATION_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	status = device_manager_get_device_eid (scheduler->device_mgr, device_num);
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+
+	platform_mutex_lock (&scheduler->lock);
+
+	if ((size_t) bus >= scheduler->num_buses) {
+		status = ATTESTATION_SCHEDULER_UNKNOWN_BUS;
+		goto exit;
+	}
+
+	if (attestation_scheduler_find_device (scheduler, device_num) != NULL) {
+		status = ATTESTATION_SCHEDULER_DUPLICATE_DEVICE;
+		goto exit;
+	}
+
+	if (scheduler->num_devices == ATTESTATION_SCHEDULER_MAX_DEVICES) {
+		status = ATTESTATION_SCHEDULER_FULL;
+		goto exit;
+	}
+
+	device = &scheduler->device[scheduler->num_devices];
+	memset (device, 0, sizeof (struct attestation_scheduler_device));
+
+	device->device_num = device_num;
+	device->bus = bus;
+	device->last_status = ATTESTATION_SCHEDULER_NOT_ATTESTED;
+
+	status = platform_init_timeout (0, &device->deadline);
+	if (status == 0) {
+		scheduler->num_devices++;
+	}
+
+exit:
+	platform_mutex_unlock (&scheduler->lock);
+	return status;
+}
+
+/**
+ * Trigger attestation of all devices that do not have an active exchange.  The exchanges will be
+ * started on the next poll of the scheduler.
+ *
+ * @param scheduler The scheduler to update.
+ *
+ * @return 0 if attestation was triggered or an error code.
+ */
+int attestation_scheduler_attest_all (struct attestation_scheduler *scheduler)
+{
+	size_t i;
+	int status = 0;
+
+	if (scheduler == NULL) {
+		return ATTESTATION_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&scheduler->lock);
+
+	for (i = 0; (i < scheduler->num_devices) && (status == 0); i++) {
+		if (!scheduler->device[i].active) {
+			scheduler->device[i].retries = 0;
+			status = platform_init_timeout (0, &scheduler->device[i].deadline);
+		}
+	}
+
+	platform_mutex_unlock (&scheduler->lock);
+	return status;
+}
+
+/**
+ * Complete the active attestation exchange for a device.  Failed attestations will be restarted on
+ * the next poll unless the device has exhausted its retries.  The scheduler lock must be held.
+ *
+ * @param scheduler The scheduler being updated.
+ * @param device The device that completed an exchange.
+ * @param result The result of the exchange.
+ */
+static void attestation_scheduler_finish (struct attestation_scheduler *scheduler,
+	struct attestation_scheduler_device *device, int result)
+{
+	if (device->active) {
+		device->active = false;
+		scheduler->bus[device->bus].active = false;
+		scheduler->outstanding--;
+	}
+
+	if ((result != 0) && (device->retries < ATTESTATION_SCHEDULER_MAX_RETRIES)) {
+		device->retries++;
+		platform_init_timeout (0, &device->deadline);
+		return;
+	}
+
+	if (result != 0) {
+		device_manager_update_device_state (scheduler->device_mgr, device->device_num,
+			DEVICE_MANAGER_AVAILABLE);
+	}
+
+	device->last_status = result;
+	device->retries = 0;
+	platform_init_timeout (scheduler->period_ms, &device->deadline);
+}
+
+/**
+ * Mark an attestation exchange with a device as active.  The scheduler lock must be held.
+ *
+ * @param scheduler The scheduler being updated.
+ * @param device The device to attest.
+ *
+ * @return 0 if the exchange was marked active or an error code.
+ */
+static int attestation_scheduler_activate (struct attestation_scheduler *scheduler,
+	struct attestation_scheduler_device *device)
+{
+	int status;
+
+	status = platform_init_timeout (
+		device_manager_get_reponse_timeout (scheduler->device_mgr, device->device_num),
+		&device->deadline);
+	if (status != 0) {
+		return status;
+	}
+
+	/* Mark the exchange active before sending the request since the response can be processed
+	 * as soon as the request is sent. */
+	device->active = true;
+	scheduler->bus[device->bus].active = true;
+	scheduler->outstanding++;
+
+	return 0;
+}
+
+/**
+ * Send the request that starts an attestation exchange with a device.  The scheduler lock must not
+ * be held, since the channel lock is held while responses are reported to the scheduler.
+ *
+ * @param scheduler The scheduler being updated.
+ * @param device The device to attest.
+ *
+ * @return 0 if the request was sent or an error code.
+ */
+static int attestation_scheduler_start (struct attestation_scheduler *scheduler,
+	struct attestation_scheduler_device *device)
+{
+	struct attestation_scheduler_bus *bus = &scheduler->bus[device->bus];
+	struct cmd_packet packet;
+	int src_addr;
+	int src_eid;
+	int dest_addr;
+	int dest_eid;
+	int status;
+
+	src_addr = device_manager_get_device_addr (scheduler->device_mgr, 0);
+	if (ROT_IS_ERROR (src_addr)) {
+		return src_addr;
+	}
+
+	src_eid = device_manager_get_device_eid (scheduler->device_mgr, 0);
+	if (ROT_IS_ERROR (src_eid)) {
+		return src_eid;
+	}
+
+	dest_addr = device_manager_get_device_addr (scheduler->device_mgr, device->device_num);
+	if (ROT_IS_ERROR (dest_addr)) {
+		return dest_addr;
+	}
+
+	dest_eid = device_manager_get_device_eid (scheduler->device_mgr, device->device_num);
+	if (ROT_IS_ERROR (dest_eid)) {
+		return dest_eid;
+	}
+
+	memset (&packet, 0, sizeof (packet));
+
+	/* The MCTP handler message tag and the channel are also used by the task processing received
+	 * packets, so the request must be generated and sent under the channel lock. */
+	platform_mutex_lock (&bus->channel->lock);
+
+	status = mctp_interface_issue_request (bus->mctp, dest_addr, dest_eid, src_addr, src_eid,
+		CERBERUS_PROTOCOL_GET_DIGEST, NULL, packet.data, sizeof (packet.data),
+		MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF);
+	if (ROT_IS_ERROR (status)) {
+		goto exit;
+	}
+
+	packet.pkt_size = status;
+	packet.dest_addr = dest_addr;
+	packet.state = CMD_VALID_PACKET;
+
+	status = bus->channel->send_packet (bus->channel, &packet);
+	if (status == 0) {
+		cmd_channel_increment_counter (bus->channel, &bus->channel->stats.tx_packets);
+	}
+	else {
+		cmd_channel_increment_counter (bus->channel, &bus->channel->stats.tx_errors);
+	}
+
+exit:
+	platform_mutex_unlock (&bus->channel->lock);
+	return status;
+}
+
+/**
+ * Get the amount of time remaining before a device needs to be checked again.
+ *
+ * @param device The device to check.
+ * @param now The current time.
+ *
+ * @return The remaining time, in milliseconds.
+ */
+static uint32_t attestation_scheduler_get_remaining (struct attestation_scheduler_device *device,
+	platform_clock *now)
+{
+	if (platform_has_timeout_expired (&device->deadline) == 1) {
+		return 0;
+	}
+
+	return platform_get_duration (now, &device->deadline);
+}
+
+/**
+ * Update the state of all device attestations.  Exchanges that have not received a response in
+ * time are failed, and new exchanges are started for any devices that are due for attestation, as
+ * long as the bus limits allow it.
+ *
+ * This should be called periodically from a single context.  Requests are sent without holding
+ * the scheduler lock, so responses can be reported while the requests are being sent.
+ *
+ * @param scheduler The scheduler to update.
+ *
+ * @return The amount of time, in milliseconds, before the scheduler needs to be polled again or an
+ * error code.  Use ROT_IS_ERROR to check the status.
+ */
+int attestation_scheduler_poll (struct attestation_scheduler *scheduler)
+{
+	struct attestation_scheduler_device *device;
+	size_t start[ATTESTATION_SCHEDULER_MAX_DEVICES];
+	size_t count = 0;
+	platform_clock now;
+	uint32_t wait;
+	uint32_t remaining;
+	bool blocked = false;
+	size_t first;
+	size_t i;
+	size_t index;
+	int status;
+
+	if (scheduler == NULL) {
+		return ATTESTATION_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&scheduler->lock);
+
+	for (i = 0; i < scheduler->num_devices; i++) {
+		device = &scheduler->device[i];
+		if (device->active && (platform_has_timeout_expired (&device->deadline) == 1)) {
+			attestation_scheduler_finish (scheduler, device, ATTESTATION_SCHEDULER_TIMEOUT);
+		}
+	}
+
+	/* Start checking from the device after the last one that was started so every device gets a
+	 * chance to run when the limits don't allow all due devices to be started at once. */
+	first = scheduler->next;
+	for (i = 0; i < scheduler->num_devices; i++) {
+		index = (first + i) % scheduler->num_devices;
+		device = &scheduler->device[index];
+
+		if (device->active || (platform_has_timeout_expired (&device->deadline) != 1)) {
+			continue;
+		}
+
+		if ((scheduler->outstanding >= scheduler->max_outstanding) ||
+			scheduler->bus[device->bus].active) {
+			blocked = true;
+			continue;
+		}
+
+		status = attestation_scheduler_activate (scheduler, device);
+		if (status == 0) {
+			start[count++] = index;
+		}
+		else {
+			attestation_scheduler_finish (scheduler, device, status);
+		}
+
+		scheduler->next = index + 1;
+	}
+
+	platform_mutex_unlock (&scheduler->lock);
+
+	/* Only this context starts exchanges, so the devices being started cannot be modified until
+	 * their requests have been sent. */
+	for (i = 0; i < count; i++) {
+		device = &scheduler->device[start[i]];
+
+		status = attestation_scheduler_start (scheduler, device);
+		if (status != 0) {
+			platform_mutex_lock (&scheduler->lock);
+			attestation_scheduler_finish (scheduler, device, status);
+			platform_mutex_unlock (&scheduler->lock);
+		}
+	}
+
+	platform_mutex_lock (&scheduler->lock);
+
+	wait = scheduler->period_ms;
+	platform_init_current_tick (&now);
+
+	for (i = 0; i < scheduler->num_devices; i++) {
+		device = &scheduler->device[i];
+
+		remaining = attestation_scheduler_get_remaining (device, &now);
+		if ((remaining != 0) || device->active) {
+			if (remaining < wait) {
+				wait = remaining;
+			}
+		}
+		else if (!blocked) {
+			/* A failed exchange was queued for an immediate retry. */
+			wait = 0;
+		}
+	}
+
+	if (blocked && (wait > ATTESTATION_SCHEDULER_BLOCKED_POLL_MS)) {
+		wait = ATTESTATION_SCHEDULER_BLOCKED_POLL_MS;
+	}
+
+	platform_mutex_unlock (&scheduler->lock);
+	return wait;
+}
+
+/**
+ * Notify the scheduler that a response for an attestation request was processed.  Responses that
+ * don't complete the exchange extend the time allowed for the device to respond to the next
+ * request in the exchange.
+ *
+ * @param scheduler The scheduler to update.
+ * @param eid The EID of the device that sent the response.
+ * @param command_id The command of the response.
+ * @param result The result of processing the response.
+ *
+ * @return 0 if the scheduler was updated or an error code.
+ */
+int attestation_scheduler_response_received (struct attestation_scheduler *scheduler,
+	uint8_t eid, uint8_t command_id, int result)
+{
+	struct attestation_scheduler_device *device;
+	int device_num;
+	int status = 0;
+
+	if (scheduler == NULL) {
+		return ATTESTATION_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	if ((command_id != CERBERUS_PROTOCOL_GET_DIGEST) &&
+		(command_id != CERBERUS_PROTOCOL_GET_CERTIFICATE) &&
+		(command_id != CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE)) {
+		return 0;
+	}
+
+	device_num = device_manager_get_device_num (scheduler->device_mgr, eid);
+	if (ROT_IS_ERROR (device_num)) {
+		return device_num;
+	}
+
+	platform_mutex_lock (&scheduler->lock);
+
+	device = attestation_scheduler_find_device (scheduler, device_num);
+	if (device == NULL) {
+		status = ATTESTATION_SCHEDULER_UNKNOWN_DEVICE;
+		goto exit;
+	}
+
+	if (!device->active) {
+		/* The exchange has already timed out, so ignore any late responses. */
+		goto exit;
+	}
+
+	if ((command_id == CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE) || ROT_IS_ERROR (result)) {
+		attestation_scheduler_finish (scheduler, device, result);
+	}
+	else {
+		/* The next request could be a challenge, so allow time for the device to sign it. */
+		status = platform_init_timeout (
+			device_manager_get_crypto_timeout (scheduler->device_mgr, device_num),
+			&device->deadline);
+	}
+
+exit:
+	platform_mutex_unlock (&scheduler->lock);
+	return status;
+}
+
+/**
+ * Get the result of the last completed attestation for a device.  Failed attempts that will still
+ * be retried are not reported.
+ *
+ * @param scheduler The scheduler to query.
+ * @param device_num The device manager entry for the device.
+ *
+ * @return 0 if the device was successfully attested, ATTESTATION_SCHEDULER_NOT_ATTESTED if no
+ * attestation has completed, or the error from the last failed attestation.
+ */
+int attestation_scheduler_get_device_status (struct attestation_scheduler *scheduler,
+	int device_num)
+{
+	struct attestation_scheduler_device *device;
+	int status;
+
+	if (scheduler == NULL) {
+		return ATTESTATION_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&scheduler->lock);
+
+	device = attestation_scheduler_find_device (scheduler, device_num);
+	if (device != NULL) {
+		status = device->last_status;
+	}
+	else {
+		status = ATTESTATION_SCHEDULER_UNKNOWN_DEVICE;
+	}
+
+	platform_mutex_unlock (&scheduler->lock);
+	return status;
+}
@@ -0,0 +1,123 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef ATTESTATION_SCHEDULER_H_
+#define ATTESTATION_SCHEDULER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "platform.h"
+#include "status/rot_status.h"
+#include "cmd_interface/cmd_channel.h"
+#include "cmd_interface/device_manager.h"
+#include "mctp/mctp_interface.h"
+
+
+/**
+ * The maximum number of buses that can be used by a single scheduler.
+ */
+#ifndef ATTESTATION_SCHEDULER_MAX_BUSES
+#define	ATTESTATION_SCHEDULER_MAX_BUSES			4
+#endif
+
+/**
+ * The maximum number of devices that can be attested by a single scheduler.
+ */
+#ifndef ATTESTATION_SCHEDULER_MAX_DEVICES
+#define	ATTESTATION_SCHEDULER_MAX_DEVICES		16
+#endif
+
+/**
+ * The number of times an attestation exchange will be restarted after a failure before the device
+ * is left unauthenticated until the next attestation period.
+ */
+#ifndef ATTESTATION_SCHEDULER_MAX_RETRIES
+#define	ATTESTATION_SCHEDULER_MAX_RETRIES		3
+#endif
+
+
+/**
+ * A bus used to communicate with devices being attested.  Only one exchange can be active on a bus
+ * at a time since the MCTP handler for the bus only has a single context for reassembling
+ * responses.
+ */
+struct attestation_scheduler_bus {
+	struct cmd_channel *channel;					/**< The channel for sending requests. */
+	struct mctp_interface *mctp;					/**< MCTP handler for requests on the bus. */
+	bool active;									/**< Flag indicating an exchange is in progress on the bus. */
+};
+
+/**
+ * Attestation state for a single device.
+ */
+struct attestation_scheduler_device {
+	int device_num;									/**< Device manager entry for the device. */
+	size_t bus;										/**< Bus used to communicate with the device. */
+	bool active;									/**< Flag indicating an exchange is in progress. */
+	int retries;									/**< Number of times the current attestation was restarted. */
+	int last_status;								/**< Result of the last completed attestation. */
+	platform_clock deadline;						/**< Response deadline for an active exchange or the
+														time of the next attestation. */
+};
+
+/**
+ * Drives attestation exchanges for multiple devices concurrently.  Each device is periodically
+ * attested by sending a Get Digests request.  The rest of the exchange is driven by the responses
+ * from the device, with the scheduler tracking the progress so that stalled or failed exchanges
+ * are retried.
+ *
+ * Devices on different buses are attested in parallel, subject to a limit on the number of
+ * exchanges that can be active across all buses.  Devices on the same bus are attested one at a
+ * time.
+ */
+struct attestation_scheduler {
+	struct device_manager *device_mgr;				/**< Manager for the devices being attested. */
+	struct attestation_scheduler_bus bus[ATTESTATION_SCHEDULER_MAX_BUSES];			/**< Buses to use for attestation. */
+	size_t num_buses;								/**< Number of buses that have been added. */
+	struct attestation_scheduler_device device[ATTESTATION_SCHEDULER_MAX_DEVICES];	/**< Devices to attest. */
+	size_t num_devices;								/**< Number of devices that have been added. */
+	size_t max_outstanding;							/**< Maximum number of concurrent exchanges. */
+	size_t outstanding;								/**< Number of exchanges currently in progress. */
+	uint32_t period_ms;								/**< Time between attestations of the same device. */
+	size_t next;									/**< Device to check first when starting exchanges. */
+	platform_mutex lock;							/**< Synchronization for attestation state. */
+};
+
+
+int attestation_scheduler_init (struct attestation_scheduler *scheduler,
+	struct device_manager *device_mgr, size_t max_outstanding, uint32_t period_ms);
+void attestation_scheduler_release (struct attestation_scheduler *scheduler);
+
+int attestation_scheduler_add_bus (struct attestation_scheduler *scheduler,
+	struct cmd_channel *channel, struct mctp_interface *mctp);
+int attestation_scheduler_add_device (struct attestation_scheduler *scheduler, int device_num,
+	int bus);
+
+int attestation_scheduler_attest_all (struct attestation_scheduler *scheduler);
+int attestation_scheduler_poll (struct attestation_scheduler *scheduler);
+int attestation_scheduler_response_received (struct attestation_scheduler *scheduler,
+	uint8_t eid, uint8_t command_id, int result);
+
+int attestation_scheduler_get_device_status (struct attestation_scheduler *scheduler,
+	int device_num);
+
+
+#define	ATTESTATION_SCHEDULER_ERROR(code)		ROT_ERROR (ROT_MODULE_ATTESTATION_SCHEDULER, code)
+
+/**
+ * Error codes that can be generated by the attestation scheduler.
+ */
+enum {
+	ATTESTATION_SCHEDULER_INVALID_ARGUMENT = ATTESTATION_SCHEDULER_ERROR (0x00),	/**< Input parameter is null or not valid. */
+	ATTESTATION_SCHEDULER_NO_MEMORY = ATTESTATION_SCHEDULER_ERROR (0x01),			/**< Memory allocation failed. */
+	ATTESTATION_SCHEDULER_FULL = ATTESTATION_SCHEDULER_ERROR (0x02),				/**< No more buses or devices can be added. */
+	ATTESTATION_SCHEDULER_UNKNOWN_BUS = ATTESTATION_SCHEDULER_ERROR (0x03),			/**< The bus has not been added to the scheduler. */
+	ATTESTATION_SCHEDULER_DUPLICATE_DEVICE = ATTESTATION_SCHEDULER_ERROR (0x04),	/**< The device is already being attested. */
+	ATTESTATION_SCHEDULER_UNKNOWN_DEVICE = ATTESTATION_SCHEDULER_ERROR (0x05),		/**< The device is not being attested. */
+	ATTESTATION_SCHEDULER_NOT_ATTESTED = ATTESTATION_SCHEDULER_ERROR (0x06),		/**< The device has not completed attestation. */
+	ATTESTATION_SCHEDULER_TIMEOUT = ATTESTATION_SCHEDULER_ERROR (0x07),				/**< The device did not respond in time. */
+};
+
+
+#endif /* ATTESTATION_SCHEDULER_H_ */
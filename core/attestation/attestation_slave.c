@@ -5,8 +5,133 @@
 #include <string.h>
 #include "platform.h"
 #include "attestation_slave.h"
+#include "common/type_cast.h"
 
 
+/**
+ * Calculate the SHA-256 digests of a list of certificates.  If certificate digests use a dedicated
+ * hash engine, all certificates are hashed together.  If they share the hash engine used for
+ * challenge responses, each certificate is hashed individually and the attestation lock is only
+ * held for each hash so a challenge does not wait for the entire list.
+ *
+ * @param attestation The attestation instance.
+ * @param certs The certificates to hash and the output buffers for each digest.
+ * @param count The number of certificates to hash.
+ *
+ * @return 0 if the digests were calculated successfully or an error code.
+ */
+static int attestation_slave_calculate_digests (struct attestation_slave *attestation,
+	const struct hash_multi_buffer *certs, size_t count)
+{
+	size_t i;
+	int status;
+
+	if (attestation->digest_hash != attestation->hash) {
+		return hash_calculate_sha256_multi (attestation->digest_hash, certs, count);
+	}
+
+	for (i = 0; i < count; i++) {
+		platform_mutex_lock (&attestation->lock);
+		status = hash_calculate_sha256_multi (attestation->hash, &certs[i], 1);
+		platform_mutex_unlock (&attestation->lock);
+
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Calculate the SHA-256 digest of a single certificate.
+ *
+ * @param attestation The attestation instance.
+ * @param data The certificate data to hash.
+ * @param length Length of the certificate data.
+ * @param digest Output for the certificate digest.
+ *
+ * @return 0 if the digest was calculated successfully or an error code.
+ */
+static int attestation_slave_calculate_digest (struct attestation_slave *attestation,
+	const uint8_t *data, size_t length, uint8_t *digest)
+{
+	struct hash_multi_buffer cert;
+
+	cert.data = data;
+	cert.length = length;
+	cert.hash = digest;
+	cert.hash_length = SHA256_HASH_LENGTH;
+
+	return attestation_slave_calculate_digests (attestation, &cert, 1);
+}
+
+/**
+ * Add a certificate to the list of certificates to hash.
+ *
+ * @param certs The list of certificates to update.
+ * @param index Index in the list for the certificate.
+ * @param data The certificate data to hash.
+ * @param length Length of the certificate data.
+ * @param digest Output for the certificate digest.
+ */
+static void attestation_slave_add_digest (struct hash_multi_buffer *certs, size_t index,
+	const uint8_t *data, size_t length, uint8_t *digest)
+{
+	certs[index].data = data;
+	certs[index].length = length;
+	certs[index].hash = digest;
+	certs[index].hash_length = SHA256_HASH_LENGTH;
+}
+
+/**
+ * Calculate the digests for the CA and Device ID certificates in the RIoT certificate chain and
+ * store them in the digest cache.  The digest lock must be held by the caller.
+ *
+ * @param attestation The attestation instance.
+ * @param root_ca The root CA certificate.  Null if there is no root CA.
+ * @param int_ca The intermediate CA certificate.  Null if there is no intermediate CA.
+ * @param keys The RIoT keys containing the Device ID certificate.
+ *
+ * @return 0 if the digests were calculated successfully or an error code.
+ */
+static int attestation_slave_hash_chain (struct attestation_slave *attestation,
+	const struct der_cert *root_ca, const struct der_cert *int_ca, const struct riot_keys *keys)
+{
+	struct attestation_slave_digest_cache *cache = &attestation->digest_cache;
+	struct hash_multi_buffer certs[ATTESTATION_SLAVE_MAX_CA_CERTS];
+	size_t count = 0;
+	int status;
+
+	cache->chain_valid = false;
+
+	if (root_ca != NULL) {
+		attestation_slave_add_digest (certs, count, root_ca->cert, root_ca->length,
+			&cache->chain[count * SHA256_HASH_LENGTH]);
+		count++;
+	}
+
+	if (int_ca != NULL) {
+		attestation_slave_add_digest (certs, count, int_ca->cert, int_ca->length,
+			&cache->chain[count * SHA256_HASH_LENGTH]);
+		count++;
+	}
+
+	attestation_slave_add_digest (certs, count, keys->devid_cert, keys->devid_cert_length,
+		&cache->chain[count * SHA256_HASH_LENGTH]);
+	count++;
+
+	status = attestation_slave_calculate_digests (attestation, certs, count);
+	if (status != 0) {
+		return status;
+	}
+
+	cache->chain_length = count * SHA256_HASH_LENGTH;
+	cache->chain_valid = true;
+
+	return 0;
+}
+
 static int attestation_slave_get_digests (struct attestation_slave *attestation, uint8_t slot_num,
 	uint8_t *buf, int buf_len, uint8_t *num_cert)
 {
@@ -14,7 +139,8 @@ static int attestation_slave_get_digests (struct attestation_slave *attestation,
 	const struct der_cert *root_ca;
 	const struct der_cert *int_ca;
 	const struct der_cert *aux_cert;
-	size_t offset = 0;
+	struct attestation_slave_digest_cache *cache;
+	size_t offset;
 	int status;
 
 	if ((attestation == NULL) || (buf == NULL) || (num_cert == NULL)) {
@@ -61,60 +187,68 @@ static int attestation_slave_get_digests (struct attestation_slave *attestation,
 		goto exit;
 	}
 
-	platform_mutex_lock (&attestation->lock);
+	cache = &attestation->digest_cache;
+	offset = SHA256_HASH_LENGTH * (*num_cert - 1);
 
-	if (root_ca != NULL) {
-		status = attestation->hash->calculate_sha256 (attestation->hash, root_ca->cert,
-			root_ca->length, buf, SHA256_HASH_LENGTH);
-		if (status != 0) {
-			goto unlock;
-		}
+	platform_mutex_lock (&attestation->digest_lock);
 
-		offset += SHA256_HASH_LENGTH;
-	}
-
-	if (int_ca != NULL) {
-		status = attestation->hash->calculate_sha256 (attestation->hash, int_ca->cert,
-			int_ca->length, &buf[offset], SHA256_HASH_LENGTH);
+	if (!cache->chain_valid || (cache->chain_length != offset)) {
+		status = attestation_slave_hash_chain (attestation, root_ca, int_ca, keys);
 		if (status != 0) {
 			goto unlock;
 		}
-
-		offset += SHA256_HASH_LENGTH;
-	}
-
-	status = attestation->hash->calculate_sha256 (attestation->hash, keys->devid_cert,
-		keys->devid_cert_length, &buf[offset], SHA256_HASH_LENGTH);
-	if (status != 0) {
-		goto unlock;
 	}
 
-	offset += SHA256_HASH_LENGTH;
+	memcpy (buf, cache->chain, offset);
 
 	switch (slot_num) {
 		case ATTESTATION_RIOT_SLOT_NUM:
-			status = attestation->hash->calculate_sha256 (attestation->hash, keys->alias_cert,
-				keys->alias_cert_length, &buf[offset], SHA256_HASH_LENGTH);
+			if (!cache->alias_valid) {
+				status = attestation_slave_calculate_digest (attestation, keys->alias_cert,
+					keys->alias_cert_length, cache->alias);
+				if (status != 0) {
+					goto unlock;
+				}
+
+				cache->alias_valid = true;
+			}
+
+			memcpy (&buf[offset], cache->alias, SHA256_HASH_LENGTH);
 			break;
 
 		case ATTESTATION_AUX_SLOT_NUM:
-			status = attestation->hash->calculate_sha256 (attestation->hash, aux_cert->cert,
-				aux_cert->length, &buf[offset], SHA256_HASH_LENGTH);
+			/* The auxiliary certificate can be replaced independently of the RIoT chain, so its
+			 * digest is not cached. */
+			status = attestation_slave_calculate_digest (attestation, aux_cert->cert,
+				aux_cert->length, &buf[offset]);
+			if (status != 0) {
+				goto unlock;
+			}
 			break;
 	}
-	if (status != 0) {
-		goto unlock;
-	}
 
 	status = offset + SHA256_HASH_LENGTH;
 
 unlock:
-	platform_mutex_unlock (&attestation->lock);
+	platform_mutex_unlock (&attestation->digest_lock);
 exit:
 	riot_key_manager_release_riot_keys (attestation->riot, keys);
 	return status;
 }
 
+static void attestation_slave_on_cert_chain_changed (struct riot_key_manager_observer *observer)
+{
+	struct attestation_slave *attestation = TO_DERIVED_TYPE (observer, struct attestation_slave,
+		riot_observer);
+
+	platform_mutex_lock (&attestation->digest_lock);
+
+	attestation->digest_cache.chain_valid = false;
+	attestation->digest_cache.alias_valid = false;
+
+	platform_mutex_unlock (&attestation->digest_lock);
+}
+
 /**
  * Get the last certificate in the specified chain.
  *
@@ -424,12 +558,24 @@ static int attestation_slave_init_common (struct attestation_slave *attestation,
 
 	status = platform_mutex_init (&attestation->lock);
 	if (status != 0) {
-		ecc->release_key_pair (ecc, &attestation->ecc_priv_key, NULL);
-		return status;
+		goto error_lock;
+	}
+
+	status = platform_mutex_init (&attestation->digest_lock);
+	if (status != 0) {
+		goto error_digest_lock;
+	}
+
+	attestation->riot_observer.on_cert_chain_changed = attestation_slave_on_cert_chain_changed;
+
+	status = riot_key_manager_add_observer (riot, &attestation->riot_observer);
+	if (status != 0) {
+		goto error_observer;
 	}
 
 	attestation->riot = riot;
 	attestation->hash = hash;
+	attestation->digest_hash = hash;
 	attestation->ecc = ecc;
 	attestation->rng = rng;
 	attestation->pcr_store = store;
@@ -439,6 +585,14 @@ static int attestation_slave_init_common (struct attestation_slave *attestation,
 	attestation->challenge_response = attestation_slave_challenge_response;
 
 	return 0;
+
+error_observer:
+	platform_mutex_free (&attestation->digest_lock);
+error_digest_lock:
+	platform_mutex_free (&attestation->lock);
+error_lock:
+	ecc->release_key_pair (ecc, &attestation->ecc_priv_key, NULL);
+	return status;
 }
 
 /**
@@ -506,6 +660,64 @@ int attestation_slave_init_no_aux (struct attestation_slave *attestation,
 	return 0;
 }
 
+/**
+ * Use a dedicated hash engine for calculating certificate digests.  By default, certificate digests
+ * share the hash engine used for challenge responses, so a digest request that needs to hash a
+ * certificate must wait for any challenge in progress.  With a dedicated engine, digest requests
+ * can be processed concurrently with challenges.
+ *
+ * This must be called before the attestation manager is used to process any requests.
+ *
+ * @param attestation Slave attestation manager to update.
+ * @param hash The hash engine to use for certificate digests.  This must not be used by any other
+ * component.
+ *
+ * @return 0 if the hash engine was set successfully or an error code.
+ */
+int attestation_slave_set_digest_hash_engine (struct attestation_slave *attestation,
+	struct hash_engine *hash)
+{
+	if ((attestation == NULL) || (hash == NULL)) {
+		return ATTESTATION_INVALID_ARGUMENT;
+	}
+
+	attestation->digest_hash = hash;
+	return 0;
+}
+
+/**
+ * Precompute signing values for challenge responses so that responding to a challenge does not
+ * need to run the expensive parts of ECDSA signature generation.  This should be called
+ * periodically when the device is otherwise idle to keep values available.
+ *
+ * @param attestation Slave attestation manager to precompute signatures for.
+ * @param count The maximum number of signatures to precompute.  Using a small value will limit
+ * how long challenge processing can be blocked by this call.
+ *
+ * @return The number of signatures that were precomputed or an error code.  Use ROT_IS_ERROR to
+ * check the return value.
+ */
+int attestation_slave_precompute_challenge_signatures (struct attestation_slave *attestation,
+	size_t count)
+{
+	int status;
+
+	if (attestation == NULL) {
+		return ATTESTATION_INVALID_ARGUMENT;
+	}
+
+	if (attestation->ecc->precompute_sign == NULL) {
+		return ATTESTATION_UNSUPPORTED_OPERATION;
+	}
+
+	platform_mutex_lock (&attestation->lock);
+	status = attestation->ecc->precompute_sign (attestation->ecc, &attestation->ecc_priv_key,
+		count);
+	platform_mutex_unlock (&attestation->lock);
+
+	return status;
+}
+
 /**
  * Release slave attestation manager
  *
@@ -514,7 +726,9 @@ int attestation_slave_init_no_aux (struct attestation_slave *attestation,
 void attestation_slave_release (struct attestation_slave *attestation)
 {
 	if (attestation) {
+		riot_key_manager_remove_observer (attestation->riot, &attestation->riot_observer);
 		attestation->ecc->release_key_pair (attestation->ecc, &attestation->ecc_priv_key, NULL);
 		platform_mutex_free (&attestation->lock);
+		platform_mutex_free (&attestation->digest_lock);
 	}
 }
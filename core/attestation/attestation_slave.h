@@ -5,6 +5,7 @@
 #define ATTESTATION_SLAVE_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "status/rot_status.h"
 #include "platform.h"
 #include "crypto/ecc.h"
@@ -17,6 +18,23 @@
 #include "attestation/attestation.h"
 
 
+/**
+ * The maximum number of CA and Device ID certificates in the RIoT certificate chain.
+ */
+#define	ATTESTATION_SLAVE_MAX_CA_CERTS		3
+
+/**
+ * Cached certificate digests.  The RIoT certificates only change when a new certificate chain is
+ * authenticated, so their digests are calculated once and reused for subsequent requests.
+ */
+struct attestation_slave_digest_cache {
+	uint8_t chain[SHA256_HASH_LENGTH * ATTESTATION_SLAVE_MAX_CA_CERTS];	/**< Digests of the CA and Device ID certificates. */
+	uint8_t alias[SHA256_HASH_LENGTH];		/**< Digest of the Alias certificate. */
+	size_t chain_length;					/**< Length of the cached chain digests. */
+	bool chain_valid;						/**< Flag indicating if the chain digests can be used. */
+	bool alias_valid;						/**< Flag indicating if the Alias digest can be used. */
+};
+
 struct attestation_slave {
 	/**
 	 * Get the digests for all certificates in the certificate chain utilized by the attestation
@@ -107,12 +125,16 @@ struct attestation_slave {
 
 	struct ecc_private_key ecc_priv_key;	/**< RIoT ECC private key. */
 	struct hash_engine *hash;				/**< The hashing engine for attestation authentication operations. */
+	struct hash_engine *digest_hash;		/**< The hashing engine for certificate digests. */
 	struct ecc_engine *ecc;					/**< The ECC engine for attestation authentication operations. */
 	struct rng_engine *rng;					/**< The RNG engine for attestation authentication operations. */
 	struct riot_key_manager *riot;			/**< The manager for RIoT keys. */
 	struct pcr_store *pcr_store;			/**< Storage for device measurements. */
 	struct aux_attestation *aux;			/**< Auxiliary attestation service handler. */
-	platform_mutex lock;					/**< Synchronization for shared handlers. */
+	struct riot_key_manager_observer riot_observer;		/**< Observer for RIoT certificate changes. */
+	struct attestation_slave_digest_cache digest_cache;	/**< Cache of certificate digests. */
+	platform_mutex lock;					/**< Synchronization for signing and the shared hash engine. */
+	platform_mutex digest_lock;				/**< Synchronization for the certificate digest cache. */
 };
 
 
@@ -125,5 +147,10 @@ int attestation_slave_init_no_aux (struct attestation_slave *attestation,
 
 void attestation_slave_release (struct attestation_slave *attestation);
 
+int attestation_slave_set_digest_hash_engine (struct attestation_slave *attestation,
+	struct hash_engine *hash);
+int attestation_slave_precompute_challenge_signatures (struct attestation_slave *attestation,
+	size_t count);
+
 
 #endif // ATTESTATION_SLAVE_H_
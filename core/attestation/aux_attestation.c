@@ -52,7 +52,7 @@ int aux_attestation_init (struct aux_attestation *aux, struct keystore *keystore
 	aux->riot = riot;
 	aux->ecc = ecc;
 
-	return 0;
+	return platform_mutex_init (&aux->key_lock);
 }
 
 /**
@@ -79,7 +79,188 @@ static void aux_attestation_free_cert (struct aux_attestation *aux)
  */
 void aux_attestation_release (struct aux_attestation *aux)
 {
-	aux_attestation_free_cert (aux);
+	if (aux) {
+		aux_attestation_free_cert (aux);
+
+		aux_attestation_disable_key_cache (aux);
+		platform_mutex_free (&aux->key_lock);
+	}
+}
+
+/**
+ * Release the loaded attestation private key.  The memory for the key will be zeroized.  The key
+ * lock must be held.
+ *
+ * @param aux The attestation handler with the key to release.
+ */
+static void aux_attestation_unload_key (struct aux_attestation *aux)
+{
+	if (aux->key_loaded) {
+		aux->rsa->release_key (aux->rsa, &aux->key);
+		riot_core_clear (&aux->key, sizeof (aux->key));
+		aux->key_loaded = false;
+	}
+}
+
+/**
+ * Load the attestation private key from the keystore.
+ *
+ * @param aux The attestation handler with the key to load.
+ * @param priv The key instance to initialize with the private key.
+ *
+ * @return 0 if the key was loaded successfully or an error code.
+ */
+static int aux_attestation_load_key (struct aux_attestation *aux, struct rsa_private_key *priv)
+{
+	uint8_t *priv_der;
+	size_t priv_length;
+	int status;
+
+	status = aux->keystore->load_key (aux->keystore, 0, &priv_der, &priv_length);
+	if (status != 0) {
+		return status;
+	}
+
+	status = aux->rsa->init_private_key (aux->rsa, priv, priv_der, priv_length);
+
+	riot_core_clear (priv_der, priv_length);
+	platform_free (priv_der);
+
+	return status;
+}
+
+/**
+ * Decrypt data with the attestation private key.  If key caching is enabled, the loaded key will
+ * be used and kept loaded after decryption.  Otherwise, the key is loaded from the keystore and
+ * released after decryption.
+ *
+ * @param aux The attestation handler to use for decryption.
+ * @param encrypted Payload to decrypt.
+ * @param len_encrypted Length of payload to decrypt.
+ * @param label Optional label to use during decryption.
+ * @param len_label Length of the optional label.
+ * @param pad_hash Algorithm used for padding generation.
+ * @param decrypted Output for the decrypted payload.
+ * @param len_decrypted Length of decrypted payload buffer.
+ *
+ * @return Decrypted payload length if the decryption was successful or an error code.
+ */
+static int aux_attestation_rsa_decrypt (struct aux_attestation *aux, const uint8_t *encrypted,
+	size_t len_encrypted, const uint8_t *label, size_t len_label, enum hash_type pad_hash,
+	uint8_t *decrypted, size_t len_decrypted)
+{
+	struct rsa_private_key priv;
+	int status;
+
+	platform_mutex_lock (&aux->key_lock);
+
+	if (!aux->cache_key) {
+		status = aux_attestation_load_key (aux, &priv);
+		if (status == 0) {
+			status = aux->rsa->decrypt (aux->rsa, &priv, encrypted, len_encrypted, label,
+				len_label, pad_hash, decrypted, len_decrypted);
+
+			aux->rsa->release_key (aux->rsa, &priv);
+		}
+
+		goto exit;
+	}
+
+	if (aux->key_loaded && (aux->key_idle_ms != 0) &&
+		(platform_has_timeout_expired (&aux->key_expiration) == 1)) {
+		aux_attestation_unload_key (aux);
+	}
+
+	if (!aux->key_loaded) {
+		status = aux_attestation_load_key (aux, &aux->key);
+		if (status != 0) {
+			goto exit;
+		}
+
+		aux->key_loaded = true;
+	}
+
+	status = aux->rsa->decrypt (aux->rsa, &aux->key, encrypted, len_encrypted, label, len_label,
+		pad_hash, decrypted, len_decrypted);
+
+	if (aux->key_idle_ms != 0) {
+		platform_init_timeout (aux->key_idle_ms, &aux->key_expiration);
+	}
+
+exit:
+	platform_mutex_unlock (&aux->key_lock);
+	return status;
+}
+
+/**
+ * Keep the attestation private key loaded after it is used so that later decryption requests,
+ * such as unsealing, don't need to load and parse the key again.
+ *
+ * @param aux The attestation handler to update.
+ * @param idle_timeout_ms The amount of time the key will be kept loaded after it was last used.
+ * Set this to 0 to keep the key loaded indefinitely.  An idle key is released the next time the
+ * key is used or aux_attestation_expire_key_cache is called.
+ *
+ * @return 0 if key caching was enabled or an error code.
+ */
+int aux_attestation_enable_key_cache (struct aux_attestation *aux, uint32_t idle_timeout_ms)
+{
+	if (aux == NULL) {
+		return AUX_ATTESTATION_INVALID_ARGUMENT;
+	}
+
+	if (aux->rsa == NULL) {
+		return AUX_ATTESTATION_UNSUPPORTED_CRYPTO;
+	}
+
+	platform_mutex_lock (&aux->key_lock);
+
+	aux->cache_key = true;
+	aux->key_idle_ms = idle_timeout_ms;
+	if (aux->key_loaded && (idle_timeout_ms != 0)) {
+		platform_init_timeout (idle_timeout_ms, &aux->key_expiration);
+	}
+
+	platform_mutex_unlock (&aux->key_lock);
+	return 0;
+}
+
+/**
+ * Stop keeping the attestation private key loaded.  If the key is currently loaded, it will be
+ * released and zeroized.
+ *
+ * @param aux The attestation handler to update.
+ */
+void aux_attestation_disable_key_cache (struct aux_attestation *aux)
+{
+	if (aux) {
+		platform_mutex_lock (&aux->key_lock);
+
+		aux_attestation_unload_key (aux);
+		aux->cache_key = false;
+
+		platform_mutex_unlock (&aux->key_lock);
+	}
+}
+
+/**
+ * Release the attestation private key if it has not been used within the idle timeout.  This
+ * should be called periodically to ensure the key does not stay loaded when it is not needed.
+ *
+ * @param aux The attestation handler to update.
+ */
+void aux_attestation_expire_key_cache (struct aux_attestation *aux)
+{
+	if (aux) {
+		platform_mutex_lock (&aux->key_lock);
+
+		if (aux->key_loaded && (aux->key_idle_ms != 0) &&
+			(platform_has_timeout_expired (&aux->key_expiration) == 1)) {
+			aux_attestation_unload_key (aux);
+		}
+
+		platform_mutex_unlock (&aux->key_lock);
+	}
 }
 
 /**
@@ -118,7 +299,14 @@ int aux_attestation_generate_key (struct aux_attestation *aux)
 		return status;
 	}
 
+	/* Any loaded key will no longer match the key in the keystore.  Hold the key lock while the
+	 * keystore is updated so the old key can't be loaded again before it has been replaced. */
+	platform_mutex_lock (&aux->key_lock);
+
 	status = aux->keystore->save_key (aux->keystore, 0, priv, length);
+	aux_attestation_unload_key (aux);
+
+	platform_mutex_unlock (&aux->key_lock);
 
 	riot_core_clear (priv, length);
 	platform_free (priv);
@@ -135,6 +323,8 @@ int aux_attestation_generate_key (struct aux_attestation *aux)
  */
 int aux_attestation_erase_key (struct aux_attestation *aux)
 {
+	int status;
+
 	if (aux == NULL) {
 		return AUX_ATTESTATION_INVALID_ARGUMENT;
 	}
@@ -148,7 +338,14 @@ int aux_attestation_erase_key (struct aux_attestation *aux)
 	 * are also only rarely used, reducing the chance of conflict. */
 	aux_attestation_free_cert (aux);
 
-	return aux->keystore->erase_key (aux->keystore, 0);
+	platform_mutex_lock (&aux->key_lock);
+
+	status = aux->keystore->erase_key (aux->keystore, 0);
+	aux_attestation_unload_key (aux);
+
+	platform_mutex_unlock (&aux->key_lock);
+
+	return status;
 }
 
 #ifdef X509_ENABLE_CREATE_CERTIFICATES
@@ -372,9 +569,6 @@ int aux_attestation_unseal (struct aux_attestation *aux, struct hash_engine *has
 	/* Get the key derivation seed. */
 	switch (seed_type) {
 		case AUX_ATTESTATION_SEED_RSA: {
-			struct rsa_private_key priv;
-			uint8_t *priv_der;
-			size_t priv_length;
 			enum hash_type padding;
 
 			if (aux->rsa == NULL) {
@@ -394,26 +588,9 @@ int aux_attestation_unseal (struct aux_attestation *aux, struct hash_engine *has
 					return AUX_ATTESTATION_BAD_SEED_PADDING;
 			}
 
-			status = aux->keystore->load_key (aux->keystore, 0, &priv_der, &priv_length);
-			if (status != 0) {
-				return status;
-			}
-
-			status = aux->rsa->init_private_key (aux->rsa, &priv, priv_der, priv_length);
-			if (status != 0) {
-				goto rsa_init_error;
-			}
-
-			secret_length = aux->rsa->decrypt (aux->rsa, &priv, seed, seed_length, NULL, 0, padding,
+			secret_length = aux_attestation_rsa_decrypt (aux, seed, seed_length, NULL, 0, padding,
 				secret, sizeof (secret));
-			if (ROT_IS_ERROR (secret_length)) {
-				status = secret_length;
-			}
-
-			aux->rsa->release_key (aux->rsa, &priv);
-rsa_init_error:
-			riot_core_clear (priv_der, priv_length);
-			platform_free (priv_der);
+			status = (ROT_IS_ERROR (secret_length)) ? secret_length : 0;
 			break;
 		}
 
@@ -596,11 +773,6 @@ int aux_attestation_decrypt (struct aux_attestation *aux, const uint8_t *encrypt
 	size_t len_encrypted, const uint8_t *label, size_t len_label, enum hash_type pad_hash,
 	uint8_t *decrypted, size_t len_decrypted)
 {
-	struct rsa_private_key priv;
-	uint8_t *priv_der;
-	size_t priv_length;
-	int status;
-
 	if ((aux == NULL) || (encrypted == NULL) || (decrypted == NULL)) {
 		return AUX_ATTESTATION_INVALID_ARGUMENT;
 	}
@@ -609,24 +781,6 @@ int aux_attestation_decrypt (struct aux_attestation *aux, const uint8_t *encrypt
 		return AUX_ATTESTATION_UNSUPPORTED_CRYPTO;
 	}
 
-	status = aux->keystore->load_key (aux->keystore, 0, &priv_der, &priv_length);
-	if (status != 0) {
-		return status;
-	}
-
-	status = aux->rsa->init_private_key (aux->rsa, &priv, priv_der, priv_length);
-	if (status != 0) {
-		goto rsa_init_error;
-	}
-
-	status = aux->rsa->decrypt (aux->rsa, &priv, encrypted, len_encrypted, label, len_label,
-		pad_hash, decrypted, len_decrypted);
-
-	aux->rsa->release_key (aux->rsa, &priv);
-
-rsa_init_error:
-	riot_core_clear (priv_der, priv_length);
-	platform_free (priv_der);
-
-	return status;
+	return aux_attestation_rsa_decrypt (aux, encrypted, len_encrypted, label, len_label, pad_hash,
+		decrypted, len_decrypted);
 }
@@ -7,6 +7,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include "platform.h"
 #include "status/rot_status.h"
 #include "keystore/keystore.h"
 #include "crypto/rsa.h"
@@ -55,6 +56,12 @@ struct aux_attestation {
 	struct ecc_engine *ecc;			/**< Interface for ECC unsealing operations. */
 	struct der_cert cert;			/**< The certificate for the attestation private key. */
 	bool is_static;					/**< Flag indicating if the certificate is in static memory. */
+	struct rsa_private_key key;		/**< The attestation private key, when kept loaded. */
+	bool key_loaded;				/**< Flag indicating the private key is currently loaded. */
+	bool cache_key;					/**< Flag indicating the private key should be kept loaded. */
+	uint32_t key_idle_ms;			/**< Time an unused private key will be kept loaded. */
+	platform_clock key_expiration;	/**< Time at which the loaded private key will be released. */
+	platform_mutex key_lock;		/**< Synchronization for the loaded private key. */
 };
 
 
@@ -65,6 +72,10 @@ void aux_attestation_release (struct aux_attestation *aux);
 int aux_attestation_generate_key (struct aux_attestation *aux);
 int aux_attestation_erase_key (struct aux_attestation *aux);
 
+int aux_attestation_enable_key_cache (struct aux_attestation *aux, uint32_t idle_timeout_ms);
+void aux_attestation_disable_key_cache (struct aux_attestation *aux);
+void aux_attestation_expire_key_cache (struct aux_attestation *aux);
+
 int aux_attestation_create_certificate (struct aux_attestation *aux, struct x509_engine *x509,
 	struct rng_engine *rng, const uint8_t *ca, size_t ca_length, const uint8_t *ca_key,
 	size_t key_length);
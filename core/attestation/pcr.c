@@ -84,6 +84,22 @@ int pcr_check_measurement_index (struct pcr_bank *pcr, uint8_t measurement_index
 	return 0;
 }
 
+/**
+ * Flag a measurement as changed so the aggregate will be updated starting from that measurement.
+ * The PCR bank lock must be held by the caller.
+ *
+ * @param pcr The PCR bank being updated.
+ * @param measurement_index The index of the measurement that changed.
+ */
+static void pcr_mark_dirty (struct pcr_bank *pcr, uint8_t measurement_index)
+{
+	if (measurement_index < pcr->dirty) {
+		pcr->dirty = measurement_index;
+	}
+
+	pcr->generation++;
+}
+
 /**
  * Update digest in PCR bank's list of measurements
  *
@@ -111,7 +127,10 @@ int pcr_update_digest (struct pcr_bank *pcr, uint8_t measurement_index, const ui
 
 	platform_mutex_lock (&pcr->lock);
 
-	memcpy (pcr->measurement_list[measurement_index].digest, digest, digest_len);
+	if (memcmp (pcr->measurement_list[measurement_index].digest, digest, digest_len) != 0) {
+		memcpy (pcr->measurement_list[measurement_index].digest, digest, digest_len);
+		pcr_mark_dirty (pcr, measurement_index);
+	}
 
 	platform_mutex_unlock (&pcr->lock);
 
@@ -168,7 +187,10 @@ int pcr_update_event_type (struct pcr_bank *pcr, uint8_t measurement_index, uint
 
 	platform_mutex_lock (&pcr->lock);
 
-	pcr->measurement_list[measurement_index].event_type = event_type;
+	if (pcr->measurement_list[measurement_index].event_type != event_type) {
+		pcr->measurement_list[measurement_index].event_type = event_type;
+		pcr->generation++;
+	}
 
 	platform_mutex_unlock (&pcr->lock);
 
@@ -176,7 +198,9 @@ int pcr_update_event_type (struct pcr_bank *pcr, uint8_t measurement_index, uint
 }
 
 /**
- * Compute aggregate of all measurements that have added to PCR bank
+ * Compute aggregate of all measurements that have added to PCR bank.  Only measurements that have
+ * changed since the last computation, and any that follow them, will be extended again.  If no
+ * measurements have changed, the previously computed aggregate is returned.
  *
  * @param pcr The PCR bank to compute aggregate measurement of
  * @param hash Hashing engine to utilize
@@ -188,7 +212,7 @@ int pcr_update_event_type (struct pcr_bank *pcr, uint8_t measurement_index, uint
 int pcr_compute (struct pcr_bank *pcr, struct hash_engine *hash, uint8_t *measurement, bool lock)
 {
 	uint8_t prev_measurement[PCR_DIGEST_LENGTH] = {0};
-	int i_measurement;
+	size_t i_measurement;
 	int status = 0;
 
 	if ((pcr == NULL) || (hash == NULL)) {
@@ -200,7 +224,12 @@ int pcr_compute (struct pcr_bank *pcr, struct hash_engine *hash, uint8_t *measur
 	}
 
 	if (!pcr->explicit) {
-		for (i_measurement = 0; i_measurement < pcr->num_measurements; ++i_measurement) {
+		if (pcr->dirty != 0) {
+			memcpy (prev_measurement, pcr->measurement_list[pcr->dirty - 1].measurement,
+				sizeof (prev_measurement));
+		}
+
+		for (i_measurement = pcr->dirty; i_measurement < pcr->num_measurements; ++i_measurement) {
 			status = hash->start_sha256 (hash);
 			if (status != 0) {
 				goto exit;
@@ -224,6 +253,7 @@ int pcr_compute (struct pcr_bank *pcr, struct hash_engine *hash, uint8_t *measur
 
 			memcpy (pcr->measurement_list[i_measurement].measurement, prev_measurement,
 				sizeof (prev_measurement));
+			pcr->dirty = i_measurement + 1;
 		}
 	}
 	else {
@@ -340,14 +370,39 @@ int pcr_invalidate_measurement_index (struct pcr_bank *pcr, uint8_t measurement_
 
 	platform_mutex_lock (&pcr->lock);
 
-	memset (pcr->measurement_list[measurement_index].digest, 0, 
+	memset (pcr->measurement_list[measurement_index].digest, 0,
 		sizeof (pcr->measurement_list[measurement_index].digest));
+	pcr_mark_dirty (pcr, measurement_index);
 
 	platform_mutex_unlock (&pcr->lock);
 
 	return 0;
 }
 
+/**
+ * Get the current generation of the measurements in the PCR bank.  The generation changes any time
+ * a measurement digest or event type is modified, so it can be used to determine if information
+ * derived from the measurements needs to be updated.
+ *
+ * @param pcr The PCR bank to query
+ *
+ * @return The current measurement generation.  This will be 0 if the PCR bank is null.
+ */
+uint32_t pcr_get_generation (struct pcr_bank *pcr)
+{
+	uint32_t generation;
+
+	if (pcr == NULL) {
+		return 0;
+	}
+
+	platform_mutex_lock (&pcr->lock);
+	generation = pcr->generation;
+	platform_mutex_unlock (&pcr->lock);
+
+	return generation;
+}
+
 /**
  * Acquire lock dedicated to PCR bank
  *
@@ -30,6 +30,8 @@ struct pcr_bank {
 	struct pcr_measurement *measurement_list;				/**< List of measurements */
 	size_t num_measurements;								/**< Number of measurements */
 	bool explicit;											/**< PCR bank contains an explicit measurement. */
+	size_t dirty;											/**< Index of the first measurement that needs to be extended. */
+	uint32_t generation;									/**< Counter incremented whenever a measurement changes. */
 	platform_mutex lock;									/**< Synchronization lock */
 };
 
@@ -51,6 +53,7 @@ int pcr_get_measurement (struct pcr_bank *pcr, uint8_t measurement_index,
 int pcr_get_all_measurements (struct pcr_bank *pcr, const uint8_t **measurement_list);
 int pcr_get_num_measurements (struct pcr_bank *pcr);
 int pcr_invalidate_measurement_index (struct pcr_bank *pcr, uint8_t measurement_index);
+uint32_t pcr_get_generation (struct pcr_bank *pcr);
 
 int pcr_lock (struct pcr_bank *pcr);
 int pcr_unlock (struct pcr_bank *pcr);
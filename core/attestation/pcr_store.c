@@ -27,6 +27,8 @@ int pcr_store_init (struct pcr_store *store, uint8_t *num_pcr_measurements, size
 		return PCR_INVALID_ARGUMENT;
 	}
 
+	memset (store, 0, sizeof (struct pcr_store));
+
 	store->banks = platform_malloc (sizeof (struct pcr_bank) * num_pcr);
 	if (store->banks == NULL) {
 		return PCR_NO_MEMORY;
@@ -37,17 +39,37 @@ int pcr_store_init (struct pcr_store *store, uint8_t *num_pcr_measurements, size
 	for (i_pcr = 0; i_pcr < num_pcr; ++i_pcr) {
 		status = pcr_init (&store->banks[i_pcr], num_pcr_measurements[i_pcr]);
 		if (status != 0) {
-			while (i_pcr > 0) {
-				--i_pcr;
-				pcr_release (&store->banks[i_pcr]);
-			}
+			goto release_banks;
+		}
 
-			platform_free (store->banks);
+		/* Banks with an explicit measurement are not reported in the log. */
+		store->log_entries += num_pcr_measurements[i_pcr];
+	}
 
-			return status;
+	if (store->log_entries != 0) {
+		store->log = platform_calloc (store->log_entries, sizeof (struct pcr_store_tcg_log_entry));
+		if (store->log == NULL) {
+			status = PCR_NO_MEMORY;
+			goto release_banks;
 		}
 	}
 
+	status = platform_mutex_init (&store->log_lock);
+	if (status != 0) {
+		platform_free (store->log);
+		goto release_banks;
+	}
+
+	return 0;
+
+release_banks:
+	while (i_pcr > 0) {
+		--i_pcr;
+		pcr_release (&store->banks[i_pcr]);
+	}
+
+	platform_free (store->banks);
+
 	return status;
 }
 
@@ -66,6 +88,8 @@ void pcr_store_release (struct pcr_store *store)
 		}
 
 		platform_free (store->banks);
+		platform_free (store->log);
+		platform_mutex_free (&store->log_lock);
 	}
 }
 
@@ -316,36 +340,53 @@ int pcr_store_get_tcg_log_size (struct pcr_store *store)
 }
 
 /**
- * Generate TCG log from PCR banks.
+ * Get the combined generation of the measurements in all PCR banks.
+ *
+ * @param store PCR store to query.
+ *
+ * @return The combined measurement generation.
+ */
+static uint32_t pcr_store_get_generation (struct pcr_store *store)
+{
+	uint32_t generation = 0;
+	size_t i_bank;
+
+	for (i_bank = 0; i_bank < store->num_pcr_banks; ++i_bank) {
+		generation += pcr_get_generation (&store->banks[i_bank]);
+	}
+
+	return generation;
+}
+
+/**
+ * Rebuild the snapshot of the TCG log if any measurements have changed since it was last
+ * generated.  The log lock must be held by the caller.
  *
  * @param store PCR store to get measurements from.
  * @param hash Hashing engine to utilize in PCR bank operations.
- * @param offset Offset within the log to start reading data.
- * @param contents Output buffer for the log contents.
- * @param length Maximum number of bytes to read from the log.
  *
- * @return The number of bytes read from the log or an error code.
+ * @return 0 if the log snapshot is current or an error code.
  */
-int pcr_store_get_tcg_log (struct pcr_store *store, struct hash_engine *hash, uint32_t offset,
-	uint8_t *contents, size_t length)
+static int pcr_store_refresh_tcg_log (struct pcr_store *store, struct hash_engine *hash)
 {
-	struct pcr_store_tcg_log_entry log_entry;
+	struct pcr_store_tcg_log_entry *log_entry;
 	const struct pcr_measurement *measurements;
-	uint32_t contents_offset = 0;
-	uint32_t entry_length;
-	uint32_t entry_offset;
+	uint32_t generation;
 	uint32_t i_entry = 0;
 	uint8_t i_bank;
-	int starting_measurement;
-	int total_log_size = 0;
 	int num_measurements;
 	int i_measurement;
 	int status;
 
-	if ((store == NULL) || (hash == NULL) || (contents == NULL)) {
-		return PCR_INVALID_ARGUMENT;
+	/* Measurements that change after the generation is sampled will trigger another refresh on
+	 * the next read. */
+	generation = pcr_store_get_generation (store);
+	if (store->log_valid && (generation == store->log_generation)) {
+		return 0;
 	}
 
+	store->log_valid = false;
+
 	for (i_bank = 0; i_bank < store->num_pcr_banks; ++i_bank) {
 		status = pcr_lock (&store->banks[i_bank]);
 		if (status != 0) {
@@ -376,64 +417,77 @@ int pcr_store_get_tcg_log (struct pcr_store *store, struct hash_engine *hash, ui
 			return num_measurements;
 		}
 
-		if (total_log_size >= offset) {
-			total_log_size += num_measurements * sizeof (struct pcr_store_tcg_log_entry);
-			starting_measurement = 0;
-			entry_offset = 0;
-		}
-		else {
-			starting_measurement = (offset - total_log_size) /
-				sizeof (struct pcr_store_tcg_log_entry);
-			entry_offset = (offset - total_log_size) - (starting_measurement) *
-				sizeof (struct pcr_store_tcg_log_entry);
-			total_log_size += num_measurements * sizeof (struct pcr_store_tcg_log_entry);
-
-			if (total_log_size <= offset) {
-				i_entry += num_measurements;
-				pcr_unlock (&store->banks[i_bank]);
-				continue;
-			}
-
-			i_entry += starting_measurement;
-		}
+		for (i_measurement = 0; i_measurement < num_measurements; ++i_measurement, ++i_entry) {
+			log_entry = &store->log[i_entry];
 
-		for (i_measurement = 0; i_measurement < num_measurements; ++i_measurement) {
-			if (i_measurement < starting_measurement) {
-				continue;
-			}
+			log_entry->header.log_magic = LOGGING_MAGIC_START;
+			log_entry->header.length = sizeof (struct pcr_store_tcg_log_entry);
+			log_entry->header.entry_id = i_entry;
 
-			log_entry.header.log_magic = LOGGING_MAGIC_START;
-			log_entry.header.length = sizeof (struct pcr_store_tcg_log_entry);
-			log_entry.header.entry_id = i_entry++;
+			log_entry->entry.digest_algorithm_id = 0x0B;
+			log_entry->entry.digest_count = 1;
+			log_entry->entry.event_type = measurements[i_measurement].event_type;
+			log_entry->entry.measurement_type = PCR_MEASUREMENT (i_bank, i_measurement);
+			log_entry->entry.measurement_size = sizeof (measurements[i_measurement].digest);
 
-			log_entry.entry.digest_algorithm_id = 0x0B;
-			log_entry.entry.digest_count = 1;
-			log_entry.entry.event_type = measurements[i_measurement].event_type;
-			log_entry.entry.measurement_type = PCR_MEASUREMENT (i_bank, i_measurement);
-			log_entry.entry.measurement_size = sizeof (measurements[i_measurement].digest);
-
-			memcpy (log_entry.entry.digest, measurements[i_measurement].digest,
+			memcpy (log_entry->entry.digest, measurements[i_measurement].digest,
 				sizeof (measurements[i_measurement].digest));
-			memcpy (log_entry.entry.measurement, measurements[i_measurement].measurement,
+			memcpy (log_entry->entry.measurement, measurements[i_measurement].measurement,
 				sizeof (measurements[i_measurement].measurement));
+		}
 
-			entry_length = min (length - contents_offset,
-				sizeof (struct pcr_store_tcg_log_entry) - entry_offset);
+		pcr_unlock (&store->banks[i_bank]);
+	}
 
-			memcpy (&contents[contents_offset], ((uint8_t*) &log_entry) + entry_offset,
-				entry_length);
+	store->log_generation = generation;
+	store->log_valid = true;
 
-			contents_offset += entry_length;
-			if (contents_offset >= length) {
-				pcr_unlock (&store->banks[i_bank]);
-				return contents_offset;
-			}
+	return 0;
+}
 
-			entry_offset = 0;
-		}
+/**
+ * Read the TCG log for the PCR banks.
+ *
+ * The log is served from a snapshot of the measurements.  The snapshot is only regenerated when
+ * measurements have changed since the last read, so reading the log in multiple chunks does not
+ * require accessing the PCR banks for each chunk.
+ *
+ * @param store PCR store to get measurements from.
+ * @param hash Hashing engine to utilize in PCR bank operations.
+ * @param offset Offset within the log to start reading data.
+ * @param contents Output buffer for the log contents.
+ * @param length Maximum number of bytes to read from the log.
+ *
+ * @return The number of bytes read from the log or an error code.
+ */
+int pcr_store_get_tcg_log (struct pcr_store *store, struct hash_engine *hash, uint32_t offset,
+	uint8_t *contents, size_t length)
+{
+	size_t log_size;
+	int status;
 
-		pcr_unlock (&store->banks[i_bank]);
+	if ((store == NULL) || (hash == NULL) || (contents == NULL)) {
+		return PCR_INVALID_ARGUMENT;
 	}
 
-	return contents_offset;
+	platform_mutex_lock (&store->log_lock);
+
+	status = pcr_store_refresh_tcg_log (store, hash);
+	if (status != 0) {
+		goto exit;
+	}
+
+	log_size = store->log_entries * sizeof (struct pcr_store_tcg_log_entry);
+	if (offset >= log_size) {
+		status = 0;
+		goto exit;
+	}
+
+	length = min (length, log_size - offset);
+	memcpy (contents, ((uint8_t*) store->log) + offset, length);
+	status = length;
+
+exit:
+	platform_mutex_unlock (&store->log_lock);
+	return status;
 }
@@ -6,6 +6,8 @@
 
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "platform.h"
 #include "crypto/hash.h"
 #include "logging/logging.h"
 #include "pcr.h"
@@ -14,14 +16,6 @@
 #define	PCR_MEASUREMENT(bank, index)			((bank) << 8 | (index))
 
 
-/**
- * Container for PCR banks
- */
-struct pcr_store {
-	struct pcr_bank *banks;						/**< PCR banks */
-	size_t num_pcr_banks;						/**< Number of PCR banks */
-};
-
 #pragma pack(push, 1)
 
 /**
@@ -50,6 +44,20 @@ struct pcr_store_tcg_log_entry {
 #pragma pack(pop)
 
 
+/**
+ * Container for PCR banks
+ */
+struct pcr_store {
+	struct pcr_bank *banks;						/**< PCR banks */
+	size_t num_pcr_banks;						/**< Number of PCR banks */
+	struct pcr_store_tcg_log_entry *log;		/**< Snapshot of the TCG log entries. */
+	size_t log_entries;							/**< Number of entries in the TCG log. */
+	uint32_t log_generation;					/**< Measurement generation of the log snapshot. */
+	bool log_valid;								/**< Flag indicating the log snapshot is valid. */
+	platform_mutex log_lock;					/**< Synchronization for the log snapshot. */
+};
+
+
 int pcr_store_init (struct pcr_store *store, uint8_t *num_pcr_measurements, size_t num_pcr);
 void pcr_store_release (struct pcr_store *store);
 
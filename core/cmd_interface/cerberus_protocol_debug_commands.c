@@ -28,6 +28,41 @@ int cerberus_protocol_debug_fill_log (struct cmd_background *background,
 	return background->debug_log_fill (background);
 }
 
+/**
+ * Process read trace packet
+ *
+ * @param request Read trace request to process
+ *
+ * @return 0 if request processing completed successfully or an error code.
+ */
+int cerberus_protocol_debug_read_trace (struct cmd_interface_request *request)
+{
+	struct cerberus_protocol_debug_read_trace *rq =
+		(struct cerberus_protocol_debug_read_trace*) request->data;
+	struct cerberus_protocol_debug_read_trace_response *rsp =
+		(struct cerberus_protocol_debug_read_trace_response*) request->data;
+	struct trace_buffer *trace;
+	int count;
+
+	if (request->length != sizeof (struct cerberus_protocol_debug_read_trace)) {
+		return CMD_HANDLER_BAD_LENGTH;
+	}
+
+	trace = trace_buffer_get_core (rq->core);
+	if (trace == NULL) {
+		return CMD_HANDLER_UNSUPPORTED_INDEX;
+	}
+
+	count = trace_buffer_read (trace, rq->offset, cerberus_protocol_debug_trace_records (rsp),
+		CERBERUS_PROTOCOL_MAX_TRACE_RECORDS (request));
+	if (ROT_IS_ERROR (count)) {
+		return count;
+	}
+
+	request->length = cerberus_protocol_debug_read_trace_response_length (count);
+	return 0;
+}
+
 /**
  * Process get device certificate packet
  *
@@ -9,6 +9,7 @@
 #include "cmd_interface/device_manager.h"
 #include "attestation/attestation_master.h"
 #include "crypto/hash.h"
+#include "logging/trace_buffer.h"
 
 
 /**
@@ -19,11 +20,52 @@
 
 #pragma pack(push, 1)
 /* TODO: Define command formats for all debug commands. */
+
+/**
+ * Cerberus protocol debug read trace request format
+ */
+struct cerberus_protocol_debug_read_trace {
+	struct cerberus_protocol_header header;					/**< Message header */
+	uint8_t core;											/**< Core to read trace records for */
+	uint32_t offset;										/**< Number of records to skip */
+};
+
+/**
+ * Cerberus protocol debug read trace response format
+ */
+struct cerberus_protocol_debug_read_trace_response {
+	struct cerberus_protocol_header header;					/**< Message header */
+};
+
+/**
+ * Get the buffer containing the retrieved trace records
+ */
+#define	cerberus_protocol_debug_trace_records(resp)	\
+	((struct trace_record*) (((uint8_t*) resp) + sizeof (*resp)))
+
+/**
+ * Get the total message length for a debug read trace response message.
+ *
+ * @param count The number of trace records in the response.
+ */
+#define	cerberus_protocol_debug_read_trace_response_length(count)	\
+	((count * sizeof (struct trace_record)) + \
+		sizeof (struct cerberus_protocol_debug_read_trace_response))
+
+/**
+ * Maximum number of trace records that can be returned in a single request
+ *
+ * @param req The command request structure containing the message.
+ */
+#define	CERBERUS_PROTOCOL_MAX_TRACE_RECORDS(req)	\
+	((req->max_response - sizeof (struct cerberus_protocol_debug_read_trace_response)) / \
+		sizeof (struct trace_record))
 #pragma pack(pop)
 
 
 int cerberus_protocol_debug_fill_log (struct cmd_background *background,
 	struct cmd_interface_request *request);
+int cerberus_protocol_debug_read_trace (struct cmd_interface_request *request);
 
 int cerberus_protocol_get_device_certificate (struct device_manager *device_mgr,
 	struct cmd_interface_request *request);
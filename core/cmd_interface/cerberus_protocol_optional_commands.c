@@ -1006,3 +1006,78 @@ exit:
 
 	return status;
 }
+
+/**
+ * Process get command statistics packet.
+ *
+ * @param stats Command statistics instance to query
+ * @param request Get command statistics request to process
+ *
+ * @return 0 if request processing completed successfully or an error code.
+ */
+int cerberus_protocol_get_command_stats (struct cmd_stats *stats,
+	struct cmd_interface_request *request)
+{
+	struct cerberus_protocol_get_command_stats *rq =
+		(struct cerberus_protocol_get_command_stats*) request->data;
+	struct cerberus_protocol_get_command_stats_response *cmd_rsp =
+		(struct cerberus_protocol_get_command_stats_response*) request->data;
+	struct cerberus_protocol_get_channel_stats_response *channel_rsp =
+		(struct cerberus_protocol_get_channel_stats_response*) request->data;
+	struct cmd_stats_command cmd_stats;
+	struct cmd_channel_stats channel_stats;
+	struct cmd_channel *channel;
+	uint8_t id;
+	int status;
+
+	if (request->length != sizeof (struct cerberus_protocol_get_command_stats)) {
+		return CMD_HANDLER_BAD_LENGTH;
+	}
+
+	id = rq->id;
+
+	switch (rq->stats_type) {
+		case CERBERUS_PROTOCOL_COMMAND_STATS:
+			status = cmd_stats_get_command (stats, id, &cmd_stats);
+			if (status != 0) {
+				return status;
+			}
+
+			cmd_rsp->command_id = id;
+			cmd_rsp->requests = cmd_stats.requests;
+			cmd_rsp->failures = cmd_stats.failures;
+			cmd_rsp->total_time_ms = cmd_stats.total_time_ms;
+			cmd_rsp->max_time_ms = cmd_stats.max_time_ms;
+			memcpy (cmd_rsp->latency, cmd_stats.latency, sizeof (cmd_rsp->latency));
+
+			request->length = sizeof (struct cerberus_protocol_get_command_stats_response);
+			return 0;
+
+		case CERBERUS_PROTOCOL_CHANNEL_STATS:
+			channel = cmd_stats_get_channel (stats, id);
+			if (channel == NULL) {
+				return CMD_HANDLER_UNSUPPORTED_INDEX;
+			}
+
+			status = cmd_channel_get_stats (channel, &channel_stats);
+			if (status != 0) {
+				return status;
+			}
+
+			channel_rsp->channel_id = id;
+			channel_rsp->rx_packets = channel_stats.rx_packets;
+			channel_rsp->rx_errors = channel_stats.rx_errors;
+			channel_rsp->rx_timeouts = channel_stats.rx_timeouts;
+			channel_rsp->dropped = channel_stats.dropped;
+			channel_rsp->overflow = channel_stats.overflow;
+			channel_rsp->tx_packets = channel_stats.tx_packets;
+			channel_rsp->tx_errors = channel_stats.tx_errors;
+			channel_rsp->timeouts = channel_stats.timeouts;
+
+			request->length = sizeof (struct cerberus_protocol_get_channel_stats_response);
+			return 0;
+
+		default:
+			return CMD_HANDLER_OUT_OF_RANGE;
+	}
+}
@@ -9,6 +9,7 @@
 #include "cmd_interface/cmd_authorization.h"
 #include "cmd_interface/cmd_background.h"
 #include "cmd_interface/cmd_interface.h"
+#include "cmd_interface/cmd_stats.h"
 #include "attestation/pcr_store.h"
 #include "attestation/attestation.h"
 #include "crypto/hash.h"
@@ -81,6 +82,14 @@ enum {
 	CERBERUS_PROTOCOL_UNSEAL_RSA_OAEP_SHA256,				/**< Seed is encrypted with OAEP-SHA256 padding */
 };
 
+/**
+ * Identifier for the type of processing statistics to retrieve.
+ */
+enum {
+	CERBERUS_PROTOCOL_COMMAND_STATS = 0,					/**< Statistics for a single command ID */
+	CERBERUS_PROTOCOL_CHANNEL_STATS							/**< Packet counters for a command channel */
+};
+
 /**
  * Maximum number of PMRs that can be used for unsealing.
  *
@@ -616,6 +625,44 @@ struct cerberus_protocol_message_unseal_result_completed_response {
  */
 #define	CERBERUS_PROTOCOL_MAX_UNSEAL_KEY_DATA(req)	\
 	((req->max_response - sizeof (struct cerberus_protocol_message_unseal_result_completed_response)) + sizeof (uint8_t))
+
+/**
+ * Cerberus protocol get command statistics request format
+ */
+struct cerberus_protocol_get_command_stats {
+	struct cerberus_protocol_header header;					/**< Message header */
+	uint8_t stats_type;										/**< Type of statistics to retrieve */
+	uint8_t id;												/**< Command ID or channel ID to query */
+};
+
+/**
+ * Cerberus protocol get command statistics response format for a single command
+ */
+struct cerberus_protocol_get_command_stats_response {
+	struct cerberus_protocol_header header;					/**< Message header */
+	uint8_t command_id;										/**< Command ID for the statistics */
+	uint32_t requests;										/**< Total number of requests processed */
+	uint32_t failures;										/**< Number of requests that failed */
+	uint32_t total_time_ms;									/**< Total processing time in milliseconds */
+	uint32_t max_time_ms;									/**< Longest processing time in milliseconds */
+	uint32_t latency[CMD_STATS_LATENCY_BUCKETS];			/**< Log2 histogram of processing times */
+};
+
+/**
+ * Cerberus protocol get command statistics response format for a command channel
+ */
+struct cerberus_protocol_get_channel_stats_response {
+	struct cerberus_protocol_header header;					/**< Message header */
+	uint8_t channel_id;										/**< Channel ID for the statistics */
+	uint32_t rx_packets;									/**< Number of packets received */
+	uint32_t rx_errors;										/**< Number of receive failures */
+	uint32_t rx_timeouts;									/**< Number of receive timeouts */
+	uint32_t dropped;										/**< Number of received packets discarded */
+	uint32_t overflow;										/**< Number of overflow packets */
+	uint32_t tx_packets;									/**< Number of packets sent */
+	uint32_t tx_errors;										/**< Number of send failures */
+	uint32_t timeouts;										/**< Number of responses dropped due to timeout */
+};
 #pragma pack(pop)
 
 
@@ -676,5 +723,8 @@ int cerberus_protocol_activate_recovery_image (struct recovery_image_cmd_interfa
 int cerberus_protocol_get_recovery_image_id (struct recovery_image_manager *manager_0,
 	struct recovery_image_manager *manager_1, struct cmd_interface_request *request);
 
+int cerberus_protocol_get_command_stats (struct cmd_stats *stats,
+	struct cmd_interface_request *request);
+
 
 #endif // CERBERUS_PROTOCOL_OPTIONAL_COMMANDS_H_
@@ -7,6 +7,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include "status/rot_status.h"
+#include "cmd_deferred.h"
 
 
 /**
@@ -129,6 +130,19 @@ struct cmd_background {
 	 * authentication request.
 	 */
 	int (*get_riot_cert_chain_state) (struct cmd_background *cmd);
+
+	/**
+	 * Execute a command request that has been deferred by the command handler.  Once execution
+	 * completes, the response will be held by the deferred handler until it is requested again.
+	 *
+	 * This is optional.  If it is not provided, deferred commands will be processed immediately.
+	 *
+	 * @param cmd The background context for executing the operation.
+	 * @param deferred The deferred handler containing the request to execute.
+	 *
+	 * @return 0 if the operation was successfully scheduled or an error code.
+	 */
+	int (*run_deferred) (struct cmd_background *cmd, struct cmd_deferred *deferred);
 };
 
 
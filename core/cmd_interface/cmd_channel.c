@@ -6,6 +6,7 @@
 #include <string.h>
 #include "platform.h"
 #include "mctp/mctp_interface.h"
+#include "logging/trace_buffer.h"
 #include "cmd_channel.h"
 #include "cmd_logging.h"
 
@@ -20,6 +21,8 @@
  */
 int cmd_channel_init (struct cmd_channel *channel, int id)
 {
+	int status;
+
 	if (channel == NULL) {
 		return CMD_CHANNEL_INVALID_ARGUMENT;
 	}
@@ -28,7 +31,17 @@ int cmd_channel_init (struct cmd_channel *channel, int id)
 
 	channel->id = id;
 
-	return 0;
+	status = platform_mutex_init (&channel->lock);
+	if (status != 0) {
+		return status;
+	}
+
+	status = platform_mutex_init (&channel->stats_lock);
+	if (status != 0) {
+		platform_mutex_free (&channel->lock);
+	}
+
+	return status;
 }
 
 /**
@@ -38,7 +51,24 @@ int cmd_channel_init (struct cmd_channel *channel, int id)
  */
 void cmd_channel_release (struct cmd_channel *channel)
 {
+	if (channel) {
+		platform_mutex_free (&channel->lock);
+		platform_mutex_free (&channel->stats_lock);
+	}
+}
 
+/**
+ * Increment one of the packet counters for a command channel.  Counters can be updated from
+ * multiple contexts, so they must only be updated through this function.
+ *
+ * @param channel The channel to update.
+ * @param counter The counter in the channel stats to increment.
+ */
+void cmd_channel_increment_counter (struct cmd_channel *channel, uint32_t *counter)
+{
+	platform_mutex_lock (&channel->stats_lock);
+	(*counter)++;
+	platform_mutex_unlock (&channel->stats_lock);
 }
 
 /**
@@ -58,6 +88,27 @@ int cmd_channel_get_id (struct cmd_channel *channel)
 	}
 }
 
+/**
+ * Get the packet counters for a command channel.
+ *
+ * @param channel The command channel to query.
+ * @param stats Output for the channel packet counters.
+ *
+ * @return 0 if the counters were retrieved successfully or an error code.
+ */
+int cmd_channel_get_stats (struct cmd_channel *channel, struct cmd_channel_stats *stats)
+{
+	if ((channel == NULL) || (stats == NULL)) {
+		return CMD_CHANNEL_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&channel->stats_lock);
+	memcpy (stats, &channel->stats, sizeof (struct cmd_channel_stats));
+	platform_mutex_unlock (&channel->stats_lock);
+
+	return 0;
+}
+
 /**
  * Receive a single packet from the command channel and process it.  Errors will be logged.
  *
@@ -72,9 +123,6 @@ int cmd_channel_receive_and_process (struct cmd_channel *channel, struct mctp_in
 	int ms_timeout)
 {
 	struct cmd_packet rx_packet;
-	struct cmd_packet *tx_packets;
-	size_t num_packets;
-	int i;
 	int status;
 
 	if ((channel == NULL) || (mctp == NULL)) {
@@ -83,36 +131,90 @@ int cmd_channel_receive_and_process (struct cmd_channel *channel, struct mctp_in
 
 	status = channel->receive_packet (channel, &rx_packet, ms_timeout);
 	if (status != 0) {
+		if (status == CMD_CHANNEL_RX_TIMEOUT) {
+			cmd_channel_increment_counter (channel, &channel->stats.rx_timeouts);
+		}
+		else {
+			cmd_channel_increment_counter (channel, &channel->stats.rx_errors);
+		}
+
 		debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_CMD_INTERFACE,
 			CMD_LOGGING_RECEIVE_PACKET_FAIL, channel->id, status);
 		return status;
 	}
 
+	return cmd_channel_process_packet (channel, mctp, &rx_packet);
+}
+
+/**
+ * Process a packet that has already been received from the command channel.  Any response will be
+ * sent over the same channel.  Errors will be logged.
+ *
+ * The channel lock is held while the packet is processed, so other contexts that send requests
+ * through the same channel and MCTP handler are serialized with the processing of received
+ * packets.
+ *
+ * @param channel The channel the packet was received from.
+ * @param mctp The MCTP interface to use for processing the received packet.
+ * @param rx_packet The packet to process.
+ *
+ * @return 0 if the packet was processed successfully or an error code.
+ */
+int cmd_channel_process_packet (struct cmd_channel *channel, struct mctp_interface *mctp,
+	struct cmd_packet *rx_packet)
+{
+	struct cmd_packet *tx_packets;
+	size_t num_packets;
+	int i;
+	int status;
+
+	if ((channel == NULL) || (mctp == NULL) || (rx_packet == NULL)) {
+		return CMD_CHANNEL_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&channel->lock);
+
+	cmd_channel_increment_counter (channel, &channel->stats.rx_packets);
+
 	/* We don't support packets larger than the maximum defined size, so there is no need to
 	 * attempt to aggregate transactions that send too much data.  Just throw the data away. */
-	if (rx_packet.state == CMD_OVERFLOW_PACKET) {
+	if (rx_packet->state == CMD_OVERFLOW_PACKET) {
 		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CMD_INTERFACE,
 			CMD_LOGGING_PACKET_OVERFLOW, channel->id, 0);
 
+		cmd_channel_increment_counter (channel, &channel->stats.overflow);
 		channel->overflow = true;
 		mctp_interface_reset_message_processing (mctp);
-		return CMD_CHANNEL_PKT_OVERFLOW;
+		status = CMD_CHANNEL_PKT_OVERFLOW;
+		goto exit;
 	}
 	else if (channel->overflow) {
 		/* We need to throw away the next "good" packet after detecting overflow.  It will be the
 		 * remaining bytes from the transaction that triggered the overflow condition, so it doesn't
 		 * actually represent valid data. */
+		cmd_channel_increment_counter (channel, &channel->stats.dropped);
 		channel->overflow = false;
-		return 0;
+		status = 0;
+		goto exit;
 	}
 
-	status = mctp_interface_process_packet (mctp, &rx_packet, &tx_packets, &num_packets);
+	TRACE_BEGIN (TRACE_EVENT_MCTP_RX, channel->id, rx_packet->pkt_size);
+	status = mctp_interface_process_packet (mctp, rx_packet, &tx_packets, &num_packets);
+	TRACE_END (TRACE_EVENT_MCTP_RX, channel->id, status);
+
 	if (status == 0) {
-		if (!rx_packet.timeout_valid || !platform_has_timeout_expired (&rx_packet.pkt_timeout)) {
+		if (!rx_packet->timeout_valid || !platform_has_timeout_expired (&rx_packet->pkt_timeout)) {
 			i = 0;
 			while ((i < num_packets) && (status == 0)) {
+				TRACE_BEGIN (TRACE_EVENT_MCTP_TX, channel->id, tx_packets[i].pkt_size);
 				status = channel->send_packet (channel, &tx_packets[i]);
-				if (status != 0) {
+				TRACE_END (TRACE_EVENT_MCTP_TX, channel->id, status);
+
+				if (status == 0) {
+					cmd_channel_increment_counter (channel, &channel->stats.tx_packets);
+				}
+				else {
+					cmd_channel_increment_counter (channel, &channel->stats.tx_errors);
 					debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR,
 						DEBUG_LOG_COMPONENT_CMD_INTERFACE, CMD_LOGGING_SEND_PACKET_FAIL,
 						channel->id, status);
@@ -122,6 +224,7 @@ int cmd_channel_receive_and_process (struct cmd_channel *channel, struct mctp_in
 			}
 		}
 		else {
+			cmd_channel_increment_counter (channel, &channel->stats.timeouts);
 			debug_log_create_entry (DEBUG_LOG_SEVERITY_WARNING, DEBUG_LOG_COMPONENT_CMD_INTERFACE,
 				CMD_LOGGING_COMMAND_TIMEOUT, channel->id, 0);
 		}
@@ -129,9 +232,12 @@ int cmd_channel_receive_and_process (struct cmd_channel *channel, struct mctp_in
 		platform_free (tx_packets);
 	}
 	else {
+		cmd_channel_increment_counter (channel, &channel->stats.dropped);
 		debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_CMD_INTERFACE,
 			CMD_LOGGING_PROCESS_FAIL, status, channel->id);
 	}
 
+exit:
+	platform_mutex_unlock (&channel->lock);
 	return status;
 }
@@ -41,6 +41,21 @@ struct cmd_packet {
 };
 
 
+/**
+ * Packet counters maintained for a command channel.
+ */
+struct cmd_channel_stats {
+	uint32_t rx_packets;					/**< Number of packets received on the channel. */
+	uint32_t rx_errors;						/**< Number of failures to receive a packet. */
+	uint32_t rx_timeouts;					/**< Number of times no packet was received in time. */
+	uint32_t dropped;						/**< Number of received packets that were discarded. */
+	uint32_t overflow;						/**< Number of packets that triggered an overflow. */
+	uint32_t tx_packets;					/**< Number of packets sent on the channel. */
+	uint32_t tx_errors;						/**< Number of failures to send a packet. */
+	uint32_t timeouts;						/**< Number of responses not sent due to processing timeout. */
+};
+
+
 struct mctp_interface;
 
 /**
@@ -69,20 +84,28 @@ struct cmd_channel {
 	 */
 	int (*send_packet) (struct cmd_channel *channel, struct cmd_packet *packet);
 
-	int id;				/**< ID for the command channel. */
-	bool overflow;		/**< Flag if the channel is in an overflow condition. */
+	int id;							/**< ID for the command channel. */
+	bool overflow;					/**< Flag if the channel is in an overflow condition. */
+	struct cmd_channel_stats stats;	/**< Packet counters for the channel. */
+	platform_mutex lock;			/**< Synchronization for packet processing on the channel. */
+	platform_mutex stats_lock;		/**< Synchronization for the packet counters. */
 };
 
 
 int cmd_channel_get_id (struct cmd_channel *channel);
+int cmd_channel_get_stats (struct cmd_channel *channel, struct cmd_channel_stats *stats);
 
 int cmd_channel_receive_and_process (struct cmd_channel *channel, struct mctp_interface *mctp,
 	int ms_timeout);
+int cmd_channel_process_packet (struct cmd_channel *channel, struct mctp_interface *mctp,
+	struct cmd_packet *rx_packet);
 
 /* Internal functions for use by derived types. */
 int cmd_channel_init (struct cmd_channel *channel, int id);
 void cmd_channel_release (struct cmd_channel *channel);
 
+void cmd_channel_increment_counter (struct cmd_channel *channel, uint32_t *counter);
+
 
 #define	CMD_CHANNEL_ERROR(code)		ROT_ERROR (ROT_MODULE_CMD_CHANNEL, code)
 
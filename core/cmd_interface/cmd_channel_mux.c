@@ -0,0 +1,359 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "cmd_channel_mux.h"
+#include "cmd_logging.h"
+#include "cerberus_protocol.h"
+
+
+/**
+ * Initialize a multiplexer for servicing command channels.  Commands that report status needed
+ * for host management are given high priority, while commands that transfer bulk data are given
+ * low priority.  All other commands have normal priority.
+ *
+ * @param mux The multiplexer to initialize.
+ *
+ * @return 0 if the multiplexer was successfully initialized or an error code.
+ */
+int cmd_channel_mux_init (struct cmd_channel_mux *mux)
+{
+	if (mux == NULL) {
+		return CMD_CHANNEL_MUX_INVALID_ARGUMENT;
+	}
+
+	memset (mux, 0, sizeof (struct cmd_channel_mux));
+
+	memset (mux->command_priority, CMD_CHANNEL_MUX_PRIORITY_NORMAL,
+		sizeof (mux->command_priority));
+
+	mux->command_priority[CERBERUS_PROTOCOL_GET_HOST_STATE] = CMD_CHANNEL_MUX_PRIORITY_HIGH;
+	mux->command_priority[CERBERUS_PROTOCOL_GET_UPDATE_STATUS] = CMD_CHANNEL_MUX_PRIORITY_HIGH;
+	mux->command_priority[CERBERUS_PROTOCOL_GET_EXT_UPDATE_STATUS] = CMD_CHANNEL_MUX_PRIORITY_HIGH;
+
+	mux->command_priority[CERBERUS_PROTOCOL_READ_LOG] = CMD_CHANNEL_MUX_PRIORITY_LOW;
+	mux->command_priority[CERBERUS_PROTOCOL_GET_ATTESTATION_DATA] = CMD_CHANNEL_MUX_PRIORITY_LOW;
+	mux->command_priority[CERBERUS_PROTOCOL_PFM_UPDATE] = CMD_CHANNEL_MUX_PRIORITY_LOW;
+	mux->command_priority[CERBERUS_PROTOCOL_CFM_UPDATE] = CMD_CHANNEL_MUX_PRIORITY_LOW;
+	mux->command_priority[CERBERUS_PROTOCOL_PCD_UPDATE] = CMD_CHANNEL_MUX_PRIORITY_LOW;
+	mux->command_priority[CERBERUS_PROTOCOL_FW_UPDATE] = CMD_CHANNEL_MUX_PRIORITY_LOW;
+	mux->command_priority[CERBERUS_PROTOCOL_UPDATE_RECOVERY_IMAGE] = CMD_CHANNEL_MUX_PRIORITY_LOW;
+
+	return platform_mutex_init (&mux->lock);
+}
+
+/**
+ * Release the resources used by a command channel multiplexer.  No contexts can be processing
+ * packets.
+ *
+ * @param mux The multiplexer to release.
+ */
+void cmd_channel_mux_release (struct cmd_channel_mux *mux)
+{
+	if (mux) {
+		platform_mutex_free (&mux->lock);
+	}
+}
+
+/**
+ * Add a command channel to be serviced by the multiplexer.  The channel must not block when
+ * receiving packets with no timeout, and must support receiving packets while a response is being
+ * sent from another context.
+ *
+ * @param mux The multiplexer to update.
+ * @param channel The command channel to service.
+ * @param mctp The MCTP handler for packets on the channel.  This must not be used with any other
+ * channel, but it can share a command handler and device manager with other channels.
+ * @param priority The priority of traffic on the channel relative to other channels.  This is
+ * only used to order packets for commands with the same priority.
+ *
+ * @return 0 if the channel was added or an error code.
+ */
+int cmd_channel_mux_add_channel (struct cmd_channel_mux *mux, struct cmd_channel *channel,
+	struct mctp_interface *mctp, enum cmd_channel_mux_priority priority)
+{
+	struct cmd_channel_mux_entry *entry;
+	int status = 0;
+	size_t i;
+
+	if ((mux == NULL) || (channel == NULL) || (mctp == NULL) ||
+		(priority >= CMD_CHANNEL_MUX_PRIORITY_COUNT)) {
+		return CMD_CHANNEL_MUX_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&mux->lock);
+
+	for (i = 0; i < mux->count; i++) {
+		if ((mux->entry[i].channel == channel) || (mux->entry[i].mctp == mctp)) {
+			status = CMD_CHANNEL_MUX_DUPLICATE_CHANNEL;
+			goto exit;
+		}
+	}
+
+	if (mux->count == CMD_CHANNEL_MUX_MAX_CHANNELS) {
+		status = CMD_CHANNEL_MUX_FULL;
+		goto exit;
+	}
+
+	entry = &mux->entry[mux->count++];
+	memset (entry, 0, sizeof (struct cmd_channel_mux_entry));
+
+	entry->channel = channel;
+	entry->mctp = mctp;
+	entry->priority = priority;
+	entry->msg_priority = CMD_CHANNEL_MUX_PRIORITY_NORMAL;
+
+exit:
+	platform_mutex_unlock (&mux->lock);
+	return status;
+}
+
+/**
+ * Assign the priority for processing a command.
+ *
+ * @param mux The multiplexer to update.
+ * @param command_id The command to configure.
+ * @param priority The priority for processing packets for the command.
+ *
+ * @return 0 if the command priority was set or an error code.
+ */
+int cmd_channel_mux_set_command_priority (struct cmd_channel_mux *mux, uint8_t command_id,
+	enum cmd_channel_mux_priority priority)
+{
+	if ((mux == NULL) || (priority >= CMD_CHANNEL_MUX_PRIORITY_COUNT)) {
+		return CMD_CHANNEL_MUX_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&mux->lock);
+	mux->command_priority[command_id] = priority;
+	platform_mutex_unlock (&mux->lock);
+
+	return 0;
+}
+
+/**
+ * Get the priority for processing a command.
+ *
+ * @param mux The multiplexer to query.
+ * @param command_id The command to query.
+ *
+ * @return The command priority or an error code.  Use ROT_IS_ERROR to check the return value.
+ */
+int cmd_channel_mux_get_command_priority (struct cmd_channel_mux *mux, uint8_t command_id)
+{
+	if (mux == NULL) {
+		return CMD_CHANNEL_MUX_INVALID_ARGUMENT;
+	}
+
+	return mux->command_priority[command_id];
+}
+
+/**
+ * Determine the priority of the command for the oldest packet received on a channel.  Packets
+ * that start a new message are assigned the priority of the requested command.  Other packets use
+ * the priority of the message they are part of.  The multiplexer lock must be held by the caller.
+ *
+ * @param mux The multiplexer processing the packet.
+ * @param entry The channel the packet was received on.
+ *
+ * @return The command priority for the packet.
+ */
+static enum cmd_channel_mux_priority cmd_channel_mux_get_packet_priority (
+	struct cmd_channel_mux *mux, struct cmd_channel_mux_entry *entry)
+{
+	struct cmd_packet *packet = &entry->queue[entry->head];
+	struct mctp_protocol_transport_header *mctp =
+		(struct mctp_protocol_transport_header*) packet->data;
+	struct cerberus_protocol_header *header;
+
+	if ((packet->state != CMD_VALID_PACKET) ||
+		(packet->pkt_size < sizeof (struct mctp_protocol_transport_header)) || !mctp->som) {
+		return entry->msg_priority;
+	}
+
+	header = (struct cerberus_protocol_header*)
+		&packet->data[sizeof (struct mctp_protocol_transport_header)];
+
+	if ((packet->pkt_size <
+			(sizeof (struct mctp_protocol_transport_header) + CERBERUS_PROTOCOL_MIN_MSG_LEN)) ||
+		!MCTP_PROTOCOL_IS_VENDOR_MSG (header->msg_type)) {
+		return CMD_CHANNEL_MUX_PRIORITY_NORMAL;
+	}
+
+	return mux->command_priority[header->command];
+}
+
+/**
+ * Poll a channel for a new packet and add it to the channel queue.  Nothing is received if the
+ * queue is full.  The multiplexer lock must be held by the caller.
+ *
+ * @param entry The channel to poll.
+ */
+static void cmd_channel_mux_receive_packet (struct cmd_channel_mux_entry *entry)
+{
+	size_t tail;
+	int status;
+
+	if (entry->pending == CMD_CHANNEL_MUX_QUEUE_DEPTH) {
+		return;
+	}
+
+	tail = (entry->head + entry->pending) % CMD_CHANNEL_MUX_QUEUE_DEPTH;
+	status = entry->channel->receive_packet (entry->channel, &entry->queue[tail], 0);
+	if (status == 0) {
+		if (entry->pending == 0) {
+			entry->skipped = 0;
+		}
+		entry->pending++;
+	}
+	else if (status != CMD_CHANNEL_RX_TIMEOUT) {
+		cmd_channel_increment_counter (entry->channel, &entry->channel->stats.rx_errors);
+		debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_CMD_INTERFACE,
+			CMD_LOGGING_RECEIVE_PACKET_FAIL, entry->channel->id, status);
+	}
+}
+
+/**
+ * Check if a channel can be processed now.  A channel cannot be processed while a packet is being
+ * processed on it or on any channel that shares the same command handler or device manager.  The
+ * multiplexer lock must be held by the caller.
+ *
+ * @param mux The multiplexer to query.
+ * @param entry The channel to check.
+ *
+ * @return true if a packet on the channel can be processed.
+ */
+static bool cmd_channel_mux_is_channel_ready (struct cmd_channel_mux *mux,
+	struct cmd_channel_mux_entry *entry)
+{
+	struct cmd_channel_mux_entry *other;
+	size_t i;
+
+	if ((entry->pending == 0) || entry->busy) {
+		return false;
+	}
+
+	for (i = 0; i < mux->count; i++) {
+		other = &mux->entry[i];
+		if (other->busy && ((other->mctp->cmd_interface == entry->mctp->cmd_interface) ||
+			(other->mctp->device_manager == entry->mctp->device_manager))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Check if the packet waiting on one channel should be processed before the packet waiting on
+ * another channel.  The multiplexer lock must be held by the caller.
+ *
+ * @param entry The channel to check.
+ * @param priority The command priority for the packet waiting on the channel.
+ * @param best The current best channel.
+ * @param best_priority The command priority for the packet waiting on the best channel.
+ *
+ * @return true if the packet on the channel should be processed first.
+ */
+static bool cmd_channel_mux_is_higher_priority (struct cmd_channel_mux_entry *entry,
+	enum cmd_channel_mux_priority priority, struct cmd_channel_mux_entry *best,
+	enum cmd_channel_mux_priority best_priority)
+{
+	bool aged = (entry->skipped >= CMD_CHANNEL_MUX_MAX_SKIPS);
+	bool best_aged = (best->skipped >= CMD_CHANNEL_MUX_MAX_SKIPS);
+
+	if (aged != best_aged) {
+		return aged;
+	}
+
+	if (priority != best_priority) {
+		return (priority > best_priority);
+	}
+
+	if (entry->priority != best->priority) {
+		return (entry->priority > best->priority);
+	}
+
+	/* Round robin between channels with equal priority. */
+	return ((int32_t) (entry->serviced - best->serviced) < 0);
+}
+
+/**
+ * Receive any available packets from the serviced channels and process the packet with the
+ * highest priority.  This can be called from multiple contexts at the same time to process
+ * packets on different channels concurrently.
+ *
+ * Each call will receive at most one new packet from each channel.  Packets that cannot be
+ * processed yet remain queued on the channel until a later call.
+ *
+ * @param mux The multiplexer to use for processing packets.
+ *
+ * @return 0 if a packet was processed successfully, CMD_CHANNEL_MUX_NO_PACKET if there were no
+ * packets ready for processing, or an error code.  Errors processing the packet will be logged.
+ */
+int cmd_channel_mux_process_next (struct cmd_channel_mux *mux)
+{
+	struct cmd_channel_mux_entry *entry;
+	struct cmd_channel_mux_entry *best = NULL;
+	enum cmd_channel_mux_priority priority;
+	enum cmd_channel_mux_priority best_priority = CMD_CHANNEL_MUX_PRIORITY_LOW;
+	bool ready[CMD_CHANNEL_MUX_MAX_CHANNELS];
+	size_t i;
+	int status;
+
+	if (mux == NULL) {
+		return CMD_CHANNEL_MUX_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&mux->lock);
+
+	for (i = 0; i < mux->count; i++) {
+		cmd_channel_mux_receive_packet (&mux->entry[i]);
+	}
+
+	for (i = 0; i < mux->count; i++) {
+		entry = &mux->entry[i];
+
+		ready[i] = cmd_channel_mux_is_channel_ready (mux, entry);
+		if (ready[i]) {
+			priority = cmd_channel_mux_get_packet_priority (mux, entry);
+			if ((best == NULL) ||
+				cmd_channel_mux_is_higher_priority (entry, priority, best, best_priority)) {
+				best = entry;
+				best_priority = priority;
+			}
+		}
+	}
+
+	if (best == NULL) {
+		platform_mutex_unlock (&mux->lock);
+		return CMD_CHANNEL_MUX_NO_PACKET;
+	}
+
+	for (i = 0; i < mux->count; i++) {
+		if (ready[i] && (&mux->entry[i] != best)) {
+			mux->entry[i].skipped++;
+		}
+	}
+
+	best->msg_priority = best_priority;
+	best->busy = true;
+	best->serviced = ++mux->sequence;
+
+	platform_mutex_unlock (&mux->lock);
+
+	/* The packet stays in the queue while it is processed.  New packets are only received into
+	 * free queue entries, so it will not be modified until it is removed. */
+	status = cmd_channel_process_packet (best->channel, best->mctp, &best->queue[best->head]);
+
+	platform_mutex_lock (&mux->lock);
+	best->head = (best->head + 1) % CMD_CHANNEL_MUX_QUEUE_DEPTH;
+	best->pending--;
+	best->skipped = 0;
+	best->busy = false;
+	platform_mutex_unlock (&mux->lock);
+
+	return status;
+}
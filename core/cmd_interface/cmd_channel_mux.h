@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef CMD_CHANNEL_MUX_H_
+#define CMD_CHANNEL_MUX_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "platform.h"
+#include "status/rot_status.h"
+#include "mctp/mctp_interface.h"
+#include "cmd_channel.h"
+
+
+/**
+ * The maximum number of command channels that can be serviced by a single multiplexer.
+ */
+#ifndef CMD_CHANNEL_MUX_MAX_CHANNELS
+#define	CMD_CHANNEL_MUX_MAX_CHANNELS		4
+#endif
+
+/**
+ * The maximum number of received packets that can be queued for a single channel.  Channels are
+ * not polled for new packets while their queue is full.
+ */
+#ifndef CMD_CHANNEL_MUX_QUEUE_DEPTH
+#define	CMD_CHANNEL_MUX_QUEUE_DEPTH			4
+#endif
+
+/**
+ * The number of times a received packet can be passed over for higher priority traffic before it
+ * is serviced at the highest priority.  This prevents bulk transfers from being starved.
+ */
+#ifndef CMD_CHANNEL_MUX_MAX_SKIPS
+#define	CMD_CHANNEL_MUX_MAX_SKIPS			8
+#endif
+
+
+/**
+ * Priority levels for servicing received packets.
+ */
+enum cmd_channel_mux_priority {
+	CMD_CHANNEL_MUX_PRIORITY_LOW = 0,				/**< Bulk traffic that is not latency sensitive. */
+	CMD_CHANNEL_MUX_PRIORITY_NORMAL,				/**< Default priority for all traffic. */
+	CMD_CHANNEL_MUX_PRIORITY_HIGH,					/**< Latency critical traffic. */
+	CMD_CHANNEL_MUX_PRIORITY_COUNT					/**< Number of priority levels. */
+};
+
+/**
+ * A command channel serviced by the multiplexer.
+ */
+struct cmd_channel_mux_entry {
+	struct cmd_channel *channel;					/**< The channel for sending and receiving packets. */
+	struct mctp_interface *mctp;					/**< MCTP handler for packets on the channel. */
+	enum cmd_channel_mux_priority priority;			/**< Priority for traffic on the channel. */
+	enum cmd_channel_mux_priority msg_priority;		/**< Priority of the message being received. */
+	struct cmd_packet queue[CMD_CHANNEL_MUX_QUEUE_DEPTH];	/**< Received packets waiting to be processed. */
+	size_t head;									/**< Queue index of the oldest received packet. */
+	size_t pending;									/**< Number of received packets in the queue. */
+	bool busy;										/**< Flag indicating a packet is being processed. */
+	int skipped;									/**< Number of times the oldest packet was passed over. */
+	uint32_t serviced;								/**< Sequence number of the last packet processed. */
+};
+
+/**
+ * Service multiple command channels from a shared pool of processing contexts.  Received packets
+ * are processed in priority order based on the command being requested and the channel the
+ * packet was received on.
+ *
+ * Packets on a single channel are always processed in order by a single context at a time.
+ * Different channels can be processed concurrently, so each channel must have its own MCTP
+ * interface.  Command handlers and device managers are not thread-safe, so packets for channels
+ * whose MCTP interfaces share either of these are never processed at the same time.
+ */
+struct cmd_channel_mux {
+	struct cmd_channel_mux_entry entry[CMD_CHANNEL_MUX_MAX_CHANNELS];	/**< Serviced channels. */
+	size_t count;									/**< Number of channels being serviced. */
+	uint8_t command_priority[256];					/**< Priority assigned to each command ID. */
+	uint32_t sequence;								/**< Counter for packets that have been processed. */
+	platform_mutex lock;							/**< Synchronization for channel state. */
+};
+
+
+int cmd_channel_mux_init (struct cmd_channel_mux *mux);
+void cmd_channel_mux_release (struct cmd_channel_mux *mux);
+
+int cmd_channel_mux_add_channel (struct cmd_channel_mux *mux, struct cmd_channel *channel,
+	struct mctp_interface *mctp, enum cmd_channel_mux_priority priority);
+int cmd_channel_mux_set_command_priority (struct cmd_channel_mux *mux, uint8_t command_id,
+	enum cmd_channel_mux_priority priority);
+int cmd_channel_mux_get_command_priority (struct cmd_channel_mux *mux, uint8_t command_id);
+
+int cmd_channel_mux_process_next (struct cmd_channel_mux *mux);
+
+
+#define	CMD_CHANNEL_MUX_ERROR(code)		ROT_ERROR (ROT_MODULE_CMD_CHANNEL_MUX, code)
+
+/**
+ * Error codes that can be generated by the command channel multiplexer.
+ */
+enum {
+	CMD_CHANNEL_MUX_INVALID_ARGUMENT = CMD_CHANNEL_MUX_ERROR (0x00),	/**< Input parameter is null or not valid. */
+	CMD_CHANNEL_MUX_NO_MEMORY = CMD_CHANNEL_MUX_ERROR (0x01),			/**< Memory allocation failed. */
+	CMD_CHANNEL_MUX_FULL = CMD_CHANNEL_MUX_ERROR (0x02),				/**< No more channels can be added. */
+	CMD_CHANNEL_MUX_DUPLICATE_CHANNEL = CMD_CHANNEL_MUX_ERROR (0x03),	/**< The channel is already being serviced. */
+	CMD_CHANNEL_MUX_NO_PACKET = CMD_CHANNEL_MUX_ERROR (0x04),			/**< No packets are waiting to be processed. */
+};
+
+
+#endif /* CMD_CHANNEL_MUX_H_ */
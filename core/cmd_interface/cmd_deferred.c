@@ -0,0 +1,308 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "cmd_deferred.h"
+
+
+/**
+ * Initialize a handler for deferred command requests.  No commands will be deferred until they
+ * are explicitly enabled.
+ *
+ * @param deferred The deferred command handler to initialize.
+ * @param execute The function to call to execute a deferred request.
+ *
+ * @return 0 if the handler was successfully initialized or an error code.
+ */
+int cmd_deferred_init (struct cmd_deferred *deferred,
+	int (*execute) (struct cmd_deferred*, struct cmd_interface_request*))
+{
+	if ((deferred == NULL) || (execute == NULL)) {
+		return CMD_DEFERRED_INVALID_ARGUMENT;
+	}
+
+	memset (deferred, 0, sizeof (struct cmd_deferred));
+
+	deferred->execute = execute;
+
+	return platform_mutex_init (&deferred->lock);
+}
+
+/**
+ * Free the buffers for the current deferred request and return to the idle state.  The handler
+ * lock must be held by the caller.
+ *
+ * @param deferred The deferred command handler to update.
+ */
+static void cmd_deferred_discard (struct cmd_deferred *deferred)
+{
+	platform_free (deferred->original);
+	platform_free (deferred->work);
+
+	deferred->original = NULL;
+	deferred->original_length = 0;
+	deferred->work = NULL;
+	deferred->state = CMD_DEFERRED_STATE_IDLE;
+}
+
+/**
+ * Release the resources used by a deferred command handler.  No requests can be executing.
+ *
+ * @param deferred The deferred command handler to release.
+ */
+void cmd_deferred_release (struct cmd_deferred *deferred)
+{
+	if (deferred) {
+		cmd_deferred_discard (deferred);
+		platform_mutex_free (&deferred->lock);
+	}
+}
+
+/**
+ * Configure a command to be executed as a deferred request.
+ *
+ * @param deferred The deferred command handler to update.
+ * @param command_id The command that should be deferred.
+ *
+ * @return 0 if the command was enabled or an error code.
+ */
+int cmd_deferred_enable_command (struct cmd_deferred *deferred, uint8_t command_id)
+{
+	if (deferred == NULL) {
+		return CMD_DEFERRED_INVALID_ARGUMENT;
+	}
+
+	deferred->enabled[command_id / 8] |= (1U << (command_id % 8));
+
+	return 0;
+}
+
+/**
+ * Configure a command to be executed immediately when it is received.
+ *
+ * @param deferred The deferred command handler to update.
+ * @param command_id The command that should not be deferred.
+ *
+ * @return 0 if the command was disabled or an error code.
+ */
+int cmd_deferred_disable_command (struct cmd_deferred *deferred, uint8_t command_id)
+{
+	if (deferred == NULL) {
+		return CMD_DEFERRED_INVALID_ARGUMENT;
+	}
+
+	deferred->enabled[command_id / 8] &= ~(1U << (command_id % 8));
+
+	return 0;
+}
+
+/**
+ * Determine if a command should be executed as a deferred request.
+ *
+ * @param deferred The deferred command handler to query.
+ * @param command_id The command to check.
+ *
+ * @return true if the command should be deferred or false if not.
+ */
+bool cmd_deferred_is_command_enabled (struct cmd_deferred *deferred, uint8_t command_id)
+{
+	if (deferred == NULL) {
+		return false;
+	}
+
+	return !!(deferred->enabled[command_id / 8] & (1U << (command_id % 8)));
+}
+
+/**
+ * Check if a request is the same one that has been deferred.  The handler lock must be held by the
+ * caller.
+ *
+ * @param deferred The deferred command handler to check.
+ * @param request The received request.
+ *
+ * @return true if the request matches the deferred request or false if not.
+ */
+static bool cmd_deferred_is_match (struct cmd_deferred *deferred,
+	struct cmd_interface_request *request)
+{
+	return ((request->source_eid == deferred->source_eid) &&
+		(request->length == deferred->original_length) &&
+		(memcmp (request->data, deferred->original, request->length) == 0));
+}
+
+/**
+ * Save a request for deferred execution.  The handler lock must be held by the caller.
+ *
+ * @param deferred The deferred command handler to update.
+ * @param request The request to defer.
+ *
+ * @return CMD_DEFERRED_SCHEDULED if the request was saved or an error code.
+ */
+static int cmd_deferred_schedule (struct cmd_deferred *deferred,
+	struct cmd_interface_request *request)
+{
+	deferred->original = platform_malloc (request->length);
+	if (deferred->original == NULL) {
+		return CMD_DEFERRED_NO_MEMORY;
+	}
+
+	deferred->work = platform_malloc (sizeof (struct cmd_interface_request));
+	if (deferred->work == NULL) {
+		platform_free (deferred->original);
+		deferred->original = NULL;
+		return CMD_DEFERRED_NO_MEMORY;
+	}
+
+	memcpy (deferred->original, request->data, request->length);
+	deferred->original_length = request->length;
+	deferred->source_eid = request->source_eid;
+
+	memcpy (deferred->work->data, request->data, request->length);
+	deferred->work->length = request->length;
+	deferred->work->max_response = request->max_response;
+	deferred->work->source_eid = request->source_eid;
+	deferred->work->target_eid = request->target_eid;
+	deferred->work->new_request = false;
+	deferred->work->crypto_timeout = false;
+	deferred->work->channel_id = request->channel_id;
+
+	deferred->state = CMD_DEFERRED_STATE_PENDING;
+
+	return CMD_DEFERRED_SCHEDULED;
+}
+
+/**
+ * Submit a received request to the deferred handler.
+ *
+ * If no request is currently deferred, the request will be saved for execution and must be
+ * executed by calling cmd_deferred_execute.  If the same request was previously deferred and has
+ * completed execution, the response will be returned in the request buffer.  A completed response
+ * that is never retrieved is discarded when a different request is submitted.
+ *
+ * @param deferred The deferred command handler to submit the request to.
+ * @param request The received request.  If a response is available, this will be updated with
+ * the response data.
+ * @param result Output for the result of executing the request.  This is only valid if a response
+ * was returned.
+ *
+ * @return 0 if the request has been completed and the response is available.  Otherwise, one of:
+ * 		- CMD_DEFERRED_SCHEDULED if the request was saved for execution.
+ * 		- CMD_DEFERRED_IN_PROGRESS if the request was already saved and is not yet complete.
+ * 		- CMD_DEFERRED_BUSY if a different request is executing.
+ * 		- An error code if the request could not be saved.
+ */
+int cmd_deferred_submit (struct cmd_deferred *deferred, struct cmd_interface_request *request,
+	int *result)
+{
+	int status;
+
+	if ((deferred == NULL) || (request == NULL) || (result == NULL) || (request->length == 0)) {
+		return CMD_DEFERRED_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&deferred->lock);
+
+	switch (deferred->state) {
+		case CMD_DEFERRED_STATE_PENDING:
+		case CMD_DEFERRED_STATE_RUNNING:
+			status = (cmd_deferred_is_match (deferred, request)) ?
+				CMD_DEFERRED_IN_PROGRESS : CMD_DEFERRED_BUSY;
+			break;
+
+		case CMD_DEFERRED_STATE_COMPLETE:
+			if (cmd_deferred_is_match (deferred, request)) {
+				memcpy (request->data, deferred->work->data, deferred->work->length);
+				request->length = deferred->work->length;
+				request->new_request = deferred->work->new_request;
+				*result = deferred->result;
+
+				cmd_deferred_discard (deferred);
+				status = 0;
+				break;
+			}
+
+			cmd_deferred_discard (deferred);
+			/* fall through */
+
+		default:
+			status = cmd_deferred_schedule (deferred, request);
+			break;
+	}
+
+	platform_mutex_unlock (&deferred->lock);
+
+	return status;
+}
+
+/**
+ * Discard a deferred request that has not started execution.
+ *
+ * @param deferred The deferred command handler to update.
+ *
+ * @return 0 if there is no longer any deferred request or an error code.  A request that is
+ * executing cannot be cancelled.
+ */
+int cmd_deferred_cancel (struct cmd_deferred *deferred)
+{
+	int status = 0;
+
+	if (deferred == NULL) {
+		return CMD_DEFERRED_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&deferred->lock);
+
+	if (deferred->state == CMD_DEFERRED_STATE_RUNNING) {
+		status = CMD_DEFERRED_BUSY;
+	}
+	else {
+		cmd_deferred_discard (deferred);
+	}
+
+	platform_mutex_unlock (&deferred->lock);
+
+	return status;
+}
+
+/**
+ * Execute the pending deferred request.  This should be called from the context that will handle
+ * deferred work.
+ *
+ * @param deferred The deferred command handler with the request to execute.
+ *
+ * @return 0 if the request was executed or an error code.  Failures from executing the request
+ * will be returned to the requester and are not reported here.
+ */
+int cmd_deferred_execute (struct cmd_deferred *deferred)
+{
+	int result;
+
+	if (deferred == NULL) {
+		return CMD_DEFERRED_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&deferred->lock);
+
+	if (deferred->state != CMD_DEFERRED_STATE_PENDING) {
+		platform_mutex_unlock (&deferred->lock);
+		return CMD_DEFERRED_NO_REQUEST;
+	}
+
+	deferred->state = CMD_DEFERRED_STATE_RUNNING;
+
+	platform_mutex_unlock (&deferred->lock);
+
+	/* The work buffer is not touched by any other call while the request is running. */
+	result = deferred->execute (deferred, deferred->work);
+
+	platform_mutex_lock (&deferred->lock);
+
+	deferred->result = result;
+	deferred->state = CMD_DEFERRED_STATE_COMPLETE;
+
+	platform_mutex_unlock (&deferred->lock);
+
+	return 0;
+}
@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef CMD_DEFERRED_H_
+#define CMD_DEFERRED_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "platform.h"
+#include "status/rot_status.h"
+#include "cmd_interface.h"
+
+
+/**
+ * States for a deferred command request.
+ */
+enum cmd_deferred_state {
+	CMD_DEFERRED_STATE_IDLE = 0,					/**< No request has been deferred. */
+	CMD_DEFERRED_STATE_PENDING,						/**< A request is waiting to be executed. */
+	CMD_DEFERRED_STATE_RUNNING,						/**< A request is being executed. */
+	CMD_DEFERRED_STATE_COMPLETE,					/**< A response is waiting to be retrieved. */
+};
+
+/**
+ * Handler for executing command requests outside of the context that received them.  Only a
+ * single request can be deferred at a time.  While the request is executing, the requester will be
+ * told to retry the request.  The response is returned when the same request is received again
+ * after execution has completed.
+ */
+struct cmd_deferred {
+	/**
+	 * Execute a deferred request.  This is called from the context running the deferred work.
+	 *
+	 * @param deferred The deferred handler executing the request.
+	 * @param request The request to execute.  This will be updated with the response.
+	 *
+	 * @return 0 if the request was successfully processed or an error code.
+	 */
+	int (*execute) (struct cmd_deferred *deferred, struct cmd_interface_request *request);
+
+	uint8_t enabled[32];							/**< Bitmap of commands that will be deferred. */
+	uint8_t *original;								/**< Copy of the request being deferred. */
+	size_t original_length;							/**< Length of the original request. */
+	uint8_t source_eid;								/**< EID of the device that sent the request. */
+	struct cmd_interface_request *work;				/**< Request data used for execution. */
+	int result;										/**< Result of request execution. */
+	enum cmd_deferred_state state;					/**< The current state of the deferred request. */
+	platform_mutex lock;							/**< Synchronization for request state. */
+};
+
+
+int cmd_deferred_init (struct cmd_deferred *deferred,
+	int (*execute) (struct cmd_deferred*, struct cmd_interface_request*));
+void cmd_deferred_release (struct cmd_deferred *deferred);
+
+int cmd_deferred_enable_command (struct cmd_deferred *deferred, uint8_t command_id);
+int cmd_deferred_disable_command (struct cmd_deferred *deferred, uint8_t command_id);
+bool cmd_deferred_is_command_enabled (struct cmd_deferred *deferred, uint8_t command_id);
+
+int cmd_deferred_submit (struct cmd_deferred *deferred, struct cmd_interface_request *request,
+	int *result);
+int cmd_deferred_cancel (struct cmd_deferred *deferred);
+int cmd_deferred_execute (struct cmd_deferred *deferred);
+
+
+#define	CMD_DEFERRED_ERROR(code)		ROT_ERROR (ROT_MODULE_CMD_DEFERRED, code)
+
+/**
+ * Error codes that can be generated by the deferred command handler.
+ */
+enum {
+	CMD_DEFERRED_INVALID_ARGUMENT = CMD_DEFERRED_ERROR (0x00),		/**< Input parameter is null or not valid. */
+	CMD_DEFERRED_NO_MEMORY = CMD_DEFERRED_ERROR (0x01),				/**< Memory allocation failed. */
+	CMD_DEFERRED_SCHEDULED = CMD_DEFERRED_ERROR (0x02),				/**< The request has been scheduled for execution. */
+	CMD_DEFERRED_IN_PROGRESS = CMD_DEFERRED_ERROR (0x03),			/**< The request has not finished execution. */
+	CMD_DEFERRED_BUSY = CMD_DEFERRED_ERROR (0x04),					/**< A different request is being executed. */
+	CMD_DEFERRED_NO_REQUEST = CMD_DEFERRED_ERROR (0x05),			/**< There is no request waiting for execution. */
+};
+
+
+#endif /* CMD_DEFERRED_H_ */
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 #include "mctp/mctp_protocol.h"
 #include "cerberus_protocol.h"
 #include "cmd_interface.h"
@@ -55,3 +56,42 @@ int cmd_interface_process_request (struct cmd_interface *intf,
 
 	return 0;
 }
+
+/**
+ * Replace the contents of a request with a Cerberus protocol error message.
+ *
+ * @param intf The command interface generating the error.
+ * @param request The request to update with the error message.
+ * @param error_code Identifier for the error.
+ * @param error_data Data for the error condition.
+ * @param cmd_set Command set to respond on.
+ *
+ * @return 0 if the error message was successfully generated or an error code.
+ */
+int cmd_interface_generate_error_packet (struct cmd_interface *intf,
+	struct cmd_interface_request *request, uint8_t error_code, uint32_t error_data,
+	uint8_t cmd_set)
+{
+	struct cerberus_protocol_error *error_msg;
+
+	if ((intf == NULL) || (request == NULL)) {
+		return CMD_HANDLER_INVALID_ARGUMENT;
+	}
+
+	error_msg = (struct cerberus_protocol_error*) request->data;
+
+	memset (error_msg, 0, sizeof (struct cerberus_protocol_error));
+
+	error_msg->header.rq = cmd_set;
+	error_msg->header.msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	error_msg->header.pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	error_msg->header.command = CERBERUS_PROTOCOL_ERROR;
+
+	error_msg->error_code = error_code;
+	error_msg->error_data = error_data;
+
+	request->length = sizeof (struct cerberus_protocol_error);
+	request->new_request = false;
+
+	return 0;
+}
@@ -93,6 +93,9 @@ struct cmd_interface {
 /* Internal functions for use by derived types. */
 int cmd_interface_process_request (struct cmd_interface *intf,
 	struct cmd_interface_request *request, uint8_t *command_id, uint8_t *command_set);
+int cmd_interface_generate_error_packet (struct cmd_interface *intf,
+	struct cmd_interface_request *request, uint8_t error_code, uint32_t error_data,
+	uint8_t cmd_set);
 
 
 #define	CMD_HANDLER_ERROR(code)		ROT_ERROR (ROT_MODULE_CMD_HANDLER, code)
@@ -6,6 +6,7 @@
 #include <stdbool.h>
 #include <string.h>
 #include <math.h>
+#include "platform.h"
 #include "cmd_interface.h"
 #include "cerberus_protocol.h"
 #include "cerberus_protocol_required_commands.h"
@@ -13,33 +14,24 @@
 #include "cerberus_protocol_optional_commands.h"
 #include "cerberus_protocol_debug_commands.h"
 #include "cmd_interface_system.h"
+#include "common/type_cast.h"
+#include "logging/trace_buffer.h"
 
 
-int cmd_interface_system_process_request (struct cmd_interface *intf,
-	struct cmd_interface_request *request)
+/**
+ * Dispatch a received request to the appropriate command handler.
+ *
+ * @param interface The command interface processing the request.
+ * @param request The request to process.
+ * @param command_id The command ID of the request.
+ * @param device_num The device manager entry for the device that sent the request.
+ * @param direction The direction of the device that sent the request.
+ *
+ * @return 0 if the request was successfully processed or an error code.
+ */
+static int cmd_interface_system_process_command (struct cmd_interface_system *interface,
+	struct cmd_interface_request *request, uint8_t command_id, int device_num, int direction)
 {
-	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
-	uint8_t command_id;
-	uint8_t command_set;
-	int device_num;
-	int direction;
-	int status;
-
-	status = cmd_interface_process_request (&interface->base, request, &command_id, &command_set);
-	if (status != 0) {
-		return status;
-	}
-
-	device_num = device_manager_get_device_num (interface->device_manager, request->source_eid);
-	if (ROT_IS_ERROR (device_num)) {
-		return device_num;
-	}
-
-	direction = device_manager_get_device_direction (interface->device_manager, device_num);
-	if (ROT_IS_ERROR (direction)) {
-		return direction;
-	}
-
 	switch (command_id) {
 		case CERBERUS_PROTOCOL_GET_FW_VERSION:
 			return cerberus_protocol_get_fw_version (interface->fw_version, request);
@@ -205,6 +197,9 @@ int cmd_interface_system_process_request (struct cmd_interface *intf,
 		case CERBERUS_PROTOCOL_GET_DEVICE_ID:
 			return cerberus_protocol_get_device_id (&interface->device_id, request);
 
+		case CERBERUS_PROTOCOL_GET_COMMAND_STATS:
+			return cerberus_protocol_get_command_stats (&interface->stats, request);
+
 #ifdef ENABLE_DEBUG_COMMANDS
 		case CERBERUS_PROTOCOL_DEBUG_START_ATTESTATION:
 			return cerberus_protocol_start_attestation (request);
@@ -225,6 +220,9 @@ int cmd_interface_system_process_request (struct cmd_interface *intf,
 		case CERBERUS_PROTOCOL_DEBUG_GET_DEVICE_MANAGER_CHALLENGE:
 			return cerberus_protocol_get_device_challenge (interface->device_manager,
 				interface->master_attestation, interface->hash, request);
+
+		case CERBERUS_PROTOCOL_DEBUG_READ_TRACE:
+			return cerberus_protocol_debug_read_trace (request);
 #endif
 
 		default:
@@ -232,6 +230,168 @@ int cmd_interface_system_process_request (struct cmd_interface *intf,
 	}
 }
 
+/**
+ * Dispatch a request and record the processing statistics for the command.
+ *
+ * @param interface The command interface processing the request.
+ * @param request The request to process.
+ * @param command_id The command ID of the request.
+ * @param device_num The device manager entry for the device that sent the request.
+ * @param direction The direction of the device that sent the request.
+ *
+ * @return 0 if the request was successfully processed or an error code.
+ */
+static int cmd_interface_system_run_command (struct cmd_interface_system *interface,
+	struct cmd_interface_request *request, uint8_t command_id, int device_num, int direction)
+{
+	platform_clock start;
+	platform_clock end;
+	int status;
+
+	/* Commands can be run from both the task processing requests and the background task that
+	 * runs deferred requests.  Handlers share the same crypto and attestation engines, none of which
+	 * are safe for concurrent use, so only one command is executed at a time.  While a deferred
+	 * command is running, other requests wait for it to complete. */
+	platform_mutex_lock (&interface->lock);
+
+	platform_init_current_tick (&start);
+	TRACE_BEGIN (TRACE_EVENT_CMD_DISPATCH, command_id, 0);
+
+	status = cmd_interface_system_process_command (interface, request, command_id, device_num,
+		direction);
+
+	TRACE_END (TRACE_EVENT_CMD_DISPATCH, command_id, status);
+	platform_init_current_tick (&end);
+
+	platform_mutex_unlock (&interface->lock);
+
+	cmd_stats_record_command (&interface->stats, command_id, status,
+		platform_get_duration (&start, &end));
+
+	return status;
+}
+
+/**
+ * Execute a request that was deferred to the background context.
+ *
+ * @param deferred The deferred handler for the command interface.
+ * @param request The request to execute.
+ *
+ * @return 0 if the request was successfully processed or an error code.
+ */
+static int cmd_interface_system_execute_deferred (struct cmd_deferred *deferred,
+	struct cmd_interface_request *request)
+{
+	struct cmd_interface_system *interface =
+		TO_DERIVED_TYPE (deferred, struct cmd_interface_system, deferred);
+	struct cerberus_protocol_header *header = (struct cerberus_protocol_header*) request->data;
+	int device_num;
+
+	device_num = device_manager_get_device_num (interface->device_manager, request->source_eid);
+	if (ROT_IS_ERROR (device_num)) {
+		return device_num;
+	}
+
+	return cmd_interface_system_run_command (interface, request, header->command, device_num,
+		DEVICE_MANAGER_UPSTREAM);
+}
+
+/**
+ * Pass a request to the deferred handler.  If the request has not yet been completed, the request
+ * will be updated with a busy error response, indicating the requester should try again later.
+ *
+ * If the background task is busy with another operation, the request is also answered with a busy
+ * error rather than executing it immediately, since it would stall the caller for the full
+ * duration of the command.  Requests are only executed immediately if the background context
+ * doesn't support deferred commands.
+ *
+ * @param interface The command interface processing the request.
+ * @param request The request to defer.
+ * @param command_set The command set of the request.
+ * @param result Output for the processing result of the request.
+ *
+ * @return 0 if the request was handled by the deferred handler or an error code if the request
+ * must be processed immediately.
+ */
+static int cmd_interface_system_defer_command (struct cmd_interface_system *interface,
+	struct cmd_interface_request *request, uint8_t command_set, int *result)
+{
+	int status;
+
+	if (interface->background->run_deferred == NULL) {
+		return CMD_BACKGROUND_UNSUPPORTED_REQUEST;
+	}
+
+	status = cmd_deferred_submit (&interface->deferred, request, result);
+	if (status == CMD_DEFERRED_SCHEDULED) {
+		status = interface->background->run_deferred (interface->background,
+			&interface->deferred);
+		if (status != 0) {
+			cmd_deferred_cancel (&interface->deferred);
+			if (status != CMD_BACKGROUND_TASK_BUSY) {
+				return status;
+			}
+		}
+		else {
+			status = CMD_DEFERRED_SCHEDULED;
+		}
+	}
+
+	if ((status == CMD_DEFERRED_SCHEDULED) || (status == CMD_DEFERRED_IN_PROGRESS) ||
+		(status == CMD_DEFERRED_BUSY) || (status == CMD_BACKGROUND_TASK_BUSY)) {
+		*result = cmd_interface_generate_error_packet (&interface->base, request,
+			CERBERUS_PROTOCOL_ERROR_BUSY, status, command_set);
+		status = 0;
+	}
+
+	return status;
+}
+
+int cmd_interface_system_process_request (struct cmd_interface *intf,
+	struct cmd_interface_request *request)
+{
+	struct cmd_interface_system *interface = (struct cmd_interface_system*) intf;
+	uint8_t command_id;
+	uint8_t command_set;
+	int device_num;
+	int direction;
+	int result;
+	int status;
+
+	status = cmd_interface_process_request (&interface->base, request, &command_id, &command_set);
+	if (status != 0) {
+		return status;
+	}
+
+	device_num = device_manager_get_device_num (interface->device_manager, request->source_eid);
+	if (ROT_IS_ERROR (device_num)) {
+		return device_num;
+	}
+
+	direction = device_manager_get_device_direction (interface->device_manager, device_num);
+	if (ROT_IS_ERROR (direction)) {
+		return direction;
+	}
+
+	if ((direction == DEVICE_MANAGER_UPSTREAM) &&
+		cmd_deferred_is_command_enabled (&interface->deferred, command_id)) {
+		status = cmd_interface_system_defer_command (interface, request, command_set, &result);
+		if (status == 0) {
+			return result;
+		}
+	}
+
+	status = cmd_interface_system_run_command (interface, request, command_id, device_num,
+		direction);
+
+	if ((direction == DEVICE_MANAGER_DOWNSTREAM) && (interface->attestation_scheduler != NULL)) {
+		attestation_scheduler_response_received (interface->attestation_scheduler,
+			request->source_eid, command_id, status);
+	}
+
+	return status;
+}
+
 int cmd_interface_system_issue_request (struct cmd_interface *intf, uint8_t command_id,
 	void *request_params, uint8_t *buf, int buf_len)
 {
@@ -338,6 +498,8 @@ int cmd_interface_system_init (struct cmd_interface_system *intf,
 	struct recovery_image_manager *recovery_manager_1, struct cmd_device *cmd_device,
 	uint16_t vendor_id, uint16_t device_id, uint16_t subsystem_vid, uint16_t subsystem_id)
 {
+	int status;
+
 	if ((intf == NULL) || (control == NULL) || (store == NULL) || (background == NULL) ||
 		(riot == NULL) || (auth == NULL) || (master_attestation == NULL) ||
 		(slave_attestation == NULL) || (hash == NULL) || (device_manager == NULL) ||
@@ -347,6 +509,24 @@ int cmd_interface_system_init (struct cmd_interface_system *intf,
 
 	memset (intf, 0, sizeof (struct cmd_interface_system));
 
+	status = cmd_stats_init (&intf->stats);
+	if (status != 0) {
+		return status;
+	}
+
+	status = cmd_deferred_init (&intf->deferred, cmd_interface_system_execute_deferred);
+	if (status != 0) {
+		cmd_stats_release (&intf->stats);
+		return status;
+	}
+
+	status = platform_mutex_init (&intf->lock);
+	if (status != 0) {
+		cmd_deferred_release (&intf->deferred);
+		cmd_stats_release (&intf->stats);
+		return status;
+	}
+
 	intf->control = control;
 	intf->pfm_0 = pfm_0;
 	intf->pfm_1 = pfm_1;
@@ -394,6 +574,62 @@ int cmd_interface_system_init (struct cmd_interface_system *intf,
 void cmd_interface_system_deinit (struct cmd_interface_system *intf)
 {
 	if (intf != NULL) {
+		platform_mutex_free (&intf->lock);
+		cmd_deferred_release (&intf->deferred);
+		cmd_stats_release (&intf->stats);
 		memset (intf, 0, sizeof (struct cmd_interface_system));
 	}
 }
+
+/**
+ * Get the command processing statistics collected by the System command interface.
+ *
+ * @param intf The System command interface to query.
+ *
+ * @return The command statistics or null if the interface is not valid.
+ */
+struct cmd_stats* cmd_interface_system_get_stats (struct cmd_interface_system *intf)
+{
+	if (intf == NULL) {
+		return NULL;
+	}
+
+	return &intf->stats;
+}
+
+/**
+ * Get the handler for requests that are executed in the background by the System command
+ * interface.  Commands must be enabled on the handler before they will be deferred.
+ *
+ * @param intf The System command interface to query.
+ *
+ * @return The deferred command handler or null if the interface is not valid.
+ */
+struct cmd_deferred* cmd_interface_system_get_deferred (struct cmd_interface_system *intf)
+{
+	if (intf == NULL) {
+		return NULL;
+	}
+
+	return &intf->deferred;
+}
+
+/**
+ * Set the scheduler that drives attestation of downstream devices.  The scheduler will be notified
+ * of every attestation response received from a downstream device.
+ *
+ * @param intf The System command interface to update.
+ * @param scheduler The attestation scheduler to notify.  Set this to null to stop notifications.
+ *
+ * @return 0 if the scheduler was set or an error code.
+ */
+int cmd_interface_system_set_attestation_scheduler (struct cmd_interface_system *intf,
+	struct attestation_scheduler *scheduler)
+{
+	if (intf == NULL) {
+		return CMD_HANDLER_INVALID_ARGUMENT;
+	}
+
+	intf->attestation_scheduler = scheduler;
+	return 0;
+}
@@ -6,8 +6,10 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "platform.h"
 #include "attestation/attestation_master.h"
 #include "attestation/attestation_slave.h"
+#include "attestation/attestation_scheduler.h"
 #include "cmd_interface.h"
 #include "device_manager.h"
 #include "cmd_background.h"
@@ -23,6 +25,8 @@
 #include "recovery/recovery_image_manager.h"
 #include "recovery/recovery_image_cmd_interface.h"
 #include "cmd_device.h"
+#include "cmd_stats.h"
+#include "cmd_deferred.h"
 
 
 /**
@@ -58,6 +62,10 @@ struct cmd_interface_system {
 	struct recovery_image_cmd_interface *recovery_cmd_1;	/**< Recovery image update command interface instance for port 1 */
 	struct cmd_device *cmd_device;							/**< Device command handler instance */
 	struct cmd_interface_device_id device_id;				/**< Device ID information */
+	struct cmd_stats stats;									/**< Command processing statistics */
+	struct cmd_deferred deferred;							/**< Handler for commands executed in the background */
+	struct attestation_scheduler *attestation_scheduler;	/**< Scheduler tracking device attestation exchanges */
+	platform_mutex lock;									/**< Serialize command execution across tasks. */
 };
 
 
@@ -80,6 +88,11 @@ int cmd_interface_system_init (struct cmd_interface_system *intf,
 );
 void cmd_interface_system_deinit (struct cmd_interface_system *intf);
 
+struct cmd_stats* cmd_interface_system_get_stats (struct cmd_interface_system *intf);
+struct cmd_deferred* cmd_interface_system_get_deferred (struct cmd_interface_system *intf);
+int cmd_interface_system_set_attestation_scheduler (struct cmd_interface_system *intf,
+	struct attestation_scheduler *scheduler);
+
 /* Internal functions for use by derived types. */
 int cmd_interface_system_process_request (struct cmd_interface *intf,
 	struct cmd_interface_request *request);
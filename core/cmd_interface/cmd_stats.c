@@ -0,0 +1,241 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "cmd_stats.h"
+#include "cmd_interface.h"
+
+
+/**
+ * Initialize a container for command processing statistics.
+ *
+ * @param stats The statistics container to initialize.
+ *
+ * @return 0 if the statistics were successfully initialized or an error code.
+ */
+int cmd_stats_init (struct cmd_stats *stats)
+{
+	if (stats == NULL) {
+		return CMD_HANDLER_INVALID_ARGUMENT;
+	}
+
+	memset (stats, 0, sizeof (struct cmd_stats));
+
+	return platform_mutex_init (&stats->lock);
+}
+
+/**
+ * Release the resources used for command processing statistics.
+ *
+ * @param stats The statistics container to release.
+ */
+void cmd_stats_release (struct cmd_stats *stats)
+{
+	if (stats) {
+		platform_mutex_free (&stats->lock);
+	}
+}
+
+/**
+ * Determine the latency histogram bucket for a processing time.
+ *
+ * @param time_ms The processing time, in milliseconds.
+ *
+ * @return The histogram bucket for the time.
+ */
+static int cmd_stats_get_latency_bucket (uint32_t time_ms)
+{
+	int bucket = 0;
+
+	while ((time_ms != 0) && (bucket < (CMD_STATS_LATENCY_BUCKETS - 1))) {
+		time_ms >>= 1;
+		bucket++;
+	}
+
+	return bucket;
+}
+
+/**
+ * Record the result of processing a single command.
+ *
+ * @param stats The statistics container to update.
+ * @param command_id The ID of the command that was processed.
+ * @param status The status returned from processing the command.
+ * @param time_ms The amount of time spent processing the command, in milliseconds.
+ */
+void cmd_stats_record_command (struct cmd_stats *stats, uint8_t command_id, int status,
+	uint32_t time_ms)
+{
+	struct cmd_stats_command *entry;
+
+	if (stats == NULL) {
+		return;
+	}
+
+	platform_mutex_lock (&stats->lock);
+
+	if (stats->index[command_id] == 0) {
+		if (stats->count >= CMD_STATS_MAX_COMMANDS) {
+			stats->untracked++;
+			platform_mutex_unlock (&stats->lock);
+			return;
+		}
+
+		stats->index[command_id] = ++stats->count;
+	}
+
+	entry = &stats->command[stats->index[command_id] - 1];
+
+	entry->requests++;
+	if (status != 0) {
+		entry->failures++;
+	}
+
+	entry->total_time_ms += time_ms;
+	if (time_ms > entry->max_time_ms) {
+		entry->max_time_ms = time_ms;
+	}
+
+	entry->latency[cmd_stats_get_latency_bucket (time_ms)]++;
+
+	platform_mutex_unlock (&stats->lock);
+}
+
+/**
+ * Get the statistics collected for a single command ID.
+ *
+ * @param stats The statistics container to query.
+ * @param command_id The ID of the command to get statistics for.
+ * @param cmd_stats Output for the command statistics.  If the command has never been processed,
+ * all statistics will be 0.
+ *
+ * @return 0 if the statistics were retrieved successfully or an error code.
+ */
+int cmd_stats_get_command (struct cmd_stats *stats, uint8_t command_id,
+	struct cmd_stats_command *cmd_stats)
+{
+	if ((stats == NULL) || (cmd_stats == NULL)) {
+		return CMD_HANDLER_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&stats->lock);
+
+	if (stats->index[command_id] != 0) {
+		memcpy (cmd_stats, &stats->command[stats->index[command_id] - 1],
+			sizeof (struct cmd_stats_command));
+	}
+	else {
+		memset (cmd_stats, 0, sizeof (struct cmd_stats_command));
+	}
+
+	platform_mutex_unlock (&stats->lock);
+
+	return 0;
+}
+
+/**
+ * Get the number of requests that were not tracked due to lack of space for additional command
+ * IDs.
+ *
+ * @param stats The statistics container to query.
+ *
+ * @return The number of untracked requests or an error code.  Use ROT_IS_ERROR to check the
+ * return value.
+ */
+int cmd_stats_get_untracked (struct cmd_stats *stats)
+{
+	int untracked;
+
+	if (stats == NULL) {
+		return CMD_HANDLER_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&stats->lock);
+	untracked = stats->untracked & 0x7fffffff;
+	platform_mutex_unlock (&stats->lock);
+
+	return untracked;
+}
+
+/**
+ * Reset all collected command statistics.  Registered channels are not affected.
+ *
+ * @param stats The statistics container to clear.
+ */
+void cmd_stats_clear (struct cmd_stats *stats)
+{
+	if (stats) {
+		platform_mutex_lock (&stats->lock);
+
+		memset (stats->command, 0, sizeof (stats->command));
+		memset (stats->index, 0, sizeof (stats->index));
+		stats->count = 0;
+		stats->untracked = 0;
+
+		platform_mutex_unlock (&stats->lock);
+	}
+}
+
+/**
+ * Register a command channel so its packet counters can be reported along with the command
+ * statistics.
+ *
+ * @param stats The statistics container to update.
+ * @param channel The command channel to register.
+ *
+ * @return 0 if the channel was registered successfully or an error code.
+ */
+int cmd_stats_add_channel (struct cmd_stats *stats, struct cmd_channel *channel)
+{
+	int i;
+
+	if ((stats == NULL) || (channel == NULL)) {
+		return CMD_HANDLER_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&stats->lock);
+
+	for (i = 0; i < CMD_STATS_MAX_CHANNELS; i++) {
+		if ((stats->channel[i] == NULL) || (stats->channel[i] == channel)) {
+			stats->channel[i] = channel;
+			platform_mutex_unlock (&stats->lock);
+			return 0;
+		}
+	}
+
+	platform_mutex_unlock (&stats->lock);
+
+	return CMD_HANDLER_NO_MEMORY;
+}
+
+/**
+ * Find a registered command channel.
+ *
+ * @param stats The statistics container to query.
+ * @param channel_id The ID of the channel to find.
+ *
+ * @return The registered channel with the specified ID or null if there is no such channel.
+ */
+struct cmd_channel* cmd_stats_get_channel (struct cmd_stats *stats, int channel_id)
+{
+	struct cmd_channel *channel = NULL;
+	int i;
+
+	if (stats == NULL) {
+		return NULL;
+	}
+
+	platform_mutex_lock (&stats->lock);
+
+	for (i = 0; (i < CMD_STATS_MAX_CHANNELS) && (channel == NULL); i++) {
+		if (stats->channel[i] && (stats->channel[i]->id == channel_id)) {
+			channel = stats->channel[i];
+		}
+	}
+
+	platform_mutex_unlock (&stats->lock);
+
+	return channel;
+}
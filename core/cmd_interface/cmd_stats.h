@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef CMD_STATS_H_
+#define CMD_STATS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "platform.h"
+#include "cmd_channel.h"
+
+
+/**
+ * The maximum number of different command IDs that will be tracked.  Commands received after this
+ * many unique IDs have been seen will only be counted in the total of untracked requests.
+ */
+#ifndef CMD_STATS_MAX_COMMANDS
+#define	CMD_STATS_MAX_COMMANDS				64
+#endif
+
+/**
+ * The maximum number of command channels that can be registered for reporting.
+ */
+#ifndef CMD_STATS_MAX_CHANNELS
+#define	CMD_STATS_MAX_CHANNELS				4
+#endif
+
+/**
+ * The number of buckets in each latency histogram.  Bucket 0 counts requests that completed in
+ * less than 1 ms.  Bucket N counts requests that took at least 2^(N-1) ms and less than 2^N ms.
+ * The last bucket counts all requests that took longer than that.
+ */
+#define	CMD_STATS_LATENCY_BUCKETS			12
+
+
+/**
+ * Statistics collected for a single command ID.
+ */
+struct cmd_stats_command {
+	uint32_t requests;									/**< Total number of requests processed. */
+	uint32_t failures;									/**< Number of requests that returned an error. */
+	uint32_t total_time_ms;								/**< Total processing time for all requests. */
+	uint32_t max_time_ms;								/**< Longest processing time for a single request. */
+	uint32_t latency[CMD_STATS_LATENCY_BUCKETS];		/**< Log2 histogram of processing times. */
+};
+
+/**
+ * Statistics collected for command processing.
+ */
+struct cmd_stats {
+	struct cmd_stats_command command[CMD_STATS_MAX_COMMANDS];	/**< Statistics for each tracked command. */
+	uint8_t index[256];									/**< Map of command ID to tracking slot.  0 is unused. */
+	uint8_t count;										/**< Number of command IDs being tracked. */
+	uint32_t untracked;									/**< Requests for command IDs that could not be tracked. */
+	struct cmd_channel *channel[CMD_STATS_MAX_CHANNELS];	/**< Channels registered for reporting. */
+	platform_mutex lock;								/**< Synchronization for statistics updates. */
+};
+
+
+int cmd_stats_init (struct cmd_stats *stats);
+void cmd_stats_release (struct cmd_stats *stats);
+
+void cmd_stats_record_command (struct cmd_stats *stats, uint8_t command_id, int status,
+	uint32_t time_ms);
+int cmd_stats_get_command (struct cmd_stats *stats, uint8_t command_id,
+	struct cmd_stats_command *cmd_stats);
+int cmd_stats_get_untracked (struct cmd_stats *stats);
+void cmd_stats_clear (struct cmd_stats *stats);
+
+int cmd_stats_add_channel (struct cmd_stats *stats, struct cmd_channel *channel);
+struct cmd_channel* cmd_stats_get_channel (struct cmd_stats *stats, int channel_id);
+
+
+#endif /* CMD_STATS_H_ */
@@ -588,6 +588,7 @@ int device_manager_init_cert_chain (struct device_manager *mgr, int device_num,
 	}
 
 	device_manager_release_cert_chain (mgr, device_num);
+	mgr->entries[device_num].cert_chain.generation++;
 
 	mgr->entries[device_num].cert_chain.cert = platform_calloc (num_cert, sizeof (struct der_cert));
 
@@ -627,6 +628,7 @@ int device_manager_update_cert (struct device_manager *mgr, int device_num, uint
 	}
 
 	device_manager_release_cert (&mgr->entries[device_num].cert_chain.cert[cert_num]);
+	mgr->entries[device_num].cert_chain.generation++;
 
 	mgr->entries[device_num].cert_chain.cert[cert_num].cert = platform_malloc (buf_len);
 
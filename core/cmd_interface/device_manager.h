@@ -139,6 +139,7 @@ struct device_manager_info {
 struct device_manager_cert_chain {
 	struct der_cert *cert;								/**< Certificate. */
 	uint8_t num_cert;									/**< Number of certificates in chain. */
+	uint32_t generation;								/**< Counter incremented when the chain is modified. */
 };
 
 /**
@@ -32,7 +32,7 @@ static int aes_mbedtls_set_key (struct aes_engine *engine, const uint8_t *key, s
 
 	status = mbedtls_gcm_setkey (&mbedtls->context, MBEDTLS_CIPHER_ID_AES, key, 256);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_AES_GCM_INIT_EC, status, 0);
 
 		return status;
@@ -64,7 +64,7 @@ static int aes_mbedtls_encrypt_data (struct aes_engine *engine, const uint8_t *p
 	status = mbedtls_gcm_crypt_and_tag (&mbedtls->context, MBEDTLS_GCM_ENCRYPT, length, iv,
 		iv_length, NULL, 0, plaintext, ciphertext, 16, tag);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_AES_GCM_CRYPT_EC, status, 0);
 
 		return status;
@@ -97,7 +97,7 @@ static int aes_mbedtls_decrypt_data (struct aes_engine *engine, const uint8_t *c
 		ciphertext, plaintext);
 
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_AES_GCM_AUTH_DECRYPT_EC, status, 0);
 
 		if (status == MBEDTLS_ERR_GCM_AUTH_FAILED) {
@@ -53,6 +53,8 @@ enum {
 	CRYPTO_LOG_MSG_MBEDTLS_RSA_OAEP_DECRYPT_EC,				/**< mbedTLS failure during RSA OAEP decryption */
 	CRYPTO_LOG_MSG_MBEDTLS_X509_ADD_TCBINFO_EC,				/**< mbedTLS failure during X509 TCB Info addition */
 	CRYPTO_LOG_MSG_MBEDTLS_X509_ADD_UEID_EC,				/**< mbedTLS failure during X509 UEID addition */
+	CRYPTO_LOG_MSG_MBEDTLS_ECDSA_PRECOMPUTE_EC,				/**< mbedTLS failure during ECDSA signature precomputation */
+	CRYPTO_LOG_MSG_MBEDTLS_ECDSA_SIGN_PRECOMPUTED_EC,		/**< mbedTLS failure during ECDSA signing with precomputed values */
 };
 
 #endif //CRYPTO_LOGGING_H_
@@ -165,6 +165,22 @@ struct ecc_engine {
 	int (*sign) (struct ecc_engine *engine, struct ecc_private_key *key, const uint8_t *digest,
 		size_t length, uint8_t *signature, size_t sig_length);
 
+	/**
+	 * Precompute the random per-signature values needed to create ECDSA signatures with a key.
+	 * Subsequent calls to sign with a key on the same curve will consume the precomputed values,
+	 * reducing signing to a few modular operations.  Each precomputed value is only used for a
+	 * single signature.  This is intended to be called when the system is otherwise idle.
+	 *
+	 * @param engine The ECC engine to use for precomputation.
+	 * @param key The private key that will be used for signing.
+	 * @param count The maximum number of signatures to precompute values for.  Fewer values will
+	 * be generated if the engine has no more space available to store them.
+	 *
+	 * @return The number of signatures that values were precomputed for or an error code.  Use
+	 * ROT_IS_ERROR to check the return value.
+	 */
+	int (*precompute_sign) (struct ecc_engine *engine, struct ecc_private_key *key, size_t count);
+
 	/**
 	 * Verify an ECDSA signature against a SHA-256 message digest.
 	 *
@@ -237,6 +253,7 @@ enum {
 	ECC_ENGINE_HW_NOT_INIT = ECC_ENGINE_ERROR (0x11),				/**< The ECC hardware has not been initialized. */
 	ECC_ENGINE_SIG_LENGTH_FAILED = ECC_ENGINE_ERROR (0x12),			/**< Failed to get the maximum signature length. */
 	ECC_ENGINE_SECRET_LENGTH_FAILED = ECC_ENGINE_ERROR (0x13),		/**< Failed to get the maximum shared secret length. */
+	ECC_ENGINE_PRECOMPUTE_FAILED = ECC_ENGINE_ERROR (0x14),			/**< Failed to precompute values for signing. */
 };
 
 
@@ -12,7 +12,9 @@
 #include "mbedtls/ecdsa.h"
 #include "mbedtls/ecdh.h"
 #include "mbedtls/bignum.h"
+#include "mbedtls/asn1write.h"
 #include "logging/debug_log.h"
+#include "logging/trace_buffer.h"
 #include "crypto/crypto_logging.h"
 #include "common/unused.h"
 
@@ -115,7 +117,7 @@ error_exit:
 	ecc_mbedtls_free_key_context (pub);
 	*error = status;
 
-	debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+	DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 		msg_code, status, 0);
 error_alloc:
 	return NULL;
@@ -149,7 +151,7 @@ static int ecc_mbedtls_init_key_pair (struct ecc_engine *engine, const uint8_t *
 
 	status = mbedtls_pk_parse_key (key_ctx, key, key_length, NULL, 0);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_PK_PARSE_EC, status, 0);
 
 		goto error;
@@ -197,7 +199,7 @@ static int ecc_mbedtls_init_public_key (struct ecc_engine *engine, const uint8_t
 
 	status = mbedtls_pk_parse_public_key (key_ctx, key, key_length);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_PK_PARSE_PUB_EC, status, 0);
 
 		goto error;
@@ -294,7 +296,7 @@ static int ecc_mbedtls_generate_derived_key_pair (struct ecc_engine *engine, con
 	return 0;
 
 error_log:
-	debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+	DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 		msg_code, status, 0);
 
 error:
@@ -359,7 +361,7 @@ static int ecc_mbedtls_generate_key_pair (struct ecc_engine *engine,
 	return 0;
 
 error_log:
-	debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+	DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 		msg_code, status, 0);
 
 error:
@@ -427,7 +429,7 @@ static int ecc_mbedtls_get_private_key_der (struct ecc_engine *engine,
 		status = 0;
 	}
 	else {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_PK_WRITE_KEY_DER_EC, status, 0);
 	}
 
@@ -466,7 +468,7 @@ static int ecc_mbedtls_get_public_key_der (struct ecc_engine *engine,
 		status = 0;
 	}
 	else {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_PK_WRITE_PUBKEY_DER_EC, status, 0);
 	}
 
@@ -474,6 +476,130 @@ static int ecc_mbedtls_get_public_key_der (struct ecc_engine *engine,
 }
 #endif
 
+/**
+ * Encode an ECDSA signature as a DER sequence of the r and s values.
+ *
+ * @param r The signature r value.
+ * @param s The signature s value.
+ * @param signature Output buffer for the encoded signature.  This must be large enough to hold the
+ * maximum signature length for the key.
+ *
+ * @return The length of the encoded signature or an error code.
+ */
+static int ecc_mbedtls_write_signature (const mbedtls_mpi *r, const mbedtls_mpi *s,
+	uint8_t *signature)
+{
+	uint8_t der[MBEDTLS_ECDSA_MAX_LEN];
+	uint8_t *pos = der + sizeof (der);
+	size_t length = 0;
+	int ret;
+
+	MBEDTLS_ASN1_CHK_ADD (length, mbedtls_asn1_write_mpi (&pos, der, s));
+	MBEDTLS_ASN1_CHK_ADD (length, mbedtls_asn1_write_mpi (&pos, der, r));
+	MBEDTLS_ASN1_CHK_ADD (length, mbedtls_asn1_write_len (&pos, der, length));
+	MBEDTLS_ASN1_CHK_ADD (length, mbedtls_asn1_write_tag (&pos, der,
+		MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE));
+
+	memcpy (signature, pos, length);
+	return length;
+}
+
+/**
+ * Create an ECDSA signature using the most recently precomputed signing values.  The precomputed
+ * values are consumed and zeroized, even if the signature fails.
+ *
+ * @param mbedtls The ECC engine with the precomputed values.
+ * @param ec The private key to sign with.
+ * @param digest The message digest to sign.
+ * @param length The length of the digest.
+ * @param signature Output buffer for the ECDSA signature.  This must be large enough to hold the
+ * maximum signature length for the key.
+ *
+ * @return The length of the signature or an error code.
+ */
+static int ecc_mbedtls_sign_precomputed (struct ecc_engine_mbedtls *mbedtls,
+	mbedtls_ecp_keypair *ec, const uint8_t *digest, size_t length, uint8_t *signature)
+{
+	struct ecc_mbedtls_sign_precompute *entry;
+	size_t n_bits = mbedtls_mpi_bitlen (&ec->grp.N);
+	size_t n_bytes = (n_bits + 7) / 8;
+	mbedtls_mpi e;
+	mbedtls_mpi s;
+	int status;
+
+	mbedtls->sign_pool_count--;
+	entry = &mbedtls->sign_pool[mbedtls->sign_pool_count];
+
+	mbedtls_mpi_init (&e);
+	mbedtls_mpi_init (&s);
+
+	/* Convert the digest to an integer, truncated to the bit length of the group order. */
+	if (length > n_bytes) {
+		length = n_bytes;
+	}
+
+	status = mbedtls_mpi_read_binary (&e, digest, length);
+	if ((status == 0) && ((length * 8) > n_bits)) {
+		status = mbedtls_mpi_shift_r (&e, (length * 8) - n_bits);
+	}
+	if ((status == 0) && (mbedtls_mpi_cmp_mpi (&e, &ec->grp.N) >= 0)) {
+		status = mbedtls_mpi_sub_mpi (&e, &e, &ec->grp.N);
+	}
+	if (status != 0) {
+		goto exit;
+	}
+
+	/* s = k^-1 * (e + r * d) mod n, computed as (b * e + (b * r) * d) * (k * b)^-1 mod n with the
+	 * random blinding value b.  Neither the private key nor the digest is used directly in the
+	 * signing arithmetic. */
+	status = mbedtls_mpi_mul_mpi (&s, &entry->r, &entry->blind);
+	if (status == 0) {
+		status = mbedtls_mpi_mod_mpi (&s, &s, &ec->grp.N);
+	}
+	if (status == 0) {
+		status = mbedtls_mpi_mul_mpi (&s, &s, &ec->d);
+	}
+	if (status == 0) {
+		status = mbedtls_mpi_mul_mpi (&e, &e, &entry->blind);
+	}
+	if (status == 0) {
+		status = mbedtls_mpi_add_mpi (&s, &s, &e);
+	}
+	if (status == 0) {
+		status = mbedtls_mpi_mod_mpi (&s, &s, &ec->grp.N);
+	}
+	if (status == 0) {
+		status = mbedtls_mpi_mul_mpi (&s, &s, &entry->k_inv);
+	}
+	if (status == 0) {
+		status = mbedtls_mpi_mod_mpi (&s, &s, &ec->grp.N);
+	}
+	if (status != 0) {
+		goto exit;
+	}
+
+	if (mbedtls_mpi_cmp_int (&s, 0) == 0) {
+		status = ECC_ENGINE_SIGN_FAILED;
+		goto exit;
+	}
+
+	status = ecc_mbedtls_write_signature (&entry->r, &s, signature);
+
+exit:
+	mbedtls_mpi_lset (&entry->k_inv, 0);
+	mbedtls_mpi_lset (&entry->r, 0);
+	mbedtls_mpi_lset (&entry->blind, 0);
+	mbedtls_mpi_free (&e);
+	mbedtls_mpi_free (&s);
+
+	if (ROT_IS_ERROR (status)) {
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+			CRYPTO_LOG_MSG_MBEDTLS_ECDSA_SIGN_PRECOMPUTED_EC, status, 0);
+	}
+
+	return status;
+}
+
 static int ecc_mbedtls_sign (struct ecc_engine *engine, struct ecc_private_key *key,
 	const uint8_t *digest, size_t length, uint8_t *signature, size_t sig_length)
 {
@@ -493,23 +619,111 @@ static int ecc_mbedtls_sign (struct ecc_engine *engine, struct ecc_private_key *
 	ec = ecc_mbedtls_get_ec_key_pair (key);
 	status = mbedtls_ecp_check_privkey (&ec->grp, &ec->d);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_ECP_CHECK_PUB_PRV_EC, status, 0);
 
 		return status;
 	}
 
+	if ((mbedtls->sign_pool_count != 0) &&
+		(mbedtls->sign_pool[mbedtls->sign_pool_count - 1].curve == ec->grp.id)) {
+		TRACE_BEGIN (TRACE_EVENT_ECC_SIGN, length, 0);
+		status = ecc_mbedtls_sign_precomputed (mbedtls, ec, digest, length, signature);
+		TRACE_END (TRACE_EVENT_ECC_SIGN, length, status);
+
+		return status;
+	}
+
+	TRACE_BEGIN (TRACE_EVENT_ECC_SIGN, length, 0);
 	status = mbedtls_pk_sign ((mbedtls_pk_context*) key->context, MBEDTLS_MD_SHA256, digest, length,
 		signature, &sig_length, mbedtls_ctr_drbg_random, &mbedtls->ctr_drbg);
+	TRACE_END (TRACE_EVENT_ECC_SIGN, length, status);
 
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_PK_SIGN_EC, status, 0);
 	}
 
 	return (status == 0) ? sig_length : status;
 }
 
+static int ecc_mbedtls_precompute_sign (struct ecc_engine *engine, struct ecc_private_key *key,
+	size_t count)
+{
+	struct ecc_engine_mbedtls *mbedtls = (struct ecc_engine_mbedtls*) engine;
+	struct ecc_mbedtls_sign_precompute *entry;
+	mbedtls_ecp_keypair *ec;
+	mbedtls_ecp_point R;
+	mbedtls_mpi k;
+	size_t added = 0;
+	int status = 0;
+
+	if ((mbedtls == NULL) || (key == NULL)) {
+		return ECC_ENGINE_INVALID_ARGUMENT;
+	}
+
+	ec = ecc_mbedtls_get_ec_key_pair (key);
+
+	mbedtls_ecp_point_init (&R);
+	mbedtls_mpi_init (&k);
+
+	while ((added < count) && (mbedtls->sign_pool_count < ECC_MBEDTLS_SIGN_POOL_SIZE)) {
+		entry = &mbedtls->sign_pool[mbedtls->sign_pool_count];
+
+		/* Generate a random nonce k and the signature value r = (k * G).x mod n. */
+		do {
+			status = mbedtls_ecp_gen_keypair (&ec->grp, &k, &R, mbedtls_ctr_drbg_random,
+				&mbedtls->ctr_drbg);
+			if (status == 0) {
+				status = mbedtls_mpi_mod_mpi (&entry->r, &R.X, &ec->grp.N);
+			}
+			if (status != 0) {
+				goto exit;
+			}
+		} while (mbedtls_mpi_cmp_int (&entry->r, 0) == 0);
+
+		/* Generate the random blinding value b used when signing.  The stored inverse is
+		 * (k * b)^-1, so the nonce is also blinded during modular inversion, and a signature
+		 * computed from the blinded private key and digest is unblinded by the same value. */
+		status = mbedtls_ecp_gen_privkey (&ec->grp, &entry->blind, mbedtls_ctr_drbg_random,
+			&mbedtls->ctr_drbg);
+		if (status == 0) {
+			status = mbedtls_mpi_mul_mpi (&k, &k, &entry->blind);
+		}
+		if (status == 0) {
+			status = mbedtls_mpi_mod_mpi (&k, &k, &ec->grp.N);
+		}
+		if (status == 0) {
+			status = mbedtls_mpi_inv_mod (&entry->k_inv, &k, &ec->grp.N);
+		}
+		if (status != 0) {
+			goto exit;
+		}
+
+		entry->curve = ec->grp.id;
+		mbedtls->sign_pool_count++;
+		added++;
+	}
+
+exit:
+	mbedtls_ecp_point_free (&R);
+	mbedtls_mpi_free (&k);
+
+	if (status != 0) {
+		entry = &mbedtls->sign_pool[mbedtls->sign_pool_count];
+		mbedtls_mpi_lset (&entry->k_inv, 0);
+		mbedtls_mpi_lset (&entry->r, 0);
+		mbedtls_mpi_lset (&entry->blind, 0);
+
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+			CRYPTO_LOG_MSG_MBEDTLS_ECDSA_PRECOMPUTE_EC, status, 0);
+
+		return status;
+	}
+
+	return added;
+}
+
 static int ecc_mbedtls_verify (struct ecc_engine *engine, struct ecc_public_key *key,
 	const uint8_t *digest, size_t length, const uint8_t *signature, size_t sig_length)
 {
@@ -520,10 +734,13 @@ static int ecc_mbedtls_verify (struct ecc_engine *engine, struct ecc_public_key
 		return ECC_ENGINE_INVALID_ARGUMENT;
 	}
 
+	TRACE_BEGIN (TRACE_EVENT_ECC_VERIFY, length, 0);
 	status = mbedtls_pk_verify ((mbedtls_pk_context*) key->context, MBEDTLS_MD_SHA256, digest,
 		length, signature, sig_length);
+	TRACE_END (TRACE_EVENT_ECC_VERIFY, length, status);
+
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_PK_VERIFY_EC, status, 0);
 
 		if ((status == MBEDTLS_ERR_MPI_ALLOC_FAILED) ||
@@ -571,7 +788,7 @@ static int ecc_mbedtls_compute_shared_secret (struct ecc_engine *engine,
 	status = mbedtls_ecdh_compute_shared (&priv_ec->grp, &out, &pub_ec->Q, &priv_ec->d,
 		mbedtls_ctr_drbg_random, &mbedtls->ctr_drbg);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_ECDH_COMPUTE_SHARED_SECRET_EC, status, 0);
 
 		goto error;
@@ -603,6 +820,7 @@ error:
  */
 int ecc_mbedtls_init (struct ecc_engine_mbedtls *engine)
 {
+	int i;
 	int status;
 
 	if (engine == NULL) {
@@ -614,10 +832,16 @@ int ecc_mbedtls_init (struct ecc_engine_mbedtls *engine)
 	mbedtls_ctr_drbg_init (&engine->ctr_drbg);
 	mbedtls_entropy_init (&engine->entropy);
 
+	for (i = 0; i < ECC_MBEDTLS_SIGN_POOL_SIZE; i++) {
+		mbedtls_mpi_init (&engine->sign_pool[i].k_inv);
+		mbedtls_mpi_init (&engine->sign_pool[i].r);
+		mbedtls_mpi_init (&engine->sign_pool[i].blind);
+	}
+
 	status = mbedtls_ctr_drbg_seed (&engine->ctr_drbg, mbedtls_entropy_func, &engine->entropy, NULL,
 		0);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_CTR_DRBG_SEED_EC, status, 0);
 
 		goto exit;
@@ -636,6 +860,7 @@ int ecc_mbedtls_init (struct ecc_engine_mbedtls *engine)
 	engine->base.get_public_key_der = ecc_mbedtls_get_public_key_der;
 #endif
 	engine->base.sign = ecc_mbedtls_sign;
+	engine->base.precompute_sign = ecc_mbedtls_precompute_sign;
 	engine->base.verify = ecc_mbedtls_verify;
 #ifdef ECC_ENABLE_ECDH
 	engine->base.get_shared_secret_max_length = ecc_mbedtls_get_shared_secret_max_length;
@@ -645,8 +870,7 @@ int ecc_mbedtls_init (struct ecc_engine_mbedtls *engine)
 	return 0;
 
 exit:
-	mbedtls_entropy_free (&engine->entropy);
-	mbedtls_ctr_drbg_free (&engine->ctr_drbg);
+	ecc_mbedtls_release (engine);
 	return status;
 }
 
@@ -657,8 +881,17 @@ exit:
  */
 void ecc_mbedtls_release (struct ecc_engine_mbedtls *engine)
 {
+	int i;
+
 	if (engine) {
 		mbedtls_entropy_free (&engine->entropy);
 		mbedtls_ctr_drbg_free (&engine->ctr_drbg);
+
+		for (i = 0; i < ECC_MBEDTLS_SIGN_POOL_SIZE; i++) {
+			mbedtls_mpi_free (&engine->sign_pool[i].k_inv);
+			mbedtls_mpi_free (&engine->sign_pool[i].r);
+			mbedtls_mpi_free (&engine->sign_pool[i].blind);
+		}
+		engine->sign_pool_count = 0;
 	}
 }
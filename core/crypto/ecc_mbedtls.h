@@ -7,8 +7,26 @@
 #include "ecc.h"
 #include "mbedtls/ctr_drbg.h"
 #include "mbedtls/entropy.h"
+#include "mbedtls/ecp.h"
+#include "mbedtls/bignum.h"
 
 
+/* Configurable ECC parameters.  Defaults can be overridden in platform_config.h. */
+#ifndef ECC_MBEDTLS_SIGN_POOL_SIZE
+#define	ECC_MBEDTLS_SIGN_POOL_SIZE		4
+#endif
+
+
+/**
+ * Values precomputed for a single ECDSA signature.
+ */
+struct ecc_mbedtls_sign_precompute {
+	mbedtls_ecp_group_id curve;			/**< The curve the values were computed for. */
+	mbedtls_mpi k_inv;					/**< The inverse of the blinded nonce, (k * b)^-1. */
+	mbedtls_mpi r;						/**< The signature r value for the random nonce. */
+	mbedtls_mpi blind;					/**< Random value b to blind the private key operation. */
+};
+
 /**
  * An mbedTLS context for ECC operations.
  */
@@ -16,6 +34,8 @@ struct ecc_engine_mbedtls {
 	struct ecc_engine base;				/**< The base ECC engine. */
 	mbedtls_ctr_drbg_context ctr_drbg;	/**< A random number generator for the engine. */
 	mbedtls_entropy_context entropy;	/**< Entropy source for the random number generator. */
+	struct ecc_mbedtls_sign_precompute sign_pool[ECC_MBEDTLS_SIGN_POOL_SIZE];	/**< Precomputed signatures. */
+	size_t sign_pool_count;				/**< Number of precomputed signing values available. */
 };
 
 
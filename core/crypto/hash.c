@@ -41,6 +41,41 @@ int hash_start_new_hash (struct hash_engine *engine, enum hash_type type)
 	return status;
 }
 
+/**
+ * Calculate SHA-256 hashes on multiple independent sets of data.  If the hash engine doesn't
+ * support multi-buffer hashing, each hash will be calculated individually.
+ *
+ * @param engine The hash engine to use to calculate the hashes.
+ * @param buffers The list of data to hash and the output buffers for each hash.
+ * @param count The number of entries in the list.
+ *
+ * @return 0 if all hashes calculated successfully or an error code.
+ */
+int hash_calculate_sha256_multi (struct hash_engine *engine,
+	const struct hash_multi_buffer *buffers, size_t count)
+{
+	size_t i;
+	int status;
+
+	if ((engine == NULL) || (buffers == NULL) || (count == 0)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (engine->calculate_sha256_multi) {
+		return engine->calculate_sha256_multi (engine, buffers, count);
+	}
+
+	for (i = 0; i < count; i++) {
+		status = engine->calculate_sha256 (engine, buffers[i].data, buffers[i].length,
+			buffers[i].hash, buffers[i].hash_length);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	return 0;
+}
+
 /**
  * Generate an HMAC for a block of data.
  *
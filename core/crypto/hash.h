@@ -32,6 +32,16 @@ enum hash_type {
 	HASH_TYPE_SHA256		/**< SHA-256 hash */
 };
 
+/**
+ * A single set of data to hash as part of a multi-buffer hash calculation.
+ */
+struct hash_multi_buffer {
+	const uint8_t *data;		/**< The data to hash. */
+	size_t length;				/**< The length of the data. */
+	uint8_t *hash;				/**< The buffer that will contain the generated hash. */
+	size_t hash_length;			/**< The size of the hash buffer. */
+};
+
 /**
  * A platform-independent API for calculating hashes.  Hash engine instances are not guaranteed to
  * be thread-safe across different API calls.
@@ -83,6 +93,25 @@ struct hash_engine {
 	int (*calculate_sha256) (struct hash_engine *engine, const uint8_t *data, size_t length,
 		uint8_t *hash, size_t hash_length);
 
+	/**
+	 * Calculate SHA-256 hashes on multiple independent sets of data.  The result for each set of
+	 * data is the same as calling calculate_sha256 on it, but an engine may process the data in
+	 * parallel.
+	 *
+	 * This is optional and will be null for engines that can't hash multiple sets of data any
+	 * faster than hashing them one at a time.  Use hash_calculate_sha256_multi to fall back to
+	 * calculate_sha256 when necessary.
+	 *
+	 * @param engine The hash engine to use to calculate the hashes.
+	 * @param buffers The list of data to hash and the output buffers for each hash.
+	 * @param count The number of entries in the list.
+	 *
+	 * @return 0 if all hashes calculated successfully or an error code.  If an error is returned,
+	 * the contents of all hash buffers are undefined.
+	 */
+	int (*calculate_sha256_multi) (struct hash_engine *engine,
+		const struct hash_multi_buffer *buffers, size_t count);
+
 	/**
 	 * Configure the hash engine to process independent blocks of data to calculate a SHA-256 hash
 	 * the aggregated data.
@@ -133,6 +162,8 @@ struct hash_engine {
 
 
 int hash_start_new_hash (struct hash_engine *engine, enum hash_type type);
+int hash_calculate_sha256_multi (struct hash_engine *engine,
+	const struct hash_multi_buffer *buffers, size_t count);
 
 
 /* HMAC functions */
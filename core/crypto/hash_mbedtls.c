@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "hash_mbedtls.h"
+#include "logging/trace_buffer.h"
 
 
 /**
@@ -42,7 +43,9 @@ static int hash_mbedtls_calculate_sha1 (struct hash_engine *engine, const uint8_
 		return HASH_ENGINE_HASH_BUFFER_TOO_SMALL;
 	}
 
+	TRACE_BEGIN (TRACE_EVENT_HASH, HASH_ACTIVE_SHA1, 0);
 	mbedtls_sha1 (data, length, hash);
+	TRACE_END (TRACE_EVENT_HASH, HASH_ACTIVE_SHA1, 0);
 
 	return 0;
 }
@@ -61,6 +64,8 @@ static int hash_mbedtls_start_sha1 (struct hash_engine *engine)
 	mbedtls_sha1_starts (&mbedtls->context.sha1);
 	mbedtls->active = HASH_ACTIVE_SHA1;
 
+	TRACE_BEGIN (TRACE_EVENT_HASH, HASH_ACTIVE_SHA1, 0);
+
 	return 0;
 }
 #endif
@@ -78,7 +83,9 @@ static int hash_mbedtls_calculate_sha256 (struct hash_engine *engine, const uint
 		return HASH_ENGINE_HASH_BUFFER_TOO_SMALL;
 	}
 
+	TRACE_BEGIN (TRACE_EVENT_HASH, HASH_ACTIVE_SHA256, 0);
 	mbedtls_sha256 (data, length, hash, 0);
+	TRACE_END (TRACE_EVENT_HASH, HASH_ACTIVE_SHA256, 0);
 
 	return 0;
 }
@@ -97,6 +104,8 @@ static int hash_mbedtls_start_sha256 (struct hash_engine *engine)
 	mbedtls_sha256_starts (&mbedtls->context.sha256, 0);
 	mbedtls->active = HASH_ACTIVE_SHA256;
 
+	TRACE_BEGIN (TRACE_EVENT_HASH, HASH_ACTIVE_SHA256, 0);
+
 	return 0;
 }
 
@@ -157,6 +166,8 @@ static int hash_mbedtls_finish (struct hash_engine *engine, uint8_t *hash, size_
 			return HASH_ENGINE_NO_ACTIVE_HASH;
 	}
 
+	TRACE_END (TRACE_EVENT_HASH, mbedtls->active, 0);
+
 	mbedtls->active = HASH_ACTIVE_NONE;
 	return 0;
 }
@@ -166,6 +177,10 @@ static void hash_mbedtls_cancel (struct hash_engine *engine)
 	struct hash_engine_mbedtls *mbedtls = (struct hash_engine_mbedtls*) engine;
 
 	if (mbedtls) {
+		if (mbedtls->active != HASH_ACTIVE_NONE) {
+			TRACE_END (TRACE_EVENT_HASH, mbedtls->active, 0);
+		}
+
 		mbedtls->active = HASH_ACTIVE_NONE;
 	}
 }
@@ -190,6 +205,7 @@ int hash_mbedtls_init (struct hash_engine_mbedtls *engine)
 	engine->base.start_sha1 = hash_mbedtls_start_sha1;
 #endif
 	engine->base.calculate_sha256 = hash_mbedtls_calculate_sha256;
+	engine->base.calculate_sha256_multi = NULL;
 	engine->base.start_sha256 = hash_mbedtls_start_sha256;
 	engine->base.update = hash_mbedtls_update;
 	engine->base.finish = hash_mbedtls_finish;
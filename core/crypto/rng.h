@@ -22,6 +22,15 @@ struct rng_engine {
 	 * @return 0 if the random buffer was successfully filled or an error code.
 	 */
 	int (*generate_random_buffer) (struct rng_engine *engine, size_t rand_len, uint8_t *buf);
+
+	/**
+	 * Force the random number generator to reseed from its entropy source.
+	 *
+	 * @param engine The RNG engine to reseed.
+	 *
+	 * @return 0 if the generator was reseeded successfully or an error code.
+	 */
+	int (*reseed) (struct rng_engine *engine);
 };
 
 
@@ -34,6 +43,7 @@ enum {
 	RNG_ENGINE_INVALID_ARGUMENT = RNG_ENGINE_ERROR (0x00),	/**< Input parameter is null or not valid. */
 	RNG_ENGINE_NO_MEMORY = RNG_ENGINE_ERROR (0x01),			/**< Memory allocation failed. */
 	RNG_ENGINE_RANDOM_FAILED = RNG_ENGINE_ERROR (0x02),		/**< Failed to generate random data. */
+	RNG_ENGINE_RESEED_FAILED = RNG_ENGINE_ERROR (0x03),		/**< Failed to reseed the generator. */
 };
 
 #endif /* RNG_H_ */
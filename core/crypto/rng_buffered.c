@@ -0,0 +1,212 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "rng_buffered.h"
+
+
+/**
+ * Discard any random data remaining in the buffer.  The buffer lock must be held by the caller.
+ *
+ * @param engine The buffered RNG to clear.
+ */
+static void rng_buffered_discard (struct rng_engine_buffered *engine)
+{
+	memset (engine->buffer, 0, sizeof (engine->buffer));
+	engine->available = 0;
+}
+
+/**
+ * Generate a new block of random data if the buffer has been fully consumed.  The buffer lock must
+ * be held by the caller.
+ *
+ * @param engine The buffered RNG to fill.
+ *
+ * @return 0 if the buffer contains random data or an error code.
+ */
+static int rng_buffered_fill (struct rng_engine_buffered *engine)
+{
+	int status;
+
+	if (engine->available != 0) {
+		return 0;
+	}
+
+	status = engine->rng->generate_random_buffer (engine->rng, sizeof (engine->buffer),
+		engine->buffer);
+	if (status != 0) {
+		rng_buffered_discard (engine);
+		return status;
+	}
+
+	engine->available = sizeof (engine->buffer);
+	return 0;
+}
+
+static int rng_buffered_generate_random_buffer (struct rng_engine *engine, size_t rand_len,
+	uint8_t *buf)
+{
+	struct rng_engine_buffered *buffered = (struct rng_engine_buffered*) engine;
+	size_t offset;
+	size_t copy;
+	int status = 0;
+
+	if ((buffered == NULL) || (buf == NULL)) {
+		return RNG_ENGINE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&buffered->lock);
+
+	if (buffered->prediction_resistance) {
+		if (buffered->rng->reseed) {
+			status = buffered->rng->reseed (buffered->rng);
+			if (status != 0) {
+				goto exit;
+			}
+		}
+
+		status = buffered->rng->generate_random_buffer (buffered->rng, rand_len, buf);
+		goto exit;
+	}
+
+	while (rand_len > 0) {
+		if ((buffered->available == 0) && (rand_len >= sizeof (buffered->buffer))) {
+			/* Nothing is gained by buffering a request at least as large as a block. */
+			status = buffered->rng->generate_random_buffer (buffered->rng, rand_len, buf);
+			goto exit;
+		}
+
+		status = rng_buffered_fill (buffered);
+		if (status != 0) {
+			goto exit;
+		}
+
+		offset = sizeof (buffered->buffer) - buffered->available;
+		copy = (rand_len < buffered->available) ? rand_len : buffered->available;
+
+		memcpy (buf, &buffered->buffer[offset], copy);
+		memset (&buffered->buffer[offset], 0, copy);
+
+		buffered->available -= copy;
+		buf += copy;
+		rand_len -= copy;
+	}
+
+exit:
+	platform_mutex_unlock (&buffered->lock);
+	return status;
+}
+
+static int rng_buffered_reseed (struct rng_engine *engine)
+{
+	struct rng_engine_buffered *buffered = (struct rng_engine_buffered*) engine;
+	int status = 0;
+
+	if (buffered == NULL) {
+		return RNG_ENGINE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&buffered->lock);
+
+	rng_buffered_discard (buffered);
+	if (buffered->rng->reseed) {
+		status = buffered->rng->reseed (buffered->rng);
+	}
+
+	platform_mutex_unlock (&buffered->lock);
+	return status;
+}
+
+/**
+ * Initialize an RNG engine that buffers random data for small requests.
+ *
+ * @param engine The buffered RNG engine to initialize.
+ * @param rng The RNG engine that will generate the random data.  This engine should not be used
+ * directly by any other component.
+ *
+ * @return 0 if the RNG engine was initialized successfully or an error code.
+ */
+int rng_buffered_init (struct rng_engine_buffered *engine, struct rng_engine *rng)
+{
+	if ((engine == NULL) || (rng == NULL)) {
+		return RNG_ENGINE_INVALID_ARGUMENT;
+	}
+
+	memset (engine, 0, sizeof (struct rng_engine_buffered));
+
+	engine->base.generate_random_buffer = rng_buffered_generate_random_buffer;
+	engine->base.reseed = rng_buffered_reseed;
+
+	engine->rng = rng;
+
+	return platform_mutex_init (&engine->lock);
+}
+
+/**
+ * Release the resources used by a buffered RNG engine.  Any unused random data will be erased.
+ *
+ * @param engine The buffered RNG engine to release.
+ */
+void rng_buffered_release (struct rng_engine_buffered *engine)
+{
+	if (engine != NULL) {
+		rng_buffered_discard (engine);
+		platform_mutex_free (&engine->lock);
+	}
+}
+
+/**
+ * Generate a new block of random data if the buffer has been fully consumed.  This can be called
+ * from a background task so that later requests don't need to wait for the random data to be
+ * generated.
+ *
+ * @param engine The buffered RNG engine to refill.
+ *
+ * @return 0 if the buffer contains random data or an error code.
+ */
+int rng_buffered_refill (struct rng_engine_buffered *engine)
+{
+	int status = 0;
+
+	if (engine == NULL) {
+		return RNG_ENGINE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&engine->lock);
+
+	if (!engine->prediction_resistance) {
+		status = rng_buffered_fill (engine);
+	}
+
+	platform_mutex_unlock (&engine->lock);
+	return status;
+}
+
+/**
+ * Configure prediction resistance for the buffered RNG.  With prediction resistance enabled,
+ * random data is never buffered.  The source RNG will be reseeded and random data generated
+ * directly for every request.
+ *
+ * @param engine The buffered RNG engine to configure.
+ * @param enable Flag indicating if prediction resistance should be enabled.
+ *
+ * @return 0 if the setting was updated successfully or an error code.
+ */
+int rng_buffered_set_prediction_resistance (struct rng_engine_buffered *engine, bool enable)
+{
+	if (engine == NULL) {
+		return RNG_ENGINE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&engine->lock);
+
+	engine->prediction_resistance = enable;
+	if (enable) {
+		rng_buffered_discard (engine);
+	}
+
+	platform_mutex_unlock (&engine->lock);
+	return 0;
+}
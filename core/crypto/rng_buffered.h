@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef RNG_BUFFERED_H_
+#define RNG_BUFFERED_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "platform.h"
+#include "crypto/rng.h"
+
+
+/**
+ * The number of random bytes generated at once to service small random requests.
+ */
+#ifndef RNG_BUFFERED_BLOCK_SIZE
+#define	RNG_BUFFERED_BLOCK_SIZE		256
+#endif
+
+
+/**
+ * An RNG engine that generates random data in blocks and hands out small requests from the
+ * buffered block.  Each byte is erased from the buffer as it is consumed.
+ */
+struct rng_engine_buffered {
+	struct rng_engine base;							/**< The base RNG engine. */
+	struct rng_engine *rng;							/**< The RNG engine used to generate random data. */
+	uint8_t buffer[RNG_BUFFERED_BLOCK_SIZE];		/**< Random data that has not been consumed. */
+	size_t available;								/**< Number of random bytes remaining in the buffer. */
+	bool prediction_resistance;						/**< Flag indicating every request must be freshly generated. */
+	platform_mutex lock;							/**< Synchronization for the random buffer. */
+};
+
+
+int rng_buffered_init (struct rng_engine_buffered *engine, struct rng_engine *rng);
+void rng_buffered_release (struct rng_engine_buffered *engine);
+
+int rng_buffered_refill (struct rng_engine_buffered *engine);
+int rng_buffered_set_prediction_resistance (struct rng_engine_buffered *engine, bool enable);
+
+
+#endif /* RNG_BUFFERED_H_ */
@@ -20,6 +20,17 @@ static int rng_mbedtls_generate_random_buffer (struct rng_engine *engine, size_t
 	return mbedtls_ctr_drbg_random (&mbedtls_engine->ctr_drbg, buf, rand_len);
 }
 
+static int rng_mbedtls_reseed (struct rng_engine *engine)
+{
+	struct rng_engine_mbedtls *mbedtls_engine = (struct rng_engine_mbedtls*) engine;
+
+	if (mbedtls_engine == NULL) {
+		return RNG_ENGINE_INVALID_ARGUMENT;
+	}
+
+	return mbedtls_ctr_drbg_reseed (&mbedtls_engine->ctr_drbg, NULL, 0);
+}
+
 /**
  * Initialize an mbed TLS engine for generating random numbers.
  *
@@ -47,6 +58,28 @@ int rng_mbedtls_init (struct rng_engine_mbedtls *engine)
     }
 
 	engine->base.generate_random_buffer = rng_mbedtls_generate_random_buffer;
+	engine->base.reseed = rng_mbedtls_reseed;
+
+	return 0;
+}
+
+/**
+ * Configure prediction resistance for the random number generator.  With prediction resistance
+ * enabled, the generator will be reseeded from the entropy source before every request.
+ *
+ * @param engine The mbed TLS RNG engine to configure.
+ * @param enable Flag indicating if prediction resistance should be enabled.
+ *
+ * @return 0 if the setting was updated successfully or an error code.
+ */
+int rng_mbedtls_set_prediction_resistance (struct rng_engine_mbedtls *engine, bool enable)
+{
+	if (engine == NULL) {
+		return RNG_ENGINE_INVALID_ARGUMENT;
+	}
+
+	mbedtls_ctr_drbg_set_prediction_resistance (&engine->ctr_drbg,
+		(enable) ? MBEDTLS_CTR_DRBG_PR_ON : MBEDTLS_CTR_DRBG_PR_OFF);
 
 	return 0;
 }
@@ -6,6 +6,7 @@
 
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "crypto/rng.h"
 #include "mbedtls/ctr_drbg.h"
 #include "mbedtls/entropy.h"
@@ -24,5 +25,7 @@ struct rng_engine_mbedtls {
 int rng_mbedtls_init (struct rng_engine_mbedtls *engine);
 void rng_mbedtls_release (struct rng_engine_mbedtls *engine);
 
+int rng_mbedtls_set_prediction_resistance (struct rng_engine_mbedtls *engine, bool enable);
+
 
 #endif // RNG_MBEDTLS_H_
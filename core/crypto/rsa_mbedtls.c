@@ -9,6 +9,7 @@
 #include "mbedtls/pk_internal.h"
 #include "mbedtls/rsa.h"
 #include "logging/debug_log.h"
+#include "logging/trace_buffer.h"
 #include "crypto_logging.h"
 
 
@@ -89,7 +90,7 @@ static int rsa_mbedtls_generate_key (struct rsa_engine *engine, struct rsa_priva
 error:
 	rsa_mbedtls_free_key_context (rsa);
 
-	debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+	DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 		msg_code, status, 0);
 	return status;
 }
@@ -113,7 +114,7 @@ static int rsa_mbedtls_init_private_key (struct rsa_engine *engine, struct rsa_p
 
 	status = mbedtls_pk_parse_key (rsa, der, length, NULL, 0);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_PK_PARSE_EC, status, 0);
 		goto error;
 	}
@@ -154,7 +155,7 @@ static int rsa_mbedtls_init_public_key (struct rsa_engine *engine, struct rsa_pu
 
 	status = mbedtls_pk_parse_public_key (pk, der, length);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_PK_PARSE_PUB_EC, status, 0);
 		goto exit;
 	}
@@ -168,7 +169,7 @@ static int rsa_mbedtls_init_public_key (struct rsa_engine *engine, struct rsa_pu
 
 	status = mbedtls_rsa_check_pubkey (rsa);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_RSA_PUBKEY_CHECK_EC, status, 0);
 		goto exit;
 	}
@@ -181,14 +182,14 @@ static int rsa_mbedtls_init_public_key (struct rsa_engine *engine, struct rsa_pu
 
 	status = mbedtls_mpi_write_binary (&rsa->N, key->modulus, key->mod_length);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_MPI_WRITE_BIN_EC, status, 0);
 		goto exit;
 	}
 
 	status = mbedtls_mpi_write_binary (&rsa->E, exp, sizeof (exp));
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_MPI_WRITE_BIN_EC, status, 0);
 		if (status == MBEDTLS_ERR_MPI_BUFFER_TOO_SMALL) {
 			status = RSA_ENGINE_UNSUPPORTED_KEY_LENGTH;
@@ -237,7 +238,7 @@ static int rsa_mbedtls_get_private_key_der (struct rsa_engine *engine,
 		status = 0;
 	}
 	else {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_PK_WRITE_KEY_DER_EC, status, 0);
 
 		platform_free (*der);
@@ -274,7 +275,7 @@ static int rsa_mbedtls_get_public_key_der (struct rsa_engine *engine,
 		status = 0;
 	}
 	else {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_PK_WRITE_PUBKEY_DER_EC, status, 0);
 
 		platform_free (*der);
@@ -317,14 +318,17 @@ static int rsa_mbedtls_decrypt (struct rsa_engine *engine, const struct rsa_priv
 			MBEDTLS_MD_SHA256);
 	}
 
+	TRACE_BEGIN (TRACE_EVENT_RSA_DECRYPT, in_length, 0);
 	status = mbedtls_rsa_rsaes_oaep_decrypt (rsa_mbedtls_get_rsa_key (key), mbedtls_ctr_drbg_random,
 		&mbedtls->ctr_drbg, MBEDTLS_RSA_PRIVATE, label, label_length, &length, encrypted, decrypted,
 		out_length);
+	TRACE_END (TRACE_EVENT_RSA_DECRYPT, in_length, status);
+
 	if (status == 0) {
 		status = length;
 	}
 	else {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_RSA_OAEP_DECRYPT_EC, status, 0);
 
 		if (status == MBEDTLS_ERR_RSA_OUTPUT_TOO_LARGE) {
@@ -383,15 +387,75 @@ static int rsa_mbedtls_load_pubkey (mbedtls_rsa_context *rsa, const struct rsa_p
 exit:
 	mbedtls_rsa_free (rsa);
 
-	debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+	DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 		msg_code, status, 0);
 	return status;
 }
 
+/**
+ * Get a parsed context for a public key.  Keys that have been recently used are taken from the
+ * engine cache.  Otherwise, the key is parsed and replaces the least recently used cache entry.
+ * The key cache lock must be held.
+ *
+ * @param engine The RSA engine to use for the key.
+ * @param key The public key to load.
+ * @param rsa Output for the parsed key context.  This is owned by the engine and is only valid
+ * while the key cache lock is held.
+ *
+ * @return 0 if the operation was successful or an error code.
+ */
+static int rsa_mbedtls_get_cached_pubkey (struct rsa_engine_mbedtls *engine,
+	const struct rsa_public_key *key, mbedtls_rsa_context **rsa)
+{
+	struct rsa_mbedtls_key_cache_entry *entry = &engine->key_cache[0];
+	int i;
+	int status;
+
+	engine->key_use++;
+
+	for (i = 0; i < RSA_MBEDTLS_KEY_CACHE_SIZE; i++) {
+		if (engine->key_cache[i].valid && rsa_same_public_key (&engine->key_cache[i].key, key)) {
+			engine->key_cache[i].last_use = engine->key_use;
+			*rsa = &engine->key_cache[i].rsa;
+			return 0;
+		}
+	}
+
+	for (i = 0; i < RSA_MBEDTLS_KEY_CACHE_SIZE; i++) {
+		if (!engine->key_cache[i].valid) {
+			entry = &engine->key_cache[i];
+			break;
+		}
+
+		if ((engine->key_use - engine->key_cache[i].last_use) >
+			(engine->key_use - entry->last_use)) {
+			entry = &engine->key_cache[i];
+		}
+	}
+
+	if (entry->valid) {
+		mbedtls_rsa_free (&entry->rsa);
+		entry->valid = false;
+	}
+
+	status = rsa_mbedtls_load_pubkey (&entry->rsa, key);
+	if (status != 0) {
+		return status;
+	}
+
+	memcpy (&entry->key, key, sizeof (entry->key));
+	entry->last_use = engine->key_use;
+	entry->valid = true;
+
+	*rsa = &entry->rsa;
+	return 0;
+}
+
 static int rsa_mbedtls_sig_verify (struct rsa_engine *engine, const struct rsa_public_key *key,
 	const uint8_t *signature, size_t sig_length, const uint8_t *match, size_t match_length)
 {
-	mbedtls_rsa_context rsa;
+	struct rsa_engine_mbedtls *mbedtls = (struct rsa_engine_mbedtls*) engine;
+	mbedtls_rsa_context *rsa;
 	int status;
 
 	if ((engine == NULL) || (key == NULL) || (signature == NULL) || (match == NULL) ||
@@ -399,17 +463,28 @@ static int rsa_mbedtls_sig_verify (struct rsa_engine *engine, const struct rsa_p
 		return RSA_ENGINE_INVALID_ARGUMENT;
 	}
 
-	status = rsa_mbedtls_load_pubkey (&rsa, key);
+	/* The cached context must stay locked while it is in use so it can't be evicted by a
+	 * concurrent verification. */
+	platform_mutex_lock (&mbedtls->key_lock);
+
+	status = rsa_mbedtls_get_cached_pubkey (mbedtls, key, &rsa);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		platform_mutex_unlock (&mbedtls->key_lock);
+
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_RSA_PUBKEY_LOAD_EC, status, 0);
 		return status;
 	}
 
-	status = mbedtls_rsa_pkcs1_verify (&rsa, NULL, NULL, MBEDTLS_RSA_PUBLIC, MBEDTLS_MD_SHA256,
+	TRACE_BEGIN (TRACE_EVENT_RSA_VERIFY, sig_length, 0);
+	status = mbedtls_rsa_pkcs1_verify (rsa, NULL, NULL, MBEDTLS_RSA_PUBLIC, MBEDTLS_MD_SHA256,
 		match_length, match, signature);
+	TRACE_END (TRACE_EVENT_RSA_VERIFY, sig_length, status);
+
+	platform_mutex_unlock (&mbedtls->key_lock);
+
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_RSA_PKCS1_VERIFY_EC, status, 0);
 
 		if ((status == MBEDTLS_ERR_MPI_ALLOC_FAILED) ||
@@ -421,7 +496,6 @@ static int rsa_mbedtls_sig_verify (struct rsa_engine *engine, const struct rsa_p
 		}
 	}
 
-	mbedtls_rsa_free (&rsa);
 	return status;
 }
 
@@ -442,13 +516,18 @@ int rsa_mbedtls_init (struct rsa_engine_mbedtls *engine)
 
 	memset (engine, 0, sizeof (struct rsa_engine_mbedtls));
 
+	status = platform_mutex_init (&engine->key_lock);
+	if (status != 0) {
+		return status;
+	}
+
 	mbedtls_ctr_drbg_init (&engine->ctr_drbg);
 	mbedtls_entropy_init (&engine->entropy);
 
 	status = mbedtls_ctr_drbg_seed (&engine->ctr_drbg, mbedtls_entropy_func, &engine->entropy, NULL,
 		0);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_CTR_DRBG_SEED_EC, status, 0);
 		goto exit;
 	}
@@ -467,6 +546,7 @@ int rsa_mbedtls_init (struct rsa_engine_mbedtls *engine)
 exit:
 	mbedtls_entropy_free (&engine->entropy);
 	mbedtls_ctr_drbg_free (&engine->ctr_drbg);
+	platform_mutex_free (&engine->key_lock);
 	return status;
 }
 
@@ -478,7 +558,34 @@ exit:
 void rsa_mbedtls_release (struct rsa_engine_mbedtls *engine)
 {
 	if (engine) {
+		rsa_mbedtls_flush_key_cache (engine);
+
 		mbedtls_entropy_free (&engine->entropy);
 		mbedtls_ctr_drbg_free (&engine->ctr_drbg);
+		platform_mutex_free (&engine->key_lock);
+	}
+}
+
+/**
+ * Discard all parsed public keys cached by an mbedTLS RSA engine.  The next verification with each
+ * key will need to parse the key again.
+ *
+ * @param engine The RSA engine to update.
+ */
+void rsa_mbedtls_flush_key_cache (struct rsa_engine_mbedtls *engine)
+{
+	int i;
+
+	if (engine) {
+		platform_mutex_lock (&engine->key_lock);
+
+		for (i = 0; i < RSA_MBEDTLS_KEY_CACHE_SIZE; i++) {
+			if (engine->key_cache[i].valid) {
+				mbedtls_rsa_free (&engine->key_cache[i].rsa);
+				engine->key_cache[i].valid = false;
+			}
+		}
+
+		platform_mutex_unlock (&engine->key_lock);
 	}
 }
@@ -4,11 +4,33 @@
 #ifndef RSA_MBEDTLS_H_
 #define RSA_MBEDTLS_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+#include "platform.h"
 #include "rsa.h"
 #include "mbedtls/ctr_drbg.h"
 #include "mbedtls/entropy.h"
+#include "mbedtls/rsa.h"
 
 
+/**
+ * The number of parsed public keys kept by the engine for signature verification.
+ */
+#ifndef RSA_MBEDTLS_KEY_CACHE_SIZE
+#define	RSA_MBEDTLS_KEY_CACHE_SIZE			4
+#endif
+
+
+/**
+ * A parsed public key that can be reused for signature verification.
+ */
+struct rsa_mbedtls_key_cache_entry {
+	struct rsa_public_key key;			/**< The public key loaded in the context. */
+	mbedtls_rsa_context rsa;			/**< The parsed key, including cached Montgomery values. */
+	uint32_t last_use;					/**< Usage count when the key was last used. */
+	bool valid;							/**< Flag indicating the entry contains a parsed key. */
+};
+
 /**
  * An mbedTLS context for RSA encryption.
  */
@@ -16,11 +38,16 @@ struct rsa_engine_mbedtls {
 	struct rsa_engine base;				/**< The base RSA engine. */
 	mbedtls_ctr_drbg_context ctr_drbg;	/**< A random number generator for the engine. */
 	mbedtls_entropy_context entropy;	/**< Entropy source for the random number generator. */
+	struct rsa_mbedtls_key_cache_entry key_cache[RSA_MBEDTLS_KEY_CACHE_SIZE];	/**< Recently used public keys. */
+	uint32_t key_use;					/**< Counter for tracking least recently used keys. */
+	platform_mutex key_lock;			/**< Synchronization for the public key cache. */
 };
 
 
 int rsa_mbedtls_init (struct rsa_engine_mbedtls *engine);
 void rsa_mbedtls_release (struct rsa_engine_mbedtls *engine);
 
+void rsa_mbedtls_flush_key_cache (struct rsa_engine_mbedtls *engine);
+
 
 #endif /* RSA_MBEDTLS_H_ */
@@ -159,7 +159,7 @@ static int x509_mbedtls_add_extended_key_usage_extension (mbedtls_asn1_named_dat
 	pos = ext + sizeof (ext);
 	length = mbedtls_asn1_write_oid (&pos, ext, oid, oid_length);
 	if (length < 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_ASN1_WRITE_OID_EC, length, 0);
 
 		return length;
@@ -168,7 +168,7 @@ static int x509_mbedtls_add_extended_key_usage_extension (mbedtls_asn1_named_dat
 	status = x509_mbedtls_close_asn1_object (&pos, ext,
 		(MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE), &length);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_ASN1_CLOSE_EC, length, 0);
 
 		return status;
@@ -209,7 +209,7 @@ static int x509_mbedtls_add_basic_constraints_extension (mbedtls_asn1_named_data
 	ret = x509_mbedtls_close_asn1_object (&pos, ext,
 		(MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE), &length);
 	if (ret != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_ASN1_CLOSE_EC, ret, 0);
 
 		return ret;
@@ -265,7 +265,7 @@ static int x509_mbedtls_add_fwid (struct x509_engine_mbedtls *engine, const uint
 	ret = x509_mbedtls_close_asn1_object (pos, engine->der_buf, MBEDTLS_ASN1_OCTET_STRING,
 		length);
 	if (ret != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_ASN1_CLOSE_EC, ret, 0);
 
 		return ret;
@@ -279,7 +279,7 @@ static int x509_mbedtls_add_fwid (struct x509_engine_mbedtls *engine, const uint
 	ret = x509_mbedtls_close_asn1_object (pos, engine->der_buf,
 		(MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE), length);
 	if (ret != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_ASN1_CLOSE_EC, ret, 0);
 
 		return ret;
@@ -321,7 +321,7 @@ static int x509_mbedtls_add_tcbinfo_extension (struct x509_engine_mbedtls *engin
 	ret = x509_mbedtls_close_asn1_object (&pos, engine->der_buf,
 		(MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_CONTEXT_SPECIFIC | 6), &length);
 	if (ret != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_ASN1_CLOSE_EC, ret, 0);
 
 		return ret;
@@ -360,7 +360,7 @@ static int x509_mbedtls_add_tcbinfo_extension (struct x509_engine_mbedtls *engin
 	ret = x509_mbedtls_close_asn1_object (&pos, engine->der_buf,
 		(MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE), &length);
 	if (ret != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_ASN1_CLOSE_EC, ret, 0);
 
 		return ret;
@@ -400,7 +400,7 @@ static int x509_mbedtls_add_ueid_extension (struct x509_engine_mbedtls *engine,
 	ret = x509_mbedtls_close_asn1_object (&pos, engine->der_buf,
 		(MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE), &length);
 	if (ret != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_ASN1_CLOSE_EC, ret, 0);
 
 		return ret;
@@ -426,7 +426,7 @@ static int x509_mbedtls_add_dice_extensions (struct x509_engine_mbedtls *engine,
 
 	status = x509_mbedtls_add_tcbinfo_extension (engine, extensions, tcb);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_X509_ADD_TCBINFO_EC, status, 0);
 
 		return status;
@@ -435,7 +435,7 @@ static int x509_mbedtls_add_dice_extensions (struct x509_engine_mbedtls *engine,
 	if (tcb->ueid) {
 		status = x509_mbedtls_add_ueid_extension (engine, extensions, tcb->ueid);
 		if (status != 0) {
-			debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+			DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 				CRYPTO_LOG_MSG_MBEDTLS_X509_ADD_UEID_EC, status, 0);
 		}
 	}
@@ -471,7 +471,7 @@ static int x509_mbedtls_create_csr (struct x509_engine *engine, const uint8_t *p
 
 	status = x509_mbedtls_load_key (&key, priv_key, key_length, true);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_X509_LOAD_KEY_EC, status, 0);
 
 		goto err_free_csr;
@@ -489,7 +489,7 @@ static int x509_mbedtls_create_csr (struct x509_engine *engine, const uint8_t *p
 	strcpy (&subject[3], name);
 	status = mbedtls_x509write_csr_set_subject_name (&x509, subject);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_X509_CSR_SET_SUBJECT_EC, status, 0);
 
 		goto err_free_subject;
@@ -505,7 +505,7 @@ static int x509_mbedtls_create_csr (struct x509_engine *engine, const uint8_t *p
 	}
 
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_X509_ADD_KEY_USAGE_EC, status, 0);
 
 		goto err_free_subject;
@@ -515,7 +515,7 @@ static int x509_mbedtls_create_csr (struct x509_engine *engine, const uint8_t *p
 		status = x509_mbedtls_add_extended_key_usage_extension (&x509.extensions,
 			MBEDTLS_OID_CLIENT_AUTH, MBEDTLS_OID_SIZE (MBEDTLS_OID_CLIENT_AUTH), true);
 		if (status != 0) {
-			debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+			DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 				CRYPTO_LOG_MSG_MBEDTLS_X509_ADD_EXT_KEY_USAGE_EC, status, 0);
 
 			goto err_free_subject;
@@ -526,7 +526,7 @@ static int x509_mbedtls_create_csr (struct x509_engine *engine, const uint8_t *p
 		status = x509_mbedtls_add_extended_key_usage_extension (&x509.extensions, eku,
 			strlen (eku), false);
 		if (status != 0) {
-			debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+			DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 				CRYPTO_LOG_MSG_MBEDTLS_X509_ADD_EXT_KEY_USAGE_EC, status, 0);
 
 			goto err_free_subject;
@@ -537,7 +537,7 @@ static int x509_mbedtls_create_csr (struct x509_engine *engine, const uint8_t *p
 		status = x509_mbedtls_add_basic_constraints_extension (&x509.extensions, true,
 			X509_CERT_PATHLEN (type));
 		if (status != 0) {
-			debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+			DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 				CRYPTO_LOG_MSG_MBEDTLS_X509_ADD_BASIC_CONSTRAINTS_EC, status, 0);
 
 			goto err_free_subject;
@@ -555,7 +555,7 @@ static int x509_mbedtls_create_csr (struct x509_engine *engine, const uint8_t *p
 	status = mbedtls_x509write_csr_der (&x509, mbedtls->der_buf, X509_MAX_SIZE,
 		mbedtls_ctr_drbg_random, &mbedtls->ctr_drbg);
 	if (status < 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_X509_CSR_DER_WRITE_EC, status, 0);
 
 		goto err_free_subject;
@@ -628,7 +628,7 @@ static int x509_mbedtls_create_certificate (struct x509_engine_mbedtls *mbedtls,
 
 	status = mbedtls_mpi_read_binary (&x509_build.serial, serial_num, serial_length);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_MPI_READ_BIN_EC, status, 0);
 
 		goto err_free_crt;
@@ -649,7 +649,7 @@ static int x509_mbedtls_create_certificate (struct x509_engine_mbedtls *mbedtls,
 	strcpy (&subject[3], name);
 	status = mbedtls_x509write_crt_set_subject_name (&x509_build, subject);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_CRT_SET_SUBJECT_EC, status, 0);
 
 		goto err_free_subject;
@@ -659,7 +659,7 @@ static int x509_mbedtls_create_certificate (struct x509_engine_mbedtls *mbedtls,
 		status = mbedtls_x509write_crt_set_issuer_name (&x509_build, subject);
 
 		if (status != 0) {
-			debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+			DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 				CRYPTO_LOG_MSG_MBEDTLS_CRT_SET_ISSUER_EC, status, 0);
 		}
 	}
@@ -679,7 +679,7 @@ static int x509_mbedtls_create_certificate (struct x509_engine_mbedtls *mbedtls,
 
 	status = mbedtls_x509write_crt_set_validity (&x509_build, "20180101000000", "99991231235959");
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_CRT_SET_VALIDITY_EC, status, 0);
 
 		goto err_free_subject;
@@ -687,7 +687,7 @@ static int x509_mbedtls_create_certificate (struct x509_engine_mbedtls *mbedtls,
 
 	status = mbedtls_x509write_crt_set_subject_key_identifier (&x509_build);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_CRT_SET_SUBJECT_EC, status, 0);
 
 		goto err_free_subject;
@@ -695,7 +695,7 @@ static int x509_mbedtls_create_certificate (struct x509_engine_mbedtls *mbedtls,
 
 	status = mbedtls_x509write_crt_set_authority_key_identifier (&x509_build);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_CRT_SET_AUTHORITY_EC, status, 0);
 
 		goto err_free_subject;
@@ -711,7 +711,7 @@ static int x509_mbedtls_create_certificate (struct x509_engine_mbedtls *mbedtls,
 	}
 
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_X509_ADD_KEY_USAGE_EC, status, 0);
 
 		goto err_free_subject;
@@ -721,7 +721,7 @@ static int x509_mbedtls_create_certificate (struct x509_engine_mbedtls *mbedtls,
 		status = x509_mbedtls_add_extended_key_usage_extension (&x509_build.extensions,
 			MBEDTLS_OID_CLIENT_AUTH, MBEDTLS_OID_SIZE (MBEDTLS_OID_CLIENT_AUTH), true);
 		if (status != 0) {
-			debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+			DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 				CRYPTO_LOG_MSG_MBEDTLS_X509_ADD_EXT_KEY_USAGE_EC, status, 0);
 
 			goto err_free_subject;
@@ -732,7 +732,7 @@ static int x509_mbedtls_create_certificate (struct x509_engine_mbedtls *mbedtls,
 		status = x509_mbedtls_add_basic_constraints_extension (&x509_build.extensions, true,
 			X509_CERT_PATHLEN (type));
 		if (status != 0) {
-			debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+			DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 				CRYPTO_LOG_MSG_MBEDTLS_X509_ADD_BASIC_CONSTRAINTS_EC, status, 0);
 
 			goto err_free_subject;
@@ -750,7 +750,7 @@ static int x509_mbedtls_create_certificate (struct x509_engine_mbedtls *mbedtls,
 	status = mbedtls_x509write_crt_der (&x509_build, mbedtls->der_buf, X509_MAX_SIZE,
 		mbedtls_ctr_drbg_random, &mbedtls->ctr_drbg);
 	if (status < 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_CRT_WRITE_DER_EC, status, 0);
 
 		goto err_free_subject;
@@ -764,7 +764,7 @@ static int x509_mbedtls_create_certificate (struct x509_engine_mbedtls *mbedtls,
 
 	status = mbedtls_x509_crt_parse_der (x509, &mbedtls->der_buf[X509_MAX_SIZE - status], status);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_CRT_PARSE_DER_EC, status, 0);
 
 		x509_mbedtls_free_cert (x509);
@@ -796,7 +796,7 @@ static int x509_mbedtls_create_self_signed_certificate (struct x509_engine *engi
 
 	status = x509_mbedtls_load_key (&cert_key, priv_key, key_length, true);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_X509_LOAD_KEY_EC, status, 0);
 
 		goto err_exit;
@@ -828,7 +828,7 @@ static int x509_mbedtls_create_ca_signed_certificate (struct x509_engine *engine
 
 	status = x509_mbedtls_load_key (&cert_key, key, key_length, false);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_X509_LOAD_KEY_EC, status, 0);
 
 		goto err_exit;
@@ -836,7 +836,7 @@ static int x509_mbedtls_create_ca_signed_certificate (struct x509_engine *engine
 
 	status = x509_mbedtls_load_key (&ca_key, ca_priv_key, ca_key_length, true);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_X509_LOAD_KEY_EC, status, 0);
 
 		goto err_free_key;
@@ -873,7 +873,7 @@ static int x509_mbedtls_load_certificate (struct x509_engine *engine, struct x50
 		cert->context = x509;
 	}
 	else {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_CRT_PARSE_DER_EC, status, 0);
 
 		x509_mbedtls_free_cert (x509);
@@ -1002,7 +1002,7 @@ static int x509_mbedtls_get_public_key (struct x509_engine *engine,
 	status = mbedtls_pk_write_pubkey_der (&((mbedtls_x509_crt*) cert->context)->pk,
 		mbedtls->der_buf, X509_MAX_SIZE);
 	if (status < 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_PK_WRITE_PUBKEY_DER_EC, status, 0);
 
 		return status;
@@ -1044,7 +1044,7 @@ static int x509_mbedtls_verify_cert_signature (mbedtls_x509_crt *cert, mbedtls_p
 	mbedtls_md_get_size (md_info), cert->sig.p, cert->sig.len);
 
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_PK_VERIFY_EC, status, 0);
 	}
 
@@ -1215,7 +1215,7 @@ static int x509_mbedtls_authenticate (struct x509_engine *engine,
 	status = mbedtls_x509_crt_verify (x509, store_ctx->root_ca, NULL, NULL, &validation, NULL,
 		NULL);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_CRT_CERT_AUTHENTICATE_EC, status, validation);
 	}
 
@@ -1251,7 +1251,7 @@ int x509_mbedtls_init (struct x509_engine_mbedtls *engine)
 	status = mbedtls_ctr_drbg_seed (&engine->ctr_drbg, mbedtls_entropy_func, &engine->entropy, NULL,
 		0);
 	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
 			CRYPTO_LOG_MSG_MBEDTLS_CTR_DRBG_SEED_EC, status, 0);
 
 		goto exit;
@@ -76,6 +76,55 @@ int app_image_verification_with_header (struct flash *flash, uint32_t start_addr
 		HASH_TYPE_SHA256, rsa, signature, APP_IMAGE_SIG_LENGTH, pub_key, hash_out, hash_legnth);
 }
 
+/**
+ * Verify the signature of an application image stored in flash using a digest of the image that
+ * was calculated in advance, such as while the image was being written to flash.  The image data is
+ * not read from flash.
+ *
+ * @param flash The flash device that contains the application image.
+ * @param start_addr The start address of the additional image header.
+ * @param header_length The length of the prepended image header.  This can be 0 if there is no
+ * additional header.
+ * @param digest The SHA-256 digest of the image data, starting with the additional header.
+ * @param digest_length The length of the digest.
+ * @param signed_length The number of bytes of image data that were used to calculate the digest.
+ * @param rsa The RSA engine to use for signature validation.
+ * @param pub_key The key to use to validate the signature.
+ *
+ * @return 0 if the application image is valid or an error code.  If the digest was not calculated
+ * over the signed image data, APP_IMAGE_DIGEST_LENGTH_MISMATCH will be returned.
+ */
+int app_image_verification_with_digest (struct flash *flash, uint32_t start_addr,
+	size_t header_length, const uint8_t *digest, size_t digest_length, size_t signed_length,
+	struct rsa_engine *rsa, const struct rsa_public_key *pub_key)
+{
+	uint32_t length;
+	uint8_t signature[APP_IMAGE_SIG_LENGTH];
+	int status;
+
+	if ((flash == NULL) || (digest == NULL) || (rsa == NULL) || (pub_key == NULL) ||
+		(digest_length != SHA256_HASH_LENGTH)) {
+		return APP_IMAGE_INVALID_ARGUMENT;
+	}
+
+	status = flash->read (flash, start_addr + header_length, (uint8_t*) &length, 4);
+	if (status != 0) {
+		return status;
+	}
+
+	if (signed_length != (header_length + 4 + length)) {
+		return APP_IMAGE_DIGEST_LENGTH_MISMATCH;
+	}
+
+	status = flash->read (flash, start_addr + signed_length, signature, APP_IMAGE_SIG_LENGTH);
+	if (status != 0) {
+		return status;
+	}
+
+	return rsa->sig_verify (rsa, pub_key, signature, APP_IMAGE_SIG_LENGTH, digest,
+		SHA256_HASH_LENGTH);
+}
+
 /**
  * Load the application image from flash into memory.
  *
@@ -24,6 +24,9 @@ int app_image_verification (struct flash *flash, uint32_t start_addr, struct has
 int app_image_verification_with_header (struct flash *flash, uint32_t start_addr,
 	size_t header_length, struct hash_engine *hash, struct rsa_engine *rsa,
 	const struct rsa_public_key *pub_key, uint8_t *hash_out, size_t hash_length);
+int app_image_verification_with_digest (struct flash *flash, uint32_t start_addr,
+	size_t header_length, const uint8_t *digest, size_t digest_length, size_t signed_length,
+	struct rsa_engine *rsa, const struct rsa_public_key *pub_key);
 
 int app_image_load (struct flash *flash, uint32_t start_addr, uint8_t *load_addr, size_t max_length,
 	size_t *load_length);
@@ -59,6 +62,7 @@ enum {
 	APP_IMAGE_TOO_LARGE = APP_IMAGE_ERROR (2),				/**< There is not enough space available to load the image. */
 	APP_IMAGE_HASH_BUFFER_TOO_SMALL = APP_IMAGE_ERROR (3),	/**< The buffer for the image hash is not large enough. */
 	APP_IMAGE_SIG_BUFFER_TOO_SMALL = APP_IMAGE_ERROR (4),	/**< The buffer for the signature is not large enough. */
+	APP_IMAGE_DIGEST_LENGTH_MISMATCH = APP_IMAGE_ERROR (5),	/**< A precomputed digest does not cover the signed image data. */
 };
 
 
@@ -45,6 +45,27 @@ struct firmware_image {
 	 */
 	int (*verify) (struct firmware_image *fw, struct hash_engine *hash, struct rsa_engine *rsa);
 
+	/**
+	 * Verify the complete firmware image using a digest of the signed image data that was
+	 * calculated while the image was being written to flash.  This provides the same validation as
+	 * 'verify', including key revocation checks, without reading the image data from flash again.
+	 *
+	 * This is optional and will be null if the image format does not support verification from a
+	 * precomputed digest.  The image must have been loaded before calling this.  Image formats that
+	 * sign an application image can use app_image_verification_with_digest to check the signature.
+	 *
+	 * @param fw The firmware image to validate.
+	 * @param hash The hash engine to use for any additional validation.
+	 * @param rsa The RSA engine to use for signature checking.
+	 * @param digest The SHA-256 digest of the image data, starting from the first byte of the image.
+	 * @param length The number of bytes of image data used to calculate the digest.
+	 *
+	 * @return 0 if the firmware image is valid or an error code.  If the digest does not cover the
+	 * same data as the image signature, FIRMWARE_IMAGE_DIGEST_LENGTH_MISMATCH will be returned.
+	 */
+	int (*verify_digest) (struct firmware_image *fw, struct hash_engine *hash,
+		struct rsa_engine *rsa, const uint8_t *digest, size_t length);
+
 	/**
 	 * Get the total size of the firmware image.
 	 *
@@ -98,6 +119,7 @@ enum {
 	FIRMWARE_IMAGE_MANIFEST_REVOKED = FIRMWARE_IMAGE_ERROR (0x0a),		/**< The key manifest contained in the image has been revoked. */
 	FIRMWARE_IMAGE_NOT_AVAILABLE = FIRMWARE_IMAGE_ERROR (0x0b),			/**< A firmware component is not available in the image. */
 	FIRMWARE_IMAGE_INVALID_SIGNATURE = FIRMWARE_IMAGE_ERROR (0x0c),		/**< An image signature is malformed. */
+	FIRMWARE_IMAGE_DIGEST_LENGTH_MISMATCH = FIRMWARE_IMAGE_ERROR (0x0d),	/**< A precomputed digest does not cover the signed image data. */
 };
 
 
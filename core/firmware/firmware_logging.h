@@ -19,6 +19,8 @@ enum {
 	FIRMWARE_LOGGING_WRITE_FAIL,				/**< Failed to write firmware image data. */
 	FIRMWARE_LOGGING_RECOVERY_RESTORE_FAIL,		/**< Failed to restore a bad recovery image. */
 	FIRMWARE_LOGGING_ACTIVE_RESTORE_FAIL,		/**< Failed to restore a bad active image. */
+	FIRMWARE_LOGGING_UPDATE_RESUME,				/**< Resuming an interrupted firmware update. */
+	FIRMWARE_LOGGING_JOURNAL_FAIL,				/**< Failed to store a firmware update checkpoint. */
 };
 
 
@@ -67,6 +67,20 @@ int firmware_update_init (struct firmware_update *updater, const struct firmware
 	return 0;
 }
 
+/**
+ * Stop calculating the digest of the image in staging flash.  The digest will not be available to
+ * verify the staging image.
+ *
+ * @param updater The updater to update.
+ */
+static void firmware_update_cancel_staging_hash (struct firmware_update *updater)
+{
+	if (updater->stage_hash_active) {
+		updater->stage_hash->cancel (updater->stage_hash);
+		updater->stage_hash_active = false;
+	}
+}
+
 /**
  * Release the resources used by a firmware updater.
  *
@@ -75,6 +89,8 @@ int firmware_update_init (struct firmware_update *updater, const struct firmware
 void firmware_update_release (struct firmware_update *updater)
 {
 	if (updater) {
+		firmware_update_cancel_staging_hash (updater);
+
 		observable_release (&updater->observable);
 		flash_updater_release (&updater->update_mgr);
 	}
@@ -96,6 +112,79 @@ void firmware_update_set_image_offset (struct firmware_update *updater, int offs
 	}
 }
 
+/**
+ * Configure the updater to calculate a digest of new images as they are written to staging flash.
+ * When the firmware image supports verification from a precomputed digest, this removes the need to
+ * read the entire staging image from flash to verify it before the update is applied.
+ *
+ * The hash engine must not be used for any other operations, since the digest calculation remains
+ * active while the image is being received.  No digest is calculated if the firmware image does
+ * not support verification from a digest.  Each block of data added to the digest is read back
+ * from flash after it is written to ensure the staging image matches the digest.
+ *
+ * This should be called only during initialization if the updater will use staging digests.
+ *
+ * @param updater The firmware updater to configure.
+ * @param hash The hash engine to use for staging image digests.  Null to always verify the image
+ * by reading it from staging flash.
+ * @param sig_length The length of the signature at the end of a staged image.  This data is not
+ * included in the digest.
+ */
+void firmware_update_set_staging_hash (struct firmware_update *updater, struct hash_engine *hash,
+	size_t sig_length)
+{
+	if (updater != NULL) {
+		firmware_update_cancel_staging_hash (updater);
+
+		updater->stage_hash = hash;
+		updater->stage_sig_length = sig_length;
+	}
+}
+
+/**
+ * Configure the updater to record the progress of image updates.  If an update is interrupted, such
+ * as by a loss of power, running the update again will resume from the last recorded checkpoint
+ * instead of starting over.
+ *
+ * Checkpoints are recorded at each erase block of the destination region, so only the block that
+ * was being written when the update was interrupted needs to be written again.
+ *
+ * This should be called only during initialization if the updater will use a journal.
+ *
+ * @param updater The firmware updater to configure.
+ * @param journal The journal to use for update progress.  Null to always run complete updates.
+ */
+void firmware_update_set_journal (struct firmware_update *updater,
+	struct firmware_update_journal *journal)
+{
+	if (updater != NULL) {
+		updater->journal = journal;
+	}
+}
+
+/**
+ * Determine if a previous update was interrupted before it completed.  If so, the update should be
+ * run again before any other image operations to finish installing the image in staging flash.
+ *
+ * @param updater The firmware updater to query.
+ *
+ * @return true if there is an interrupted update that can be resumed.
+ */
+bool firmware_update_is_resume_pending (struct firmware_update *updater)
+{
+	struct firmware_update_checkpoint checkpoint;
+
+	if ((updater == NULL) || (updater->journal == NULL)) {
+		return false;
+	}
+
+	if (firmware_update_journal_get_checkpoint (updater->journal, &checkpoint) != 0) {
+		return false;
+	}
+
+	return (checkpoint.phase != FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE);
+}
+
 /**
  * Indicate to the firmware updater if the recovery image on flash is currently good.
  *
@@ -259,6 +348,14 @@ static int firmware_update_restore_image (struct firmware_update *updater, struc
 	uint32_t page;
 	int status;
 
+	if (updater->journal) {
+		/* Any interrupted update can't be resumed once the image has been replaced. */
+		status = firmware_update_journal_clear (updater->journal);
+		if (status != 0) {
+			return status;
+		}
+	}
+
 	status = updater->fw->load (updater->fw, src, src_addr + updater->img_offset);
 	if (status != 0) {
 		return status;
@@ -402,12 +499,140 @@ static void firmware_update_status_change (struct firmware_update_notification *
 	}
 }
 
+/**
+ * Update the progress of the current image write step.  The checkpoint is only stored if the
+ * updater has a journal.
+ *
+ * @param updater The updater being executed.
+ * @param checkpoint The progress of the update.
+ * @param phase The phase of the write step that has been completed.
+ *
+ * @return 0 if the checkpoint was recorded or an error code.
+ */
+static int firmware_update_checkpoint (struct firmware_update *updater,
+	struct firmware_update_checkpoint *checkpoint, uint8_t phase)
+{
+	checkpoint->phase = phase;
+
+	if (updater->journal) {
+		return firmware_update_journal_record (updater->journal, checkpoint);
+	}
+
+	return 0;
+}
+
+/**
+ * Copy the image in staging flash to a bootable region, recording a checkpoint after each erase
+ * block has been written.  The erase block containing the start of the image is written last, so
+ * the image does not become bootable until all other data has been written.
+ *
+ * When resuming from a checkpoint, only the data after the last checkpoint is erased and written
+ * again.
+ *
+ * @param updater The updater being executed.
+ * @param dest The bootable flash device to program.
+ * @param dest_addr The address to program the image to.
+ * @param length The length of the new image.
+ * @param page The page size of flash being written.
+ * @param checkpoint The progress of the update.  This will be updated as data is written.
+ *
+ * @return 0 if the new image was copied successfully or an error code.
+ */
+static int firmware_update_program_checkpointed (struct firmware_update *updater,
+	struct flash *dest, uint32_t dest_addr, size_t length, uint32_t page,
+	struct firmware_update_checkpoint *checkpoint)
+{
+	struct flash *src = updater->flash->staging_flash;
+	uint32_t src_addr = updater->flash->staging_addr + updater->img_offset;
+	uint32_t block;
+	uint32_t header_len;
+	uint32_t chunk;
+	int status;
+
+	status = dest->get_block_size (dest, &block);
+	if (status != 0) {
+		return status;
+	}
+
+	header_len = block - FLASH_REGION_OFFSET (dest_addr, block);
+	if (header_len > length) {
+		header_len = length;
+	}
+
+	if ((checkpoint->phase < FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM) ||
+		(checkpoint->offset < header_len) || (checkpoint->offset > length)) {
+		status = flash_erase_region_and_verify (dest, dest_addr, length);
+		if (status != 0) {
+			return status;
+		}
+
+		checkpoint->offset = header_len;
+		status = firmware_update_checkpoint (updater, checkpoint,
+			FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM);
+		if (status != 0) {
+			return status;
+		}
+	}
+	else if (checkpoint->phase == FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM) {
+		/* Data after the last checkpoint may have been partially written. */
+		if (checkpoint->offset < length) {
+			status = flash_erase_region_and_verify (dest, dest_addr + checkpoint->offset,
+				length - checkpoint->offset);
+			if (status != 0) {
+				return status;
+			}
+		}
+	}
+	else {
+		/* The header block may have been partially written. */
+		status = flash_erase_region_and_verify (dest, dest_addr, header_len);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	while (checkpoint->offset < length) {
+		chunk = length - checkpoint->offset;
+		if (chunk > block) {
+			chunk = block;
+		}
+
+		status = flash_copy_ext_to_blank_and_verify (dest, dest_addr + checkpoint->offset, src,
+			src_addr + checkpoint->offset, chunk);
+		if (status != 0) {
+			return status;
+		}
+
+		checkpoint->offset += chunk;
+		status = firmware_update_checkpoint (updater, checkpoint,
+			FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	if (checkpoint->phase != FIRMWARE_UPDATE_JOURNAL_PHASE_HEADER) {
+		status = firmware_update_checkpoint (updater, checkpoint,
+			FIRMWARE_UPDATE_JOURNAL_PHASE_HEADER);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	return firmware_update_program_bootable (updater, dest, dest_addr, src, src_addr, header_len,
+		page);
+}
+
 /**
  * Write a new firmware image to a region in flash from the staging region.
  *
  * The image currently in flash will optionally be backed up.  If there is an error writing the new
  * image, an attempt will be made to restore the current image from the backup.
  *
+ * If the updater has a journal, progress through the write step will be recorded.  When the
+ * checkpoint indicates this step was interrupted, the write will resume from the last completed
+ * phase of the step.
+ *
  * @param updater The updater being executed.
  * @param callback The updated notification handlers.
  * @param dest The destination flash device for the new image.
@@ -419,6 +644,8 @@ static void firmware_update_status_change (struct firmware_update_notification *
  * @param backup_fail The status to report if image backup has failed.
  * @param update_start The status to report when the image has started update.
  * @param update_fail The status to report if the image update failed.
+ * @param step The journal step for this image write.
+ * @param checkpoint The progress of the update.  This will be updated as the image is written.
  * @param img_good Output indicating of the destination region contains a good image at the end of
  * this process.  It does not mean the new image is in the region, just that there is a good one,
  * such as when a backup image is restored in error handling.
@@ -430,33 +657,64 @@ static int firmware_update_write_image (struct firmware_update *updater,
 	struct flash *backup, uint32_t backup_addr, size_t update_len,
 	enum firmware_update_status backup_start, enum firmware_update_status backup_fail,
 	enum firmware_update_status update_start, enum firmware_update_status update_fail,
+	enum firmware_update_journal_step step, struct firmware_update_checkpoint *checkpoint,
 	bool *img_good)
 {
-	int backup_len;
+	int backup_len = 0;
 	uint32_t page;
 	int status;
 
 	*img_good = true;
-	if (backup) {
-		/* Backup the current image. */
-		firmware_update_status_change (callback, backup_start);
-		status = updater->fw->load (updater->fw, dest, dest_addr + updater->img_offset);
+	if ((checkpoint->step != step) ||
+		(checkpoint->phase == FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE)) {
+		checkpoint->step = step;
+		checkpoint->backup_length = 0;
+		checkpoint->offset = 0;
+
+		status = firmware_update_checkpoint (updater, checkpoint,
+			FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED);
 		if (status != 0) {
-			firmware_update_status_change (callback, backup_fail);
+			firmware_update_status_change (callback, (backup) ? backup_fail : update_fail);
 			return status;
 		}
+	}
+	else if (checkpoint->phase == FIRMWARE_UPDATE_JOURNAL_PHASE_DONE) {
+		/* This image was completely written before the update was interrupted. */
+		return 0;
+	}
 
-		backup_len = updater->fw->get_image_size (updater->fw);
-		if (ROT_IS_ERROR (backup_len)) {
-			firmware_update_status_change (callback, backup_fail);
-			return backup_len;
-		}
+	if (backup) {
+		if (checkpoint->phase < FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE) {
+			/* Backup the current image. */
+			firmware_update_status_change (callback, backup_start);
+			status = updater->fw->load (updater->fw, dest, dest_addr + updater->img_offset);
+			if (status != 0) {
+				firmware_update_status_change (callback, backup_fail);
+				return status;
+			}
 
-		status = flash_copy_ext_and_verify (backup, backup_addr + updater->img_offset, dest,
-			dest_addr + updater->img_offset, backup_len);
-		if (status != 0) {
-			firmware_update_status_change (callback, backup_fail);
-			return status;
+			backup_len = updater->fw->get_image_size (updater->fw);
+			if (ROT_IS_ERROR (backup_len)) {
+				firmware_update_status_change (callback, backup_fail);
+				return backup_len;
+			}
+
+			status = flash_copy_ext_and_verify (backup, backup_addr + updater->img_offset, dest,
+				dest_addr + updater->img_offset, backup_len);
+			if (status == 0) {
+				checkpoint->backup_length = backup_len;
+				status = firmware_update_checkpoint (updater, checkpoint,
+					FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE);
+			}
+
+			if (status != 0) {
+				firmware_update_status_change (callback, backup_fail);
+				return status;
+			}
+		}
+		else {
+			/* The current image may already be partially overwritten, so use the saved backup. */
+			backup_len = checkpoint->backup_length;
 		}
 	}
 
@@ -470,15 +728,21 @@ static int firmware_update_write_image (struct firmware_update *updater,
 	}
 
 	*img_good = false;
-	status = flash_erase_region_and_verify (dest, dest_addr + updater->img_offset, update_len);
-	if (status != 0) {
-		firmware_update_status_change (callback, update_fail);
-		return status;
+	if (updater->journal) {
+		status = firmware_update_program_checkpointed (updater, dest,
+			dest_addr + updater->img_offset, update_len, page, checkpoint);
 	}
+	else {
+		status = flash_erase_region_and_verify (dest, dest_addr + updater->img_offset, update_len);
+		if (status != 0) {
+			firmware_update_status_change (callback, update_fail);
+			return status;
+		}
 
-	status = firmware_update_program_bootable (updater, dest, dest_addr + updater->img_offset,
-		updater->flash->staging_flash, updater->flash->staging_addr + updater->img_offset,
-		update_len, page);
+		status = firmware_update_program_bootable (updater, dest, dest_addr + updater->img_offset,
+			updater->flash->staging_flash, updater->flash->staging_addr + updater->img_offset,
+			update_len, page);
+	}
 	if (status == 0) {
 		status = firmware_update_finalize_image (updater, dest, dest_addr);
 	}
@@ -503,6 +767,184 @@ static int firmware_update_write_image (struct firmware_update *updater,
 	}
 
 	*img_good = true;
+
+	status = firmware_update_checkpoint (updater, checkpoint, FIRMWARE_UPDATE_JOURNAL_PHASE_DONE);
+	if (status != 0) {
+		/* The new image is in flash, so this doesn't fail the update.  If the update gets
+		 * interrupted, the image will be written again from the last stored checkpoint. */
+		debug_log_create_entry (DEBUG_LOG_SEVERITY_WARNING, DEBUG_LOG_COMPONENT_CERBERUS_FW,
+			FIRMWARE_LOGGING_JOURNAL_FAIL, status, FIRMWARE_UPDATE_JOURNAL_PHASE_DONE);
+	}
+
+	return 0;
+}
+
+/**
+ * Verify the loaded image in staging flash.  If a digest of the staging image was calculated while
+ * it was being received, the image will be verified using that digest.  Otherwise, the image data
+ * will be read from flash for verification.
+ *
+ * @param updater The updater being executed.
+ *
+ * @return 0 if the staging image is valid or an error code.
+ */
+static int firmware_update_verify_staging (struct firmware_update *updater)
+{
+	uint8_t digest[SHA256_HASH_LENGTH];
+	int status;
+
+	if (updater->stage_hash_active) {
+		if ((updater->stage_hashed == updater->stage_hash_length) && updater->fw->verify_digest) {
+			updater->stage_hash_active = false;
+
+			status = updater->stage_hash->finish (updater->stage_hash, digest, sizeof (digest));
+			if (status == 0) {
+				status = updater->fw->verify_digest (updater->fw, updater->hash, updater->rsa,
+					digest, updater->stage_hash_length);
+				if (status != FIRMWARE_IMAGE_DIGEST_LENGTH_MISMATCH) {
+					return status;
+				}
+			}
+			else {
+				updater->stage_hash->cancel (updater->stage_hash);
+			}
+		}
+		else {
+			firmware_update_cancel_staging_hash (updater);
+		}
+	}
+
+	return updater->fw->verify (updater->fw, updater->hash, updater->rsa);
+}
+
+/**
+ * Install the verified image in staging flash to the active and recovery regions and update
+ * certificate revocation information.
+ *
+ * @param updater The updater being executed.
+ * @param callback The update notification handlers.
+ * @param new_len The length of the new image.
+ * @param new_revision The recovery revision ID of the new image.
+ * @param checkpoint The progress of the update.  If an interrupted update is being resumed, image
+ * writes that have already completed will be skipped.
+ *
+ * @return 0 if the image was successfully installed or an error code.
+ */
+static int firmware_update_install_image (struct firmware_update *updater,
+	struct firmware_update_notification *callback, int new_len, int new_revision,
+	struct firmware_update_checkpoint *checkpoint)
+{
+	struct key_manifest *manifest;
+	bool resume = (checkpoint->phase != FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE);
+	bool recovery_first;
+	bool recovery_updated;
+	bool img_good;
+	int cert_revoked;
+	int status;
+
+	if (resume) {
+		recovery_first = (checkpoint->step == FIRMWARE_UPDATE_JOURNAL_STEP_RECOVERY_FIRST);
+		recovery_updated = !!(checkpoint->flags & FIRMWARE_UPDATE_JOURNAL_FLAG_RECOVERY_UPDATED);
+	}
+	else {
+		recovery_first = updater->recovery_bad;
+		recovery_updated = false;
+	}
+
+	/* Don't allow the active image to be erased until we have a good recovery image. */
+	if (updater->flash->recovery_flash && recovery_first) {
+		status = firmware_update_write_image (updater, callback, updater->flash->recovery_flash,
+			updater->flash->recovery_addr, NULL, 0, new_len, UPDATE_STATUS_BACKUP_RECOVERY,
+			UPDATE_STATUS_BACKUP_REC_FAIL, UPDATE_STATUS_UPDATE_RECOVERY,
+			UPDATE_STATUS_UPDATE_REC_FAIL, FIRMWARE_UPDATE_JOURNAL_STEP_RECOVERY_FIRST, checkpoint,
+			&img_good);
+		if (status != 0) {
+			return status;
+		}
+
+		updater->recovery_bad = !img_good;
+		recovery_updated = true;
+		checkpoint->flags |= FIRMWARE_UPDATE_JOURNAL_FLAG_RECOVERY_UPDATED;
+	}
+
+	/* Update the active image from staging flash. */
+	if (checkpoint->step <= FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE) {
+		status = firmware_update_write_image (updater, callback, updater->flash->active_flash,
+			updater->flash->active_addr, updater->flash->backup_flash, updater->flash->backup_addr,
+			new_len, UPDATE_STATUS_BACKUP_ACTIVE, UPDATE_STATUS_BACKUP_FAILED,
+			UPDATE_STATUS_UPDATING_IMAGE, UPDATE_STATUS_UPDATE_FAILED,
+			FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, checkpoint, &img_good);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	/* Check for certificate revocation. */
+	firmware_update_status_change (callback, UPDATE_STATUS_CHECK_REVOCATION);
+	status = updater->fw->load (updater->fw, updater->flash->active_flash,
+		updater->flash->active_addr + updater->img_offset);
+	if (status != 0) {
+		firmware_update_status_change (callback, UPDATE_STATUS_REVOKE_CHK_FAIL);
+		return status;
+	}
+
+	manifest = updater->fw->get_key_manifest (updater->fw);
+	if (manifest == NULL) {
+		firmware_update_status_change (callback, UPDATE_STATUS_REVOKE_CHK_FAIL);
+		return FIRMWARE_UPDATE_NO_KEY_MANIFEST;
+	}
+
+	cert_revoked = manifest->revokes_old_manifest (manifest);
+	if (ROT_IS_ERROR (cert_revoked)) {
+		firmware_update_status_change (callback, UPDATE_STATUS_REVOKE_CHK_FAIL);
+		return cert_revoked;
+	}
+
+	/* Check if recovery update is necessary.  An interrupted recovery update must be completed,
+	 * since the recovery image is no longer valid. */
+	firmware_update_status_change (callback, UPDATE_STATUS_CHECK_RECOVERY);
+	if (cert_revoked || (updater->recovery_rev != new_revision) ||
+		(checkpoint->step == FIRMWARE_UPDATE_JOURNAL_STEP_RECOVERY)) {
+		if (updater->flash->recovery_flash && !recovery_updated) {
+			struct flash *backup;
+			uint32_t backup_addr;
+
+			if (updater->flash->rec_backup_flash) {
+				backup = updater->flash->rec_backup_flash;
+				backup_addr = updater->flash->rec_backup_addr;
+			}
+			else {
+				backup = updater->flash->backup_flash;
+				backup_addr = updater->flash->backup_addr;
+			}
+
+			/* Update the recovery image from staging flash. */
+			status = firmware_update_write_image (updater, callback, updater->flash->recovery_flash,
+				updater->flash->recovery_addr, backup, backup_addr, new_len,
+				UPDATE_STATUS_BACKUP_RECOVERY, UPDATE_STATUS_BACKUP_REC_FAIL,
+				UPDATE_STATUS_UPDATE_RECOVERY, UPDATE_STATUS_UPDATE_REC_FAIL,
+				FIRMWARE_UPDATE_JOURNAL_STEP_RECOVERY, checkpoint, &img_good);
+
+			updater->recovery_bad = !img_good;
+			if (status != 0) {
+				return status;
+			}
+		}
+
+		updater->recovery_rev = new_revision;
+
+		if (cert_revoked) {
+			/* Revoke the old certificate. */
+			firmware_update_status_change (callback, UPDATE_STATUS_REVOKE_CERT);
+			status = manifest->update_revocation (manifest);
+			if (status != 0) {
+				firmware_update_status_change (callback, UPDATE_STATUS_REVOKE_FAILED);
+				return status;
+			}
+		}
+	}
+
+	/* Update completed successfully. */
 	return 0;
 }
 
@@ -515,6 +957,9 @@ static int firmware_update_write_image (struct firmware_update *updater,
  * 			revoked.
  * 		- Update certificate revocation information in the device.
  *
+ * If the updater has a journal and a previous update of the same image was interrupted, image
+ * writes that already completed will be skipped and the interrupted write will be resumed.
+ *
  * @param updater The updater that should run.
  * @param callback A set of notification handlers to use during the update process.  This can be
  * null if no notifications are necessary.  Also, individual callbacks that are not desired can be
@@ -526,13 +971,11 @@ int firmware_update_run_update (struct firmware_update *updater,
 	struct firmware_update_notification *callback)
 {
 	int new_len;
-	struct key_manifest *manifest;
 	struct firmware_header *header = NULL;
-	bool recovery_updated = false;
-	bool img_good;
-	int cert_revoked;
+	struct firmware_update_checkpoint checkpoint;
 	int new_revision;
 	int allow_update;
+	int clear_status;
 	int status;
 
 	if (updater == NULL) {
@@ -555,7 +998,7 @@ int firmware_update_run_update (struct firmware_update *updater,
 		return status;
 	}
 
-	status = updater->fw->verify (updater->fw, updater->hash, updater->rsa);
+	status = firmware_update_verify_staging (updater);
 	if (status != 0) {
 		if ((status == RSA_ENGINE_BAD_SIGNATURE) || (status == FIRMWARE_IMAGE_MANIFEST_REVOKED)) {
 			firmware_update_status_change (callback, UPDATE_STATUS_INVALID_IMAGE);
@@ -606,93 +1049,36 @@ int firmware_update_run_update (struct firmware_update *updater,
 		return status;
 	}
 
-	/* Don't allow the active image to be erased until we have a good recovery image. */
-	if (updater->flash->recovery_flash && updater->recovery_bad) {
-		status = firmware_update_write_image (updater, callback, updater->flash->recovery_flash,
-			updater->flash->recovery_addr, NULL, 0, new_len, UPDATE_STATUS_BACKUP_RECOVERY,
-			UPDATE_STATUS_BACKUP_REC_FAIL, UPDATE_STATUS_UPDATE_RECOVERY,
-			UPDATE_STATUS_UPDATE_REC_FAIL, &img_good);
-		if (status != 0) {
-			return status;
+	/* Resume an interrupted update of the same image.  The staging image has been verified again,
+	 * since it can't be trusted across a reset. */
+	memset (&checkpoint, 0, sizeof (checkpoint));
+	if (updater->journal) {
+		status = firmware_update_journal_get_checkpoint (updater->journal, &checkpoint);
+		if ((status != 0) || (checkpoint.image_length != (uint32_t) new_len)) {
+			memset (&checkpoint, 0, sizeof (checkpoint));
 		}
-
-		updater->recovery_bad = !img_good;
-		recovery_updated = true;
-	}
-
-	/* Update the active image from staging flash. */
-	status = firmware_update_write_image (updater, callback, updater->flash->active_flash,
-		updater->flash->active_addr, updater->flash->backup_flash, updater->flash->backup_addr,
-		new_len, UPDATE_STATUS_BACKUP_ACTIVE, UPDATE_STATUS_BACKUP_FAILED,
-		UPDATE_STATUS_UPDATING_IMAGE, UPDATE_STATUS_UPDATE_FAILED, &img_good);
-	if (status != 0) {
-		return status;
-	}
-
-	/* Check for certificate revocation. */
-	firmware_update_status_change (callback, UPDATE_STATUS_CHECK_REVOCATION);
-	status = updater->fw->load (updater->fw, updater->flash->active_flash,
-		updater->flash->active_addr + updater->img_offset);
-	if (status != 0) {
-		firmware_update_status_change (callback, UPDATE_STATUS_REVOKE_CHK_FAIL);
-		return status;
-	}
-
-	manifest = updater->fw->get_key_manifest (updater->fw);
-	if (manifest == NULL) {
-		firmware_update_status_change (callback, UPDATE_STATUS_REVOKE_CHK_FAIL);
-		return FIRMWARE_UPDATE_NO_KEY_MANIFEST;
 	}
+	checkpoint.image_length = new_len;
 
-	cert_revoked = manifest->revokes_old_manifest (manifest);
-	if (ROT_IS_ERROR (cert_revoked)) {
-		firmware_update_status_change (callback, UPDATE_STATUS_REVOKE_CHK_FAIL);
-		return cert_revoked;
-	}
+	status = firmware_update_install_image (updater, callback, new_len, new_revision,
+		&checkpoint);
 
-	/* Check if recovery update is necessary. */
-	firmware_update_status_change (callback, UPDATE_STATUS_CHECK_RECOVERY);
-	if (cert_revoked || (updater->recovery_rev != new_revision)) {
-		if (updater->flash->recovery_flash && !recovery_updated) {
-			struct flash *backup;
-			uint32_t backup_addr;
+	if (updater->journal) {
+		/* Whether the image was installed or the update failed, there is nothing left to resume.
+		 * If the journal can't be cleared, the update would be resumed on the next boot instead of
+		 * checking the images, so report the error even if the image was installed. */
+		clear_status = firmware_update_journal_clear (updater->journal);
+		if (clear_status != 0) {
+			debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_CERBERUS_FW,
+				FIRMWARE_LOGGING_JOURNAL_FAIL, clear_status, FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE);
 
-			if (updater->flash->rec_backup_flash) {
-				backup = updater->flash->rec_backup_flash;
-				backup_addr = updater->flash->rec_backup_addr;
-			}
-			else {
-				backup = updater->flash->backup_flash;
-				backup_addr = updater->flash->backup_addr;
-			}
-
-			/* Update the recovery image from staging flash. */
-			status = firmware_update_write_image (updater, callback, updater->flash->recovery_flash,
-				updater->flash->recovery_addr, backup, backup_addr, new_len,
-				UPDATE_STATUS_BACKUP_RECOVERY, UPDATE_STATUS_BACKUP_REC_FAIL,
-				UPDATE_STATUS_UPDATE_RECOVERY, UPDATE_STATUS_UPDATE_REC_FAIL, &img_good);
-
-			updater->recovery_bad = !img_good;
-			if (status != 0) {
-				return status;
-			}
-		}
-
-		updater->recovery_rev = new_revision;
-
-		if (cert_revoked) {
-			/* Revoke the old certificate. */
-			firmware_update_status_change (callback, UPDATE_STATUS_REVOKE_CERT);
-			status = manifest->update_revocation (manifest);
-			if (status != 0) {
-				firmware_update_status_change (callback, UPDATE_STATUS_REVOKE_FAILED);
-				return status;
+			if (status == 0) {
+				status = clear_status;
 			}
 		}
 	}
 
-	/* Update completed successfully. */
-	return 0;
+	return status;
 }
 
 /**
@@ -718,16 +1104,39 @@ int firmware_update_prepare_staging (struct firmware_update *updater,
 
 	firmware_update_status_change (callback, UPDATE_STATUS_STAGING_PREP);
 
+	firmware_update_cancel_staging_hash (updater);
+
+	if (updater->journal) {
+		/* An interrupted update can't be resumed once the staging image is replaced. */
+		status = firmware_update_journal_clear (updater->journal);
+		if (status != 0) {
+			firmware_update_status_change (callback, UPDATE_STATUS_STAGING_PREP_FAIL);
+			return status;
+		}
+	}
+
 	status = flash_updater_prepare_for_update (&updater->update_mgr, size);
 	if (status != 0) {
 		firmware_update_status_change (callback, UPDATE_STATUS_STAGING_PREP_FAIL);
+		return status;
 	}
 
-	return status;
+	/* If the digest can't be started, the image will be verified from flash.  There is no need to
+	 * calculate a digest that the image can't use for verification. */
+	if (updater->stage_hash && updater->fw->verify_digest && (size > updater->stage_sig_length) &&
+		(updater->stage_hash->start_sha256 (updater->stage_hash) == 0)) {
+		updater->stage_hash_length = size - updater->stage_sig_length;
+		updater->stage_hashed = 0;
+		updater->stage_hash_active = true;
+	}
+
+	return 0;
 }
 
 /**
- * Program FW update data to staging area
+ * Program FW update data to staging area.  If a digest of the staging image is being calculated,
+ * the data will also be added to the digest.  Since an image verified with this digest will not be
+ * read from flash, the programmed data is read back to ensure it matches the data in the digest.
  *
  * @param updater Updater to use
  * @param buf Buffer with FW update data to program
@@ -741,6 +1150,7 @@ int firmware_update_prepare_staging (struct firmware_update *updater,
 int firmware_update_write_to_staging (struct firmware_update *updater,
 	struct firmware_update_notification *callback, uint8_t *buf, size_t buf_len)
 {
+	size_t hash_len;
 	int status;
 
 	if ((updater == NULL) || (buf == NULL)) {
@@ -750,12 +1160,35 @@ int firmware_update_write_to_staging (struct firmware_update *updater,
 
 	firmware_update_status_change (callback, UPDATE_STATUS_STAGING_WRITE);
 
-	status = flash_updater_write_update_data (&updater->update_mgr, buf, buf_len);
+	if (updater->stage_hash_active) {
+		status = flash_updater_write_and_verify_update_data (&updater->update_mgr, buf, buf_len);
+	}
+	else {
+		status = flash_updater_write_update_data (&updater->update_mgr, buf, buf_len);
+	}
 	if (status != 0) {
+		firmware_update_cancel_staging_hash (updater);
 		firmware_update_status_change (callback, UPDATE_STATUS_STAGING_WRITE_FAIL);
+		return status;
 	}
 
-	return status;
+	if (updater->stage_hash_active) {
+		hash_len = updater->stage_hash_length - updater->stage_hashed;
+		if (buf_len < hash_len) {
+			hash_len = buf_len;
+		}
+
+		if (hash_len != 0) {
+			if (updater->stage_hash->update (updater->stage_hash, buf, hash_len) == 0) {
+				updater->stage_hashed += hash_len;
+			}
+			else {
+				firmware_update_cancel_staging_hash (updater);
+			}
+		}
+	}
+
+	return 0;
 }
 
 /**
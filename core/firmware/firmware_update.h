@@ -11,6 +11,7 @@
 #include "app_context.h"
 #include "firmware_image.h"
 #include "firmware_update_observer.h"
+#include "firmware_update_journal.h"
 #include "flash/flash.h"
 #include "flash/flash_updater.h"
 #include "crypto/hash.h"
@@ -127,6 +128,12 @@ struct firmware_update {
 	int recovery_rev;						/**< Revision ID of the current recovery image. */
 	int min_rev;							/**< Minimum revision ID allowed for update. */
 	int img_offset;							/**< Offset to apply to FW image regions. */
+	struct hash_engine *stage_hash;			/**< Dedicated hash engine for data written to staging. */
+	size_t stage_sig_length;				/**< Length of the signature at the end of staged images. */
+	size_t stage_hash_length;				/**< Number of staged bytes covered by the digest. */
+	size_t stage_hashed;					/**< Number of staged bytes added to the digest. */
+	bool stage_hash_active;					/**< Flag indicating the staging digest is being calculated. */
+	struct firmware_update_journal *journal;	/**< Progress journal for resuming interrupted updates. */
 	struct observable observable;			/**< Observer manager for the updater. */
 };
 
@@ -151,6 +158,11 @@ int firmware_update_init (struct firmware_update *updater, const struct firmware
 void firmware_update_release (struct firmware_update *updater);
 
 void firmware_update_set_image_offset (struct firmware_update *updater, int offset);
+void firmware_update_set_staging_hash (struct firmware_update *updater, struct hash_engine *hash,
+	size_t sig_length);
+void firmware_update_set_journal (struct firmware_update *updater,
+	struct firmware_update_journal *journal);
+bool firmware_update_is_resume_pending (struct firmware_update *updater);
 
 void firmware_update_set_recovery_good (struct firmware_update *updater, bool img_good);
 void firmware_update_set_recovery_revision (struct firmware_update *updater, int revision);
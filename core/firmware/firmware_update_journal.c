@@ -0,0 +1,259 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "firmware_update_journal.h"
+#include "flash/flash_util.h"
+#include "crypto/checksum.h"
+
+
+/**
+ * Marker identifying a programmed journal entry.
+ */
+#define	FIRMWARE_UPDATE_JOURNAL_MARKER		0x4a
+
+
+#pragma pack(push, 1)
+/**
+ * The format of a checkpoint stored in the journal.
+ */
+struct firmware_update_journal_entry {
+	uint8_t marker;						/**< Marker for a programmed entry. */
+	uint8_t step;						/**< The image write step in progress. */
+	uint8_t phase;						/**< The last completed phase of the write step. */
+	uint8_t flags;						/**< Additional state for the update. */
+	uint32_t image_length;				/**< Length of the image being installed. */
+	uint32_t backup_length;				/**< Length of the image saved to the backup region. */
+	uint32_t offset;					/**< Image offset of the first data not yet written. */
+	uint8_t reserved[3];				/**< Unused. */
+	uint8_t crc;						/**< CRC of the entry data. */
+};
+#pragma pack(pop)
+
+
+/**
+ * Check if a journal entry has never been programmed.
+ *
+ * @param entry The entry to check.
+ *
+ * @return true if the entry is blank.
+ */
+static bool firmware_update_journal_is_blank (const struct firmware_update_journal_entry *entry)
+{
+	const uint8_t *raw = (const uint8_t*) entry;
+	size_t i;
+
+	for (i = 0; i < sizeof (struct firmware_update_journal_entry); i++) {
+		if (raw[i] != 0xff) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Check if a journal entry contains a complete checkpoint.  Entries that were only partially
+ * written when power was lost will fail this check.
+ *
+ * @param entry The entry to check.
+ *
+ * @return true if the entry is valid.
+ */
+static bool firmware_update_journal_is_valid (const struct firmware_update_journal_entry *entry)
+{
+	return (entry->marker == FIRMWARE_UPDATE_JOURNAL_MARKER) &&
+		(entry->step <= FIRMWARE_UPDATE_JOURNAL_STEP_RECOVERY) &&
+		(entry->phase <= FIRMWARE_UPDATE_JOURNAL_PHASE_DONE) &&
+		(entry->crc == checksum_crc8 (0, (uint8_t*) entry,
+			sizeof (struct firmware_update_journal_entry) - 1));
+}
+
+/**
+ * Initialize a journal for firmware update progress.  The most recent checkpoint will be loaded
+ * from flash.
+ *
+ * @param journal The journal to initialize.
+ * @param flash The flash device that contains the journal.
+ * @param base_addr The address of the flash sector dedicated to the journal.
+ *
+ * @return 0 if the journal was successfully initialized or an error code.
+ */
+int firmware_update_journal_init (struct firmware_update_journal *journal, struct flash *flash,
+	uint32_t base_addr)
+{
+	struct firmware_update_journal_entry entry;
+	uint32_t offset;
+	int status;
+
+	if ((journal == NULL) || (flash == NULL)) {
+		return FIRMWARE_UPDATE_JOURNAL_INVALID_ARGUMENT;
+	}
+
+	memset (journal, 0, sizeof (struct firmware_update_journal));
+
+	status = flash->get_sector_size (flash, &journal->sector_size);
+	if (status != 0) {
+		return status;
+	}
+
+	if (FLASH_REGION_OFFSET (base_addr, journal->sector_size) != 0) {
+		return FIRMWARE_UPDATE_JOURNAL_NOT_SECTOR_ALIGNED;
+	}
+
+	journal->flash = flash;
+	journal->base_addr = base_addr;
+
+	for (offset = 0; (offset + sizeof (entry)) <= journal->sector_size; offset += sizeof (entry)) {
+		status = flash->read (flash, base_addr + offset, (uint8_t*) &entry, sizeof (entry));
+		if (status != 0) {
+			return status;
+		}
+
+		if (firmware_update_journal_is_blank (&entry)) {
+			break;
+		}
+
+		if (firmware_update_journal_is_valid (&entry)) {
+			journal->checkpoint.step = entry.step;
+			journal->checkpoint.phase = entry.phase;
+			journal->checkpoint.flags = entry.flags;
+			journal->checkpoint.image_length = entry.image_length;
+			journal->checkpoint.backup_length = entry.backup_length;
+			journal->checkpoint.offset = entry.offset;
+		}
+	}
+
+	journal->next_entry = offset;
+
+	return 0;
+}
+
+/**
+ * Release the resources used by a firmware update journal.
+ *
+ * @param journal The journal to release.
+ */
+void firmware_update_journal_release (struct firmware_update_journal *journal)
+{
+
+}
+
+/**
+ * Add a new checkpoint to the journal.  If the journal sector is full, it will be erased first.  A
+ * loss of power during this erase will discard all update progress.
+ *
+ * @param journal The journal to update.
+ * @param checkpoint The checkpoint to record.
+ *
+ * @return 0 if the checkpoint was stored or an error code.
+ */
+int firmware_update_journal_record (struct firmware_update_journal *journal,
+	const struct firmware_update_checkpoint *checkpoint)
+{
+	struct firmware_update_journal_entry entry;
+	uint32_t addr;
+	int status;
+
+	if ((journal == NULL) || (checkpoint == NULL)) {
+		return FIRMWARE_UPDATE_JOURNAL_INVALID_ARGUMENT;
+	}
+
+	if ((journal->next_entry + sizeof (entry)) > journal->sector_size) {
+		status = journal->flash->sector_erase (journal->flash, journal->base_addr);
+		if (status != 0) {
+			return status;
+		}
+
+		journal->next_entry = 0;
+	}
+
+	entry.marker = FIRMWARE_UPDATE_JOURNAL_MARKER;
+	entry.step = checkpoint->step;
+	entry.phase = checkpoint->phase;
+	entry.flags = checkpoint->flags;
+	entry.image_length = checkpoint->image_length;
+	entry.backup_length = checkpoint->backup_length;
+	entry.offset = checkpoint->offset;
+	memset (entry.reserved, 0xff, sizeof (entry.reserved));
+	entry.crc = checksum_crc8 (0, (uint8_t*) &entry, sizeof (entry) - 1);
+
+	/* Once anything has been written, the entry location can't be used again. */
+	addr = journal->base_addr + journal->next_entry;
+	journal->next_entry += sizeof (entry);
+
+	status = journal->flash->write (journal->flash, addr, (uint8_t*) &entry, sizeof (entry));
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+	else if (status != sizeof (entry)) {
+		return FIRMWARE_UPDATE_JOURNAL_INCOMPLETE_WRITE;
+	}
+
+	status = flash_verify_data (journal->flash, addr, (uint8_t*) &entry, sizeof (entry));
+	if (status != 0) {
+		return status;
+	}
+
+	journal->checkpoint = *checkpoint;
+	return 0;
+}
+
+/**
+ * Mark the journal as having no update in progress.  Nothing is written to flash if the journal
+ * is already idle.
+ *
+ * If the idle checkpoint can't be stored, the journal sector is erased instead so the last
+ * checkpoint is no longer valid.
+ *
+ * @param journal The journal to clear.
+ *
+ * @return 0 if the journal was cleared or an error code.
+ */
+int firmware_update_journal_clear (struct firmware_update_journal *journal)
+{
+	struct firmware_update_checkpoint idle;
+	int status;
+
+	if (journal == NULL) {
+		return FIRMWARE_UPDATE_JOURNAL_INVALID_ARGUMENT;
+	}
+
+	if (journal->checkpoint.phase == FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE) {
+		return 0;
+	}
+
+	memset (&idle, 0, sizeof (idle));
+	status = firmware_update_journal_record (journal, &idle);
+	if (status != 0) {
+		status = journal->flash->sector_erase (journal->flash, journal->base_addr);
+		if (status == 0) {
+			journal->next_entry = 0;
+			journal->checkpoint = idle;
+		}
+	}
+
+	return status;
+}
+
+/**
+ * Get the most recent checkpoint stored in the journal.
+ *
+ * @param journal The journal to query.
+ * @param checkpoint Output for the checkpoint.  If no update is in progress, the phase will be
+ * FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE.
+ *
+ * @return 0 if the checkpoint was retrieved or an error code.
+ */
+int firmware_update_journal_get_checkpoint (struct firmware_update_journal *journal,
+	struct firmware_update_checkpoint *checkpoint)
+{
+	if ((journal == NULL) || (checkpoint == NULL)) {
+		return FIRMWARE_UPDATE_JOURNAL_INVALID_ARGUMENT;
+	}
+
+	*checkpoint = journal->checkpoint;
+	return 0;
+}
@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef FIRMWARE_UPDATE_JOURNAL_H_
+#define FIRMWARE_UPDATE_JOURNAL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "status/rot_status.h"
+#include "flash/flash.h"
+
+
+/**
+ * The image write steps of a firmware update that are tracked in the journal.
+ */
+enum firmware_update_journal_step {
+	FIRMWARE_UPDATE_JOURNAL_STEP_RECOVERY_FIRST = 0,	/**< Writing a bad recovery image before the active image. */
+	FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,				/**< Writing the active image. */
+	FIRMWARE_UPDATE_JOURNAL_STEP_RECOVERY,				/**< Writing the recovery image after the active image. */
+};
+
+/**
+ * The last completed phase of an image write step.
+ */
+enum firmware_update_journal_phase {
+	FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE = 0,				/**< No update is in progress. */
+	FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED,				/**< The write step has started. */
+	FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE,			/**< The current image has been backed up. */
+	FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM,				/**< Image data is being copied after the header block. */
+	FIRMWARE_UPDATE_JOURNAL_PHASE_HEADER,				/**< The block with the start of the image is being copied. */
+	FIRMWARE_UPDATE_JOURNAL_PHASE_DONE,					/**< The write step has completed. */
+};
+
+/**
+ * Flag indicating the recovery image has already been written during the update.
+ */
+#define	FIRMWARE_UPDATE_JOURNAL_FLAG_RECOVERY_UPDATED	(1U << 0)
+
+
+/**
+ * Progress information for a firmware update.
+ */
+struct firmware_update_checkpoint {
+	uint8_t step;						/**< The image write step in progress. */
+	uint8_t phase;						/**< The last completed phase of the write step. */
+	uint8_t flags;						/**< Additional state for the update. */
+	uint32_t image_length;				/**< Length of the image being installed. */
+	uint32_t backup_length;				/**< Length of the image saved to the backup region. */
+	uint32_t offset;					/**< Image offset of the first data not yet written. */
+};
+
+/**
+ * Non-volatile journal of firmware update progress.  Checkpoints are appended to a dedicated flash
+ * sector so an update interrupted by a power loss can resume from the last completed checkpoint.
+ * The sector is only erased when it has no room for another checkpoint.
+ */
+struct firmware_update_journal {
+	struct flash *flash;				/**< The flash device that contains the journal. */
+	uint32_t base_addr;					/**< The base address of the journal sector. */
+	uint32_t sector_size;				/**< The size of the journal sector. */
+	uint32_t next_entry;				/**< Sector offset for the next journal entry. */
+	struct firmware_update_checkpoint checkpoint;	/**< The most recent checkpoint. */
+};
+
+
+int firmware_update_journal_init (struct firmware_update_journal *journal, struct flash *flash,
+	uint32_t base_addr);
+void firmware_update_journal_release (struct firmware_update_journal *journal);
+
+int firmware_update_journal_record (struct firmware_update_journal *journal,
+	const struct firmware_update_checkpoint *checkpoint);
+int firmware_update_journal_clear (struct firmware_update_journal *journal);
+int firmware_update_journal_get_checkpoint (struct firmware_update_journal *journal,
+	struct firmware_update_checkpoint *checkpoint);
+
+
+#define	FIRMWARE_UPDATE_JOURNAL_ERROR(code)		ROT_ERROR (ROT_MODULE_FIRMWARE_UPDATE_JOURNAL, code)
+
+/**
+ * Error codes that can be generated by the firmware update journal.
+ */
+enum {
+	FIRMWARE_UPDATE_JOURNAL_INVALID_ARGUMENT = FIRMWARE_UPDATE_JOURNAL_ERROR (0x00),	/**< Input parameter is null or not valid. */
+	FIRMWARE_UPDATE_JOURNAL_NO_MEMORY = FIRMWARE_UPDATE_JOURNAL_ERROR (0x01),			/**< Memory allocation failed. */
+	FIRMWARE_UPDATE_JOURNAL_NOT_SECTOR_ALIGNED = FIRMWARE_UPDATE_JOURNAL_ERROR (0x02),	/**< The journal is not aligned to a flash sector. */
+	FIRMWARE_UPDATE_JOURNAL_INCOMPLETE_WRITE = FIRMWARE_UPDATE_JOURNAL_ERROR (0x03),	/**< Only part of a journal entry was written. */
+};
+
+
+#endif /* FIRMWARE_UPDATE_JOURNAL_H_ */
@@ -228,6 +228,39 @@ int flash_updater_write_update_data (struct flash_updater *updater, const uint8_
 	return (status == length) ? 0 : FLASH_UPDATER_INCOMPLETE_WRITE;
 }
 
+/**
+ * Write update data to flash and verify that it was programmed correctly by reading it back.  The
+ * flash must have already been prepared for the update for this data to be written correctly.
+ *
+ * The data will be written to the same location as with flash_updater_write_update_data.  If the
+ * verification fails, the data is still counted as written.
+ *
+ * @param updater The flash updater that will write the data.
+ * @param data The data to write to flash.
+ * @param length The amount of data to write.
+ *
+ * @return 0 if all of the data was written and verified successfully or an error code.
+ */
+int flash_updater_write_and_verify_update_data (struct flash_updater *updater,
+	const uint8_t *data, size_t length)
+{
+	uint32_t addr;
+	int status;
+
+	if (updater == NULL) {
+		return FLASH_UPDATER_INVALID_ARGUMENT;
+	}
+
+	addr = updater->base_addr + updater->write_offset;
+
+	status = flash_updater_write_update_data (updater, data, length);
+	if (status != 0) {
+		return status;
+	}
+
+	return flash_verify_data (updater->flash, addr, data, length);
+}
+
 /**
  * Get the total number of update bytes written to the flash.
  *
@@ -38,6 +38,8 @@ int flash_updater_prepare_for_update_erase_all (struct flash_updater *updater, s
 
 int flash_updater_write_update_data (struct flash_updater *updater, const uint8_t *data,
 	size_t length);
+int flash_updater_write_and_verify_update_data (struct flash_updater *updater,
+	const uint8_t *data, size_t length);
 
 size_t flash_updater_get_bytes_written (struct flash_updater *updater);
 int flash_updater_get_remaining_bytes (struct flash_updater *updater);
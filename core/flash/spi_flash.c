@@ -8,6 +8,7 @@
 #include "spi_flash.h"
 #include "flash/flash_common.h"
 #include "flash/flash_logging.h"
+#include "logging/trace_buffer.h"
 
 
 /* Status bits indicating when flash is operating in 4-byte address mode. */
@@ -35,6 +36,25 @@
 	}
 
 
+/**
+ * Submit a transfer to the SPI master for the flash device.
+ *
+ * @param flash The flash instance to use for the transfer.
+ * @param xfer The transfer to execute.
+ *
+ * @return 0 if the transfer was executed successfully or an error code.
+ */
+static int spi_flash_xfer (struct spi_flash *flash, const struct flash_xfer *xfer)
+{
+	int status;
+
+	TRACE_BEGIN (TRACE_EVENT_FLASH_XFER, xfer->cmd, xfer->length);
+	status = flash->spi->xfer (flash->spi, xfer);
+	TRACE_END (TRACE_EVENT_FLASH_XFER, xfer->cmd, status);
+
+	return status;
+}
+
 /**
  * Configure the read command for the flash device.
  *
@@ -439,7 +459,7 @@ static int spi_flash_simple_command (struct spi_flash *flash, uint8_t cmd)
 	struct flash_xfer xfer;
 
 	FLASH_XFER_INIT_CMD_ONLY (xfer, cmd, 0);
-	return flash->spi->xfer (flash->spi, &xfer);
+	return spi_flash_xfer (flash, &xfer);
 }
 
 /**
@@ -486,7 +506,7 @@ static int spi_flash_is_wip_set (struct spi_flash *flash)
 		FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR_FLAG, &reg, 1, 0);
 	}
 
-	status = flash->spi->xfer (flash->spi, &xfer);
+	status = spi_flash_xfer (flash, &xfer);
 	if (status == 0) {
 		if (!flash->use_busy_flag) {
 			return ((reg & FLASH_STATUS_WIP) != 0);
@@ -584,7 +604,7 @@ static int spi_flash_write_register (struct spi_flash *flash, uint8_t cmd, uint8
 	}
 
 	FLASH_XFER_INIT_WRITE_REG (xfer, cmd, data, length, 0);
-	status = flash->spi->xfer (flash->spi, &xfer);
+	status = spi_flash_xfer (flash, &xfer);
 	if (status != 0) {
 		return status;
 	}
@@ -739,7 +759,7 @@ int spi_flash_get_device_id (struct spi_flash *flash, uint8_t *vendor, uint16_t
 		FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDID, flash->device_id, sizeof (flash->device_id),
 			0);
 
-		status = flash->spi->xfer (flash->spi, &xfer);
+		status = spi_flash_xfer (flash, &xfer);
 		if (status != 0) {
 			flash->device_id[0] = 0xff;
 			goto exit;
@@ -860,7 +880,7 @@ int spi_flash_clear_block_protect (struct spi_flash *flash)
 
 		case SPI_FLASH_SFDP_QUAD_QE_BIT1_SR2_35:
 			FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR2, &reg[1], 1, 0);
-			status = flash->spi->xfer (flash->spi, &xfer);
+			status = spi_flash_xfer (flash, &xfer);
 			if (status != 0) {
 				goto exit;
 			}
@@ -871,7 +891,7 @@ int spi_flash_clear_block_protect (struct spi_flash *flash)
 	}
 
 	FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR, reg, cmd_len, 0);
-	status = flash->spi->xfer (flash->spi, &xfer);
+	status = spi_flash_xfer (flash, &xfer);
 	if (status != 0) {
 		goto exit;
 	}
@@ -1074,7 +1094,7 @@ int spi_flash_detect_4byte_address_mode (struct spi_flash *flash)
 	platform_mutex_lock (&flash->lock);
 
 	FLASH_XFER_INIT_READ_REG (xfer, cmd, &reg, 1, 0);
-	status = flash->spi->xfer (flash->spi, &xfer);
+	status = spi_flash_xfer (flash, &xfer);
 	if (status != 0) {
 		goto exit;
 	}
@@ -1164,7 +1184,7 @@ int spi_flash_enable_quad_spi (struct spi_flash *flash, uint8_t enable)
 
 		case SPI_FLASH_SFDP_QUAD_QE_BIT1_SR2_35:
 			FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR2, &reg[1], 1, 0);
-			status = flash->spi->xfer (flash->spi, &xfer);
+			status = spi_flash_xfer (flash, &xfer);
 			if (status != 0) {
 				goto exit;
 			}
@@ -1186,7 +1206,7 @@ int spi_flash_enable_quad_spi (struct spi_flash *flash, uint8_t enable)
 	}
 
 	FLASH_XFER_INIT_READ_REG (xfer, cmd, reg, cmd_len, 0);
-	status = flash->spi->xfer (flash->spi, &xfer);
+	status = spi_flash_xfer (flash, &xfer);
 	if (status != 0) {
 		goto exit;
 	}
@@ -1301,7 +1321,7 @@ int spi_flash_is_quad_spi_enabled (struct spi_flash *flash)
 	}
 
 	FLASH_XFER_INIT_READ_REG (xfer, cmd, reg, cmd_len, 0);
-	status = flash->spi->xfer (flash->spi, &xfer);
+	status = spi_flash_xfer (flash, &xfer);
 	if (status != 0) {
 		goto exit;
 	}
@@ -1363,7 +1383,7 @@ int spi_flash_configure_drive_strength (struct spi_flash *flash)
 	switch (vendor) {
 		case FLASH_ID_WINBOND:
 			FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR3, &reg, 1, 0);
-			status = flash->spi->xfer (flash->spi, &xfer);
+			status = spi_flash_xfer (flash, &xfer);
 			if (status != 0) {
 				break;
 			}
@@ -1376,7 +1396,7 @@ int spi_flash_configure_drive_strength (struct spi_flash *flash)
 				}
 
 				FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR3, &reg, 1, 0);
-				status = flash->spi->xfer (flash->spi, &xfer);
+				status = spi_flash_xfer (flash, &xfer);
 				if (status != 0) {
 					break;
 				}
@@ -1423,7 +1443,7 @@ int spi_flash_read (struct spi_flash *flash, uint32_t address, uint8_t *data, si
 
 	FLASH_XFER_INIT_READ (xfer, flash->command.read, address, flash->command.read_dummy,
 		flash->command.read_mode, data, length, flash->command.read_flags | flash->addr_mode);
-	status = flash->spi->xfer (flash->spi, &xfer);
+	status = spi_flash_xfer (flash, &xfer);
 
 exit:
 	platform_mutex_unlock (&flash->lock);
@@ -1522,7 +1542,7 @@ int spi_flash_write (struct spi_flash *flash, uint32_t address, const uint8_t *d
 		FLASH_XFER_INIT_WRITE (xfer, flash->command.write, address, 0, (uint8_t*) data, write_len,
 			flash->command.write_flags | flash->addr_mode);
 
-		status = flash->spi->xfer (flash->spi, &xfer);
+		status = spi_flash_xfer (flash, &xfer);
 		if (status == 0) {
 			status = spi_flash_wait_for_write_completion (flash, -1, 1);
 			if (status == 0) {
@@ -1541,7 +1561,7 @@ exit:
 	length = length - remaining;
 	if (length) {
 		if (status != 0) {
-			debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_FLASH,
+			DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_FLASH,
 				FLASH_LOGGING_INCOMPLETE_WRITE, address, status);
 		}
 		return length;
@@ -1586,7 +1606,7 @@ static int spi_flash_erase_region (struct spi_flash *flash, uint32_t address, ui
 
 	FLASH_XFER_INIT_NO_DATA (xfer, erase_cmd, address, erase_flags | flash->addr_mode);
 
-	status = flash->spi->xfer (flash->spi, &xfer);
+	status = spi_flash_xfer (flash, &xfer);
 	if (status != 0) {
 		goto exit;
 	}
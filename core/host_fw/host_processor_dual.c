@@ -11,6 +11,7 @@
 #include "host_logging.h"
 #include "flash/flash_util.h"
 #include "recovery/recovery_image.h"
+#include "logging/trace_buffer.h"
 
 
 /**
@@ -348,6 +349,8 @@ static int host_processor_dual_validate_flash (struct host_processor_dual *host,
 	bool checked_rw = true;
 	bool pfm_dirty = host_state_manager_is_pfm_dirty (host->state);
 
+	TRACE_BEGIN (TRACE_EVENT_HOST_VALIDATE_FLASH, is_pending, 0);
+
 	if (!is_bypass && host_state_manager_is_inactive_dirty (host->state)) {
 		if (!is_validated) {
 			host_state_manager_set_run_time_validation (host->state, HOST_STATE_PREVALIDATED_NONE);
@@ -493,6 +496,7 @@ static int host_processor_dual_validate_flash (struct host_processor_dual *host,
 	}
 
 exit:
+	TRACE_END (TRACE_EVENT_HOST_VALIDATE_FLASH, is_pending, status);
 	return status;
 }
 
@@ -559,6 +563,7 @@ static int host_processor_dual_power_on_reset (struct host_processor *host,
 	}
 
 	platform_mutex_lock (&dual->lock);
+	TRACE_BEGIN (TRACE_EVENT_HOST_POWER_ON_RESET, 0, 0);
 
 	host_state_manager_set_pfm_dirty (dual->state, true);
 	host_state_manager_set_bypass_mode (dual->state, false);
@@ -630,6 +635,7 @@ exit:
 		dual->pfm->free_pfm (dual->pfm, pending_pfm);
 	}
 	if (status != 0) {
+		TRACE_END (TRACE_EVENT_HOST_POWER_ON_RESET, 0, status);
 		platform_mutex_unlock (&dual->lock);
 		return status;
 	}
@@ -637,6 +643,7 @@ exit:
 exit_host:
 	host_processor_dual_set_host_flash_access (dual);
 
+	TRACE_END (TRACE_EVENT_HOST_POWER_ON_RESET, 0, status);
 	platform_mutex_unlock (&dual->lock);
 	return status;
 }
@@ -663,6 +670,7 @@ static int host_processor_dual_soft_reset (struct host_processor *host, struct h
 	}
 
 	platform_mutex_lock (&dual->lock);
+	TRACE_BEGIN (TRACE_EVENT_HOST_SOFT_RESET, 0, 0);
 
 	active_pfm = dual->pfm->get_active_pfm (dual->pfm);
 	pending_pfm = dual->pfm->get_pending_pfm (dual->pfm);
@@ -776,6 +784,7 @@ exit:
 	 * in cases where the reset is never set is not an issue. */
 	dual->control->hold_processor_in_reset (dual->control, false);
 
+	TRACE_END (TRACE_EVENT_HOST_SOFT_RESET, 0, status);
 	platform_mutex_unlock (&dual->lock);
 	return status;
 }
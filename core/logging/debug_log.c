@@ -6,10 +6,12 @@
 
 
 struct logging *debug_log = NULL;
+int debug_log_severity_threshold = DEBUG_LOG_SEVERITY_INFO;
 
 
 /**
- * Create a new entry in the debug log.
+ * Create a new entry in the debug log.  Entries less severe than the current debug log severity
+ * level are discarded.
  *
  * @param severity Severity level of the new entry.
  * @param component Component that is generating the entry.
@@ -32,6 +34,10 @@ int debug_log_create_entry (uint8_t severity, uint8_t component, uint8_t msg_ind
 		return LOGGING_UNSUPPORTED_SEVERITY;
 	}
 
+	if (severity > debug_log_severity_threshold) {
+		return 0;
+	}
+
 	entry.format = DEBUG_LOG_ENTRY_FORMAT;
 	entry.severity = severity;
 	entry.component = component;
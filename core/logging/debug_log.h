@@ -13,6 +13,12 @@
  */
 extern struct logging *debug_log;
 
+/**
+ * The least severe level of entries that will be added to the debug log.  Entries with a higher
+ * severity value are discarded before the entry is created.  This defaults to allowing all entries.
+ */
+extern int debug_log_severity_threshold;
+
 
 /**
  * Severity levels for log entries.
@@ -44,6 +50,7 @@ enum debug_log_component {
 	DEBUG_LOG_COMPONENT_MCTP,					/**< Log entry for MCTP stack */
 	DEBUG_LOG_COMPONENT_TPM,					/**< Log entry for TPM */
 	DEBUG_LOG_COMPONENT_RIOT,					/**< Log entry for RIoT */
+	DEBUG_LOG_COMPONENT_LOGGING,				/**< Log entry for the logging infrastructure */
 	DEBUG_LOG_COMPONENT_DEVICE_SPECIFIC = 0xff	/**< Log entry for device-specific messages */
 };
 
@@ -77,6 +84,57 @@ struct debug_log_entry {
 #pragma pack(pop)
 
 
+/**
+ * The least severe level of entries that will be compiled into the firmware when using
+ * DEBUG_LOG_CREATE_ENTRY.  Entries with a higher severity value will be removed at compile time.
+ */
+#ifndef DEBUG_LOG_COMPILE_SEVERITY
+#define	DEBUG_LOG_COMPILE_SEVERITY			DEBUG_LOG_SEVERITY_INFO
+#endif
+
+/**
+ * Bitmask of components whose entries will be compiled into the firmware when using
+ * DEBUG_LOG_CREATE_ENTRY.  Each bit corresponds to the component with the same ID.  Components with
+ * IDs that don't fit in the mask, such as DEBUG_LOG_COMPONENT_DEVICE_SPECIFIC, are always enabled.
+ */
+#ifndef DEBUG_LOG_COMPILE_COMPONENTS
+#define	DEBUG_LOG_COMPILE_COMPONENTS		0xffffffffU
+#endif
+
+/**
+ * Determine if debug log entries for a severity level and component are compiled into the firmware.
+ *
+ * @param severity Severity level of the entry.
+ * @param component Component that is generating the entry.
+ */
+#define	DEBUG_LOG_IS_COMPILED(severity, component) \
+	(((severity) <= DEBUG_LOG_COMPILE_SEVERITY) && (((component) > 31) || \
+		((DEBUG_LOG_COMPILE_COMPONENTS) & (1U << ((component) & 0x1f)))))
+
+/**
+ * Create a new entry in the debug log from a performance sensitive code path.
+ *
+ * Entries that are not enabled at compile time will generate no code.  Enabled entries are checked
+ * against the runtime severity level before calling debug_log_create_entry, so filtered entries
+ * don't incur the cost of building and dispatching the entry.  Arguments are only evaluated if the
+ * entry will be created, so they must not have side effects.  The status of adding the entry to the
+ * log is not reported.
+ *
+ * @param severity Severity level of the new entry.
+ * @param component Component that is generating the entry.
+ * @param msg_index Identifier code for the log entry message.
+ * @param arg1 Log entry optional message specific argument.
+ * @param arg2 Log entry optional message specific argument.
+ */
+#define	DEBUG_LOG_CREATE_ENTRY(severity, component, msg_index, arg1, arg2) \
+	do { \
+		if (DEBUG_LOG_IS_COMPILED (severity, component) && \
+			((severity) <= debug_log_severity_threshold)) { \
+			debug_log_create_entry (severity, component, msg_index, arg1, arg2); \
+		} \
+	} while (0)
+
+
 int debug_log_create_entry (uint8_t severity, uint8_t component, uint8_t msg_index, uint32_t arg1,
 	uint32_t arg2);
 int debug_log_flush (void);
@@ -101,6 +101,17 @@ struct logging {
 	 */
 	int (*read_contents) (struct logging *logging, uint32_t offset, uint8_t *contents,
 		size_t length);
+
+	/**
+	 * Get the maximum length of a single entry that can be added to the log.  This does not
+	 * include the log entry header.
+	 *
+	 * @param logging The log to query.
+	 *
+	 * @return The maximum entry length or an error code.  Use ROT_IS_ERROR to check the return
+	 * value.
+	 */
+	int (*get_max_entry_length) (struct logging *logging);
 };
 
 
@@ -122,6 +133,8 @@ enum {
 	LOGGING_STORAGE_NOT_ALIGNED = LOGGING_ERROR (9),		/**< Memory for the log is not aligned correctly. */
 	LOGGING_BAD_ENTRY_LENGTH = LOGGING_ERROR (10),			/**< The entry data is not the right size for the log. */
 	LOGGING_NO_LOG_AVAILABLE = LOGGING_ERROR (11),			/**< There is no log available for the operation. */
+	LOGGING_STAGING_FULL = LOGGING_ERROR (12),				/**< There is no space to stage a new entry. */
+	LOGGING_ENTRY_RATE_LIMITED = LOGGING_ERROR (13),		/**< The entry was dropped due to a rate limit. */
 };
 
 
@@ -0,0 +1,359 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "logging_coalesce.h"
+#include "logging_logging.h"
+
+
+/**
+ * Add a debug log entry to the log.
+ *
+ * @param coalesce The log to update.
+ * @param severity Severity level of the new entry.
+ * @param msg_index Identifier code for the log entry message.
+ * @param arg1 Message specific argument.
+ * @param arg2 Message specific argument.
+ *
+ * @return 0 if the entry was added to the log or an error code.
+ */
+static int logging_coalesce_add_debug_entry (struct logging_coalesce *coalesce, uint8_t severity,
+	uint8_t msg_index, uint32_t arg1, uint32_t arg2)
+{
+	struct debug_log_entry_info entry;
+
+	entry.format = DEBUG_LOG_ENTRY_FORMAT;
+	entry.severity = severity;
+	entry.component = DEBUG_LOG_COMPONENT_LOGGING;
+	entry.msg_index = msg_index;
+	entry.arg1 = arg1;
+	entry.arg2 = arg2;
+
+	return coalesce->log->create_entry (coalesce->log, (uint8_t*) &entry, sizeof (entry));
+}
+
+/**
+ * Report any copies of the last entry that have been suppressed.  The lock must be held by the
+ * caller.
+ *
+ * The report is added to the log immediately after the entry being repeated, so the entry itself
+ * does not need to be identified.
+ *
+ * @param coalesce The log to update.
+ */
+static void logging_coalesce_report_repeats (struct logging_coalesce *coalesce)
+{
+	if (coalesce->repeats != 0) {
+		logging_coalesce_add_debug_entry (coalesce, DEBUG_LOG_SEVERITY_INFO,
+			LOGGING_LOGGING_REPEATED_ENTRY, coalesce->repeats,
+			platform_get_duration (&coalesce->first, &coalesce->latest));
+
+		coalesce->repeats = 0;
+	}
+}
+
+/**
+ * Find the rate limit for a component.
+ *
+ * @param coalesce The log to query.
+ * @param component The component to find.
+ *
+ * @return The rate limit for the component or null if the component is not limited.
+ */
+static struct logging_coalesce_limit* logging_coalesce_find_limit (
+	struct logging_coalesce *coalesce, uint8_t component)
+{
+	size_t i;
+
+	for (i = 0; i < coalesce->limit_count; i++) {
+		if (coalesce->limits[i].component == component) {
+			return &coalesce->limits[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Consume a token for a new entry from a component rate limit.
+ *
+ * @param limit The rate limit to update.
+ * @param now The current time.
+ *
+ * @return true if the entry can be logged or false if it must be dropped.
+ */
+static bool logging_coalesce_consume_token (struct logging_coalesce_limit *limit,
+	platform_clock *now)
+{
+	uint32_t earned;
+
+	earned = platform_get_duration (&limit->refill, now) / limit->period_ms;
+	if (earned != 0) {
+		if (earned >= (uint32_t) (limit->burst - limit->tokens)) {
+			limit->tokens = limit->burst;
+			limit->refill = *now;
+		}
+		else {
+			limit->tokens += earned;
+			platform_increase_timeout (earned * limit->period_ms, &limit->refill);
+		}
+	}
+
+	if (limit->tokens == 0) {
+		limit->dropped++;
+		return false;
+	}
+
+	limit->tokens--;
+	return true;
+}
+
+static int logging_coalesce_create_entry (struct logging *logging, uint8_t *entry, size_t length)
+{
+	struct logging_coalesce *coalesce = (struct logging_coalesce*) logging;
+	struct debug_log_entry_info info;
+	struct logging_coalesce_limit *limit;
+	platform_clock now;
+	int status;
+
+	if ((coalesce == NULL) || (entry == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&coalesce->lock);
+
+	if (length == sizeof (info)) {
+		memcpy (&info, entry, sizeof (info));
+	}
+
+	if ((length != sizeof (info)) || (info.format != DEBUG_LOG_ENTRY_FORMAT)) {
+		/* Other entries are not coalesced, but they still end any sequence of repeated entries. */
+		logging_coalesce_report_repeats (coalesce);
+		coalesce->last_valid = false;
+
+		status = coalesce->log->create_entry (coalesce->log, entry, length);
+
+		platform_mutex_unlock (&coalesce->lock);
+		return status;
+	}
+
+	platform_init_current_tick (&now);
+
+	if (coalesce->last_valid && (memcmp (&coalesce->last, &info, sizeof (info)) == 0) &&
+		(platform_get_duration (&coalesce->first, &now) < coalesce->window_ms)) {
+		coalesce->repeats++;
+		coalesce->latest = now;
+
+		platform_mutex_unlock (&coalesce->lock);
+		return 0;
+	}
+
+	logging_coalesce_report_repeats (coalesce);
+	coalesce->last_valid = false;
+
+	limit = logging_coalesce_find_limit (coalesce, info.component);
+	if (limit) {
+		if (!logging_coalesce_consume_token (limit, &now)) {
+			platform_mutex_unlock (&coalesce->lock);
+			return LOGGING_ENTRY_RATE_LIMITED;
+		}
+
+		if (limit->dropped != 0) {
+			logging_coalesce_add_debug_entry (coalesce, DEBUG_LOG_SEVERITY_WARNING,
+				LOGGING_LOGGING_RATE_LIMITED, limit->component, limit->dropped);
+			limit->dropped = 0;
+		}
+	}
+
+	status = coalesce->log->create_entry (coalesce->log, entry, length);
+	if (status == 0) {
+		memcpy (&coalesce->last, &info, sizeof (info));
+		coalesce->last_valid = true;
+		coalesce->first = now;
+	}
+
+	platform_mutex_unlock (&coalesce->lock);
+
+	return status;
+}
+
+static int logging_coalesce_flush (struct logging *logging)
+{
+	struct logging_coalesce *coalesce = (struct logging_coalesce*) logging;
+
+	if (coalesce == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&coalesce->lock);
+	logging_coalesce_report_repeats (coalesce);
+	platform_mutex_unlock (&coalesce->lock);
+
+	return coalesce->log->flush (coalesce->log);
+}
+
+static int logging_coalesce_clear (struct logging *logging)
+{
+	struct logging_coalesce *coalesce = (struct logging_coalesce*) logging;
+	size_t i;
+	int status;
+
+	if (coalesce == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&coalesce->lock);
+
+	coalesce->last_valid = false;
+	coalesce->repeats = 0;
+	for (i = 0; i < coalesce->limit_count; i++) {
+		coalesce->limits[i].dropped = 0;
+	}
+
+	status = coalesce->log->clear (coalesce->log);
+
+	platform_mutex_unlock (&coalesce->lock);
+
+	return status;
+}
+
+static int logging_coalesce_get_size (struct logging *logging)
+{
+	struct logging_coalesce *coalesce = (struct logging_coalesce*) logging;
+
+	if (coalesce == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	return coalesce->log->get_size (coalesce->log);
+}
+
+static int logging_coalesce_read_contents (struct logging *logging, uint32_t offset,
+	uint8_t *contents, size_t length)
+{
+	struct logging_coalesce *coalesce = (struct logging_coalesce*) logging;
+
+	if ((coalesce == NULL) || (contents == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	return coalesce->log->read_contents (coalesce->log, offset, contents, length);
+}
+
+static int logging_coalesce_get_max_entry_length (struct logging *logging)
+{
+	struct logging_coalesce *coalesce = (struct logging_coalesce*) logging;
+
+	if (coalesce == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	return coalesce->log->get_max_entry_length (coalesce->log);
+}
+
+/**
+ * Initialize a log that coalesces repeated debug log entries before adding them to another log.
+ *
+ * An entry is coalesced if it is identical to the last debug log entry added to the log and was
+ * created within the coalescing window of that entry.  Suppressed copies are reported when a
+ * different entry is created, the window expires, or the log is flushed.
+ *
+ * @param logging The log to initialize.
+ * @param log The log that will store the entries.  Entries should not be added to this log
+ * directly.
+ * @param window_ms The amount of time, in milliseconds, after an entry is logged during which
+ * copies of that entry will be suppressed.  Set this to 0 to disable coalescing.
+ *
+ * @return 0 if the log was successfully initialized or an error code.
+ */
+int logging_coalesce_init (struct logging_coalesce *logging, struct logging *log,
+	uint32_t window_ms)
+{
+	int status;
+
+	if ((logging == NULL) || (log == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	memset (logging, 0, sizeof (struct logging_coalesce));
+
+	status = platform_mutex_init (&logging->lock);
+	if (status != 0) {
+		return status;
+	}
+
+	logging->log = log;
+	logging->window_ms = window_ms;
+
+	logging->base.create_entry = logging_coalesce_create_entry;
+	logging->base.flush = logging_coalesce_flush;
+	logging->base.clear = logging_coalesce_clear;
+	logging->base.get_size = logging_coalesce_get_size;
+	logging->base.read_contents = logging_coalesce_read_contents;
+	logging->base.get_max_entry_length = logging_coalesce_get_max_entry_length;
+
+	return 0;
+}
+
+/**
+ * Release the resources used by a coalescing log.  Any suppressed entries that have not been
+ * reported will be lost.
+ *
+ * @param logging The log to release.
+ */
+void logging_coalesce_release (struct logging_coalesce *logging)
+{
+	if (logging) {
+		platform_mutex_free (&logging->lock);
+	}
+}
+
+/**
+ * Configure per-component rate limits for debug log entries.  Components without a rate limit can
+ * log entries without restriction.
+ *
+ * When an entry is dropped due to a rate limit, a LOGGING_LOGGING_RATE_LIMITED entry will be added
+ * before the next entry from that component is logged to report the number of dropped entries.
+ *
+ * @param logging The log to configure.
+ * @param limits The rate limits to apply.  The component, burst, and period for each limit must be
+ * set by the caller.  The remaining state will be initialized, and each component will start with
+ * a full token bucket.  The limits must remain valid for the lifetime of the log.  Null to remove
+ * all rate limits.
+ * @param count The number of rate limits.
+ *
+ * @return 0 if the rate limits were configured or an error code.
+ */
+int logging_coalesce_set_rate_limits (struct logging_coalesce *logging,
+	struct logging_coalesce_limit *limits, size_t count)
+{
+	platform_clock now;
+	size_t i;
+
+	if ((logging == NULL) || ((limits == NULL) && (count != 0))) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	for (i = 0; i < count; i++) {
+		if ((limits[i].burst == 0) || (limits[i].period_ms == 0)) {
+			return LOGGING_INVALID_ARGUMENT;
+		}
+	}
+
+	platform_init_current_tick (&now);
+
+	for (i = 0; i < count; i++) {
+		limits[i].tokens = limits[i].burst;
+		limits[i].refill = now;
+		limits[i].dropped = 0;
+	}
+
+	platform_mutex_lock (&logging->lock);
+	logging->limits = limits;
+	logging->limit_count = count;
+	platform_mutex_unlock (&logging->lock);
+
+	return 0;
+}
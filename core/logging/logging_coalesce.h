@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef LOGGING_COALESCE_H_
+#define LOGGING_COALESCE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "logging.h"
+#include "debug_log.h"
+#include "platform.h"
+
+
+/**
+ * Rate limit applied to debug log entries from a single component.  Limits are enforced with a
+ * token bucket:  each entry consumes a token, and tokens are earned at a fixed rate up to a maximum
+ * burst size.
+ */
+struct logging_coalesce_limit {
+	uint8_t component;				/**< The component being rate limited. */
+	uint16_t burst;					/**< The maximum number of entries that can be logged at once. */
+	uint32_t period_ms;				/**< Time required to earn a token for one additional entry. */
+	uint16_t tokens;				/**< The number of entries that can currently be logged. */
+	platform_clock refill;			/**< The time the last token was earned. */
+	uint32_t dropped;				/**< Entries dropped since the last entry was logged. */
+};
+
+/**
+ * A log that suppresses repeated and excessive debug log entries before they reach another log.
+ *
+ * Identical debug log entries created within a window are coalesced into a single entry followed by
+ * a LOGGING_LOGGING_REPEATED_ENTRY entry that reports how many copies were suppressed.  Debug log
+ * entries can also be rate limited per component.  Entries that are not debug log entries are
+ * passed through unmodified.
+ */
+struct logging_coalesce {
+	struct logging base;					/**< The base logging instance. */
+	struct logging *log;					/**< The log that will store the entries. */
+	uint32_t window_ms;						/**< Time during which repeated entries are coalesced. */
+	struct logging_coalesce_limit *limits;	/**< Rate limits for debug log components. */
+	size_t limit_count;						/**< The number of component rate limits. */
+	struct debug_log_entry_info last;		/**< The last debug log entry added to the log. */
+	bool last_valid;						/**< Flag indicating if the last entry is valid. */
+	uint32_t repeats;						/**< Copies of the last entry that have been suppressed. */
+	platform_clock first;					/**< The time the last entry was added to the log. */
+	platform_clock latest;					/**< The time of the most recent suppressed copy. */
+	platform_mutex lock;					/**< Synchronization for log accesses. */
+};
+
+
+int logging_coalesce_init (struct logging_coalesce *logging, struct logging *log,
+	uint32_t window_ms);
+void logging_coalesce_release (struct logging_coalesce *logging);
+
+int logging_coalesce_set_rate_limits (struct logging_coalesce *logging,
+	struct logging_coalesce_limit *limits, size_t count);
+
+
+#endif /* LOGGING_COALESCE_H_ */
@@ -39,6 +39,8 @@ static int logging_flash_save_buffer (struct logging_flash *logging)
 			}
 
 			logging->flash_used[curr_sector_num] = 0;
+			logging->sector_offset[curr_sector_num] = logging->flash_end;
+			logging->erase_count++;
 
 			if (logging->log_start == curr_sector_num) {
 				int next_sector = (logging->log_start + 1) % LOGGING_FLASH_SECTORS;
@@ -63,6 +65,7 @@ static int logging_flash_save_buffer (struct logging_flash *logging)
 
 		logging->next_addr += write_len;
 		logging->flash_used[curr_sector_num] += write_len;
+		logging->flash_end += write_len;
 
 		if (status == 0) {
 			if (((logging->write_remain < sizeof (struct logging_entry_header)) ||
@@ -79,6 +82,7 @@ static int logging_flash_save_buffer (struct logging_flash *logging)
 				sizeof (logging->entry_buffer) - FLASH_SECTOR_OFFSET (logging->next_addr);
 			if (logging->terminated) {
 				logging->flash_used[curr_sector_num] -= sizeof (struct logging_entry_header);
+				logging->flash_end -= sizeof (struct logging_entry_header);
 				logging->terminated = false;
 			}
 		}
@@ -189,6 +193,9 @@ static int logging_flash_clear (struct logging *logging)
 	}
 
 	memset (flash_log->flash_used, 0, sizeof (flash_log->flash_used));
+	memset (flash_log->sector_offset, 0, sizeof (flash_log->sector_offset));
+	flash_log->flash_end = 0;
+	flash_log->erase_count++;
 	flash_log->next_entry_id = 0;
 	flash_log->log_start = 0;
 
@@ -228,63 +235,212 @@ static int logging_flash_get_size (struct logging *logging)
 	return log_size;
 }
 
-static int logging_flash_read_contents (struct logging *logging, uint32_t offset, uint8_t *contents,
-	size_t length)
+/**
+ * Get the number of sectors, starting from the first sector in the log, that contain log data.
+ * The lock must be held by the caller.
+ *
+ * @param logging The log to query.
+ *
+ * @return The number of sectors with log data.
+ */
+static int logging_flash_get_sector_count (struct logging_flash *logging)
 {
-	struct logging_flash *flash_log = (struct logging_flash*) logging;
-	int bytes_read = 0;
+	int sectors = 0;
+
+	while ((sectors < LOGGING_FLASH_SECTORS) &&
+		(logging->flash_used[(logging->log_start + sectors) % LOGGING_FLASH_SECTORS] != 0)) {
+		sectors++;
+	}
+
+	return sectors;
+}
+
+/**
+ * Get the offset within the log where a sector starts.  The lock must be held by the caller.
+ *
+ * @param logging The log to query.
+ * @param sector The sector index, relative to the first sector in the log.
+ *
+ * @return The log offset for the start of the sector.
+ */
+static uint32_t logging_flash_get_sector_start (struct logging_flash *logging, int sector)
+{
+	return logging->sector_offset[(logging->log_start + sector) % LOGGING_FLASH_SECTORS] -
+		logging->sector_offset[logging->log_start];
+}
+
+/**
+ * Find the sector that contains a log offset.  The lock must be held by the caller.
+ *
+ * Sector offsets increase monotonically from the first sector in the log, so the sector can be
+ * found directly from the index without walking the log contents.
+ *
+ * @param logging The log to query.
+ * @param sectors The number of sectors that contain log data.
+ * @param offset The log offset to find.
+ *
+ * @return The index of the sector, relative to the first sector in the log, that contains the
+ * offset.  If the offset is past the end of the data on flash, the number of sectors is returned.
+ */
+static int logging_flash_find_sector (struct logging_flash *logging, int sectors, uint32_t offset)
+{
+	int low = 0;
+	int high = sectors;
+	int mid;
+
+	if (offset >= (logging->flash_end - logging->sector_offset[logging->log_start])) {
+		return sectors;
+	}
+
+	while ((high - low) > 1) {
+		mid = low + ((high - low) / 2);
+		if (logging_flash_get_sector_start (logging, mid) <= offset) {
+			low = mid;
+		}
+		else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+/**
+ * A region of flash to read for log data.
+ */
+struct logging_flash_read_region {
+	uint32_t addr;			/**< Flash address of the data. */
+	int length;				/**< Length of the data. */
+};
+
+/**
+ * Read data from the log.
+ *
+ * The lock is only held while determining the flash regions to read and copying buffered entries.
+ * Flash is read without holding the lock so new entries can still be created during the read.
+ *
+ * @param logging The log to read.
+ * @param offset Offset within the log to start reading data.
+ * @param contents Output buffer for the log contents.
+ * @param length Maximum number of bytes to read from the log.
+ * @param hold_lock Flag to hold the lock for the entire read.
+ * @param erased Output indicating if log data was erased while flash was being read without the
+ * lock.  If this is true, the data read may not be valid.
+ *
+ * @return The number of bytes read from the log or an error code.
+ */
+static int logging_flash_read_log (struct logging_flash *logging, uint32_t offset,
+	uint8_t *contents, size_t length, bool hold_lock, bool *erased)
+{
+	struct logging_flash_read_region regions[LOGGING_FLASH_SECTORS];
+	int region_count = 0;
+	uint32_t flash_len;
+	uint32_t erase_count;
+	size_t bytes_read = 0;
 	int i;
 	int sectors;
+	int sector;
 	int read_len;
-	int read_offset;
+	int read_offset = 0;
 	int status;
 
-	if ((flash_log == NULL) || (contents == NULL)) {
-		return LOGGING_INVALID_ARGUMENT;
-	}
+	*erased = false;
 
-	platform_mutex_lock (&flash_log->lock);
+	platform_mutex_lock (&logging->lock);
 
-	i = flash_log->log_start;
-	sectors = 0;
+	sectors = logging_flash_get_sector_count (logging);
+	flash_len = logging->flash_end - logging->sector_offset[logging->log_start];
 
-	while ((length != 0) && (sectors < LOGGING_FLASH_SECTORS) && (flash_log->flash_used[i] != 0)) {
-		read_offset = (offset < flash_log->flash_used[i]) ? offset : flash_log->flash_used[i];
-		read_len = (length < (flash_log->flash_used[i] - read_offset)) ?
-			length : (flash_log->flash_used[i] - read_offset);
+	i = logging_flash_find_sector (logging, sectors, offset);
+	if (i < sectors) {
+		read_offset = offset - logging_flash_get_sector_start (logging, i);
+	}
 
-		if (read_len != 0) {
-			status = spi_flash_read (flash_log->flash,
-				flash_log->base_addr + (FLASH_SECTOR_SIZE * i) + read_offset, contents, read_len);
-			if (status != 0) {
-				platform_mutex_unlock (&flash_log->lock);
-				return status;
-			}
+	while ((i < sectors) && (bytes_read < length)) {
+		sector = (logging->log_start + i) % LOGGING_FLASH_SECTORS;
+		read_len = logging->flash_used[sector] - read_offset;
+		if (read_len > (length - bytes_read)) {
+			read_len = length - bytes_read;
 		}
 
-		bytes_read += read_len;
-		contents += read_len;
-		length -= read_len;
-		offset -= read_offset;
+		regions[region_count].addr =
+			logging->base_addr + (FLASH_SECTOR_SIZE * sector) + read_offset;
+		regions[region_count].length = read_len;
+		region_count++;
 
-		i = (i + 1) % LOGGING_FLASH_SECTORS;
-		sectors++;
+		bytes_read += read_len;
+		read_offset = 0;
+		i++;
 	}
 
-	/* After reading all data from flash, read buffered entries that haven't been flushed yet. */
-	read_len = flash_log->next_write - flash_log->entry_buffer;
-	if (flash_log->terminated) {
+	/* After reading all data from flash, read buffered entries that haven't been flushed yet.
+	 * These must be copied while holding the lock since they can be flushed at any time. */
+	read_len = logging->next_write - logging->entry_buffer;
+	if (logging->terminated) {
 		read_len -= sizeof (struct logging_entry_header);
 	}
-	read_offset = (offset < read_len) ? offset : read_len;
-	read_len = (length < (read_len - read_offset)) ? length : (read_len - read_offset);
+	read_offset = (offset > flash_len) ? (offset - flash_len) : 0;
+	read_offset = (read_offset < read_len) ? read_offset : read_len;
+	read_len = ((length - bytes_read) < (read_len - read_offset)) ?
+		(length - bytes_read) : (read_len - read_offset);
 
-	memcpy (contents, flash_log->entry_buffer + read_offset, read_len);
-	bytes_read += read_len;
+	memcpy (contents + bytes_read, logging->entry_buffer + read_offset, read_len);
 
-	platform_mutex_unlock (&flash_log->lock);
+	erase_count = logging->erase_count;
+	if (!hold_lock) {
+		platform_mutex_unlock (&logging->lock);
+	}
 
-	return bytes_read;
+	status = 0;
+	for (i = 0; (i < region_count) && (status == 0); i++) {
+		status = spi_flash_read (logging->flash, regions[i].addr, contents, regions[i].length);
+		contents += regions[i].length;
+	}
+
+	if (!hold_lock) {
+		platform_mutex_lock (&logging->lock);
+		*erased = (erase_count != logging->erase_count);
+	}
+
+	platform_mutex_unlock (&logging->lock);
+
+	if (status != 0) {
+		return status;
+	}
+
+	return bytes_read + read_len;
+}
+
+static int logging_flash_read_contents (struct logging *logging, uint32_t offset, uint8_t *contents,
+	size_t length)
+{
+	struct logging_flash *flash_log = (struct logging_flash*) logging;
+	bool erased;
+	int status;
+
+	if ((flash_log == NULL) || (contents == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	status = logging_flash_read_log (flash_log, offset, contents, length, false, &erased);
+	if (erased) {
+		/* Log data was erased while it was being read, so the data read from flash may not match
+		 * the log state.  Read the log again without allowing any changes. */
+		status = logging_flash_read_log (flash_log, offset, contents, length, true, &erased);
+	}
+
+	return status;
+}
+
+static int logging_flash_get_max_entry_length (struct logging *logging)
+{
+	struct logging_flash *flash_log = (struct logging_flash*) logging;
+
+	if (flash_log == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	return sizeof (flash_log->entry_buffer) - sizeof (struct logging_entry_header);
 }
 
 /**
@@ -409,6 +565,17 @@ int logging_flash_init (struct logging_flash *logging, struct spi_flash *flash,
 		flash_addr = base_addr;
 	}
 
+	for (curr_sector_num = 0; curr_sector_num < LOGGING_FLASH_SECTORS; ++curr_sector_num) {
+		int sector = (logging->log_start + curr_sector_num) % LOGGING_FLASH_SECTORS;
+
+		if (logging->flash_used[sector] == 0) {
+			break;
+		}
+
+		logging->sector_offset[sector] = logging->flash_end;
+		logging->flash_end += logging->flash_used[sector];
+	}
+
 	status = platform_mutex_init (&logging->lock);
 	if (status != 0) {
 		return status;
@@ -426,6 +593,7 @@ int logging_flash_init (struct logging_flash *logging, struct spi_flash *flash,
 	logging->base.clear = logging_flash_clear;
 	logging->base.get_size = logging_flash_get_size;
 	logging->base.read_contents = logging_flash_read_contents;
+	logging->base.get_max_entry_length = logging_flash_get_max_entry_length;
 
 	return 0;
 }
@@ -33,6 +33,9 @@ struct logging_flash {
 	bool terminated;							/**< Entry buffer has been terminated. */
 	uint32_t next_entry_id;						/**< Next ID to assign to a log entry. */
 	int flash_used[LOGGING_FLASH_SECTORS];		/**< Number of valid bytes stored in each sector. */
+	uint32_t sector_offset[LOGGING_FLASH_SECTORS];	/**< Running log offset for the start of each sector. */
+	uint32_t flash_end;							/**< Running log offset for the end of data on flash. */
+	uint32_t erase_count;						/**< Number of times log data has been erased. */
 	uint32_t next_addr;							/**< Next flash address to write to. */
 	int log_start;								/**< The sector that contains the first entries. */
 };
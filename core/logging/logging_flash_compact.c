@@ -0,0 +1,824 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include "logging_flash_compact.h"
+#include "debug_log.h"
+#include "flash/flash_util.h"
+
+
+/**
+ * Marker at the start of every sector that contains log entries.
+ */
+#define	LOGGING_FLASH_COMPACT_SECTOR_MAGIC		0x3C
+
+/**
+ * The current version of the compact encoding.
+ */
+#define	LOGGING_FLASH_COMPACT_FORMAT			1
+
+/**
+ * Marker for an entry stored as raw bytes.  The marker is followed by the entry length encoded as a
+ * variable length integer and the entry data.
+ */
+#define	LOGGING_FLASH_COMPACT_TAG_RAW			0xD0
+
+/**
+ * Marker for a debug log entry.  The marker is followed by the severity, component, and message
+ * index bytes and both arguments encoded as variable length integers.
+ */
+#define	LOGGING_FLASH_COMPACT_TAG_DEBUG			0xD1
+
+/**
+ * Decoding status indicating there is no valid entry at the current location.
+ */
+#define	LOGGING_FLASH_COMPACT_NO_ENTRY			0
+
+/**
+ * Decoding status indicating there is not enough data to decode the entry.
+ */
+#define	LOGGING_FLASH_COMPACT_INCOMPLETE		-1
+
+/**
+ * The largest encoding for a 32-bit variable length integer.
+ */
+#define	LOGGING_FLASH_COMPACT_MAX_VARINT		5
+
+
+#pragma pack(push, 1)
+
+/**
+ * Header at the start of each sector of log entries.
+ */
+struct logging_flash_compact_sector_header {
+	uint8_t magic;				/**< Start of sector marker. */
+	uint8_t format;				/**< Format of the entries in the sector. */
+	uint32_t entry_id;			/**< ID of the first entry in the sector. */
+};
+
+#pragma pack(pop)
+
+
+/**
+ * State for reading expanded log entries.
+ */
+struct logging_flash_compact_reader {
+	uint32_t offset;			/**< Remaining offset before data should be returned. */
+	uint8_t *contents;			/**< Output buffer for log data. */
+	size_t length;				/**< Remaining space in the output buffer. */
+	int bytes_read;				/**< Total number of bytes read. */
+};
+
+
+/**
+ * Encode an integer using a variable number of bytes.  Each byte holds seven bits of the value,
+ * least significant first, with the high bit set when there are more bytes.
+ *
+ * @param value The value to encode.
+ * @param output Output for the encoded value.  This must have space for the largest encoding.
+ *
+ * @return The number of bytes in the encoded value.
+ */
+static size_t logging_flash_compact_encode_varint (uint32_t value, uint8_t *output)
+{
+	size_t length = 0;
+
+	do {
+		output[length] = value & 0x7f;
+		value >>= 7;
+		if (value != 0) {
+			output[length] |= 0x80;
+		}
+
+		length++;
+	} while (value != 0);
+
+	return length;
+}
+
+/**
+ * Decode an integer that was encoded using a variable number of bytes.
+ *
+ * @param data The encoded value.
+ * @param length The amount of data available.
+ * @param value Output for the decoded value.
+ *
+ * @return The number of bytes in the encoded value, LOGGING_FLASH_COMPACT_INCOMPLETE if there is
+ * not enough data, or LOGGING_FLASH_COMPACT_NO_ENTRY if the encoding is not valid.
+ */
+static int logging_flash_compact_decode_varint (const uint8_t *data, size_t length,
+	uint32_t *value)
+{
+	size_t i;
+
+	*value = 0;
+	for (i = 0; i < LOGGING_FLASH_COMPACT_MAX_VARINT; i++) {
+		if (i == length) {
+			return LOGGING_FLASH_COMPACT_INCOMPLETE;
+		}
+
+		if ((i == (LOGGING_FLASH_COMPACT_MAX_VARINT - 1)) && (data[i] > 0x0f)) {
+			return LOGGING_FLASH_COMPACT_NO_ENTRY;
+		}
+
+		*value |= (uint32_t) (data[i] & 0x7f) << (i * 7);
+		if (!(data[i] & 0x80)) {
+			return i + 1;
+		}
+	}
+
+	return LOGGING_FLASH_COMPACT_NO_ENTRY;
+}
+
+/**
+ * Encode a log entry.
+ *
+ * @param entry The entry data to encode.
+ * @param length Length of the entry data.
+ * @param output Output for the encoded entry.  This must have space for the largest encoding.
+ *
+ * @return The length of the encoded entry.
+ */
+static size_t logging_flash_compact_encode_entry (const uint8_t *entry, size_t length,
+	uint8_t *output)
+{
+	struct debug_log_entry_info info;
+	size_t pos = 1;
+
+	if (length == sizeof (info)) {
+		memcpy (&info, entry, sizeof (info));
+		if (info.format == DEBUG_LOG_ENTRY_FORMAT) {
+			output[0] = LOGGING_FLASH_COMPACT_TAG_DEBUG;
+			output[pos++] = info.severity;
+			output[pos++] = info.component;
+			output[pos++] = info.msg_index;
+			pos += logging_flash_compact_encode_varint (info.arg1, &output[pos]);
+			pos += logging_flash_compact_encode_varint (info.arg2, &output[pos]);
+
+			return pos;
+		}
+	}
+
+	output[0] = LOGGING_FLASH_COMPACT_TAG_RAW;
+	pos += logging_flash_compact_encode_varint (length, &output[pos]);
+	memcpy (&output[pos], entry, length);
+
+	return pos + length;
+}
+
+/**
+ * Decode a log entry.
+ *
+ * @param data The encoded entry.
+ * @param length The amount of encoded data available.
+ * @param entry Output for the decoded entry data.  This must have space for the largest entry.
+ * @param entry_length Output for the length of the decoded entry data.
+ *
+ * @return The length of the encoded entry, LOGGING_FLASH_COMPACT_INCOMPLETE if the entry is not
+ * complete, or LOGGING_FLASH_COMPACT_NO_ENTRY if there is no valid entry.
+ */
+static int logging_flash_compact_decode_entry (const uint8_t *data, size_t length, uint8_t *entry,
+	size_t *entry_length)
+{
+	struct debug_log_entry_info info;
+	uint32_t value;
+	size_t pos = 1;
+	int status;
+
+	if (length == 0) {
+		return LOGGING_FLASH_COMPACT_INCOMPLETE;
+	}
+
+	switch (data[0]) {
+		case LOGGING_FLASH_COMPACT_TAG_RAW:
+			status = logging_flash_compact_decode_varint (&data[pos], length - pos, &value);
+			if (status <= 0) {
+				return status;
+			}
+
+			pos += status;
+			if ((value == 0) || (value > LOGGING_FLASH_COMPACT_MAX_ENTRY_LENGTH)) {
+				return LOGGING_FLASH_COMPACT_NO_ENTRY;
+			}
+
+			if ((length - pos) < value) {
+				return LOGGING_FLASH_COMPACT_INCOMPLETE;
+			}
+
+			memcpy (entry, &data[pos], value);
+			*entry_length = value;
+
+			return pos + value;
+
+		case LOGGING_FLASH_COMPACT_TAG_DEBUG:
+			if ((length - pos) < 3) {
+				return LOGGING_FLASH_COMPACT_INCOMPLETE;
+			}
+
+			info.format = DEBUG_LOG_ENTRY_FORMAT;
+			info.severity = data[pos++];
+			info.component = data[pos++];
+			info.msg_index = data[pos++];
+
+			status = logging_flash_compact_decode_varint (&data[pos], length - pos, &value);
+			if (status <= 0) {
+				return status;
+			}
+
+			info.arg1 = value;
+			pos += status;
+
+			status = logging_flash_compact_decode_varint (&data[pos], length - pos, &value);
+			if (status <= 0) {
+				return status;
+			}
+
+			info.arg2 = value;
+			pos += status;
+
+			memcpy (entry, &info, sizeof (info));
+			*entry_length = sizeof (info);
+
+			return pos;
+
+		default:
+			return LOGGING_FLASH_COMPACT_NO_ENTRY;
+	}
+}
+
+/**
+ * Copy the requested portion of an expanded log entry to the output buffer.
+ *
+ * @param reader The state of the read request.
+ * @param entry The expanded entry, including the entry header.
+ * @param length Length of the expanded entry.
+ */
+static void logging_flash_compact_copy_entry (struct logging_flash_compact_reader *reader,
+	const uint8_t *entry, size_t length)
+{
+	size_t copy_len;
+
+	if (reader->offset >= length) {
+		reader->offset -= length;
+		return;
+	}
+
+	copy_len = length - reader->offset;
+	copy_len = (copy_len < reader->length) ? copy_len : reader->length;
+
+	memcpy (reader->contents, &entry[reader->offset], copy_len);
+	reader->contents += copy_len;
+	reader->length -= copy_len;
+	reader->bytes_read += copy_len;
+	reader->offset = 0;
+}
+
+/**
+ * Expand encoded log entries and copy the requested portion of them to the output buffer.
+ * Decoding stops at the first entry that is either incomplete or not valid.
+ *
+ * @param logging The log being read.
+ * @param data The encoded entries.
+ * @param length Length of the encoded data.
+ * @param entry_id The ID of the first encoded entry.  This will be updated with the ID of the next
+ * entry.
+ * @param reader The state of the read request.
+ *
+ * @return The number of encoded bytes that were processed.
+ */
+static size_t logging_flash_compact_read_entries (struct logging_flash_compact *logging,
+	const uint8_t *data, size_t length, uint32_t *entry_id,
+	struct logging_flash_compact_reader *reader)
+{
+	struct logging_entry_header header;
+	size_t entry_len;
+	size_t pos = 0;
+	int status;
+
+	while ((reader->length != 0) && (pos < length)) {
+		status = logging_flash_compact_decode_entry (&data[pos], length - pos,
+			&logging->entry[sizeof (header)], &entry_len);
+		if (status <= 0) {
+			break;
+		}
+
+		header.log_magic = LOGGING_MAGIC_START;
+		header.length = entry_len + sizeof (header);
+		header.entry_id = (*entry_id)++;
+		memcpy (logging->entry, &header, sizeof (header));
+
+		logging_flash_compact_copy_entry (reader, logging->entry, header.length);
+		pos += status;
+	}
+
+	return pos;
+}
+
+/**
+ * Read the entries stored in a single sector of the log.  The flash is read in small blocks, so
+ * entries are expanded as they are read.
+ *
+ * @param logging The log being read.
+ * @param sector The sector to read.
+ * @param reader The state of the read request.
+ *
+ * @return 0 if the sector was read successfully or an error code.
+ */
+static int logging_flash_compact_read_sector (struct logging_flash_compact *logging, int sector,
+	struct logging_flash_compact_reader *reader)
+{
+	struct logging_flash_compact_sector_header header;
+	uint32_t sector_addr = logging->base_addr + (FLASH_SECTOR_SIZE * sector);
+	uint32_t entry_id = 0;
+	size_t pos = 0;
+	size_t read_len;
+	size_t processed;
+	int status;
+
+	while ((reader->length != 0) && (pos < logging->flash_used[sector])) {
+		read_len = logging->flash_used[sector] - pos;
+		read_len = (read_len < sizeof (logging->encoded)) ? read_len : sizeof (logging->encoded);
+
+		status = logging->flash->read (logging->flash, sector_addr + pos, logging->encoded,
+			read_len);
+		if (status != 0) {
+			return status;
+		}
+
+		processed = 0;
+		if (pos == 0) {
+			memcpy (&header, logging->encoded, sizeof (header));
+			entry_id = header.entry_id;
+			processed = sizeof (header);
+		}
+
+		processed += logging_flash_compact_read_entries (logging, &logging->encoded[processed],
+			read_len - processed, &entry_id, reader);
+		if (processed == 0) {
+			/* The block doesn't contain any valid entries.  There is nothing else to read. */
+			break;
+		}
+
+		pos += processed;
+	}
+
+	return 0;
+}
+
+/**
+ * Add the header for a new sector to the entry buffer.  It is assumed the buffer is empty.
+ *
+ * @param logging The log to update.
+ */
+static void logging_flash_compact_write_sector_header (struct logging_flash_compact *logging)
+{
+	struct logging_flash_compact_sector_header header;
+
+	header.magic = LOGGING_FLASH_COMPACT_SECTOR_MAGIC;
+	header.format = LOGGING_FLASH_COMPACT_FORMAT;
+	header.entry_id = logging->next_entry_id;
+
+	memcpy (logging->next_write, &header, sizeof (header));
+	logging->next_write += sizeof (header);
+	logging->write_remain -= sizeof (header);
+}
+
+/**
+ * Move the write position to the start of the next sector.
+ *
+ * @param logging The log to update.
+ */
+static void logging_flash_compact_next_sector (struct logging_flash_compact *logging)
+{
+	logging->next_addr = FLASH_SECTOR_BASE (logging->next_addr) + FLASH_SECTOR_SIZE;
+	if (logging->next_addr >= (logging->base_addr + LOGGING_FLASH_AREA_LEN)) {
+		logging->next_addr = logging->base_addr;
+	}
+
+	logging->write_remain = sizeof (logging->entry_buffer);
+}
+
+/**
+ * Save the entry buffer to flash.
+ *
+ * @param logging The log that should be saved.
+ *
+ * @return 0 if the data was successfully saved or an error code.
+ */
+static int logging_flash_compact_save_buffer (struct logging_flash_compact *logging)
+{
+	int write_len;
+	int sector;
+	int next_sector;
+	int status;
+
+	if (logging->next_write == logging->entry_buffer) {
+		return 0;
+	}
+
+	write_len = logging->next_write - logging->entry_buffer;
+	sector = (FLASH_SECTOR_BASE (logging->next_addr) - logging->base_addr) / FLASH_SECTOR_SIZE;
+
+	if (FLASH_SECTOR_OFFSET (logging->next_addr) == 0) {
+		status = flash_sector_erase_region (logging->flash, logging->next_addr,
+			FLASH_SECTOR_SIZE);
+		if (status != 0) {
+			return status;
+		}
+
+		logging->flash_used[sector] = 0;
+		logging->log_size[sector] = 0;
+
+		if (logging->log_start == sector) {
+			next_sector = (logging->log_start + 1) % LOGGING_FLASH_SECTORS;
+			if (logging->flash_used[next_sector] != 0) {
+				logging->log_start = next_sector;
+			}
+		}
+	}
+
+	status = logging->flash->write (logging->flash, logging->next_addr, logging->entry_buffer,
+		write_len);
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+	else if (status != write_len) {
+		/* Leave the buffer unchanged so it will be written again on the next flush.  Rewriting the
+		 * same data to flash does not change the bytes that were already written, and entries
+		 * remain aligned with the sector header. */
+		return LOGGING_INCOMPLETE_FLUSH;
+	}
+
+	logging->next_addr += write_len;
+	logging->flash_used[sector] += write_len;
+	logging->log_size[sector] += logging->buffer_size;
+
+	logging->next_write = logging->entry_buffer;
+	logging->buffer_size = 0;
+	logging->buffer_id = logging->next_entry_id;
+
+	if (logging->next_addr >= (logging->base_addr + LOGGING_FLASH_AREA_LEN)) {
+		logging->next_addr = logging->base_addr;
+	}
+
+	logging->write_remain =
+		sizeof (logging->entry_buffer) - FLASH_SECTOR_OFFSET (logging->next_addr);
+
+	return 0;
+}
+
+static int logging_flash_compact_create_entry (struct logging *logging, uint8_t *entry,
+	size_t length)
+{
+	struct logging_flash_compact *flash_log = (struct logging_flash_compact*) logging;
+	size_t encoded_len;
+	int status;
+
+	if ((flash_log == NULL) || (entry == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	if ((length == 0) || (length > LOGGING_FLASH_COMPACT_MAX_ENTRY_LENGTH)) {
+		return LOGGING_BAD_ENTRY_LENGTH;
+	}
+
+	platform_mutex_lock (&flash_log->lock);
+
+	encoded_len = logging_flash_compact_encode_entry (entry, length, flash_log->encoded);
+
+	if (flash_log->write_remain < (int) encoded_len) {
+		status = logging_flash_compact_save_buffer (flash_log);
+		if (status != 0) {
+			platform_mutex_unlock (&flash_log->lock);
+			return status;
+		}
+
+		/* Any space left in the current sector remains blank, which marks the end of the
+		 * sector's entries. */
+		if (flash_log->write_remain < (int) encoded_len) {
+			logging_flash_compact_next_sector (flash_log);
+		}
+	}
+
+	if ((flash_log->next_write == flash_log->entry_buffer) &&
+		(FLASH_SECTOR_OFFSET (flash_log->next_addr) == 0)) {
+		logging_flash_compact_write_sector_header (flash_log);
+	}
+
+	memcpy (flash_log->next_write, flash_log->encoded, encoded_len);
+	flash_log->next_write += encoded_len;
+	flash_log->write_remain -= encoded_len;
+	flash_log->buffer_size += length + sizeof (struct logging_entry_header);
+	flash_log->next_entry_id++;
+
+	platform_mutex_unlock (&flash_log->lock);
+
+	return 0;
+}
+
+static int logging_flash_compact_flush (struct logging *logging)
+{
+	struct logging_flash_compact *flash_log = (struct logging_flash_compact*) logging;
+	int status;
+
+	if (flash_log == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&flash_log->lock);
+	status = logging_flash_compact_save_buffer (flash_log);
+	platform_mutex_unlock (&flash_log->lock);
+
+	return status;
+}
+
+static int logging_flash_compact_clear (struct logging *logging)
+{
+	struct logging_flash_compact *flash_log = (struct logging_flash_compact*) logging;
+	int status;
+
+	if (flash_log == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&flash_log->lock);
+
+	status = flash_erase_region (flash_log->flash, flash_log->base_addr, LOGGING_FLASH_AREA_LEN);
+	if (status != 0) {
+		goto exit;
+	}
+
+	memset (flash_log->flash_used, 0, sizeof (flash_log->flash_used));
+	memset (flash_log->log_size, 0, sizeof (flash_log->log_size));
+	flash_log->next_entry_id = 0;
+	flash_log->log_start = 0;
+
+	flash_log->next_addr = flash_log->base_addr;
+	flash_log->next_write = flash_log->entry_buffer;
+	flash_log->write_remain = sizeof (flash_log->entry_buffer);
+	flash_log->buffer_size = 0;
+	flash_log->buffer_id = 0;
+
+exit:
+	platform_mutex_unlock (&flash_log->lock);
+	return status;
+}
+
+static int logging_flash_compact_get_size (struct logging *logging)
+{
+	struct logging_flash_compact *flash_log = (struct logging_flash_compact*) logging;
+	int sector;
+	int log_size = 0;
+
+	if (flash_log == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&flash_log->lock);
+
+	for (sector = 0; sector < LOGGING_FLASH_SECTORS; ++sector) {
+		log_size += flash_log->log_size[sector];
+	}
+
+	log_size += flash_log->buffer_size;
+
+	platform_mutex_unlock (&flash_log->lock);
+
+	return log_size;
+}
+
+static int logging_flash_compact_read_contents (struct logging *logging, uint32_t offset,
+	uint8_t *contents, size_t length)
+{
+	struct logging_flash_compact *flash_log = (struct logging_flash_compact*) logging;
+	struct logging_flash_compact_reader reader;
+	uint32_t entry_id;
+	size_t header_len = 0;
+	int i;
+	int sectors;
+	int status;
+
+	if ((flash_log == NULL) || (contents == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	reader.offset = offset;
+	reader.contents = contents;
+	reader.length = length;
+	reader.bytes_read = 0;
+
+	platform_mutex_lock (&flash_log->lock);
+
+	i = flash_log->log_start;
+	sectors = 0;
+
+	while ((reader.length != 0) && (sectors < LOGGING_FLASH_SECTORS) &&
+		(flash_log->flash_used[i] != 0)) {
+		/* Skip sectors that don't contain any requested data without reading them. */
+		if (reader.offset >= flash_log->log_size[i]) {
+			reader.offset -= flash_log->log_size[i];
+		}
+		else {
+			status = logging_flash_compact_read_sector (flash_log, i, &reader);
+			if (status != 0) {
+				platform_mutex_unlock (&flash_log->lock);
+				return status;
+			}
+		}
+
+		i = (i + 1) % LOGGING_FLASH_SECTORS;
+		sectors++;
+	}
+
+	/* After reading all data from flash, read buffered entries that haven't been flushed yet. */
+	if ((flash_log->next_write != flash_log->entry_buffer) &&
+		(FLASH_SECTOR_OFFSET (flash_log->next_addr) == 0)) {
+		header_len = sizeof (struct logging_flash_compact_sector_header);
+	}
+
+	entry_id = flash_log->buffer_id;
+	logging_flash_compact_read_entries (flash_log, &flash_log->entry_buffer[header_len],
+		(flash_log->next_write - flash_log->entry_buffer) - header_len, &entry_id, &reader);
+
+	platform_mutex_unlock (&flash_log->lock);
+
+	return reader.bytes_read;
+}
+
+/**
+ * Scan a sector of the log for stored entries.
+ *
+ * @param logging The log being initialized.
+ * @param sector The sector to scan.
+ * @param first_id Output for the ID of the first entry in the sector.
+ * @param entries Output for the number of entries stored in the sector.
+ * @param full Output indicating if no more entries can be added to the sector.
+ *
+ * @return 0 if the sector was scanned successfully or an error code.
+ */
+static int logging_flash_compact_scan_sector (struct logging_flash_compact *logging, int sector,
+	uint32_t *first_id, uint32_t *entries, bool *full)
+{
+	struct logging_flash_compact_sector_header header;
+	uint32_t sector_addr = logging->base_addr + (FLASH_SECTOR_SIZE * sector);
+	size_t length = sizeof (logging->entry_buffer) - sizeof (header);
+	size_t pos = 0;
+	size_t entry_len;
+	int status;
+
+	*entries = 0;
+	*full = false;
+
+	status = logging->flash->read (logging->flash, sector_addr, (uint8_t*) &header,
+		sizeof (header));
+	if (status != 0) {
+		return status;
+	}
+
+	if ((header.magic != LOGGING_FLASH_COMPACT_SECTOR_MAGIC) ||
+		(header.format != LOGGING_FLASH_COMPACT_FORMAT)) {
+		return 0;
+	}
+
+	status = logging->flash->read (logging->flash, sector_addr + sizeof (header),
+		logging->entry_buffer, length);
+	if (status != 0) {
+		return status;
+	}
+
+	do {
+		status = logging_flash_compact_decode_entry (&logging->entry_buffer[pos], length - pos,
+			logging->entry, &entry_len);
+		if (status > 0) {
+			pos += status;
+			logging->log_size[sector] += entry_len + sizeof (struct logging_entry_header);
+			(*entries)++;
+		}
+	} while (status > 0);
+
+	/* If the entries don't end with blank flash, nothing else can be written to the sector. */
+	if ((pos == length) || (logging->entry_buffer[pos] != 0xff)) {
+		*full = true;
+	}
+
+	logging->flash_used[sector] = pos + sizeof (header);
+	*first_id = header.entry_id;
+
+	return 0;
+}
+
+static int logging_flash_compact_get_max_entry_length (struct logging *logging)
+{
+	if (logging == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	return LOGGING_FLASH_COMPACT_MAX_ENTRY_LENGTH;
+}
+
+/**
+ * Initialize a log that uses flash for persistent storage of compact log entries.  Log entries
+ * already on flash will be detected and maintained.
+ *
+ * The log will consume an entire flash erase block.
+ *
+ * @param logging The log to initialize.
+ * @param flash The flash device where log entries are stored.
+ * @param base_addr The starting address for log entries.  This must be aligned to the beginning of
+ * an erase block.
+ *
+ * @return 0 if the log was successfully initialized or an error code.
+ */
+int logging_flash_compact_init (struct logging_flash_compact *logging, struct flash *flash,
+	uint32_t base_addr)
+{
+	int sector;
+	int newest = -1;
+	uint32_t first_id;
+	uint32_t oldest_id = 0;
+	uint32_t newest_id = 0;
+	uint32_t entries;
+	bool full;
+	bool newest_full = false;
+	int status;
+
+	if ((logging == NULL) || (flash == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	if (FLASH_BLOCK_BASE (base_addr) != base_addr) {
+		return LOGGING_STORAGE_NOT_ALIGNED;
+	}
+
+	memset (logging, 0, sizeof (struct logging_flash_compact));
+
+	logging->flash = flash;
+	logging->base_addr = base_addr;
+
+	for (sector = 0; sector < LOGGING_FLASH_SECTORS; sector++) {
+		status = logging_flash_compact_scan_sector (logging, sector, &first_id, &entries, &full);
+		if (status != 0) {
+			return status;
+		}
+
+		if (logging->flash_used[sector] != 0) {
+			if ((newest < 0) || (first_id < oldest_id)) {
+				oldest_id = first_id;
+				logging->log_start = sector;
+			}
+
+			if ((newest < 0) || (first_id >= newest_id)) {
+				newest_id = first_id;
+				newest = sector;
+				newest_full = full;
+				logging->next_entry_id = first_id + entries;
+			}
+		}
+	}
+
+	if (newest < 0) {
+		logging->next_addr = base_addr;
+		logging->write_remain = sizeof (logging->entry_buffer);
+	}
+	else {
+		logging->next_addr = base_addr + (FLASH_SECTOR_SIZE * newest) + logging->flash_used[newest];
+		logging->write_remain = sizeof (logging->entry_buffer) - logging->flash_used[newest];
+
+		if (newest_full) {
+			logging_flash_compact_next_sector (logging);
+		}
+	}
+
+	status = platform_mutex_init (&logging->lock);
+	if (status != 0) {
+		return status;
+	}
+
+	logging->next_write = logging->entry_buffer;
+	logging->buffer_id = logging->next_entry_id;
+
+	logging->base.create_entry = logging_flash_compact_create_entry;
+	logging->base.flush = logging_flash_compact_flush;
+	logging->base.clear = logging_flash_compact_clear;
+	logging->base.get_size = logging_flash_compact_get_size;
+	logging->base.read_contents = logging_flash_compact_read_contents;
+	logging->base.get_max_entry_length = logging_flash_compact_get_max_entry_length;
+
+	return 0;
+}
+
+/**
+ * Release the resources used by a compact flash log.  The contents on flash will remain.  Any
+ * entries not already on flash will be lost.
+ *
+ * @param logging The log to release.
+ */
+void logging_flash_compact_release (struct logging_flash_compact *logging)
+{
+	if (logging) {
+		platform_mutex_free (&logging->lock);
+	}
+}
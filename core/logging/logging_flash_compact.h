@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef LOGGING_FLASH_COMPACT_H_
+#define LOGGING_FLASH_COMPACT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "logging.h"
+#include "logging_flash.h"
+#include "platform.h"
+#include "flash/flash.h"
+#include "flash/flash_common.h"
+
+
+/**
+ * The maximum length of a single entry that can be added to the log.  This does not include the
+ * standard logging header.
+ */
+#define	LOGGING_FLASH_COMPACT_MAX_ENTRY_LENGTH		240
+
+/**
+ * The amount of encoded log data that will be read from flash at one time.  This must be large
+ * enough to hold the largest encoded entry.
+ */
+#define	LOGGING_FLASH_COMPACT_READ_LENGTH			256
+
+
+/**
+ * A log that persistently stores entries on flash using a compact encoding.  Entries are stored
+ * without per-entry headers.  Instead, each sector starts with a header that identifies the first
+ * entry in the sector, and entry IDs are implied by their position.  Debug log entries are further
+ * compressed by storing arguments as variable length integers.
+ *
+ * Entries are expanded to the standard logging format when the log is read, so the contents are
+ * the same as a log stored with logging_flash.  The log uses the same amount of flash as
+ * logging_flash, but the data stored on flash is not compatible between the two.
+ */
+struct logging_flash_compact {
+	struct logging base;						/**< The base logging instance. */
+	struct flash *flash;						/**< The flash where log entries are stored. */
+	uint32_t base_addr;							/**< The base address of the log data on flash. */
+	platform_mutex lock;						/**< Synchronization for log accesses. */
+	uint8_t entry_buffer[FLASH_SECTOR_SIZE];	/**< Encoded entries waiting to be flushed. */
+	uint8_t *next_write;						/**< The next write position in the entry buffer. */
+	int write_remain;							/**< Remaining space in the entry buffer. */
+	int buffer_size;							/**< Expanded size of the buffered entries. */
+	uint32_t buffer_id;							/**< ID of the first buffered entry. */
+	uint32_t next_entry_id;						/**< Next ID to assign to a log entry. */
+	uint32_t flash_used[LOGGING_FLASH_SECTORS];	/**< Encoded bytes stored in each sector. */
+	uint32_t log_size[LOGGING_FLASH_SECTORS];	/**< Expanded size of the entries in each sector. */
+	uint32_t next_addr;							/**< Next flash address to write to. */
+	int log_start;								/**< The sector that contains the first entries. */
+	uint8_t encoded[LOGGING_FLASH_COMPACT_READ_LENGTH];	/**< Buffer for encoded entry data. */
+	/** Buffer for an expanded entry. */
+	uint8_t entry[sizeof (struct logging_entry_header) + LOGGING_FLASH_COMPACT_MAX_ENTRY_LENGTH];
+};
+
+
+int logging_flash_compact_init (struct logging_flash_compact *logging, struct flash *flash,
+	uint32_t base_addr);
+void logging_flash_compact_release (struct logging_flash_compact *logging);
+
+
+#endif /* LOGGING_FLASH_COMPACT_H_ */
@@ -0,0 +1,19 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef LOGGING_LOGGING_H_
+#define LOGGING_LOGGING_H_
+
+#include "logging/debug_log.h"
+
+
+/**
+ * Logging messages for the logging infrastructure.
+ */
+enum {
+	LOGGING_LOGGING_REPEATED_ENTRY,		/**< Repeated copies of the previous entry were suppressed. */
+	LOGGING_LOGGING_RATE_LIMITED,		/**< Entries from a component were dropped by a rate limit. */
+};
+
+
+#endif /* LOGGING_LOGGING_H_ */
@@ -133,6 +133,17 @@ static int logging_memory_read_contents (struct logging *logging, uint32_t offse
 	return bytes_read;
 }
 
+static int logging_memory_get_max_entry_length (struct logging *logging)
+{
+	struct logging_memory *mem_log = (struct logging_memory*) logging;
+
+	if (mem_log == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	return mem_log->entry_size - sizeof (struct logging_entry_header);
+}
+
 /**
  * Initialize a log that store contents in volatile memory.
  *
@@ -174,6 +185,7 @@ int logging_memory_init (struct logging_memory *logging, size_t entry_count, siz
 	logging->base.clear = logging_memory_clear;
 	logging->base.get_size = logging_memory_get_size;
 	logging->base.read_contents = logging_memory_read_contents;
+	logging->base.get_max_entry_length = logging_memory_get_max_entry_length;
 
 	return 0;
 }
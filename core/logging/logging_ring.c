@@ -0,0 +1,335 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "logging_ring.h"
+
+
+/**
+ * Discard the oldest entry in the log.  The lock must be held by the caller.
+ *
+ * @param logging The log to update.
+ */
+static void logging_ring_discard_entry (struct logging_ring *logging)
+{
+	struct logging_entry_header header;
+
+	memcpy (&header, &logging->log_buffer[logging->log_start], sizeof (header));
+	logging->log_start += header.length;
+	logging->generation++;
+
+	if (logging->wrapped && (logging->log_start == logging->log_wrap)) {
+		logging->log_start = 0;
+		logging->wrapped = false;
+	}
+}
+
+/**
+ * Ensure there is contiguous space at the end of the log for a new entry, discarding the oldest
+ * entries as necessary.  The lock must be held by the caller.
+ *
+ * @param logging The log to update.
+ * @param length The amount of space needed.  This must not be larger than the log buffer.
+ */
+static void logging_ring_make_space (struct logging_ring *logging, size_t length)
+{
+	while (1) {
+		if (!logging->wrapped) {
+			if ((logging->log_size - logging->log_end) >= length) {
+				return;
+			}
+
+			if (logging->log_start == logging->log_end) {
+				logging->log_start = 0;
+				logging->log_end = 0;
+				continue;
+			}
+
+			/* Leave the remaining space at the end of the buffer unused and add the entry at the
+			 * start of the buffer. */
+			logging->log_wrap = logging->log_end;
+			logging->log_end = 0;
+			logging->wrapped = true;
+		}
+
+		if ((logging->log_start - logging->log_end) >= length) {
+			return;
+		}
+
+		logging_ring_discard_entry (logging);
+	}
+}
+
+/**
+ * Get the regions of memory that contain log data.  The lock must be held by the caller.
+ *
+ * @param logging The log to query.
+ * @param offset Offset within the log for the first span.
+ * @param spans Output for the log data spans.
+ *
+ * @return The number of spans of log data.
+ */
+static int logging_ring_build_spans (struct logging_ring *logging, uint32_t offset,
+	struct logging_ring_span *spans)
+{
+	size_t first_end = (logging->wrapped) ? logging->log_wrap : logging->log_end;
+	size_t first_len = first_end - logging->log_start;
+	int count = 0;
+
+	if (offset < first_len) {
+		spans[count].data = &logging->log_buffer[logging->log_start + offset];
+		spans[count].length = first_len - offset;
+		count++;
+		offset = 0;
+	}
+	else {
+		offset -= first_len;
+	}
+
+	if (logging->wrapped && (offset < logging->log_end)) {
+		spans[count].data = &logging->log_buffer[offset];
+		spans[count].length = logging->log_end - offset;
+		count++;
+	}
+
+	return count;
+}
+
+static int logging_ring_create_entry (struct logging *logging, uint8_t *entry, size_t length)
+{
+	struct logging_ring *ring = (struct logging_ring*) logging;
+	struct logging_entry_header header;
+	size_t entry_size = length + sizeof (header);
+
+	if ((ring == NULL) || (entry == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	if ((length == 0) || (entry_size > ring->log_size) || (entry_size > UINT16_MAX)) {
+		return LOGGING_BAD_ENTRY_LENGTH;
+	}
+
+	platform_mutex_lock (&ring->lock);
+
+	logging_ring_make_space (ring, entry_size);
+
+	header.log_magic = LOGGING_MAGIC_START;
+	header.length = entry_size;
+	header.entry_id = ring->next_entry_id++;
+
+	memcpy (&ring->log_buffer[ring->log_end], (uint8_t*) &header, sizeof (header));
+	memcpy (&ring->log_buffer[ring->log_end + sizeof (header)], entry, length);
+	ring->log_end += entry_size;
+
+	platform_mutex_unlock (&ring->lock);
+
+	return 0;
+}
+
+static int logging_ring_flush (struct logging *logging)
+{
+	return 0;
+}
+
+static int logging_ring_clear (struct logging *logging)
+{
+	struct logging_ring *ring = (struct logging_ring*) logging;
+
+	if (ring == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&ring->lock);
+
+	ring->log_start = 0;
+	ring->log_end = 0;
+	ring->wrapped = false;
+	ring->next_entry_id = 0;
+	ring->generation++;
+
+	platform_mutex_unlock (&ring->lock);
+
+	return 0;
+}
+
+static int logging_ring_get_size (struct logging *logging)
+{
+	struct logging_ring *ring = (struct logging_ring*) logging;
+	int log_size;
+
+	if (ring == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&ring->lock);
+
+	if (ring->wrapped) {
+		log_size = (ring->log_wrap - ring->log_start) + ring->log_end;
+	}
+	else {
+		log_size = ring->log_end - ring->log_start;
+	}
+
+	platform_mutex_unlock (&ring->lock);
+
+	return log_size;
+}
+
+static int logging_ring_read_contents (struct logging *logging, uint32_t offset,
+	uint8_t *contents, size_t length)
+{
+	struct logging_ring *ring = (struct logging_ring*) logging;
+	struct logging_ring_span spans[LOGGING_RING_MAX_SPANS];
+	int count;
+	int i;
+	size_t copy_len;
+	int bytes_read = 0;
+
+	if ((ring == NULL) || (contents == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&ring->lock);
+
+	count = logging_ring_build_spans (ring, offset, spans);
+	for (i = 0; (i < count) && (length != 0); i++) {
+		copy_len = (length < spans[i].length) ? length : spans[i].length;
+
+		memcpy (&contents[bytes_read], spans[i].data, copy_len);
+		bytes_read += copy_len;
+		length -= copy_len;
+	}
+
+	platform_mutex_unlock (&ring->lock);
+
+	return bytes_read;
+}
+
+static int logging_ring_get_max_entry_length (struct logging *logging)
+{
+	struct logging_ring *ring = (struct logging_ring*) logging;
+	size_t entry_size;
+
+	if (ring == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	entry_size = (ring->log_size > UINT16_MAX) ? UINT16_MAX : ring->log_size;
+
+	return entry_size - sizeof (struct logging_entry_header);
+}
+
+/**
+ * Initialize a log that stores variable length entries in volatile memory.
+ *
+ * @param logging The log to initialize.
+ * @param log_size The amount of memory to use for log entries, including the standard logging
+ * overhead for each entry.  This also determines the maximum size of a single entry.
+ *
+ * @return 0 if the log was successfully initialized or an error code.
+ */
+int logging_ring_init (struct logging_ring *logging, size_t log_size)
+{
+	int status;
+
+	if ((logging == NULL) || (log_size <= sizeof (struct logging_entry_header))) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	memset (logging, 0, sizeof (struct logging_ring));
+
+	logging->log_buffer = platform_malloc (log_size);
+	if (logging->log_buffer == NULL) {
+		return LOGGING_NO_MEMORY;
+	}
+
+	status = platform_mutex_init (&logging->lock);
+	if (status != 0) {
+		platform_free (logging->log_buffer);
+		return status;
+	}
+
+	logging->log_size = log_size;
+
+	logging->base.create_entry = logging_ring_create_entry;
+	logging->base.flush = logging_ring_flush;
+	logging->base.clear = logging_ring_clear;
+	logging->base.get_size = logging_ring_get_size;
+	logging->base.read_contents = logging_ring_read_contents;
+	logging->base.get_max_entry_length = logging_ring_get_max_entry_length;
+
+	return 0;
+}
+
+/**
+ * Release the resources used by a ring log.
+ *
+ * @param logging The log to release.
+ */
+void logging_ring_release (struct logging_ring *logging)
+{
+	if (logging) {
+		platform_mutex_free (&logging->lock);
+		platform_free (logging->log_buffer);
+	}
+}
+
+/**
+ * Get direct access to the log contents without copying the data.
+ *
+ * The spans remain valid until log data is discarded, either because older entries were replaced
+ * by new ones or because the log was cleared.  Since this can happen at any time, the caller must
+ * check that the generation is still current after it has finished accessing the data.  If the
+ * generation has changed, any data accessed from the spans may have been overwritten.
+ *
+ * @param logging The log to query.
+ * @param offset Offset within the log for the first span.
+ * @param spans Output for the log data spans.  The log data is the concatenation of the spans.
+ * @param generation Output for the log generation that corresponds to the spans.
+ *
+ * @return The number of spans of log data or an error code.  Use ROT_IS_ERROR to check the return
+ * value.
+ */
+int logging_ring_get_spans (struct logging_ring *logging, uint32_t offset,
+	struct logging_ring_span spans[LOGGING_RING_MAX_SPANS], uint32_t *generation)
+{
+	int count;
+
+	if ((logging == NULL) || (spans == NULL) || (generation == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&logging->lock);
+
+	count = logging_ring_build_spans (logging, offset, spans);
+	*generation = logging->generation;
+
+	platform_mutex_unlock (&logging->lock);
+
+	return count;
+}
+
+/**
+ * Check if log data spans are still valid.
+ *
+ * @param logging The log to query.
+ * @param generation The log generation returned with the spans.
+ *
+ * @return true if no log data has been discarded since the spans were retrieved.
+ */
+bool logging_ring_is_generation_current (struct logging_ring *logging, uint32_t generation)
+{
+	bool current;
+
+	if (logging == NULL) {
+		return false;
+	}
+
+	platform_mutex_lock (&logging->lock);
+	current = (generation == logging->generation);
+	platform_mutex_unlock (&logging->lock);
+
+	return current;
+}
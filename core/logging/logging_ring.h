@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef LOGGING_RING_H_
+#define LOGGING_RING_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "logging.h"
+#include "platform.h"
+
+
+/**
+ * The maximum number of spans needed to describe the log contents.
+ */
+#define	LOGGING_RING_MAX_SPANS		2
+
+
+/**
+ * A contiguous region of log data in memory.
+ */
+struct logging_ring_span {
+	const uint8_t *data;			/**< The log data. */
+	size_t length;					/**< The length of the log data. */
+};
+
+/**
+ * A log that stores variable length entries in a ring buffer in volatile memory.  When there is not
+ * enough space for a new entry, the oldest entries are discarded.
+ *
+ * Entries are never split across the end of the buffer, so each entry is always contiguous in
+ * memory.  This allows log data to be accessed directly without copying it.
+ */
+struct logging_ring {
+	struct logging base;			/**< The base logging instance. */
+	uint8_t *log_buffer;			/**< The buffer used for log entries. */
+	size_t log_size;				/**< The size of the log buffer. */
+	platform_mutex lock;			/**< Synchronization for log accesses. */
+	size_t log_start;				/**< The first entry of the log. */
+	size_t log_end;					/**< The end of the log where new entries will be added. */
+	size_t log_wrap;				/**< The end of the log data before wrapping to the start. */
+	bool wrapped;					/**< Flag indicating log data wraps to the start of the buffer. */
+	uint32_t generation;			/**< Counter for changes that discard log data. */
+	uint32_t next_entry_id;			/**< Next ID to assign to a log entry. */
+};
+
+
+int logging_ring_init (struct logging_ring *logging, size_t log_size);
+void logging_ring_release (struct logging_ring *logging);
+
+int logging_ring_get_spans (struct logging_ring *logging, uint32_t offset,
+	struct logging_ring_span spans[LOGGING_RING_MAX_SPANS], uint32_t *generation);
+bool logging_ring_is_generation_current (struct logging_ring *logging, uint32_t generation);
+
+
+#endif /* LOGGING_RING_H_ */
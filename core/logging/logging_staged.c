@@ -0,0 +1,427 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include "logging_staged.h"
+
+
+/**
+ * Get the storage for a staged entry.
+ *
+ * @param logging The staged log.
+ * @param pos Position of the entry in the ring.
+ *
+ * @return The entry slot.  The slot starts with the length of the entry.
+ */
+static uint8_t* logging_staged_get_slot (struct logging_staged *logging, size_t pos)
+{
+	return &logging->ring[(pos & (logging->slot_count - 1)) * logging->slot_size];
+}
+
+/**
+ * Get the sequence number for a staged entry.
+ *
+ * @param logging The staged log.
+ * @param pos Position of the entry in the ring.
+ *
+ * @return The sequence number for the entry slot.
+ */
+static atomic_size_t* logging_staged_get_sequence (struct logging_staged *logging, size_t pos)
+{
+	return &logging->sequence[pos & (logging->slot_count - 1)];
+}
+
+static int logging_staged_create_entry (struct logging *logging, uint8_t *entry, size_t length)
+{
+	struct logging_staged *staged = (struct logging_staged*) logging;
+	uint8_t *slot;
+	uint16_t entry_len = length;
+	size_t pos;
+	size_t head;
+
+	if ((staged == NULL) || (entry == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	if ((length == 0) || (length > staged->entry_length)) {
+		return LOGGING_BAD_ENTRY_LENGTH;
+	}
+
+	/* Claim the next free slot.  A slot is free for a position when its sequence number matches
+	 * the position.  If another context claims the position first, try again with the new tail. */
+	pos = atomic_load_explicit (&staged->tail, memory_order_relaxed);
+	do {
+		head = atomic_load_explicit (&staged->head, memory_order_acquire);
+		if ((pos - head) >= staged->entry_count) {
+			atomic_fetch_add_explicit (&staged->dropped, 1, memory_order_relaxed);
+			return LOGGING_STAGING_FULL;
+		}
+
+		if (atomic_load_explicit (logging_staged_get_sequence (staged, pos),
+			memory_order_acquire) != pos) {
+			pos = atomic_load_explicit (&staged->tail, memory_order_relaxed);
+			continue;
+		}
+	} while (!atomic_compare_exchange_weak_explicit (&staged->tail, &pos, pos + 1,
+		memory_order_relaxed, memory_order_relaxed));
+
+	slot = logging_staged_get_slot (staged, pos);
+	memcpy (slot, &entry_len, sizeof (entry_len));
+	memcpy (&slot[sizeof (entry_len)], entry, length);
+
+	/* Publish the entry so it can be written to the log. */
+	atomic_store_explicit (logging_staged_get_sequence (staged, pos), pos + 1,
+		memory_order_release);
+
+	/* Only request a flush when the watermark is first reached.  Subsequent entries don't need to
+	 * notify again since a flush is already pending. */
+	if (staged->flush_request && (((pos + 1) - head) == staged->watermark)) {
+		staged->flush_request (staged->context);
+	}
+
+	return 0;
+}
+
+/**
+ * Determine if an error from the log indicates that an entry will never be accepted.  Retrying
+ * these entries would block all later entries, so they are discarded instead.
+ *
+ * @param status The error reported by the log.
+ *
+ * @return true if the entry should be discarded.
+ */
+static bool logging_staged_is_entry_rejected (int status)
+{
+	switch (status) {
+		case LOGGING_INVALID_ARGUMENT:
+		case LOGGING_BAD_ENTRY_LENGTH:
+		case LOGGING_UNSUPPORTED_SEVERITY:
+		case LOGGING_ENTRY_RATE_LIMITED:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * Write all staged entries to the log.  The flush lock must be held by the caller.
+ *
+ * New entries can continue to be staged while the log is being updated since the slots being
+ * written are not released until they have been added to the log.  Writing stops at the first
+ * slot that has been claimed but not yet filled.  That entry will be written on the next flush.
+ *
+ * Entries the log will never accept are discarded and counted.  For any other error, the entry
+ * remains staged so it can be written on the next flush.
+ *
+ * @param staged The staged log to write.
+ * @param discard Flag to discard the staged entries without writing them to the log.
+ *
+ * @return 0 if all staged entries were added to the log or an error code.
+ */
+static int logging_staged_write_entries (struct logging_staged *staged, bool discard)
+{
+	uint8_t *slot;
+	uint16_t entry_len;
+	size_t pos;
+	int status;
+
+	pos = atomic_load_explicit (&staged->head, memory_order_relaxed);
+
+	while (atomic_load_explicit (logging_staged_get_sequence (staged, pos),
+		memory_order_acquire) == (pos + 1)) {
+		if (!discard) {
+			slot = logging_staged_get_slot (staged, pos);
+
+			memcpy (&entry_len, slot, sizeof (entry_len));
+			status = staged->log->create_entry (staged->log, &slot[sizeof (entry_len)],
+				entry_len);
+			if (status != 0) {
+				if (!logging_staged_is_entry_rejected (status)) {
+					return status;
+				}
+
+				atomic_fetch_add_explicit (&staged->rejected, 1, memory_order_relaxed);
+			}
+		}
+
+		/* Release the slot for use on the next pass around the ring. */
+		atomic_store_explicit (logging_staged_get_sequence (staged, pos),
+			pos + staged->slot_count, memory_order_release);
+
+		pos++;
+		atomic_store_explicit (&staged->head, pos, memory_order_release);
+	}
+
+	return 0;
+}
+
+static int logging_staged_flush (struct logging *logging)
+{
+	struct logging_staged *staged = (struct logging_staged*) logging;
+	int status;
+
+	if (staged == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&staged->flush_lock);
+
+	status = logging_staged_write_entries (staged, false);
+	if (status == 0) {
+		status = staged->log->flush (staged->log);
+	}
+
+	platform_mutex_unlock (&staged->flush_lock);
+
+	return status;
+}
+
+static int logging_staged_clear (struct logging *logging)
+{
+	struct logging_staged *staged = (struct logging_staged*) logging;
+	int status;
+
+	if (staged == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&staged->flush_lock);
+
+	logging_staged_write_entries (staged, true);
+	atomic_store_explicit (&staged->dropped, 0, memory_order_relaxed);
+	atomic_store_explicit (&staged->rejected, 0, memory_order_relaxed);
+
+	status = staged->log->clear (staged->log);
+
+	platform_mutex_unlock (&staged->flush_lock);
+
+	return status;
+}
+
+static int logging_staged_get_size (struct logging *logging)
+{
+	struct logging_staged *staged = (struct logging_staged*) logging;
+
+	if (staged == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	return staged->log->get_size (staged->log);
+}
+
+static int logging_staged_read_contents (struct logging *logging, uint32_t offset,
+	uint8_t *contents, size_t length)
+{
+	struct logging_staged *staged = (struct logging_staged*) logging;
+
+	if ((staged == NULL) || (contents == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	return staged->log->read_contents (staged->log, offset, contents, length);
+}
+
+static int logging_staged_get_max_entry_length (struct logging *logging)
+{
+	struct logging_staged *staged = (struct logging_staged*) logging;
+
+	if (staged == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	return staged->entry_length;
+}
+
+/**
+ * Initialize a log that stages entries in memory before writing them to another log.
+ *
+ * Entries are only written to the other log when the staged log is flushed.  Until then, they will
+ * not be reported in the log size or contents.  If staging is full when a new entry is created, the
+ * new entry will be dropped.
+ *
+ * @param logging The log to initialize.
+ * @param log The log that will store the staged entries.  Entries should not be added to this log
+ * directly.
+ * @param entry_count The maximum number of entries that can be staged.
+ * @param entry_length The maximum length of a single entry.  This does not include the length of
+ * standard logging overhead.  This cannot be longer than the entries supported by the log.
+ *
+ * @return 0 if the log was successfully initialized or an error code.
+ */
+int logging_staged_init (struct logging_staged *logging, struct logging *log, size_t entry_count,
+	size_t entry_length)
+{
+	int max_length;
+	size_t i;
+	int status;
+
+	if ((logging == NULL) || (log == NULL) || (entry_count == 0) || (entry_length == 0) ||
+		(entry_length > UINT16_MAX) || (entry_count > ((SIZE_MAX / 2) + 1))) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	max_length = log->get_max_entry_length (log);
+	if (ROT_IS_ERROR (max_length)) {
+		return max_length;
+	}
+
+	if (entry_length > (size_t) max_length) {
+		return LOGGING_BAD_ENTRY_LENGTH;
+	}
+
+	memset (logging, 0, sizeof (struct logging_staged));
+
+	/* Slot positions are mapped to the ring with a mask so they stay consistent when the position
+	 * counters wrap. */
+	logging->slot_count = 1;
+	while (logging->slot_count < entry_count) {
+		logging->slot_count <<= 1;
+	}
+
+	logging->slot_size = sizeof (uint16_t) + entry_length;
+	logging->ring = platform_malloc (logging->slot_size * logging->slot_count);
+	if (logging->ring == NULL) {
+		return LOGGING_NO_MEMORY;
+	}
+
+	logging->sequence = platform_malloc (sizeof (atomic_size_t) * logging->slot_count);
+	if (logging->sequence == NULL) {
+		status = LOGGING_NO_MEMORY;
+		goto error_sequence;
+	}
+
+	status = platform_mutex_init (&logging->flush_lock);
+	if (status != 0) {
+		goto error_flush_lock;
+	}
+
+	for (i = 0; i < logging->slot_count; i++) {
+		atomic_init (&logging->sequence[i], i);
+	}
+
+	atomic_init (&logging->head, 0);
+	atomic_init (&logging->tail, 0);
+	atomic_init (&logging->dropped, 0);
+	atomic_init (&logging->rejected, 0);
+
+	logging->log = log;
+	logging->entry_length = entry_length;
+	logging->entry_count = entry_count;
+
+	logging->base.create_entry = logging_staged_create_entry;
+	logging->base.flush = logging_staged_flush;
+	logging->base.clear = logging_staged_clear;
+	logging->base.get_size = logging_staged_get_size;
+	logging->base.read_contents = logging_staged_read_contents;
+	logging->base.get_max_entry_length = logging_staged_get_max_entry_length;
+
+	return 0;
+
+error_flush_lock:
+	platform_free (logging->sequence);
+error_sequence:
+	platform_free (logging->ring);
+	return status;
+}
+
+/**
+ * Release the resources used by a staged log.  Any entries that have not been flushed will be lost.
+ *
+ * @param logging The log to release.
+ */
+void logging_staged_release (struct logging_staged *logging)
+{
+	if (logging) {
+		platform_mutex_free (&logging->flush_lock);
+		platform_free (logging->sequence);
+		platform_free (logging->ring);
+	}
+}
+
+/**
+ * Register a handler to be notified when the number of staged entries reaches a watermark.  This
+ * allows the task that flushes the log to sleep until there is enough data to be worth writing,
+ * rather than polling the log for new entries.
+ *
+ * The handler is read without synchronization when entries are created, so it must be configured
+ * before any other context can create entries in the log.
+ *
+ * @param logging The staged log to configure.
+ * @param watermark The number of staged entries that will trigger the flush request.  This must
+ * not be more than the number of entries that can be staged.  Set to 0 to disable flush requests.
+ * @param flush_request The handler to call when the watermark is reached.  Set to null to disable
+ * flush requests.
+ * @param context Context to pass to the flush request handler.
+ *
+ * @return 0 if the watermark was configured or an error code.
+ */
+int logging_staged_set_flush_watermark (struct logging_staged *logging, size_t watermark,
+	void (*flush_request) (void*), void *context)
+{
+	if ((logging == NULL) || (watermark > logging->entry_count)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	logging->watermark = watermark;
+	logging->flush_request = (watermark != 0) ? flush_request : NULL;
+	logging->context = context;
+
+	return 0;
+}
+
+/**
+ * Get the number of entries that have been dropped because there was no space to stage them.
+ *
+ * @param logging The staged log to query.
+ *
+ * @return The number of dropped entries.
+ */
+uint32_t logging_staged_get_dropped_count (struct logging_staged *logging)
+{
+	if (logging == NULL) {
+		return 0;
+	}
+
+	return atomic_load_explicit (&logging->dropped, memory_order_relaxed);
+}
+
+/**
+ * Get the number of staged entries that were discarded because the log would not accept them.
+ *
+ * @param logging The staged log to query.
+ *
+ * @return The number of rejected entries.
+ */
+uint32_t logging_staged_get_rejected_count (struct logging_staged *logging)
+{
+	if (logging == NULL) {
+		return 0;
+	}
+
+	return atomic_load_explicit (&logging->rejected, memory_order_relaxed);
+}
+
+/**
+ * Get the number of entries waiting to be written to the log.  This includes entries that are
+ * still being staged.
+ *
+ * @param logging The staged log to query.
+ *
+ * @return The number of staged entries.
+ */
+size_t logging_staged_get_staged_count (struct logging_staged *logging)
+{
+	size_t head;
+
+	if (logging == NULL) {
+		return 0;
+	}
+
+	head = atomic_load_explicit (&logging->head, memory_order_acquire);
+
+	return atomic_load_explicit (&logging->tail, memory_order_acquire) - head;
+}
@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef LOGGING_STAGED_H_
+#define LOGGING_STAGED_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "logging.h"
+#include "platform.h"
+
+
+/**
+ * A log that stages new entries in memory and only writes them to another log when flushed.
+ * Creating an entry never blocks on the storage used by the other log, so entries can be created
+ * from time-critical contexts, including interrupt handlers.  The staged entries should be flushed
+ * from a background task.
+ *
+ * Entries are staged in a lock-free ring.  Each slot has a sequence number that indicates if the
+ * slot is free, claimed by a producer, or holds an entry ready to be written.  Any number of
+ * contexts can create entries, but only one context at a time can write the entries to the log.
+ */
+struct logging_staged {
+	struct logging base;			/**< The base logging instance. */
+	struct logging *log;			/**< The log that will store the staged entries. */
+	uint8_t *ring;					/**< Storage for entries that have not been flushed. */
+	atomic_size_t *sequence;		/**< Sequence number for each slot in the ring. */
+	size_t slot_size;				/**< The amount of storage used by a single staged entry. */
+	size_t slot_count;				/**< The number of slots in the ring.  Always a power of 2. */
+	size_t entry_length;			/**< Maximum length of a single entry. */
+	size_t entry_count;				/**< Maximum number of entries that can be staged. */
+	atomic_size_t head;				/**< Position of the oldest staged entry. */
+	atomic_size_t tail;				/**< Position for the next staged entry. */
+	atomic_uint_least32_t dropped;	/**< The number of entries dropped because staging was full. */
+	atomic_uint_least32_t rejected;	/**< The number of staged entries rejected by the log. */
+	size_t watermark;				/**< Number of staged entries that triggers a flush request. */
+	void *context;					/**< Context to pass to the flush request handler. */
+	platform_mutex flush_lock;		/**< Synchronization for writing staged entries to the log. */
+
+	/**
+	 * Optional handler to notify the task responsible for flushing the log that the staged entries
+	 * have reached the watermark.  This is called from the context creating the log entry, which
+	 * may be an interrupt handler, so it must not block.
+	 *
+	 * @param context The context registered with the handler.
+	 */
+	void (*flush_request) (void *context);
+};
+
+
+int logging_staged_init (struct logging_staged *logging, struct logging *log, size_t entry_count,
+	size_t entry_length);
+void logging_staged_release (struct logging_staged *logging);
+
+int logging_staged_set_flush_watermark (struct logging_staged *logging, size_t watermark,
+	void (*flush_request) (void*), void *context);
+
+uint32_t logging_staged_get_dropped_count (struct logging_staged *logging);
+uint32_t logging_staged_get_rejected_count (struct logging_staged *logging);
+size_t logging_staged_get_staged_count (struct logging_staged *logging);
+
+
+#endif /* LOGGING_STAGED_H_ */
@@ -0,0 +1,289 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "trace_buffer.h"
+#include "logging.h"
+
+
+struct trace_buffer *trace_buffers[TRACE_BUFFER_MAX_CORES];
+
+
+/**
+ * Initialize a buffer for trace records.
+ *
+ * @param trace The trace buffer to initialize.
+ * @param records Storage for the trace records.  This must remain valid for the lifetime of the
+ * trace buffer.
+ * @param count The number of records that can be stored.
+ * @param get_timestamp The platform source for record timestamps.  If this is null, timestamps
+ * will be the number of milliseconds since the buffer was initialized.
+ *
+ * @return 0 if the trace buffer was successfully initialized or an error code.
+ */
+int trace_buffer_init (struct trace_buffer *trace, struct trace_record *records, size_t count,
+	trace_buffer_timestamp get_timestamp)
+{
+	if ((trace == NULL) || (records == NULL) || (count == 0) || (count > UINT32_MAX)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	memset (trace, 0, sizeof (struct trace_buffer));
+
+	trace->records = records;
+	trace->count = count;
+	trace->get_timestamp = get_timestamp;
+	platform_init_current_tick (&trace->start);
+
+	atomic_init (&trace->head, 0);
+	atomic_init (&trace->full, false);
+	atomic_init (&trace->enabled, true);
+
+	return 0;
+}
+
+/**
+ * Release the resources used by a trace buffer.  The buffer must not be registered for any core.
+ *
+ * @param trace The trace buffer to release.
+ */
+void trace_buffer_release (struct trace_buffer *trace)
+{
+
+}
+
+/**
+ * Get the timestamp for a new trace record.
+ *
+ * @param trace The trace buffer the record will be added to.
+ *
+ * @return The timestamp for the record.
+ */
+static uint32_t trace_buffer_get_timestamp (struct trace_buffer *trace)
+{
+	platform_clock now;
+
+	if (trace->get_timestamp) {
+		return trace->get_timestamp ();
+	}
+
+	platform_init_current_tick (&now);
+	return platform_get_duration (&trace->start, &now);
+}
+
+/**
+ * Add a record to a trace buffer.  If the buffer is full, the oldest record will be overwritten.
+ *
+ * @param trace The trace buffer to update.
+ * @param event Identifier for the traced event.
+ * @param phase The type of trace record.
+ * @param arg1 Event specific argument.
+ * @param arg2 Event specific argument.
+ */
+void trace_buffer_add (struct trace_buffer *trace, uint16_t event, uint8_t phase, uint32_t arg1,
+	uint32_t arg2)
+{
+	struct trace_record *record;
+	uint_least32_t head;
+	uint_least32_t next;
+	uint32_t timestamp;
+
+	if ((trace == NULL) || !atomic_load_explicit (&trace->enabled, memory_order_relaxed)) {
+		return;
+	}
+
+	/* The timestamp is taken between reading the head and claiming the record.  If another record
+	 * is claimed in between, the claim fails and a new timestamp is taken, so records are always
+	 * stored in timestamp order. */
+	head = atomic_load_explicit (&trace->head, memory_order_relaxed);
+	do {
+		timestamp = trace_buffer_get_timestamp (trace);
+
+		next = head + 1;
+		if (next == trace->count) {
+			next = 0;
+		}
+	} while (!atomic_compare_exchange_weak_explicit (&trace->head, &head, next,
+		memory_order_acq_rel, memory_order_relaxed));
+
+	if (next == 0) {
+		atomic_store_explicit (&trace->full, true, memory_order_release);
+	}
+
+	record = &trace->records[head];
+	record->timestamp = timestamp;
+	record->event = event;
+	record->phase = phase;
+	record->core = trace->core;
+	record->arg1 = arg1;
+	record->arg2 = arg2;
+}
+
+/**
+ * Get the number of records stored in a trace buffer.
+ *
+ * @param trace The trace buffer to query.
+ * @param head Output for the position of the next record that will be written.
+ *
+ * @return The number of stored records.
+ */
+static uint32_t trace_buffer_get_stored (struct trace_buffer *trace, uint32_t *head)
+{
+	*head = atomic_load_explicit (&trace->head, memory_order_acquire);
+
+	if (atomic_load_explicit (&trace->full, memory_order_acquire)) {
+		return trace->count;
+	}
+
+	return *head;
+}
+
+/**
+ * Get the number of records currently stored in a trace buffer.
+ *
+ * @param trace The trace buffer to query.
+ *
+ * @return The number of stored records.
+ */
+uint32_t trace_buffer_get_count (struct trace_buffer *trace)
+{
+	uint32_t head;
+
+	if (trace == NULL) {
+		return 0;
+	}
+
+	return trace_buffer_get_stored (trace, &head);
+}
+
+/**
+ * Read records from a trace buffer.  Records are returned in the order they were added.
+ *
+ * @param trace The trace buffer to read.
+ * @param offset The number of records to skip, starting from the oldest record in the buffer.
+ * @param records Output for the trace records.
+ * @param count The maximum number of records to read.
+ *
+ * @return The number of records read or an error code.  Use ROT_IS_ERROR to check the return
+ * value.
+ */
+int trace_buffer_read (struct trace_buffer *trace, uint32_t offset, struct trace_record *records,
+	size_t count)
+{
+	uint32_t stored;
+	uint32_t head;
+	uint32_t index;
+	size_t i;
+
+	if ((trace == NULL) || (records == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	stored = trace_buffer_get_stored (trace, &head);
+	if (offset >= stored) {
+		return 0;
+	}
+
+	if ((stored - offset) < count) {
+		count = stored - offset;
+	}
+
+	/* The oldest record is the one that will be overwritten next when the buffer is full. */
+	index = (stored < trace->count) ? offset : head + offset;
+	if (index >= trace->count) {
+		index -= trace->count;
+	}
+
+	for (i = 0; i < count; i++) {
+		records[i] = trace->records[index++];
+		if (index == trace->count) {
+			index = 0;
+		}
+	}
+
+	return count;
+}
+
+/**
+ * Start or stop adding new records to a trace buffer.  Stopping the trace allows the buffer to be
+ * read without new records replacing the data.
+ *
+ * @param trace The trace buffer to update.
+ * @param enabled true to store new records or false to discard them.
+ */
+void trace_buffer_set_enabled (struct trace_buffer *trace, bool enabled)
+{
+	if (trace) {
+		atomic_store_explicit (&trace->enabled, enabled, memory_order_relaxed);
+	}
+}
+
+/**
+ * Remove all records from a trace buffer.  Tracing should be disabled while the buffer is cleared.
+ *
+ * @param trace The trace buffer to clear.
+ */
+void trace_buffer_clear (struct trace_buffer *trace)
+{
+	if (trace) {
+		atomic_store_explicit (&trace->full, false, memory_order_relaxed);
+		atomic_store_explicit (&trace->head, 0, memory_order_release);
+	}
+}
+
+/**
+ * Register a trace buffer to store the events generated on a core.
+ *
+ * @param trace The trace buffer to register.  Null to stop tracing events on the core.
+ * @param core The core that will use the trace buffer.
+ *
+ * @return 0 if the trace buffer was registered or an error code.
+ */
+int trace_buffer_register (struct trace_buffer *trace, int core)
+{
+	if ((core < 0) || (core >= TRACE_BUFFER_MAX_CORES)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	if (trace) {
+		trace->core = core;
+	}
+
+	trace_buffers[core] = trace;
+	return 0;
+}
+
+/**
+ * Get the trace buffer registered for a core.
+ *
+ * @param core The core to query.
+ *
+ * @return The trace buffer for the core or null if there is no trace buffer.
+ */
+struct trace_buffer* trace_buffer_get_core (int core)
+{
+	if ((core < 0) || (core >= TRACE_BUFFER_MAX_CORES)) {
+		return NULL;
+	}
+
+	return trace_buffers[core];
+}
+
+/**
+ * Add a record to the trace buffer for the current core.  Nothing is recorded if no trace buffer
+ * has been registered for the core.
+ *
+ * This should not be called directly.  Use the TRACE_BEGIN, TRACE_END, or TRACE_INSTANT macros so
+ * instrumentation can be removed at build time.
+ *
+ * @param event Identifier for the traced event.
+ * @param phase The type of trace record.
+ * @param arg1 Event specific argument.
+ * @param arg2 Event specific argument.
+ */
+void trace_buffer_event (uint16_t event, uint8_t phase, uint32_t arg1, uint32_t arg2)
+{
+	trace_buffer_add (trace_buffer_get_core (TRACE_BUFFER_CORE_ID ()), event, phase, arg1, arg2);
+}
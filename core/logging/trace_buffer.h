@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef TRACE_BUFFER_H_
+#define TRACE_BUFFER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "platform.h"
+
+
+/**
+ * The maximum number of cores that can have a trace buffer registered.
+ */
+#ifndef TRACE_BUFFER_MAX_CORES
+#define	TRACE_BUFFER_MAX_CORES				1
+#endif
+
+/**
+ * Determine the core that is generating a trace event.  Platforms with more than one core must
+ * define this to return the ID of the current core.
+ */
+#ifndef TRACE_BUFFER_CORE_ID
+#define	TRACE_BUFFER_CORE_ID()				0
+#endif
+
+
+/**
+ * Identifiers for traced events.  The arguments for the begin record of each event are listed in
+ * parentheses.  The end record for an operation reports the status of the operation in arg2.
+ */
+enum {
+	TRACE_EVENT_FLASH_XFER = 0,					/**< SPI flash transfer (command, length). */
+	TRACE_EVENT_HASH,							/**< Hash calculation (algorithm). */
+	TRACE_EVENT_RSA_DECRYPT,					/**< RSA private key decryption (data length). */
+	TRACE_EVENT_RSA_VERIFY,						/**< RSA signature verification (signature length). */
+	TRACE_EVENT_ECC_SIGN,						/**< ECDSA signature generation (digest length). */
+	TRACE_EVENT_ECC_VERIFY,						/**< ECDSA signature verification (digest length). */
+	TRACE_EVENT_MCTP_RX,						/**< MCTP packet processing (channel ID, length). */
+	TRACE_EVENT_MCTP_TX,						/**< MCTP packet transmission (channel ID, length). */
+	TRACE_EVENT_CMD_DISPATCH,					/**< Command processing (command ID). */
+	TRACE_EVENT_HOST_POWER_ON_RESET,			/**< Host power-on reset processing. */
+	TRACE_EVENT_HOST_SOFT_RESET,				/**< Host soft reset processing. */
+	TRACE_EVENT_HOST_VALIDATE_FLASH,			/**< Host flash validation (pending PFM flag). */
+	TRACE_EVENT_PLATFORM = 0x8000,				/**< First ID available for platform-specific events. */
+};
+
+/**
+ * The type of each trace record.
+ */
+enum {
+	TRACE_PHASE_BEGIN = 0,						/**< The start of a traced operation. */
+	TRACE_PHASE_END,							/**< The end of a traced operation. */
+	TRACE_PHASE_INSTANT,						/**< An event with no duration. */
+};
+
+
+#pragma pack(push, 1)
+/**
+ * A single record in a trace buffer.
+ */
+struct trace_record {
+	uint32_t timestamp;								/**< Time the event was recorded. */
+	uint16_t event;									/**< Identifier for the traced event. */
+	uint8_t phase;									/**< The type of trace record. */
+	uint8_t core;									/**< The core that recorded the event. */
+	uint32_t arg1;									/**< Event specific argument. */
+	uint32_t arg2;									/**< Event specific argument. */
+};
+#pragma pack(pop)
+
+/**
+ * Get the current time for a trace record.  If events are traced from interrupt handlers, this must
+ * be safe to call from an interrupt.
+ *
+ * @return The current timestamp.  The resolution is determined by the platform.
+ */
+typedef uint32_t (*trace_buffer_timestamp) (void);
+
+/**
+ * A fixed size ring of trace records for a single core.  When the buffer is full, the oldest
+ * records are overwritten.
+ *
+ * Records are added without locking, so events can be traced from any task or interrupt handler
+ * on the core.  Reading the buffer while records are being added can return a partially written
+ * record, so tracing should be disabled before reading.
+ */
+struct trace_buffer {
+	struct trace_record *records;					/**< Storage for the trace records. */
+	uint32_t count;									/**< The number of records that can be stored. */
+	atomic_uint_least32_t head;						/**< The next record to write. */
+	atomic_bool full;								/**< Flag indicating all records have been written. */
+	uint8_t core;									/**< The core that owns the buffer. */
+	atomic_bool enabled;							/**< Flag indicating new records will be stored. */
+	trace_buffer_timestamp get_timestamp;			/**< Platform source for record timestamps. */
+	platform_clock start;							/**< Reference time for millisecond timestamps. */
+};
+
+
+int trace_buffer_init (struct trace_buffer *trace, struct trace_record *records, size_t count,
+	trace_buffer_timestamp get_timestamp);
+void trace_buffer_release (struct trace_buffer *trace);
+
+void trace_buffer_add (struct trace_buffer *trace, uint16_t event, uint8_t phase, uint32_t arg1,
+	uint32_t arg2);
+int trace_buffer_read (struct trace_buffer *trace, uint32_t offset, struct trace_record *records,
+	size_t count);
+uint32_t trace_buffer_get_count (struct trace_buffer *trace);
+void trace_buffer_set_enabled (struct trace_buffer *trace, bool enabled);
+void trace_buffer_clear (struct trace_buffer *trace);
+
+int trace_buffer_register (struct trace_buffer *trace, int core);
+struct trace_buffer* trace_buffer_get_core (int core);
+
+void trace_buffer_event (uint16_t event, uint8_t phase, uint32_t arg1, uint32_t arg2);
+
+
+/**
+ * Trace buffers for each core.  A trace buffer is only used by the instrumented code once it has
+ * been registered for a core.
+ */
+extern struct trace_buffer *trace_buffers[TRACE_BUFFER_MAX_CORES];
+
+
+/* Instrumentation for traced operations.  Without ENABLE_TRACE, these compile to nothing. */
+#ifdef ENABLE_TRACE
+#define	TRACE_EVENT(event, phase, arg1, arg2)	trace_buffer_event (event, phase, arg1, arg2)
+#else
+#define	TRACE_EVENT(event, phase, arg1, arg2)
+#endif
+
+#define	TRACE_BEGIN(event, arg1, arg2)			TRACE_EVENT (event, TRACE_PHASE_BEGIN, arg1, arg2)
+#define	TRACE_END(event, arg1, arg2)			TRACE_EVENT (event, TRACE_PHASE_END, arg1, arg2)
+#define	TRACE_INSTANT(event, arg1, arg2)		TRACE_EVENT (event, TRACE_PHASE_INSTANT, arg1, arg2)
+
+
+#endif /* TRACE_BUFFER_H_ */
@@ -105,7 +105,7 @@ static int mctp_interface_generate_error_packet (struct mctp_interface *interfac
 	int status;
 
 	if (error_code != CERBERUS_PROTOCOL_NO_ERROR) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_MCTP,
+		DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_MCTP,
 			MCTP_LOGGING_PROTOCOL_ERROR,
 			(error_code << 24 | src_eid << 16 | dest_eid << 8 | msg_tag), error_data);
 	}
@@ -221,7 +221,7 @@ int mctp_interface_process_packet (struct mctp_interface *interface, struct cmd_
 				}
 			}
 
-			debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_MCTP,
+			DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_MCTP,
 				MCTP_LOGGING_PKT_DROPPED, msg1, msg2);
 
 			mctp_interface_reset_message_processing (interface);
@@ -288,7 +288,7 @@ int mctp_interface_process_packet (struct mctp_interface *interface, struct cmd_
 			status = mctp_interface_control_process_request (interface,	&interface->msg_buffer,
 				source_addr);
 			if (status != 0) {
-				debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_MCTP,
+				DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_MCTP,
 					MCTP_LOGGING_CONTROL_FAIL, status, 0);
 
 				return status;
@@ -315,7 +315,7 @@ int mctp_interface_process_packet (struct mctp_interface *interface, struct cmd_
 					struct cerberus_protocol_error *error_msg =
 						(struct cerberus_protocol_error*) interface->msg_buffer.data;
 
-					debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR,
+					DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_ERROR,
 						DEBUG_LOG_COMPONENT_MCTP, MCTP_LOGGING_ERR_MSG,
 						(error_msg->error_code << 24 | src_eid << 16 | dest_eid << 8 | msg_tag),
 						error_msg->error_data);
@@ -400,6 +400,7 @@ int ecc_riot_init (struct ecc_engine_riot *engine, struct rng_engine *rng)
 	engine->base.get_public_key_der = ecc_riot_get_public_key_der;
 #endif
 	engine->base.sign = ecc_riot_sign;
+	engine->base.precompute_sign = NULL;
 	engine->base.verify = ecc_riot_verify;
 #ifdef ECC_ENABLE_ECDH
 	engine->base.get_shared_secret_max_length = NULL;
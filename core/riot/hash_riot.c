@@ -162,6 +162,7 @@ int hash_riot_init (struct hash_engine_riot *engine)
 	engine->base.start_sha1 = hash_riot_start_sha1;
 #endif
 	engine->base.calculate_sha256 = hash_riot_calculate_sha256;
+	engine->base.calculate_sha256_multi = NULL;
 	engine->base.start_sha256 = hash_riot_start_sha256;
 	engine->base.update = hash_riot_update;
 	engine->base.finish = hash_riot_finish;
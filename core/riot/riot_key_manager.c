@@ -206,6 +206,13 @@ static int riot_key_manager_init_certs (struct riot_key_manager *riot, struct ke
 		return status;
 	}
 
+	status = observable_init (&riot->observable);
+	if (status != 0) {
+		platform_mutex_free (&riot->store_lock);
+		platform_mutex_free (&riot->auth_lock);
+		return status;
+	}
+
 	riot->keystore = keystore;
 	riot->x509 = x509;
 	riot->static_keys = static_keys;
@@ -279,11 +286,49 @@ void riot_key_manager_release (struct riot_key_manager *riot)
 		riot_key_manager_free_ca_cert (&riot->root_ca);
 		riot_key_manager_free_ca_cert (&riot->intermediate_ca);
 
+		observable_release (&riot->observable);
 		platform_mutex_free (&riot->store_lock);
 		platform_mutex_free (&riot->auth_lock);
 	}
 }
 
+/**
+ * Add an observer to be notified of changes to the RIoT certificate chain.  An observer can only
+ * be added to the list once.
+ *
+ * @param riot The RIoT key manager to register with.
+ * @param observer The observer to add.
+ *
+ * @return 0 if the observer was added for notifications or an error code.
+ */
+int riot_key_manager_add_observer (struct riot_key_manager *riot,
+	struct riot_key_manager_observer *observer)
+{
+	if (riot == NULL) {
+		return RIOT_KEY_MANAGER_INVALID_ARGUMENT;
+	}
+
+	return observable_add_observer (&riot->observable, observer);
+}
+
+/**
+ * Remove an observer so it will no longer be notified of changes to the RIoT certificate chain.
+ *
+ * @param riot The RIoT key manager to deregister from.
+ * @param observer The observer to remove.
+ *
+ * @return 0 if the observer was removed from future notifications or an error code.
+ */
+int riot_key_manager_remove_observer (struct riot_key_manager *riot,
+	struct riot_key_manager_observer *observer)
+{
+	if (riot == NULL) {
+		return RIOT_KEY_MANAGER_INVALID_ARGUMENT;
+	}
+
+	return observable_remove_observer (&riot->observable, observer);
+}
+
 /**
  * Store the signed Device ID certificate.
  *
@@ -343,6 +388,7 @@ int riot_key_manager_store_intermediate_ca (struct riot_key_manager *riot, const
  * the RIoT certificates exposed by the manager will be updated to match the stored ones.
  *
  * Once the certificate chain has been verified, further attempts to store certificates will fail.
+ * Registered observers will be notified after verification has been attempted.
  *
  * Updates to the certificate chain will be blocked until the RIoT Core device keys are not in use.
  *
@@ -352,11 +398,20 @@ int riot_key_manager_store_intermediate_ca (struct riot_key_manager *riot, const
  */
 int riot_key_manager_verify_stored_certs (struct riot_key_manager *riot)
 {
+	int status;
+
 	if (riot == NULL) {
 		return RIOT_KEY_MANAGER_INVALID_ARGUMENT;
 	}
 
-	return riot_key_manager_authenticate_stored_certificates (riot);
+	status = riot_key_manager_authenticate_stored_certificates (riot);
+
+	/* The CA certificates are loaded while authenticating the chain and released again on failure,
+	 * so observers must be told even if authentication did not succeed. */
+	observable_notify_observers (&riot->observable,
+		offsetof (struct riot_key_manager_observer, on_cert_chain_changed));
+
+	return status;
 }
 
  /**
@@ -13,6 +13,8 @@
 #include "riot_keys.h"
 #include "crypto/x509.h"
 #include "common/certificate.h"
+#include "common/observable.h"
+#include "riot_key_manager_observer.h"
 
 
 /**
@@ -28,6 +30,7 @@ struct riot_key_manager {
 	bool static_devid;						/**< Flag indicating a static device ID cert buffer. */
 	platform_mutex store_lock;				/**< Synchronization for cert storage. */
 	platform_mutex auth_lock;				/**< Synchronization for key updates. */
+	struct observable observable;			/**< The manager for certificate chain observers. */
 };
 
 
@@ -37,6 +40,11 @@ int riot_key_manager_init_static (struct riot_key_manager *riot, struct keystore
 	const struct riot_keys *keys, struct x509_engine *x509);
 void riot_key_manager_release (struct riot_key_manager *keystore);
 
+int riot_key_manager_add_observer (struct riot_key_manager *riot,
+	struct riot_key_manager_observer *observer);
+int riot_key_manager_remove_observer (struct riot_key_manager *riot,
+	struct riot_key_manager_observer *observer);
+
 int riot_key_manager_store_signed_device_id (struct riot_key_manager *riot, const uint8_t *dev_id,
 	size_t length);
 int riot_key_manager_store_root_ca (struct riot_key_manager *riot, const uint8_t *root_ca,
@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef RIOT_KEY_MANAGER_OBSERVER_H_
+#define RIOT_KEY_MANAGER_OBSERVER_H_
+
+
+/**
+ * Interface for notifying observers of changes to the RIoT certificate chain.  Unwanted event
+ * notifications will be set to null.
+ */
+struct riot_key_manager_observer {
+	/**
+	 * Notification that the certificates managed by the RIoT key manager may have changed.  This
+	 * is generated after every attempt to authenticate the stored certificate chain, whether or
+	 * not the attempt was successful.
+	 *
+	 * @param observer The observer being notified.
+	 */
+	void (*on_cert_chain_changed) (struct riot_key_manager_observer *observer);
+};
+
+
+#endif /* RIOT_KEY_MANAGER_OBSERVER_H_ */
@@ -503,6 +503,36 @@ int state_manager_store_non_volatile_state (struct state_manager *manager)
 	return status;
 }
 
+/**
+ * Determine if the current non-volatile state differs from the state that was last stored to
+ * flash.  This does not access flash, so it can be used by a background task to decide if the
+ * state needs to be stored without generating any flash traffic while the state is unchanged.
+ *
+ * Storing the state when there is nothing pending will only verify the flash contents.
+ *
+ * @param manager The manager to query.
+ *
+ * @return true if there is non-volatile state that needs to be stored or false if flash is already
+ * up to date.
+ */
+bool state_manager_has_pending_non_volatile_state (struct state_manager *manager)
+{
+	uint16_t store_state;
+	bool pending;
+
+	if (manager == NULL) {
+		return false;
+	}
+
+	platform_mutex_lock (&manager->state_lock);
+	store_state = manager->nv_state & ~SINGLE_BYTE_STATE;
+	store_state |= MULTI_BYTE_STATE;
+	pending = (store_state != manager->last_nv_stored);
+	platform_mutex_unlock (&manager->state_lock);
+
+	return pending;
+}
+
 /**
  * Save the setting for the manifest region that contains the active manifest.
  * This setting will be stored in non-volatile memory on the next call to store state.
@@ -83,6 +83,7 @@ int state_manager_init (struct state_manager *manager, struct flash *state_flash
 void state_manager_release (struct state_manager *manager);
 
 int state_manager_store_non_volatile_state (struct state_manager *manager);
+bool state_manager_has_pending_non_volatile_state (struct state_manager *manager);
 void state_manager_block_non_volatile_state_storage (struct state_manager *manager, bool block);
 
 /* Internal functions for use by derived types. */
@@ -91,6 +91,12 @@ enum {
 	ROT_MODULE_CMD_DEVICE = 0x004f,						/**< Command handler for device-specific workflows. */
 	ROT_MODULE_HOST_PROCESSOR_OBSERVER = 0x0050,		/**< Observers for host processor management. */
 	ROT_MODULE_COUNTER_MANAGER = 0x0051,				/**< Counter operation management. */
+	ROT_MODULE_CMD_LOAD_GENERATOR = 0x0052,			/**< Load generator for command processing. */
+	ROT_MODULE_CMD_DEFERRED = 0x0053,					/**< Handler for deferred command execution. */
+	ROT_MODULE_CMD_CHANNEL_MUX = 0x0054,				/**< Multiplexer for servicing multiple command channels. */
+	ROT_MODULE_ATTESTATION_SCHEDULER = 0x0055,			/**< Scheduler for concurrent device attestation. */
+	ROT_MODULE_RSA_VERIFY_BENCHMARK = 0x0056,			/**< Throughput measurement for RSA signature verification. */
+	ROT_MODULE_FIRMWARE_UPDATE_JOURNAL = 0x0057,		/**< Journal of firmware update progress. */
 };
 
 
@@ -16,6 +16,7 @@
 //#define	TESTING_RUN_FLASH_UTIL_SUITE
 //#define	TESTING_RUN_APP_IMAGE_SUITE
 //#define	TESTING_RUN_FIRMWARE_UPDATE_SUITE
+//#define	TESTING_RUN_FIRMWARE_UPDATE_JOURNAL_SUITE
 //#define	TESTING_RUN_HOST_FW_UTIL_SUITE
 //#define	TESTING_RUN_MANIFEST_FLASH_SUITE
 //#define	TESTING_RUN_PFM_FLASH_SUITE
@@ -40,8 +41,13 @@
 //#define	TESTING_RUN_SPI_FILTER_IRQ_HANDLER_SUITE
 //#define	TESTING_RUN_PLATFORM_TIMER_SUITE
 //#define	TESTING_RUN_BMC_RECOVERY_SUITE
+//#define	TESTING_RUN_LOGGING_COALESCE_SUITE
 //#define	TESTING_RUN_LOGGING_FLASH_SUITE
+//#define	TESTING_RUN_LOGGING_FLASH_COMPACT_SUITE
 //#define	TESTING_RUN_LOGGING_MEMORY_SUITE
+//#define	TESTING_RUN_LOGGING_RING_SUITE
+//#define	TESTING_RUN_TRACE_BUFFER_SUITE
+//#define	TESTING_RUN_LOGGING_STAGED_SUITE
 //#define	TESTING_RUN_CHECKSUM_SUITE
 //#define	TESTING_RUN_MCTP_INTERFACE_SUITE
 //#define	TESTING_RUN_ECC_MBEDTLS_SUITE
@@ -59,7 +65,9 @@
 //#define	TESTING_RUN_HOST_IRQ_HANDLER_PFM_CHECK_SUITE
 //#define	TESTING_RUN_ATTESTATION_MASTER_SUITE
 //#define	TESTING_RUN_ATTESTATION_SLAVE_SUITE
+//#define	TESTING_RUN_ATTESTATION_SCHEDULER_SUITE
 //#define	TESTING_RUN_RNG_MBEDTLS_SUITE
+//#define	TESTING_RUN_RNG_BUFFERED_SUITE
 //#define	TESTING_RUN_DEVICE_MANAGER_SUITE
 //#define	TESTING_RUN_ECC_RIOT_SUITE
 //#define	TESTING_RUN_BASE64_RIOT_SUITE
@@ -87,6 +95,9 @@
 //#define	TESTING_RUN_SPI_FILTER_SUITE
 //#define	TESTING_RUN_IMAGE_HEADER_SUITE
 //#define	TESTING_RUN_CMD_CHANNEL_SUITE
+//#define	TESTING_RUN_CMD_STATS_SUITE
+//#define	TESTING_RUN_CMD_DEFERRED_SUITE
+//#define	TESTING_RUN_CMD_CHANNEL_MUX_SUITE
 //#define	TESTING_RUN_FIRMWARE_COMPONENT_SUITE
 //#define	TESTING_RUN_FLASH_UPDATER_SUITE
 //#define	TESTING_RUN_TPM_SUITE
@@ -115,6 +126,7 @@ CuSuite* get_rsa_mbedtls_suite (void);
 CuSuite* get_flash_util_suite (void);
 CuSuite* get_app_image_suite (void);
 CuSuite* get_firmware_update_suite (void);
+CuSuite* get_firmware_update_journal_suite (void);
 CuSuite* get_host_fw_util_suite (void);
 CuSuite* get_manifest_flash_suite (void);
 CuSuite* get_pfm_flash_suite (void);
@@ -145,8 +157,13 @@ CuSuite* get_host_irq_handler_suite (void);
 CuSuite* get_spi_filter_irq_handler_suite (void);
 CuSuite* get_platform_timer_suite (void);
 CuSuite* get_bmc_recovery_suite (void);
+CuSuite* get_logging_coalesce_suite (void);
 CuSuite* get_logging_flash_suite (void);
+CuSuite* get_logging_flash_compact_suite (void);
 CuSuite* get_logging_memory_suite (void);
+CuSuite* get_logging_ring_suite (void);
+CuSuite* get_trace_buffer_suite (void);
+CuSuite* get_logging_staged_suite (void);
 CuSuite* get_checksum_suite (void);
 CuSuite* get_mctp_interface_suite (void);
 CuSuite* get_ecc_mbedtls_suite (void);
@@ -164,7 +181,9 @@ CuSuite* get_spi_filter_irq_handler_dirty_suite (void);
 CuSuite* get_host_irq_handler_pfm_check_suite (void);
 CuSuite* get_attestation_master_suite (void);
 CuSuite* get_attestation_slave_suite (void);
+CuSuite* get_attestation_scheduler_suite (void);
 CuSuite* get_rng_mbedtls_suite (void);
+CuSuite* get_rng_buffered_suite (void);
 CuSuite* get_device_manager_suite (void);
 CuSuite* get_ecc_riot_suite (void);
 CuSuite* get_base64_riot_suite (void);
@@ -192,6 +211,9 @@ CuSuite* get_manifest_manager_suite (void);
 CuSuite* get_spi_filter_suite (void);
 CuSuite* get_image_header_suite (void);
 CuSuite* get_cmd_channel_suite (void);
+CuSuite* get_cmd_stats_suite (void);
+CuSuite* get_cmd_deferred_suite (void);
+CuSuite* get_cmd_channel_mux_suite (void);
 CuSuite* get_firmware_component_suite (void);
 CuSuite* get_flash_updater_suite (void);
 CuSuite* get_tpm_suite (void);
@@ -237,6 +259,9 @@ void add_all_tests (CuSuite *suite)
 #ifdef TESTING_RUN_FIRMWARE_UPDATE_SUITE
 	CuSuiteAddSuite (suite, get_firmware_update_suite ());
 #endif
+#ifdef TESTING_RUN_FIRMWARE_UPDATE_JOURNAL_SUITE
+	CuSuiteAddSuite (suite, get_firmware_update_journal_suite ());
+#endif
 #ifdef TESTING_RUN_HOST_FW_UTIL_SUITE
 	CuSuiteAddSuite (suite, get_host_fw_util_suite ());
 #endif
@@ -315,12 +340,27 @@ void add_all_tests (CuSuite *suite)
 #ifdef TESTING_RUN_BMC_RECOVERY_SUITE
 	CuSuiteAddSuite (suite, get_bmc_recovery_suite ());
 #endif
+#ifdef TESTING_RUN_LOGGING_COALESCE_SUITE
+	CuSuiteAddSuite (suite, get_logging_coalesce_suite ());
+#endif
 #ifdef TESTING_RUN_LOGGING_FLASH_SUITE
 	CuSuiteAddSuite (suite, get_logging_flash_suite ());
 #endif
+#ifdef TESTING_RUN_LOGGING_FLASH_COMPACT_SUITE
+	CuSuiteAddSuite (suite, get_logging_flash_compact_suite ());
+#endif
 #ifdef TESTING_RUN_LOGGING_MEMORY_SUITE
 	CuSuiteAddSuite (suite, get_logging_memory_suite ());
 #endif
+#ifdef TESTING_RUN_LOGGING_RING_SUITE
+	CuSuiteAddSuite (suite, get_logging_ring_suite ());
+#endif
+#ifdef TESTING_RUN_TRACE_BUFFER_SUITE
+	CuSuiteAddSuite (suite, get_trace_buffer_suite ());
+#endif
+#ifdef TESTING_RUN_LOGGING_STAGED_SUITE
+	CuSuiteAddSuite (suite, get_logging_staged_suite ());
+#endif
 #ifdef TESTING_RUN_CHECKSUM_SUITE
 	CuSuiteAddSuite (suite, get_checksum_suite ());
 #endif
@@ -372,9 +412,15 @@ void add_all_tests (CuSuite *suite)
 #ifdef TESTING_RUN_ATTESTATION_SLAVE_SUITE
 	CuSuiteAddSuite (suite, get_attestation_slave_suite ());
 #endif
+#ifdef TESTING_RUN_ATTESTATION_SCHEDULER_SUITE
+	CuSuiteAddSuite (suite, get_attestation_scheduler_suite ());
+#endif
 #ifdef TESTING_RUN_RNG_MBEDTLS_SUITE
 	CuSuiteAddSuite (suite, get_rng_mbedtls_suite ());
 #endif
+#ifdef TESTING_RUN_RNG_BUFFERED_SUITE
+	CuSuiteAddSuite (suite, get_rng_buffered_suite ());
+#endif
 #ifdef TESTING_RUN_DEVICE_MANAGER_SUITE
 	CuSuiteAddSuite (suite, get_device_manager_suite ());
 #endif
@@ -456,6 +502,15 @@ void add_all_tests (CuSuite *suite)
 #ifdef TESTING_RUN_CMD_CHANNEL_SUITE
 	CuSuiteAddSuite (suite, get_cmd_channel_suite ());
 #endif
+#ifdef TESTING_RUN_CMD_STATS_SUITE
+	CuSuiteAddSuite (suite, get_cmd_stats_suite ());
+#endif
+#ifdef TESTING_RUN_CMD_DEFERRED_SUITE
+	CuSuiteAddSuite (suite, get_cmd_deferred_suite ());
+#endif
+#ifdef TESTING_RUN_CMD_CHANNEL_MUX_SUITE
+	CuSuiteAddSuite (suite, get_cmd_channel_mux_suite ());
+#endif
 #ifdef TESTING_RUN_FIRMWARE_COMPONENT_SUITE
 	CuSuiteAddSuite (suite, get_firmware_component_suite ());
 #endif
@@ -2109,6 +2109,257 @@ static void app_image_test_verification_with_header_read_signature_error (CuTest
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
+static void app_image_test_verification_with_digest (CuTest *test)
+{
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+
+	TEST_START;
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_HEADER_LENGTH), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_HEADER_DATA + APP_IMAGE_HEADER_LENGTH,
+		sizeof (APP_IMAGE_HEADER_DATA) - APP_IMAGE_HEADER_LENGTH, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20104 + APP_IMAGE_HEADER_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (APP_IMAGE_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_HEADER_SIGNATURE, RSA_ENCRYPT_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_verification_with_digest (&flash.base, 0x20000, APP_IMAGE_HEADER_LENGTH,
+		APP_IMAGE_HEADER_HASH, sizeof (APP_IMAGE_HEADER_HASH), APP_IMAGE_HEADER_DATA_LENGTH,
+		&rsa.base, &RSA_PUBLIC_KEY);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_verification_with_digest_no_header (CuTest *test)
+{
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+
+	TEST_START;
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_DATA, sizeof (APP_IMAGE_DATA), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20104),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (APP_IMAGE_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_SIGNATURE, RSA_ENCRYPT_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_verification_with_digest (&flash.base, 0x20000, 0, APP_IMAGE_HASH,
+		sizeof (APP_IMAGE_HASH), APP_IMAGE_DATA_LENGTH, &rsa.base, &RSA_PUBLIC_KEY);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_verification_with_digest_no_match_signature (CuTest *test)
+{
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+
+	TEST_START;
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_HEADER_LENGTH), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_HEADER_DATA + APP_IMAGE_HEADER_LENGTH,
+		sizeof (APP_IMAGE_HEADER_DATA) - APP_IMAGE_HEADER_LENGTH, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20104 + APP_IMAGE_HEADER_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (APP_IMAGE_SIG_LENGTH));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_HEADER_SIGNATURE, RSA_ENCRYPT_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_verification_with_digest (&flash.base, 0x20000, APP_IMAGE_HEADER_LENGTH,
+		APP_IMAGE_HASH, sizeof (APP_IMAGE_HASH), APP_IMAGE_HEADER_DATA_LENGTH, &rsa.base,
+		&RSA_PUBLIC_KEY);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_verification_with_digest_length_mismatch (CuTest *test)
+{
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+
+	TEST_START;
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_HEADER_LENGTH), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_HEADER_DATA + APP_IMAGE_HEADER_LENGTH,
+		sizeof (APP_IMAGE_HEADER_DATA) - APP_IMAGE_HEADER_LENGTH, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_verification_with_digest (&flash.base, 0x20000, APP_IMAGE_HEADER_LENGTH,
+		APP_IMAGE_HEADER_HASH, sizeof (APP_IMAGE_HEADER_HASH), APP_IMAGE_HEADER_DATA_LENGTH + 1,
+		&rsa.base, &RSA_PUBLIC_KEY);
+	CuAssertIntEquals (test, APP_IMAGE_DIGEST_LENGTH_MISMATCH, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_verification_with_digest_null (CuTest *test)
+{
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+
+	TEST_START;
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_verification_with_digest (NULL, 0x20000, APP_IMAGE_HEADER_LENGTH,
+		APP_IMAGE_HEADER_HASH, sizeof (APP_IMAGE_HEADER_HASH), APP_IMAGE_HEADER_DATA_LENGTH,
+		&rsa.base, &RSA_PUBLIC_KEY);
+	CuAssertIntEquals (test, APP_IMAGE_INVALID_ARGUMENT, status);
+
+	status = app_image_verification_with_digest (&flash.base, 0x20000, APP_IMAGE_HEADER_LENGTH,
+		NULL, sizeof (APP_IMAGE_HEADER_HASH), APP_IMAGE_HEADER_DATA_LENGTH, &rsa.base,
+		&RSA_PUBLIC_KEY);
+	CuAssertIntEquals (test, APP_IMAGE_INVALID_ARGUMENT, status);
+
+	status = app_image_verification_with_digest (&flash.base, 0x20000, APP_IMAGE_HEADER_LENGTH,
+		APP_IMAGE_HEADER_HASH, sizeof (APP_IMAGE_HEADER_HASH) - 1, APP_IMAGE_HEADER_DATA_LENGTH,
+		&rsa.base, &RSA_PUBLIC_KEY);
+	CuAssertIntEquals (test, APP_IMAGE_INVALID_ARGUMENT, status);
+
+	status = app_image_verification_with_digest (&flash.base, 0x20000, APP_IMAGE_HEADER_LENGTH,
+		APP_IMAGE_HEADER_HASH, sizeof (APP_IMAGE_HEADER_HASH), APP_IMAGE_HEADER_DATA_LENGTH,
+		NULL, &RSA_PUBLIC_KEY);
+	CuAssertIntEquals (test, APP_IMAGE_INVALID_ARGUMENT, status);
+
+	status = app_image_verification_with_digest (&flash.base, 0x20000, APP_IMAGE_HEADER_LENGTH,
+		APP_IMAGE_HEADER_HASH, sizeof (APP_IMAGE_HEADER_HASH), APP_IMAGE_HEADER_DATA_LENGTH,
+		&rsa.base, NULL);
+	CuAssertIntEquals (test, APP_IMAGE_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_verification_with_digest_read_length_error (CuTest *test)
+{
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+
+	TEST_START;
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x20000 + APP_IMAGE_HEADER_LENGTH), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_verification_with_digest (&flash.base, 0x20000, APP_IMAGE_HEADER_LENGTH,
+		APP_IMAGE_HEADER_HASH, sizeof (APP_IMAGE_HEADER_HASH), APP_IMAGE_HEADER_DATA_LENGTH,
+		&rsa.base, &RSA_PUBLIC_KEY);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void app_image_test_verification_with_digest_read_signature_error (CuTest *test)
+{
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+
+	TEST_START;
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0,
+		MOCK_ARG (0x20000 + APP_IMAGE_HEADER_LENGTH), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, APP_IMAGE_HEADER_DATA + APP_IMAGE_HEADER_LENGTH,
+		sizeof (APP_IMAGE_HEADER_DATA) - APP_IMAGE_HEADER_LENGTH, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x20104 + APP_IMAGE_HEADER_LENGTH), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (APP_IMAGE_SIG_LENGTH));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = app_image_verification_with_digest (&flash.base, 0x20000, APP_IMAGE_HEADER_LENGTH,
+		APP_IMAGE_HEADER_HASH, sizeof (APP_IMAGE_HEADER_HASH), APP_IMAGE_HEADER_DATA_LENGTH,
+		&rsa.base, &RSA_PUBLIC_KEY);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
 static void app_image_test_get_hash_with_header (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
@@ -3333,6 +3584,13 @@ CuSuite* get_app_image_suite ()
 	SUITE_ADD_TEST (suite, app_image_test_verification_with_header_small_hash_buffer);
 	SUITE_ADD_TEST (suite, app_image_test_verification_with_header_read_length_error);
 	SUITE_ADD_TEST (suite, app_image_test_verification_with_header_read_signature_error);
+	SUITE_ADD_TEST (suite, app_image_test_verification_with_digest);
+	SUITE_ADD_TEST (suite, app_image_test_verification_with_digest_no_header);
+	SUITE_ADD_TEST (suite, app_image_test_verification_with_digest_no_match_signature);
+	SUITE_ADD_TEST (suite, app_image_test_verification_with_digest_length_mismatch);
+	SUITE_ADD_TEST (suite, app_image_test_verification_with_digest_null);
+	SUITE_ADD_TEST (suite, app_image_test_verification_with_digest_read_length_error);
+	SUITE_ADD_TEST (suite, app_image_test_verification_with_digest_read_signature_error);
 	SUITE_ADD_TEST (suite, app_image_test_get_hash_with_header);
 	SUITE_ADD_TEST (suite, app_image_test_get_hash_with_header_zero_length);
 	SUITE_ADD_TEST (suite, app_image_test_get_hash_with_header_null);
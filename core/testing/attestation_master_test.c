@@ -357,6 +357,7 @@ static void attestation_master_test_init (CuTest *test)
 	CuAssertPtrNotNull (test, attestation.compare_digests);
 	CuAssertPtrNotNull (test, attestation.store_certificate);
 	CuAssertPtrNotNull (test, attestation.process_challenge_response);
+	CuAssertIntEquals (test, 1, attestation.num_devices);
 
 	complete_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
 		&keystore, &manager, &riot);
@@ -555,6 +556,34 @@ static void attestation_master_test_release_null (CuTest *test)
 	attestation_master_release (NULL);
 }
 
+static void attestation_master_test_release_after_device_table_resize (CuTest *test)
+{
+	int status;
+	struct attestation_master attestation;
+	struct hash_engine_mock hash;
+	struct ecc_engine_mock ecc;
+	struct rsa_engine_mock rsa;
+	struct x509_engine_mock x509;
+	struct rng_engine_mock rng;
+	struct riot_key_manager riot;
+	struct keystore_mock keystore;
+	struct device_manager manager;
+
+	TEST_START;
+
+	setup_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		ATTESTATION_ECDHE_KEY_EXCHANGE, &riot, &keystore, &manager);
+
+	status = device_manager_resize_entries_table (&manager, 4);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Only the devices known at initialization have cached keys to release. */
+	CuAssertIntEquals (test, 1, attestation.num_devices);
+
+	complete_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		&keystore, &manager, &riot);
+}
+
 static void attestation_master_test_issue_challenge (CuTest *test)
 {
 	int status;
@@ -3053,6 +3082,510 @@ static void attestation_master_test_process_challenge_response_rsa_verify_failur
 		&keystore, &manager, &riot);
 }
 
+static void attestation_master_test_process_challenge_response_cached_leaf_key_ecc (CuTest *test)
+{
+	int status;
+	struct attestation_master attestation;
+	struct hash_engine_mock hash;
+	struct ecc_engine_mock ecc;
+	struct rsa_engine_mock rsa;
+	struct x509_engine_mock x509;
+	struct rng_engine_mock rng;
+	struct attestation_challenge challenge;
+	struct attestation_chain_digest digests;
+	struct riot_key_manager riot;
+	struct keystore_mock keystore;
+	struct device_manager manager;
+	uint8_t buf[137] = {0};
+	uint16_t buf_len = 137;
+
+	TEST_START;
+
+	buf[1] = 1;
+
+	digests.num_cert = 2;
+
+	setup_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		ATTESTATION_ECDHE_KEY_EXCHANGE, &riot, &keystore, &manager);
+
+	status = mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0, MOCK_ARG (32),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0, MOCK_ARG (32),
+		MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&x509.mock, x509.base.init_ca_cert_store, &x509, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&x509.mock, 0, 0);
+	status |= mock_expect (&x509.mock, x509.base.add_root_ca, &x509, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.load_certificate, &x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect_save_arg (&x509.mock, 0, 1);
+	status |= mock_expect (&x509.mock, x509.base.authenticate, &x509, 0, MOCK_ARG_SAVED_ARG (1),
+		MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&x509.mock, x509.base.get_public_key, &x509, 0, MOCK_ARG_SAVED_ARG (1),
+		MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&x509.mock, x509.base.release_certificate, &x509, 0,
+		MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&x509.mock, x509.base.release_ca_cert_store, &x509, 0,
+		MOCK_ARG_SAVED_ARG (0));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0, MOCK_ARG_ANY,
+		MOCK_ARG_ANY, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&ecc.mock, 2, 0);
+	status |= mock_expect (&ecc.mock, ecc.base.verify, &ecc, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (32), MOCK_ARG_PTR_CONTAINS (&buf[72], 65), MOCK_ARG (65));
+	status |= mock_expect (&ecc.mock, ecc.base.verify, &ecc, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (32), MOCK_ARG_PTR_CONTAINS (&buf[72], 65), MOCK_ARG (65));
+	status |= mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG (0),
+		MOCK_ARG_SAVED_ARG (0));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (34));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (buf, 72),
+		MOCK_ARG (72));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (32));
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (34));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (buf, 72),
+		MOCK_ARG (72));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (32));
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 1, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 0, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 1, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.issue_challenge (&attestation, 0xAA, 0, (uint8_t*)&challenge,
+		sizeof (struct attestation_challenge));
+	CuAssertIntEquals (test, sizeof (struct attestation_challenge), status);
+
+	status = attestation.process_challenge_response (&attestation, buf, buf_len, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.issue_challenge (&attestation, 0xAA, 0, (uint8_t*)&challenge,
+		sizeof (struct attestation_challenge));
+	CuAssertIntEquals (test, sizeof (struct attestation_challenge), status);
+
+	status = attestation.process_challenge_response (&attestation, buf, buf_len, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		&keystore, &manager, &riot);
+}
+
+static void attestation_master_test_process_challenge_response_cached_leaf_key_new_cert (
+	CuTest *test)
+{
+	int status;
+	struct attestation_master attestation;
+	struct hash_engine_mock hash;
+	struct ecc_engine_mock ecc;
+	struct rsa_engine_mock rsa;
+	struct x509_engine_mock x509;
+	struct rng_engine_mock rng;
+	struct attestation_challenge challenge;
+	struct attestation_chain_digest digests;
+	struct riot_key_manager riot;
+	struct keystore_mock keystore;
+	struct device_manager manager;
+	uint8_t buf[137] = {0};
+	uint16_t buf_len = 137;
+
+	TEST_START;
+
+	buf[1] = 1;
+
+	digests.num_cert = 2;
+
+	setup_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		ATTESTATION_ECDHE_KEY_EXCHANGE, &riot, &keystore, &manager);
+
+	status = mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0, MOCK_ARG (32),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0, MOCK_ARG (32),
+		MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&x509.mock, x509.base.init_ca_cert_store, &x509, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&x509.mock, 0, 0);
+	status |= mock_expect (&x509.mock, x509.base.add_root_ca, &x509, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.load_certificate, &x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect_save_arg (&x509.mock, 0, 1);
+	status |= mock_expect (&x509.mock, x509.base.authenticate, &x509, 0, MOCK_ARG_SAVED_ARG (1),
+		MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&x509.mock, x509.base.get_public_key, &x509, 0, MOCK_ARG_SAVED_ARG (1),
+		MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&x509.mock, x509.base.release_certificate, &x509, 0,
+		MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&x509.mock, x509.base.release_ca_cert_store, &x509, 0,
+		MOCK_ARG_SAVED_ARG (0));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&x509.mock, x509.base.init_ca_cert_store, &x509, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&x509.mock, 0, 2);
+	status |= mock_expect (&x509.mock, x509.base.add_root_ca, &x509, 0, MOCK_ARG_SAVED_ARG (2),
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.load_certificate, &x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect_save_arg (&x509.mock, 0, 3);
+	status |= mock_expect (&x509.mock, x509.base.authenticate, &x509, 0, MOCK_ARG_SAVED_ARG (3),
+		MOCK_ARG_SAVED_ARG (2));
+	status |= mock_expect (&x509.mock, x509.base.get_public_key, &x509, 0, MOCK_ARG_SAVED_ARG (3),
+		MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&x509.mock, x509.base.release_certificate, &x509, 0,
+		MOCK_ARG_SAVED_ARG (3));
+	status |= mock_expect (&x509.mock, x509.base.release_ca_cert_store, &x509, 0,
+		MOCK_ARG_SAVED_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0, MOCK_ARG_ANY,
+		MOCK_ARG_ANY, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&ecc.mock, 2, 0);
+	status |= mock_expect (&ecc.mock, ecc.base.verify, &ecc, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (32), MOCK_ARG_PTR_CONTAINS (&buf[72], 65), MOCK_ARG (65));
+	status |= mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG (0),
+		MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0, MOCK_ARG_ANY,
+		MOCK_ARG_ANY, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&ecc.mock, 2, 1);
+	status |= mock_expect (&ecc.mock, ecc.base.verify, &ecc, 0, MOCK_ARG_SAVED_ARG (1),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (32), MOCK_ARG_PTR_CONTAINS (&buf[72], 65), MOCK_ARG (65));
+	status |= mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG (0),
+		MOCK_ARG_SAVED_ARG (1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (34));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (buf, 72),
+		MOCK_ARG (72));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (32));
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (34));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (buf, 72),
+		MOCK_ARG (72));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (32));
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 1, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 0, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 1, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.issue_challenge (&attestation, 0xAA, 0, (uint8_t*)&challenge,
+		sizeof (struct attestation_challenge));
+	CuAssertIntEquals (test, sizeof (struct attestation_challenge), status);
+
+	status = attestation.process_challenge_response (&attestation, buf, buf_len, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 1, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.issue_challenge (&attestation, 0xAA, 0, (uint8_t*)&challenge,
+		sizeof (struct attestation_challenge));
+	CuAssertIntEquals (test, sizeof (struct attestation_challenge), status);
+
+	status = attestation.process_challenge_response (&attestation, buf, buf_len, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		&keystore, &manager, &riot);
+}
+
+static void attestation_master_test_process_challenge_response_cached_leaf_key_digest_mismatch (
+	CuTest *test)
+{
+	int status;
+	struct attestation_master attestation;
+	struct hash_engine_mock hash;
+	struct ecc_engine_mock ecc;
+	struct rsa_engine_mock rsa;
+	struct x509_engine_mock x509;
+	struct rng_engine_mock rng;
+	struct attestation_challenge challenge;
+	struct attestation_chain_digest digests;
+	struct riot_key_manager riot;
+	struct keystore_mock keystore;
+	struct device_manager manager;
+	uint8_t buf[137] = {0};
+	uint16_t buf_len = 137;
+
+	TEST_START;
+
+	buf[1] = 1;
+
+	digests.num_cert = 2;
+	digests.digest_len = SHA256_HASH_LENGTH;
+	digests.digest = platform_calloc (2, SHA256_HASH_LENGTH);
+	CuAssertPtrNotNull (test, digests.digest);
+
+	digests.digest[0] = 0xAA;
+
+	setup_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		ATTESTATION_ECDHE_KEY_EXCHANGE, &riot, &keystore, &manager);
+
+	status = mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0, MOCK_ARG (32),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0, MOCK_ARG (32),
+		MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&x509.mock, x509.base.init_ca_cert_store, &x509, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&x509.mock, 0, 0);
+	status |= mock_expect (&x509.mock, x509.base.add_root_ca, &x509, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.load_certificate, &x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect_save_arg (&x509.mock, 0, 1);
+	status |= mock_expect (&x509.mock, x509.base.authenticate, &x509, 0, MOCK_ARG_SAVED_ARG (1),
+		MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&x509.mock, x509.base.get_public_key, &x509, 0, MOCK_ARG_SAVED_ARG (1),
+		MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&x509.mock, x509.base.release_certificate, &x509, 0,
+		MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&x509.mock, x509.base.release_ca_cert_store, &x509, 0,
+		MOCK_ARG_SAVED_ARG (0));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&x509.mock, x509.base.init_ca_cert_store, &x509, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&x509.mock, 0, 2);
+	status |= mock_expect (&x509.mock, x509.base.add_root_ca, &x509, 0, MOCK_ARG_SAVED_ARG (2),
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.load_certificate, &x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect_save_arg (&x509.mock, 0, 3);
+	status |= mock_expect (&x509.mock, x509.base.authenticate, &x509, 0, MOCK_ARG_SAVED_ARG (3),
+		MOCK_ARG_SAVED_ARG (2));
+	status |= mock_expect (&x509.mock, x509.base.get_public_key, &x509, 0, MOCK_ARG_SAVED_ARG (3),
+		MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&x509.mock, x509.base.release_certificate, &x509, 0,
+		MOCK_ARG_SAVED_ARG (3));
+	status |= mock_expect (&x509.mock, x509.base.release_ca_cert_store, &x509, 0,
+		MOCK_ARG_SAVED_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0, MOCK_ARG_ANY,
+		MOCK_ARG_ANY, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&ecc.mock, 2, 0);
+	status |= mock_expect (&ecc.mock, ecc.base.verify, &ecc, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (32), MOCK_ARG_PTR_CONTAINS (&buf[72], 65), MOCK_ARG (65));
+	status |= mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG (0),
+		MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0, MOCK_ARG_ANY,
+		MOCK_ARG_ANY, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&ecc.mock, 2, 1);
+	status |= mock_expect (&ecc.mock, ecc.base.verify, &ecc, 0, MOCK_ARG_SAVED_ARG (1),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (32), MOCK_ARG_PTR_CONTAINS (&buf[72], 65), MOCK_ARG (65));
+	status |= mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG (0),
+		MOCK_ARG_SAVED_ARG (1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (34));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (buf, 72),
+		MOCK_ARG (72));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (32));
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&hash.mock, 2, &digests.digest[32], SHA256_HASH_LENGTH, -1);
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&hash.mock, 2, &digests.digest[32], SHA256_HASH_LENGTH, -1);
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (34));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (buf, 72),
+		MOCK_ARG (72));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (32));
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 1, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 0, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 1, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.issue_challenge (&attestation, 0xAA, 0, (uint8_t*)&challenge,
+		sizeof (struct attestation_challenge));
+	CuAssertIntEquals (test, sizeof (struct attestation_challenge), status);
+
+	status = attestation.process_challenge_response (&attestation, buf, buf_len, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 1, status);
+
+	status = attestation.issue_challenge (&attestation, 0xAA, 0, (uint8_t*)&challenge,
+		sizeof (struct attestation_challenge));
+	CuAssertIntEquals (test, sizeof (struct attestation_challenge), status);
+
+	status = attestation.process_challenge_response (&attestation, buf, buf_len, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	platform_free (digests.digest);
+
+	complete_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		&keystore, &manager, &riot);
+}
+
+static void attestation_master_test_process_challenge_response_cached_leaf_key_rsa (CuTest *test)
+{
+	int status;
+	struct attestation_master attestation;
+	struct hash_engine_mock hash;
+	struct ecc_engine_mock ecc;
+	struct rsa_engine_mock rsa;
+	struct x509_engine_mock x509;
+	struct rng_engine_mock rng;
+	struct attestation_challenge challenge;
+	struct attestation_chain_digest digests;
+	struct riot_key_manager riot;
+	struct keystore_mock keystore;
+	struct device_manager manager;
+	uint8_t buf[329] = {0};
+	uint16_t buf_len = 329;
+
+	TEST_START;
+
+	buf[1] = 1;
+
+	digests.num_cert = 2;
+
+	setup_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		ATTESTATION_RSA_KEY_EXCHANGE, &riot, &keystore, &manager);
+
+	status = mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0, MOCK_ARG (32),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0, MOCK_ARG (32),
+		MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&x509.mock, x509.base.init_ca_cert_store, &x509, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_save_arg (&x509.mock, 0, 0);
+	status |= mock_expect (&x509.mock, x509.base.add_root_ca, &x509, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect (&x509.mock, x509.base.load_certificate, &x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN));
+	status |= mock_expect_save_arg (&x509.mock, 0, 1);
+	status |= mock_expect (&x509.mock, x509.base.authenticate, &x509, 0, MOCK_ARG_SAVED_ARG (1),
+		MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&x509.mock, x509.base.get_public_key, &x509, 0, MOCK_ARG_SAVED_ARG (1),
+		MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&x509.mock, x509.base.release_certificate, &x509, 0,
+		MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&x509.mock, x509.base.release_ca_cert_store, &x509, 0,
+		MOCK_ARG_SAVED_ARG (0));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&rsa.mock, rsa.base.init_public_key, &rsa, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG_ANY, MOCK_ARG_ANY);
+	status |= mock_expect_save_arg (&rsa.mock, 0, 0);
+	status |= mock_expect (&rsa.mock, rsa.base.sig_verify, &rsa, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (&buf[72], 257), MOCK_ARG (257), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect (&rsa.mock, rsa.base.sig_verify, &rsa, 0, MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (&buf[72], 257), MOCK_ARG (257), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (34));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (buf, 72),
+		MOCK_ARG (72));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (32));
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (34));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (buf, 72),
+		MOCK_ARG (72));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (32));
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.compare_digests (&attestation, 0xAA, &digests);
+	CuAssertIntEquals (test, 1, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 0, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.store_certificate (&attestation, 0xAA, 0, 1, RIOT_CORE_DEVID_CERT,
+		RIOT_CORE_DEVID_CERT_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.issue_challenge (&attestation, 0xAA, 0, (uint8_t*)&challenge,
+		sizeof (struct attestation_challenge));
+	CuAssertIntEquals (test, sizeof (struct attestation_challenge), status);
+
+	status = attestation.process_challenge_response (&attestation, buf, buf_len, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.issue_challenge (&attestation, 0xAA, 0, (uint8_t*)&challenge,
+		sizeof (struct attestation_challenge));
+	CuAssertIntEquals (test, sizeof (struct attestation_challenge), status);
+
+	status = attestation.process_challenge_response (&attestation, buf, buf_len, 0xAA);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_attestation_master_mock_test (test, &attestation, &hash, &ecc, &rsa, &x509, &rng,
+		&keystore, &manager, &riot);
+}
+
 static void attestation_master_test_process_challenge_response_null (CuTest *test)
 {
 	int status;
@@ -3091,6 +3624,7 @@ CuSuite* get_attestation_master_suite ()
 	SUITE_ADD_TEST (suite, attestation_master_test_init_null);
 	SUITE_ADD_TEST (suite, attestation_master_test_init_invalid_encryption_algo);
 	SUITE_ADD_TEST (suite, attestation_master_test_release_null);
+	SUITE_ADD_TEST (suite, attestation_master_test_release_after_device_table_resize);
 	SUITE_ADD_TEST (suite, attestation_master_test_issue_challenge);
 	SUITE_ADD_TEST (suite, attestation_master_test_issue_challenge_buf_too_small);
 	SUITE_ADD_TEST (suite, attestation_master_test_issue_challenge_invalid_slot_num);
@@ -3146,6 +3680,12 @@ CuSuite* get_attestation_master_suite ()
 		attestation_master_test_process_challenge_response_rsa_public_key_failure);
 	SUITE_ADD_TEST (suite, attestation_master_test_process_challenge_response_ecc_verify_failure);
 	SUITE_ADD_TEST (suite, attestation_master_test_process_challenge_response_rsa_verify_failure);
+	SUITE_ADD_TEST (suite, attestation_master_test_process_challenge_response_cached_leaf_key_ecc);
+	SUITE_ADD_TEST (suite,
+		attestation_master_test_process_challenge_response_cached_leaf_key_new_cert);
+	SUITE_ADD_TEST (suite,
+		attestation_master_test_process_challenge_response_cached_leaf_key_digest_mismatch);
+	SUITE_ADD_TEST (suite, attestation_master_test_process_challenge_response_cached_leaf_key_rsa);
 	SUITE_ADD_TEST (suite, attestation_master_test_process_challenge_response_null);
 
 	return suite;
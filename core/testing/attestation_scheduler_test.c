@@ -0,0 +1,1124 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "platform.h"
+#include "attestation/attestation_scheduler.h"
+#include "cmd_interface/cerberus_protocol.h"
+#include "mctp/mctp_protocol.h"
+#include "mock/cmd_channel_mock.h"
+#include "mock/cmd_interface_mock.h"
+
+
+static const char *SUITE = "attestation_scheduler";
+
+
+/**
+ * The number of buses used for testing.
+ */
+#define	ATTESTATION_SCHEDULER_TESTING_BUSES		2
+
+/**
+ * The number of devices used for testing, including the local device.
+ */
+#define	ATTESTATION_SCHEDULER_TESTING_DEVICES	4
+
+/**
+ * Attestation period used for testing.  This is long enough that devices will not be attested
+ * again during a test.
+ */
+#define	ATTESTATION_SCHEDULER_TESTING_PERIOD	10000
+
+/**
+ * Address of the local device.
+ */
+#define	ATTESTATION_SCHEDULER_TESTING_ADDR		0x41
+
+/**
+ * Get the EID for a remote test device.
+ */
+#define	ATTESTATION_SCHEDULER_TESTING_EID(x)	(0x20 + (x))
+
+/**
+ * Get the address for a remote test device.
+ */
+#define	ATTESTATION_SCHEDULER_TESTING_DEV_ADDR(x)	(0x50 + (x))
+
+
+/**
+ * Dependencies for testing the attestation scheduler.
+ */
+struct attestation_scheduler_testing {
+	struct cmd_channel_mock channel[ATTESTATION_SCHEDULER_TESTING_BUSES];	/**< Mock channels for each bus. */
+	struct mctp_interface mctp[ATTESTATION_SCHEDULER_TESTING_BUSES];		/**< MCTP handler for each bus. */
+	uint8_t msg_tag[ATTESTATION_SCHEDULER_TESTING_BUSES];					/**< Next message tag on each bus. */
+	struct cmd_interface_mock cmd;											/**< Mock command handler. */
+	struct device_manager device_mgr;										/**< Manager for the attested devices. */
+	struct attestation_scheduler scheduler;									/**< The scheduler under test. */
+};
+
+
+/**
+ * Initialize the device manager and MCTP dependencies for testing.  Remote devices have a 10ms
+ * response timeout and 100ms crypto timeout.
+ *
+ * @param test The test framework.
+ * @param testing The testing components to initialize.
+ */
+static void attestation_scheduler_testing_init_dependencies (CuTest *test,
+	struct attestation_scheduler_testing *testing)
+{
+	struct device_manager_full_capabilities capabilities;
+	int status;
+	int i;
+
+	status = cmd_interface_mock_init (&testing->cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_init (&testing->device_mgr, ATTESTATION_SCHEDULER_TESTING_DEVICES,
+		DEVICE_MANAGER_PA_ROT_MODE, DEVICE_MANAGER_MASTER_AND_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_device_entry (&testing->device_mgr, 0, DEVICE_MANAGER_SELF,
+		MCTP_PROTOCOL_PA_ROT_CTRL_EID, ATTESTATION_SCHEDULER_TESTING_ADDR);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&capabilities, 0, sizeof (capabilities));
+	capabilities.request.max_message_size = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+	capabilities.request.max_packet_size = MCTP_PROTOCOL_MAX_TRANSMISSION_UNIT;
+	capabilities.max_timeout = 1;
+	capabilities.max_sig = 1;
+
+	for (i = 1; i < ATTESTATION_SCHEDULER_TESTING_DEVICES; i++) {
+		status = device_manager_update_device_entry (&testing->device_mgr, i,
+			DEVICE_MANAGER_DOWNSTREAM, ATTESTATION_SCHEDULER_TESTING_EID (i),
+			ATTESTATION_SCHEDULER_TESTING_DEV_ADDR (i));
+		CuAssertIntEquals (test, 0, status);
+
+		status = device_manager_update_device_capabilities (&testing->device_mgr, i,
+			&capabilities);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	for (i = 0; i < ATTESTATION_SCHEDULER_TESTING_BUSES; i++) {
+		status = cmd_channel_mock_init (&testing->channel[i], i);
+		CuAssertIntEquals (test, 0, status);
+
+		status = mctp_interface_init (&testing->mctp[i], &testing->cmd.base, &testing->device_mgr,
+			MCTP_PROTOCOL_PA_ROT_CTRL_EID, CERBERUS_PROTOCOL_MSFT_PCI_VID,
+			CERBERUS_PROTOCOL_PROTOCOL_VERSION);
+		CuAssertIntEquals (test, 0, status);
+
+		testing->msg_tag[i] = 0;
+	}
+}
+
+/**
+ * Initialize the scheduler for testing and add all buses.
+ *
+ * @param test The test framework.
+ * @param testing The testing components to initialize.
+ * @param max_outstanding The maximum number of active exchanges for the scheduler.
+ */
+static void attestation_scheduler_testing_init (CuTest *test,
+	struct attestation_scheduler_testing *testing, size_t max_outstanding)
+{
+	int status;
+	int i;
+
+	attestation_scheduler_testing_init_dependencies (test, testing);
+
+	status = attestation_scheduler_init (&testing->scheduler, &testing->device_mgr,
+		max_outstanding, ATTESTATION_SCHEDULER_TESTING_PERIOD);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < ATTESTATION_SCHEDULER_TESTING_BUSES; i++) {
+		status = attestation_scheduler_add_bus (&testing->scheduler, &testing->channel[i].base,
+			&testing->mctp[i]);
+		CuAssertIntEquals (test, i, status);
+	}
+}
+
+/**
+ * Release the test components and validate all mocks.
+ *
+ * @param test The test framework.
+ * @param testing The testing components to release.
+ */
+static void attestation_scheduler_testing_release (CuTest *test,
+	struct attestation_scheduler_testing *testing)
+{
+	int status;
+	int i;
+
+	attestation_scheduler_release (&testing->scheduler);
+
+	for (i = 0; i < ATTESTATION_SCHEDULER_TESTING_BUSES; i++) {
+		status = cmd_channel_mock_validate_and_release (&testing->channel[i]);
+		CuAssertIntEquals (test, 0, status);
+
+		mctp_interface_deinit (&testing->mctp[i]);
+	}
+
+	status = cmd_interface_mock_validate_and_release (&testing->cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	device_manager_release (&testing->device_mgr);
+}
+
+/**
+ * Set up the expectations for sending a Get Digests request to a device.
+ *
+ * @param test The test framework.
+ * @param testing The testing components.
+ * @param bus The bus the request will be sent on.
+ * @param device_num The device the request will be sent to.
+ * @param result The result of sending the packet.
+ */
+static void attestation_scheduler_testing_expect_request (CuTest *test,
+	struct attestation_scheduler_testing *testing, int bus, int device_num, int result)
+{
+	uint8_t request[5] = {MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x14, 0x13, 0x01, 0x81};
+	struct cmd_packet expected;
+	uint8_t msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	int status;
+
+	memset (&expected, 0, sizeof (expected));
+
+	status = mctp_protocol_construct (request, sizeof (request), expected.data,
+		sizeof (expected.data), ATTESTATION_SCHEDULER_TESTING_ADDR,
+		ATTESTATION_SCHEDULER_TESTING_EID (device_num), MCTP_PROTOCOL_PA_ROT_CTRL_EID, true, true,
+		0, testing->msg_tag[bus], MCTP_PROTOCOL_TO_REQUEST,
+		ATTESTATION_SCHEDULER_TESTING_DEV_ADDR (device_num), &msg_type);
+	CuAssertTrue (test, !ROT_IS_ERROR (status));
+
+	expected.pkt_size = status;
+	expected.dest_addr = ATTESTATION_SCHEDULER_TESTING_DEV_ADDR (device_num);
+	expected.state = CMD_VALID_PACKET;
+
+	testing->msg_tag[bus] = (testing->msg_tag[bus] + 1) % 8;
+
+	status = mock_expect (&testing->cmd.mock, testing->cmd.base.issue_request, &testing->cmd,
+		sizeof (request), MOCK_ARG (CERBERUS_PROTOCOL_GET_DIGEST), MOCK_ARG (NULL),
+		MOCK_ARG_NOT_NULL, MOCK_ARG_ANY);
+	status |= mock_expect_output_tmp (&testing->cmd.mock, 2, request, sizeof (request), -1);
+
+	status |= mock_expect (&testing->channel[bus].mock, testing->channel[bus].base.send_packet,
+		&testing->channel[bus], result,
+		MOCK_ARG_VALIDATOR_TMP (cmd_channel_mock_validate_packet, &expected, sizeof (expected)));
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Validate the mocks for all buses and reset the expectations.
+ *
+ * @param test The test framework.
+ * @param testing The testing components.
+ */
+static void attestation_scheduler_testing_validate (CuTest *test,
+	struct attestation_scheduler_testing *testing)
+{
+	int status;
+	int i;
+
+	status = mock_validate (&testing->cmd.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < ATTESTATION_SCHEDULER_TESTING_BUSES; i++) {
+		status = mock_validate (&testing->channel[i].mock);
+		CuAssertIntEquals (test, 0, status);
+	}
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void attestation_scheduler_test_init (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_dependencies (test, &testing);
+
+	status = attestation_scheduler_init (&testing.scheduler, &testing.device_mgr, 2, 1000);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, testing.scheduler.num_buses);
+	CuAssertIntEquals (test, 0, testing.scheduler.num_devices);
+	CuAssertIntEquals (test, 2, testing.scheduler.max_outstanding);
+	CuAssertIntEquals (test, 1000, testing.scheduler.period_ms);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_init_null (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_dependencies (test, &testing);
+
+	status = attestation_scheduler_init (NULL, &testing.device_mgr, 2, 1000);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = attestation_scheduler_init (&testing.scheduler, NULL, 2, 1000);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = attestation_scheduler_init (&testing.scheduler, &testing.device_mgr, 0, 1000);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = attestation_scheduler_init (&testing.scheduler, &testing.device_mgr, 2, 1000);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	attestation_scheduler_release (NULL);
+}
+
+static void attestation_scheduler_test_add_bus (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_dependencies (test, &testing);
+
+	status = attestation_scheduler_init (&testing.scheduler, &testing.device_mgr, 2, 1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_add_bus (&testing.scheduler, &testing.channel[0].base,
+		&testing.mctp[0]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_add_bus (&testing.scheduler, &testing.channel[1].base,
+		&testing.mctp[1]);
+	CuAssertIntEquals (test, 1, status);
+
+	CuAssertIntEquals (test, 2, testing.scheduler.num_buses);
+	CuAssertPtrEquals (test, &testing.channel[0].base, testing.scheduler.bus[0].channel);
+	CuAssertPtrEquals (test, &testing.mctp[0], testing.scheduler.bus[0].mctp);
+	CuAssertIntEquals (test, false, testing.scheduler.bus[0].active);
+	CuAssertPtrEquals (test, &testing.channel[1].base, testing.scheduler.bus[1].channel);
+	CuAssertPtrEquals (test, &testing.mctp[1], testing.scheduler.bus[1].mctp);
+	CuAssertIntEquals (test, false, testing.scheduler.bus[1].active);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_add_bus_null (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_dependencies (test, &testing);
+
+	status = attestation_scheduler_init (&testing.scheduler, &testing.device_mgr, 2, 1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_add_bus (NULL, &testing.channel[0].base, &testing.mctp[0]);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = attestation_scheduler_add_bus (&testing.scheduler, NULL, &testing.mctp[0]);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = attestation_scheduler_add_bus (&testing.scheduler, &testing.channel[0].base, NULL);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	CuAssertIntEquals (test, 0, testing.scheduler.num_buses);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_add_bus_full (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+	int i;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init_dependencies (test, &testing);
+
+	status = attestation_scheduler_init (&testing.scheduler, &testing.device_mgr, 2, 1000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < ATTESTATION_SCHEDULER_MAX_BUSES; i++) {
+		status = attestation_scheduler_add_bus (&testing.scheduler, &testing.channel[0].base,
+			&testing.mctp[0]);
+		CuAssertIntEquals (test, i, status);
+	}
+
+	status = attestation_scheduler_add_bus (&testing.scheduler, &testing.channel[1].base,
+		&testing.mctp[1]);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_FULL, status);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_add_device (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 2);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 2, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 2, testing.scheduler.num_devices);
+
+	status = attestation_scheduler_get_device_status (&testing.scheduler, 1);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_NOT_ATTESTED, status);
+
+	status = attestation_scheduler_get_device_status (&testing.scheduler, 2);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_NOT_ATTESTED, status);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_add_device_null (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 2);
+
+	status = attestation_scheduler_add_device (NULL, 1, 0);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, -1);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+
+	CuAssertIntEquals (test, 0, testing.scheduler.num_devices);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_add_device_unknown_bus (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 2);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1,
+		ATTESTATION_SCHEDULER_TESTING_BUSES);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_UNKNOWN_BUS, status);
+
+	CuAssertIntEquals (test, 0, testing.scheduler.num_devices);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_add_device_unknown_device (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 2);
+
+	status = attestation_scheduler_add_device (&testing.scheduler,
+		ATTESTATION_SCHEDULER_TESTING_DEVICES, 0);
+	CuAssertIntEquals (test, DEVICE_MGR_UNKNOWN_DEVICE, status);
+
+	CuAssertIntEquals (test, 0, testing.scheduler.num_devices);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_add_device_duplicate (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 2);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 1);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_DUPLICATE_DEVICE, status);
+
+	CuAssertIntEquals (test, 1, testing.scheduler.num_devices);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_poll_no_devices (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 2);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_TESTING_PERIOD, status);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_poll_multiple_buses (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 2);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 2, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 1, 0);
+	attestation_scheduler_testing_expect_request (test, &testing, 1, 2, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status > 0) && (status <= 10));
+
+	CuAssertIntEquals (test, 2, testing.scheduler.outstanding);
+	CuAssertIntEquals (test, true, testing.scheduler.bus[0].active);
+	CuAssertIntEquals (test, true, testing.scheduler.bus[1].active);
+
+	/* Nothing new should be started while the exchanges are active. */
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status >= 0) && (status <= 10));
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_poll_multiple_devices_same_bus (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 4);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 2, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Only one exchange can be active on a bus, even when the scheduler limit allows more. */
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 1, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status >= 0) && (status <= 10));
+
+	CuAssertIntEquals (test, 1, testing.scheduler.outstanding);
+	CuAssertIntEquals (test, true, testing.scheduler.bus[0].active);
+	CuAssertIntEquals (test, false, testing.scheduler.bus[1].active);
+	CuAssertIntEquals (test, true, testing.scheduler.device[0].active);
+	CuAssertIntEquals (test, false, testing.scheduler.device[1].active);
+
+	attestation_scheduler_testing_validate (test, &testing);
+
+	status = attestation_scheduler_response_received (&testing.scheduler,
+		ATTESTATION_SCHEDULER_TESTING_EID (1), CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, testing.scheduler.bus[0].active);
+
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 2, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status > 0) && (status <= 10));
+
+	CuAssertIntEquals (test, 1, testing.scheduler.outstanding);
+	CuAssertIntEquals (test, true, testing.scheduler.bus[0].active);
+	CuAssertIntEquals (test, true, testing.scheduler.device[1].active);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_poll_bus_limit (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 4);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 2, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 3, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 1, 0);
+	attestation_scheduler_testing_expect_request (test, &testing, 1, 3, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status >= 0) && (status <= 10));
+
+	CuAssertIntEquals (test, 2, testing.scheduler.outstanding);
+	CuAssertIntEquals (test, true, testing.scheduler.bus[0].active);
+	CuAssertIntEquals (test, true, testing.scheduler.bus[1].active);
+
+	attestation_scheduler_testing_validate (test, &testing);
+
+	status = attestation_scheduler_response_received (&testing.scheduler,
+		ATTESTATION_SCHEDULER_TESTING_EID (1), CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 2, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status >= 0) && (status <= 10));
+
+	CuAssertIntEquals (test, 2, testing.scheduler.outstanding);
+	CuAssertIntEquals (test, true, testing.scheduler.bus[0].active);
+	CuAssertIntEquals (test, true, testing.scheduler.bus[1].active);
+
+	status = attestation_scheduler_get_device_status (&testing.scheduler, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_poll_scheduler_limit (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 1);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 2, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 1, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status >= 0) && (status <= 10));
+
+	CuAssertIntEquals (test, 1, testing.scheduler.outstanding);
+	CuAssertIntEquals (test, true, testing.scheduler.bus[0].active);
+	CuAssertIntEquals (test, false, testing.scheduler.bus[1].active);
+
+	attestation_scheduler_testing_validate (test, &testing);
+
+	status = attestation_scheduler_response_received (&testing.scheduler,
+		ATTESTATION_SCHEDULER_TESTING_EID (1), CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_scheduler_testing_expect_request (test, &testing, 1, 2, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status > 0) && (status <= 10));
+
+	CuAssertIntEquals (test, 1, testing.scheduler.outstanding);
+	CuAssertIntEquals (test, false, testing.scheduler.bus[0].active);
+	CuAssertIntEquals (test, true, testing.scheduler.bus[1].active);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_poll_round_robin (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 1);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 2, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 1, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status >= 0) && (status <= 10));
+
+	attestation_scheduler_testing_validate (test, &testing);
+
+	status = attestation_scheduler_response_received (&testing.scheduler,
+		ATTESTATION_SCHEDULER_TESTING_EID (1), CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_attest_all (&testing.scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Both devices are due, but the device that was waiting should be attested first. */
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 2, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status >= 0) && (status <= 10));
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_poll_timeout_retry (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 2);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 1, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status > 0) && (status <= 10));
+
+	attestation_scheduler_testing_validate (test, &testing);
+
+	platform_msleep (20);
+
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 1, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status > 0) && (status <= 10));
+
+	CuAssertIntEquals (test, 1, testing.scheduler.outstanding);
+	CuAssertIntEquals (test, 1, testing.scheduler.device[0].retries);
+
+	status = attestation_scheduler_get_device_status (&testing.scheduler, 1);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_NOT_ATTESTED, status);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_poll_timeout_retries_exhausted (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+	int i;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 2);
+
+	status = device_manager_update_device_state (&testing.device_mgr, 1,
+		DEVICE_MANAGER_AUTHENTICATED);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 1, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status > 0) && (status <= 10));
+
+	for (i = 0; i < ATTESTATION_SCHEDULER_MAX_RETRIES; i++) {
+		attestation_scheduler_testing_validate (test, &testing);
+
+		platform_msleep (20);
+
+		attestation_scheduler_testing_expect_request (test, &testing, 0, 1, 0);
+
+		status = attestation_scheduler_poll (&testing.scheduler);
+		CuAssertTrue (test, (status > 0) && (status <= 10));
+	}
+
+	attestation_scheduler_testing_validate (test, &testing);
+
+	platform_msleep (20);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, status > 10);
+
+	CuAssertIntEquals (test, 0, testing.scheduler.outstanding);
+	CuAssertIntEquals (test, false, testing.scheduler.bus[0].active);
+
+	status = attestation_scheduler_get_device_status (&testing.scheduler, 1);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_TIMEOUT, status);
+
+	status = device_manager_get_device_state (&testing.device_mgr, 1);
+	CuAssertIntEquals (test, DEVICE_MANAGER_AVAILABLE, status);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_poll_send_error (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 2);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 1, CMD_CHANNEL_TX_FAILED);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, testing.scheduler.outstanding);
+	CuAssertIntEquals (test, false, testing.scheduler.bus[0].active);
+	CuAssertIntEquals (test, 1, testing.scheduler.device[0].retries);
+	CuAssertIntEquals (test, 1, testing.channel[0].base.stats.tx_errors);
+
+	attestation_scheduler_testing_validate (test, &testing);
+
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 1, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status > 0) && (status <= 10));
+
+	CuAssertIntEquals (test, 1, testing.scheduler.outstanding);
+	CuAssertIntEquals (test, 1, testing.channel[0].base.stats.tx_packets);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_poll_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = attestation_scheduler_poll (NULL);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+}
+
+static void attestation_scheduler_test_response_received_exchange_progress (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 2);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 1, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status > 0) && (status <= 10));
+
+	attestation_scheduler_testing_validate (test, &testing);
+
+	status = attestation_scheduler_response_received (&testing.scheduler,
+		ATTESTATION_SCHEDULER_TESTING_EID (1), CERBERUS_PROTOCOL_GET_DIGEST, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_response_received (&testing.scheduler,
+		ATTESTATION_SCHEDULER_TESTING_EID (1), CERBERUS_PROTOCOL_GET_CERTIFICATE, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The response timeout has passed, but the crypto timeout has not. */
+	platform_msleep (20);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status > 10) && (status <= 100));
+
+	CuAssertIntEquals (test, 1, testing.scheduler.outstanding);
+	CuAssertIntEquals (test, 0, testing.scheduler.device[0].retries);
+
+	status = attestation_scheduler_response_received (&testing.scheduler,
+		ATTESTATION_SCHEDULER_TESTING_EID (1), CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, testing.scheduler.outstanding);
+
+	status = attestation_scheduler_get_device_status (&testing.scheduler, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, status > 100);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_response_received_failure (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 2);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 1, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status > 0) && (status <= 10));
+
+	attestation_scheduler_testing_validate (test, &testing);
+
+	status = attestation_scheduler_response_received (&testing.scheduler,
+		ATTESTATION_SCHEDULER_TESTING_EID (1), CERBERUS_PROTOCOL_GET_CERTIFICATE,
+		CMD_HANDLER_BAD_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, testing.scheduler.outstanding);
+	CuAssertIntEquals (test, 1, testing.scheduler.device[0].retries);
+
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 1, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status > 0) && (status <= 10));
+
+	status = attestation_scheduler_get_device_status (&testing.scheduler, 1);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_NOT_ATTESTED, status);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_response_received_late (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 2);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_response_received (&testing.scheduler,
+		ATTESTATION_SCHEDULER_TESTING_EID (1), CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, testing.scheduler.outstanding);
+
+	status = attestation_scheduler_get_device_status (&testing.scheduler, 1);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_NOT_ATTESTED, status);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_response_received_other_command (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 2);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 1, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status > 0) && (status <= 10));
+
+	status = attestation_scheduler_response_received (&testing.scheduler,
+		ATTESTATION_SCHEDULER_TESTING_EID (1), CERBERUS_PROTOCOL_GET_DEVICE_CAPABILITIES,
+		CMD_HANDLER_BAD_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, testing.scheduler.outstanding);
+	CuAssertIntEquals (test, 0, testing.scheduler.device[0].retries);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_response_received_unknown_device (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 2);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_response_received (&testing.scheduler,
+		ATTESTATION_SCHEDULER_TESTING_EID (2), CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_UNKNOWN_DEVICE, status);
+
+	status = attestation_scheduler_response_received (&testing.scheduler, 0x7f,
+		CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0);
+	CuAssertIntEquals (test, DEVICE_MGR_UNKNOWN_DEVICE, status);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_response_received_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = attestation_scheduler_response_received (NULL, ATTESTATION_SCHEDULER_TESTING_EID (1),
+		CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+}
+
+static void attestation_scheduler_test_attest_all (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 2);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 2, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 1, 0);
+	attestation_scheduler_testing_expect_request (test, &testing, 1, 2, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status > 0) && (status <= 10));
+
+	attestation_scheduler_testing_validate (test, &testing);
+
+	status = attestation_scheduler_response_received (&testing.scheduler,
+		ATTESTATION_SCHEDULER_TESTING_EID (1), CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_attest_all (&testing.scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Only the device that is not already being attested will be started. */
+	attestation_scheduler_testing_expect_request (test, &testing, 0, 1, 0);
+
+	status = attestation_scheduler_poll (&testing.scheduler);
+	CuAssertTrue (test, (status > 0) && (status <= 10));
+
+	CuAssertIntEquals (test, 2, testing.scheduler.outstanding);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_attest_all_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = attestation_scheduler_attest_all (NULL);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+}
+
+static void attestation_scheduler_test_get_device_status_unknown_device (CuTest *test)
+{
+	struct attestation_scheduler_testing testing;
+	int status;
+
+	TEST_START;
+
+	attestation_scheduler_testing_init (test, &testing, 2);
+
+	status = attestation_scheduler_add_device (&testing.scheduler, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_scheduler_get_device_status (&testing.scheduler, 2);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_UNKNOWN_DEVICE, status);
+
+	attestation_scheduler_testing_release (test, &testing);
+}
+
+static void attestation_scheduler_test_get_device_status_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = attestation_scheduler_get_device_status (NULL, 1);
+	CuAssertIntEquals (test, ATTESTATION_SCHEDULER_INVALID_ARGUMENT, status);
+}
+
+
+CuSuite* get_attestation_scheduler_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_init);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_init_null);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_release_null);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_add_bus);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_add_bus_null);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_add_bus_full);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_add_device);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_add_device_null);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_add_device_unknown_bus);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_add_device_unknown_device);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_add_device_duplicate);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_poll_no_devices);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_poll_multiple_buses);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_poll_multiple_devices_same_bus);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_poll_bus_limit);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_poll_scheduler_limit);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_poll_round_robin);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_poll_timeout_retry);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_poll_timeout_retries_exhausted);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_poll_send_error);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_poll_null);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_response_received_exchange_progress);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_response_received_failure);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_response_received_late);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_response_received_other_command);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_response_received_unknown_device);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_response_received_null);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_attest_all);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_attest_all_null);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_get_device_status_unknown_device);
+	SUITE_ADD_TEST (suite, attestation_scheduler_test_get_device_status_null);
+
+	return suite;
+}
@@ -73,6 +73,9 @@ static void attestation_slave_testing_init_dependencies (CuTest *test,
 	status = hash_mock_init (&attestation->hash);
 	CuAssertIntEquals (test, 0, status);
 
+	/* Hash certificates individually unless a test specifically needs multi-buffer hashing. */
+	attestation->hash.base.calculate_sha256_multi = NULL;
+
 	status = ecc_mock_init (&attestation->ecc);
 	CuAssertIntEquals (test, 0, status);
 
@@ -1133,33 +1136,544 @@ static void attestation_slave_test_get_digests_aux_slot_no_dev_id (CuTest *test)
 		&attestation.ecc.base, &attestation.rng.base, &attestation.store, &attestation.aux);
 	CuAssertIntEquals (test, 0, status);
 
-	status = attestation.slave.get_digests (&attestation.slave, 1, buf, sizeof (buf), &num_cert);
-	CuAssertIntEquals (test, ATTESTATION_CERT_NOT_AVAILABLE, status);
+	status = attestation.slave.get_digests (&attestation.slave, 1, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, ATTESTATION_CERT_NOT_AVAILABLE, status);
+
+	complete_attestation_slave_mock_test (test, &attestation);
+}
+
+static void attestation_slave_test_get_digests_aux_slot_no_aux_cert (CuTest *test)
+{
+	int status;
+	struct attestation_slave_testing attestation;
+	uint8_t buf[32 * 4] = {0};
+	uint8_t num_cert = 1;
+
+	TEST_START;
+
+	setup_attestation_slave_mock_test (test, &attestation);
+
+	attestation_testing_add_int_ca_to_riot_key_manager (test, &attestation.riot,
+		&attestation.keystore, &attestation.x509);
+
+	status = attestation.slave.get_digests (&attestation.slave, 1, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, ATTESTATION_CERT_NOT_AVAILABLE, status);
+
+	complete_attestation_slave_mock_test (test, &attestation);
+}
+
+static void attestation_slave_test_get_digests_devid_fail (CuTest *test)
+{
+	int status;
+	struct attestation_slave_testing attestation;
+	uint8_t buf[32 * 4] = {0};
+	uint8_t num_cert = 0;
+
+	TEST_START;
+
+	setup_attestation_slave_mock_test (test, &attestation);
+
+	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, HASH_ENGINE_SHA256_FAILED,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+
+	complete_attestation_slave_mock_test (test, &attestation);
+}
+
+static void attestation_slave_test_get_digests_alias_fail (CuTest *test)
+{
+	int status;
+	struct attestation_slave_testing attestation;
+	uint8_t buf[32 * 4] = {0};
+	uint8_t num_cert = 0;
+
+	TEST_START;
+
+	setup_attestation_slave_mock_test (test, &attestation);
+
+	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, HASH_ENGINE_SHA256_FAILED,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT, RIOT_CORE_ALIAS_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+
+	complete_attestation_slave_mock_test (test, &attestation);
+}
+
+static void attestation_slave_test_get_digests_aux_fail (CuTest *test)
+{
+	int status;
+	struct attestation_slave_testing attestation;
+	uint8_t buf[32 * 4] = {0};
+	uint8_t num_cert = 0;
+
+	TEST_START;
+
+	setup_attestation_slave_mock_test (test, &attestation);
+
+	attestation_testing_add_aux_certificate (test, &attestation.aux);
+
+	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, HASH_ENGINE_SHA256_FAILED,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTCA_RSA_EE_DER, X509_CERTCA_RSA_EE_DER_LEN),
+		MOCK_ARG (X509_CERTCA_RSA_EE_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.slave.get_digests (&attestation.slave, 1, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+
+	complete_attestation_slave_mock_test (test, &attestation);
+}
+
+static void attestation_slave_test_get_digests_int_ca_fail (CuTest *test)
+{
+	int status;
+	struct attestation_slave_testing attestation;
+	uint8_t buf[32 * 4] = {0};
+	uint8_t num_cert = 0;
+
+	TEST_START;
+
+	setup_attestation_slave_mock_test (test, &attestation);
+
+	attestation_testing_add_int_ca_to_riot_key_manager (test, &attestation.riot,
+		&attestation.keystore, &attestation.x509);
+
+	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_RSA_CA_NOPL_DER, X509_CERTSS_RSA_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTSS_RSA_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, HASH_ENGINE_SHA256_FAILED,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTCA_ECC_CA_NOPL_DER, X509_CERTCA_ECC_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTCA_ECC_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+
+	complete_attestation_slave_mock_test (test, &attestation);
+}
+
+static void attestation_slave_test_get_digests_root_ca_fail (CuTest *test)
+{
+	int status;
+	struct attestation_slave_testing attestation;
+	uint8_t buf[32 * 4] = {0};
+	uint8_t num_cert = 0;
+
+	TEST_START;
+
+	setup_attestation_slave_mock_test (test, &attestation);
+
+	attestation_testing_add_int_ca_to_riot_key_manager (test, &attestation.riot,
+		&attestation.keystore, &attestation.x509);
+
+	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, HASH_ENGINE_SHA256_FAILED,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_RSA_CA_NOPL_DER, X509_CERTSS_RSA_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTSS_RSA_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+
+	complete_attestation_slave_mock_test (test, &attestation);
+}
+
+static void attestation_slave_test_get_digests_cached (CuTest *test)
+{
+	int status;
+	struct attestation_slave_testing attestation;
+	uint8_t buf[32 * 4] = {0};
+	uint8_t cert_hash[] = {
+		0x00,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x01,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x02,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x03,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f
+	};
+	uint8_t num_cert = 0;
+
+	TEST_START;
+
+	setup_attestation_slave_mock_test (test, &attestation);
+
+	attestation_testing_add_int_ca_to_riot_key_manager (test, &attestation.riot,
+		&attestation.keystore, &attestation.x509);
+
+	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_RSA_CA_NOPL_DER, X509_CERTSS_RSA_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTSS_RSA_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[0], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTCA_ECC_CA_NOPL_DER, X509_CERTCA_ECC_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTCA_ECC_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[32], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_INTR_SIGNED_CERT,
+			RIOT_CORE_DEVID_INTR_SIGNED_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_INTR_SIGNED_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[64], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT, RIOT_CORE_ALIAS_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[96], 32, -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, sizeof (cert_hash), status);
+	CuAssertIntEquals (test, 4, num_cert);
+
+	status = testing_validate_array (cert_hash, buf, sizeof (cert_hash));
+	CuAssertIntEquals (test, 0, status);
+
+	memset (buf, 0, sizeof (buf));
+	num_cert = 0;
+
+	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, sizeof (cert_hash), status);
+	CuAssertIntEquals (test, 4, num_cert);
+
+	status = testing_validate_array (cert_hash, buf, sizeof (cert_hash));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_attestation_slave_mock_test (test, &attestation);
+}
+
+static void attestation_slave_test_get_digests_aux_slot_cached_chain (CuTest *test)
+{
+	int status;
+	struct attestation_slave_testing attestation;
+	uint8_t buf[32 * 4] = {0};
+	uint8_t cert_hash[] = {
+		0x00,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x01,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x02,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x03,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f
+	};
+	uint8_t num_cert = 0;
+
+	TEST_START;
+
+	setup_attestation_slave_mock_test (test, &attestation);
+
+	attestation_testing_add_int_ca_to_riot_key_manager (test, &attestation.riot,
+		&attestation.keystore, &attestation.x509);
+	attestation_testing_add_aux_certificate (test, &attestation.aux);
+
+	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_RSA_CA_NOPL_DER, X509_CERTSS_RSA_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTSS_RSA_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[0], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTCA_ECC_CA_NOPL_DER, X509_CERTCA_ECC_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTCA_ECC_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[32], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_INTR_SIGNED_CERT,
+			RIOT_CORE_DEVID_INTR_SIGNED_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_INTR_SIGNED_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[64], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT, RIOT_CORE_ALIAS_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[96], 32, -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, sizeof (cert_hash), status);
+	CuAssertIntEquals (test, 4, num_cert);
+
+	status = testing_validate_array (cert_hash, buf, sizeof (cert_hash));
+	CuAssertIntEquals (test, 0, status);
+
+	memset (buf, 0, sizeof (buf));
+	num_cert = 0;
+
+	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTCA_RSA_EE_DER, X509_CERTCA_RSA_EE_DER_LEN),
+		MOCK_ARG (X509_CERTCA_RSA_EE_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[96], 32, -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.slave.get_digests (&attestation.slave, 1, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, sizeof (cert_hash), status);
+	CuAssertIntEquals (test, 4, num_cert);
+
+	status = testing_validate_array (cert_hash, buf, sizeof (cert_hash));
+	CuAssertIntEquals (test, 0, status);
+
+	memset (buf, 0, sizeof (buf));
+	num_cert = 0;
+
+	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTCA_RSA_EE_DER, X509_CERTCA_RSA_EE_DER_LEN),
+		MOCK_ARG (X509_CERTCA_RSA_EE_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[96], 32, -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.slave.get_digests (&attestation.slave, 1, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, sizeof (cert_hash), status);
+	CuAssertIntEquals (test, 4, num_cert);
+
+	status = testing_validate_array (cert_hash, buf, sizeof (cert_hash));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_attestation_slave_mock_test (test, &attestation);
+}
+
+static void attestation_slave_test_get_digests_cert_chain_changed (CuTest *test)
+{
+	int status;
+	struct attestation_slave_testing attestation;
+	uint8_t buf[32 * 4] = {0};
+	uint8_t cert_hash[] = {
+		0x00,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x01,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x02,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x03,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f
+	};
+	uint8_t num_cert = 0;
+
+	TEST_START;
+
+	setup_attestation_slave_mock_test (test, &attestation);
+
+	attestation_testing_add_int_ca_to_riot_key_manager (test, &attestation.riot,
+		&attestation.keystore, &attestation.x509);
+
+	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_RSA_CA_NOPL_DER, X509_CERTSS_RSA_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTSS_RSA_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[0], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTCA_ECC_CA_NOPL_DER, X509_CERTCA_ECC_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTCA_ECC_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[32], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_INTR_SIGNED_CERT,
+			RIOT_CORE_DEVID_INTR_SIGNED_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_INTR_SIGNED_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[64], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT, RIOT_CORE_ALIAS_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[96], 32, -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, sizeof (cert_hash), status);
+	CuAssertIntEquals (test, 4, num_cert);
+
+	status = testing_validate_array (cert_hash, buf, sizeof (cert_hash));
+	CuAssertIntEquals (test, 0, status);
+
+	attestation.slave.riot_observer.on_cert_chain_changed (&attestation.slave.riot_observer);
+
+	memset (buf, 0, sizeof (buf));
+	num_cert = 0;
+
+	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_RSA_CA_NOPL_DER, X509_CERTSS_RSA_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTSS_RSA_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[0], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTCA_ECC_CA_NOPL_DER, X509_CERTCA_ECC_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTCA_ECC_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[32], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_INTR_SIGNED_CERT,
+			RIOT_CORE_DEVID_INTR_SIGNED_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_INTR_SIGNED_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[64], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT, RIOT_CORE_ALIAS_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[96], 32, -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, sizeof (cert_hash), status);
+	CuAssertIntEquals (test, 4, num_cert);
+
+	status = testing_validate_array (cert_hash, buf, sizeof (cert_hash));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_attestation_slave_mock_test (test, &attestation);
+}
+
+static void attestation_slave_test_get_digests_hash_error_not_cached (CuTest *test)
+{
+	int status;
+	struct attestation_slave_testing attestation;
+	uint8_t buf[32 * 4] = {0};
+	uint8_t cert_hash[] = {
+		0x00,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x01,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x02,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x03,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f
+	};
+	uint8_t num_cert = 0;
+
+	TEST_START;
+
+	setup_attestation_slave_mock_test (test, &attestation);
+
+	attestation_testing_add_int_ca_to_riot_key_manager (test, &attestation.riot,
+		&attestation.keystore, &attestation.x509);
+
+	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_RSA_CA_NOPL_DER, X509_CERTSS_RSA_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTSS_RSA_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[0], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, HASH_ENGINE_SHA256_FAILED,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTCA_ECC_CA_NOPL_DER, X509_CERTCA_ECC_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTCA_ECC_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+
+	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_RSA_CA_NOPL_DER, X509_CERTSS_RSA_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTSS_RSA_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[0], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTCA_ECC_CA_NOPL_DER, X509_CERTCA_ECC_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTCA_ECC_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[32], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_INTR_SIGNED_CERT,
+			RIOT_CORE_DEVID_INTR_SIGNED_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_INTR_SIGNED_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[64], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT, RIOT_CORE_ALIAS_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[96], 32, -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, sizeof (cert_hash), status);
+	CuAssertIntEquals (test, 4, num_cert);
+
+	status = testing_validate_array (cert_hash, buf, sizeof (cert_hash));
+	CuAssertIntEquals (test, 0, status);
 
 	complete_attestation_slave_mock_test (test, &attestation);
 }
 
-static void attestation_slave_test_get_digests_aux_slot_no_aux_cert (CuTest *test)
+static void attestation_slave_test_get_digests_null (CuTest *test)
 {
 	int status;
 	struct attestation_slave_testing attestation;
 	uint8_t buf[32 * 4] = {0};
-	uint8_t num_cert = 1;
+	uint8_t num_cert = 0;
 
 	TEST_START;
 
 	setup_attestation_slave_mock_test (test, &attestation);
 
-	attestation_testing_add_int_ca_to_riot_key_manager (test, &attestation.riot,
-		&attestation.keystore, &attestation.x509);
+	status = attestation.slave.get_digests (NULL, 0, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, ATTESTATION_INVALID_ARGUMENT, status);
 
-	status = attestation.slave.get_digests (&attestation.slave, 1, buf, sizeof (buf), &num_cert);
-	CuAssertIntEquals (test, ATTESTATION_CERT_NOT_AVAILABLE, status);
+	status = attestation.slave.get_digests (&attestation.slave, 0, NULL, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, ATTESTATION_INVALID_ARGUMENT, status);
+
+	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), NULL);
+	CuAssertIntEquals (test, ATTESTATION_INVALID_ARGUMENT, status);
 
 	complete_attestation_slave_mock_test (test, &attestation);
 }
 
-static void attestation_slave_test_get_digests_devid_fail (CuTest *test)
+static void attestation_slave_test_get_digests_invalid_slot_num (CuTest *test)
 {
 	int status;
 	struct attestation_slave_testing attestation;
@@ -1170,82 +1684,166 @@ static void attestation_slave_test_get_digests_devid_fail (CuTest *test)
 
 	setup_attestation_slave_mock_test (test, &attestation);
 
-	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
-		&attestation.hash, HASH_ENGINE_SHA256_FAILED,
-		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
-		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
-	CuAssertIntEquals (test, 0, status);
-
-	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
-	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+	status = attestation.slave.get_digests (&attestation.slave, 2, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, ATTESTATION_INVALID_SLOT_NUM, status);
 
 	complete_attestation_slave_mock_test (test, &attestation);
 }
 
-static void attestation_slave_test_get_digests_alias_fail (CuTest *test)
+static void attestation_slave_test_get_digests_dedicated_hash_engine (CuTest *test)
 {
 	int status;
 	struct attestation_slave_testing attestation;
+	struct hash_engine_mock digest_hash;
 	uint8_t buf[32 * 4] = {0};
+	uint8_t cert_hash[] = {
+		0x00,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x01,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x02,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x03,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f
+	};
 	uint8_t num_cert = 0;
 
 	TEST_START;
 
 	setup_attestation_slave_mock_test (test, &attestation);
 
-	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
-		&attestation.hash, 0,
-		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
-		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status = hash_mock_init (&digest_hash);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
-		&attestation.hash, HASH_ENGINE_SHA256_FAILED,
+	digest_hash.base.calculate_sha256_multi = NULL;
+
+	status = attestation_slave_set_digest_hash_engine (&attestation.slave, &digest_hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_testing_add_int_ca_to_riot_key_manager (test, &attestation.riot,
+		&attestation.keystore, &attestation.x509);
+
+	status = mock_expect (&digest_hash.mock, digest_hash.base.calculate_sha256, &digest_hash, 0,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_RSA_CA_NOPL_DER, X509_CERTSS_RSA_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTSS_RSA_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&digest_hash.mock, 2, &cert_hash[0], 32, -1);
+
+	status |= mock_expect (&digest_hash.mock, digest_hash.base.calculate_sha256, &digest_hash, 0,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTCA_ECC_CA_NOPL_DER, X509_CERTCA_ECC_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTCA_ECC_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&digest_hash.mock, 2, &cert_hash[32], 32, -1);
+
+	status |= mock_expect (&digest_hash.mock, digest_hash.base.calculate_sha256, &digest_hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_INTR_SIGNED_CERT,
+			RIOT_CORE_DEVID_INTR_SIGNED_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_INTR_SIGNED_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&digest_hash.mock, 2, &cert_hash[64], 32, -1);
+
+	status |= mock_expect (&digest_hash.mock, digest_hash.base.calculate_sha256, &digest_hash, 0,
 		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT, RIOT_CORE_ALIAS_CERT_LEN),
 		MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&digest_hash.mock, 2, &cert_hash[96], 32, -1);
 
 	CuAssertIntEquals (test, 0, status);
 
+	/* Digests calculated with a dedicated engine don't need the signing lock. */
+	platform_mutex_lock (&attestation.slave.lock);
+
 	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
-	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+
+	platform_mutex_unlock (&attestation.slave.lock);
+
+	CuAssertIntEquals (test, sizeof (cert_hash), status);
+	CuAssertIntEquals (test, 4, num_cert);
+
+	status = testing_validate_array (cert_hash, buf, sizeof (cert_hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&digest_hash);
+	CuAssertIntEquals (test, 0, status);
 
 	complete_attestation_slave_mock_test (test, &attestation);
 }
 
-static void attestation_slave_test_get_digests_aux_fail (CuTest *test)
+static void attestation_slave_test_get_digests_cached_signing_lock_held (CuTest *test)
 {
 	int status;
 	struct attestation_slave_testing attestation;
 	uint8_t buf[32 * 4] = {0};
+	uint8_t cert_hash[] = {
+		0x00,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x01,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x02,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,
+		0x03,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f
+	};
 	uint8_t num_cert = 0;
 
 	TEST_START;
 
 	setup_attestation_slave_mock_test (test, &attestation);
 
-	attestation_testing_add_aux_certificate (test, &attestation.aux);
+	attestation_testing_add_int_ca_to_riot_key_manager (test, &attestation.riot,
+		&attestation.keystore, &attestation.x509);
 
 	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
 		&attestation.hash, 0,
-		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_CERT, RIOT_CORE_DEVID_CERT_LEN),
-		MOCK_ARG (RIOT_CORE_DEVID_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_RSA_CA_NOPL_DER, X509_CERTSS_RSA_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTSS_RSA_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[0], 32, -1);
 
 	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
-		&attestation.hash, HASH_ENGINE_SHA256_FAILED,
-		MOCK_ARG_PTR_CONTAINS (X509_CERTCA_RSA_EE_DER, X509_CERTCA_RSA_EE_DER_LEN),
-		MOCK_ARG (X509_CERTCA_RSA_EE_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTCA_ECC_CA_NOPL_DER, X509_CERTCA_ECC_CA_NOPL_DER_LEN),
+		MOCK_ARG (X509_CERTCA_ECC_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[32], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_DEVID_INTR_SIGNED_CERT,
+			RIOT_CORE_DEVID_INTR_SIGNED_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_DEVID_INTR_SIGNED_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[64], 32, -1);
+
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
+		&attestation.hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RIOT_CORE_ALIAS_CERT, RIOT_CORE_ALIAS_CERT_LEN),
+		MOCK_ARG (RIOT_CORE_ALIAS_CERT_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status |= mock_expect_output (&attestation.hash.mock, 2, &cert_hash[96], 32, -1);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = attestation.slave.get_digests (&attestation.slave, 1, buf, sizeof (buf), &num_cert);
-	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, sizeof (cert_hash), status);
+	CuAssertIntEquals (test, 4, num_cert);
+
+	memset (buf, 0, sizeof (buf));
+	num_cert = 0;
+
+	/* Cached digests can be read while a challenge is being signed. */
+	platform_mutex_lock (&attestation.slave.lock);
+
+	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
+
+	platform_mutex_unlock (&attestation.slave.lock);
+
+	CuAssertIntEquals (test, sizeof (cert_hash), status);
+	CuAssertIntEquals (test, 4, num_cert);
+
+	status = testing_validate_array (cert_hash, buf, sizeof (cert_hash));
+	CuAssertIntEquals (test, 0, status);
 
 	complete_attestation_slave_mock_test (test, &attestation);
 }
 
-static void attestation_slave_test_get_digests_int_ca_fail (CuTest *test)
+static void attestation_slave_test_get_digests_multi_buffer_hash (CuTest *test)
 {
 	int status;
 	struct attestation_slave_testing attestation;
+	struct hash_engine_mock digest_hash;
 	uint8_t buf[32 * 4] = {0};
 	uint8_t num_cert = 0;
 
@@ -1253,31 +1851,36 @@ static void attestation_slave_test_get_digests_int_ca_fail (CuTest *test)
 
 	setup_attestation_slave_mock_test (test, &attestation);
 
-	attestation_testing_add_int_ca_to_riot_key_manager (test, &attestation.riot,
-		&attestation.keystore, &attestation.x509);
+	status = hash_mock_init (&digest_hash);
+	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
-		&attestation.hash, 0,
-		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_RSA_CA_NOPL_DER, X509_CERTSS_RSA_CA_NOPL_DER_LEN),
-		MOCK_ARG (X509_CERTSS_RSA_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	status = attestation_slave_set_digest_hash_engine (&attestation.slave, &digest_hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
-		&attestation.hash, HASH_ENGINE_SHA256_FAILED,
-		MOCK_ARG_PTR_CONTAINS (X509_CERTCA_ECC_CA_NOPL_DER, X509_CERTCA_ECC_CA_NOPL_DER_LEN),
-		MOCK_ARG (X509_CERTCA_ECC_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
+	attestation_testing_add_int_ca_to_riot_key_manager (test, &attestation.riot,
+		&attestation.keystore, &attestation.x509);
 
+	status = mock_expect (&digest_hash.mock, digest_hash.base.calculate_sha256_multi,
+		&digest_hash, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (3));
+	status |= mock_expect (&digest_hash.mock, digest_hash.base.calculate_sha256_multi,
+		&digest_hash, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (1));
 	CuAssertIntEquals (test, 0, status);
 
 	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
-	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+	CuAssertIntEquals (test, sizeof (buf), status);
+	CuAssertIntEquals (test, 4, num_cert);
+
+	status = hash_mock_validate_and_release (&digest_hash);
+	CuAssertIntEquals (test, 0, status);
 
 	complete_attestation_slave_mock_test (test, &attestation);
 }
 
-static void attestation_slave_test_get_digests_root_ca_fail (CuTest *test)
+static void attestation_slave_test_get_digests_multi_buffer_hash_error (CuTest *test)
 {
 	int status;
 	struct attestation_slave_testing attestation;
+	struct hash_engine_mock digest_hash;
 	uint8_t buf[32 * 4] = {0};
 	uint8_t num_cert = 0;
 
@@ -1285,26 +1888,33 @@ static void attestation_slave_test_get_digests_root_ca_fail (CuTest *test)
 
 	setup_attestation_slave_mock_test (test, &attestation);
 
+	status = hash_mock_init (&digest_hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_slave_set_digest_hash_engine (&attestation.slave, &digest_hash.base);
+	CuAssertIntEquals (test, 0, status);
+
 	attestation_testing_add_int_ca_to_riot_key_manager (test, &attestation.riot,
 		&attestation.keystore, &attestation.x509);
 
-	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256,
-		&attestation.hash, HASH_ENGINE_SHA256_FAILED,
-		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_RSA_CA_NOPL_DER, X509_CERTSS_RSA_CA_NOPL_DER_LEN),
-		MOCK_ARG (X509_CERTSS_RSA_CA_NOPL_DER_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (32));
-
+	status = mock_expect (&digest_hash.mock, digest_hash.base.calculate_sha256_multi,
+		&digest_hash, HASH_ENGINE_SHA256_FAILED, MOCK_ARG_NOT_NULL, MOCK_ARG (3));
 	CuAssertIntEquals (test, 0, status);
 
 	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
 	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
 
+	status = hash_mock_validate_and_release (&digest_hash);
+	CuAssertIntEquals (test, 0, status);
+
 	complete_attestation_slave_mock_test (test, &attestation);
 }
 
-static void attestation_slave_test_get_digests_null (CuTest *test)
+static void attestation_slave_test_get_digests_multi_buffer_hash_shared_engine (CuTest *test)
 {
 	int status;
 	struct attestation_slave_testing attestation;
+	struct hash_engine_mock multi_hash;
 	uint8_t buf[32 * 4] = {0};
 	uint8_t num_cert = 0;
 
@@ -1312,31 +1922,59 @@ static void attestation_slave_test_get_digests_null (CuTest *test)
 
 	setup_attestation_slave_mock_test (test, &attestation);
 
-	status = attestation.slave.get_digests (NULL, 0, buf, sizeof (buf), &num_cert);
-	CuAssertIntEquals (test, ATTESTATION_INVALID_ARGUMENT, status);
+	/* Enable multi-buffer hashing on the shared engine. */
+	status = hash_mock_init (&multi_hash);
+	CuAssertIntEquals (test, 0, status);
 
-	status = attestation.slave.get_digests (&attestation.slave, 0, NULL, sizeof (buf), &num_cert);
-	CuAssertIntEquals (test, ATTESTATION_INVALID_ARGUMENT, status);
+	attestation.hash.base.calculate_sha256_multi = multi_hash.base.calculate_sha256_multi;
 
-	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), NULL);
-	CuAssertIntEquals (test, ATTESTATION_INVALID_ARGUMENT, status);
+	status = hash_mock_validate_and_release (&multi_hash);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_testing_add_int_ca_to_riot_key_manager (test, &attestation.riot,
+		&attestation.keystore, &attestation.x509);
+
+	/* The signing lock is only held for one certificate at a time on the shared engine. */
+	status = mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256_multi,
+		&attestation.hash, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256_multi,
+		&attestation.hash, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256_multi,
+		&attestation.hash, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect (&attestation.hash.mock, attestation.hash.base.calculate_sha256_multi,
+		&attestation.hash, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation.slave.get_digests (&attestation.slave, 0, buf, sizeof (buf), &num_cert);
+	CuAssertIntEquals (test, sizeof (buf), status);
+	CuAssertIntEquals (test, 4, num_cert);
 
 	complete_attestation_slave_mock_test (test, &attestation);
 }
 
-static void attestation_slave_test_get_digests_invalid_slot_num (CuTest *test)
+static void attestation_slave_test_set_digest_hash_engine_null (CuTest *test)
 {
 	int status;
 	struct attestation_slave_testing attestation;
-	uint8_t buf[32 * 4] = {0};
-	uint8_t num_cert = 0;
+	struct hash_engine_mock digest_hash;
 
 	TEST_START;
 
 	setup_attestation_slave_mock_test (test, &attestation);
 
-	status = attestation.slave.get_digests (&attestation.slave, 2, buf, sizeof (buf), &num_cert);
-	CuAssertIntEquals (test, ATTESTATION_INVALID_SLOT_NUM, status);
+	status = hash_mock_init (&digest_hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_slave_set_digest_hash_engine (NULL, &digest_hash.base);
+	CuAssertIntEquals (test, ATTESTATION_INVALID_ARGUMENT, status);
+
+	status = attestation_slave_set_digest_hash_engine (&attestation.slave, NULL);
+	CuAssertIntEquals (test, ATTESTATION_INVALID_ARGUMENT, status);
+
+	CuAssertPtrEquals (test, &attestation.hash.base, attestation.slave.digest_hash);
+
+	status = hash_mock_validate_and_release (&digest_hash);
+	CuAssertIntEquals (test, 0, status);
 
 	complete_attestation_slave_mock_test (test, &attestation);
 }
@@ -3416,6 +4054,90 @@ static void attestation_slave_test_aux_decrypt_null (CuTest *test)
 	complete_attestation_slave_mock_test (test, &attestation);
 }
 
+static void attestation_slave_test_precompute_challenge_signatures (CuTest *test)
+{
+	int status;
+	struct attestation_slave_testing attestation;
+
+	TEST_START;
+
+	setup_attestation_slave_mock_test (test, &attestation);
+
+	status = mock_expect (&attestation.ecc.mock, attestation.ecc.base.precompute_sign,
+		&attestation.ecc, 2, MOCK_ARG_SAVED_ARG (0), MOCK_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_slave_precompute_challenge_signatures (&attestation.slave, 2);
+	CuAssertIntEquals (test, 2, status);
+
+	complete_attestation_slave_mock_test (test, &attestation);
+}
+
+static void attestation_slave_test_precompute_challenge_signatures_no_aux (CuTest *test)
+{
+	int status;
+	struct attestation_slave_testing attestation;
+
+	TEST_START;
+
+	setup_attestation_slave_no_aux_mock_test (test, &attestation);
+
+	status = mock_expect (&attestation.ecc.mock, attestation.ecc.base.precompute_sign,
+		&attestation.ecc, 1, MOCK_ARG_SAVED_ARG (0), MOCK_ARG (1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_slave_precompute_challenge_signatures (&attestation.slave, 1);
+	CuAssertIntEquals (test, 1, status);
+
+	complete_attestation_slave_mock_test (test, &attestation);
+}
+
+static void attestation_slave_test_precompute_challenge_signatures_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = attestation_slave_precompute_challenge_signatures (NULL, 1);
+	CuAssertIntEquals (test, ATTESTATION_INVALID_ARGUMENT, status);
+}
+
+static void attestation_slave_test_precompute_challenge_signatures_unsupported (CuTest *test)
+{
+	int status;
+	struct attestation_slave_testing attestation;
+
+	TEST_START;
+
+	setup_attestation_slave_mock_test (test, &attestation);
+
+	attestation.ecc.base.precompute_sign = NULL;
+
+	status = attestation_slave_precompute_challenge_signatures (&attestation.slave, 1);
+	CuAssertIntEquals (test, ATTESTATION_UNSUPPORTED_OPERATION, status);
+
+	complete_attestation_slave_mock_test (test, &attestation);
+}
+
+static void attestation_slave_test_precompute_challenge_signatures_fail (CuTest *test)
+{
+	int status;
+	struct attestation_slave_testing attestation;
+
+	TEST_START;
+
+	setup_attestation_slave_mock_test (test, &attestation);
+
+	status = mock_expect (&attestation.ecc.mock, attestation.ecc.base.precompute_sign,
+		&attestation.ecc, ECC_ENGINE_PRECOMPUTE_FAILED, MOCK_ARG_SAVED_ARG (0), MOCK_ARG (1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_slave_precompute_challenge_signatures (&attestation.slave, 1);
+	CuAssertIntEquals (test, ECC_ENGINE_PRECOMPUTE_FAILED, status);
+
+	complete_attestation_slave_mock_test (test, &attestation);
+}
+
 
 CuSuite* get_attestation_slave_suite ()
 {
@@ -3446,8 +4168,18 @@ CuSuite* get_attestation_slave_suite ()
 	SUITE_ADD_TEST (suite, attestation_slave_test_get_digests_aux_fail);
 	SUITE_ADD_TEST (suite, attestation_slave_test_get_digests_int_ca_fail);
 	SUITE_ADD_TEST (suite, attestation_slave_test_get_digests_root_ca_fail);
+	SUITE_ADD_TEST (suite, attestation_slave_test_get_digests_cached);
+	SUITE_ADD_TEST (suite, attestation_slave_test_get_digests_aux_slot_cached_chain);
+	SUITE_ADD_TEST (suite, attestation_slave_test_get_digests_cert_chain_changed);
+	SUITE_ADD_TEST (suite, attestation_slave_test_get_digests_hash_error_not_cached);
 	SUITE_ADD_TEST (suite, attestation_slave_test_get_digests_null);
 	SUITE_ADD_TEST (suite, attestation_slave_test_get_digests_invalid_slot_num);
+	SUITE_ADD_TEST (suite, attestation_slave_test_get_digests_dedicated_hash_engine);
+	SUITE_ADD_TEST (suite, attestation_slave_test_get_digests_cached_signing_lock_held);
+	SUITE_ADD_TEST (suite, attestation_slave_test_get_digests_multi_buffer_hash);
+	SUITE_ADD_TEST (suite, attestation_slave_test_get_digests_multi_buffer_hash_error);
+	SUITE_ADD_TEST (suite, attestation_slave_test_get_digests_multi_buffer_hash_shared_engine);
+	SUITE_ADD_TEST (suite, attestation_slave_test_set_digest_hash_engine_null);
 	SUITE_ADD_TEST (suite, attestation_slave_test_get_dev_id_certificate);
 	SUITE_ADD_TEST (suite, attestation_slave_test_get_dev_id_certificate_no_aux);
 	SUITE_ADD_TEST (suite, attestation_slave_test_get_dev_id_certificate_aux_slot);
@@ -3516,6 +4248,11 @@ CuSuite* get_attestation_slave_suite ()
 	SUITE_ADD_TEST (suite, attestation_slave_test_aux_decrypt_no_aux);
 	SUITE_ADD_TEST (suite, attestation_slave_test_aux_decrypt_fail);
 	SUITE_ADD_TEST (suite, attestation_slave_test_aux_decrypt_null);
+	SUITE_ADD_TEST (suite, attestation_slave_test_precompute_challenge_signatures);
+	SUITE_ADD_TEST (suite, attestation_slave_test_precompute_challenge_signatures_no_aux);
+	SUITE_ADD_TEST (suite, attestation_slave_test_precompute_challenge_signatures_null);
+	SUITE_ADD_TEST (suite, attestation_slave_test_precompute_challenge_signatures_unsupported);
+	SUITE_ADD_TEST (suite, attestation_slave_test_precompute_challenge_signatures_fail);
 
 	return suite;
 }
@@ -6004,6 +6004,859 @@ static void aux_attestation_test_decrypt_error (CuTest *test)
 	aux_attestation_testing_validate_and_release (test, &aux);
 }
 
+static void aux_attestation_test_decrypt_key_cache (CuTest *test)
+{
+	struct aux_attestation_testing aux;
+	uint8_t decrypted[RSA_KEY_LENGTH_3K];
+	uint8_t *key_der;
+	int status;
+
+	TEST_START;
+
+	key_der = platform_malloc (RSA3K_PRIVKEY_DER_LEN);
+	CuAssertPtrNotNull (test, key_der);
+
+	memcpy (key_der, RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN);
+
+	aux_attestation_testing_init (test, &aux);
+
+	status = aux_attestation_enable_key_cache (&aux.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&aux.keystore.mock, aux.keystore.base.load_key, &aux.keystore, 0,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&aux.keystore.mock, 1, &key_der, sizeof (key_der), -1);
+	status |= mock_expect_output (&aux.keystore.mock, 2, &RSA3K_PRIVKEY_DER_LEN,
+		sizeof (RSA3K_PRIVKEY_DER_LEN), -1);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.init_private_key, &aux.rsa, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN),
+		MOCK_ARG (RSA3K_PRIVKEY_DER_LEN));
+	status |= mock_expect_save_arg (&aux.rsa.mock, 0, 0);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.decrypt, &aux.rsa, KEY_SEED_LEN,
+		MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN),
+		MOCK_ARG (KEY_SEED_ENCRYPT_OAEP_LEN), MOCK_ARG (NULL), MOCK_ARG (0),
+		MOCK_ARG (HASH_TYPE_SHA1), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (decrypted)));
+	status |= mock_expect_output (&aux.rsa.mock, 6, KEY_SEED, KEY_SEED_LEN, 7);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.decrypt, &aux.rsa, KEY_SEED_LEN,
+		MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN),
+		MOCK_ARG (KEY_SEED_ENCRYPT_OAEP_LEN), MOCK_ARG (NULL), MOCK_ARG (0),
+		MOCK_ARG (HASH_TYPE_SHA1), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (decrypted)));
+	status |= mock_expect_output (&aux.rsa.mock, 6, KEY_SEED, KEY_SEED_LEN, 7);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.release_key, &aux.rsa, 0,
+		MOCK_ARG_SAVED_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = aux_attestation_decrypt (&aux.test, KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN,
+		NULL, 0, HASH_TYPE_SHA1, decrypted, sizeof (decrypted));
+	CuAssertIntEquals (test, KEY_SEED_LEN, status);
+
+	status = testing_validate_array (KEY_SEED, decrypted, KEY_SEED_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (decrypted, 0, sizeof (decrypted));
+
+	status = aux_attestation_decrypt (&aux.test, KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN,
+		NULL, 0, HASH_TYPE_SHA1, decrypted, sizeof (decrypted));
+	CuAssertIntEquals (test, KEY_SEED_LEN, status);
+
+	status = testing_validate_array (KEY_SEED, decrypted, KEY_SEED_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	aux_attestation_testing_validate_and_release (test, &aux);
+}
+
+static void aux_attestation_test_decrypt_key_cache_no_mock (CuTest *test)
+{
+	RSA_TESTING_ENGINE rsa;
+	struct aux_attestation_testing aux;
+	uint8_t decrypted[RSA_KEY_LENGTH_3K];
+	uint8_t *key_der;
+	int status;
+
+	TEST_START;
+
+	key_der = platform_malloc (RSA3K_PRIVKEY_DER_LEN);
+	CuAssertPtrNotNull (test, key_der);
+
+	memcpy (key_der, RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	aux_attestation_testing_init_dependencies (test, &aux);
+
+	status = aux_attestation_init (&aux.test, &aux.keystore.base, &rsa.base, &aux.riot,
+		&aux.ecc.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = aux_attestation_enable_key_cache (&aux.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&aux.keystore.mock, aux.keystore.base.load_key, &aux.keystore, 0,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&aux.keystore.mock, 1, &key_der, sizeof (key_der), -1);
+	status |= mock_expect_output (&aux.keystore.mock, 2, &RSA3K_PRIVKEY_DER_LEN,
+		sizeof (RSA3K_PRIVKEY_DER_LEN), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = aux_attestation_decrypt (&aux.test, KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN,
+		NULL, 0, HASH_TYPE_SHA1, decrypted, sizeof (decrypted));
+	CuAssertIntEquals (test, KEY_SEED_LEN, status);
+
+	status = testing_validate_array (KEY_SEED, decrypted, KEY_SEED_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (decrypted, 0, sizeof (decrypted));
+
+	status = aux_attestation_decrypt (&aux.test, KEY_SEED_ENCRYPT_OAEP_SHA256,
+		KEY_SEED_ENCRYPT_OAEP_SHA256_LEN, NULL, 0, HASH_TYPE_SHA256, decrypted,
+		sizeof (decrypted));
+	CuAssertIntEquals (test, KEY_SEED_LEN, status);
+
+	status = testing_validate_array (KEY_SEED, decrypted, KEY_SEED_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	aux_attestation_testing_validate_and_release (test, &aux);
+
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void aux_attestation_test_decrypt_key_cache_load_error (CuTest *test)
+{
+	struct aux_attestation_testing aux;
+	uint8_t decrypted[RSA_KEY_LENGTH_3K];
+	int status;
+
+	TEST_START;
+
+	aux_attestation_testing_init (test, &aux);
+
+	status = aux_attestation_enable_key_cache (&aux.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&aux.keystore.mock, aux.keystore.base.load_key, &aux.keystore,
+		KEYSTORE_LOAD_FAILED, MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = aux_attestation_decrypt (&aux.test, KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN,
+		NULL, 0, HASH_TYPE_SHA1, decrypted, sizeof (decrypted));
+	CuAssertIntEquals (test, KEYSTORE_LOAD_FAILED, status);
+
+	aux_attestation_testing_validate_and_release (test, &aux);
+}
+
+static void aux_attestation_test_decrypt_key_cache_init_key_error (CuTest *test)
+{
+	struct aux_attestation_testing aux;
+	uint8_t decrypted[RSA_KEY_LENGTH_3K];
+	uint8_t *key_der;
+	int status;
+
+	TEST_START;
+
+	key_der = platform_malloc (RSA3K_PRIVKEY_DER_LEN);
+	CuAssertPtrNotNull (test, key_der);
+
+	memcpy (key_der, RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN);
+
+	aux_attestation_testing_init (test, &aux);
+
+	status = aux_attestation_enable_key_cache (&aux.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&aux.keystore.mock, aux.keystore.base.load_key, &aux.keystore, 0,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&aux.keystore.mock, 1, &key_der, sizeof (key_der), -1);
+	status |= mock_expect_output (&aux.keystore.mock, 2, &RSA3K_PRIVKEY_DER_LEN,
+		sizeof (RSA3K_PRIVKEY_DER_LEN), -1);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.init_private_key, &aux.rsa,
+		RSA_ENGINE_KEY_PAIR_FAILED, MOCK_ARG_NOT_NULL,
+		MOCK_ARG_PTR_CONTAINS (RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN),
+		MOCK_ARG (RSA3K_PRIVKEY_DER_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = aux_attestation_decrypt (&aux.test, KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN,
+		NULL, 0, HASH_TYPE_SHA1, decrypted, sizeof (decrypted));
+	CuAssertIntEquals (test, RSA_ENGINE_KEY_PAIR_FAILED, status);
+
+	aux_attestation_testing_validate_and_release (test, &aux);
+}
+
+static void aux_attestation_test_decrypt_key_cache_decrypt_error (CuTest *test)
+{
+	struct aux_attestation_testing aux;
+	uint8_t decrypted[RSA_KEY_LENGTH_3K];
+	uint8_t *key_der;
+	int status;
+
+	TEST_START;
+
+	key_der = platform_malloc (RSA3K_PRIVKEY_DER_LEN);
+	CuAssertPtrNotNull (test, key_der);
+
+	memcpy (key_der, RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN);
+
+	aux_attestation_testing_init (test, &aux);
+
+	status = aux_attestation_enable_key_cache (&aux.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&aux.keystore.mock, aux.keystore.base.load_key, &aux.keystore, 0,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&aux.keystore.mock, 1, &key_der, sizeof (key_der), -1);
+	status |= mock_expect_output (&aux.keystore.mock, 2, &RSA3K_PRIVKEY_DER_LEN,
+		sizeof (RSA3K_PRIVKEY_DER_LEN), -1);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.init_private_key, &aux.rsa, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN),
+		MOCK_ARG (RSA3K_PRIVKEY_DER_LEN));
+	status |= mock_expect_save_arg (&aux.rsa.mock, 0, 0);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.decrypt, &aux.rsa, RSA_ENGINE_DECRYPT_FAILED,
+		MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN),
+		MOCK_ARG (KEY_SEED_ENCRYPT_OAEP_LEN), MOCK_ARG (NULL), MOCK_ARG (0),
+		MOCK_ARG (HASH_TYPE_SHA1), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (decrypted)));
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.decrypt, &aux.rsa, KEY_SEED_LEN,
+		MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN),
+		MOCK_ARG (KEY_SEED_ENCRYPT_OAEP_LEN), MOCK_ARG (NULL), MOCK_ARG (0),
+		MOCK_ARG (HASH_TYPE_SHA1), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (decrypted)));
+	status |= mock_expect_output (&aux.rsa.mock, 6, KEY_SEED, KEY_SEED_LEN, 7);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.release_key, &aux.rsa, 0,
+		MOCK_ARG_SAVED_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = aux_attestation_decrypt (&aux.test, KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN,
+		NULL, 0, HASH_TYPE_SHA1, decrypted, sizeof (decrypted));
+	CuAssertIntEquals (test, RSA_ENGINE_DECRYPT_FAILED, status);
+
+	status = aux_attestation_decrypt (&aux.test, KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN,
+		NULL, 0, HASH_TYPE_SHA1, decrypted, sizeof (decrypted));
+	CuAssertIntEquals (test, KEY_SEED_LEN, status);
+
+	aux_attestation_testing_validate_and_release (test, &aux);
+}
+
+static void aux_attestation_test_decrypt_key_cache_idle_timeout (CuTest *test)
+{
+	struct aux_attestation_testing aux;
+	uint8_t decrypted[RSA_KEY_LENGTH_3K];
+	uint8_t *key_der;
+	uint8_t *key_der2;
+	int status;
+
+	TEST_START;
+
+	key_der = platform_malloc (RSA3K_PRIVKEY_DER_LEN);
+	CuAssertPtrNotNull (test, key_der);
+
+	key_der2 = platform_malloc (RSA3K_PRIVKEY_DER_LEN);
+	CuAssertPtrNotNull (test, key_der2);
+
+	memcpy (key_der, RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN);
+	memcpy (key_der2, RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN);
+
+	aux_attestation_testing_init (test, &aux);
+
+	status = aux_attestation_enable_key_cache (&aux.test, 10);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&aux.keystore.mock, aux.keystore.base.load_key, &aux.keystore, 0,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&aux.keystore.mock, 1, &key_der, sizeof (key_der), -1);
+	status |= mock_expect_output (&aux.keystore.mock, 2, &RSA3K_PRIVKEY_DER_LEN,
+		sizeof (RSA3K_PRIVKEY_DER_LEN), -1);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.init_private_key, &aux.rsa, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN),
+		MOCK_ARG (RSA3K_PRIVKEY_DER_LEN));
+	status |= mock_expect_save_arg (&aux.rsa.mock, 0, 0);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.decrypt, &aux.rsa, KEY_SEED_LEN,
+		MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN),
+		MOCK_ARG (KEY_SEED_ENCRYPT_OAEP_LEN), MOCK_ARG (NULL), MOCK_ARG (0),
+		MOCK_ARG (HASH_TYPE_SHA1), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (decrypted)));
+	status |= mock_expect_output (&aux.rsa.mock, 6, KEY_SEED, KEY_SEED_LEN, 7);
+
+	/* The idle key is released and loaded again. */
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.release_key, &aux.rsa, 0,
+		MOCK_ARG_SAVED_ARG (0));
+
+	status |= mock_expect (&aux.keystore.mock, aux.keystore.base.load_key, &aux.keystore, 0,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&aux.keystore.mock, 1, &key_der2, sizeof (key_der2), -1);
+	status |= mock_expect_output (&aux.keystore.mock, 2, &RSA3K_PRIVKEY_DER_LEN,
+		sizeof (RSA3K_PRIVKEY_DER_LEN), -1);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.init_private_key, &aux.rsa, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN),
+		MOCK_ARG (RSA3K_PRIVKEY_DER_LEN));
+	status |= mock_expect_save_arg (&aux.rsa.mock, 0, 1);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.decrypt, &aux.rsa, KEY_SEED_LEN,
+		MOCK_ARG_SAVED_ARG (1),
+		MOCK_ARG_PTR_CONTAINS (KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN),
+		MOCK_ARG (KEY_SEED_ENCRYPT_OAEP_LEN), MOCK_ARG (NULL), MOCK_ARG (0),
+		MOCK_ARG (HASH_TYPE_SHA1), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (decrypted)));
+	status |= mock_expect_output (&aux.rsa.mock, 6, KEY_SEED, KEY_SEED_LEN, 7);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.release_key, &aux.rsa, 0,
+		MOCK_ARG_SAVED_ARG (1));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = aux_attestation_decrypt (&aux.test, KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN,
+		NULL, 0, HASH_TYPE_SHA1, decrypted, sizeof (decrypted));
+	CuAssertIntEquals (test, KEY_SEED_LEN, status);
+
+	platform_msleep (20);
+
+	status = aux_attestation_decrypt (&aux.test, KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN,
+		NULL, 0, HASH_TYPE_SHA1, decrypted, sizeof (decrypted));
+	CuAssertIntEquals (test, KEY_SEED_LEN, status);
+
+	aux_attestation_testing_validate_and_release (test, &aux);
+}
+
+static void aux_attestation_test_enable_key_cache_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = aux_attestation_enable_key_cache (NULL, 0);
+	CuAssertIntEquals (test, AUX_ATTESTATION_INVALID_ARGUMENT, status);
+}
+
+static void aux_attestation_test_enable_key_cache_no_rsa_support (CuTest *test)
+{
+	struct aux_attestation_testing aux;
+	int status;
+
+	TEST_START;
+
+	aux_attestation_testing_init_dependencies (test, &aux);
+
+	status = aux_attestation_init (&aux.test, &aux.keystore.base, NULL, &aux.riot,
+		&aux.ecc.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = aux_attestation_enable_key_cache (&aux.test, 0);
+	CuAssertIntEquals (test, AUX_ATTESTATION_UNSUPPORTED_CRYPTO, status);
+
+	aux_attestation_testing_validate_and_release (test, &aux);
+}
+
+static void aux_attestation_test_disable_key_cache (CuTest *test)
+{
+	struct aux_attestation_testing aux;
+	uint8_t decrypted[RSA_KEY_LENGTH_3K];
+	uint8_t *key_der;
+	uint8_t *key_der2;
+	int status;
+
+	TEST_START;
+
+	key_der = platform_malloc (RSA3K_PRIVKEY_DER_LEN);
+	CuAssertPtrNotNull (test, key_der);
+
+	key_der2 = platform_malloc (RSA3K_PRIVKEY_DER_LEN);
+	CuAssertPtrNotNull (test, key_der2);
+
+	memcpy (key_der, RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN);
+	memcpy (key_der2, RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN);
+
+	aux_attestation_testing_init (test, &aux);
+
+	status = aux_attestation_enable_key_cache (&aux.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&aux.keystore.mock, aux.keystore.base.load_key, &aux.keystore, 0,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&aux.keystore.mock, 1, &key_der, sizeof (key_der), -1);
+	status |= mock_expect_output (&aux.keystore.mock, 2, &RSA3K_PRIVKEY_DER_LEN,
+		sizeof (RSA3K_PRIVKEY_DER_LEN), -1);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.init_private_key, &aux.rsa, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN),
+		MOCK_ARG (RSA3K_PRIVKEY_DER_LEN));
+	status |= mock_expect_save_arg (&aux.rsa.mock, 0, 0);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.decrypt, &aux.rsa, KEY_SEED_LEN,
+		MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN),
+		MOCK_ARG (KEY_SEED_ENCRYPT_OAEP_LEN), MOCK_ARG (NULL), MOCK_ARG (0),
+		MOCK_ARG (HASH_TYPE_SHA1), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (decrypted)));
+	status |= mock_expect_output (&aux.rsa.mock, 6, KEY_SEED, KEY_SEED_LEN, 7);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.release_key, &aux.rsa, 0,
+		MOCK_ARG_SAVED_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = aux_attestation_decrypt (&aux.test, KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN,
+		NULL, 0, HASH_TYPE_SHA1, decrypted, sizeof (decrypted));
+	CuAssertIntEquals (test, KEY_SEED_LEN, status);
+
+	aux_attestation_disable_key_cache (&aux.test);
+
+	status = mock_validate (&aux.rsa.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The key is no longer kept loaded after decryption. */
+	status = mock_expect (&aux.keystore.mock, aux.keystore.base.load_key, &aux.keystore, 0,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&aux.keystore.mock, 1, &key_der2, sizeof (key_der2), -1);
+	status |= mock_expect_output (&aux.keystore.mock, 2, &RSA3K_PRIVKEY_DER_LEN,
+		sizeof (RSA3K_PRIVKEY_DER_LEN), -1);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.init_private_key, &aux.rsa, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN),
+		MOCK_ARG (RSA3K_PRIVKEY_DER_LEN));
+	status |= mock_expect_save_arg (&aux.rsa.mock, 0, 1);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.decrypt, &aux.rsa, KEY_SEED_LEN,
+		MOCK_ARG_SAVED_ARG (1),
+		MOCK_ARG_PTR_CONTAINS (KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN),
+		MOCK_ARG (KEY_SEED_ENCRYPT_OAEP_LEN), MOCK_ARG (NULL), MOCK_ARG (0),
+		MOCK_ARG (HASH_TYPE_SHA1), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (decrypted)));
+	status |= mock_expect_output (&aux.rsa.mock, 6, KEY_SEED, KEY_SEED_LEN, 7);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.release_key, &aux.rsa, 0,
+		MOCK_ARG_SAVED_ARG (1));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = aux_attestation_decrypt (&aux.test, KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN,
+		NULL, 0, HASH_TYPE_SHA1, decrypted, sizeof (decrypted));
+	CuAssertIntEquals (test, KEY_SEED_LEN, status);
+
+	aux_attestation_testing_validate_and_release (test, &aux);
+}
+
+static void aux_attestation_test_disable_key_cache_null (CuTest *test)
+{
+	TEST_START;
+
+	aux_attestation_disable_key_cache (NULL);
+}
+
+static void aux_attestation_test_expire_key_cache (CuTest *test)
+{
+	struct aux_attestation_testing aux;
+	uint8_t decrypted[RSA_KEY_LENGTH_3K];
+	uint8_t *key_der;
+	int status;
+
+	TEST_START;
+
+	key_der = platform_malloc (RSA3K_PRIVKEY_DER_LEN);
+	CuAssertPtrNotNull (test, key_der);
+
+	memcpy (key_der, RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN);
+
+	aux_attestation_testing_init (test, &aux);
+
+	status = aux_attestation_enable_key_cache (&aux.test, 10);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&aux.keystore.mock, aux.keystore.base.load_key, &aux.keystore, 0,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&aux.keystore.mock, 1, &key_der, sizeof (key_der), -1);
+	status |= mock_expect_output (&aux.keystore.mock, 2, &RSA3K_PRIVKEY_DER_LEN,
+		sizeof (RSA3K_PRIVKEY_DER_LEN), -1);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.init_private_key, &aux.rsa, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN),
+		MOCK_ARG (RSA3K_PRIVKEY_DER_LEN));
+	status |= mock_expect_save_arg (&aux.rsa.mock, 0, 0);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.decrypt, &aux.rsa, KEY_SEED_LEN,
+		MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN),
+		MOCK_ARG (KEY_SEED_ENCRYPT_OAEP_LEN), MOCK_ARG (NULL), MOCK_ARG (0),
+		MOCK_ARG (HASH_TYPE_SHA1), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (decrypted)));
+	status |= mock_expect_output (&aux.rsa.mock, 6, KEY_SEED, KEY_SEED_LEN, 7);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = aux_attestation_decrypt (&aux.test, KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN,
+		NULL, 0, HASH_TYPE_SHA1, decrypted, sizeof (decrypted));
+	CuAssertIntEquals (test, KEY_SEED_LEN, status);
+
+	/* The key has not been idle long enough to be released. */
+	aux_attestation_expire_key_cache (&aux.test);
+
+	status = mock_validate (&aux.rsa.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&aux.rsa.mock, aux.rsa.base.release_key, &aux.rsa, 0,
+		MOCK_ARG_SAVED_ARG (0));
+	CuAssertIntEquals (test, 0, status);
+
+	platform_msleep (20);
+
+	aux_attestation_expire_key_cache (&aux.test);
+
+	status = mock_validate (&aux.rsa.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	aux_attestation_testing_validate_and_release (test, &aux);
+}
+
+static void aux_attestation_test_expire_key_cache_no_timeout (CuTest *test)
+{
+	struct aux_attestation_testing aux;
+	uint8_t decrypted[RSA_KEY_LENGTH_3K];
+	uint8_t *key_der;
+	int status;
+
+	TEST_START;
+
+	key_der = platform_malloc (RSA3K_PRIVKEY_DER_LEN);
+	CuAssertPtrNotNull (test, key_der);
+
+	memcpy (key_der, RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN);
+
+	aux_attestation_testing_init (test, &aux);
+
+	status = aux_attestation_enable_key_cache (&aux.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&aux.keystore.mock, aux.keystore.base.load_key, &aux.keystore, 0,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&aux.keystore.mock, 1, &key_der, sizeof (key_der), -1);
+	status |= mock_expect_output (&aux.keystore.mock, 2, &RSA3K_PRIVKEY_DER_LEN,
+		sizeof (RSA3K_PRIVKEY_DER_LEN), -1);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.init_private_key, &aux.rsa, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN),
+		MOCK_ARG (RSA3K_PRIVKEY_DER_LEN));
+	status |= mock_expect_save_arg (&aux.rsa.mock, 0, 0);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.decrypt, &aux.rsa, KEY_SEED_LEN,
+		MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN),
+		MOCK_ARG (KEY_SEED_ENCRYPT_OAEP_LEN), MOCK_ARG (NULL), MOCK_ARG (0),
+		MOCK_ARG (HASH_TYPE_SHA1), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (decrypted)));
+	status |= mock_expect_output (&aux.rsa.mock, 6, KEY_SEED, KEY_SEED_LEN, 7);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = aux_attestation_decrypt (&aux.test, KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN,
+		NULL, 0, HASH_TYPE_SHA1, decrypted, sizeof (decrypted));
+	CuAssertIntEquals (test, KEY_SEED_LEN, status);
+
+	platform_msleep (20);
+
+	aux_attestation_expire_key_cache (&aux.test);
+
+	status = mock_validate (&aux.rsa.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&aux.rsa.mock, aux.rsa.base.release_key, &aux.rsa, 0,
+		MOCK_ARG_SAVED_ARG (0));
+	CuAssertIntEquals (test, 0, status);
+
+	aux_attestation_testing_validate_and_release (test, &aux);
+}
+
+static void aux_attestation_test_expire_key_cache_null (CuTest *test)
+{
+	TEST_START;
+
+	aux_attestation_expire_key_cache (NULL);
+}
+
+static void aux_attestation_test_erase_key_with_cached_key (CuTest *test)
+{
+	struct aux_attestation_testing aux;
+	uint8_t decrypted[RSA_KEY_LENGTH_3K];
+	uint8_t *key_der;
+	int status;
+
+	TEST_START;
+
+	key_der = platform_malloc (RSA3K_PRIVKEY_DER_LEN);
+	CuAssertPtrNotNull (test, key_der);
+
+	memcpy (key_der, RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN);
+
+	aux_attestation_testing_init (test, &aux);
+
+	status = aux_attestation_enable_key_cache (&aux.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&aux.keystore.mock, aux.keystore.base.load_key, &aux.keystore, 0,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&aux.keystore.mock, 1, &key_der, sizeof (key_der), -1);
+	status |= mock_expect_output (&aux.keystore.mock, 2, &RSA3K_PRIVKEY_DER_LEN,
+		sizeof (RSA3K_PRIVKEY_DER_LEN), -1);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.init_private_key, &aux.rsa, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN),
+		MOCK_ARG (RSA3K_PRIVKEY_DER_LEN));
+	status |= mock_expect_save_arg (&aux.rsa.mock, 0, 0);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.decrypt, &aux.rsa, KEY_SEED_LEN,
+		MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN),
+		MOCK_ARG (KEY_SEED_ENCRYPT_OAEP_LEN), MOCK_ARG (NULL), MOCK_ARG (0),
+		MOCK_ARG (HASH_TYPE_SHA1), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (decrypted)));
+	status |= mock_expect_output (&aux.rsa.mock, 6, KEY_SEED, KEY_SEED_LEN, 7);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.release_key, &aux.rsa, 0,
+		MOCK_ARG_SAVED_ARG (0));
+
+	status |= mock_expect (&aux.keystore.mock, aux.keystore.base.erase_key, &aux.keystore, 0,
+		MOCK_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = aux_attestation_decrypt (&aux.test, KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN,
+		NULL, 0, HASH_TYPE_SHA1, decrypted, sizeof (decrypted));
+	CuAssertIntEquals (test, KEY_SEED_LEN, status);
+
+	status = aux_attestation_erase_key (&aux.test);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&aux.rsa.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	aux_attestation_testing_validate_and_release (test, &aux);
+}
+
+static void aux_attestation_test_generate_key_with_cached_key (CuTest *test)
+{
+	struct aux_attestation_testing aux;
+	uint8_t decrypted[RSA_KEY_LENGTH_3K];
+	uint8_t *key_der;
+	uint8_t *new_der;
+	int status;
+
+	TEST_START;
+
+	key_der = platform_malloc (RSA3K_PRIVKEY_DER_LEN);
+	CuAssertPtrNotNull (test, key_der);
+
+	memcpy (key_der, RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN);
+
+	new_der = platform_malloc (RSA3K_PRIVKEY_DER_LEN);
+	CuAssertPtrNotNull (test, new_der);
+
+	memcpy (new_der, RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN);
+
+	aux_attestation_testing_init (test, &aux);
+
+	status = aux_attestation_enable_key_cache (&aux.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&aux.keystore.mock, aux.keystore.base.load_key, &aux.keystore, 0,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&aux.keystore.mock, 1, &key_der, sizeof (key_der), -1);
+	status |= mock_expect_output (&aux.keystore.mock, 2, &RSA3K_PRIVKEY_DER_LEN,
+		sizeof (RSA3K_PRIVKEY_DER_LEN), -1);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.init_private_key, &aux.rsa, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN),
+		MOCK_ARG (RSA3K_PRIVKEY_DER_LEN));
+	status |= mock_expect_save_arg (&aux.rsa.mock, 0, 0);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.decrypt, &aux.rsa, KEY_SEED_LEN,
+		MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN),
+		MOCK_ARG (KEY_SEED_ENCRYPT_OAEP_LEN), MOCK_ARG (NULL), MOCK_ARG (0),
+		MOCK_ARG (HASH_TYPE_SHA1), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (decrypted)));
+	status |= mock_expect_output (&aux.rsa.mock, 6, KEY_SEED, KEY_SEED_LEN, 7);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.generate_key, &aux.rsa, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (3072));
+	status |= mock_expect_save_arg (&aux.rsa.mock, 0, 1);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.get_private_key_der, &aux.rsa, 0,
+		MOCK_ARG_SAVED_ARG (1), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&aux.rsa.mock, 1, &new_der, sizeof (new_der), -1);
+	status |= mock_expect_output (&aux.rsa.mock, 2, &RSA3K_PRIVKEY_DER_LEN,
+		sizeof (RSA3K_PRIVKEY_DER_LEN), -1);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.release_key, &aux.rsa, 0,
+		MOCK_ARG_SAVED_ARG (1));
+
+	/* The cached key is released after the new key has been saved. */
+	status |= mock_expect (&aux.keystore.mock, aux.keystore.base.save_key, &aux.keystore, 0,
+		MOCK_ARG (0), MOCK_ARG_PTR_CONTAINS (RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN),
+		MOCK_ARG (RSA3K_PRIVKEY_DER_LEN));
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.release_key, &aux.rsa, 0,
+		MOCK_ARG_SAVED_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = aux_attestation_decrypt (&aux.test, KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN,
+		NULL, 0, HASH_TYPE_SHA1, decrypted, sizeof (decrypted));
+	CuAssertIntEquals (test, KEY_SEED_LEN, status);
+
+	status = aux_attestation_generate_key (&aux.test);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, false, aux.test.key_loaded);
+
+	status = mock_validate (&aux.rsa.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	aux_attestation_testing_validate_and_release (test, &aux);
+}
+
+static void aux_attestation_test_generate_key_with_cached_key_generation_error (CuTest *test)
+{
+	struct aux_attestation_testing aux;
+	uint8_t decrypted[RSA_KEY_LENGTH_3K];
+	uint8_t *key_der;
+	int status;
+
+	TEST_START;
+
+	key_der = platform_malloc (RSA3K_PRIVKEY_DER_LEN);
+	CuAssertPtrNotNull (test, key_der);
+
+	memcpy (key_der, RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN);
+
+	aux_attestation_testing_init (test, &aux);
+
+	status = aux_attestation_enable_key_cache (&aux.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&aux.keystore.mock, aux.keystore.base.load_key, &aux.keystore, 0,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&aux.keystore.mock, 1, &key_der, sizeof (key_der), -1);
+	status |= mock_expect_output (&aux.keystore.mock, 2, &RSA3K_PRIVKEY_DER_LEN,
+		sizeof (RSA3K_PRIVKEY_DER_LEN), -1);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.init_private_key, &aux.rsa, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR_CONTAINS (RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN),
+		MOCK_ARG (RSA3K_PRIVKEY_DER_LEN));
+	status |= mock_expect_save_arg (&aux.rsa.mock, 0, 0);
+
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.decrypt, &aux.rsa, KEY_SEED_LEN,
+		MOCK_ARG_SAVED_ARG (0),
+		MOCK_ARG_PTR_CONTAINS (KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN),
+		MOCK_ARG (KEY_SEED_ENCRYPT_OAEP_LEN), MOCK_ARG (NULL), MOCK_ARG (0),
+		MOCK_ARG (HASH_TYPE_SHA1), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (decrypted)));
+	status |= mock_expect_output (&aux.rsa.mock, 6, KEY_SEED, KEY_SEED_LEN, 7);
+
+	/* The keystore is not changed, so the cached key is still valid. */
+	status |= mock_expect (&aux.rsa.mock, aux.rsa.base.generate_key, &aux.rsa,
+		RSA_ENGINE_GENERATE_KEY_FAILED, MOCK_ARG_NOT_NULL, MOCK_ARG (3072));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = aux_attestation_decrypt (&aux.test, KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN,
+		NULL, 0, HASH_TYPE_SHA1, decrypted, sizeof (decrypted));
+	CuAssertIntEquals (test, KEY_SEED_LEN, status);
+
+	status = aux_attestation_generate_key (&aux.test);
+	CuAssertIntEquals (test, RSA_ENGINE_GENERATE_KEY_FAILED, status);
+	CuAssertIntEquals (test, true, aux.test.key_loaded);
+
+	status = mock_validate (&aux.rsa.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&aux.rsa.mock, aux.rsa.base.release_key, &aux.rsa, 0,
+		MOCK_ARG_SAVED_ARG (0));
+	CuAssertIntEquals (test, 0, status);
+
+	aux_attestation_testing_validate_and_release (test, &aux);
+}
+
+static void aux_attestation_test_unseal_rsa_key_cache_no_mock (CuTest *test)
+{
+	RSA_TESTING_ENGINE rsa;
+	HASH_TESTING_ENGINE hash;
+	struct aux_attestation_testing aux;
+	struct pcr_store pcr;
+	uint8_t num_measurements[] = {0};
+	int status;
+	uint8_t *key_der;
+	uint8_t attestation_key[32];
+
+	TEST_START;
+
+	key_der = platform_malloc (RSA3K_PRIVKEY_DER_LEN);
+	CuAssertPtrNotNull (test, key_der);
+
+	memcpy (key_der, RSA3K_PRIVKEY_DER, RSA3K_PRIVKEY_DER_LEN);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	aux_attestation_testing_init_dependencies (test, &aux);
+
+	status = aux_attestation_init (&aux.test, &aux.keystore.base, &rsa.base, &aux.riot,
+		&aux.ecc.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = aux_attestation_enable_key_cache (&aux.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_init (&pcr, num_measurements, sizeof (num_measurements));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_update_digest (&pcr, PCR_MEASUREMENT (0, 0), PCR0_VALUE, PCR0_VALUE_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&aux.keystore.mock, aux.keystore.base.load_key, &aux.keystore, 0,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&aux.keystore.mock, 1, &key_der, sizeof (key_der), -1);
+	status |= mock_expect_output (&aux.keystore.mock, 2, &RSA3K_PRIVKEY_DER_LEN,
+		sizeof (RSA3K_PRIVKEY_DER_LEN), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = aux_attestation_unseal (&aux.test, &hash.base, &pcr, AUX_ATTESTATION_KEY_256BIT,
+		KEY_SEED_ENCRYPT_OAEP, KEY_SEED_ENCRYPT_OAEP_LEN, AUX_ATTESTATION_SEED_RSA,
+		AUX_ATTESTATION_PADDING_OAEP_SHA1, PAYLOAD_HMAC, HMAC_SHA256, CIPHER_TEXT, CIPHER_TEXT_LEN,
+		SEALING_POLICY, 1, attestation_key, sizeof (attestation_key));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (ENCRYPTION_KEY, attestation_key, ENCRYPTION_KEY_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (attestation_key, 0, sizeof (attestation_key));
+
+	status = aux_attestation_unseal (&aux.test, &hash.base, &pcr, AUX_ATTESTATION_KEY_256BIT,
+		KEY_SEED_ENCRYPT_OAEP_SHA256, KEY_SEED_ENCRYPT_OAEP_SHA256_LEN, AUX_ATTESTATION_SEED_RSA,
+		AUX_ATTESTATION_PADDING_OAEP_SHA256, PAYLOAD_HMAC, HMAC_SHA256, CIPHER_TEXT,
+		CIPHER_TEXT_LEN, SEALING_POLICY, 1, attestation_key, sizeof (attestation_key));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (ENCRYPTION_KEY, attestation_key, ENCRYPTION_KEY_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	aux_attestation_testing_validate_and_release (test, &aux);
+
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	pcr_store_release (&pcr);
+}
+
 
 CuSuite* get_aux_attestation_suite ()
 {
@@ -6110,6 +6963,23 @@ CuSuite* get_aux_attestation_suite ()
 	SUITE_ADD_TEST (suite, aux_attestation_test_decrypt_load_error);
 	SUITE_ADD_TEST (suite, aux_attestation_test_decrypt_init_key_error);
 	SUITE_ADD_TEST (suite, aux_attestation_test_decrypt_error);
+	SUITE_ADD_TEST (suite, aux_attestation_test_decrypt_key_cache);
+	SUITE_ADD_TEST (suite, aux_attestation_test_decrypt_key_cache_no_mock);
+	SUITE_ADD_TEST (suite, aux_attestation_test_decrypt_key_cache_load_error);
+	SUITE_ADD_TEST (suite, aux_attestation_test_decrypt_key_cache_init_key_error);
+	SUITE_ADD_TEST (suite, aux_attestation_test_decrypt_key_cache_decrypt_error);
+	SUITE_ADD_TEST (suite, aux_attestation_test_decrypt_key_cache_idle_timeout);
+	SUITE_ADD_TEST (suite, aux_attestation_test_enable_key_cache_null);
+	SUITE_ADD_TEST (suite, aux_attestation_test_enable_key_cache_no_rsa_support);
+	SUITE_ADD_TEST (suite, aux_attestation_test_disable_key_cache);
+	SUITE_ADD_TEST (suite, aux_attestation_test_disable_key_cache_null);
+	SUITE_ADD_TEST (suite, aux_attestation_test_expire_key_cache);
+	SUITE_ADD_TEST (suite, aux_attestation_test_expire_key_cache_no_timeout);
+	SUITE_ADD_TEST (suite, aux_attestation_test_expire_key_cache_null);
+	SUITE_ADD_TEST (suite, aux_attestation_test_erase_key_with_cached_key);
+	SUITE_ADD_TEST (suite, aux_attestation_test_generate_key_with_cached_key);
+	SUITE_ADD_TEST (suite, aux_attestation_test_generate_key_with_cached_key_generation_error);
+	SUITE_ADD_TEST (suite, aux_attestation_test_unseal_rsa_key_cache_no_mock);
 
 	return suite;
 }
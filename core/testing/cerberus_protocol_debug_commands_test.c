@@ -8,6 +8,7 @@
 #include "testing.h"
 #include "cmd_interface/cerberus_protocol.h"
 #include "cmd_interface/cerberus_protocol_debug_commands.h"
+#include "logging/trace_buffer.h"
 #include "mock/ecc_mock.h"
 #include "mock/rsa_mock.h"
 #include "mock/rng_mock.h"
@@ -46,6 +47,196 @@ void cerberus_protocol_debug_commands_testing_process_debug_fill_log (CuTest *te
 	CuAssertIntEquals (test, false, request.crypto_timeout);
 }
 
+void cerberus_protocol_debug_commands_testing_process_debug_read_trace (CuTest *test,
+	struct cmd_interface *cmd)
+{
+	struct cmd_interface_request request;
+	struct cerberus_protocol_debug_read_trace *req =
+		(struct cerberus_protocol_debug_read_trace*) request.data;
+	struct cerberus_protocol_debug_read_trace_response *resp =
+		(struct cerberus_protocol_debug_read_trace_response*) request.data;
+	struct trace_record records[8];
+	struct trace_record *out;
+	struct trace_buffer trace;
+	int status;
+	int i;
+
+	status = trace_buffer_init (&trace, records, 8, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = trace_buffer_register (&trace, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 5; i++) {
+		trace_buffer_add (&trace, TRACE_EVENT_CMD_DISPATCH, TRACE_PHASE_INSTANT, i, i + 10);
+	}
+
+	/* Stop tracing so command processing doesn't add records. */
+	trace_buffer_set_enabled (&trace, false);
+
+	memset (&request, 0, sizeof (request));
+	req->header.msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	req->header.pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	req->header.command = CERBERUS_PROTOCOL_DEBUG_READ_TRACE;
+
+	req->core = 0;
+	req->offset = 2;
+	request.length = sizeof (struct cerberus_protocol_debug_read_trace);
+	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+	request.source_eid = MCTP_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, cerberus_protocol_debug_read_trace_response_length (3),
+		request.length);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF, resp->header.msg_type);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MSFT_PCI_VID, resp->header.pci_vendor_id);
+	CuAssertIntEquals (test, 0, resp->header.crypt);
+	CuAssertIntEquals (test, 0, resp->header.d_bit);
+	CuAssertIntEquals (test, 0, resp->header.integrity_check);
+	CuAssertIntEquals (test, 0, resp->header.seq_num);
+	CuAssertIntEquals (test, 0, resp->header.rq);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_DEBUG_READ_TRACE, resp->header.command);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+
+	out = cerberus_protocol_debug_trace_records (resp);
+	for (i = 0; i < 3; i++) {
+		CuAssertIntEquals (test, TRACE_EVENT_CMD_DISPATCH, out[i].event);
+		CuAssertIntEquals (test, TRACE_PHASE_INSTANT, out[i].phase);
+		CuAssertIntEquals (test, 0, out[i].core);
+		CuAssertIntEquals (test, i + 2, out[i].arg1);
+		CuAssertIntEquals (test, i + 12, out[i].arg2);
+	}
+
+	trace_buffer_register (NULL, 0);
+	trace_buffer_release (&trace);
+}
+
+void cerberus_protocol_debug_commands_testing_process_debug_read_trace_limited_response (
+	CuTest *test, struct cmd_interface *cmd)
+{
+	struct cmd_interface_request request;
+	struct cerberus_protocol_debug_read_trace *req =
+		(struct cerberus_protocol_debug_read_trace*) request.data;
+	struct cerberus_protocol_debug_read_trace_response *resp =
+		(struct cerberus_protocol_debug_read_trace_response*) request.data;
+	struct trace_record records[8];
+	struct trace_record *out;
+	struct trace_buffer trace;
+	int status;
+	int i;
+
+	status = trace_buffer_init (&trace, records, 8, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = trace_buffer_register (&trace, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 8; i++) {
+		trace_buffer_add (&trace, TRACE_EVENT_FLASH_XFER, TRACE_PHASE_BEGIN, i, 0);
+	}
+
+	/* Stop tracing so command processing doesn't add records. */
+	trace_buffer_set_enabled (&trace, false);
+
+	memset (&request, 0, sizeof (request));
+	req->header.msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	req->header.pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	req->header.command = CERBERUS_PROTOCOL_DEBUG_READ_TRACE;
+
+	req->core = 0;
+	req->offset = 0;
+	request.length = sizeof (struct cerberus_protocol_debug_read_trace);
+	request.max_response = sizeof (struct cerberus_protocol_debug_read_trace_response) +
+		(sizeof (struct trace_record) * 4) + 1;
+	request.source_eid = MCTP_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, cerberus_protocol_debug_read_trace_response_length (4),
+		request.length);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_DEBUG_READ_TRACE, resp->header.command);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+
+	out = cerberus_protocol_debug_trace_records (resp);
+	for (i = 0; i < 4; i++) {
+		CuAssertIntEquals (test, TRACE_EVENT_FLASH_XFER, out[i].event);
+		CuAssertIntEquals (test, i, out[i].arg1);
+	}
+
+	trace_buffer_register (NULL, 0);
+	trace_buffer_release (&trace);
+}
+
+void cerberus_protocol_debug_commands_testing_process_debug_read_trace_invalid_len (CuTest *test,
+	struct cmd_interface *cmd)
+{
+	struct cmd_interface_request request;
+	struct cerberus_protocol_debug_read_trace *req =
+		(struct cerberus_protocol_debug_read_trace*) request.data;
+	int status;
+
+	memset (&request, 0, sizeof (request));
+	req->header.msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	req->header.pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	req->header.command = CERBERUS_PROTOCOL_DEBUG_READ_TRACE;
+
+	req->core = 0;
+	req->offset = 0;
+	request.length = sizeof (struct cerberus_protocol_debug_read_trace) + 1;
+	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+	request.source_eid = MCTP_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, CMD_HANDLER_BAD_LENGTH, status);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+
+	request.length = sizeof (struct cerberus_protocol_debug_read_trace) - 1;
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, CMD_HANDLER_BAD_LENGTH, status);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+}
+
+void cerberus_protocol_debug_commands_testing_process_debug_read_trace_no_trace (CuTest *test,
+	struct cmd_interface *cmd)
+{
+	struct cmd_interface_request request;
+	struct cerberus_protocol_debug_read_trace *req =
+		(struct cerberus_protocol_debug_read_trace*) request.data;
+	int status;
+
+	memset (&request, 0, sizeof (request));
+	req->header.msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	req->header.pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	req->header.command = CERBERUS_PROTOCOL_DEBUG_READ_TRACE;
+
+	req->core = 0;
+	req->offset = 0;
+	request.length = sizeof (struct cerberus_protocol_debug_read_trace);
+	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+	request.source_eid = MCTP_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, CMD_HANDLER_UNSUPPORTED_INDEX, status);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+
+	req->core = TRACE_BUFFER_MAX_CORES;
+	request.length = sizeof (struct cerberus_protocol_debug_read_trace);
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, CMD_HANDLER_UNSUPPORTED_INDEX, status);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+}
+
 void cerberus_protocol_debug_commands_testing_process_get_device_certificate (CuTest *test,
 	struct cmd_interface *cmd, struct device_manager *device_manager)
 {
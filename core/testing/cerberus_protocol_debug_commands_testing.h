@@ -18,6 +18,15 @@
 void cerberus_protocol_debug_commands_testing_process_debug_fill_log (CuTest *test,
 	struct cmd_interface *cmd, struct cmd_background_mock *background);
 
+void cerberus_protocol_debug_commands_testing_process_debug_read_trace (CuTest *test,
+	struct cmd_interface *cmd);
+void cerberus_protocol_debug_commands_testing_process_debug_read_trace_limited_response (
+	CuTest *test, struct cmd_interface *cmd);
+void cerberus_protocol_debug_commands_testing_process_debug_read_trace_invalid_len (CuTest *test,
+	struct cmd_interface *cmd);
+void cerberus_protocol_debug_commands_testing_process_debug_read_trace_no_trace (CuTest *test,
+	struct cmd_interface *cmd);
+
 void cerberus_protocol_debug_commands_testing_process_get_device_certificate (CuTest *test,
 	struct cmd_interface *cmd, struct device_manager *device_manager);
 void cerberus_protocol_debug_commands_testing_process_get_device_certificate_invalid_len (
@@ -6824,6 +6824,254 @@ void cerberus_protocol_optional_commands_testing_process_get_recovery_image_vers
 	CuAssertIntEquals (test, false, request.crypto_timeout);
 }
 
+void cerberus_protocol_optional_commands_testing_process_get_command_stats (CuTest *test,
+	struct cmd_interface *cmd)
+{
+	struct cmd_interface_request request;
+	struct cerberus_protocol_get_command_stats *req =
+		(struct cerberus_protocol_get_command_stats*) request.data;
+	struct cerberus_protocol_get_command_stats_response *resp =
+		(struct cerberus_protocol_get_command_stats_response*) request.data;
+	uint32_t total = 0;
+	int status;
+	int i;
+
+	memset (&request, 0, sizeof (request));
+	req->header.msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	req->header.pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	req->header.command = CERBERUS_PROTOCOL_GET_COMMAND_STATS;
+
+	request.length = sizeof (struct cerberus_protocol_get_command_stats) + 1;
+	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+	request.source_eid = MCTP_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, CMD_HANDLER_BAD_LENGTH, status);
+
+	req->stats_type = CERBERUS_PROTOCOL_COMMAND_STATS;
+	req->id = CERBERUS_PROTOCOL_GET_COMMAND_STATS;
+	request.length = sizeof (struct cerberus_protocol_get_command_stats);
+
+	request.new_request = true;
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, sizeof (struct cerberus_protocol_get_command_stats_response),
+		request.length);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF, resp->header.msg_type);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MSFT_PCI_VID, resp->header.pci_vendor_id);
+	CuAssertIntEquals (test, 0, resp->header.crypt);
+	CuAssertIntEquals (test, 0, resp->header.d_bit);
+	CuAssertIntEquals (test, 0, resp->header.integrity_check);
+	CuAssertIntEquals (test, 0, resp->header.seq_num);
+	CuAssertIntEquals (test, 0, resp->header.rq);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_GET_COMMAND_STATS, resp->header.command);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_GET_COMMAND_STATS, resp->command_id);
+	CuAssertIntEquals (test, 1, resp->requests);
+	CuAssertIntEquals (test, 1, resp->failures);
+	CuAssertIntEquals (test, false, request.new_request);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+
+	for (i = 0; i < CMD_STATS_LATENCY_BUCKETS; i++) {
+		total += resp->latency[i];
+	}
+	CuAssertIntEquals (test, 1, total);
+}
+
+void cerberus_protocol_optional_commands_testing_process_get_command_stats_no_requests (
+	CuTest *test, struct cmd_interface *cmd)
+{
+	struct cmd_interface_request request;
+	struct cerberus_protocol_get_command_stats *req =
+		(struct cerberus_protocol_get_command_stats*) request.data;
+	struct cerberus_protocol_get_command_stats_response *resp =
+		(struct cerberus_protocol_get_command_stats_response*) request.data;
+	uint8_t zero[sizeof (resp->latency)] = {0};
+	int status;
+
+	memset (&request, 0, sizeof (request));
+	req->header.msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	req->header.pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	req->header.command = CERBERUS_PROTOCOL_GET_COMMAND_STATS;
+
+	req->stats_type = CERBERUS_PROTOCOL_COMMAND_STATS;
+	req->id = CERBERUS_PROTOCOL_GET_FW_VERSION;
+	request.length = sizeof (struct cerberus_protocol_get_command_stats);
+	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+	request.source_eid = MCTP_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+
+	request.new_request = true;
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, sizeof (struct cerberus_protocol_get_command_stats_response),
+		request.length);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_GET_COMMAND_STATS, resp->header.command);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_GET_FW_VERSION, resp->command_id);
+	CuAssertIntEquals (test, 0, resp->requests);
+	CuAssertIntEquals (test, 0, resp->failures);
+	CuAssertIntEquals (test, 0, resp->total_time_ms);
+	CuAssertIntEquals (test, 0, resp->max_time_ms);
+	CuAssertIntEquals (test, false, request.new_request);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+
+	status = testing_validate_array (zero, (uint8_t*) resp->latency, sizeof (zero));
+	CuAssertIntEquals (test, 0, status);
+}
+
+void cerberus_protocol_optional_commands_testing_process_get_command_stats_channel (CuTest *test,
+	struct cmd_interface *cmd, struct cmd_stats *stats)
+{
+	struct cmd_interface_request request;
+	struct cerberus_protocol_get_command_stats *req =
+		(struct cerberus_protocol_get_command_stats*) request.data;
+	struct cerberus_protocol_get_channel_stats_response *resp =
+		(struct cerberus_protocol_get_channel_stats_response*) request.data;
+	struct cmd_channel channel;
+	int status;
+
+	status = cmd_channel_init (&channel, 3);
+	CuAssertIntEquals (test, 0, status);
+
+	channel.stats.rx_packets = 1;
+	channel.stats.rx_errors = 2;
+	channel.stats.rx_timeouts = 3;
+	channel.stats.dropped = 4;
+	channel.stats.overflow = 5;
+	channel.stats.tx_packets = 6;
+	channel.stats.tx_errors = 7;
+	channel.stats.timeouts = 8;
+
+	status = cmd_stats_add_channel (stats, &channel);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&request, 0, sizeof (request));
+	req->header.msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	req->header.pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	req->header.command = CERBERUS_PROTOCOL_GET_COMMAND_STATS;
+
+	req->stats_type = CERBERUS_PROTOCOL_CHANNEL_STATS;
+	req->id = 3;
+	request.length = sizeof (struct cerberus_protocol_get_command_stats);
+	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+	request.source_eid = MCTP_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+
+	request.new_request = true;
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, sizeof (struct cerberus_protocol_get_channel_stats_response),
+		request.length);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF, resp->header.msg_type);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MSFT_PCI_VID, resp->header.pci_vendor_id);
+	CuAssertIntEquals (test, 0, resp->header.crypt);
+	CuAssertIntEquals (test, 0, resp->header.d_bit);
+	CuAssertIntEquals (test, 0, resp->header.integrity_check);
+	CuAssertIntEquals (test, 0, resp->header.seq_num);
+	CuAssertIntEquals (test, 0, resp->header.rq);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_GET_COMMAND_STATS, resp->header.command);
+	CuAssertIntEquals (test, 3, resp->channel_id);
+	CuAssertIntEquals (test, 1, resp->rx_packets);
+	CuAssertIntEquals (test, 2, resp->rx_errors);
+	CuAssertIntEquals (test, 3, resp->rx_timeouts);
+	CuAssertIntEquals (test, 4, resp->dropped);
+	CuAssertIntEquals (test, 5, resp->overflow);
+	CuAssertIntEquals (test, 6, resp->tx_packets);
+	CuAssertIntEquals (test, 7, resp->tx_errors);
+	CuAssertIntEquals (test, 8, resp->timeouts);
+	CuAssertIntEquals (test, false, request.new_request);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+
+	cmd_channel_release (&channel);
+}
+
+void cerberus_protocol_optional_commands_testing_process_get_command_stats_unknown_channel (
+	CuTest *test, struct cmd_interface *cmd)
+{
+	struct cmd_interface_request request;
+	struct cerberus_protocol_get_command_stats *req =
+		(struct cerberus_protocol_get_command_stats*) request.data;
+	int status;
+
+	memset (&request, 0, sizeof (request));
+	req->header.msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	req->header.pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	req->header.command = CERBERUS_PROTOCOL_GET_COMMAND_STATS;
+
+	req->stats_type = CERBERUS_PROTOCOL_CHANNEL_STATS;
+	req->id = 3;
+	request.length = sizeof (struct cerberus_protocol_get_command_stats);
+	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+	request.source_eid = MCTP_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, CMD_HANDLER_UNSUPPORTED_INDEX, status);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+}
+
+void cerberus_protocol_optional_commands_testing_process_get_command_stats_invalid_len (
+	CuTest *test, struct cmd_interface *cmd)
+{
+	struct cmd_interface_request request;
+	struct cerberus_protocol_get_command_stats *req =
+		(struct cerberus_protocol_get_command_stats*) request.data;
+	int status;
+
+	memset (&request, 0, sizeof (request));
+	req->header.msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	req->header.pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	req->header.command = CERBERUS_PROTOCOL_GET_COMMAND_STATS;
+
+	req->stats_type = CERBERUS_PROTOCOL_COMMAND_STATS;
+	req->id = CERBERUS_PROTOCOL_GET_FW_VERSION;
+	request.length = sizeof (struct cerberus_protocol_get_command_stats) + 1;
+	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+	request.source_eid = MCTP_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, CMD_HANDLER_BAD_LENGTH, status);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+
+	request.length = sizeof (struct cerberus_protocol_get_command_stats) - 1;
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, CMD_HANDLER_BAD_LENGTH, status);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+}
+
+void cerberus_protocol_optional_commands_testing_process_get_command_stats_invalid_type (
+	CuTest *test, struct cmd_interface *cmd)
+{
+	struct cmd_interface_request request;
+	struct cerberus_protocol_get_command_stats *req =
+		(struct cerberus_protocol_get_command_stats*) request.data;
+	int status;
+
+	memset (&request, 0, sizeof (request));
+	req->header.msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	req->header.pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	req->header.command = CERBERUS_PROTOCOL_GET_COMMAND_STATS;
+
+	req->stats_type = 2;
+	req->id = CERBERUS_PROTOCOL_GET_FW_VERSION;
+	request.length = sizeof (struct cerberus_protocol_get_command_stats);
+	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+	request.source_eid = MCTP_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, CMD_HANDLER_OUT_OF_RANGE, status);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+}
+
 
 /*******************
  * Test cases
@@ -7794,6 +8042,102 @@ static void cerberus_protocol_optional_commands_test_message_unseal_result_forma
 	CuAssertPtrEquals (test, &raw_buffer_resp[11], &resp2->key);
 }
 
+static void cerberus_protocol_optional_commands_test_get_command_stats_format (CuTest *test)
+{
+	uint8_t raw_buffer_req[] = {
+		0x7e,0x14,0x13,0x03,0x8f,
+		0x01,0x02
+	};
+	uint8_t raw_buffer_cmd_resp[] = {
+		0x7e,0x14,0x13,0x03,0x8f,
+		0x82,
+		0x01,0x02,0x03,0x04,
+		0x05,0x06,0x07,0x08,
+		0x09,0x0a,0x0b,0x0c,
+		0x0d,0x0e,0x0f,0x10,
+		0x00,0x00,0x00,0x01,0x00,0x00,0x00,0x02,0x00,0x00,0x00,0x03,0x00,0x00,0x00,0x04,
+		0x00,0x00,0x00,0x05,0x00,0x00,0x00,0x06,0x00,0x00,0x00,0x07,0x00,0x00,0x00,0x08,
+		0x00,0x00,0x00,0x09,0x00,0x00,0x00,0x0a,0x00,0x00,0x00,0x0b,0x00,0x00,0x00,0x0c
+	};
+	uint8_t raw_buffer_channel_resp[] = {
+		0x7e,0x14,0x13,0x03,0x8f,
+		0x02,
+		0x01,0x02,0x03,0x04,
+		0x05,0x06,0x07,0x08,
+		0x09,0x0a,0x0b,0x0c,
+		0x0d,0x0e,0x0f,0x10,
+		0x11,0x12,0x13,0x14,
+		0x15,0x16,0x17,0x18,
+		0x19,0x1a,0x1b,0x1c,
+		0x1d,0x1e,0x1f,0x20
+	};
+	struct cerberus_protocol_get_command_stats *req;
+	struct cerberus_protocol_get_command_stats_response *cmd_resp;
+	struct cerberus_protocol_get_channel_stats_response *channel_resp;
+	int i;
+
+	TEST_START;
+
+	CuAssertIntEquals (test, sizeof (raw_buffer_req),
+		sizeof (struct cerberus_protocol_get_command_stats));
+	CuAssertIntEquals (test, sizeof (raw_buffer_cmd_resp),
+		sizeof (struct cerberus_protocol_get_command_stats_response));
+	CuAssertIntEquals (test, sizeof (raw_buffer_channel_resp),
+		sizeof (struct cerberus_protocol_get_channel_stats_response));
+
+	req = (struct cerberus_protocol_get_command_stats*) raw_buffer_req;
+	CuAssertIntEquals (test, 0, req->header.integrity_check);
+	CuAssertIntEquals (test, 0x7e, req->header.msg_type);
+	CuAssertIntEquals (test, 0x1314, req->header.pci_vendor_id);
+	CuAssertIntEquals (test, 0, req->header.rq);
+	CuAssertIntEquals (test, 0, req->header.d_bit);
+	CuAssertIntEquals (test, 0, req->header.crypt);
+	CuAssertIntEquals (test, 0x03, req->header.seq_num);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_GET_COMMAND_STATS, req->header.command);
+
+	CuAssertIntEquals (test, 0x01, req->stats_type);
+	CuAssertIntEquals (test, 0x02, req->id);
+
+	cmd_resp = (struct cerberus_protocol_get_command_stats_response*) raw_buffer_cmd_resp;
+	CuAssertIntEquals (test, 0, cmd_resp->header.integrity_check);
+	CuAssertIntEquals (test, 0x7e, cmd_resp->header.msg_type);
+	CuAssertIntEquals (test, 0x1314, cmd_resp->header.pci_vendor_id);
+	CuAssertIntEquals (test, 0, cmd_resp->header.rq);
+	CuAssertIntEquals (test, 0, cmd_resp->header.d_bit);
+	CuAssertIntEquals (test, 0, cmd_resp->header.crypt);
+	CuAssertIntEquals (test, 0x03, cmd_resp->header.seq_num);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_GET_COMMAND_STATS, cmd_resp->header.command);
+
+	CuAssertIntEquals (test, 0x82, cmd_resp->command_id);
+	CuAssertIntEquals (test, 0x04030201, cmd_resp->requests);
+	CuAssertIntEquals (test, 0x08070605, cmd_resp->failures);
+	CuAssertIntEquals (test, 0x0c0b0a09, cmd_resp->total_time_ms);
+	CuAssertIntEquals (test, 0x100f0e0d, cmd_resp->max_time_ms);
+
+	for (i = 0; i < CMD_STATS_LATENCY_BUCKETS; i++) {
+		CuAssertIntEquals (test, (i + 1) << 24, cmd_resp->latency[i]);
+	}
+
+	channel_resp = (struct cerberus_protocol_get_channel_stats_response*) raw_buffer_channel_resp;
+	CuAssertIntEquals (test, 0, channel_resp->header.integrity_check);
+	CuAssertIntEquals (test, 0x7e, channel_resp->header.msg_type);
+	CuAssertIntEquals (test, 0x1314, channel_resp->header.pci_vendor_id);
+	CuAssertIntEquals (test, 0, channel_resp->header.rq);
+	CuAssertIntEquals (test, 0, channel_resp->header.d_bit);
+	CuAssertIntEquals (test, 0, channel_resp->header.crypt);
+	CuAssertIntEquals (test, 0x03, channel_resp->header.seq_num);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_GET_COMMAND_STATS, channel_resp->header.command);
+
+	CuAssertIntEquals (test, 0x02, channel_resp->channel_id);
+	CuAssertIntEquals (test, 0x04030201, channel_resp->rx_packets);
+	CuAssertIntEquals (test, 0x08070605, channel_resp->rx_errors);
+	CuAssertIntEquals (test, 0x0c0b0a09, channel_resp->rx_timeouts);
+	CuAssertIntEquals (test, 0x100f0e0d, channel_resp->dropped);
+	CuAssertIntEquals (test, 0x14131211, channel_resp->overflow);
+	CuAssertIntEquals (test, 0x18171615, channel_resp->tx_packets);
+	CuAssertIntEquals (test, 0x1c1b1a19, channel_resp->tx_errors);
+	CuAssertIntEquals (test, 0x201f1e1d, channel_resp->timeouts);
+}
 
 CuSuite* get_cerberus_protocol_optional_commands_suite ()
 {
@@ -7826,6 +8170,7 @@ CuSuite* get_cerberus_protocol_optional_commands_suite ()
 	SUITE_ADD_TEST (suite, cerberus_protocol_optional_commands_test_recover_firmware_format);
 	SUITE_ADD_TEST (suite, cerberus_protocol_optional_commands_test_message_unseal_format);
 	SUITE_ADD_TEST (suite ,cerberus_protocol_optional_commands_test_message_unseal_result_format);
+	SUITE_ADD_TEST (suite, cerberus_protocol_optional_commands_test_get_command_stats_format);
 
 	return suite;
 }
@@ -8,6 +8,7 @@
 #include <stddef.h>
 #include "testing.h"
 #include "cmd_interface/cmd_interface.h"
+#include "cmd_interface/cmd_stats.h"
 #include "attestation/pcr_store.h"
 #include "mock/firmware_update_control_mock.h"
 #include "mock/manifest_cmd_interface_mock.h"
@@ -384,5 +385,18 @@ void cerberus_protocol_optional_commands_testing_process_get_recovery_image_vers
 void cerberus_protocol_optional_commands_testing_process_get_recovery_image_version_bad_port_index (
 	CuTest *test, struct cmd_interface *cmd);
 
+void cerberus_protocol_optional_commands_testing_process_get_command_stats (CuTest *test,
+	struct cmd_interface *cmd);
+void cerberus_protocol_optional_commands_testing_process_get_command_stats_no_requests (
+	CuTest *test, struct cmd_interface *cmd);
+void cerberus_protocol_optional_commands_testing_process_get_command_stats_channel (CuTest *test,
+	struct cmd_interface *cmd, struct cmd_stats *stats);
+void cerberus_protocol_optional_commands_testing_process_get_command_stats_unknown_channel (
+	CuTest *test, struct cmd_interface *cmd);
+void cerberus_protocol_optional_commands_testing_process_get_command_stats_invalid_len (
+	CuTest *test, struct cmd_interface *cmd);
+void cerberus_protocol_optional_commands_testing_process_get_command_stats_invalid_type (
+	CuTest *test, struct cmd_interface *cmd);
+
 
 #endif /* CERBERUS_PROTOCOL_OPTIONAL_COMMANDS_TESTING_H_ */
@@ -0,0 +1,1112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "platform.h"
+#include "cmd_interface/cmd_channel_mux.h"
+#include "cmd_interface/cerberus_protocol.h"
+#include "mock/cmd_channel_mock.h"
+#include "mock/cmd_interface_mock.h"
+#include "crypto/checksum.h"
+
+
+static const char *SUITE = "cmd_channel_mux";
+
+
+/**
+ * The number of channels used for testing.
+ */
+#define	CMD_CHANNEL_MUX_TESTING_CHANNELS	2
+
+/**
+ * Dependencies for testing the command channel multiplexer.
+ */
+struct cmd_channel_mux_testing {
+	struct cmd_channel_mock channel[CMD_CHANNEL_MUX_TESTING_CHANNELS];	/**< Mock channels to service. */
+	struct mctp_interface mctp[CMD_CHANNEL_MUX_TESTING_CHANNELS];		/**< MCTP handler for each channel. */
+	struct cmd_interface_mock cmd;										/**< Mock command handler. */
+	struct device_manager device_mgr;									/**< Device manager for MCTP. */
+	struct cmd_channel_mux mux;											/**< The multiplexer under test. */
+};
+
+
+/**
+ * Initialize the multiplexer and all dependencies for testing.  Channels are not added to the
+ * multiplexer.
+ *
+ * @param test The test framework.
+ * @param testing The testing components to initialize.
+ */
+static void cmd_channel_mux_testing_init (CuTest *test, struct cmd_channel_mux_testing *testing)
+{
+	int status;
+	int i;
+
+	status = cmd_interface_mock_init (&testing->cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_init (&testing->device_mgr, 1, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < CMD_CHANNEL_MUX_TESTING_CHANNELS; i++) {
+		status = cmd_channel_mock_init (&testing->channel[i], i);
+		CuAssertIntEquals (test, 0, status);
+
+		status = mctp_interface_init (&testing->mctp[i], &testing->cmd.base, &testing->device_mgr,
+			MCTP_PROTOCOL_PA_ROT_CTRL_EID, CERBERUS_PROTOCOL_MSFT_PCI_VID,
+			CERBERUS_PROTOCOL_PROTOCOL_VERSION);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = cmd_channel_mux_init (&testing->mux);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Initialize the multiplexer for testing and add all channels.
+ *
+ * @param test The test framework.
+ * @param testing The testing components to initialize.
+ * @param priority0 The priority for channel 0.
+ * @param priority1 The priority for channel 1.
+ */
+static void cmd_channel_mux_testing_init_channels (CuTest *test,
+	struct cmd_channel_mux_testing *testing, enum cmd_channel_mux_priority priority0,
+	enum cmd_channel_mux_priority priority1)
+{
+	int status;
+
+	cmd_channel_mux_testing_init (test, testing);
+
+	status = cmd_channel_mux_add_channel (&testing->mux, &testing->channel[0].base,
+		&testing->mctp[0], priority0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mux_add_channel (&testing->mux, &testing->channel[1].base,
+		&testing->mctp[1], priority1);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release the test components and validate all mocks.
+ *
+ * @param test The test framework.
+ * @param testing The testing components to release.
+ */
+static void cmd_channel_mux_testing_release (CuTest *test, struct cmd_channel_mux_testing *testing)
+{
+	int status;
+	int i;
+
+	cmd_channel_mux_release (&testing->mux);
+
+	for (i = 0; i < CMD_CHANNEL_MUX_TESTING_CHANNELS; i++) {
+		status = cmd_channel_mock_validate_and_release (&testing->channel[i]);
+		CuAssertIntEquals (test, 0, status);
+
+		mctp_interface_deinit (&testing->mctp[i]);
+	}
+
+	status = cmd_interface_mock_validate_and_release (&testing->cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	device_manager_release (&testing->device_mgr);
+}
+
+/**
+ * Construct a received packet for a Cerberus protocol message.
+ *
+ * @param packet The packet to construct.
+ * @param command The command ID for the message.  This is only used for SOM packets.
+ * @param som Flag indicating the packet starts a message.
+ * @param eom Flag indicating the packet ends a message.
+ * @param seq The packet sequence number.
+ */
+static void cmd_channel_mux_testing_build_packet (struct cmd_packet *packet, uint8_t command,
+	bool som, bool eom, uint8_t seq)
+{
+	struct mctp_protocol_transport_header *header =
+		(struct mctp_protocol_transport_header*) packet->data;
+
+	memset (packet, 0, sizeof (struct cmd_packet));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_PROTOCOL_BMC_EID;
+	header->som = som;
+	header->eom = eom;
+	header->tag_owner = 1;
+	header->msg_tag = 0x00;
+	header->packet_seq = seq;
+
+	if (som) {
+		packet->data[7] = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+		packet->data[8] = 0x14;
+		packet->data[9] = 0x14;
+		packet->data[10] = 0x00;
+		packet->data[11] = command;
+	}
+	else {
+		packet->data[7] = 0x11;
+		packet->data[8] = 0x12;
+		packet->data[9] = 0x13;
+		packet->data[10] = 0x14;
+		packet->data[11] = 0x15;
+	}
+	packet->data[12] = 0x01;
+	packet->data[13] = 0x02;
+	packet->data[14] = 0x03;
+	packet->data[15] = 0x04;
+	packet->data[16] = 0x05;
+	packet->data[17] = checksum_crc8 (0xBA, packet->data, 17);
+	packet->pkt_size = 18;
+	packet->state = CMD_VALID_PACKET;
+	packet->dest_addr = 0x5D;
+}
+
+/**
+ * Set the expectation for polling a channel with no packet available.
+ *
+ * @param test The test framework.
+ * @param channel The channel to poll.
+ */
+static void cmd_channel_mux_testing_expect_no_packet (CuTest *test,
+	struct cmd_channel_mock *channel)
+{
+	int status;
+
+	status = mock_expect (&channel->mock, channel->base.receive_packet, channel,
+		CMD_CHANNEL_RX_TIMEOUT, MOCK_ARG_NOT_NULL, MOCK_ARG (0));
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Set the expectation for polling a channel that has a packet available.
+ *
+ * @param test The test framework.
+ * @param channel The channel to poll.
+ * @param packet The packet to receive.
+ */
+static void cmd_channel_mux_testing_expect_packet (CuTest *test, struct cmd_channel_mock *channel,
+	struct cmd_packet *packet)
+{
+	int status;
+
+	status = mock_expect (&channel->mock, channel->base.receive_packet, channel, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (0));
+	status |= mock_expect_output (&channel->mock, 0, packet, sizeof (struct cmd_packet), -1);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Set the expectation for processing a complete request and sending the response.
+ *
+ * @param test The test framework.
+ * @param testing The testing components.
+ * @param channel The channel that will send the response.
+ */
+static void cmd_channel_mux_testing_expect_response (CuTest *test,
+	struct cmd_channel_mux_testing *testing, struct cmd_channel_mock *channel)
+{
+	int status;
+
+	status = mock_expect (&testing->cmd.mock, testing->cmd.base.process_request, &testing->cmd, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&channel->mock, channel->base.send_packet, channel, 0,
+		MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Validate the current expectations for all mocks.
+ *
+ * @param test The test framework.
+ * @param testing The testing components.
+ */
+static void cmd_channel_mux_testing_validate (CuTest *test, struct cmd_channel_mux_testing *testing)
+{
+	int status;
+	int i;
+
+	for (i = 0; i < CMD_CHANNEL_MUX_TESTING_CHANNELS; i++) {
+		status = mock_validate (&testing->channel[i].mock);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = mock_validate (&testing->cmd.mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void cmd_channel_mux_test_init (CuTest *test)
+{
+	struct cmd_channel_mux mux;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_mux_init (&mux);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, mux.count);
+
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_PRIORITY_HIGH,
+		cmd_channel_mux_get_command_priority (&mux, CERBERUS_PROTOCOL_GET_HOST_STATE));
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_PRIORITY_HIGH,
+		cmd_channel_mux_get_command_priority (&mux, CERBERUS_PROTOCOL_GET_UPDATE_STATUS));
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_PRIORITY_HIGH,
+		cmd_channel_mux_get_command_priority (&mux, CERBERUS_PROTOCOL_GET_EXT_UPDATE_STATUS));
+
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_PRIORITY_LOW,
+		cmd_channel_mux_get_command_priority (&mux, CERBERUS_PROTOCOL_READ_LOG));
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_PRIORITY_LOW,
+		cmd_channel_mux_get_command_priority (&mux, CERBERUS_PROTOCOL_GET_ATTESTATION_DATA));
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_PRIORITY_LOW,
+		cmd_channel_mux_get_command_priority (&mux, CERBERUS_PROTOCOL_PFM_UPDATE));
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_PRIORITY_LOW,
+		cmd_channel_mux_get_command_priority (&mux, CERBERUS_PROTOCOL_CFM_UPDATE));
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_PRIORITY_LOW,
+		cmd_channel_mux_get_command_priority (&mux, CERBERUS_PROTOCOL_PCD_UPDATE));
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_PRIORITY_LOW,
+		cmd_channel_mux_get_command_priority (&mux, CERBERUS_PROTOCOL_FW_UPDATE));
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_PRIORITY_LOW,
+		cmd_channel_mux_get_command_priority (&mux, CERBERUS_PROTOCOL_UPDATE_RECOVERY_IMAGE));
+
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_PRIORITY_NORMAL,
+		cmd_channel_mux_get_command_priority (&mux, CERBERUS_PROTOCOL_GET_FW_VERSION));
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_PRIORITY_NORMAL,
+		cmd_channel_mux_get_command_priority (&mux, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE));
+
+	cmd_channel_mux_release (&mux);
+}
+
+static void cmd_channel_mux_test_init_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_mux_init (NULL);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_INVALID_ARGUMENT, status);
+}
+
+static void cmd_channel_mux_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	cmd_channel_mux_release (NULL);
+}
+
+static void cmd_channel_mux_test_add_channel (CuTest *test)
+{
+	struct cmd_channel_mux_testing testing;
+	int status;
+
+	TEST_START;
+
+	cmd_channel_mux_testing_init (test, &testing);
+
+	status = cmd_channel_mux_add_channel (&testing.mux, &testing.channel[0].base,
+		&testing.mctp[0], CMD_CHANNEL_MUX_PRIORITY_HIGH);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, testing.mux.count);
+
+	status = cmd_channel_mux_add_channel (&testing.mux, &testing.channel[1].base,
+		&testing.mctp[1], CMD_CHANNEL_MUX_PRIORITY_LOW);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, testing.mux.count);
+
+	CuAssertPtrEquals (test, &testing.channel[0].base, testing.mux.entry[0].channel);
+	CuAssertPtrEquals (test, &testing.mctp[0], testing.mux.entry[0].mctp);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_PRIORITY_HIGH, testing.mux.entry[0].priority);
+
+	CuAssertPtrEquals (test, &testing.channel[1].base, testing.mux.entry[1].channel);
+	CuAssertPtrEquals (test, &testing.mctp[1], testing.mux.entry[1].mctp);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_PRIORITY_LOW, testing.mux.entry[1].priority);
+
+	cmd_channel_mux_testing_release (test, &testing);
+}
+
+static void cmd_channel_mux_test_add_channel_duplicate (CuTest *test)
+{
+	struct cmd_channel_mux_testing testing;
+	int status;
+
+	TEST_START;
+
+	cmd_channel_mux_testing_init (test, &testing);
+
+	status = cmd_channel_mux_add_channel (&testing.mux, &testing.channel[0].base,
+		&testing.mctp[0], CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mux_add_channel (&testing.mux, &testing.channel[0].base,
+		&testing.mctp[1], CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_DUPLICATE_CHANNEL, status);
+
+	status = cmd_channel_mux_add_channel (&testing.mux, &testing.channel[1].base,
+		&testing.mctp[0], CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_DUPLICATE_CHANNEL, status);
+
+	CuAssertIntEquals (test, 1, testing.mux.count);
+
+	cmd_channel_mux_testing_release (test, &testing);
+}
+
+static void cmd_channel_mux_test_add_channel_full (CuTest *test)
+{
+	struct cmd_channel_mux_testing testing;
+	struct cmd_channel_mock channel[CMD_CHANNEL_MUX_MAX_CHANNELS + 1];
+	struct mctp_interface mctp[CMD_CHANNEL_MUX_MAX_CHANNELS + 1];
+	int status;
+	int i;
+
+	TEST_START;
+
+	cmd_channel_mux_testing_init (test, &testing);
+
+	for (i = 0; i < CMD_CHANNEL_MUX_MAX_CHANNELS; i++) {
+		status = cmd_channel_mux_add_channel (&testing.mux, &channel[i].base, &mctp[i],
+			CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = cmd_channel_mux_add_channel (&testing.mux, &channel[i].base, &mctp[i],
+		CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_FULL, status);
+
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_MAX_CHANNELS, testing.mux.count);
+
+	cmd_channel_mux_testing_release (test, &testing);
+}
+
+static void cmd_channel_mux_test_add_channel_null (CuTest *test)
+{
+	struct cmd_channel_mux_testing testing;
+	int status;
+
+	TEST_START;
+
+	cmd_channel_mux_testing_init (test, &testing);
+
+	status = cmd_channel_mux_add_channel (NULL, &testing.channel[0].base, &testing.mctp[0],
+		CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_mux_add_channel (&testing.mux, NULL, &testing.mctp[0],
+		CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_mux_add_channel (&testing.mux, &testing.channel[0].base, NULL,
+		CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_mux_add_channel (&testing.mux, &testing.channel[0].base,
+		&testing.mctp[0], CMD_CHANNEL_MUX_PRIORITY_COUNT);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_INVALID_ARGUMENT, status);
+
+	CuAssertIntEquals (test, 0, testing.mux.count);
+
+	cmd_channel_mux_testing_release (test, &testing);
+}
+
+static void cmd_channel_mux_test_set_command_priority (CuTest *test)
+{
+	struct cmd_channel_mux mux;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_mux_init (&mux);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mux_set_command_priority (&mux, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE,
+		CMD_CHANNEL_MUX_PRIORITY_LOW);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mux_set_command_priority (&mux, CERBERUS_PROTOCOL_READ_LOG,
+		CMD_CHANNEL_MUX_PRIORITY_HIGH);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_PRIORITY_LOW,
+		cmd_channel_mux_get_command_priority (&mux, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE));
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_PRIORITY_HIGH,
+		cmd_channel_mux_get_command_priority (&mux, CERBERUS_PROTOCOL_READ_LOG));
+
+	cmd_channel_mux_release (&mux);
+}
+
+static void cmd_channel_mux_test_set_command_priority_null (CuTest *test)
+{
+	struct cmd_channel_mux mux;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_mux_init (&mux);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mux_set_command_priority (NULL, CERBERUS_PROTOCOL_READ_LOG,
+		CMD_CHANNEL_MUX_PRIORITY_HIGH);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_mux_set_command_priority (&mux, CERBERUS_PROTOCOL_READ_LOG,
+		CMD_CHANNEL_MUX_PRIORITY_COUNT);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_INVALID_ARGUMENT, status);
+
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_PRIORITY_LOW,
+		cmd_channel_mux_get_command_priority (&mux, CERBERUS_PROTOCOL_READ_LOG));
+
+	cmd_channel_mux_release (&mux);
+}
+
+static void cmd_channel_mux_test_get_command_priority_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_mux_get_command_priority (NULL, CERBERUS_PROTOCOL_READ_LOG);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_INVALID_ARGUMENT, status);
+}
+
+static void cmd_channel_mux_test_process_next_no_packets (CuTest *test)
+{
+	struct cmd_channel_mux_testing testing;
+	struct cmd_channel_stats stats;
+	int status;
+
+	TEST_START;
+
+	cmd_channel_mux_testing_init_channels (test, &testing, CMD_CHANNEL_MUX_PRIORITY_NORMAL,
+		CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[0]);
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[1]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_NO_PACKET, status);
+
+	status = cmd_channel_get_stats (&testing.channel[0].base, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.rx_packets);
+	CuAssertIntEquals (test, 0, stats.rx_errors);
+	CuAssertIntEquals (test, 0, stats.rx_timeouts);
+
+	cmd_channel_mux_testing_release (test, &testing);
+}
+
+static void cmd_channel_mux_test_process_next_no_channels (CuTest *test)
+{
+	struct cmd_channel_mux mux;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_mux_init (&mux);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mux_process_next (&mux);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_NO_PACKET, status);
+
+	cmd_channel_mux_release (&mux);
+}
+
+static void cmd_channel_mux_test_process_next_single_packet (CuTest *test)
+{
+	struct cmd_channel_mux_testing testing;
+	struct cmd_packet packet;
+	struct cmd_channel_stats stats;
+	int status;
+
+	TEST_START;
+
+	cmd_channel_mux_testing_init_channels (test, &testing, CMD_CHANNEL_MUX_PRIORITY_NORMAL,
+		CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+
+	cmd_channel_mux_testing_build_packet (&packet, CERBERUS_PROTOCOL_GET_FW_VERSION, true, true,
+		0);
+
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[0]);
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[1], &packet);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[1]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_get_stats (&testing.channel[1].base, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.rx_packets);
+	CuAssertIntEquals (test, 0, stats.rx_errors);
+	CuAssertIntEquals (test, 0, stats.dropped);
+	CuAssertIntEquals (test, 1, stats.tx_packets);
+
+	status = cmd_channel_get_stats (&testing.channel[0].base, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.rx_packets);
+	CuAssertIntEquals (test, 0, stats.tx_packets);
+
+	cmd_channel_mux_testing_release (test, &testing);
+}
+
+static void cmd_channel_mux_test_process_next_command_priority (CuTest *test)
+{
+	struct cmd_channel_mux_testing testing;
+	struct cmd_packet bulk;
+	struct cmd_packet critical;
+	int status;
+
+	TEST_START;
+
+	cmd_channel_mux_testing_init_channels (test, &testing, CMD_CHANNEL_MUX_PRIORITY_NORMAL,
+		CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+
+	cmd_channel_mux_testing_build_packet (&bulk, CERBERUS_PROTOCOL_READ_LOG, true, true, 0);
+	cmd_channel_mux_testing_build_packet (&critical, CERBERUS_PROTOCOL_GET_HOST_STATE, true, true,
+		0);
+
+	/* The latency critical request is processed first. */
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[0], &bulk);
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[1], &critical);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[1]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_validate (test, &testing);
+
+	/* The bulk request is still queued and does not need to be received again. */
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[0]);
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[1]);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[0]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_release (test, &testing);
+}
+
+static void cmd_channel_mux_test_process_next_channel_priority (CuTest *test)
+{
+	struct cmd_channel_mux_testing testing;
+	struct cmd_packet packet;
+	int status;
+
+	TEST_START;
+
+	cmd_channel_mux_testing_init_channels (test, &testing, CMD_CHANNEL_MUX_PRIORITY_LOW,
+		CMD_CHANNEL_MUX_PRIORITY_HIGH);
+
+	cmd_channel_mux_testing_build_packet (&packet, CERBERUS_PROTOCOL_GET_FW_VERSION, true, true,
+		0);
+
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[0], &packet);
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[1], &packet);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[1]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_validate (test, &testing);
+
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[0]);
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[1]);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[0]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_release (test, &testing);
+}
+
+static void cmd_channel_mux_test_process_next_command_priority_over_channel (CuTest *test)
+{
+	struct cmd_channel_mux_testing testing;
+	struct cmd_packet bulk;
+	struct cmd_packet critical;
+	int status;
+
+	TEST_START;
+
+	cmd_channel_mux_testing_init_channels (test, &testing, CMD_CHANNEL_MUX_PRIORITY_HIGH,
+		CMD_CHANNEL_MUX_PRIORITY_LOW);
+
+	cmd_channel_mux_testing_build_packet (&bulk, CERBERUS_PROTOCOL_FW_UPDATE, true, true, 0);
+	cmd_channel_mux_testing_build_packet (&critical, CERBERUS_PROTOCOL_GET_UPDATE_STATUS, true,
+		true, 0);
+
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[0], &bulk);
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[1], &critical);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[1]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_validate (test, &testing);
+
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[0]);
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[1]);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[0]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_release (test, &testing);
+}
+
+static void cmd_channel_mux_test_process_next_round_robin (CuTest *test)
+{
+	struct cmd_channel_mux_testing testing;
+	struct cmd_packet packet;
+	int status;
+
+	TEST_START;
+
+	cmd_channel_mux_testing_init_channels (test, &testing, CMD_CHANNEL_MUX_PRIORITY_NORMAL,
+		CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+
+	cmd_channel_mux_testing_build_packet (&packet, CERBERUS_PROTOCOL_GET_FW_VERSION, true, true,
+		0);
+
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[0], &packet);
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[1], &packet);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[0]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_validate (test, &testing);
+
+	/* Channel 0 has another request, but channel 1 has been waiting longer. */
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[0], &packet);
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[1]);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[1]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_validate (test, &testing);
+
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[0]);
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[1], &packet);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[0]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_validate (test, &testing);
+
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[0]);
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[1]);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[1]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_release (test, &testing);
+}
+
+static void cmd_channel_mux_test_process_next_starvation (CuTest *test)
+{
+	struct cmd_channel_mux_testing testing;
+	struct cmd_packet bulk;
+	struct cmd_packet critical;
+	int status;
+	int i;
+
+	TEST_START;
+
+	cmd_channel_mux_testing_init_channels (test, &testing, CMD_CHANNEL_MUX_PRIORITY_NORMAL,
+		CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+
+	cmd_channel_mux_testing_build_packet (&bulk, CERBERUS_PROTOCOL_READ_LOG, true, true, 0);
+	cmd_channel_mux_testing_build_packet (&critical, CERBERUS_PROTOCOL_GET_HOST_STATE, true, true,
+		0);
+
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[0], &bulk);
+
+	for (i = 0; i < CMD_CHANNEL_MUX_MAX_SKIPS; i++) {
+		if (i != 0) {
+			cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[0]);
+		}
+		cmd_channel_mux_testing_expect_packet (test, &testing.channel[1], &critical);
+		cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[1]);
+
+		status = cmd_channel_mux_process_next (&testing.mux);
+		CuAssertIntEquals (test, 0, status);
+
+		cmd_channel_mux_testing_validate (test, &testing);
+	}
+
+	/* The bulk request has waited long enough and is processed ahead of new requests. */
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[0]);
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[1], &critical);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[0]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_validate (test, &testing);
+
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[0]);
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[1]);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[1]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_release (test, &testing);
+}
+
+static void cmd_channel_mux_test_process_next_multi_packet_message (CuTest *test)
+{
+	struct cmd_channel_mux_testing testing;
+	struct cmd_packet first;
+	struct cmd_packet last;
+	struct cmd_packet packet;
+	int status;
+
+	TEST_START;
+
+	cmd_channel_mux_testing_init_channels (test, &testing, CMD_CHANNEL_MUX_PRIORITY_NORMAL,
+		CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+
+	cmd_channel_mux_testing_build_packet (&first, CERBERUS_PROTOCOL_PFM_UPDATE, true, false, 0);
+	cmd_channel_mux_testing_build_packet (&last, 0, false, true, 1);
+	cmd_channel_mux_testing_build_packet (&packet, CERBERUS_PROTOCOL_GET_FW_VERSION, true, true,
+		0);
+
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[0], &first);
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[1]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_validate (test, &testing);
+
+	/* The rest of the bulk message has the same priority as the start of the message. */
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[0], &last);
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[1], &packet);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[1]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_validate (test, &testing);
+
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[0]);
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[1]);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[0]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_release (test, &testing);
+}
+
+static void cmd_channel_mux_test_process_next_queue_packets (CuTest *test)
+{
+	struct cmd_channel_mux_testing testing;
+	struct cmd_packet bulk;
+	struct cmd_packet critical;
+	struct cmd_channel_stats stats;
+	int status;
+	int i;
+
+	TEST_START;
+
+	cmd_channel_mux_testing_init_channels (test, &testing, CMD_CHANNEL_MUX_PRIORITY_NORMAL,
+		CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+
+	cmd_channel_mux_testing_build_packet (&bulk, CERBERUS_PROTOCOL_READ_LOG, true, true, 0);
+	cmd_channel_mux_testing_build_packet (&critical, CERBERUS_PROTOCOL_GET_HOST_STATE, true, true,
+		0);
+
+	/* Bulk requests are queued while critical requests are processed. */
+	for (i = 0; i < CMD_CHANNEL_MUX_QUEUE_DEPTH; i++) {
+		cmd_channel_mux_testing_expect_packet (test, &testing.channel[0], &bulk);
+		cmd_channel_mux_testing_expect_packet (test, &testing.channel[1], &critical);
+		cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[1]);
+
+		status = cmd_channel_mux_process_next (&testing.mux);
+		CuAssertIntEquals (test, 0, status);
+
+		cmd_channel_mux_testing_validate (test, &testing);
+	}
+
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_QUEUE_DEPTH, testing.mux.entry[0].pending);
+
+	/* The queue is full, so the channel is not polled. */
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[1], &critical);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[1]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_validate (test, &testing);
+
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[1]);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[0]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_validate (test, &testing);
+
+	for (i = 1; i < CMD_CHANNEL_MUX_QUEUE_DEPTH; i++) {
+		cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[0]);
+		cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[1]);
+		cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[0]);
+
+		status = cmd_channel_mux_process_next (&testing.mux);
+		CuAssertIntEquals (test, 0, status);
+
+		cmd_channel_mux_testing_validate (test, &testing);
+	}
+
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[0]);
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[1]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_NO_PACKET, status);
+
+	status = cmd_channel_get_stats (&testing.channel[0].base, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_QUEUE_DEPTH, stats.rx_packets);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_QUEUE_DEPTH, stats.tx_packets);
+
+	cmd_channel_mux_testing_release (test, &testing);
+}
+
+static void cmd_channel_mux_test_process_next_shared_handler_busy (CuTest *test)
+{
+	struct cmd_channel_mux_testing testing;
+	struct cmd_packet packet;
+	int status;
+
+	TEST_START;
+
+	cmd_channel_mux_testing_init_channels (test, &testing, CMD_CHANNEL_MUX_PRIORITY_NORMAL,
+		CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+
+	cmd_channel_mux_testing_build_packet (&packet, CERBERUS_PROTOCOL_GET_FW_VERSION, true, true,
+		0);
+
+	/* Both channels use the same command handler, so channel 1 must wait while channel 0 is being
+	 * processed by another context. */
+	testing.mux.entry[0].busy = true;
+
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[0]);
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[1], &packet);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_NO_PACKET, status);
+	CuAssertIntEquals (test, 1, testing.mux.entry[1].pending);
+
+	cmd_channel_mux_testing_validate (test, &testing);
+
+	testing.mux.entry[0].busy = false;
+
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[0]);
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[1]);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[1]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_release (test, &testing);
+}
+
+static void cmd_channel_mux_test_process_next_shared_device_manager_busy (CuTest *test)
+{
+	struct cmd_channel_mux_testing testing;
+	struct cmd_interface_mock cmd;
+	struct cmd_packet packet;
+	int status;
+
+	TEST_START;
+
+	status = cmd_interface_mock_init (&cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_init (test, &testing);
+
+	mctp_interface_deinit (&testing.mctp[1]);
+	status = mctp_interface_init (&testing.mctp[1], &cmd.base, &testing.device_mgr,
+		MCTP_PROTOCOL_PA_ROT_CTRL_EID, CERBERUS_PROTOCOL_MSFT_PCI_VID,
+		CERBERUS_PROTOCOL_PROTOCOL_VERSION);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mux_add_channel (&testing.mux, &testing.channel[0].base,
+		&testing.mctp[0], CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mux_add_channel (&testing.mux, &testing.channel[1].base,
+		&testing.mctp[1], CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_build_packet (&packet, CERBERUS_PROTOCOL_GET_FW_VERSION, true, true,
+		0);
+
+	testing.mux.entry[0].busy = true;
+
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[0]);
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[1], &packet);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_NO_PACKET, status);
+	CuAssertIntEquals (test, 1, testing.mux.entry[1].pending);
+
+	status = cmd_interface_mock_validate_and_release (&cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_release (test, &testing);
+}
+
+static void cmd_channel_mux_test_process_next_independent_handler_busy (CuTest *test)
+{
+	struct cmd_channel_mux_testing testing;
+	struct cmd_interface_mock cmd;
+	struct device_manager device_mgr;
+	struct cmd_packet packet;
+	int status;
+
+	TEST_START;
+
+	status = cmd_interface_mock_init (&cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_init (&device_mgr, 1, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_init (test, &testing);
+
+	mctp_interface_deinit (&testing.mctp[1]);
+	status = mctp_interface_init (&testing.mctp[1], &cmd.base, &device_mgr,
+		MCTP_PROTOCOL_PA_ROT_CTRL_EID, CERBERUS_PROTOCOL_MSFT_PCI_VID,
+		CERBERUS_PROTOCOL_PROTOCOL_VERSION);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mux_add_channel (&testing.mux, &testing.channel[0].base,
+		&testing.mctp[0], CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mux_add_channel (&testing.mux, &testing.channel[1].base,
+		&testing.mctp[1], CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_build_packet (&packet, CERBERUS_PROTOCOL_GET_FW_VERSION, true, true,
+		0);
+
+	/* Channel 1 does not share any state with channel 0, so it can be processed concurrently. */
+	testing.mux.entry[0].busy = true;
+
+	cmd_channel_mux_testing_expect_no_packet (test, &testing.channel[0]);
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[1], &packet);
+
+	status = mock_expect (&cmd.mock, cmd.base.process_request, &cmd, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&testing.channel[1].mock, testing.channel[1].base.send_packet,
+		&testing.channel[1], 0, MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, testing.mux.entry[1].pending);
+
+	status = cmd_interface_mock_validate_and_release (&cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_release (test, &testing);
+
+	device_manager_release (&device_mgr);
+}
+
+static void cmd_channel_mux_test_process_next_receive_error (CuTest *test)
+{
+	struct cmd_channel_mux_testing testing;
+	struct cmd_packet packet;
+	struct cmd_channel_stats stats;
+	int status;
+
+	TEST_START;
+
+	cmd_channel_mux_testing_init_channels (test, &testing, CMD_CHANNEL_MUX_PRIORITY_NORMAL,
+		CMD_CHANNEL_MUX_PRIORITY_NORMAL);
+
+	cmd_channel_mux_testing_build_packet (&packet, CERBERUS_PROTOCOL_GET_FW_VERSION, true, true,
+		0);
+
+	status = mock_expect (&testing.channel[0].mock, testing.channel[0].base.receive_packet,
+		&testing.channel[0], CMD_CHANNEL_RX_FAILED, MOCK_ARG_NOT_NULL, MOCK_ARG (0));
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mux_testing_expect_packet (test, &testing.channel[1], &packet);
+	cmd_channel_mux_testing_expect_response (test, &testing, &testing.channel[1]);
+
+	status = cmd_channel_mux_process_next (&testing.mux);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_get_stats (&testing.channel[0].base, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.rx_packets);
+	CuAssertIntEquals (test, 1, stats.rx_errors);
+
+	cmd_channel_mux_testing_release (test, &testing);
+}
+
+static void cmd_channel_mux_test_process_next_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_mux_process_next (NULL);
+	CuAssertIntEquals (test, CMD_CHANNEL_MUX_INVALID_ARGUMENT, status);
+}
+
+
+CuSuite* get_cmd_channel_mux_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_init);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_init_null);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_release_null);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_add_channel);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_add_channel_duplicate);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_add_channel_full);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_add_channel_null);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_set_command_priority);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_set_command_priority_null);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_get_command_priority_null);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_process_next_no_packets);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_process_next_no_channels);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_process_next_single_packet);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_process_next_command_priority);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_process_next_channel_priority);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_process_next_command_priority_over_channel);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_process_next_round_robin);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_process_next_starvation);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_process_next_multi_packet_message);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_process_next_queue_packets);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_process_next_shared_handler_busy);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_process_next_shared_device_manager_busy);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_process_next_independent_handler_busy);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_process_next_receive_error);
+	SUITE_ADD_TEST (suite, cmd_channel_mux_test_process_next_null);
+
+	return suite;
+}
@@ -68,6 +68,75 @@ static void cmd_channel_test_get_id_null (CuTest *test)
 	cmd_channel_mock_release (&channel);
 }
 
+static void cmd_channel_test_get_stats_init (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_channel_stats stats;
+	struct cmd_channel_stats zero;
+	int status;
+
+	TEST_START;
+
+	memset (&stats, 0xff, sizeof (stats));
+	memset (&zero, 0, sizeof (zero));
+
+	status = cmd_channel_mock_init (&channel, 10);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_get_stats (&channel.base, &stats);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array ((uint8_t*) &zero, (uint8_t*) &stats, sizeof (stats));
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_mock_release (&channel);
+}
+
+static void cmd_channel_test_get_stats_null (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_channel_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_mock_init (&channel, 10);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_get_stats (NULL, &stats);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_get_stats (&channel.base, NULL);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	cmd_channel_mock_release (&channel);
+}
+
+static void cmd_channel_test_increment_counter (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_channel_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_mock_init (&channel, 10);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_increment_counter (&channel.base, &channel.base.stats.tx_packets);
+	cmd_channel_increment_counter (&channel.base, &channel.base.stats.tx_packets);
+	cmd_channel_increment_counter (&channel.base, &channel.base.stats.tx_errors);
+
+	status = cmd_channel_get_stats (&channel.base, &stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, stats.rx_packets);
+	CuAssertIntEquals (test, 2, stats.tx_packets);
+	CuAssertIntEquals (test, 1, stats.tx_errors);
+
+	cmd_channel_mock_release (&channel);
+}
+
 static void cmd_channel_test_receive_and_process_single_packet_response (CuTest *test)
 {
 	struct cmd_channel_mock channel;
@@ -80,6 +149,7 @@ static void cmd_channel_test_receive_and_process_single_packet_response (CuTest
 	struct cmd_interface_request response;
 	struct mctp_protocol_transport_header *header =
 		(struct mctp_protocol_transport_header*) rx_packet.data;
+	struct cmd_channel_stats stats;
 	int status;
 
 	TEST_START;
@@ -193,6 +263,17 @@ static void cmd_channel_test_receive_and_process_single_packet_response (CuTest
 	status = cmd_channel_receive_and_process (&channel.base, &mctp, -1);
 	CuAssertIntEquals (test, 0, status);
 
+	status = cmd_channel_get_stats (&channel.base, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.rx_packets);
+	CuAssertIntEquals (test, 0, stats.rx_errors);
+	CuAssertIntEquals (test, 0, stats.rx_timeouts);
+	CuAssertIntEquals (test, 0, stats.dropped);
+	CuAssertIntEquals (test, 0, stats.overflow);
+	CuAssertIntEquals (test, 1, stats.tx_packets);
+	CuAssertIntEquals (test, 0, stats.tx_errors);
+	CuAssertIntEquals (test, 0, stats.timeouts);
+
 	status = cmd_channel_mock_validate_and_release (&channel);
 	CuAssertIntEquals (test, 0, status);
 
@@ -554,6 +635,7 @@ static void cmd_channel_test_receive_and_process_request_processing_timeout (CuT
 	struct cmd_interface_mock cmd;
 	struct device_manager device_mgr;
 	struct mctp_interface mctp;
+	struct cmd_channel_stats stats;
 	int status;
 	struct cmd_packet rx_packet;
 	struct cmd_interface_request request;
@@ -642,6 +724,17 @@ static void cmd_channel_test_receive_and_process_request_processing_timeout (CuT
 	status = cmd_channel_receive_and_process (&channel.base, &mctp, -1);
 	CuAssertIntEquals (test, 0, status);
 
+	status = cmd_channel_get_stats (&channel.base, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.rx_packets);
+	CuAssertIntEquals (test, 0, stats.rx_errors);
+	CuAssertIntEquals (test, 0, stats.rx_timeouts);
+	CuAssertIntEquals (test, 0, stats.dropped);
+	CuAssertIntEquals (test, 0, stats.overflow);
+	CuAssertIntEquals (test, 0, stats.tx_packets);
+	CuAssertIntEquals (test, 0, stats.tx_errors);
+	CuAssertIntEquals (test, 1, stats.timeouts);
+
 	status = cmd_channel_mock_validate_and_release (&channel);
 	CuAssertIntEquals (test, 0, status);
 
@@ -1124,6 +1217,7 @@ static void cmd_channel_test_receive_and_process_send_failure (CuTest *test)
 	struct cmd_interface_mock cmd;
 	struct device_manager device_mgr;
 	struct mctp_interface mctp;
+	struct cmd_channel_stats stats;
 	int status;
 	struct cmd_packet rx_packet;
 	struct cmd_packet tx_packet[2];
@@ -1272,6 +1366,17 @@ static void cmd_channel_test_receive_and_process_send_failure (CuTest *test)
 	status = cmd_channel_receive_and_process (&channel.base, &mctp, -1);
 	CuAssertIntEquals (test, CMD_CHANNEL_TX_FAILED, status);
 
+	status = cmd_channel_get_stats (&channel.base, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.rx_packets);
+	CuAssertIntEquals (test, 0, stats.rx_errors);
+	CuAssertIntEquals (test, 0, stats.rx_timeouts);
+	CuAssertIntEquals (test, 0, stats.dropped);
+	CuAssertIntEquals (test, 0, stats.overflow);
+	CuAssertIntEquals (test, 0, stats.tx_packets);
+	CuAssertIntEquals (test, 1, stats.tx_errors);
+	CuAssertIntEquals (test, 0, stats.timeouts);
+
 	status = cmd_channel_mock_validate_and_release (&channel);
 	CuAssertIntEquals (test, 0, status);
 
@@ -1472,6 +1577,7 @@ static void cmd_channel_test_receive_and_process_receive_failure (CuTest *test)
 	struct cmd_interface_mock cmd;
 	struct device_manager device_mgr;
 	struct mctp_interface mctp;
+	struct cmd_channel_stats stats;
 	int status;
 	struct cmd_packet rx_packet[2];
 	struct cmd_packet tx_packet;
@@ -1645,6 +1751,17 @@ static void cmd_channel_test_receive_and_process_receive_failure (CuTest *test)
 	status = cmd_channel_receive_and_process (&channel.base, &mctp, -1);
 	CuAssertIntEquals (test, 0, status);
 
+	status = cmd_channel_get_stats (&channel.base, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, stats.rx_packets);
+	CuAssertIntEquals (test, 1, stats.rx_errors);
+	CuAssertIntEquals (test, 0, stats.rx_timeouts);
+	CuAssertIntEquals (test, 0, stats.dropped);
+	CuAssertIntEquals (test, 0, stats.overflow);
+	CuAssertIntEquals (test, 1, stats.tx_packets);
+	CuAssertIntEquals (test, 0, stats.tx_errors);
+	CuAssertIntEquals (test, 0, stats.timeouts);
+
 	status = cmd_channel_mock_validate_and_release (&channel);
 	CuAssertIntEquals (test, 0, status);
 
@@ -1662,6 +1779,7 @@ static void cmd_channel_test_receive_and_process_receive_timeout (CuTest *test)
 	struct cmd_interface_mock cmd;
 	struct device_manager device_mgr;
 	struct mctp_interface mctp;
+	struct cmd_channel_stats stats;
 	int status;
 	struct cmd_packet rx_packet[2];
 	struct cmd_packet tx_packet;
@@ -1835,6 +1953,17 @@ static void cmd_channel_test_receive_and_process_receive_timeout (CuTest *test)
 	status = cmd_channel_receive_and_process (&channel.base, &mctp, -1);
 	CuAssertIntEquals (test, 0, status);
 
+	status = cmd_channel_get_stats (&channel.base, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, stats.rx_packets);
+	CuAssertIntEquals (test, 0, stats.rx_errors);
+	CuAssertIntEquals (test, 1, stats.rx_timeouts);
+	CuAssertIntEquals (test, 0, stats.dropped);
+	CuAssertIntEquals (test, 0, stats.overflow);
+	CuAssertIntEquals (test, 1, stats.tx_packets);
+	CuAssertIntEquals (test, 0, stats.tx_errors);
+	CuAssertIntEquals (test, 0, stats.timeouts);
+
 	status = cmd_channel_mock_validate_and_release (&channel);
 	CuAssertIntEquals (test, 0, status);
 
@@ -1852,6 +1981,7 @@ static void cmd_channel_test_receive_and_process_overflow_packet (CuTest *test)
 	struct cmd_interface_mock cmd;
 	struct device_manager device_mgr;
 	struct mctp_interface mctp;
+	struct cmd_channel_stats stats;
 	int status;
 	struct cmd_packet rx_packet[4];
 	struct cmd_packet tx_packet;
@@ -2052,6 +2182,17 @@ static void cmd_channel_test_receive_and_process_overflow_packet (CuTest *test)
 	status = cmd_channel_receive_and_process (&channel.base, &mctp, -1);
 	CuAssertIntEquals (test, 0, status);
 
+	status = cmd_channel_get_stats (&channel.base, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 4, stats.rx_packets);
+	CuAssertIntEquals (test, 0, stats.rx_errors);
+	CuAssertIntEquals (test, 0, stats.rx_timeouts);
+	CuAssertIntEquals (test, 1, stats.dropped);
+	CuAssertIntEquals (test, 1, stats.overflow);
+	CuAssertIntEquals (test, 1, stats.tx_packets);
+	CuAssertIntEquals (test, 0, stats.tx_errors);
+	CuAssertIntEquals (test, 0, stats.timeouts);
+
 	status = cmd_channel_mock_validate_and_release (&channel);
 	CuAssertIntEquals (test, 0, status);
 
@@ -2311,6 +2452,9 @@ CuSuite* get_cmd_channel_suite ()
 	SUITE_ADD_TEST (suite, cmd_channel_test_release_null);
 	SUITE_ADD_TEST (suite, cmd_channel_test_get_id);
 	SUITE_ADD_TEST (suite, cmd_channel_test_get_id_null);
+	SUITE_ADD_TEST (suite, cmd_channel_test_get_stats_init);
+	SUITE_ADD_TEST (suite, cmd_channel_test_get_stats_null);
+	SUITE_ADD_TEST (suite, cmd_channel_test_increment_counter);
 	SUITE_ADD_TEST (suite, cmd_channel_test_receive_and_process_single_packet_response);
 	SUITE_ADD_TEST (suite, cmd_channel_test_receive_and_process_multi_packet_response);
 	SUITE_ADD_TEST (suite, cmd_channel_test_receive_and_process_multi_packet_message);
@@ -0,0 +1,549 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "platform.h"
+#include "cmd_interface/cmd_deferred.h"
+#include "cmd_interface/cerberus_protocol.h"
+
+
+static const char *SUITE = "cmd_deferred";
+
+
+/**
+ * Execution context for testing deferred requests.
+ */
+struct cmd_deferred_testing {
+	struct cmd_deferred deferred;				/**< The handler under test. */
+	int calls;									/**< Number of times a request was executed. */
+	int result;									/**< Result to report for execution. */
+	uint8_t last_command;						/**< The last command executed. */
+};
+
+/**
+ * Execution handler for tests.  The response will be the request with every byte inverted.
+ */
+static int cmd_deferred_testing_execute (struct cmd_deferred *deferred,
+	struct cmd_interface_request *request)
+{
+	struct cmd_deferred_testing *testing = (struct cmd_deferred_testing*) deferred;
+	size_t i;
+
+	testing->calls++;
+	testing->last_command = ((struct cerberus_protocol_header*) request->data)->command;
+
+	for (i = 0; i < request->length; i++) {
+		request->data[i] = ~request->data[i];
+	}
+	request->data[request->length] = 0x55;
+	request->length++;
+
+	return testing->result;
+}
+
+/**
+ * Build a request for testing.
+ *
+ * @param request The request to initialize.
+ * @param command The command ID for the request.
+ * @param payload Payload byte to add to the request.
+ * @param eid Source EID for the request.
+ */
+static void cmd_deferred_testing_request (struct cmd_interface_request *request, uint8_t command,
+	uint8_t payload, uint8_t eid)
+{
+	struct cerberus_protocol_header *header = (struct cerberus_protocol_header*) request->data;
+
+	memset (request, 0, sizeof (struct cmd_interface_request));
+
+	header->msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	header->pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	header->command = command;
+	request->data[CERBERUS_PROTOCOL_MIN_MSG_LEN] = payload;
+	request->length = CERBERUS_PROTOCOL_MIN_MSG_LEN + 1;
+	request->max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+	request->source_eid = eid;
+	request->target_eid = 0x0b;
+}
+
+/**
+ * Initialize a handler for testing.
+ *
+ * @param test The test framework.
+ * @param testing The testing context to initialize.
+ */
+static void cmd_deferred_testing_init (CuTest *test, struct cmd_deferred_testing *testing)
+{
+	int status;
+
+	status = cmd_deferred_init (&testing->deferred, cmd_deferred_testing_execute);
+	CuAssertIntEquals (test, 0, status);
+
+	testing->calls = 0;
+	testing->result = 0;
+	testing->last_command = 0;
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void cmd_deferred_test_init (CuTest *test)
+{
+	struct cmd_deferred_testing testing;
+	int i;
+
+	TEST_START;
+
+	cmd_deferred_testing_init (test, &testing);
+
+	CuAssertPtrEquals (test, cmd_deferred_testing_execute, testing.deferred.execute);
+
+	for (i = 0; i < 256; i++) {
+		CuAssertIntEquals (test, false, cmd_deferred_is_command_enabled (&testing.deferred, i));
+	}
+
+	cmd_deferred_release (&testing.deferred);
+}
+
+static void cmd_deferred_test_init_null (CuTest *test)
+{
+	struct cmd_deferred_testing testing;
+	int status;
+
+	TEST_START;
+
+	status = cmd_deferred_init (NULL, cmd_deferred_testing_execute);
+	CuAssertIntEquals (test, CMD_DEFERRED_INVALID_ARGUMENT, status);
+
+	status = cmd_deferred_init (&testing.deferred, NULL);
+	CuAssertIntEquals (test, CMD_DEFERRED_INVALID_ARGUMENT, status);
+}
+
+static void cmd_deferred_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	cmd_deferred_release (NULL);
+}
+
+static void cmd_deferred_test_enable_command (CuTest *test)
+{
+	struct cmd_deferred_testing testing;
+	int status;
+
+	TEST_START;
+
+	cmd_deferred_testing_init (test, &testing);
+
+	status = cmd_deferred_enable_command (&testing.deferred,
+		CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_deferred_enable_command (&testing.deferred, 0xff);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, true, cmd_deferred_is_command_enabled (&testing.deferred,
+		CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE));
+	CuAssertIntEquals (test, true, cmd_deferred_is_command_enabled (&testing.deferred, 0xff));
+	CuAssertIntEquals (test, false, cmd_deferred_is_command_enabled (&testing.deferred,
+		CERBERUS_PROTOCOL_GET_DIGEST));
+	CuAssertIntEquals (test, false, cmd_deferred_is_command_enabled (&testing.deferred, 0x00));
+
+	status = cmd_deferred_disable_command (&testing.deferred,
+		CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, cmd_deferred_is_command_enabled (&testing.deferred,
+		CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE));
+	CuAssertIntEquals (test, true, cmd_deferred_is_command_enabled (&testing.deferred, 0xff));
+
+	cmd_deferred_release (&testing.deferred);
+}
+
+static void cmd_deferred_test_enable_command_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = cmd_deferred_enable_command (NULL, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE);
+	CuAssertIntEquals (test, CMD_DEFERRED_INVALID_ARGUMENT, status);
+
+	status = cmd_deferred_disable_command (NULL, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE);
+	CuAssertIntEquals (test, CMD_DEFERRED_INVALID_ARGUMENT, status);
+
+	CuAssertIntEquals (test, false, cmd_deferred_is_command_enabled (NULL,
+		CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE));
+}
+
+static void cmd_deferred_test_submit_execute (CuTest *test)
+{
+	struct cmd_deferred_testing testing;
+	struct cmd_interface_request request;
+	struct cmd_interface_request expected;
+	int result = 1;
+	int status;
+	size_t i;
+
+	TEST_START;
+
+	cmd_deferred_testing_init (test, &testing);
+	testing.result = 0;
+
+	cmd_deferred_testing_request (&request, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0x12, 0x10);
+	memcpy (&expected, &request, sizeof (expected));
+
+	status = cmd_deferred_submit (&testing.deferred, &request, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_SCHEDULED, status);
+	CuAssertIntEquals (test, CMD_DEFERRED_STATE_PENDING, testing.deferred.state);
+	CuAssertIntEquals (test, 0, testing.calls);
+
+	status = cmd_deferred_execute (&testing.deferred);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, testing.calls);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, testing.last_command);
+	CuAssertIntEquals (test, CMD_DEFERRED_STATE_COMPLETE, testing.deferred.state);
+
+	status = cmd_deferred_submit (&testing.deferred, &request, &result);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, result);
+	CuAssertIntEquals (test, expected.length + 1, request.length);
+	CuAssertIntEquals (test, false, request.new_request);
+	CuAssertIntEquals (test, CMD_DEFERRED_STATE_IDLE, testing.deferred.state);
+
+	for (i = 0; i < expected.length; i++) {
+		CuAssertIntEquals (test, (uint8_t) ~expected.data[i], request.data[i]);
+	}
+	CuAssertIntEquals (test, 0x55, request.data[expected.length]);
+
+	cmd_deferred_release (&testing.deferred);
+}
+
+static void cmd_deferred_test_submit_execute_error (CuTest *test)
+{
+	struct cmd_deferred_testing testing;
+	struct cmd_interface_request request;
+	int result = 0;
+	int status;
+
+	TEST_START;
+
+	cmd_deferred_testing_init (test, &testing);
+	testing.result = CMD_HANDLER_PROCESS_FAILED;
+
+	cmd_deferred_testing_request (&request, CERBERUS_PROTOCOL_EXPORT_CSR, 0x00, 0x10);
+
+	status = cmd_deferred_submit (&testing.deferred, &request, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_SCHEDULED, status);
+
+	status = cmd_deferred_execute (&testing.deferred);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_deferred_testing_request (&request, CERBERUS_PROTOCOL_EXPORT_CSR, 0x00, 0x10);
+
+	status = cmd_deferred_submit (&testing.deferred, &request, &result);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, CMD_HANDLER_PROCESS_FAILED, result);
+
+	cmd_deferred_release (&testing.deferred);
+}
+
+static void cmd_deferred_test_submit_in_progress (CuTest *test)
+{
+	struct cmd_deferred_testing testing;
+	struct cmd_interface_request request;
+	int result = 0;
+	int status;
+
+	TEST_START;
+
+	cmd_deferred_testing_init (test, &testing);
+
+	cmd_deferred_testing_request (&request, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0x12, 0x10);
+
+	status = cmd_deferred_submit (&testing.deferred, &request, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_SCHEDULED, status);
+
+	status = cmd_deferred_submit (&testing.deferred, &request, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_IN_PROGRESS, status);
+
+	testing.deferred.state = CMD_DEFERRED_STATE_RUNNING;
+
+	status = cmd_deferred_submit (&testing.deferred, &request, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_IN_PROGRESS, status);
+
+	testing.deferred.state = CMD_DEFERRED_STATE_PENDING;
+
+	CuAssertIntEquals (test, 0, testing.calls);
+
+	cmd_deferred_release (&testing.deferred);
+}
+
+static void cmd_deferred_test_submit_busy (CuTest *test)
+{
+	struct cmd_deferred_testing testing;
+	struct cmd_interface_request request;
+	struct cmd_interface_request other;
+	int result = 0;
+	int status;
+
+	TEST_START;
+
+	cmd_deferred_testing_init (test, &testing);
+
+	cmd_deferred_testing_request (&request, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0x12, 0x10);
+
+	status = cmd_deferred_submit (&testing.deferred, &request, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_SCHEDULED, status);
+
+	/* Different payload. */
+	cmd_deferred_testing_request (&other, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0x34, 0x10);
+
+	status = cmd_deferred_submit (&testing.deferred, &other, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_BUSY, status);
+
+	/* Different requester. */
+	cmd_deferred_testing_request (&other, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0x12, 0x11);
+
+	status = cmd_deferred_submit (&testing.deferred, &other, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_BUSY, status);
+
+	/* Different length. */
+	cmd_deferred_testing_request (&other, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0x12, 0x10);
+	other.length++;
+
+	status = cmd_deferred_submit (&testing.deferred, &other, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_BUSY, status);
+
+	status = cmd_deferred_execute (&testing.deferred);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, testing.calls);
+
+	status = cmd_deferred_submit (&testing.deferred, &request, &result);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_deferred_release (&testing.deferred);
+}
+
+static void cmd_deferred_test_submit_replace_completed (CuTest *test)
+{
+	struct cmd_deferred_testing testing;
+	struct cmd_interface_request request;
+	struct cmd_interface_request other;
+	int result = 0;
+	int status;
+
+	TEST_START;
+
+	cmd_deferred_testing_init (test, &testing);
+
+	cmd_deferred_testing_request (&request, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0x12, 0x10);
+
+	status = cmd_deferred_submit (&testing.deferred, &request, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_SCHEDULED, status);
+
+	status = cmd_deferred_execute (&testing.deferred);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_deferred_testing_request (&other, CERBERUS_PROTOCOL_EXPORT_CSR, 0x00, 0x11);
+
+	status = cmd_deferred_submit (&testing.deferred, &other, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_SCHEDULED, status);
+	CuAssertIntEquals (test, CMD_DEFERRED_STATE_PENDING, testing.deferred.state);
+
+	/* The original request has been discarded and must be run again. */
+	status = cmd_deferred_submit (&testing.deferred, &request, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_BUSY, status);
+
+	status = cmd_deferred_execute (&testing.deferred);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, testing.calls);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_EXPORT_CSR, testing.last_command);
+
+	status = cmd_deferred_submit (&testing.deferred, &other, &result);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_deferred_release (&testing.deferred);
+}
+
+static void cmd_deferred_test_submit_null (CuTest *test)
+{
+	struct cmd_deferred_testing testing;
+	struct cmd_interface_request request;
+	int result = 0;
+	int status;
+
+	TEST_START;
+
+	cmd_deferred_testing_init (test, &testing);
+
+	cmd_deferred_testing_request (&request, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0x12, 0x10);
+
+	status = cmd_deferred_submit (NULL, &request, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_INVALID_ARGUMENT, status);
+
+	status = cmd_deferred_submit (&testing.deferred, NULL, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_INVALID_ARGUMENT, status);
+
+	status = cmd_deferred_submit (&testing.deferred, &request, NULL);
+	CuAssertIntEquals (test, CMD_DEFERRED_INVALID_ARGUMENT, status);
+
+	request.length = 0;
+	status = cmd_deferred_submit (&testing.deferred, &request, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_INVALID_ARGUMENT, status);
+
+	CuAssertIntEquals (test, CMD_DEFERRED_STATE_IDLE, testing.deferred.state);
+
+	cmd_deferred_release (&testing.deferred);
+}
+
+static void cmd_deferred_test_execute_no_request (CuTest *test)
+{
+	struct cmd_deferred_testing testing;
+	struct cmd_interface_request request;
+	int result = 0;
+	int status;
+
+	TEST_START;
+
+	cmd_deferred_testing_init (test, &testing);
+
+	status = cmd_deferred_execute (&testing.deferred);
+	CuAssertIntEquals (test, CMD_DEFERRED_NO_REQUEST, status);
+
+	cmd_deferred_testing_request (&request, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0x12, 0x10);
+
+	status = cmd_deferred_submit (&testing.deferred, &request, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_SCHEDULED, status);
+
+	status = cmd_deferred_execute (&testing.deferred);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_deferred_execute (&testing.deferred);
+	CuAssertIntEquals (test, CMD_DEFERRED_NO_REQUEST, status);
+	CuAssertIntEquals (test, 1, testing.calls);
+
+	cmd_deferred_release (&testing.deferred);
+}
+
+static void cmd_deferred_test_execute_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = cmd_deferred_execute (NULL);
+	CuAssertIntEquals (test, CMD_DEFERRED_INVALID_ARGUMENT, status);
+}
+
+static void cmd_deferred_test_cancel (CuTest *test)
+{
+	struct cmd_deferred_testing testing;
+	struct cmd_interface_request request;
+	int result = 0;
+	int status;
+
+	TEST_START;
+
+	cmd_deferred_testing_init (test, &testing);
+
+	cmd_deferred_testing_request (&request, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0x12, 0x10);
+
+	status = cmd_deferred_submit (&testing.deferred, &request, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_SCHEDULED, status);
+
+	status = cmd_deferred_cancel (&testing.deferred);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, CMD_DEFERRED_STATE_IDLE, testing.deferred.state);
+
+	status = cmd_deferred_execute (&testing.deferred);
+	CuAssertIntEquals (test, CMD_DEFERRED_NO_REQUEST, status);
+	CuAssertIntEquals (test, 0, testing.calls);
+
+	status = cmd_deferred_submit (&testing.deferred, &request, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_SCHEDULED, status);
+
+	cmd_deferred_release (&testing.deferred);
+}
+
+static void cmd_deferred_test_cancel_no_request (CuTest *test)
+{
+	struct cmd_deferred_testing testing;
+	int status;
+
+	TEST_START;
+
+	cmd_deferred_testing_init (test, &testing);
+
+	status = cmd_deferred_cancel (&testing.deferred);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_deferred_release (&testing.deferred);
+}
+
+static void cmd_deferred_test_cancel_running (CuTest *test)
+{
+	struct cmd_deferred_testing testing;
+	struct cmd_interface_request request;
+	int result = 0;
+	int status;
+
+	TEST_START;
+
+	cmd_deferred_testing_init (test, &testing);
+
+	cmd_deferred_testing_request (&request, CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE, 0x12, 0x10);
+
+	status = cmd_deferred_submit (&testing.deferred, &request, &result);
+	CuAssertIntEquals (test, CMD_DEFERRED_SCHEDULED, status);
+
+	testing.deferred.state = CMD_DEFERRED_STATE_RUNNING;
+
+	status = cmd_deferred_cancel (&testing.deferred);
+	CuAssertIntEquals (test, CMD_DEFERRED_BUSY, status);
+
+	testing.deferred.state = CMD_DEFERRED_STATE_PENDING;
+
+	cmd_deferred_release (&testing.deferred);
+}
+
+static void cmd_deferred_test_cancel_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = cmd_deferred_cancel (NULL);
+	CuAssertIntEquals (test, CMD_DEFERRED_INVALID_ARGUMENT, status);
+}
+
+
+CuSuite* get_cmd_deferred_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, cmd_deferred_test_init);
+	SUITE_ADD_TEST (suite, cmd_deferred_test_init_null);
+	SUITE_ADD_TEST (suite, cmd_deferred_test_release_null);
+	SUITE_ADD_TEST (suite, cmd_deferred_test_enable_command);
+	SUITE_ADD_TEST (suite, cmd_deferred_test_enable_command_null);
+	SUITE_ADD_TEST (suite, cmd_deferred_test_submit_execute);
+	SUITE_ADD_TEST (suite, cmd_deferred_test_submit_execute_error);
+	SUITE_ADD_TEST (suite, cmd_deferred_test_submit_in_progress);
+	SUITE_ADD_TEST (suite, cmd_deferred_test_submit_busy);
+	SUITE_ADD_TEST (suite, cmd_deferred_test_submit_replace_completed);
+	SUITE_ADD_TEST (suite, cmd_deferred_test_submit_null);
+	SUITE_ADD_TEST (suite, cmd_deferred_test_execute_no_request);
+	SUITE_ADD_TEST (suite, cmd_deferred_test_execute_null);
+	SUITE_ADD_TEST (suite, cmd_deferred_test_cancel);
+	SUITE_ADD_TEST (suite, cmd_deferred_test_cancel_no_request);
+	SUITE_ADD_TEST (suite, cmd_deferred_test_cancel_running);
+	SUITE_ADD_TEST (suite, cmd_deferred_test_cancel_null);
+
+	return suite;
+}
@@ -1058,6 +1058,368 @@ static void cmd_interface_system_test_deinit_null (CuTest *test)
 	cmd_interface_system_deinit (NULL);
 }
 
+static void cmd_interface_system_test_get_stats (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_stats *stats;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	stats = cmd_interface_system_get_stats (&cmd.handler);
+	CuAssertPtrEquals (test, &cmd.handler.stats, stats);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_get_stats_null (CuTest *test)
+{
+	struct cmd_stats *stats;
+
+	TEST_START;
+
+	stats = cmd_interface_system_get_stats (NULL);
+	CuAssertPtrEquals (test, NULL, stats);
+}
+
+static void cmd_interface_system_test_get_deferred (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_deferred *deferred;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	deferred = cmd_interface_system_get_deferred (&cmd.handler);
+	CuAssertPtrEquals (test, &cmd.handler.deferred, deferred);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_get_deferred_null (CuTest *test)
+{
+	struct cmd_deferred *deferred;
+
+	TEST_START;
+
+	deferred = cmd_interface_system_get_deferred (NULL);
+	CuAssertPtrEquals (test, NULL, deferred);
+}
+
+static void cmd_interface_system_test_set_attestation_scheduler (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct attestation_scheduler scheduler;
+	int status;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_interface_system_set_attestation_scheduler (&cmd.handler, &scheduler);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &scheduler, cmd.handler.attestation_scheduler);
+
+	status = cmd_interface_system_set_attestation_scheduler (&cmd.handler, NULL);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, cmd.handler.attestation_scheduler);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_set_attestation_scheduler_null (CuTest *test)
+{
+	struct attestation_scheduler scheduler;
+	int status;
+
+	TEST_START;
+
+	status = cmd_interface_system_set_attestation_scheduler (NULL, &scheduler);
+	CuAssertIntEquals (test, CMD_HANDLER_INVALID_ARGUMENT, status);
+}
+
+/**
+ * Construct a request for the FW version that can be deferred.
+ *
+ * @param request The request to initialize.
+ * @param area The FW version area to request.
+ */
+static void cmd_interface_system_testing_deferred_request (struct cmd_interface_request *request,
+	uint8_t area)
+{
+	struct cerberus_protocol_get_fw_version *req =
+		(struct cerberus_protocol_get_fw_version*) request->data;
+
+	memset (request, 0, sizeof (struct cmd_interface_request));
+	req->header.msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	req->header.pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	req->header.command = CERBERUS_PROTOCOL_GET_FW_VERSION;
+
+	req->area = area;
+	request->length = sizeof (struct cerberus_protocol_get_fw_version);
+	request->max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+	request->source_eid = MCTP_PROTOCOL_BMC_EID;
+	request->target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+}
+
+/**
+ * Check that a request was answered with a busy error.
+ *
+ * @param test The test framework.
+ * @param request The request to check.
+ * @param error_data The expected error data.
+ */
+static void cmd_interface_system_testing_check_busy (CuTest *test,
+	struct cmd_interface_request *request, uint32_t error_data)
+{
+	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) request->data;
+
+	CuAssertIntEquals (test, sizeof (struct cerberus_protocol_error), request->length);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF, error->header.msg_type);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MSFT_PCI_VID, error->header.pci_vendor_id);
+	CuAssertIntEquals (test, 0, error->header.rq);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR, error->header.command);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_BUSY, error->error_code);
+	CuAssertIntEquals (test, error_data, error->error_data);
+	CuAssertIntEquals (test, false, request->new_request);
+}
+
+static void cmd_interface_system_test_process_deferred_command (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_interface_request request;
+	struct cerberus_protocol_get_fw_version_response *resp =
+		(struct cerberus_protocol_get_fw_version_response*) request.data;
+	struct cmd_stats_command stats;
+	int status;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_deferred_enable_command (&cmd.handler.deferred, CERBERUS_PROTOCOL_GET_FW_VERSION);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&cmd.background.mock, cmd.background.base.run_deferred, &cmd.background,
+		0, MOCK_ARG (&cmd.handler.deferred));
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_interface_system_testing_deferred_request (&request, 0);
+
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, 0, status);
+	cmd_interface_system_testing_check_busy (test, &request, CMD_DEFERRED_SCHEDULED);
+
+	/* Retry before the request has been executed. */
+	cmd_interface_system_testing_deferred_request (&request, 0);
+
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, 0, status);
+	cmd_interface_system_testing_check_busy (test, &request, CMD_DEFERRED_IN_PROGRESS);
+
+	status = cmd_stats_get_command (&cmd.handler.stats, CERBERUS_PROTOCOL_GET_FW_VERSION, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.requests);
+
+	/* Run the request from the background context. */
+	status = cmd_deferred_execute (&cmd.handler.deferred);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_interface_system_testing_deferred_request (&request, 0);
+
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, sizeof (struct cerberus_protocol_get_fw_version_response),
+		request.length);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF, resp->header.msg_type);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MSFT_PCI_VID, resp->header.pci_vendor_id);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_GET_FW_VERSION, resp->header.command);
+	CuAssertStrEquals (test, CERBERUS_FW_VERSION, resp->version);
+	CuAssertIntEquals (test, false, request.new_request);
+
+	status = cmd_stats_get_command (&cmd.handler.stats, CERBERUS_PROTOCOL_GET_FW_VERSION, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.requests);
+	CuAssertIntEquals (test, 0, stats.failures);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_deferred_command_error (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_interface_request request;
+	int status;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_deferred_enable_command (&cmd.handler.deferred, CERBERUS_PROTOCOL_GET_FW_VERSION);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&cmd.background.mock, cmd.background.base.run_deferred, &cmd.background,
+		0, MOCK_ARG (&cmd.handler.deferred));
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_interface_system_testing_deferred_request (&request, FW_VERSION_COUNT);
+
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, 0, status);
+	cmd_interface_system_testing_check_busy (test, &request, CMD_DEFERRED_SCHEDULED);
+
+	status = cmd_deferred_execute (&cmd.handler.deferred);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_interface_system_testing_deferred_request (&request, FW_VERSION_COUNT);
+
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, CMD_HANDLER_UNSUPPORTED_INDEX, status);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_deferred_command_busy (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_interface_request request;
+	int status;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_deferred_enable_command (&cmd.handler.deferred, CERBERUS_PROTOCOL_GET_FW_VERSION);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&cmd.background.mock, cmd.background.base.run_deferred, &cmd.background,
+		0, MOCK_ARG (&cmd.handler.deferred));
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_interface_system_testing_deferred_request (&request, 0);
+
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, 0, status);
+	cmd_interface_system_testing_check_busy (test, &request, CMD_DEFERRED_SCHEDULED);
+
+	cmd_interface_system_testing_deferred_request (&request, 1);
+
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, 0, status);
+	cmd_interface_system_testing_check_busy (test, &request, CMD_DEFERRED_BUSY);
+
+	/* Commands that are not deferred are still processed. */
+	cerberus_protocol_required_commands_testing_process_get_device_id (test, &cmd.handler.base,
+		CERBERUS_PROTOCOL_MSFT_PCI_VID, 2, CERBERUS_PROTOCOL_MSFT_PCI_VID, 4);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_deferred_command_task_busy (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct cmd_interface_request request;
+	struct cmd_stats_command stats;
+	int status;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_deferred_enable_command (&cmd.handler.deferred, CERBERUS_PROTOCOL_GET_FW_VERSION);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&cmd.background.mock, cmd.background.base.run_deferred, &cmd.background,
+		CMD_BACKGROUND_TASK_BUSY, MOCK_ARG (&cmd.handler.deferred));
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_interface_system_testing_deferred_request (&request, 0);
+
+	/* The request is not processed immediately when the background task is busy. */
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, 0, status);
+	cmd_interface_system_testing_check_busy (test, &request, CMD_BACKGROUND_TASK_BUSY);
+
+	CuAssertIntEquals (test, CMD_DEFERRED_STATE_IDLE, cmd.handler.deferred.state);
+
+	status = cmd_stats_get_command (&cmd.handler.stats, CERBERUS_PROTOCOL_GET_FW_VERSION, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.requests);
+
+	/* The request can be deferred once the task is available. */
+	status = mock_expect (&cmd.background.mock, cmd.background.base.run_deferred, &cmd.background,
+		0, MOCK_ARG (&cmd.handler.deferred));
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_interface_system_testing_deferred_request (&request, 0);
+
+	status = cmd.handler.base.process_request (&cmd.handler.base, &request);
+	CuAssertIntEquals (test, 0, status);
+	cmd_interface_system_testing_check_busy (test, &request, CMD_DEFERRED_SCHEDULED);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_deferred_command_run_error (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	int status;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_deferred_enable_command (&cmd.handler.deferred, CERBERUS_PROTOCOL_GET_FW_VERSION);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&cmd.background.mock, cmd.background.base.run_deferred, &cmd.background,
+		CMD_BACKGROUND_NO_TASK, MOCK_ARG (&cmd.handler.deferred));
+	CuAssertIntEquals (test, 0, status);
+
+	/* The request is processed immediately when it can't be run in the background. */
+	cerberus_protocol_required_commands_testing_process_get_fw_version (test, &cmd.handler.base,
+		CERBERUS_FW_VERSION);
+
+	CuAssertIntEquals (test, CMD_DEFERRED_STATE_IDLE, cmd.handler.deferred.state);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_deferred_command_no_background_support (
+	CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	int status;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+
+	status = cmd_deferred_enable_command (&cmd.handler.deferred, CERBERUS_PROTOCOL_GET_FW_VERSION);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd.background.base.run_deferred = NULL;
+
+	/* The request is processed immediately when the background handler can't defer commands. */
+	cerberus_protocol_required_commands_testing_process_get_fw_version (test, &cmd.handler.base,
+		CERBERUS_FW_VERSION);
+
+	CuAssertIntEquals (test, CMD_DEFERRED_STATE_IDLE, cmd.handler.deferred.state);
+
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
 static void cmd_interface_system_test_process_null (CuTest *test)
 {
 	struct cmd_interface_system_testing cmd;
@@ -3289,6 +3651,57 @@ static void cmd_interface_system_test_process_debug_fill_log (CuTest *test)
 	complete_cmd_interface_system_mock_test (test, &cmd);
 }
 
+static void cmd_interface_system_test_process_debug_read_trace (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+	cerberus_protocol_debug_commands_testing_process_debug_read_trace (test, &cmd.handler.base);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_debug_read_trace_limited_response (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+	cerberus_protocol_debug_commands_testing_process_debug_read_trace_limited_response (test,
+		&cmd.handler.base);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_debug_read_trace_invalid_len (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+	cerberus_protocol_debug_commands_testing_process_debug_read_trace_invalid_len (test,
+		&cmd.handler.base);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_debug_read_trace_no_trace (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+	cerberus_protocol_debug_commands_testing_process_debug_read_trace_no_trace (test,
+		&cmd.handler.base);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
 static void cmd_interface_system_test_process_get_log_info (CuTest *test)
 {
 	struct cmd_interface_system_testing cmd;
@@ -5737,6 +6150,83 @@ static void cmd_interface_system_test_process_get_device_id_invalid_len (CuTest
 	complete_cmd_interface_system_mock_test (test, &cmd);
 }
 
+static void cmd_interface_system_test_process_get_command_stats (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+	cerberus_protocol_optional_commands_testing_process_get_command_stats (test, &cmd.handler.base);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_get_command_stats_no_requests (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+	cerberus_protocol_optional_commands_testing_process_get_command_stats_no_requests (test,
+		&cmd.handler.base);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_get_command_stats_channel (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+	cerberus_protocol_optional_commands_testing_process_get_command_stats_channel (test,
+		&cmd.handler.base, &cmd.handler.stats);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_get_command_stats_unknown_channel (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+	cerberus_protocol_optional_commands_testing_process_get_command_stats_unknown_channel (test,
+		&cmd.handler.base);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_get_command_stats_invalid_len (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+	cerberus_protocol_optional_commands_testing_process_get_command_stats_invalid_len (test,
+		&cmd.handler.base);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_get_command_stats_invalid_type (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, DEVICE_MANAGER_UPSTREAM);
+	cerberus_protocol_optional_commands_testing_process_get_command_stats_invalid_type (test,
+		&cmd.handler.base);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
 static void cmd_interface_system_test_process_reset_counter (CuTest *test)
 {
 	struct cmd_interface_system_testing cmd;
@@ -5996,6 +6486,18 @@ CuSuite* get_cmd_interface_system_suite ()
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_init);
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_init_null);
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_deinit_null);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_get_stats);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_get_stats_null);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_get_deferred);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_get_deferred_null);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_set_attestation_scheduler);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_set_attestation_scheduler_null);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_deferred_command);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_deferred_command_error);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_deferred_command_busy);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_deferred_command_task_busy);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_deferred_command_run_error);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_deferred_command_no_background_support);
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_null);
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_payload_too_short);
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_unsupported_message);
@@ -6180,6 +6682,10 @@ CuSuite* get_cmd_interface_system_suite ()
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_log_clear_invalid_type);
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_log_clear_debug_fail);
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_debug_fill_log);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_debug_read_trace);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_debug_read_trace_limited_response);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_debug_read_trace_invalid_len);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_debug_read_trace_no_trace);
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_log_info);
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_log_info_invalid_len);
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_log_info_fail_debug);
@@ -6403,6 +6909,12 @@ CuSuite* get_cmd_interface_system_suite ()
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_device_info_fail);
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_device_id);
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_device_id_invalid_len);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_command_stats);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_command_stats_no_requests);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_command_stats_channel);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_command_stats_unknown_channel);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_command_stats_invalid_len);
+	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_get_command_stats_invalid_type);
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_reset_counter);
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_reset_counter_port0);
 	SUITE_ADD_TEST (suite, cmd_interface_system_test_process_reset_counter_port1);
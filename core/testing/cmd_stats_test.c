@@ -0,0 +1,452 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "platform.h"
+#include "cmd_interface/cmd_stats.h"
+#include "cmd_interface/cmd_interface.h"
+#include "mock/cmd_channel_mock.h"
+
+
+static const char *SUITE = "cmd_stats";
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void cmd_stats_test_init (CuTest *test)
+{
+	struct cmd_stats stats;
+	struct cmd_stats_command cmd;
+	int status;
+
+	TEST_START;
+
+	status = cmd_stats_init (&stats);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_stats_get_command (&stats, 0x01, &cmd);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, cmd.requests);
+	CuAssertIntEquals (test, 0, cmd.failures);
+
+	status = cmd_stats_get_untracked (&stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, cmd_stats_get_channel (&stats, 0));
+
+	cmd_stats_release (&stats);
+}
+
+static void cmd_stats_test_init_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = cmd_stats_init (NULL);
+	CuAssertIntEquals (test, CMD_HANDLER_INVALID_ARGUMENT, status);
+}
+
+static void cmd_stats_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	cmd_stats_release (NULL);
+}
+
+static void cmd_stats_test_record_command (CuTest *test)
+{
+	struct cmd_stats stats;
+	struct cmd_stats_command cmd;
+	int status;
+
+	TEST_START;
+
+	status = cmd_stats_init (&stats);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_stats_record_command (&stats, 0x01, 0, 5);
+
+	status = cmd_stats_get_command (&stats, 0x01, &cmd);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, cmd.requests);
+	CuAssertIntEquals (test, 0, cmd.failures);
+	CuAssertIntEquals (test, 5, cmd.total_time_ms);
+	CuAssertIntEquals (test, 5, cmd.max_time_ms);
+	CuAssertIntEquals (test, 1, cmd.latency[3]);
+
+	status = cmd_stats_get_command (&stats, 0x02, &cmd);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, cmd.requests);
+
+	cmd_stats_release (&stats);
+}
+
+static void cmd_stats_test_record_command_multiple (CuTest *test)
+{
+	struct cmd_stats stats;
+	struct cmd_stats_command cmd;
+	int status;
+
+	TEST_START;
+
+	status = cmd_stats_init (&stats);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_stats_record_command (&stats, 0x01, 0, 5);
+	cmd_stats_record_command (&stats, 0x82, 0, 1);
+	cmd_stats_record_command (&stats, 0x01, CMD_HANDLER_BAD_LENGTH, 20);
+	cmd_stats_record_command (&stats, 0x01, 0, 2);
+
+	status = cmd_stats_get_command (&stats, 0x01, &cmd);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 3, cmd.requests);
+	CuAssertIntEquals (test, 1, cmd.failures);
+	CuAssertIntEquals (test, 27, cmd.total_time_ms);
+	CuAssertIntEquals (test, 20, cmd.max_time_ms);
+
+	status = cmd_stats_get_command (&stats, 0x82, &cmd);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, cmd.requests);
+	CuAssertIntEquals (test, 0, cmd.failures);
+	CuAssertIntEquals (test, 1, cmd.total_time_ms);
+	CuAssertIntEquals (test, 1, cmd.max_time_ms);
+
+	cmd_stats_release (&stats);
+}
+
+static void cmd_stats_test_record_command_latency_buckets (CuTest *test)
+{
+	struct cmd_stats stats;
+	struct cmd_stats_command cmd;
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = cmd_stats_init (&stats);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_stats_record_command (&stats, 0x01, 0, 0);
+	cmd_stats_record_command (&stats, 0x01, 0, 1);
+	cmd_stats_record_command (&stats, 0x01, 0, 2);
+	cmd_stats_record_command (&stats, 0x01, 0, 3);
+	cmd_stats_record_command (&stats, 0x01, 0, 4);
+	cmd_stats_record_command (&stats, 0x01, 0, 1023);
+	cmd_stats_record_command (&stats, 0x01, 0, 1024);
+	cmd_stats_record_command (&stats, 0x01, 0, 2048);
+	cmd_stats_record_command (&stats, 0x01, 0, 0xffffffff);
+
+	status = cmd_stats_get_command (&stats, 0x01, &cmd);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 9, cmd.requests);
+	CuAssertIntEquals (test, 0xffffffff, cmd.max_time_ms);
+
+	CuAssertIntEquals (test, 1, cmd.latency[0]);
+	CuAssertIntEquals (test, 1, cmd.latency[1]);
+	CuAssertIntEquals (test, 2, cmd.latency[2]);
+	CuAssertIntEquals (test, 1, cmd.latency[3]);
+	for (i = 4; i < 10; i++) {
+		CuAssertIntEquals (test, 0, cmd.latency[i]);
+	}
+	CuAssertIntEquals (test, 1, cmd.latency[10]);
+	CuAssertIntEquals (test, 3, cmd.latency[CMD_STATS_LATENCY_BUCKETS - 1]);
+
+	cmd_stats_release (&stats);
+}
+
+static void cmd_stats_test_record_command_untracked (CuTest *test)
+{
+	struct cmd_stats stats;
+	struct cmd_stats_command cmd;
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = cmd_stats_init (&stats);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < CMD_STATS_MAX_COMMANDS; i++) {
+		cmd_stats_record_command (&stats, i, 0, 1);
+	}
+
+	cmd_stats_record_command (&stats, CMD_STATS_MAX_COMMANDS, 0, 1);
+	cmd_stats_record_command (&stats, CMD_STATS_MAX_COMMANDS + 1, 0, 1);
+	cmd_stats_record_command (&stats, 0, 0, 1);
+
+	status = cmd_stats_get_untracked (&stats);
+	CuAssertIntEquals (test, 2, status);
+
+	status = cmd_stats_get_command (&stats, 0, &cmd);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, cmd.requests);
+
+	status = cmd_stats_get_command (&stats, CMD_STATS_MAX_COMMANDS - 1, &cmd);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, cmd.requests);
+
+	status = cmd_stats_get_command (&stats, CMD_STATS_MAX_COMMANDS, &cmd);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, cmd.requests);
+
+	cmd_stats_release (&stats);
+}
+
+static void cmd_stats_test_record_command_null (CuTest *test)
+{
+	TEST_START;
+
+	cmd_stats_record_command (NULL, 0x01, 0, 1);
+}
+
+static void cmd_stats_test_get_command_null (CuTest *test)
+{
+	struct cmd_stats stats;
+	struct cmd_stats_command cmd;
+	int status;
+
+	TEST_START;
+
+	status = cmd_stats_init (&stats);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_stats_get_command (NULL, 0x01, &cmd);
+	CuAssertIntEquals (test, CMD_HANDLER_INVALID_ARGUMENT, status);
+
+	status = cmd_stats_get_command (&stats, 0x01, NULL);
+	CuAssertIntEquals (test, CMD_HANDLER_INVALID_ARGUMENT, status);
+
+	cmd_stats_release (&stats);
+}
+
+static void cmd_stats_test_get_untracked_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = cmd_stats_get_untracked (NULL);
+	CuAssertIntEquals (test, CMD_HANDLER_INVALID_ARGUMENT, status);
+}
+
+static void cmd_stats_test_clear (CuTest *test)
+{
+	struct cmd_stats stats;
+	struct cmd_stats_command cmd;
+	struct cmd_channel_mock channel;
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = cmd_channel_mock_init (&channel, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_stats_init (&stats);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_stats_add_channel (&stats, &channel.base);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < CMD_STATS_MAX_COMMANDS + 1; i++) {
+		cmd_stats_record_command (&stats, i, 0, 1);
+	}
+
+	cmd_stats_clear (&stats);
+
+	status = cmd_stats_get_command (&stats, 0, &cmd);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, cmd.requests);
+
+	status = cmd_stats_get_untracked (&stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, &channel.base, cmd_stats_get_channel (&stats, 1));
+
+	cmd_stats_record_command (&stats, CMD_STATS_MAX_COMMANDS, 0, 1);
+
+	status = cmd_stats_get_command (&stats, CMD_STATS_MAX_COMMANDS, &cmd);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, cmd.requests);
+
+	cmd_stats_release (&stats);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void cmd_stats_test_clear_null (CuTest *test)
+{
+	TEST_START;
+
+	cmd_stats_clear (NULL);
+}
+
+static void cmd_stats_test_add_channel (CuTest *test)
+{
+	struct cmd_stats stats;
+	struct cmd_channel_mock channel1;
+	struct cmd_channel_mock channel2;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_mock_init (&channel1, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mock_init (&channel2, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_stats_init (&stats);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_stats_add_channel (&stats, &channel1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_stats_add_channel (&stats, &channel2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, &channel1.base, cmd_stats_get_channel (&stats, 1));
+	CuAssertPtrEquals (test, &channel2.base, cmd_stats_get_channel (&stats, 2));
+	CuAssertPtrEquals (test, NULL, cmd_stats_get_channel (&stats, 3));
+
+	cmd_stats_release (&stats);
+
+	status = cmd_channel_mock_validate_and_release (&channel1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void cmd_stats_test_add_channel_twice (CuTest *test)
+{
+	struct cmd_stats stats;
+	struct cmd_channel_mock channel[CMD_STATS_MAX_CHANNELS];
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = cmd_stats_init (&stats);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < CMD_STATS_MAX_CHANNELS; i++) {
+		status = cmd_channel_mock_init (&channel[i], i);
+		CuAssertIntEquals (test, 0, status);
+
+		status = cmd_stats_add_channel (&stats, &channel[i].base);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = cmd_stats_add_channel (&stats, &channel[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_stats_release (&stats);
+
+	for (i = 0; i < CMD_STATS_MAX_CHANNELS; i++) {
+		status = cmd_channel_mock_validate_and_release (&channel[i]);
+		CuAssertIntEquals (test, 0, status);
+	}
+}
+
+static void cmd_stats_test_add_channel_full (CuTest *test)
+{
+	struct cmd_stats stats;
+	struct cmd_channel_mock channel[CMD_STATS_MAX_CHANNELS + 1];
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = cmd_stats_init (&stats);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < CMD_STATS_MAX_CHANNELS; i++) {
+		status = cmd_channel_mock_init (&channel[i], i);
+		CuAssertIntEquals (test, 0, status);
+
+		status = cmd_stats_add_channel (&stats, &channel[i].base);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = cmd_channel_mock_init (&channel[i], i);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_stats_add_channel (&stats, &channel[i].base);
+	CuAssertIntEquals (test, CMD_HANDLER_NO_MEMORY, status);
+
+	CuAssertPtrEquals (test, NULL, cmd_stats_get_channel (&stats, CMD_STATS_MAX_CHANNELS));
+
+	cmd_stats_release (&stats);
+
+	for (i = 0; i < CMD_STATS_MAX_CHANNELS + 1; i++) {
+		status = cmd_channel_mock_validate_and_release (&channel[i]);
+		CuAssertIntEquals (test, 0, status);
+	}
+}
+
+static void cmd_stats_test_add_channel_null (CuTest *test)
+{
+	struct cmd_stats stats;
+	struct cmd_channel_mock channel;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_mock_init (&channel, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_stats_init (&stats);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_stats_add_channel (NULL, &channel.base);
+	CuAssertIntEquals (test, CMD_HANDLER_INVALID_ARGUMENT, status);
+
+	status = cmd_stats_add_channel (&stats, NULL);
+	CuAssertIntEquals (test, CMD_HANDLER_INVALID_ARGUMENT, status);
+
+	cmd_stats_release (&stats);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void cmd_stats_test_get_channel_null (CuTest *test)
+{
+	TEST_START;
+
+	CuAssertPtrEquals (test, NULL, cmd_stats_get_channel (NULL, 0));
+}
+
+
+CuSuite* get_cmd_stats_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, cmd_stats_test_init);
+	SUITE_ADD_TEST (suite, cmd_stats_test_init_null);
+	SUITE_ADD_TEST (suite, cmd_stats_test_release_null);
+	SUITE_ADD_TEST (suite, cmd_stats_test_record_command);
+	SUITE_ADD_TEST (suite, cmd_stats_test_record_command_multiple);
+	SUITE_ADD_TEST (suite, cmd_stats_test_record_command_latency_buckets);
+	SUITE_ADD_TEST (suite, cmd_stats_test_record_command_untracked);
+	SUITE_ADD_TEST (suite, cmd_stats_test_record_command_null);
+	SUITE_ADD_TEST (suite, cmd_stats_test_get_command_null);
+	SUITE_ADD_TEST (suite, cmd_stats_test_get_untracked_null);
+	SUITE_ADD_TEST (suite, cmd_stats_test_clear);
+	SUITE_ADD_TEST (suite, cmd_stats_test_clear_null);
+	SUITE_ADD_TEST (suite, cmd_stats_test_add_channel);
+	SUITE_ADD_TEST (suite, cmd_stats_test_add_channel_twice);
+	SUITE_ADD_TEST (suite, cmd_stats_test_add_channel_full);
+	SUITE_ADD_TEST (suite, cmd_stats_test_add_channel_null);
+	SUITE_ADD_TEST (suite, cmd_stats_test_get_channel_null);
+
+	return suite;
+}
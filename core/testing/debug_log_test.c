@@ -54,6 +54,7 @@ static void complete_debug_log_mock_test (CuTest *test, struct logging_mock *log
 static void debug_log_testing_suite_tear_down (CuTest *test)
 {
 	debug_log = NULL;
+	debug_log_severity_threshold = DEBUG_LOG_SEVERITY_INFO;
 }
 
 /*******************
@@ -114,6 +115,98 @@ static void debug_log_test_create_entry_invalid_severity (CuTest *test)
 	complete_debug_log_mock_test (test, &logger);
 }
 
+static void debug_log_test_create_entry_severity_filtered (CuTest *test)
+{
+	struct logging_mock logger;
+	struct debug_log_entry_info entry = {
+		.format = 1,
+		.severity = DEBUG_LOG_SEVERITY_WARNING,
+		.component = 2,
+		.msg_index = 3,
+		.arg1 = 4,
+		.arg2 = 5
+	};
+	int status;
+
+	TEST_START;
+
+	setup_debug_log_mock_test (test, &logger);
+	debug_log_severity_threshold = DEBUG_LOG_SEVERITY_WARNING;
+
+	status = mock_expect (&logger.mock, logger.base.create_entry, &logger, 0,
+		MOCK_ARG_PTR_CONTAINS (&entry, sizeof (entry)), MOCK_ARG (sizeof (entry)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, 2, 3, 4, 5);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_create_entry (DEBUG_LOG_SEVERITY_WARNING, 2, 3, 4, 5);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_severity_threshold = DEBUG_LOG_SEVERITY_INFO;
+	complete_debug_log_mock_test (test, &logger);
+}
+
+static void debug_log_test_create_entry_macro (CuTest *test)
+{
+	struct logging_mock logger;
+	struct debug_log_entry_info entry = {
+		.format = 1,
+		.severity = DEBUG_LOG_SEVERITY_INFO,
+		.component = 2,
+		.msg_index = 3,
+		.arg1 = 4,
+		.arg2 = 5
+	};
+	int status;
+
+	TEST_START;
+
+	CuAssertIntEquals (test, true,
+		DEBUG_LOG_IS_COMPILED (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO));
+	CuAssertIntEquals (test, true,
+		DEBUG_LOG_IS_COMPILED (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_DEVICE_SPECIFIC));
+
+	setup_debug_log_mock_test (test, &logger);
+
+	status = mock_expect (&logger.mock, logger.base.create_entry, &logger, 0,
+		MOCK_ARG_PTR_CONTAINS (&entry, sizeof (entry)), MOCK_ARG (sizeof (entry)));
+	CuAssertIntEquals (test, 0, status);
+
+	DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, 2, 3, 4, 5);
+
+	complete_debug_log_mock_test (test, &logger);
+}
+
+static void debug_log_test_create_entry_macro_severity_filtered (CuTest *test)
+{
+	struct logging_mock logger;
+	int evaluated = 0;
+
+	TEST_START;
+
+	setup_debug_log_mock_test (test, &logger);
+	debug_log_severity_threshold = DEBUG_LOG_SEVERITY_ERROR;
+
+	/* Filtered entries don't call into the log or evaluate the entry arguments. */
+	DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_WARNING, 2, 3, evaluated++, 5);
+	DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_INFO, 2, 3, evaluated++, 5);
+
+	CuAssertIntEquals (test, 0, evaluated);
+
+	debug_log_severity_threshold = DEBUG_LOG_SEVERITY_INFO;
+	complete_debug_log_mock_test (test, &logger);
+}
+
+static void debug_log_test_create_entry_macro_no_log (CuTest *test)
+{
+	TEST_START;
+
+	debug_log = NULL;
+
+	DEBUG_LOG_CREATE_ENTRY (DEBUG_LOG_SEVERITY_ERROR, 2, 3, 4, 5);
+}
+
 static void debug_log_test_flush (CuTest *test)
 {
 	struct logging_mock logger;
@@ -245,6 +338,10 @@ CuSuite* get_debug_log_suite ()
 	SUITE_ADD_TEST (suite, debug_log_test_create_entry);
 	SUITE_ADD_TEST (suite, debug_log_test_create_entry_no_log);
 	SUITE_ADD_TEST (suite, debug_log_test_create_entry_invalid_severity);
+	SUITE_ADD_TEST (suite, debug_log_test_create_entry_severity_filtered);
+	SUITE_ADD_TEST (suite, debug_log_test_create_entry_macro);
+	SUITE_ADD_TEST (suite, debug_log_test_create_entry_macro_severity_filtered);
+	SUITE_ADD_TEST (suite, debug_log_test_create_entry_macro_no_log);
 	SUITE_ADD_TEST (suite, debug_log_test_flush);
 	SUITE_ADD_TEST (suite, debug_log_test_flush_no_log);
 	SUITE_ADD_TEST (suite, debug_log_test_clear);
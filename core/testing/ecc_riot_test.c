@@ -46,6 +46,7 @@ static void ecc_riot_test_init (CuTest *test)
 	CuAssertPtrNotNull (test, engine.base.get_private_key_der);
 	CuAssertPtrNotNull (test, engine.base.get_public_key_der);
 	CuAssertPtrNotNull (test, engine.base.sign);
+	CuAssertPtrEquals (test, NULL, engine.base.precompute_sign);
 	CuAssertPtrNotNull (test, engine.base.verify);
 	CuAssertPtrEquals (test, NULL, engine.base.get_shared_secret_max_length);
 	CuAssertPtrEquals (test, NULL, engine.base.compute_shared_secret);
@@ -0,0 +1,1044 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "firmware/firmware_update_journal.h"
+#include "mock/flash_mock.h"
+#include "flash/flash_common.h"
+#include "flash/flash_util.h"
+#include "crypto/checksum.h"
+
+
+static const char *SUITE = "firmware_update_journal";
+
+
+/**
+ * Length of a journal entry in flash.
+ */
+#define	JOURNAL_ENTRY_LEN			20
+
+/**
+ * Sector size to use for tests that fill the journal.  This can hold three entries.
+ */
+#define	JOURNAL_SMALL_SECTOR		64
+
+
+/**
+ * Build the flash contents for a journal entry.
+ *
+ * @param entry Output for the entry data.
+ * @param step The step in the entry.
+ * @param phase The phase in the entry.
+ * @param flags The flags in the entry.
+ * @param image_length The image length in the entry.
+ * @param backup_length The backup length in the entry.
+ * @param offset The image offset in the entry.
+ */
+static void firmware_update_journal_testing_entry (uint8_t *entry, uint8_t step, uint8_t phase,
+	uint8_t flags, uint32_t image_length, uint32_t backup_length, uint32_t offset)
+{
+	entry[0] = 0x4a;
+	entry[1] = step;
+	entry[2] = phase;
+	entry[3] = flags;
+	memcpy (&entry[4], &image_length, 4);
+	memcpy (&entry[8], &backup_length, 4);
+	memcpy (&entry[12], &offset, 4);
+	memset (&entry[16], 0xff, 3);
+	entry[19] = checksum_crc8 (0, entry, JOURNAL_ENTRY_LEN - 1);
+}
+
+/**
+ * Set up expectations for initializing a journal.
+ *
+ * @param test The test framework.
+ * @param flash The mock for the journal flash.
+ * @param base_addr The base address of the journal.
+ * @param sector_size The sector size to report for the flash.
+ * @param entries The entries stored in the journal.  A blank entry will be reported after these
+ * entries if there is room in the sector.
+ * @param count The number of entries.
+ */
+static void firmware_update_journal_testing_expect_init (CuTest *test, struct flash_mock *flash,
+	uint32_t base_addr, uint32_t sector_size, const uint8_t *entries, size_t count)
+{
+	uint8_t blank[JOURNAL_ENTRY_LEN];
+	size_t i;
+	int status;
+
+	memset (blank, 0xff, sizeof (blank));
+
+	status = mock_expect (&flash->mock, flash->base.get_sector_size, flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash->mock, 0, &sector_size, sizeof (sector_size), -1);
+
+	for (i = 0; i < count; i++) {
+		status |= mock_expect (&flash->mock, flash->base.read, flash, 0,
+			MOCK_ARG (base_addr + (i * JOURNAL_ENTRY_LEN)), MOCK_ARG_NOT_NULL,
+			MOCK_ARG (JOURNAL_ENTRY_LEN));
+		status |= mock_expect_output (&flash->mock, 1, &entries[i * JOURNAL_ENTRY_LEN],
+			JOURNAL_ENTRY_LEN, 2);
+	}
+
+	if (((count + 1) * JOURNAL_ENTRY_LEN) <= sector_size) {
+		status |= mock_expect (&flash->mock, flash->base.read, flash, 0,
+			MOCK_ARG (base_addr + (count * JOURNAL_ENTRY_LEN)), MOCK_ARG_NOT_NULL,
+			MOCK_ARG (JOURNAL_ENTRY_LEN));
+		status |= mock_expect_output_tmp (&flash->mock, 1, blank, sizeof (blank), 2);
+	}
+
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Initialize a journal for testing.
+ *
+ * @param test The test framework.
+ * @param journal The journal to initialize.
+ * @param flash The mock for the journal flash.
+ * @param sector_size The sector size to report for the flash.
+ * @param entries The entries stored in the journal.
+ * @param count The number of entries.
+ */
+static void firmware_update_journal_testing_init (CuTest *test,
+	struct firmware_update_journal *journal, struct flash_mock *flash, uint32_t sector_size,
+	const uint8_t *entries, size_t count)
+{
+	int status;
+
+	status = flash_mock_init (flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_testing_expect_init (test, flash, 0x10000, sector_size, entries,
+		count);
+
+	status = firmware_update_journal_init (journal, &flash->base, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash->mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Set up expectations for writing a journal entry.
+ *
+ * @param flash The mock for the journal flash.
+ * @param addr The address the entry will be written to.
+ * @param entry The expected entry data.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+static int firmware_update_journal_testing_expect_record (struct flash_mock *flash, uint32_t addr,
+	const uint8_t *entry)
+{
+	int status;
+
+	status = mock_expect (&flash->mock, flash->base.write, flash, JOURNAL_ENTRY_LEN,
+		MOCK_ARG (addr), MOCK_ARG_PTR_CONTAINS (entry, JOURNAL_ENTRY_LEN),
+		MOCK_ARG (JOURNAL_ENTRY_LEN));
+	status |= flash_mock_expect_verify_flash (flash, addr, entry, JOURNAL_ENTRY_LEN);
+
+	return status;
+}
+
+/**
+ * Check the contents of a checkpoint.
+ *
+ * @param test The test framework.
+ * @param checkpoint The checkpoint to check.
+ * @param step The expected step.
+ * @param phase The expected phase.
+ * @param flags The expected flags.
+ * @param image_length The expected image length.
+ * @param backup_length The expected backup length.
+ * @param offset The expected image offset.
+ */
+static void firmware_update_journal_testing_check_checkpoint (CuTest *test,
+	const struct firmware_update_checkpoint *checkpoint, uint8_t step, uint8_t phase,
+	uint8_t flags, uint32_t image_length, uint32_t backup_length, uint32_t offset)
+{
+	CuAssertIntEquals (test, step, checkpoint->step);
+	CuAssertIntEquals (test, phase, checkpoint->phase);
+	CuAssertIntEquals (test, flags, checkpoint->flags);
+	CuAssertIntEquals (test, image_length, checkpoint->image_length);
+	CuAssertIntEquals (test, backup_length, checkpoint->backup_length);
+	CuAssertIntEquals (test, offset, checkpoint->offset);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void firmware_update_journal_test_init (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint checkpoint;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_testing_expect_init (test, &flash, 0x10000, FLASH_SECTOR_SIZE, NULL,
+		0);
+
+	status = firmware_update_journal_init (&journal, &flash.base, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, journal.next_entry);
+
+	status = firmware_update_journal_get_checkpoint (&journal, &checkpoint);
+	CuAssertIntEquals (test, 0, status);
+	firmware_update_journal_testing_check_checkpoint (test, &checkpoint, 0,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0, 0);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_init_find_latest (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint checkpoint;
+	uint8_t entries[JOURNAL_ENTRY_LEN * 3];
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_entry (&entries[0], FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0, 0x1234, 0, 0);
+	firmware_update_journal_testing_entry (&entries[JOURNAL_ENTRY_LEN],
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE, 0, 0x1234,
+		0x2000, 0);
+	firmware_update_journal_testing_entry (&entries[JOURNAL_ENTRY_LEN * 2],
+		FIRMWARE_UPDATE_JOURNAL_STEP_RECOVERY, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM,
+		FIRMWARE_UPDATE_JOURNAL_FLAG_RECOVERY_UPDATED, 0x1234, 0x2000, 0x1000);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_testing_expect_init (test, &flash, 0x10000, FLASH_SECTOR_SIZE,
+		entries, 3);
+
+	status = firmware_update_journal_init (&journal, &flash.base, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, JOURNAL_ENTRY_LEN * 3, journal.next_entry);
+
+	status = firmware_update_journal_get_checkpoint (&journal, &checkpoint);
+	CuAssertIntEquals (test, 0, status);
+	firmware_update_journal_testing_check_checkpoint (test, &checkpoint,
+		FIRMWARE_UPDATE_JOURNAL_STEP_RECOVERY, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM,
+		FIRMWARE_UPDATE_JOURNAL_FLAG_RECOVERY_UPDATED, 0x1234, 0x2000, 0x1000);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_init_skip_torn_entry (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint checkpoint;
+	uint8_t entries[JOURNAL_ENTRY_LEN * 2];
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_entry (&entries[0], FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0, 0x1234, 0x2000, 0x800);
+	firmware_update_journal_testing_entry (&entries[JOURNAL_ENTRY_LEN],
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0, 0x1234,
+		0x2000, 0x1000);
+	memset (&entries[JOURNAL_ENTRY_LEN + 10], 0xff, JOURNAL_ENTRY_LEN - 10);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_testing_expect_init (test, &flash, 0x10000, FLASH_SECTOR_SIZE,
+		entries, 2);
+
+	status = firmware_update_journal_init (&journal, &flash.base, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, JOURNAL_ENTRY_LEN * 2, journal.next_entry);
+
+	status = firmware_update_journal_get_checkpoint (&journal, &checkpoint);
+	CuAssertIntEquals (test, 0, status);
+	firmware_update_journal_testing_check_checkpoint (test, &checkpoint,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0, 0x1234,
+		0x2000, 0x800);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_init_skip_bad_crc (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint checkpoint;
+	uint8_t entries[JOURNAL_ENTRY_LEN * 2];
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_entry (&entries[0], FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0, 0x1234, 0, 0);
+	firmware_update_journal_testing_entry (&entries[JOURNAL_ENTRY_LEN],
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_DONE, 0, 0x1234, 0, 0);
+	entries[JOURNAL_ENTRY_LEN + 19] ^= 0x55;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_testing_expect_init (test, &flash, 0x10000, FLASH_SECTOR_SIZE,
+		entries, 2);
+
+	status = firmware_update_journal_init (&journal, &flash.base, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_get_checkpoint (&journal, &checkpoint);
+	CuAssertIntEquals (test, 0, status);
+	firmware_update_journal_testing_check_checkpoint (test, &checkpoint,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0, 0x1234, 0,
+		0);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_init_skip_unknown_phase (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint checkpoint;
+	uint8_t entries[JOURNAL_ENTRY_LEN * 3];
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_entry (&entries[0], FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0, 0x1234, 0, 0);
+	firmware_update_journal_testing_entry (&entries[JOURNAL_ENTRY_LEN],
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_DONE + 1, 0, 0x1234, 0,
+		0);
+	firmware_update_journal_testing_entry (&entries[JOURNAL_ENTRY_LEN * 2],
+		FIRMWARE_UPDATE_JOURNAL_STEP_RECOVERY + 1, FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0,
+		0x1234, 0, 0);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_testing_expect_init (test, &flash, 0x10000, FLASH_SECTOR_SIZE,
+		entries, 3);
+
+	status = firmware_update_journal_init (&journal, &flash.base, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_get_checkpoint (&journal, &checkpoint);
+	CuAssertIntEquals (test, 0, status);
+	firmware_update_journal_testing_check_checkpoint (test, &checkpoint,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0, 0x1234, 0,
+		0);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_init_full (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint checkpoint;
+	uint8_t entries[JOURNAL_ENTRY_LEN * 3];
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_entry (&entries[0], FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0, 0x1234, 0, 0);
+	firmware_update_journal_testing_entry (&entries[JOURNAL_ENTRY_LEN],
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE, 0, 0x1234,
+		0x2000, 0);
+	firmware_update_journal_testing_entry (&entries[JOURNAL_ENTRY_LEN * 2],
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0, 0x1234,
+		0x2000, 0x100);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_testing_expect_init (test, &flash, 0x10000, JOURNAL_SMALL_SECTOR,
+		entries, 3);
+
+	status = firmware_update_journal_init (&journal, &flash.base, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, JOURNAL_ENTRY_LEN * 3, journal.next_entry);
+
+	status = firmware_update_journal_get_checkpoint (&journal, &checkpoint);
+	CuAssertIntEquals (test, 0, status);
+	firmware_update_journal_testing_check_checkpoint (test, &checkpoint,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0, 0x1234,
+		0x2000, 0x100);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_init_null (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_init (NULL, &flash.base, 0x10000);
+	CuAssertIntEquals (test, FIRMWARE_UPDATE_JOURNAL_INVALID_ARGUMENT, status);
+
+	status = firmware_update_journal_init (&journal, NULL, 0x10000);
+	CuAssertIntEquals (test, FIRMWARE_UPDATE_JOURNAL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void firmware_update_journal_test_init_sector_size_error (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, FLASH_NO_MEMORY,
+		MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_init (&journal, &flash.base, 0x10000);
+	CuAssertIntEquals (test, FLASH_NO_MEMORY, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void firmware_update_journal_test_init_not_sector_aligned (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_init (&journal, &flash.base, 0x10100);
+	CuAssertIntEquals (test, FIRMWARE_UPDATE_JOURNAL_NOT_SECTOR_ALIGNED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void firmware_update_journal_test_init_read_error (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_NO_MEMORY,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (JOURNAL_ENTRY_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_init (&journal, &flash.base, 0x10000);
+	CuAssertIntEquals (test, FLASH_NO_MEMORY, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void firmware_update_journal_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	firmware_update_journal_release (NULL);
+}
+
+static void firmware_update_journal_test_record (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint checkpoint;
+	struct firmware_update_checkpoint latest;
+	uint8_t entry[JOURNAL_ENTRY_LEN];
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_init (test, &journal, &flash, FLASH_SECTOR_SIZE, NULL, 0);
+
+	checkpoint.step = FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE;
+	checkpoint.phase = FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE;
+	checkpoint.flags = FIRMWARE_UPDATE_JOURNAL_FLAG_RECOVERY_UPDATED;
+	checkpoint.image_length = 0x1234;
+	checkpoint.backup_length = 0x2000;
+	checkpoint.offset = 0;
+
+	firmware_update_journal_testing_entry (entry, FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE, FIRMWARE_UPDATE_JOURNAL_FLAG_RECOVERY_UPDATED,
+		0x1234, 0x2000, 0);
+
+	status = firmware_update_journal_testing_expect_record (&flash, 0x10000, entry);
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_record (&journal, &checkpoint);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, JOURNAL_ENTRY_LEN, journal.next_entry);
+
+	status = firmware_update_journal_get_checkpoint (&journal, &latest);
+	CuAssertIntEquals (test, 0, status);
+	firmware_update_journal_testing_check_checkpoint (test, &latest,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE,
+		FIRMWARE_UPDATE_JOURNAL_FLAG_RECOVERY_UPDATED, 0x1234, 0x2000, 0);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_record_multiple (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint checkpoint;
+	struct firmware_update_checkpoint latest;
+	uint8_t entries[JOURNAL_ENTRY_LEN];
+	uint8_t entry[JOURNAL_ENTRY_LEN * 2];
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_entry (entries, FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0, 0x1234, 0, 0);
+
+	firmware_update_journal_testing_init (test, &journal, &flash, FLASH_SECTOR_SIZE, entries, 1);
+
+	checkpoint.step = FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE;
+	checkpoint.phase = FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM;
+	checkpoint.flags = 0;
+	checkpoint.image_length = 0x1234;
+	checkpoint.backup_length = 0x2000;
+	checkpoint.offset = 0x100;
+
+	firmware_update_journal_testing_entry (&entry[0], FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0, 0x1234, 0x2000, 0x100);
+	firmware_update_journal_testing_entry (&entry[JOURNAL_ENTRY_LEN],
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0, 0x1234,
+		0x2000, 0x1100);
+
+	status = firmware_update_journal_testing_expect_record (&flash, 0x10000 + JOURNAL_ENTRY_LEN,
+		&entry[0]);
+	status |= firmware_update_journal_testing_expect_record (&flash,
+		0x10000 + (JOURNAL_ENTRY_LEN * 2), &entry[JOURNAL_ENTRY_LEN]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_record (&journal, &checkpoint);
+	CuAssertIntEquals (test, 0, status);
+
+	checkpoint.offset = 0x1100;
+	status = firmware_update_journal_record (&journal, &checkpoint);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, JOURNAL_ENTRY_LEN * 3, journal.next_entry);
+
+	status = firmware_update_journal_get_checkpoint (&journal, &latest);
+	CuAssertIntEquals (test, 0, status);
+	firmware_update_journal_testing_check_checkpoint (test, &latest,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0, 0x1234,
+		0x2000, 0x1100);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_record_full_sector (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint checkpoint;
+	struct firmware_update_checkpoint latest;
+	uint8_t entries[JOURNAL_ENTRY_LEN * 3];
+	uint8_t entry[JOURNAL_ENTRY_LEN];
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_entry (&entries[0], FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0, 0x1234, 0, 0);
+	firmware_update_journal_testing_entry (&entries[JOURNAL_ENTRY_LEN],
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE, 0, 0x1234,
+		0x2000, 0);
+	firmware_update_journal_testing_entry (&entries[JOURNAL_ENTRY_LEN * 2],
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0, 0x1234,
+		0x2000, 0x100);
+
+	firmware_update_journal_testing_init (test, &journal, &flash, JOURNAL_SMALL_SECTOR, entries,
+		3);
+
+	checkpoint.step = FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE;
+	checkpoint.phase = FIRMWARE_UPDATE_JOURNAL_PHASE_HEADER;
+	checkpoint.flags = 0;
+	checkpoint.image_length = 0x1234;
+	checkpoint.backup_length = 0x2000;
+	checkpoint.offset = 0x1234;
+
+	firmware_update_journal_testing_entry (entry, FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_HEADER, 0, 0x1234, 0x2000, 0x1234);
+
+	status = mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+	status |= firmware_update_journal_testing_expect_record (&flash, 0x10000, entry);
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_record (&journal, &checkpoint);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, JOURNAL_ENTRY_LEN, journal.next_entry);
+
+	status = firmware_update_journal_get_checkpoint (&journal, &latest);
+	CuAssertIntEquals (test, 0, status);
+	firmware_update_journal_testing_check_checkpoint (test, &latest,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_HEADER, 0, 0x1234,
+		0x2000, 0x1234);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_record_null (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint checkpoint;
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_init (test, &journal, &flash, FLASH_SECTOR_SIZE, NULL, 0);
+
+	memset (&checkpoint, 0, sizeof (checkpoint));
+
+	status = firmware_update_journal_record (NULL, &checkpoint);
+	CuAssertIntEquals (test, FIRMWARE_UPDATE_JOURNAL_INVALID_ARGUMENT, status);
+
+	status = firmware_update_journal_record (&journal, NULL);
+	CuAssertIntEquals (test, FIRMWARE_UPDATE_JOURNAL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_record_erase_error (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint checkpoint;
+	struct firmware_update_checkpoint latest;
+	uint8_t entries[JOURNAL_ENTRY_LEN * 3];
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_entry (&entries[0], FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0, 0x1234, 0, 0);
+	firmware_update_journal_testing_entry (&entries[JOURNAL_ENTRY_LEN],
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE, 0, 0x1234,
+		0x2000, 0);
+	firmware_update_journal_testing_entry (&entries[JOURNAL_ENTRY_LEN * 2],
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0, 0x1234,
+		0x2000, 0x100);
+
+	firmware_update_journal_testing_init (test, &journal, &flash, JOURNAL_SMALL_SECTOR, entries,
+		3);
+
+	memset (&checkpoint, 0, sizeof (checkpoint));
+
+	status = mock_expect (&flash.mock, flash.base.sector_erase, &flash, FLASH_NO_MEMORY,
+		MOCK_ARG (0x10000));
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_record (&journal, &checkpoint);
+	CuAssertIntEquals (test, FLASH_NO_MEMORY, status);
+
+	status = firmware_update_journal_get_checkpoint (&journal, &latest);
+	CuAssertIntEquals (test, 0, status);
+	firmware_update_journal_testing_check_checkpoint (test, &latest,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0, 0x1234,
+		0x2000, 0x100);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_record_write_error (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint checkpoint;
+	struct firmware_update_checkpoint latest;
+	uint8_t entry[JOURNAL_ENTRY_LEN];
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_init (test, &journal, &flash, FLASH_SECTOR_SIZE, NULL, 0);
+
+	memset (&checkpoint, 0, sizeof (checkpoint));
+	checkpoint.phase = FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED;
+
+	firmware_update_journal_testing_entry (entry, 0, FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0, 0,
+		0, 0);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, FLASH_NO_MEMORY,
+		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (entry, JOURNAL_ENTRY_LEN),
+		MOCK_ARG (JOURNAL_ENTRY_LEN));
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_record (&journal, &checkpoint);
+	CuAssertIntEquals (test, FLASH_NO_MEMORY, status);
+	CuAssertIntEquals (test, JOURNAL_ENTRY_LEN, journal.next_entry);
+
+	status = firmware_update_journal_get_checkpoint (&journal, &latest);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, latest.phase);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_record_incomplete_write (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint checkpoint;
+	struct firmware_update_checkpoint latest;
+	uint8_t entry[JOURNAL_ENTRY_LEN];
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_init (test, &journal, &flash, FLASH_SECTOR_SIZE, NULL, 0);
+
+	memset (&checkpoint, 0, sizeof (checkpoint));
+	checkpoint.phase = FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED;
+
+	firmware_update_journal_testing_entry (entry, 0, FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0, 0,
+		0, 0);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, JOURNAL_ENTRY_LEN - 1,
+		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (entry, JOURNAL_ENTRY_LEN),
+		MOCK_ARG (JOURNAL_ENTRY_LEN));
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_record (&journal, &checkpoint);
+	CuAssertIntEquals (test, FIRMWARE_UPDATE_JOURNAL_INCOMPLETE_WRITE, status);
+	CuAssertIntEquals (test, JOURNAL_ENTRY_LEN, journal.next_entry);
+
+	status = firmware_update_journal_get_checkpoint (&journal, &latest);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, latest.phase);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_record_verify_mismatch (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint checkpoint;
+	struct firmware_update_checkpoint latest;
+	uint8_t entry[JOURNAL_ENTRY_LEN];
+	uint8_t bad[JOURNAL_ENTRY_LEN];
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_init (test, &journal, &flash, FLASH_SECTOR_SIZE, NULL, 0);
+
+	memset (&checkpoint, 0, sizeof (checkpoint));
+	checkpoint.phase = FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED;
+
+	firmware_update_journal_testing_entry (entry, 0, FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0, 0,
+		0, 0);
+	memcpy (bad, entry, sizeof (bad));
+	bad[5] ^= 0x10;
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, JOURNAL_ENTRY_LEN,
+		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (entry, JOURNAL_ENTRY_LEN),
+		MOCK_ARG (JOURNAL_ENTRY_LEN));
+	status |= flash_mock_expect_verify_flash (&flash, 0x10000, bad, JOURNAL_ENTRY_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_record (&journal, &checkpoint);
+	CuAssertIntEquals (test, FLASH_UTIL_DATA_MISMATCH, status);
+	CuAssertIntEquals (test, JOURNAL_ENTRY_LEN, journal.next_entry);
+
+	status = firmware_update_journal_get_checkpoint (&journal, &latest);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, latest.phase);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_clear (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint latest;
+	uint8_t entries[JOURNAL_ENTRY_LEN];
+	uint8_t entry[JOURNAL_ENTRY_LEN];
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_entry (entries, FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_DONE, 0, 0x1234, 0x2000, 0x1234);
+
+	firmware_update_journal_testing_init (test, &journal, &flash, FLASH_SECTOR_SIZE, entries, 1);
+
+	firmware_update_journal_testing_entry (entry, 0, FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0,
+		0);
+
+	status = firmware_update_journal_testing_expect_record (&flash, 0x10000 + JOURNAL_ENTRY_LEN,
+		entry);
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_clear (&journal);
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_get_checkpoint (&journal, &latest);
+	CuAssertIntEquals (test, 0, status);
+	firmware_update_journal_testing_check_checkpoint (test, &latest, 0,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0, 0);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_clear_already_idle (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_init (test, &journal, &flash, FLASH_SECTOR_SIZE, NULL, 0);
+
+	status = firmware_update_journal_clear (&journal);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, journal.next_entry);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_clear_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = firmware_update_journal_clear (NULL);
+	CuAssertIntEquals (test, FIRMWARE_UPDATE_JOURNAL_INVALID_ARGUMENT, status);
+}
+
+static void firmware_update_journal_test_clear_write_error (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint latest;
+	uint8_t entries[JOURNAL_ENTRY_LEN];
+	uint8_t entry[JOURNAL_ENTRY_LEN];
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_entry (entries, FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_DONE, 0, 0x1234, 0x2000, 0x1234);
+
+	firmware_update_journal_testing_init (test, &journal, &flash, FLASH_SECTOR_SIZE, entries, 1);
+
+	firmware_update_journal_testing_entry (entry, 0, FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0,
+		0);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, FLASH_NO_MEMORY,
+		MOCK_ARG (0x10000 + JOURNAL_ENTRY_LEN), MOCK_ARG_PTR_CONTAINS (entry, JOURNAL_ENTRY_LEN),
+		MOCK_ARG (JOURNAL_ENTRY_LEN));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_clear (&journal);
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_get_checkpoint (&journal, &latest);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, latest.phase);
+	CuAssertIntEquals (test, 0, journal.next_entry);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_clear_erase_error (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint latest;
+	uint8_t entries[JOURNAL_ENTRY_LEN];
+	uint8_t entry[JOURNAL_ENTRY_LEN];
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_entry (entries, FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_DONE, 0, 0x1234, 0x2000, 0x1234);
+
+	firmware_update_journal_testing_init (test, &journal, &flash, FLASH_SECTOR_SIZE, entries, 1);
+
+	firmware_update_journal_testing_entry (entry, 0, FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0,
+		0);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, FLASH_NO_MEMORY,
+		MOCK_ARG (0x10000 + JOURNAL_ENTRY_LEN), MOCK_ARG_PTR_CONTAINS (entry, JOURNAL_ENTRY_LEN),
+		MOCK_ARG (JOURNAL_ENTRY_LEN));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, FLASH_SECTOR_ERASE_FAILED,
+		MOCK_ARG (0x10000));
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_clear (&journal);
+	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
+
+	status = firmware_update_journal_get_checkpoint (&journal, &latest);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FIRMWARE_UPDATE_JOURNAL_PHASE_DONE, latest.phase);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+static void firmware_update_journal_test_get_checkpoint_null (CuTest *test)
+{
+	struct flash_mock flash;
+	struct firmware_update_journal journal;
+	struct firmware_update_checkpoint checkpoint;
+	int status;
+
+	TEST_START;
+
+	firmware_update_journal_testing_init (test, &journal, &flash, FLASH_SECTOR_SIZE, NULL, 0);
+
+	status = firmware_update_journal_get_checkpoint (NULL, &checkpoint);
+	CuAssertIntEquals (test, FIRMWARE_UPDATE_JOURNAL_INVALID_ARGUMENT, status);
+
+	status = firmware_update_journal_get_checkpoint (&journal, NULL);
+	CuAssertIntEquals (test, FIRMWARE_UPDATE_JOURNAL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+}
+
+
+CuSuite* get_firmware_update_journal_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_init);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_init_find_latest);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_init_skip_torn_entry);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_init_skip_bad_crc);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_init_skip_unknown_phase);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_init_full);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_init_null);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_init_sector_size_error);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_init_not_sector_aligned);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_init_read_error);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_release_null);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_record);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_record_multiple);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_record_full_sector);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_record_null);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_record_erase_error);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_record_write_error);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_record_incomplete_write);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_record_verify_mismatch);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_clear);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_clear_already_idle);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_clear_null);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_clear_write_error);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_clear_erase_error);
+	SUITE_ADD_TEST (suite, firmware_update_journal_test_get_checkpoint_null);
+
+	return suite;
+}
@@ -7,6 +7,7 @@
 #include "testing.h"
 #include "firmware/firmware_update.h"
 #include "flash/flash_common.h"
+#include "flash/flash_util.h"
 #include "engines/hash_testing_engine.h"
 #include "engines/rsa_testing_engine.h"
 #include "mock/firmware_image_mock.h"
@@ -16,6 +17,8 @@
 #include "mock/key_manifest_mock.h"
 #include "mock/firmware_update_mock.h"
 #include "mock/firmware_update_observer_mock.h"
+#include "mock/hash_mock.h"
+#include "crypto/checksum.h"
 #include "rsa_testing.h"
 #include "firmware_header_testing.h"
 #include "image_header_testing.h"
@@ -307,6 +310,205 @@ void firmware_update_testing_validate_and_release (CuTest *test,
 	HASH_TESTING_ENGINE_RELEASE (&updater->hash);
 }
 
+/**
+ * Prepare staging flash and write an image in two parts, reading back the data programmed for
+ * some of the parts.
+ *
+ * @param test The testing framework.
+ * @param updater The testing components to use.
+ * @param data The image data to write.
+ * @param length The length of the image data.
+ * @param first The number of bytes to write in the first part.
+ * @param verified The number of parts that will be read back after being written, starting with
+ * the first part.
+ */
+static void firmware_update_testing_write_staging_verified (CuTest *test,
+	struct firmware_update_testing *updater, const uint8_t *data, size_t length, size_t first,
+	int verified)
+{
+	int status;
+
+	status = mock_expect (&updater->handler.mock, updater->handler.base.status_change,
+		&updater->handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_PREP));
+	status |= flash_mock_expect_erase_flash_verify (&updater->flash, 0x30000, length);
+
+	status |= mock_expect (&updater->handler.mock, updater->handler.base.status_change,
+		&updater->handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_WRITE));
+	status |= mock_expect (&updater->flash.mock, updater->flash.base.write, &updater->flash,
+		first, MOCK_ARG (0x30000), MOCK_ARG_PTR_CONTAINS (data, first), MOCK_ARG (first));
+	if (verified > 0) {
+		status |= flash_mock_expect_verify_flash (&updater->flash, 0x30000, data, first);
+	}
+
+	status |= mock_expect (&updater->handler.mock, updater->handler.base.status_change,
+		&updater->handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_WRITE));
+	status |= mock_expect (&updater->flash.mock, updater->flash.base.write, &updater->flash,
+		length - first, MOCK_ARG (0x30000 + first), MOCK_ARG_PTR_CONTAINS (&data[first],
+		length - first), MOCK_ARG (length - first));
+	if (verified > 1) {
+		status |= flash_mock_expect_verify_flash (&updater->flash, 0x30000 + first, &data[first],
+			length - first);
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_prepare_staging (&updater->test, &updater->handler.base, length);
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_write_to_staging (&updater->test, &updater->handler.base,
+		(uint8_t*) data, first);
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_write_to_staging (&updater->test, &updater->handler.base,
+		(uint8_t*) &data[first], length - first);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, firmware_update_get_update_remaining (&updater->test));
+
+	firmware_update_testing_validate (test, updater);
+}
+
+/**
+ * Prepare staging flash and write an image in two parts.
+ *
+ * @param test The testing framework.
+ * @param updater The testing components to use.
+ * @param data The image data to write.
+ * @param length The length of the image data.
+ * @param first The number of bytes to write in the first part.
+ */
+static void firmware_update_testing_write_staging (CuTest *test,
+	struct firmware_update_testing *updater, const uint8_t *data, size_t length, size_t first)
+{
+	firmware_update_testing_write_staging_verified (test, updater, data, length, first, 0);
+}
+
+/**
+ * Build the flash contents for an update journal entry.
+ *
+ * @param entry Output for the entry data.  This must be 20 bytes.
+ * @param step The step in the entry.
+ * @param phase The phase in the entry.
+ * @param flags The flags in the entry.
+ * @param image_length The image length in the entry.
+ * @param backup_length The backup length in the entry.
+ * @param offset The image offset in the entry.
+ */
+static void firmware_update_testing_journal_entry (uint8_t *entry, uint8_t step, uint8_t phase,
+	uint8_t flags, uint32_t image_length, uint32_t backup_length, uint32_t offset)
+{
+	entry[0] = 0x4a;
+	entry[1] = step;
+	entry[2] = phase;
+	entry[3] = flags;
+	memcpy (&entry[4], &image_length, 4);
+	memcpy (&entry[8], &backup_length, 4);
+	memcpy (&entry[12], &offset, 4);
+	memset (&entry[16], 0xff, 3);
+	entry[19] = checksum_crc8 (0, entry, 19);
+}
+
+/**
+ * Initialize an update journal and configure the updater to use it.  The journal is stored at
+ * address 0x10000.
+ *
+ * @param test The testing framework.
+ * @param updater The testing components to update.
+ * @param journal The journal to initialize.
+ * @param flash The mock for the journal flash.
+ * @param entry The latest journal entry.  Null for an empty journal.
+ */
+static void firmware_update_testing_init_journal (CuTest *test,
+	struct firmware_update_testing *updater, struct firmware_update_journal *journal,
+	struct flash_mock *flash, const uint8_t *entry)
+{
+	uint8_t blank[20];
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t addr = 0x10000;
+	int status;
+
+	memset (blank, 0xff, sizeof (blank));
+
+	status = flash_mock_init (flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash->mock, flash->base.get_sector_size, flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash->mock, 0, &bytes, sizeof (bytes), -1);
+
+	if (entry) {
+		status |= mock_expect (&flash->mock, flash->base.read, flash, 0, MOCK_ARG (addr),
+			MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (blank)));
+		status |= mock_expect_output (&flash->mock, 1, entry, sizeof (blank), 2);
+
+		addr += sizeof (blank);
+	}
+
+	status |= mock_expect (&flash->mock, flash->base.read, flash, 0, MOCK_ARG (addr),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (blank)));
+	status |= mock_expect_output (&flash->mock, 1, blank, sizeof (blank), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_journal_init (journal, &flash->base, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash->mock);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_set_journal (&updater->test, journal);
+}
+
+/**
+ * Set up expectations for recording an update checkpoint in the journal.
+ *
+ * @param flash The mock for the journal flash.
+ * @param index The index of the journal entry that will be written.
+ * @param step The step in the checkpoint.
+ * @param phase The phase in the checkpoint.
+ * @param flags The flags in the checkpoint.
+ * @param image_length The image length in the checkpoint.
+ * @param backup_length The backup length in the checkpoint.
+ * @param offset The image offset in the checkpoint.
+ *
+ * @return 0 if the expectations were set or non-zero if not.
+ */
+static int firmware_update_testing_expect_checkpoint (struct flash_mock *flash, int index,
+	uint8_t step, uint8_t phase, uint8_t flags, uint32_t image_length, uint32_t backup_length,
+	uint32_t offset)
+{
+	uint8_t entry[20];
+	uint32_t addr = 0x10000 + (index * sizeof (entry));
+	int status;
+
+	firmware_update_testing_journal_entry (entry, step, phase, flags, image_length, backup_length,
+		offset);
+
+	status = mock_expect (&flash->mock, flash->base.write, flash, sizeof (entry), MOCK_ARG (addr),
+		MOCK_ARG_PTR_CONTAINS_TMP (entry, sizeof (entry)), MOCK_ARG (sizeof (entry)));
+	status |= mock_expect (&flash->mock, flash->base.read, flash, 0, MOCK_ARG (addr),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (entry)));
+	status |= mock_expect_output_tmp (&flash->mock, 1, entry, sizeof (entry), 2);
+
+	return status;
+}
+
+/**
+ * Set expectations for querying the updater.flash block size.
+ *
+ * @param flash The flash mock to set expectations on.
+ * @param block The block size to report.
+ *
+ * @return 0 if the expectations were set or non-zero if not.
+ */
+static int firmware_update_testing_flash_block_size (struct flash_mock *flash, uint32_t block)
+{
+	int status;
+
+	status = mock_expect (&flash->mock, flash->base.get_block_size, flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&flash->mock, 0, &block, sizeof (block), -1);
+
+	return status;
+}
+
 /*******************
  * Test cases
  *******************/
@@ -791,6 +993,28 @@ static void firmware_update_test_set_image_offset_null (CuTest *test)
 	firmware_update_set_image_offset (NULL, 0x100);
 }
 
+static void firmware_update_test_set_staging_hash_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_set_staging_hash (NULL, &hash.base, 256);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void firmware_update_test_set_journal_null (CuTest *test)
+{
+	TEST_START;
+
+	firmware_update_set_journal (NULL, NULL);
+}
+
 static void firmware_update_test_add_observer_null (CuTest *test)
 {
 	struct firmware_update_testing updater;
@@ -10371,6 +10595,1911 @@ static void firmware_update_test_multiple_prepare_and_write_cycles_image_offset
 	firmware_update_testing_validate_and_release (test, &updater);
 }
 
+static void firmware_update_test_prepare_staging_staging_digest (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct hash_engine_mock stage_hash;
+	int status;
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+
+	status = hash_mock_init (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_set_staging_hash (&updater.test, &stage_hash.base, 3);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_PREP));
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x30000, 8);
+
+	status |= mock_expect (&stage_hash.mock, stage_hash.base.start_sha256, &stage_hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_prepare_staging (&updater.test, &updater.handler.base, 8);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 8, firmware_update_get_update_remaining (&updater.test));
+
+	status = mock_validate (&stage_hash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The active digest is cancelled when the updater is released. */
+	status = mock_expect (&stage_hash.mock, stage_hash.base.cancel, &stage_hash, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_testing_validate_and_release (test, &updater);
+
+	status = hash_mock_validate_and_release (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void firmware_update_test_prepare_staging_staging_digest_restart (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct hash_engine_mock stage_hash;
+	int status;
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+
+	status = hash_mock_init (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_set_staging_hash (&updater.test, &stage_hash.base, 3);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_PREP));
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x30000, 8);
+	status |= mock_expect (&stage_hash.mock, stage_hash.base.start_sha256, &stage_hash, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_PREP));
+	status |= mock_expect (&stage_hash.mock, stage_hash.base.cancel, &stage_hash, 0);
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x30000, 10);
+	status |= mock_expect (&stage_hash.mock, stage_hash.base.start_sha256, &stage_hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_prepare_staging (&updater.test, &updater.handler.base, 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_prepare_staging (&updater.test, &updater.handler.base, 10);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&stage_hash.mock, stage_hash.base.cancel, &stage_hash, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_testing_validate_and_release (test, &updater);
+
+	status = hash_mock_validate_and_release (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void firmware_update_test_prepare_staging_staging_digest_image_too_small (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct hash_engine_mock stage_hash;
+	int status;
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+
+	status = hash_mock_init (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_set_staging_hash (&updater.test, &stage_hash.base, 3);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_PREP));
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x30000, 3);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_prepare_staging (&updater.test, &updater.handler.base, 3);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_testing_validate_and_release (test, &updater);
+
+	status = hash_mock_validate_and_release (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void firmware_update_test_prepare_staging_staging_digest_start_error (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct hash_engine_mock stage_hash;
+	int status;
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+
+	status = hash_mock_init (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_set_staging_hash (&updater.test, &stage_hash.base, 3);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_PREP));
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x30000, 8);
+
+	status |= mock_expect (&stage_hash.mock, stage_hash.base.start_sha256, &stage_hash,
+		HASH_ENGINE_START_SHA256_FAILED);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_prepare_staging (&updater.test, &updater.handler.base, 8);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_testing_validate_and_release (test, &updater);
+
+	status = hash_mock_validate_and_release (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void firmware_update_test_write_to_staging_staging_digest_write_fail (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct hash_engine_mock stage_hash;
+	int status;
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18};
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+
+	status = hash_mock_init (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_set_staging_hash (&updater.test, &stage_hash.base, 3);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_PREP));
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x30000,
+		sizeof (staging_data));
+	status |= mock_expect (&stage_hash.mock, stage_hash.base.start_sha256, &stage_hash, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_WRITE));
+	status |= mock_expect (&updater.flash.mock, updater.flash.base.write, &updater.flash,
+		FLASH_WRITE_FAILED, MOCK_ARG (0x30000),
+		MOCK_ARG_PTR_CONTAINS (staging_data, sizeof (staging_data)),
+		MOCK_ARG (sizeof (staging_data)));
+	status |= mock_expect (&stage_hash.mock, stage_hash.base.cancel, &stage_hash, 0);
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_WRITE_FAIL));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_prepare_staging (&updater.test, &updater.handler.base,
+		sizeof (staging_data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_write_to_staging (&updater.test, &updater.handler.base, staging_data,
+		sizeof (staging_data));
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+
+	firmware_update_testing_validate_and_release (test, &updater);
+
+	status = hash_mock_validate_and_release (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void firmware_update_test_write_to_staging_staging_digest_verify_fail (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct hash_engine_mock stage_hash;
+	int status;
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18};
+	uint8_t flash_data[] = {0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x10};
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+
+	status = hash_mock_init (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_set_staging_hash (&updater.test, &stage_hash.base, 3);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_PREP));
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x30000,
+		sizeof (staging_data));
+	status |= mock_expect (&stage_hash.mock, stage_hash.base.start_sha256, &stage_hash, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_WRITE));
+	status |= mock_expect (&updater.flash.mock, updater.flash.base.write, &updater.flash,
+		sizeof (staging_data), MOCK_ARG (0x30000),
+		MOCK_ARG_PTR_CONTAINS (staging_data, sizeof (staging_data)),
+		MOCK_ARG (sizeof (staging_data)));
+	status |= flash_mock_expect_verify_flash (&updater.flash, 0x30000, flash_data,
+		sizeof (flash_data));
+	status |= mock_expect (&stage_hash.mock, stage_hash.base.cancel, &stage_hash, 0);
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_WRITE_FAIL));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_prepare_staging (&updater.test, &updater.handler.base,
+		sizeof (staging_data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_write_to_staging (&updater.test, &updater.handler.base, staging_data,
+		sizeof (staging_data));
+	CuAssertIntEquals (test, FLASH_UTIL_DATA_MISMATCH, status);
+
+	firmware_update_testing_validate_and_release (test, &updater);
+
+	status = hash_mock_validate_and_release (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void firmware_update_test_run_update_staging_digest (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	HASH_TESTING_ENGINE stage_hash;
+	int status;
+	uint8_t active_data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18};
+	uint8_t digest[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+
+	status = HASH_TESTING_ENGINE_INIT (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = updater.hash.base.calculate_sha256 (&updater.hash.base, staging_data,
+		sizeof (staging_data) - 3, digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_set_staging_hash (&updater.test, &stage_hash.base, 3);
+
+	firmware_update_testing_write_staging_verified (test, &updater, staging_data,
+		sizeof (staging_data), 4, 2);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify_digest, &updater.fw, 0,
+		MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa),
+		MOCK_ARG_PTR_CONTAINS (digest, sizeof (digest)), MOCK_ARG (sizeof (staging_data) - 3));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_firmware_header, &updater.fw,
+		(intptr_t) &updater.header);
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_SAVING_STATE));
+	status |= mock_expect (&updater.app.mock, updater.app.base.save, &updater.app, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_BACKUP_ACTIVE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x10000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (active_data));
+	status |= flash_mock_expect_erase_copy_verify (&updater.flash, &updater.flash, 0x20000, 0x10000,
+		active_data, sizeof (active_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_UPDATING_IMAGE));
+	status |= firmware_update_testing_flash_page_size (&updater.flash, FLASH_PAGE_SIZE);
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x10000, sizeof (staging_data));
+	status |= flash_mock_expect_copy_flash_verify (&updater.flash, &updater.flash, 0x10000, 0x30000,
+		staging_data, sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_REVOCATION));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x10000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_key_manifest, &updater.fw,
+		(intptr_t) &updater.manifest);
+	status |= mock_expect (&updater.manifest.mock, updater.manifest.base.revokes_old_manifest,
+		&updater.manifest, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_RECOVERY));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_testing_validate_and_release (test, &updater);
+
+	HASH_TESTING_ENGINE_RELEASE (&stage_hash);
+}
+
+static void firmware_update_test_run_update_staging_digest_image_offset (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	HASH_TESTING_ENGINE stage_hash;
+	int status;
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18};
+	uint8_t digest[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+
+	status = HASH_TESTING_ENGINE_INIT (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = updater.hash.base.calculate_sha256 (&updater.hash.base, staging_data,
+		sizeof (staging_data) - 3, digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_set_image_offset (&updater.test, 0x100);
+	firmware_update_set_staging_hash (&updater.test, &stage_hash.base, 3);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_PREP));
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x30100,
+		sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_WRITE));
+	status |= mock_expect (&updater.flash.mock, updater.flash.base.write, &updater.flash,
+		sizeof (staging_data), MOCK_ARG (0x30100),
+		MOCK_ARG_PTR_CONTAINS (staging_data, sizeof (staging_data)),
+		MOCK_ARG (sizeof (staging_data)));
+	status |= flash_mock_expect_verify_flash (&updater.flash, 0x30100, staging_data,
+		sizeof (staging_data));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_prepare_staging (&updater.test, &updater.handler.base,
+		sizeof (staging_data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_write_to_staging (&updater.test, &updater.handler.base, staging_data,
+		sizeof (staging_data));
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_testing_validate (test, &updater);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30100));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify_digest, &updater.fw,
+		RSA_ENGINE_BAD_SIGNATURE, MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa),
+		MOCK_ARG_PTR_CONTAINS (digest, sizeof (digest)), MOCK_ARG (sizeof (staging_data) - 3));
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_INVALID_IMAGE));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	firmware_update_testing_validate_and_release (test, &updater);
+
+	HASH_TESTING_ENGINE_RELEASE (&stage_hash);
+}
+
+static void firmware_update_test_run_update_staging_digest_length_mismatch (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	HASH_TESTING_ENGINE stage_hash;
+	int status;
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18};
+	uint8_t digest[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+
+	status = HASH_TESTING_ENGINE_INIT (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = updater.hash.base.calculate_sha256 (&updater.hash.base, staging_data,
+		sizeof (staging_data) - 3, digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_set_staging_hash (&updater.test, &stage_hash.base, 3);
+
+	firmware_update_testing_write_staging_verified (test, &updater, staging_data,
+		sizeof (staging_data), 6, 2);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify_digest, &updater.fw,
+		FIRMWARE_IMAGE_DIGEST_LENGTH_MISMATCH, MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa),
+		MOCK_ARG_PTR_CONTAINS (digest, sizeof (digest)), MOCK_ARG (sizeof (staging_data) - 3));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw,
+		RSA_ENGINE_BAD_SIGNATURE, MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_INVALID_IMAGE));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	firmware_update_testing_validate_and_release (test, &updater);
+
+	HASH_TESTING_ENGINE_RELEASE (&stage_hash);
+}
+
+static void firmware_update_test_run_update_staging_digest_not_supported (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct hash_engine_mock stage_hash;
+	int status;
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18};
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+	updater.fw.base.verify_digest = NULL;
+
+	status = hash_mock_init (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+
+	/* No digest is calculated for an image that can't use it. */
+	firmware_update_set_staging_hash (&updater.test, &stage_hash.base, 3);
+
+	firmware_update_testing_write_staging (test, &updater, staging_data, sizeof (staging_data), 4);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw,
+		FIRMWARE_IMAGE_VERIFY_FAILED, MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFY_FAILURE));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, FIRMWARE_IMAGE_VERIFY_FAILED, status);
+
+	firmware_update_testing_validate_and_release (test, &updater);
+
+	status = hash_mock_validate_and_release (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void firmware_update_test_run_update_staging_digest_hash_update_error (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct hash_engine_mock stage_hash;
+	int status;
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18};
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+
+	status = hash_mock_init (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_set_staging_hash (&updater.test, &stage_hash.base, 3);
+
+	status = mock_expect (&stage_hash.mock, stage_hash.base.start_sha256, &stage_hash, 0);
+	status |= mock_expect (&stage_hash.mock, stage_hash.base.update, &stage_hash,
+		HASH_ENGINE_UPDATE_FAILED, MOCK_ARG_PTR_CONTAINS (staging_data, 4), MOCK_ARG (4));
+	status |= mock_expect (&stage_hash.mock, stage_hash.base.cancel, &stage_hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_testing_write_staging_verified (test, &updater, staging_data,
+		sizeof (staging_data), 4, 1);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw,
+		RSA_ENGINE_BAD_SIGNATURE, MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_INVALID_IMAGE));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	firmware_update_testing_validate_and_release (test, &updater);
+
+	status = hash_mock_validate_and_release (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void firmware_update_test_run_update_staging_digest_hash_finish_error (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct hash_engine_mock stage_hash;
+	int status;
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18};
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+
+	status = hash_mock_init (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_set_staging_hash (&updater.test, &stage_hash.base, 3);
+
+	status = mock_expect (&stage_hash.mock, stage_hash.base.start_sha256, &stage_hash, 0);
+	status |= mock_expect (&stage_hash.mock, stage_hash.base.update, &stage_hash, 0,
+		MOCK_ARG_PTR_CONTAINS (staging_data, 4), MOCK_ARG (4));
+	status |= mock_expect (&stage_hash.mock, stage_hash.base.update, &stage_hash, 0,
+		MOCK_ARG_PTR_CONTAINS (&staging_data[4], 1), MOCK_ARG (1));
+
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_testing_write_staging_verified (test, &updater, staging_data,
+		sizeof (staging_data), 4, 2);
+
+	status = mock_expect (&stage_hash.mock, stage_hash.base.finish, &stage_hash,
+		HASH_ENGINE_FINISH_FAILED, MOCK_ARG_NOT_NULL, MOCK_ARG (SHA256_HASH_LENGTH));
+	status |= mock_expect (&stage_hash.mock, stage_hash.base.cancel, &stage_hash, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw,
+		RSA_ENGINE_BAD_SIGNATURE, MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_INVALID_IMAGE));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	firmware_update_testing_validate_and_release (test, &updater);
+
+	status = hash_mock_validate_and_release (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void firmware_update_test_run_update_staging_digest_used_once (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	HASH_TESTING_ENGINE stage_hash;
+	int status;
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18};
+	uint8_t digest[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+
+	status = HASH_TESTING_ENGINE_INIT (&stage_hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = updater.hash.base.calculate_sha256 (&updater.hash.base, staging_data,
+		sizeof (staging_data) - 3, digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_set_staging_hash (&updater.test, &stage_hash.base, 3);
+
+	firmware_update_testing_write_staging_verified (test, &updater, staging_data,
+		sizeof (staging_data), 4, 2);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify_digest, &updater.fw,
+		RSA_ENGINE_BAD_SIGNATURE, MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa),
+		MOCK_ARG_PTR_CONTAINS (digest, sizeof (digest)), MOCK_ARG (sizeof (staging_data) - 3));
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_INVALID_IMAGE));
+
+	/* A second attempt must read the image from flash. */
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw,
+		RSA_ENGINE_BAD_SIGNATURE, MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_INVALID_IMAGE));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	firmware_update_testing_validate_and_release (test, &updater);
+
+	HASH_TESTING_ENGINE_RELEASE (&stage_hash);
+}
+
+static void firmware_update_test_run_update_journal (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct firmware_update_journal journal;
+	struct flash_mock journal_flash;
+	int status;
+	uint8_t active_data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15};
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+	firmware_update_testing_init_journal (test, &updater, &journal, &journal_flash, NULL);
+
+	CuAssertIntEquals (test, false, firmware_update_is_resume_pending (&updater.test));
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw, 0,
+		MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_firmware_header, &updater.fw,
+		(intptr_t) &updater.header);
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_SAVING_STATE));
+	status |= mock_expect (&updater.app.mock, updater.app.base.save, &updater.app, 0);
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 0,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0,
+		sizeof (staging_data), 0, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_BACKUP_ACTIVE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x10000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (active_data));
+	status |= flash_mock_expect_erase_copy_verify (&updater.flash, &updater.flash, 0x20000, 0x10000,
+		active_data, sizeof (active_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 1,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE, 0,
+		sizeof (staging_data), sizeof (active_data), 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_UPDATING_IMAGE));
+	status |= firmware_update_testing_flash_page_size (&updater.flash, FLASH_PAGE_SIZE);
+	status |= firmware_update_testing_flash_block_size (&updater.flash, FLASH_BLOCK_SIZE);
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x10000, sizeof (staging_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 2,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0,
+		sizeof (staging_data), sizeof (active_data), sizeof (staging_data));
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 3,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_HEADER, 0,
+		sizeof (staging_data), sizeof (active_data), sizeof (staging_data));
+
+	status |= flash_mock_expect_copy_flash_verify (&updater.flash, &updater.flash, 0x10000, 0x30000,
+		staging_data, sizeof (staging_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 4,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_DONE, 0,
+		sizeof (staging_data), sizeof (active_data), sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_REVOCATION));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x10000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_key_manifest, &updater.fw,
+		(intptr_t) &updater.manifest);
+	status |= mock_expect (&updater.manifest.mock, updater.manifest.base.revokes_old_manifest,
+		 &updater.manifest, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_RECOVERY));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 5, 0,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, firmware_update_is_resume_pending (&updater.test));
+
+	status = flash_mock_validate_and_release (&journal_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+	firmware_update_testing_validate_and_release (test, &updater);
+}
+
+static void firmware_update_test_run_update_journal_checkpoint_each_block (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct firmware_update_journal journal;
+	struct flash_mock journal_flash;
+	int status;
+	uint8_t active_data[] = {0x01, 0x02, 0x03, 0x04};
+	static uint8_t staging_data[0x100 + FLASH_BLOCK_SIZE + 0x80];
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (staging_data); i++) {
+		staging_data[i] = RSA_PRIVKEY_DER[i % RSA_PRIVKEY_DER_LEN];
+	}
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+	firmware_update_testing_init_journal (test, &updater, &journal, &journal_flash, NULL);
+
+	/* Start the image 0x100 bytes before the end of an erase block. */
+	updater.map.active_addr = 0x1ff00;
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw, 0,
+		MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_firmware_header, &updater.fw,
+		(intptr_t) &updater.header);
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_SAVING_STATE));
+	status |= mock_expect (&updater.app.mock, updater.app.base.save, &updater.app, 0);
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 0,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0,
+		sizeof (staging_data), 0, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_BACKUP_ACTIVE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x1ff00));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (active_data));
+	status |= flash_mock_expect_erase_copy_verify (&updater.flash, &updater.flash, 0x20000, 0x1ff00,
+		active_data, sizeof (active_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 1,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE, 0,
+		sizeof (staging_data), sizeof (active_data), 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_UPDATING_IMAGE));
+	status |= firmware_update_testing_flash_page_size (&updater.flash, FLASH_PAGE_SIZE);
+	status |= firmware_update_testing_flash_block_size (&updater.flash, FLASH_BLOCK_SIZE);
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x1ff00, sizeof (staging_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 2,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0,
+		sizeof (staging_data), sizeof (active_data), 0x100);
+
+	status |= flash_mock_expect_copy_flash_verify (&updater.flash, &updater.flash, 0x20000, 0x30100,
+		staging_data + 0x100, FLASH_BLOCK_SIZE);
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 3,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0,
+		sizeof (staging_data), sizeof (active_data), 0x100 + FLASH_BLOCK_SIZE);
+
+	status |= flash_mock_expect_copy_flash_verify (&updater.flash, &updater.flash, 0x30000, 0x40100,
+		staging_data + 0x100 + FLASH_BLOCK_SIZE, 0x80);
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 4,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0,
+		sizeof (staging_data), sizeof (active_data), sizeof (staging_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 5,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_HEADER, 0,
+		sizeof (staging_data), sizeof (active_data), sizeof (staging_data));
+	status |= flash_mock_expect_copy_flash_verify (&updater.flash, &updater.flash, 0x1ff00, 0x30000,
+		staging_data, 0x100);
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 6,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_DONE, 0,
+		sizeof (staging_data), sizeof (active_data), sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_REVOCATION));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x1ff00));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_key_manifest, &updater.fw,
+		(intptr_t) &updater.manifest);
+	status |= mock_expect (&updater.manifest.mock, updater.manifest.base.revokes_old_manifest,
+		 &updater.manifest, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_RECOVERY));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 7, 0,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&journal_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+	firmware_update_testing_validate_and_release (test, &updater);
+}
+
+static void firmware_update_test_run_update_journal_resume_program (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct firmware_update_journal journal;
+	struct flash_mock journal_flash;
+	int status;
+	uint8_t entry[20];
+	uint8_t staging_data[0x180];
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (staging_data); i++) {
+		staging_data[i] = RSA_PRIVKEY_DER[i % RSA_PRIVKEY_DER_LEN];
+	}
+
+	firmware_update_testing_journal_entry (entry, FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0, sizeof (staging_data), 4, 0x100);
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+	firmware_update_testing_init_journal (test, &updater, &journal, &journal_flash, entry);
+
+	updater.map.active_addr = 0x1ff00;
+
+	CuAssertIntEquals (test, true, firmware_update_is_resume_pending (&updater.test));
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw, 0,
+		MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_firmware_header, &updater.fw,
+		(intptr_t) &updater.header);
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_SAVING_STATE));
+	status |= mock_expect (&updater.app.mock, updater.app.base.save, &updater.app, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_UPDATING_IMAGE));
+	status |= firmware_update_testing_flash_page_size (&updater.flash, FLASH_PAGE_SIZE);
+	status |= firmware_update_testing_flash_block_size (&updater.flash, FLASH_BLOCK_SIZE);
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x20000, 0x80);
+
+	status |= flash_mock_expect_copy_flash_verify (&updater.flash, &updater.flash, 0x20000, 0x30100,
+		staging_data + 0x100, 0x80);
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 1,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0,
+		sizeof (staging_data), 4, sizeof (staging_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 2,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_HEADER, 0,
+		sizeof (staging_data), 4, sizeof (staging_data));
+	status |= flash_mock_expect_copy_flash_verify (&updater.flash, &updater.flash, 0x1ff00, 0x30000,
+		staging_data, 0x100);
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 3,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_DONE, 0,
+		sizeof (staging_data), 4, sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_REVOCATION));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x1ff00));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_key_manifest, &updater.fw,
+		(intptr_t) &updater.manifest);
+	status |= mock_expect (&updater.manifest.mock, updater.manifest.base.revokes_old_manifest,
+		 &updater.manifest, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_RECOVERY));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 4, 0,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, firmware_update_is_resume_pending (&updater.test));
+
+	status = flash_mock_validate_and_release (&journal_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+	firmware_update_testing_validate_and_release (test, &updater);
+}
+
+static void firmware_update_test_run_update_journal_resume_header (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct firmware_update_journal journal;
+	struct flash_mock journal_flash;
+	int status;
+	uint8_t entry[20];
+	uint8_t staging_data[0x180];
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (staging_data); i++) {
+		staging_data[i] = RSA_PRIVKEY_DER[i % RSA_PRIVKEY_DER_LEN];
+	}
+
+	firmware_update_testing_journal_entry (entry, FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_HEADER, 0, sizeof (staging_data), 4, sizeof (staging_data));
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+	firmware_update_testing_init_journal (test, &updater, &journal, &journal_flash, entry);
+
+	updater.map.active_addr = 0x1ff00;
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw, 0,
+		MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_firmware_header, &updater.fw,
+		(intptr_t) &updater.header);
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_SAVING_STATE));
+	status |= mock_expect (&updater.app.mock, updater.app.base.save, &updater.app, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_UPDATING_IMAGE));
+	status |= firmware_update_testing_flash_page_size (&updater.flash, FLASH_PAGE_SIZE);
+	status |= firmware_update_testing_flash_block_size (&updater.flash, FLASH_BLOCK_SIZE);
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x1ff00, 0x100);
+	status |= flash_mock_expect_copy_flash_verify (&updater.flash, &updater.flash, 0x1ff00, 0x30000,
+		staging_data, 0x100);
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 1,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_DONE, 0,
+		sizeof (staging_data), 4, sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_REVOCATION));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x1ff00));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_key_manifest, &updater.fw,
+		(intptr_t) &updater.manifest);
+	status |= mock_expect (&updater.manifest.mock, updater.manifest.base.revokes_old_manifest,
+		 &updater.manifest, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_RECOVERY));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 2, 0,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&journal_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+	firmware_update_testing_validate_and_release (test, &updater);
+}
+
+static void firmware_update_test_run_update_journal_resume_recovery (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct firmware_update_journal journal;
+	struct flash_mock journal_flash;
+	int status;
+	uint8_t entry[20];
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15};
+
+	TEST_START;
+
+	firmware_update_testing_journal_entry (entry, FIRMWARE_UPDATE_JOURNAL_STEP_RECOVERY,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE, 0, sizeof (staging_data), 4, 0);
+
+	/* The recovery revision matches the new image, but the interrupted write must be finished. */
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+	firmware_update_testing_init_journal (test, &updater, &journal, &journal_flash, entry);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw, 0,
+		MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_firmware_header, &updater.fw,
+		(intptr_t) &updater.header);
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_SAVING_STATE));
+	status |= mock_expect (&updater.app.mock, updater.app.base.save, &updater.app, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_REVOCATION));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x10000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_key_manifest, &updater.fw,
+		(intptr_t) &updater.manifest);
+	status |= mock_expect (&updater.manifest.mock, updater.manifest.base.revokes_old_manifest,
+		 &updater.manifest, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_RECOVERY));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_UPDATE_RECOVERY));
+	status |= firmware_update_testing_flash_page_size (&updater.flash, FLASH_PAGE_SIZE);
+	status |= firmware_update_testing_flash_block_size (&updater.flash, FLASH_BLOCK_SIZE);
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x40000, sizeof (staging_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 1,
+		FIRMWARE_UPDATE_JOURNAL_STEP_RECOVERY, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0,
+		sizeof (staging_data), 4, sizeof (staging_data));
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 2,
+		FIRMWARE_UPDATE_JOURNAL_STEP_RECOVERY, FIRMWARE_UPDATE_JOURNAL_PHASE_HEADER, 0,
+		sizeof (staging_data), 4, sizeof (staging_data));
+
+	status |= flash_mock_expect_copy_flash_verify (&updater.flash, &updater.flash, 0x40000, 0x30000,
+		staging_data, sizeof (staging_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 3,
+		FIRMWARE_UPDATE_JOURNAL_STEP_RECOVERY, FIRMWARE_UPDATE_JOURNAL_PHASE_DONE, 0,
+		sizeof (staging_data), 4, sizeof (staging_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 4, 0,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, false, updater.test.recovery_bad);
+
+	status = flash_mock_validate_and_release (&journal_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+	firmware_update_testing_validate_and_release (test, &updater);
+}
+
+static void firmware_update_test_run_update_journal_resume_recovery_updated (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct firmware_update_journal journal;
+	struct flash_mock journal_flash;
+	int status;
+	uint8_t entry[20];
+	uint8_t active_data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15};
+
+	TEST_START;
+
+	firmware_update_testing_journal_entry (entry, FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, FIRMWARE_UPDATE_JOURNAL_FLAG_RECOVERY_UPDATED,
+		sizeof (staging_data), 0, 0);
+
+	/* The recovery revision doesn't match, but recovery was already written by this update. */
+	firmware_update_testing_init (test, &updater, 0, 1, 0);
+	firmware_update_testing_init_journal (test, &updater, &journal, &journal_flash, entry);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw, 0,
+		MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_firmware_header, &updater.fw,
+		(intptr_t) &updater.header);
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_SAVING_STATE));
+	status |= mock_expect (&updater.app.mock, updater.app.base.save, &updater.app, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_BACKUP_ACTIVE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x10000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (active_data));
+	status |= flash_mock_expect_erase_copy_verify (&updater.flash, &updater.flash, 0x20000, 0x10000,
+		active_data, sizeof (active_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 1,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE,
+		FIRMWARE_UPDATE_JOURNAL_FLAG_RECOVERY_UPDATED, sizeof (staging_data), sizeof (active_data),
+		0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_UPDATING_IMAGE));
+	status |= firmware_update_testing_flash_page_size (&updater.flash, FLASH_PAGE_SIZE);
+	status |= firmware_update_testing_flash_block_size (&updater.flash, FLASH_BLOCK_SIZE);
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x10000, sizeof (staging_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 2,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM,
+		FIRMWARE_UPDATE_JOURNAL_FLAG_RECOVERY_UPDATED, sizeof (staging_data), sizeof (active_data),
+		sizeof (staging_data));
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 3,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_HEADER,
+		FIRMWARE_UPDATE_JOURNAL_FLAG_RECOVERY_UPDATED, sizeof (staging_data), sizeof (active_data),
+		sizeof (staging_data));
+
+	status |= flash_mock_expect_copy_flash_verify (&updater.flash, &updater.flash, 0x10000, 0x30000,
+		staging_data, sizeof (staging_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 4,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_DONE,
+		FIRMWARE_UPDATE_JOURNAL_FLAG_RECOVERY_UPDATED, sizeof (staging_data), sizeof (active_data),
+		sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_REVOCATION));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x10000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_key_manifest, &updater.fw,
+		(intptr_t) &updater.manifest);
+	status |= mock_expect (&updater.manifest.mock, updater.manifest.base.revokes_old_manifest,
+		 &updater.manifest, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_RECOVERY));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 5, 0,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, updater.test.recovery_rev);
+
+	status = flash_mock_validate_and_release (&journal_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+	firmware_update_testing_validate_and_release (test, &updater);
+}
+
+static void firmware_update_test_run_update_journal_different_image (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct firmware_update_journal journal;
+	struct flash_mock journal_flash;
+	int status;
+	uint8_t entry[20];
+	uint8_t active_data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15};
+
+	TEST_START;
+
+	firmware_update_testing_journal_entry (entry, FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_HEADER, 0, 0x1234, sizeof (active_data), 0x1234);
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+	firmware_update_testing_init_journal (test, &updater, &journal, &journal_flash, entry);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw, 0,
+		MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_firmware_header, &updater.fw,
+		(intptr_t) &updater.header);
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_SAVING_STATE));
+	status |= mock_expect (&updater.app.mock, updater.app.base.save, &updater.app, 0);
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 1,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0,
+		sizeof (staging_data), 0, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_BACKUP_ACTIVE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x10000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (active_data));
+	status |= flash_mock_expect_erase_copy_verify (&updater.flash, &updater.flash, 0x20000, 0x10000,
+		active_data, sizeof (active_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 2,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE, 0,
+		sizeof (staging_data), sizeof (active_data), 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_UPDATING_IMAGE));
+	status |= firmware_update_testing_flash_page_size (&updater.flash, FLASH_PAGE_SIZE);
+	status |= firmware_update_testing_flash_block_size (&updater.flash, FLASH_BLOCK_SIZE);
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x10000, sizeof (staging_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 3,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0,
+		sizeof (staging_data), sizeof (active_data), sizeof (staging_data));
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 4,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_HEADER, 0,
+		sizeof (staging_data), sizeof (active_data), sizeof (staging_data));
+
+	status |= flash_mock_expect_copy_flash_verify (&updater.flash, &updater.flash, 0x10000, 0x30000,
+		staging_data, sizeof (staging_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 5,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_DONE, 0,
+		sizeof (staging_data), sizeof (active_data), sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_REVOCATION));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x10000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_key_manifest, &updater.fw,
+		(intptr_t) &updater.manifest);
+	status |= mock_expect (&updater.manifest.mock, updater.manifest.base.revokes_old_manifest,
+		 &updater.manifest, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_RECOVERY));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 6, 0,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&journal_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+	firmware_update_testing_validate_and_release (test, &updater);
+}
+
+static void firmware_update_test_run_update_journal_checkpoint_error (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct firmware_update_journal journal;
+	struct flash_mock journal_flash;
+	int status;
+	uint8_t entry[20];
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15};
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+	firmware_update_testing_init_journal (test, &updater, &journal, &journal_flash, NULL);
+
+	firmware_update_testing_journal_entry (entry, FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0, sizeof (staging_data), 0, 0);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw, 0,
+		MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_firmware_header, &updater.fw,
+		(intptr_t) &updater.header);
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_SAVING_STATE));
+	status |= mock_expect (&updater.app.mock, updater.app.base.save, &updater.app, 0);
+
+	status |= mock_expect (&journal_flash.mock, journal_flash.base.write, &journal_flash,
+		FLASH_NO_MEMORY, MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (entry, sizeof (entry)),
+		MOCK_ARG (sizeof (entry)));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_BACKUP_FAILED));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, FLASH_NO_MEMORY, status);
+
+	status = flash_mock_validate_and_release (&journal_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+	firmware_update_testing_validate_and_release (test, &updater);
+}
+
+static void firmware_update_test_run_update_journal_update_fail (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct firmware_update_journal journal;
+	struct flash_mock journal_flash;
+	int status;
+	uint8_t active_data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15};
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+	firmware_update_testing_init_journal (test, &updater, &journal, &journal_flash, NULL);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw, 0,
+		MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_firmware_header, &updater.fw,
+		(intptr_t) &updater.header);
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_SAVING_STATE));
+	status |= mock_expect (&updater.app.mock, updater.app.base.save, &updater.app, 0);
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 0,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0,
+		sizeof (staging_data), 0, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_BACKUP_ACTIVE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x10000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (active_data));
+	status |= flash_mock_expect_erase_copy_verify (&updater.flash, &updater.flash, 0x20000, 0x10000,
+		active_data, sizeof (active_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 1,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE, 0,
+		sizeof (staging_data), sizeof (active_data), 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_UPDATING_IMAGE));
+	status |= firmware_update_testing_flash_page_size (&updater.flash, FLASH_PAGE_SIZE);
+	status |= firmware_update_testing_flash_block_size (&updater.flash, FLASH_BLOCK_SIZE);
+	status |= firmware_update_testing_flash_block_size (&updater.flash, FLASH_BLOCK_SIZE);
+	status |= mock_expect (&updater.flash.mock, updater.flash.base.block_erase, &updater.flash,
+		FLASH_NO_MEMORY, MOCK_ARG (0x10000));
+
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x10000, sizeof (active_data));
+	status |= flash_mock_expect_copy_flash_verify (&updater.flash, &updater.flash, 0x10000, 0x20000,
+		active_data, sizeof (active_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_UPDATE_FAILED));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 2, 0,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, FLASH_NO_MEMORY, status);
+
+	CuAssertIntEquals (test, false, firmware_update_is_resume_pending (&updater.test));
+
+	status = flash_mock_validate_and_release (&journal_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+	firmware_update_testing_validate_and_release (test, &updater);
+}
+
+static void firmware_update_test_run_update_journal_done_checkpoint_error (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct firmware_update_journal journal;
+	struct flash_mock journal_flash;
+	int status;
+	uint8_t entry[20];
+	uint8_t active_data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15};
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+	firmware_update_testing_init_journal (test, &updater, &journal, &journal_flash, NULL);
+
+	firmware_update_testing_journal_entry (entry, FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_DONE, 0, sizeof (staging_data), sizeof (active_data),
+		sizeof (staging_data));
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw, 0,
+		MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_firmware_header, &updater.fw,
+		(intptr_t) &updater.header);
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_SAVING_STATE));
+	status |= mock_expect (&updater.app.mock, updater.app.base.save, &updater.app, 0);
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 0,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0,
+		sizeof (staging_data), 0, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_BACKUP_ACTIVE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x10000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (active_data));
+	status |= flash_mock_expect_erase_copy_verify (&updater.flash, &updater.flash, 0x20000, 0x10000,
+		active_data, sizeof (active_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 1,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE, 0,
+		sizeof (staging_data), sizeof (active_data), 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_UPDATING_IMAGE));
+	status |= firmware_update_testing_flash_page_size (&updater.flash, FLASH_PAGE_SIZE);
+	status |= firmware_update_testing_flash_block_size (&updater.flash, FLASH_BLOCK_SIZE);
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x10000, sizeof (staging_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 2,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0,
+		sizeof (staging_data), sizeof (active_data), sizeof (staging_data));
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 3,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_HEADER, 0,
+		sizeof (staging_data), sizeof (active_data), sizeof (staging_data));
+
+	status |= flash_mock_expect_copy_flash_verify (&updater.flash, &updater.flash, 0x10000, 0x30000,
+		staging_data, sizeof (staging_data));
+
+	status |= mock_expect (&journal_flash.mock, journal_flash.base.write, &journal_flash,
+		FLASH_NO_MEMORY, MOCK_ARG (0x10000 + (4 * sizeof (entry))),
+		MOCK_ARG_PTR_CONTAINS (entry, sizeof (entry)), MOCK_ARG (sizeof (entry)));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_REVOCATION));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x10000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_key_manifest, &updater.fw,
+		(intptr_t) &updater.manifest);
+	status |= mock_expect (&updater.manifest.mock, updater.manifest.base.revokes_old_manifest,
+		 &updater.manifest, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_RECOVERY));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 5, 0,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, firmware_update_is_resume_pending (&updater.test));
+
+	status = flash_mock_validate_and_release (&journal_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+	firmware_update_testing_validate_and_release (test, &updater);
+}
+
+static void firmware_update_test_run_update_journal_clear_write_error (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct firmware_update_journal journal;
+	struct flash_mock journal_flash;
+	int status;
+	uint8_t idle[20];
+	uint8_t active_data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15};
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+	firmware_update_testing_init_journal (test, &updater, &journal, &journal_flash, NULL);
+
+	firmware_update_testing_journal_entry (idle, 0, FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0,
+		0);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw, 0,
+		MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_firmware_header, &updater.fw,
+		(intptr_t) &updater.header);
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_SAVING_STATE));
+	status |= mock_expect (&updater.app.mock, updater.app.base.save, &updater.app, 0);
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 0,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0,
+		sizeof (staging_data), 0, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_BACKUP_ACTIVE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x10000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (active_data));
+	status |= flash_mock_expect_erase_copy_verify (&updater.flash, &updater.flash, 0x20000, 0x10000,
+		active_data, sizeof (active_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 1,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE, 0,
+		sizeof (staging_data), sizeof (active_data), 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_UPDATING_IMAGE));
+	status |= firmware_update_testing_flash_page_size (&updater.flash, FLASH_PAGE_SIZE);
+	status |= firmware_update_testing_flash_block_size (&updater.flash, FLASH_BLOCK_SIZE);
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x10000, sizeof (staging_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 2,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0,
+		sizeof (staging_data), sizeof (active_data), sizeof (staging_data));
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 3,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_HEADER, 0,
+		sizeof (staging_data), sizeof (active_data), sizeof (staging_data));
+
+	status |= flash_mock_expect_copy_flash_verify (&updater.flash, &updater.flash, 0x10000, 0x30000,
+		staging_data, sizeof (staging_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 4,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_DONE, 0,
+		sizeof (staging_data), sizeof (active_data), sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_REVOCATION));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x10000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_key_manifest, &updater.fw,
+		(intptr_t) &updater.manifest);
+	status |= mock_expect (&updater.manifest.mock, updater.manifest.base.revokes_old_manifest,
+		 &updater.manifest, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_RECOVERY));
+
+	status |= mock_expect (&journal_flash.mock, journal_flash.base.write, &journal_flash,
+		FLASH_NO_MEMORY, MOCK_ARG (0x10000 + (5 * sizeof (idle))),
+		MOCK_ARG_PTR_CONTAINS (idle, sizeof (idle)), MOCK_ARG (sizeof (idle)));
+	status |= mock_expect (&journal_flash.mock, journal_flash.base.sector_erase, &journal_flash,
+		0, MOCK_ARG (0x10000));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, firmware_update_is_resume_pending (&updater.test));
+
+	status = flash_mock_validate_and_release (&journal_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+	firmware_update_testing_validate_and_release (test, &updater);
+}
+
+static void firmware_update_test_run_update_journal_clear_error (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct firmware_update_journal journal;
+	struct flash_mock journal_flash;
+	int status;
+	uint8_t idle[20];
+	uint8_t active_data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t staging_data[] = {0x11, 0x12, 0x13, 0x14, 0x15};
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+	firmware_update_testing_init_journal (test, &updater, &journal, &journal_flash, NULL);
+
+	firmware_update_testing_journal_entry (idle, 0, FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0,
+		0);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_VERIFYING_IMAGE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x30000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw, 0,
+		MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_firmware_header, &updater.fw,
+		(intptr_t) &updater.header);
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_SAVING_STATE));
+	status |= mock_expect (&updater.app.mock, updater.app.base.save, &updater.app, 0);
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 0,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_STARTED, 0,
+		sizeof (staging_data), 0, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_BACKUP_ACTIVE));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x10000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (active_data));
+	status |= flash_mock_expect_erase_copy_verify (&updater.flash, &updater.flash, 0x20000, 0x10000,
+		active_data, sizeof (active_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 1,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_BACKUP_DONE, 0,
+		sizeof (staging_data), sizeof (active_data), 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_UPDATING_IMAGE));
+	status |= firmware_update_testing_flash_page_size (&updater.flash, FLASH_PAGE_SIZE);
+	status |= firmware_update_testing_flash_block_size (&updater.flash, FLASH_BLOCK_SIZE);
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x10000, sizeof (staging_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 2,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0,
+		sizeof (staging_data), sizeof (active_data), sizeof (staging_data));
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 3,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_HEADER, 0,
+		sizeof (staging_data), sizeof (active_data), sizeof (staging_data));
+
+	status |= flash_mock_expect_copy_flash_verify (&updater.flash, &updater.flash, 0x10000, 0x30000,
+		staging_data, sizeof (staging_data));
+
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 4,
+		FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE, FIRMWARE_UPDATE_JOURNAL_PHASE_DONE, 0,
+		sizeof (staging_data), sizeof (active_data), sizeof (staging_data));
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_REVOCATION));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x10000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_key_manifest, &updater.fw,
+		(intptr_t) &updater.manifest);
+	status |= mock_expect (&updater.manifest.mock, updater.manifest.base.revokes_old_manifest,
+		 &updater.manifest, 0);
+
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_CHECK_RECOVERY));
+
+	status |= mock_expect (&journal_flash.mock, journal_flash.base.write, &journal_flash,
+		FLASH_NO_MEMORY, MOCK_ARG (0x10000 + (5 * sizeof (idle))),
+		MOCK_ARG_PTR_CONTAINS (idle, sizeof (idle)), MOCK_ARG (sizeof (idle)));
+	status |= mock_expect (&journal_flash.mock, journal_flash.base.sector_erase, &journal_flash,
+		FLASH_SECTOR_ERASE_FAILED, MOCK_ARG (0x10000));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_run_update (&updater.test, &updater.handler.base);
+	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
+
+	CuAssertIntEquals (test, true, firmware_update_is_resume_pending (&updater.test));
+
+	status = flash_mock_validate_and_release (&journal_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+	firmware_update_testing_validate_and_release (test, &updater);
+}
+
+static void firmware_update_test_prepare_staging_journal (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct firmware_update_journal journal;
+	struct flash_mock journal_flash;
+	int status;
+	uint8_t entry[20];
+
+	TEST_START;
+
+	firmware_update_testing_journal_entry (entry, FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0, 5, 4, 5);
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+	firmware_update_testing_init_journal (test, &updater, &journal, &journal_flash, entry);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_PREP));
+	status |= firmware_update_testing_expect_checkpoint (&journal_flash, 1, 0,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0, 0);
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x30000, 5);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_prepare_staging (&updater.test, &updater.handler.base, 5);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, firmware_update_is_resume_pending (&updater.test));
+
+	status = flash_mock_validate_and_release (&journal_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+	firmware_update_testing_validate_and_release (test, &updater);
+}
+
+static void firmware_update_test_prepare_staging_journal_clear_error (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct firmware_update_journal journal;
+	struct flash_mock journal_flash;
+	int status;
+	uint8_t entry[20];
+	uint8_t idle[20];
+
+	TEST_START;
+
+	firmware_update_testing_journal_entry (entry, FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0, 5, 4, 5);
+	firmware_update_testing_journal_entry (idle, 0, FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0,
+		0);
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+	firmware_update_testing_init_journal (test, &updater, &journal, &journal_flash, entry);
+
+	status = mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_PREP));
+	status |= mock_expect (&journal_flash.mock, journal_flash.base.write, &journal_flash,
+		FLASH_NO_MEMORY, MOCK_ARG (0x10000 + sizeof (idle)),
+		MOCK_ARG_PTR_CONTAINS (idle, sizeof (idle)), MOCK_ARG (sizeof (idle)));
+	status |= mock_expect (&journal_flash.mock, journal_flash.base.sector_erase, &journal_flash,
+		FLASH_SECTOR_ERASE_FAILED, MOCK_ARG (0x10000));
+	status |= mock_expect (&updater.handler.mock, updater.handler.base.status_change,
+		&updater.handler, 0, MOCK_ARG (UPDATE_STATUS_STAGING_PREP_FAIL));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_prepare_staging (&updater.test, &updater.handler.base, 5);
+	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
+
+	CuAssertIntEquals (test, true, firmware_update_is_resume_pending (&updater.test));
+
+	status = flash_mock_validate_and_release (&journal_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+	firmware_update_testing_validate_and_release (test, &updater);
+}
+
+static void firmware_update_test_restore_active_image_journal (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct firmware_update_journal journal;
+	struct flash_mock journal_flash;
+	int status;
+	uint8_t entry[20];
+	uint8_t active_data[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	firmware_update_testing_journal_entry (entry, FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0, 5, 4, 5);
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+	firmware_update_testing_init_journal (test, &updater, &journal, &journal_flash, entry);
+
+	status = firmware_update_testing_expect_checkpoint (&journal_flash, 1, 0,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0, 0);
+
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.load, &updater.fw, 0,
+		MOCK_ARG (&updater.flash), MOCK_ARG (0x40000));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.verify, &updater.fw, 0,
+		MOCK_ARG (&updater.hash), MOCK_ARG (&updater.rsa));
+	status |= mock_expect (&updater.fw.mock, updater.fw.base.get_image_size, &updater.fw,
+		sizeof (active_data));
+
+	status |= firmware_update_testing_flash_page_size (&updater.flash, FLASH_PAGE_SIZE);
+	status |= flash_mock_expect_erase_flash_verify (&updater.flash, 0x10000, sizeof (active_data));
+	status |= flash_mock_expect_copy_flash_verify (&updater.flash, &updater.flash, 0x10000, 0x40000,
+		active_data, sizeof (active_data));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_restore_active_image (&updater.test);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, firmware_update_is_resume_pending (&updater.test));
+
+	status = flash_mock_validate_and_release (&journal_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+	firmware_update_testing_validate_and_release (test, &updater);
+}
+
+static void firmware_update_test_restore_active_image_journal_clear_error (CuTest *test)
+{
+	struct firmware_update_testing updater;
+	struct firmware_update_journal journal;
+	struct flash_mock journal_flash;
+	int status;
+	uint8_t entry[20];
+	uint8_t idle[20];
+
+	TEST_START;
+
+	firmware_update_testing_journal_entry (entry, FIRMWARE_UPDATE_JOURNAL_STEP_ACTIVE,
+		FIRMWARE_UPDATE_JOURNAL_PHASE_PROGRAM, 0, 5, 4, 5);
+	firmware_update_testing_journal_entry (idle, 0, FIRMWARE_UPDATE_JOURNAL_PHASE_IDLE, 0, 0, 0,
+		0);
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+	firmware_update_testing_init_journal (test, &updater, &journal, &journal_flash, entry);
+
+	status = mock_expect (&journal_flash.mock, journal_flash.base.write, &journal_flash,
+		FLASH_NO_MEMORY, MOCK_ARG (0x10000 + sizeof (idle)),
+		MOCK_ARG_PTR_CONTAINS (idle, sizeof (idle)), MOCK_ARG (sizeof (idle)));
+	status |= mock_expect (&journal_flash.mock, journal_flash.base.sector_erase, &journal_flash,
+		FLASH_SECTOR_ERASE_FAILED, MOCK_ARG (0x10000));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = firmware_update_restore_active_image (&updater.test);
+	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&journal_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	firmware_update_journal_release (&journal);
+	firmware_update_testing_validate_and_release (test, &updater);
+}
+
+static void firmware_update_test_is_resume_pending_no_journal (CuTest *test)
+{
+	struct firmware_update_testing updater;
+
+	TEST_START;
+
+	firmware_update_testing_init (test, &updater, 0, 0, 0);
+
+	CuAssertIntEquals (test, false, firmware_update_is_resume_pending (&updater.test));
+
+	firmware_update_testing_validate_and_release (test, &updater);
+}
+
+static void firmware_update_test_is_resume_pending_null (CuTest *test)
+{
+	TEST_START;
+
+	CuAssertIntEquals (test, false, firmware_update_is_resume_pending (NULL));
+}
+
 static void firmware_update_test_validate_recovery_image (CuTest *test)
 {
 	struct firmware_update_testing updater;
@@ -12962,6 +15091,8 @@ CuSuite* get_firmware_update_suite ()
 	SUITE_ADD_TEST (suite, firmware_update_test_set_recovery_good_null);
 	SUITE_ADD_TEST (suite, firmware_update_test_set_recovery_revision_null);
 	SUITE_ADD_TEST (suite, firmware_update_test_set_image_offset_null);
+	SUITE_ADD_TEST (suite, firmware_update_test_set_staging_hash_null);
+	SUITE_ADD_TEST (suite, firmware_update_test_set_journal_null);
 	SUITE_ADD_TEST (suite, firmware_update_test_add_observer_null);
 	SUITE_ADD_TEST (suite, firmware_update_test_remove_observer_null);
 	SUITE_ADD_TEST (suite, firmware_update_test_run_update);
@@ -13105,6 +15236,37 @@ CuSuite* get_firmware_update_suite ()
 	SUITE_ADD_TEST (suite, firmware_update_test_write_to_staging_partial_write);
 	SUITE_ADD_TEST (suite, firmware_update_test_multiple_prepare_and_write_cycles);
 	SUITE_ADD_TEST (suite, firmware_update_test_multiple_prepare_and_write_cycles_image_offset);
+	SUITE_ADD_TEST (suite, firmware_update_test_prepare_staging_staging_digest);
+	SUITE_ADD_TEST (suite, firmware_update_test_prepare_staging_staging_digest_restart);
+	SUITE_ADD_TEST (suite, firmware_update_test_prepare_staging_staging_digest_image_too_small);
+	SUITE_ADD_TEST (suite, firmware_update_test_prepare_staging_staging_digest_start_error);
+	SUITE_ADD_TEST (suite, firmware_update_test_write_to_staging_staging_digest_write_fail);
+	SUITE_ADD_TEST (suite, firmware_update_test_write_to_staging_staging_digest_verify_fail);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_staging_digest);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_staging_digest_image_offset);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_staging_digest_length_mismatch);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_staging_digest_not_supported);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_staging_digest_hash_update_error);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_staging_digest_hash_finish_error);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_staging_digest_used_once);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_journal);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_journal_checkpoint_each_block);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_journal_resume_program);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_journal_resume_header);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_journal_resume_recovery);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_journal_resume_recovery_updated);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_journal_different_image);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_journal_checkpoint_error);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_journal_update_fail);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_journal_done_checkpoint_error);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_journal_clear_write_error);
+	SUITE_ADD_TEST (suite, firmware_update_test_run_update_journal_clear_error);
+	SUITE_ADD_TEST (suite, firmware_update_test_prepare_staging_journal);
+	SUITE_ADD_TEST (suite, firmware_update_test_prepare_staging_journal_clear_error);
+	SUITE_ADD_TEST (suite, firmware_update_test_restore_active_image_journal);
+	SUITE_ADD_TEST (suite, firmware_update_test_restore_active_image_journal_clear_error);
+	SUITE_ADD_TEST (suite, firmware_update_test_is_resume_pending_no_journal);
+	SUITE_ADD_TEST (suite, firmware_update_test_is_resume_pending_null);
 	SUITE_ADD_TEST (suite, firmware_update_test_validate_recovery_image);
 	SUITE_ADD_TEST (suite, firmware_update_test_validate_recovery_image_offset);
 	SUITE_ADD_TEST (suite, firmware_update_test_validate_recovery_image_extra_verify);
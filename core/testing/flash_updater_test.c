@@ -6,6 +6,7 @@
 #include <string.h>
 #include "testing.h"
 #include "flash/flash_updater.h"
+#include "flash/flash_util.h"
 #include "mock/flash_mock.h"
 
 
@@ -1455,6 +1456,234 @@ static void flash_updater_test_write_update_data_restart_write_erase_error (CuTe
 	flash_updater_release (&updater);
 }
 
+static void flash_updater_test_write_and_verify_update_data (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_updater updater;
+	int status;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_updater_init (&updater, &flash.base, 0x10000, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data), MOCK_ARG (0x10000),
+		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	status |= flash_mock_expect_verify_flash (&flash, 0x10000, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_updater_write_and_verify_update_data (&updater, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_updater_get_bytes_written (&updater);
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	status = flash_updater_get_remaining_bytes (&updater);
+	CuAssertIntEquals (test, (int) -sizeof (data), status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_updater_release (&updater);
+}
+
+static void flash_updater_test_write_and_verify_update_data_multiple (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_updater updater;
+	int status;
+	uint8_t data1[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t data2[] = {0x05, 0x06, 0x07, 0x08, 0x09};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_updater_init (&updater, &flash.base, 0x10000, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data1), MOCK_ARG (0x10000),
+		MOCK_ARG_PTR_CONTAINS (data1, sizeof (data1)), MOCK_ARG (sizeof (data1)));
+	status |= flash_mock_expect_verify_flash (&flash, 0x10000, data1, sizeof (data1));
+	status |= mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data2),
+		MOCK_ARG (0x10004), MOCK_ARG_PTR_CONTAINS (data2, sizeof (data2)),
+		MOCK_ARG (sizeof (data2)));
+	status |= flash_mock_expect_verify_flash (&flash, 0x10004, data2, sizeof (data2));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_updater_write_and_verify_update_data (&updater, data1, sizeof (data1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_updater_write_and_verify_update_data (&updater, data2, sizeof (data2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_updater_get_bytes_written (&updater);
+	CuAssertIntEquals (test, sizeof (data1) + sizeof (data2), status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_updater_release (&updater);
+}
+
+static void flash_updater_test_write_and_verify_update_data_with_offset (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_updater updater;
+	int status;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_updater_init (&updater, &flash.base, 0x10000, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_updater_apply_update_offset (&updater, 0x30);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data), MOCK_ARG (0x10030),
+		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	status |= flash_mock_expect_verify_flash (&flash, 0x10030, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_updater_write_and_verify_update_data (&updater, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_updater_release (&updater);
+}
+
+static void flash_updater_test_write_and_verify_update_data_null (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_updater updater;
+	int status;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_updater_init (&updater, &flash.base, 0x10000, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_updater_write_and_verify_update_data (NULL, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_UPDATER_INVALID_ARGUMENT, status);
+
+	status = flash_updater_write_and_verify_update_data (&updater, NULL, sizeof (data));
+	CuAssertIntEquals (test, FLASH_UPDATER_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_updater_release (&updater);
+}
+
+static void flash_updater_test_write_and_verify_update_data_write_error (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_updater updater;
+	int status;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_updater_init (&updater, &flash.base, 0x10000, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, FLASH_WRITE_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_updater_write_and_verify_update_data (&updater, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+
+	status = flash_updater_get_bytes_written (&updater);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_updater_release (&updater);
+}
+
+static void flash_updater_test_write_and_verify_update_data_mismatch (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_updater updater;
+	int status;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t bad[] = {0x01, 0x02, 0x13, 0x04};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_updater_init (&updater, &flash.base, 0x10000, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data), MOCK_ARG (0x10000),
+		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	status |= flash_mock_expect_verify_flash (&flash, 0x10000, bad, sizeof (bad));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_updater_write_and_verify_update_data (&updater, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_UTIL_DATA_MISMATCH, status);
+
+	status = flash_updater_get_bytes_written (&updater);
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_updater_release (&updater);
+}
+
+static void flash_updater_test_write_and_verify_update_data_read_error (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_updater updater;
+	int status;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_updater_init (&updater, &flash.base, 0x10000, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data), MOCK_ARG (0x10000),
+		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_updater_write_and_verify_update_data (&updater, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_updater_release (&updater);
+}
+
 static void flash_updater_test_get_remaining_bytes_null (CuTest *test)
 {
 	struct flash_mock flash;
@@ -1757,6 +1986,13 @@ CuSuite* get_flash_updater_suite ()
 	SUITE_ADD_TEST (suite, flash_updater_test_write_update_data_restart_write_erase_all);
 	SUITE_ADD_TEST (suite, flash_updater_test_write_update_data_restart_write_with_offset);
 	SUITE_ADD_TEST (suite, flash_updater_test_write_update_data_restart_write_erase_error);
+	SUITE_ADD_TEST (suite, flash_updater_test_write_and_verify_update_data);
+	SUITE_ADD_TEST (suite, flash_updater_test_write_and_verify_update_data_multiple);
+	SUITE_ADD_TEST (suite, flash_updater_test_write_and_verify_update_data_with_offset);
+	SUITE_ADD_TEST (suite, flash_updater_test_write_and_verify_update_data_null);
+	SUITE_ADD_TEST (suite, flash_updater_test_write_and_verify_update_data_write_error);
+	SUITE_ADD_TEST (suite, flash_updater_test_write_and_verify_update_data_mismatch);
+	SUITE_ADD_TEST (suite, flash_updater_test_write_and_verify_update_data_read_error);
 	SUITE_ADD_TEST (suite, flash_updater_test_get_remaining_bytes_null);
 	SUITE_ADD_TEST (suite, flash_updater_test_get_bytes_written_null);
 	SUITE_ADD_TEST (suite, flash_updater_test_apply_update_offset_null);
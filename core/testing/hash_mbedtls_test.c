@@ -28,6 +28,7 @@ static void hash_mbedtls_test_init (CuTest *test)
 
 	CuAssertPtrNotNull (test, engine.base.calculate_sha1);
 	CuAssertPtrNotNull (test, engine.base.calculate_sha256);
+	CuAssertPtrEquals (test, NULL, engine.base.calculate_sha256_multi);
 	CuAssertPtrNotNull (test, engine.base.start_sha1);
 	CuAssertPtrNotNull (test, engine.base.start_sha256);
 	CuAssertPtrNotNull (test, engine.base.update);
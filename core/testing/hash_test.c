@@ -1083,6 +1083,184 @@ static void hash_test_start_new_hash_null (CuTest *test)
 	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
 }
 
+static void hash_test_calculate_sha256_multi (CuTest *test)
+{
+	HASH_TESTING_ENGINE engine;
+	int status;
+	char *message = "Test";
+	char *message2 = "Test2";
+	uint8_t hash[SHA256_HASH_LENGTH];
+	uint8_t hash2[SHA256_HASH_LENGTH];
+	uint8_t expected2[SHA256_HASH_LENGTH];
+	struct hash_multi_buffer buffers[2];
+	uint8_t expected[] = {
+		0x53,0x2e,0xaa,0xbd,0x95,0x74,0x88,0x0d,0xbf,0x76,0xb9,0xb8,0xcc,0x00,0x83,0x2c,
+		0x20,0xa6,0xec,0x11,0x3d,0x68,0x22,0x99,0x55,0x0d,0x7a,0x6e,0x0f,0x34,0x5e,0x25
+	};
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha256 (&engine.base, (uint8_t*) message2, strlen (message2),
+		expected2, sizeof (expected2));
+	CuAssertIntEquals (test, 0, status);
+
+	buffers[0].data = (uint8_t*) message;
+	buffers[0].length = strlen (message);
+	buffers[0].hash = hash;
+	buffers[0].hash_length = sizeof (hash);
+
+	buffers[1].data = (uint8_t*) message2;
+	buffers[1].length = strlen (message2);
+	buffers[1].hash = hash2;
+	buffers[1].hash_length = sizeof (hash2);
+
+	status = hash_calculate_sha256_multi (&engine.base, buffers, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected2, hash2, sizeof (hash2));
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&engine);
+}
+
+static void hash_test_calculate_sha256_multi_engine_support (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	uint8_t data[] = {0x01, 0x02};
+	uint8_t hash[SHA256_HASH_LENGTH];
+	uint8_t hash2[SHA256_HASH_LENGTH];
+	struct hash_multi_buffer buffers[2];
+
+	TEST_START;
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	buffers[0].data = &data[0];
+	buffers[0].length = 1;
+	buffers[0].hash = hash;
+	buffers[0].hash_length = sizeof (hash);
+
+	buffers[1].data = &data[1];
+	buffers[1].length = 1;
+	buffers[1].hash = hash2;
+	buffers[1].hash_length = sizeof (hash2);
+
+	status = mock_expect (&engine.mock, engine.base.calculate_sha256_multi, &engine, 0,
+		MOCK_ARG (buffers), MOCK_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_calculate_sha256_multi (&engine.base, buffers, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_calculate_sha256_multi_engine_support_error (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	uint8_t data[] = {0x01};
+	uint8_t hash[SHA256_HASH_LENGTH];
+	struct hash_multi_buffer buffers[1];
+
+	TEST_START;
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	buffers[0].data = data;
+	buffers[0].length = sizeof (data);
+	buffers[0].hash = hash;
+	buffers[0].hash_length = sizeof (hash);
+
+	status = mock_expect (&engine.mock, engine.base.calculate_sha256_multi, &engine,
+		HASH_ENGINE_SHA256_FAILED, MOCK_ARG (buffers), MOCK_ARG (1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_calculate_sha256_multi (&engine.base, buffers, 1);
+	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_calculate_sha256_multi_hash_error (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	uint8_t data[] = {0x01, 0x02};
+	uint8_t hash[SHA256_HASH_LENGTH];
+	uint8_t hash2[SHA256_HASH_LENGTH];
+	struct hash_multi_buffer buffers[2];
+
+	TEST_START;
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.calculate_sha256_multi = NULL;
+
+	buffers[0].data = &data[0];
+	buffers[0].length = 1;
+	buffers[0].hash = hash;
+	buffers[0].hash_length = sizeof (hash);
+
+	buffers[1].data = &data[1];
+	buffers[1].length = 1;
+	buffers[1].hash = hash2;
+	buffers[1].hash_length = sizeof (hash2);
+
+	status = mock_expect (&engine.mock, engine.base.calculate_sha256, &engine,
+		HASH_ENGINE_SHA256_FAILED, MOCK_ARG (&data[0]), MOCK_ARG (1), MOCK_ARG (hash),
+		MOCK_ARG (sizeof (hash)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_calculate_sha256_multi (&engine.base, buffers, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_calculate_sha256_multi_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE engine;
+	int status;
+	uint8_t data[] = {0x01};
+	uint8_t hash[SHA256_HASH_LENGTH];
+	struct hash_multi_buffer buffers[1];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	buffers[0].data = data;
+	buffers[0].length = sizeof (data);
+	buffers[0].hash = hash;
+	buffers[0].hash_length = sizeof (hash);
+
+	status = hash_calculate_sha256_multi (NULL, buffers, 1);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_calculate_sha256_multi (&engine.base, NULL, 1);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_calculate_sha256_multi (&engine.base, buffers, 0);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&engine);
+}
+
 
 CuSuite* get_hash_suite ()
 {
@@ -1123,6 +1301,11 @@ CuSuite* get_hash_suite ()
 	SUITE_ADD_TEST (suite, hash_test_start_new_hash_sha256);
 	SUITE_ADD_TEST (suite, hash_test_start_new_hash_unknown);
 	SUITE_ADD_TEST (suite, hash_test_start_new_hash_null);
+	SUITE_ADD_TEST (suite, hash_test_calculate_sha256_multi);
+	SUITE_ADD_TEST (suite, hash_test_calculate_sha256_multi_engine_support);
+	SUITE_ADD_TEST (suite, hash_test_calculate_sha256_multi_engine_support_error);
+	SUITE_ADD_TEST (suite, hash_test_calculate_sha256_multi_hash_error);
+	SUITE_ADD_TEST (suite, hash_test_calculate_sha256_multi_null);
 
 	return suite;
 }
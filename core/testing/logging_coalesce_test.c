@@ -0,0 +1,883 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "platform.h"
+#include "testing.h"
+#include "logging/logging_coalesce.h"
+#include "logging/logging_logging.h"
+#include "mock/logging_mock.h"
+
+
+static const char *SUITE = "logging_coalesce";
+
+
+/**
+ * Dependencies for testing coalescing logs.
+ */
+struct logging_coalesce_testing {
+	struct logging_mock log;			/**< Mock for the log storing the entries. */
+	struct logging_coalesce coalesce;	/**< The coalescing log being tested. */
+};
+
+/**
+ * Initialize a coalescing log for testing.
+ *
+ * @param test The testing framework.
+ * @param logging Testing components to initialize.
+ * @param window_ms The coalescing window.
+ */
+static void logging_coalesce_testing_init (CuTest *test, struct logging_coalesce_testing *logging,
+	uint32_t window_ms)
+{
+	int status;
+
+	status = logging_mock_init (&logging->log);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_coalesce_init (&logging->coalesce, &logging->log.base, window_ms);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release coalescing log test components and validate all mocks.
+ *
+ * @param test The testing framework.
+ * @param logging Testing components to release.
+ */
+static void logging_coalesce_testing_release (CuTest *test,
+	struct logging_coalesce_testing *logging)
+{
+	int status;
+
+	status = logging_mock_validate_and_release (&logging->log);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_coalesce_release (&logging->coalesce);
+}
+
+/**
+ * Build a debug log entry.
+ *
+ * @param entry Output for the entry.
+ * @param component The component generating the entry.
+ * @param msg_index The entry message.
+ * @param arg1 The first entry argument.
+ */
+static void logging_coalesce_testing_debug_entry (struct debug_log_entry_info *entry,
+	uint8_t component, uint8_t msg_index, uint32_t arg1)
+{
+	entry->format = DEBUG_LOG_ENTRY_FORMAT;
+	entry->severity = DEBUG_LOG_SEVERITY_ERROR;
+	entry->component = component;
+	entry->msg_index = msg_index;
+	entry->arg1 = arg1;
+	entry->arg2 = 0x1234;
+}
+
+/**
+ * Set up expectations for an entry to be added to the log.
+ *
+ * @param test The testing framework.
+ * @param logging Testing components to update.
+ * @param entry The expected entry.
+ * @param result The result of adding the entry.
+ */
+static void logging_coalesce_testing_expect_entry (CuTest *test,
+	struct logging_coalesce_testing *logging, const struct debug_log_entry_info *entry, int result)
+{
+	int status;
+
+	status = mock_expect (&logging->log.mock, logging->log.base.create_entry, &logging->log,
+		result, MOCK_ARG_PTR_CONTAINS_TMP ((uint8_t*) entry, sizeof (*entry)),
+		MOCK_ARG (sizeof (*entry)));
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Set up expectations for a log entry generated by the coalescing log.  The second argument is not
+ * checked since it can contain timing information.
+ *
+ * @param test The testing framework.
+ * @param logging Testing components to update.
+ * @param severity The expected entry severity.
+ * @param msg_index The expected entry message.
+ * @param arg1 The expected first argument.
+ */
+static void logging_coalesce_testing_expect_report (CuTest *test,
+	struct logging_coalesce_testing *logging, uint8_t severity, uint8_t msg_index, uint32_t arg1)
+{
+	struct debug_log_entry_info entry;
+	int status;
+
+	entry.format = DEBUG_LOG_ENTRY_FORMAT;
+	entry.severity = severity;
+	entry.component = DEBUG_LOG_COMPONENT_LOGGING;
+	entry.msg_index = msg_index;
+	entry.arg1 = arg1;
+
+	status = mock_expect (&logging->log.mock, logging->log.base.create_entry, &logging->log, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP ((uint8_t*) &entry, offsetof (struct debug_log_entry_info, arg2)),
+		MOCK_ARG (sizeof (entry)));
+	CuAssertIntEquals (test, 0, status);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void logging_coalesce_test_init (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+
+	TEST_START;
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	CuAssertPtrNotNull (test, logging.coalesce.base.create_entry);
+	CuAssertPtrNotNull (test, logging.coalesce.base.flush);
+	CuAssertPtrNotNull (test, logging.coalesce.base.clear);
+	CuAssertPtrNotNull (test, logging.coalesce.base.get_size);
+	CuAssertPtrNotNull (test, logging.coalesce.base.read_contents);
+	CuAssertPtrNotNull (test, logging.coalesce.base.get_max_entry_length);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_init_null (CuTest *test)
+{
+	struct logging_mock log;
+	struct logging_coalesce logging;
+	int status;
+
+	TEST_START;
+
+	status = logging_mock_init (&log);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_coalesce_init (NULL, &log.base, 1000);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_coalesce_init (&logging, NULL, 1000);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_mock_validate_and_release (&log);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void logging_coalesce_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	logging_coalesce_release (NULL);
+}
+
+static void logging_coalesce_test_create_entry (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	struct debug_log_entry_info entry;
+	int status;
+
+	TEST_START;
+
+	logging_coalesce_testing_debug_entry (&entry, DEBUG_LOG_COMPONENT_MCTP, 1, 2);
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	logging_coalesce_testing_expect_entry (test, &logging, &entry, 0);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_create_entry_not_debug_entry (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	struct debug_log_entry_info entry;
+	uint8_t raw[] = {0x01, 0x02, 0x03, 0x04};
+	int status;
+
+	TEST_START;
+
+	logging_coalesce_testing_debug_entry (&entry, DEBUG_LOG_COMPONENT_MCTP, 1, 2);
+	entry.format = DEBUG_LOG_ENTRY_FORMAT + 1;
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (raw, sizeof (raw)), MOCK_ARG (sizeof (raw)));
+	status |= mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (raw, sizeof (raw)), MOCK_ARG (sizeof (raw)));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_coalesce_testing_expect_entry (test, &logging, &entry, 0);
+	logging_coalesce_testing_expect_entry (test, &logging, &entry, 0);
+
+	/* Only debug log entries are coalesced. */
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, raw, sizeof (raw));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, raw, sizeof (raw));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_create_entry_repeated (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	struct debug_log_entry_info entry1;
+	struct debug_log_entry_info entry2;
+	int status;
+	int i;
+
+	TEST_START;
+
+	logging_coalesce_testing_debug_entry (&entry1, DEBUG_LOG_COMPONENT_MCTP, 1, 2);
+	logging_coalesce_testing_debug_entry (&entry2, DEBUG_LOG_COMPONENT_MCTP, 1, 3);
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	logging_coalesce_testing_expect_entry (test, &logging, &entry1, 0);
+
+	for (i = 0; i < 5; i++) {
+		status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry1,
+			sizeof (entry1));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = mock_validate (&logging.log.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* A different entry reports the suppressed copies. */
+	logging_coalesce_testing_expect_report (test, &logging, DEBUG_LOG_SEVERITY_INFO,
+		LOGGING_LOGGING_REPEATED_ENTRY, 4);
+	logging_coalesce_testing_expect_entry (test, &logging, &entry2, 0);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry2,
+		sizeof (entry2));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_create_entry_repeated_then_not_debug_entry (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	struct debug_log_entry_info entry;
+	uint8_t raw[] = {0x01, 0x02, 0x03, 0x04};
+	int status;
+
+	TEST_START;
+
+	logging_coalesce_testing_debug_entry (&entry, DEBUG_LOG_COMPONENT_CMD_INTERFACE, 4, 2);
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	logging_coalesce_testing_expect_entry (test, &logging, &entry, 0);
+	logging_coalesce_testing_expect_report (test, &logging, DEBUG_LOG_SEVERITY_INFO,
+		LOGGING_LOGGING_REPEATED_ENTRY, 1);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (raw, sizeof (raw)), MOCK_ARG (sizeof (raw)));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_coalesce_testing_expect_entry (test, &logging, &entry, 0);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, raw, sizeof (raw));
+	CuAssertIntEquals (test, 0, status);
+
+	/* The repeated sequence has ended, so the entry is logged again. */
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_create_entry_window_expired (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	struct debug_log_entry_info entry;
+	int status;
+
+	TEST_START;
+
+	logging_coalesce_testing_debug_entry (&entry, DEBUG_LOG_COMPONENT_MCTP, 1, 2);
+
+	logging_coalesce_testing_init (test, &logging, 10);
+
+	logging_coalesce_testing_expect_entry (test, &logging, &entry, 0);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&logging.log.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	platform_msleep (20);
+
+	logging_coalesce_testing_expect_report (test, &logging, DEBUG_LOG_SEVERITY_INFO,
+		LOGGING_LOGGING_REPEATED_ENTRY, 1);
+	logging_coalesce_testing_expect_entry (test, &logging, &entry, 0);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_create_entry_no_window (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	struct debug_log_entry_info entry;
+	int status;
+	int i;
+
+	TEST_START;
+
+	logging_coalesce_testing_debug_entry (&entry, DEBUG_LOG_COMPONENT_MCTP, 1, 2);
+
+	logging_coalesce_testing_init (test, &logging, 0);
+
+	for (i = 0; i < 3; i++) {
+		logging_coalesce_testing_expect_entry (test, &logging, &entry, 0);
+
+		status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+			sizeof (entry));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_create_entry_log_error (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	struct debug_log_entry_info entry;
+	int status;
+
+	TEST_START;
+
+	logging_coalesce_testing_debug_entry (&entry, DEBUG_LOG_COMPONENT_MCTP, 1, 2);
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	logging_coalesce_testing_expect_entry (test, &logging, &entry, LOGGING_STAGING_FULL);
+	logging_coalesce_testing_expect_entry (test, &logging, &entry, 0);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_STAGING_FULL, status);
+
+	/* The entry was not logged, so it can't be coalesced. */
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_create_entry_null (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	struct debug_log_entry_info entry;
+	int status;
+
+	TEST_START;
+
+	logging_coalesce_testing_debug_entry (&entry, DEBUG_LOG_COMPONENT_MCTP, 1, 2);
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	status = logging.coalesce.base.create_entry (NULL, (uint8_t*) &entry, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, NULL, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_create_entry_rate_limited (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	struct logging_coalesce_limit limit;
+	struct debug_log_entry_info entry;
+	struct debug_log_entry_info other;
+	int status;
+	int i;
+
+	TEST_START;
+
+	logging_coalesce_testing_debug_entry (&other, DEBUG_LOG_COMPONENT_CMD_INTERFACE, 1, 0);
+
+	limit.component = DEBUG_LOG_COMPONENT_MCTP;
+	limit.burst = 2;
+	limit.period_ms = 100000;
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	status = logging_coalesce_set_rate_limits (&logging.coalesce, &limit, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 2; i++) {
+		logging_coalesce_testing_debug_entry (&entry, DEBUG_LOG_COMPONENT_MCTP, 1, i);
+		logging_coalesce_testing_expect_entry (test, &logging, &entry, 0);
+
+		status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+			sizeof (entry));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	for (; i < 5; i++) {
+		logging_coalesce_testing_debug_entry (&entry, DEBUG_LOG_COMPONENT_MCTP, 1, i);
+
+		status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+			sizeof (entry));
+		CuAssertIntEquals (test, LOGGING_ENTRY_RATE_LIMITED, status);
+	}
+
+	CuAssertIntEquals (test, 3, limit.dropped);
+
+	/* Other components are not limited. */
+	for (i = 0; i < 3; i++) {
+		other.arg1 = i;
+		logging_coalesce_testing_expect_entry (test, &logging, &other, 0);
+
+		status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &other,
+			sizeof (other));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_create_entry_rate_limit_refill (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	struct logging_coalesce_limit limit;
+	struct debug_log_entry_info entry;
+	int status;
+
+	TEST_START;
+
+	limit.component = DEBUG_LOG_COMPONENT_MCTP;
+	limit.burst = 1;
+	limit.period_ms = 20;
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	status = logging_coalesce_set_rate_limits (&logging.coalesce, &limit, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_coalesce_testing_debug_entry (&entry, DEBUG_LOG_COMPONENT_MCTP, 1, 0);
+	logging_coalesce_testing_expect_entry (test, &logging, &entry, 0);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_coalesce_testing_debug_entry (&entry, DEBUG_LOG_COMPONENT_MCTP, 1, 1);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_ENTRY_RATE_LIMITED, status);
+
+	status = mock_validate (&logging.log.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	platform_msleep (30);
+
+	/* The dropped entries are reported before the next entry from the component. */
+	logging_coalesce_testing_debug_entry (&entry, DEBUG_LOG_COMPONENT_MCTP, 1, 2);
+
+	logging_coalesce_testing_expect_report (test, &logging, DEBUG_LOG_SEVERITY_WARNING,
+		LOGGING_LOGGING_RATE_LIMITED, DEBUG_LOG_COMPONENT_MCTP);
+	logging_coalesce_testing_expect_entry (test, &logging, &entry, 0);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, limit.dropped);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_create_entry_rate_limit_repeated (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	struct logging_coalesce_limit limit;
+	struct debug_log_entry_info entry;
+	int status;
+	int i;
+
+	TEST_START;
+
+	limit.component = DEBUG_LOG_COMPONENT_MCTP;
+	limit.burst = 1;
+	limit.period_ms = 100000;
+
+	logging_coalesce_testing_debug_entry (&entry, DEBUG_LOG_COMPONENT_MCTP, 1, 0);
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	status = logging_coalesce_set_rate_limits (&logging.coalesce, &limit, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_coalesce_testing_expect_entry (test, &logging, &entry, 0);
+
+	/* Coalesced entries don't consume tokens. */
+	for (i = 0; i < 10; i++) {
+		status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+			sizeof (entry));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	CuAssertIntEquals (test, 0, limit.dropped);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_set_rate_limits_remove (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	struct logging_coalesce_limit limit;
+	struct debug_log_entry_info entry;
+	int status;
+	int i;
+
+	TEST_START;
+
+	limit.component = DEBUG_LOG_COMPONENT_MCTP;
+	limit.burst = 1;
+	limit.period_ms = 100000;
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	status = logging_coalesce_set_rate_limits (&logging.coalesce, &limit, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_coalesce_set_rate_limits (&logging.coalesce, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 3; i++) {
+		logging_coalesce_testing_debug_entry (&entry, DEBUG_LOG_COMPONENT_MCTP, 1, i);
+		logging_coalesce_testing_expect_entry (test, &logging, &entry, 0);
+
+		status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+			sizeof (entry));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_set_rate_limits_invalid_arg (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	struct logging_coalesce_limit limit;
+	int status;
+
+	TEST_START;
+
+	limit.component = DEBUG_LOG_COMPONENT_MCTP;
+	limit.burst = 1;
+	limit.period_ms = 100;
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	status = logging_coalesce_set_rate_limits (NULL, &limit, 1);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_coalesce_set_rate_limits (&logging.coalesce, NULL, 1);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	limit.burst = 0;
+	status = logging_coalesce_set_rate_limits (&logging.coalesce, &limit, 1);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	limit.burst = 1;
+	limit.period_ms = 0;
+	status = logging_coalesce_set_rate_limits (&logging.coalesce, &limit, 1);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_flush (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.flush, &logging.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.coalesce.base.flush (&logging.coalesce.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_flush_repeated_entry (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	struct debug_log_entry_info entry;
+	int status;
+
+	TEST_START;
+
+	logging_coalesce_testing_debug_entry (&entry, DEBUG_LOG_COMPONENT_MCTP, 1, 2);
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	logging_coalesce_testing_expect_entry (test, &logging, &entry, 0);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_coalesce_testing_expect_report (test, &logging, DEBUG_LOG_SEVERITY_INFO,
+		LOGGING_LOGGING_REPEATED_ENTRY, 2);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.flush, &logging.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.coalesce.base.flush (&logging.coalesce.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&logging.log.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Copies are still suppressed after the flush. */
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_coalesce_testing_expect_report (test, &logging, DEBUG_LOG_SEVERITY_INFO,
+		LOGGING_LOGGING_REPEATED_ENTRY, 1);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.flush, &logging.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.coalesce.base.flush (&logging.coalesce.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_flush_null (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	status = logging.coalesce.base.flush (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_clear (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	struct debug_log_entry_info entry;
+	int status;
+
+	TEST_START;
+
+	logging_coalesce_testing_debug_entry (&entry, DEBUG_LOG_COMPONENT_MCTP, 1, 2);
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	logging_coalesce_testing_expect_entry (test, &logging, &entry, 0);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.clear, &logging.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.coalesce.base.clear (&logging.coalesce.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&logging.log.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Suppressed copies are discarded with the log. */
+	logging_coalesce_testing_expect_entry (test, &logging, &entry, 0);
+
+	status = logging.coalesce.base.create_entry (&logging.coalesce.base, (uint8_t*) &entry,
+		sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_clear_null (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	status = logging.coalesce.base.clear (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_get_size (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.get_size, &logging.log, 100);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.coalesce.base.get_size (&logging.coalesce.base);
+	CuAssertIntEquals (test, 100, status);
+
+	status = logging.coalesce.base.get_size (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_read_contents (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	uint8_t output[32];
+	int status;
+
+	TEST_START;
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.read_contents, &logging.log, 20,
+		MOCK_ARG (10), MOCK_ARG (output), MOCK_ARG (sizeof (output)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.coalesce.base.read_contents (&logging.coalesce.base, 10, output,
+		sizeof (output));
+	CuAssertIntEquals (test, 20, status);
+
+	status = logging.coalesce.base.read_contents (NULL, 10, output, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging.coalesce.base.read_contents (&logging.coalesce.base, 10, NULL,
+		sizeof (output));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+static void logging_coalesce_test_get_max_entry_length (CuTest *test)
+{
+	struct logging_coalesce_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_coalesce_testing_init (test, &logging, 1000);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.get_max_entry_length, &logging.log,
+		240);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.coalesce.base.get_max_entry_length (&logging.coalesce.base);
+	CuAssertIntEquals (test, 240, status);
+
+	status = logging.coalesce.base.get_max_entry_length (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_coalesce_testing_release (test, &logging);
+}
+
+
+CuSuite* get_logging_coalesce_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, logging_coalesce_test_init);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_init_null);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_release_null);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_create_entry);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_create_entry_not_debug_entry);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_create_entry_repeated);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_create_entry_repeated_then_not_debug_entry);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_create_entry_window_expired);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_create_entry_no_window);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_create_entry_log_error);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_create_entry_null);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_create_entry_rate_limited);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_create_entry_rate_limit_refill);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_create_entry_rate_limit_repeated);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_set_rate_limits_remove);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_set_rate_limits_invalid_arg);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_flush);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_flush_repeated_entry);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_flush_null);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_clear);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_clear_null);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_get_size);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_read_contents);
+	SUITE_ADD_TEST (suite, logging_coalesce_test_get_max_entry_length);
+
+	return suite;
+}
@@ -0,0 +1,1425 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "platform.h"
+#include "testing.h"
+#include "logging/logging_flash_compact.h"
+#include "logging/debug_log.h"
+#include "flash/flash_common.h"
+#include "mock/flash_mock.h"
+
+
+static const char *SUITE = "logging_flash_compact";
+
+
+/**
+ * Length of the header at the start of each sector.
+ */
+#define	SECTOR_HEADER_LEN		6
+
+/**
+ * Encoded debug entry for LOG_ENTRY_DEBUG.
+ */
+static const uint8_t LOG_ENTRY_DEBUG_ENCODED[] = {0xd1, 0x00, 0x05, 0x02, 0x12, 0x80, 0x06};
+
+/**
+ * Raw entry data that is not a debug entry.
+ */
+static const uint8_t LOG_ENTRY_RAW[] = {0x01, 0x02, 0x03, 0x04};
+
+/**
+ * Encoded raw entry for LOG_ENTRY_RAW.
+ */
+static const uint8_t LOG_ENTRY_RAW_ENCODED[] = {0xd0, 0x04, 0x01, 0x02, 0x03, 0x04};
+
+
+/**
+ * Dependencies for testing the compact flash log.
+ */
+struct logging_flash_compact_testing {
+	struct flash_mock flash;					/**< Mock for the log flash. */
+	struct logging_flash_compact logging;		/**< The log being tested. */
+};
+
+/**
+ * Get the debug entry used for testing.
+ *
+ * @param entry Output for the debug entry.
+ */
+static void logging_flash_compact_testing_debug_entry (struct debug_log_entry_info *entry)
+{
+	entry->format = DEBUG_LOG_ENTRY_FORMAT;
+	entry->severity = DEBUG_LOG_SEVERITY_ERROR;
+	entry->component = DEBUG_LOG_COMPONENT_STATE_MGR;
+	entry->msg_index = 2;
+	entry->arg1 = 0x12;
+	entry->arg2 = 0x300;
+}
+
+/**
+ * Build the header for a sector of log entries.
+ *
+ * @param sector Output for the sector contents.  The entire buffer will be set to blank except for
+ * the header.
+ * @param length Length of the sector buffer.
+ * @param entry_id The ID of the first entry in the sector.
+ *
+ * @return The length of the header.
+ */
+static size_t logging_flash_compact_testing_sector_header (uint8_t *sector, size_t length,
+	uint32_t entry_id)
+{
+	memset (sector, 0xff, length);
+
+	sector[0] = 0x3c;
+	sector[1] = 0x01;
+	memcpy (&sector[2], &entry_id, sizeof (entry_id));
+
+	return SECTOR_HEADER_LEN;
+}
+
+/**
+ * Build the expected expanded contents of a log entry.
+ *
+ * @param output Output for the expanded entry.
+ * @param entry_id The ID of the entry.
+ * @param entry The entry data.
+ * @param length Length of the entry data.
+ *
+ * @return The length of the expanded entry.
+ */
+static size_t logging_flash_compact_testing_expanded_entry (uint8_t *output, uint32_t entry_id,
+	const uint8_t *entry, size_t length)
+{
+	struct logging_entry_header header;
+
+	header.log_magic = 0xCB;
+	header.length = length + sizeof (header);
+	header.entry_id = entry_id;
+
+	memcpy (output, &header, sizeof (header));
+	memcpy (&output[sizeof (header)], entry, length);
+
+	return header.length;
+}
+
+/**
+ * Set up expectations for scanning a sector of the log during initialization.
+ *
+ * @param test The testing framework.
+ * @param flash The flash mock to update.
+ * @param sector The index of the sector being scanned.
+ * @param contents The contents of the sector or null for a blank sector.
+ */
+static void logging_flash_compact_testing_expect_scan (CuTest *test, struct flash_mock *flash,
+	int sector, const uint8_t *contents)
+{
+	uint8_t blank[SECTOR_HEADER_LEN];
+	uint32_t addr = 0x10000 + (sector * FLASH_SECTOR_SIZE);
+	int status;
+
+	memset (blank, 0xff, sizeof (blank));
+
+	status = mock_expect (&flash->mock, flash->base.read, flash, 0, MOCK_ARG (addr),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (SECTOR_HEADER_LEN));
+	status |= mock_expect_output_tmp (&flash->mock, 1, (contents) ? contents : blank,
+		SECTOR_HEADER_LEN, 2);
+
+	if (contents) {
+		status |= mock_expect (&flash->mock, flash->base.read, flash, 0,
+			MOCK_ARG (addr + SECTOR_HEADER_LEN), MOCK_ARG_NOT_NULL,
+			MOCK_ARG (FLASH_SECTOR_SIZE - SECTOR_HEADER_LEN));
+		status |= mock_expect_output_tmp (&flash->mock, 1, &contents[SECTOR_HEADER_LEN],
+			FLASH_SECTOR_SIZE - SECTOR_HEADER_LEN, 2);
+	}
+
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Initialize a compact flash log for testing.
+ *
+ * @param test The testing framework.
+ * @param logging Testing components to initialize.
+ * @param sectors Contents of each sector of the log.  Null entries are blank sectors.  If this is
+ * null, the entire log is blank.
+ */
+static void logging_flash_compact_testing_init (CuTest *test,
+	struct logging_flash_compact_testing *logging, uint8_t *sectors[LOGGING_FLASH_SECTORS])
+{
+	int status;
+	int i;
+
+	status = flash_mock_init (&logging->flash);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < LOGGING_FLASH_SECTORS; i++) {
+		logging_flash_compact_testing_expect_scan (test, &logging->flash, i,
+			(sectors) ? sectors[i] : NULL);
+	}
+
+	status = logging_flash_compact_init (&logging->logging, &logging->flash.base, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&logging->flash.mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release compact flash log test components and validate all mocks.
+ *
+ * @param test The testing framework.
+ * @param logging Testing components to release.
+ */
+static void logging_flash_compact_testing_release (CuTest *test,
+	struct logging_flash_compact_testing *logging)
+{
+	int status;
+
+	status = flash_mock_validate_and_release (&logging->flash);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_release (&logging->logging);
+}
+
+/**
+ * Set up expectations for writing encoded entries to flash.
+ *
+ * @param test The testing framework.
+ * @param flash The flash mock to update.
+ * @param addr The address being written.
+ * @param data The expected data.
+ * @param length Length of the expected data.
+ * @param erase Flag indicating if the sector should be erased first.
+ */
+static void logging_flash_compact_testing_expect_write (CuTest *test, struct flash_mock *flash,
+	uint32_t addr, const uint8_t *data, size_t length, bool erase)
+{
+	int status = 0;
+
+	if (erase) {
+		status = flash_mock_expect_erase_flash_sector (flash, addr, FLASH_SECTOR_SIZE);
+	}
+
+	status |= mock_expect (&flash->mock, flash->base.write, flash, length, MOCK_ARG (addr),
+		MOCK_ARG_PTR_CONTAINS_TMP (data, length), MOCK_ARG (length));
+
+	CuAssertIntEquals (test, 0, status);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void logging_flash_compact_test_init_empty (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	CuAssertPtrNotNull (test, logging.logging.base.create_entry);
+	CuAssertPtrNotNull (test, logging.logging.base.flush);
+	CuAssertPtrNotNull (test, logging.logging.base.clear);
+	CuAssertPtrNotNull (test, logging.logging.base.get_size);
+	CuAssertPtrNotNull (test, logging.logging.base.read_contents);
+	CuAssertPtrNotNull (test, logging.logging.base.get_max_entry_length);
+
+	status = logging.logging.base.get_size (&logging.logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_init_existing_entries (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	struct debug_log_entry_info info;
+	uint8_t sector0[FLASH_SECTOR_SIZE];
+	uint8_t *sectors[LOGGING_FLASH_SECTORS] = {sector0};
+	uint8_t expected[64];
+	uint8_t output[64];
+	size_t pos;
+	size_t expected_len;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_debug_entry (&info);
+
+	pos = logging_flash_compact_testing_sector_header (sector0, sizeof (sector0), 5);
+	memcpy (&sector0[pos], LOG_ENTRY_DEBUG_ENCODED, sizeof (LOG_ENTRY_DEBUG_ENCODED));
+	pos += sizeof (LOG_ENTRY_DEBUG_ENCODED);
+	memcpy (&sector0[pos], LOG_ENTRY_RAW_ENCODED, sizeof (LOG_ENTRY_RAW_ENCODED));
+	pos += sizeof (LOG_ENTRY_RAW_ENCODED);
+
+	expected_len = logging_flash_compact_testing_expanded_entry (expected, 5, (uint8_t*) &info,
+		sizeof (info));
+	expected_len += logging_flash_compact_testing_expanded_entry (&expected[expected_len], 6,
+		LOG_ENTRY_RAW, sizeof (LOG_ENTRY_RAW));
+
+	logging_flash_compact_testing_init (test, &logging, sectors);
+
+	status = logging.logging.base.get_size (&logging.logging.base);
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = mock_expect (&logging.flash.mock, logging.flash.base.read, &logging.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (pos));
+	status |= mock_expect_output (&logging.flash.mock, 1, sector0, pos, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.read_contents (&logging.logging.base, 0, output,
+		sizeof (output));
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = testing_validate_array (expected, output, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_init_wrapped (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	uint8_t sector0[FLASH_SECTOR_SIZE];
+	uint8_t sector14[FLASH_SECTOR_SIZE];
+	uint8_t sector15[FLASH_SECTOR_SIZE];
+	uint8_t *sectors[LOGGING_FLASH_SECTORS] = {0};
+	uint8_t expected[64];
+	uint8_t output[64];
+	size_t pos;
+	size_t expected_len;
+	int status;
+
+	TEST_START;
+
+	sectors[0] = sector0;
+	sectors[14] = sector14;
+	sectors[15] = sector15;
+
+	pos = logging_flash_compact_testing_sector_header (sector14, sizeof (sector14), 10);
+	memcpy (&sector14[pos], LOG_ENTRY_RAW_ENCODED, sizeof (LOG_ENTRY_RAW_ENCODED));
+
+	pos = logging_flash_compact_testing_sector_header (sector15, sizeof (sector15), 11);
+	memcpy (&sector15[pos], LOG_ENTRY_RAW_ENCODED, sizeof (LOG_ENTRY_RAW_ENCODED));
+
+	pos = logging_flash_compact_testing_sector_header (sector0, sizeof (sector0), 12);
+	memcpy (&sector0[pos], LOG_ENTRY_RAW_ENCODED, sizeof (LOG_ENTRY_RAW_ENCODED));
+	pos += sizeof (LOG_ENTRY_RAW_ENCODED);
+
+	expected_len = logging_flash_compact_testing_expanded_entry (expected, 10, LOG_ENTRY_RAW,
+		sizeof (LOG_ENTRY_RAW));
+	expected_len += logging_flash_compact_testing_expanded_entry (&expected[expected_len], 11,
+		LOG_ENTRY_RAW, sizeof (LOG_ENTRY_RAW));
+	expected_len += logging_flash_compact_testing_expanded_entry (&expected[expected_len], 12,
+		LOG_ENTRY_RAW, sizeof (LOG_ENTRY_RAW));
+
+	logging_flash_compact_testing_init (test, &logging, sectors);
+
+	CuAssertIntEquals (test, 14, logging.logging.log_start);
+	CuAssertIntEquals (test, 13, logging.logging.next_entry_id);
+	CuAssertIntEquals (test, 0x10000 + pos, logging.logging.next_addr);
+
+	status = mock_expect (&logging.flash.mock, logging.flash.base.read, &logging.flash, 0,
+		MOCK_ARG (0x1e000), MOCK_ARG_NOT_NULL, MOCK_ARG (pos));
+	status |= mock_expect_output (&logging.flash.mock, 1, sector14, pos, 2);
+
+	status |= mock_expect (&logging.flash.mock, logging.flash.base.read, &logging.flash, 0,
+		MOCK_ARG (0x1f000), MOCK_ARG_NOT_NULL, MOCK_ARG (pos));
+	status |= mock_expect_output (&logging.flash.mock, 1, sector15, pos, 2);
+
+	status |= mock_expect (&logging.flash.mock, logging.flash.base.read, &logging.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (pos));
+	status |= mock_expect_output (&logging.flash.mock, 1, sector0, pos, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.read_contents (&logging.logging.base, 0, output,
+		sizeof (output));
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = testing_validate_array (expected, output, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_init_corrupt_entry (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	struct debug_log_entry_info info;
+	uint8_t sector0[FLASH_SECTOR_SIZE];
+	uint8_t *sectors[LOGGING_FLASH_SECTORS] = {sector0};
+	uint8_t expected[SECTOR_HEADER_LEN + sizeof (LOG_ENTRY_DEBUG_ENCODED)];
+	size_t pos;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_debug_entry (&info);
+
+	pos = logging_flash_compact_testing_sector_header (sector0, sizeof (sector0), 3);
+	memcpy (&sector0[pos], LOG_ENTRY_RAW_ENCODED, sizeof (LOG_ENTRY_RAW_ENCODED));
+	pos += sizeof (LOG_ENTRY_RAW_ENCODED);
+
+	/* A partially written entry. */
+	sector0[pos] = 0xd1;
+	sector0[pos + 1] = 0x00;
+
+	logging_flash_compact_testing_init (test, &logging, sectors);
+
+	status = logging.logging.base.get_size (&logging.logging.base);
+	CuAssertIntEquals (test, sizeof (LOG_ENTRY_RAW) + sizeof (struct logging_entry_header),
+		status);
+
+	/* New entries must be written to the next sector. */
+	pos = logging_flash_compact_testing_sector_header (expected, sizeof (expected), 4);
+	memcpy (&expected[pos], LOG_ENTRY_DEBUG_ENCODED, sizeof (LOG_ENTRY_DEBUG_ENCODED));
+
+	status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) &info,
+		sizeof (info));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_expect_write (test, &logging.flash, 0x11000, expected,
+		sizeof (expected), true);
+
+	status = logging.logging.base.flush (&logging.logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_init_null (CuTest *test)
+{
+	struct flash_mock flash;
+	struct logging_flash_compact logging;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_compact_init (NULL, &flash.base, 0x10000);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_flash_compact_init (&logging, NULL, 0x10000);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void logging_flash_compact_test_init_not_block_aligned (CuTest *test)
+{
+	struct flash_mock flash;
+	struct logging_flash_compact logging;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_compact_init (&logging, &flash.base, 0x11000);
+	CuAssertIntEquals (test, LOGGING_STORAGE_NOT_ALIGNED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void logging_flash_compact_test_init_read_error (CuTest *test)
+{
+	struct flash_mock flash;
+	struct logging_flash_compact logging;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (SECTOR_HEADER_LEN));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_compact_init (&logging, &flash.base, 0x10000);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void logging_flash_compact_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	logging_flash_compact_release (NULL);
+}
+
+static void logging_flash_compact_test_create_entry (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	struct debug_log_entry_info info;
+	uint8_t expected[64];
+	uint8_t output[64];
+	size_t expected_len;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_debug_entry (&info);
+
+	expected_len = logging_flash_compact_testing_expanded_entry (expected, 0, (uint8_t*) &info,
+		sizeof (info));
+	expected_len += logging_flash_compact_testing_expanded_entry (&expected[expected_len], 1,
+		LOG_ENTRY_RAW, sizeof (LOG_ENTRY_RAW));
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	/* Creating entries only updates the buffer. */
+	status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) &info,
+		sizeof (info));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) LOG_ENTRY_RAW,
+		sizeof (LOG_ENTRY_RAW));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.get_size (&logging.logging.base);
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = logging.logging.base.read_contents (&logging.logging.base, 0, output,
+		sizeof (output));
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = testing_validate_array (expected, output, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_create_entry_debug_format_not_supported (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	struct debug_log_entry_info info;
+	uint8_t encoded[SECTOR_HEADER_LEN + 2 + sizeof (info)];
+	uint8_t expected[64];
+	uint8_t output[64];
+	size_t expected_len;
+	size_t pos;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_debug_entry (&info);
+	info.format = DEBUG_LOG_ENTRY_FORMAT + 1;
+
+	pos = logging_flash_compact_testing_sector_header (output, sizeof (output), 0);
+	memcpy (encoded, output, pos);
+	encoded[pos++] = 0xd0;
+	encoded[pos++] = sizeof (info);
+	memcpy (&encoded[pos], &info, sizeof (info));
+
+	expected_len = logging_flash_compact_testing_expanded_entry (expected, 0, (uint8_t*) &info,
+		sizeof (info));
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) &info,
+		sizeof (info));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.read_contents (&logging.logging.base, 0, output,
+		sizeof (output));
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = testing_validate_array (expected, output, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_expect_write (test, &logging.flash, 0x10000, encoded,
+		sizeof (encoded), true);
+
+	status = logging.logging.base.flush (&logging.logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_create_entry_large_args (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	struct debug_log_entry_info info;
+	uint8_t encoded[] = {
+		0x3c, 0x01, 0x00, 0x00, 0x00, 0x00,
+		0xd1, 0x02, 0xff, 0x7f, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x00
+	};
+	uint8_t expected[64];
+	uint8_t output[64];
+	size_t expected_len;
+	int status;
+
+	TEST_START;
+
+	info.format = DEBUG_LOG_ENTRY_FORMAT;
+	info.severity = DEBUG_LOG_SEVERITY_INFO;
+	info.component = DEBUG_LOG_COMPONENT_DEVICE_SPECIFIC;
+	info.msg_index = 0x7f;
+	info.arg1 = 0xffffffff;
+	info.arg2 = 0;
+
+	expected_len = logging_flash_compact_testing_expanded_entry (expected, 0, (uint8_t*) &info,
+		sizeof (info));
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) &info,
+		sizeof (info));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_expect_write (test, &logging.flash, 0x10000, encoded,
+		sizeof (encoded), true);
+
+	status = logging.logging.base.flush (&logging.logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&logging.flash.mock, logging.flash.base.read, &logging.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (encoded)));
+	status |= mock_expect_output (&logging.flash.mock, 1, encoded, sizeof (encoded), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.read_contents (&logging.logging.base, 0, output,
+		sizeof (output));
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = testing_validate_array (expected, output, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_create_entry_null (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	status = logging.logging.base.create_entry (NULL, (uint8_t*) LOG_ENTRY_RAW,
+		sizeof (LOG_ENTRY_RAW));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging.logging.base.create_entry (&logging.logging.base, NULL,
+		sizeof (LOG_ENTRY_RAW));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_create_entry_bad_length (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	uint8_t entry[LOGGING_FLASH_COMPACT_MAX_ENTRY_LENGTH + 1];
+	int status;
+
+	TEST_START;
+
+	memset (entry, 0x55, sizeof (entry));
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	status = logging.logging.base.create_entry (&logging.logging.base, entry, 0);
+	CuAssertIntEquals (test, LOGGING_BAD_ENTRY_LENGTH, status);
+
+	status = logging.logging.base.create_entry (&logging.logging.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_BAD_ENTRY_LENGTH, status);
+
+	status = logging.logging.base.get_size (&logging.logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_create_entry_fill_sector (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	uint8_t entry[LOGGING_FLASH_COMPACT_MAX_ENTRY_LENGTH];
+	uint8_t encoded[3 + LOGGING_FLASH_COMPACT_MAX_ENTRY_LENGTH];
+	uint8_t sector[FLASH_SECTOR_SIZE];
+	int per_sector = (FLASH_SECTOR_SIZE - SECTOR_HEADER_LEN) / sizeof (encoded);
+	size_t pos;
+	int status;
+	int i;
+
+	TEST_START;
+
+	memset (entry, 0x55, sizeof (entry));
+
+	encoded[0] = 0xd0;
+	encoded[1] = 0x80 | (sizeof (entry) & 0x7f);
+	encoded[2] = sizeof (entry) >> 7;
+	memcpy (&encoded[3], entry, sizeof (entry));
+
+	pos = logging_flash_compact_testing_sector_header (sector, sizeof (sector), 0);
+	for (i = 0; i < per_sector; i++) {
+		memcpy (&sector[pos], encoded, sizeof (encoded));
+		pos += sizeof (encoded);
+	}
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	for (i = 0; i < per_sector; i++) {
+		status = logging.logging.base.create_entry (&logging.logging.base, entry, sizeof (entry));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	/* The next entry doesn't fit, so the sector is written and the entry starts a new sector. */
+	logging_flash_compact_testing_expect_write (test, &logging.flash, 0x10000, sector, pos, true);
+
+	status = logging.logging.base.create_entry (&logging.logging.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&logging.flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.get_size (&logging.logging.base);
+	CuAssertIntEquals (test,
+		(per_sector + 1) * (sizeof (entry) + sizeof (struct logging_entry_header)), status);
+
+	pos = logging_flash_compact_testing_sector_header (sector, sizeof (sector), per_sector);
+	memcpy (&sector[pos], encoded, sizeof (encoded));
+	pos += sizeof (encoded);
+
+	logging_flash_compact_testing_expect_write (test, &logging.flash, 0x11000, sector, pos, true);
+
+	status = logging.logging.base.flush (&logging.logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_create_entry_wrap_log (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	uint8_t sector0[FLASH_SECTOR_SIZE];
+	uint8_t sector1[FLASH_SECTOR_SIZE];
+	uint8_t sector15[FLASH_SECTOR_SIZE];
+	uint8_t *sectors[LOGGING_FLASH_SECTORS] = {0};
+	uint8_t expected[SECTOR_HEADER_LEN + sizeof (LOG_ENTRY_RAW_ENCODED)];
+	size_t pos;
+	int status;
+	int i;
+
+	TEST_START;
+
+	/* Every sector holds entries, and the last sector has no space for another entry. */
+	for (i = 1; i < 15; i++) {
+		sectors[i] = sector1;
+	}
+	sectors[0] = sector0;
+	sectors[15] = sector15;
+
+	pos = logging_flash_compact_testing_sector_header (sector0, sizeof (sector0), 0);
+	memcpy (&sector0[pos], LOG_ENTRY_RAW_ENCODED, sizeof (LOG_ENTRY_RAW_ENCODED));
+
+	pos = logging_flash_compact_testing_sector_header (sector1, sizeof (sector1), 1);
+	memcpy (&sector1[pos], LOG_ENTRY_RAW_ENCODED, sizeof (LOG_ENTRY_RAW_ENCODED));
+
+	pos = logging_flash_compact_testing_sector_header (sector15, sizeof (sector15), 20);
+	memset (&sector15[pos], 0, FLASH_SECTOR_SIZE - pos);
+	for (; (pos + sizeof (LOG_ENTRY_RAW_ENCODED)) <= FLASH_SECTOR_SIZE;
+		pos += sizeof (LOG_ENTRY_RAW_ENCODED)) {
+		memcpy (&sector15[pos], LOG_ENTRY_RAW_ENCODED, sizeof (LOG_ENTRY_RAW_ENCODED));
+	}
+
+	logging_flash_compact_testing_init (test, &logging, sectors);
+
+	CuAssertIntEquals (test, 0, logging.logging.log_start);
+	CuAssertIntEquals (test, 0x10000, logging.logging.next_addr);
+
+	status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) LOG_ENTRY_RAW,
+		sizeof (LOG_ENTRY_RAW));
+	CuAssertIntEquals (test, 0, status);
+
+	pos = logging_flash_compact_testing_sector_header (expected, sizeof (expected),
+		logging.logging.buffer_id);
+	memcpy (&expected[pos], LOG_ENTRY_RAW_ENCODED, sizeof (LOG_ENTRY_RAW_ENCODED));
+
+	logging_flash_compact_testing_expect_write (test, &logging.flash, 0x10000, expected,
+		sizeof (expected), true);
+
+	status = logging.logging.base.flush (&logging.logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The oldest entries are now in the second sector. */
+	CuAssertIntEquals (test, 1, logging.logging.log_start);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_flush (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	struct debug_log_entry_info info;
+	uint8_t expected[SECTOR_HEADER_LEN + sizeof (LOG_ENTRY_DEBUG_ENCODED) +
+		sizeof (LOG_ENTRY_RAW_ENCODED)];
+	size_t pos;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_debug_entry (&info);
+
+	pos = logging_flash_compact_testing_sector_header (expected, sizeof (expected), 0);
+	memcpy (&expected[pos], LOG_ENTRY_DEBUG_ENCODED, sizeof (LOG_ENTRY_DEBUG_ENCODED));
+	pos += sizeof (LOG_ENTRY_DEBUG_ENCODED);
+	memcpy (&expected[pos], LOG_ENTRY_RAW_ENCODED, sizeof (LOG_ENTRY_RAW_ENCODED));
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) &info,
+		sizeof (info));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) LOG_ENTRY_RAW,
+		sizeof (LOG_ENTRY_RAW));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_expect_write (test, &logging.flash, 0x10000, expected,
+		sizeof (expected), true);
+
+	status = logging.logging.base.flush (&logging.logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.get_size (&logging.logging.base);
+	CuAssertIntEquals (test, sizeof (info) + sizeof (LOG_ENTRY_RAW) +
+		(sizeof (struct logging_entry_header) * 2), status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_flush_append (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	struct debug_log_entry_info info;
+	uint8_t first[SECTOR_HEADER_LEN + sizeof (LOG_ENTRY_DEBUG_ENCODED)];
+	uint8_t expected[64];
+	uint8_t output[64];
+	uint8_t sector[FLASH_SECTOR_SIZE];
+	size_t expected_len;
+	size_t pos;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_debug_entry (&info);
+
+	pos = logging_flash_compact_testing_sector_header (sector, sizeof (sector), 0);
+	memcpy (&sector[pos], LOG_ENTRY_DEBUG_ENCODED, sizeof (LOG_ENTRY_DEBUG_ENCODED));
+	memcpy (first, sector, sizeof (first));
+	pos += sizeof (LOG_ENTRY_DEBUG_ENCODED);
+	memcpy (&sector[pos], LOG_ENTRY_RAW_ENCODED, sizeof (LOG_ENTRY_RAW_ENCODED));
+	pos += sizeof (LOG_ENTRY_RAW_ENCODED);
+
+	expected_len = logging_flash_compact_testing_expanded_entry (expected, 0, (uint8_t*) &info,
+		sizeof (info));
+	expected_len += logging_flash_compact_testing_expanded_entry (&expected[expected_len], 1,
+		LOG_ENTRY_RAW, sizeof (LOG_ENTRY_RAW));
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) &info,
+		sizeof (info));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_expect_write (test, &logging.flash, 0x10000, first,
+		sizeof (first), true);
+
+	status = logging.logging.base.flush (&logging.logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&logging.flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Entries after the first flush are appended without a new header or erase. */
+	status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) LOG_ENTRY_RAW,
+		sizeof (LOG_ENTRY_RAW));
+	CuAssertIntEquals (test, 0, status);
+
+	/* Read entries from both flash and the buffer. */
+	status = mock_expect (&logging.flash.mock, logging.flash.base.read, &logging.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (first)));
+	status |= mock_expect_output (&logging.flash.mock, 1, first, sizeof (first), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.read_contents (&logging.logging.base, 0, output,
+		sizeof (output));
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = testing_validate_array (expected, output, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_expect_write (test, &logging.flash, 0x10000 + sizeof (first),
+		LOG_ENTRY_RAW_ENCODED, sizeof (LOG_ENTRY_RAW_ENCODED), false);
+
+	status = logging.logging.base.flush (&logging.logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&logging.flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&logging.flash.mock, logging.flash.base.read, &logging.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (pos));
+	status |= mock_expect_output (&logging.flash.mock, 1, sector, pos, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.read_contents (&logging.logging.base, 0, output,
+		sizeof (output));
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = testing_validate_array (expected, output, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_flush_no_entries (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	status = logging.logging.base.flush (&logging.logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_flush_write_error (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	uint8_t expected[SECTOR_HEADER_LEN + sizeof (LOG_ENTRY_RAW_ENCODED)];
+	size_t pos;
+	int status;
+
+	TEST_START;
+
+	pos = logging_flash_compact_testing_sector_header (expected, sizeof (expected), 0);
+	memcpy (&expected[pos], LOG_ENTRY_RAW_ENCODED, sizeof (LOG_ENTRY_RAW_ENCODED));
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) LOG_ENTRY_RAW,
+		sizeof (LOG_ENTRY_RAW));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_expect_erase_flash_sector (&logging.flash, 0x10000, FLASH_SECTOR_SIZE);
+	status |= mock_expect (&logging.flash.mock, logging.flash.base.write, &logging.flash,
+		FLASH_WRITE_FAILED, MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS_TMP (expected,
+		sizeof (expected)), MOCK_ARG (sizeof (expected)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.flush (&logging.logging.base);
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+
+	status = mock_validate (&logging.flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The entries are still buffered, so they will be written on the next flush. */
+	logging_flash_compact_testing_expect_write (test, &logging.flash, 0x10000, expected,
+		sizeof (expected), true);
+
+	status = logging.logging.base.flush (&logging.logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_flush_incomplete_write (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	uint8_t expected[SECTOR_HEADER_LEN + sizeof (LOG_ENTRY_RAW_ENCODED)];
+	size_t pos;
+	int status;
+
+	TEST_START;
+
+	pos = logging_flash_compact_testing_sector_header (expected, sizeof (expected), 0);
+	memcpy (&expected[pos], LOG_ENTRY_RAW_ENCODED, sizeof (LOG_ENTRY_RAW_ENCODED));
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) LOG_ENTRY_RAW,
+		sizeof (LOG_ENTRY_RAW));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_expect_erase_flash_sector (&logging.flash, 0x10000, FLASH_SECTOR_SIZE);
+	status |= mock_expect (&logging.flash.mock, logging.flash.base.write, &logging.flash, 4,
+		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS_TMP (expected, sizeof (expected)),
+		MOCK_ARG (sizeof (expected)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.flush (&logging.logging.base);
+	CuAssertIntEquals (test, LOGGING_INCOMPLETE_FLUSH, status);
+
+	status = mock_validate (&logging.flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_expect_write (test, &logging.flash, 0x10000, expected,
+		sizeof (expected), true);
+
+	status = logging.logging.base.flush (&logging.logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_flush_erase_error (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) LOG_ENTRY_RAW,
+		sizeof (LOG_ENTRY_RAW));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&logging.flash.mock, logging.flash.base.get_sector_size, &logging.flash,
+		0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&logging.flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status |= mock_expect (&logging.flash.mock, logging.flash.base.sector_erase, &logging.flash,
+		FLASH_SECTOR_ERASE_FAILED, MOCK_ARG (0x10000));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.flush (&logging.logging.base);
+	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
+
+	status = logging.logging.base.get_size (&logging.logging.base);
+	CuAssertIntEquals (test, sizeof (LOG_ENTRY_RAW) + sizeof (struct logging_entry_header),
+		status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_flush_null (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	status = logging.logging.base.flush (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_clear (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	uint8_t sector0[FLASH_SECTOR_SIZE];
+	uint8_t *sectors[LOGGING_FLASH_SECTORS] = {sector0};
+	uint8_t expected[SECTOR_HEADER_LEN + sizeof (LOG_ENTRY_RAW_ENCODED)];
+	size_t pos;
+	int status;
+
+	TEST_START;
+
+	pos = logging_flash_compact_testing_sector_header (sector0, sizeof (sector0), 7);
+	memcpy (&sector0[pos], LOG_ENTRY_RAW_ENCODED, sizeof (LOG_ENTRY_RAW_ENCODED));
+
+	logging_flash_compact_testing_init (test, &logging, sectors);
+
+	status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) LOG_ENTRY_RAW,
+		sizeof (LOG_ENTRY_RAW));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_expect_erase_flash (&logging.flash, 0x10000, LOGGING_FLASH_AREA_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.clear (&logging.logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.get_size (&logging.logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&logging.flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Entry IDs restart after the log is cleared. */
+	status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) LOG_ENTRY_RAW,
+		sizeof (LOG_ENTRY_RAW));
+	CuAssertIntEquals (test, 0, status);
+
+	pos = logging_flash_compact_testing_sector_header (expected, sizeof (expected), 0);
+	memcpy (&expected[pos], LOG_ENTRY_RAW_ENCODED, sizeof (LOG_ENTRY_RAW_ENCODED));
+
+	logging_flash_compact_testing_expect_write (test, &logging.flash, 0x10000, expected,
+		sizeof (expected), true);
+
+	status = logging.logging.base.flush (&logging.logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_clear_erase_error (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	uint32_t bytes = FLASH_BLOCK_SIZE;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) LOG_ENTRY_RAW,
+		sizeof (LOG_ENTRY_RAW));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&logging.flash.mock, logging.flash.base.get_block_size, &logging.flash,
+		0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&logging.flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status |= mock_expect (&logging.flash.mock, logging.flash.base.block_erase, &logging.flash,
+		FLASH_BLOCK_ERASE_FAILED, MOCK_ARG (0x10000));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.clear (&logging.logging.base);
+	CuAssertIntEquals (test, FLASH_BLOCK_ERASE_FAILED, status);
+
+	status = logging.logging.base.get_size (&logging.logging.base);
+	CuAssertIntEquals (test, sizeof (LOG_ENTRY_RAW) + sizeof (struct logging_entry_header),
+		status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_clear_null (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	status = logging.logging.base.clear (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_get_size_null (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	status = logging.logging.base.get_size (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_get_max_entry_length (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	status = logging.logging.base.get_max_entry_length (&logging.logging.base);
+	CuAssertIntEquals (test, LOGGING_FLASH_COMPACT_MAX_ENTRY_LENGTH, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_get_max_entry_length_null (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	status = logging.logging.base.get_max_entry_length (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_read_contents_offset (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	struct debug_log_entry_info info;
+	uint8_t sector0[FLASH_SECTOR_SIZE];
+	uint8_t *sectors[LOGGING_FLASH_SECTORS] = {sector0};
+	uint8_t expected[64];
+	uint8_t output[64];
+	size_t pos;
+	size_t expected_len;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_debug_entry (&info);
+
+	pos = logging_flash_compact_testing_sector_header (sector0, sizeof (sector0), 5);
+	memcpy (&sector0[pos], LOG_ENTRY_DEBUG_ENCODED, sizeof (LOG_ENTRY_DEBUG_ENCODED));
+	pos += sizeof (LOG_ENTRY_DEBUG_ENCODED);
+
+	expected_len = logging_flash_compact_testing_expanded_entry (expected, 5, (uint8_t*) &info,
+		sizeof (info));
+	expected_len += logging_flash_compact_testing_expanded_entry (&expected[expected_len], 6,
+		LOG_ENTRY_RAW, sizeof (LOG_ENTRY_RAW));
+
+	logging_flash_compact_testing_init (test, &logging, sectors);
+
+	status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) LOG_ENTRY_RAW,
+		sizeof (LOG_ENTRY_RAW));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&logging.flash.mock, logging.flash.base.read, &logging.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (pos));
+	status |= mock_expect_output (&logging.flash.mock, 1, sector0, pos, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	/* Read a range that spans the entry on flash and the buffered entry. */
+	status = logging.logging.base.read_contents (&logging.logging.base, 10, output, 15);
+	CuAssertIntEquals (test, 15, status);
+
+	status = testing_validate_array (&expected[10], output, 15);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Reading past the entries on flash doesn't need to access flash. */
+	status = logging.logging.base.read_contents (&logging.logging.base, 25, output,
+		sizeof (output));
+	CuAssertIntEquals (test, expected_len - 25, status);
+
+	status = testing_validate_array (&expected[25], output, expected_len - 25);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.read_contents (&logging.logging.base, expected_len, output,
+		sizeof (output));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_read_contents_multiple_blocks (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	struct debug_log_entry_info info;
+	uint8_t sector0[FLASH_SECTOR_SIZE];
+	uint8_t *sectors[LOGGING_FLASH_SECTORS] = {sector0};
+	uint8_t expected[100 * sizeof (struct debug_log_entry)];
+	uint8_t output[100 * sizeof (struct debug_log_entry)];
+	size_t pos;
+	size_t expected_len = 0;
+	size_t next_read;
+	int status;
+	int i;
+
+	TEST_START;
+
+	logging_flash_compact_testing_debug_entry (&info);
+
+	pos = logging_flash_compact_testing_sector_header (sector0, sizeof (sector0), 0);
+	for (i = 0; i < 100; i++) {
+		memcpy (&sector0[pos], LOG_ENTRY_DEBUG_ENCODED, sizeof (LOG_ENTRY_DEBUG_ENCODED));
+		pos += sizeof (LOG_ENTRY_DEBUG_ENCODED);
+
+		expected_len += logging_flash_compact_testing_expanded_entry (&expected[expected_len], i,
+			(uint8_t*) &info, sizeof (info));
+	}
+
+	logging_flash_compact_testing_init (test, &logging, sectors);
+
+	status = logging.logging.base.get_size (&logging.logging.base);
+	CuAssertIntEquals (test, expected_len, status);
+
+	/* Entries that span a block boundary are read again with the next block. */
+	status = mock_expect (&logging.flash.mock, logging.flash.base.read, &logging.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (LOGGING_FLASH_COMPACT_READ_LENGTH));
+	status |= mock_expect_output (&logging.flash.mock, 1, sector0,
+		LOGGING_FLASH_COMPACT_READ_LENGTH, 2);
+
+	next_read = SECTOR_HEADER_LEN +
+		(((LOGGING_FLASH_COMPACT_READ_LENGTH - SECTOR_HEADER_LEN) /
+			sizeof (LOG_ENTRY_DEBUG_ENCODED)) * sizeof (LOG_ENTRY_DEBUG_ENCODED));
+
+	status |= mock_expect (&logging.flash.mock, logging.flash.base.read, &logging.flash, 0,
+		MOCK_ARG (0x10000 + next_read), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (LOGGING_FLASH_COMPACT_READ_LENGTH));
+	status |= mock_expect_output (&logging.flash.mock, 1, &sector0[next_read],
+		LOGGING_FLASH_COMPACT_READ_LENGTH, 2);
+
+	next_read += (LOGGING_FLASH_COMPACT_READ_LENGTH / sizeof (LOG_ENTRY_DEBUG_ENCODED)) *
+		sizeof (LOG_ENTRY_DEBUG_ENCODED);
+
+	status |= mock_expect (&logging.flash.mock, logging.flash.base.read, &logging.flash, 0,
+		MOCK_ARG (0x10000 + next_read), MOCK_ARG_NOT_NULL, MOCK_ARG (pos - next_read));
+	status |= mock_expect_output (&logging.flash.mock, 1, &sector0[next_read], pos - next_read,
+		2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.read_contents (&logging.logging.base, 0, output,
+		sizeof (output));
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = testing_validate_array (expected, output, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_read_contents_read_error (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	uint8_t sector0[FLASH_SECTOR_SIZE];
+	uint8_t *sectors[LOGGING_FLASH_SECTORS] = {sector0};
+	uint8_t output[64];
+	size_t pos;
+	int status;
+
+	TEST_START;
+
+	pos = logging_flash_compact_testing_sector_header (sector0, sizeof (sector0), 0);
+	memcpy (&sector0[pos], LOG_ENTRY_RAW_ENCODED, sizeof (LOG_ENTRY_RAW_ENCODED));
+	pos += sizeof (LOG_ENTRY_RAW_ENCODED);
+
+	logging_flash_compact_testing_init (test, &logging, sectors);
+
+	status = mock_expect (&logging.flash.mock, logging.flash.base.read, &logging.flash,
+		FLASH_READ_FAILED, MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (pos));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.logging.base.read_contents (&logging.logging.base, 0, output,
+		sizeof (output));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_read_contents_null (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	uint8_t output[64];
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	status = logging.logging.base.read_contents (NULL, 0, output, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging.logging.base.read_contents (&logging.logging.base, 0, NULL,
+		sizeof (output));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+static void logging_flash_compact_test_debug_entry_density (CuTest *test)
+{
+	struct logging_flash_compact_testing logging;
+	struct debug_log_entry_info info;
+	int entries = 0;
+	int status;
+
+	TEST_START;
+
+	logging_flash_compact_testing_debug_entry (&info);
+
+	logging_flash_compact_testing_init (test, &logging, NULL);
+
+	/* Count the debug entries that fit in a single sector before a flush is required. */
+	while (logging.logging.write_remain >= (int) sizeof (LOG_ENTRY_DEBUG_ENCODED)) {
+		status = logging.logging.base.create_entry (&logging.logging.base, (uint8_t*) &info,
+			sizeof (info));
+		CuAssertIntEquals (test, 0, status);
+
+		entries++;
+	}
+
+	CuAssertTrue (test,
+		entries >= (int) ((FLASH_SECTOR_SIZE / sizeof (struct debug_log_entry)) * 2));
+
+	logging_flash_compact_testing_release (test, &logging);
+}
+
+
+CuSuite* get_logging_flash_compact_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_init_empty);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_init_existing_entries);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_init_wrapped);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_init_corrupt_entry);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_init_null);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_init_not_block_aligned);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_init_read_error);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_release_null);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_create_entry);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_create_entry_debug_format_not_supported);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_create_entry_large_args);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_create_entry_null);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_create_entry_bad_length);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_create_entry_fill_sector);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_create_entry_wrap_log);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_flush);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_flush_append);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_flush_no_entries);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_flush_write_error);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_flush_incomplete_write);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_flush_erase_error);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_flush_null);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_clear);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_clear_erase_error);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_clear_null);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_get_size_null);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_get_max_entry_length);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_get_max_entry_length_null);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_read_contents_offset);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_read_contents_multiple_blocks);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_read_contents_read_error);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_read_contents_null);
+	SUITE_ADD_TEST (suite, logging_flash_compact_test_debug_entry_density);
+
+	return suite;
+}
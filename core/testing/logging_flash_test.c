@@ -65,10 +65,17 @@ static void logging_flash_test_init_empty (CuTest *test)
 	CuAssertPtrNotNull (test, logging.base.clear);
 	CuAssertPtrNotNull (test, logging.base.get_size);
 	CuAssertPtrNotNull (test, logging.base.read_contents);
+	CuAssertPtrNotNull (test, logging.base.get_max_entry_length);
 
 	status = logging.base.get_size (&logging.base);
 	CuAssertIntEquals (test, 0, status);
 
+	status = logging.base.get_max_entry_length (&logging.base);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE - sizeof (struct logging_entry_header), status);
+
+	status = logging.base.get_max_entry_length (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
 	/* Make sure the lock has been released. */
 	logging.base.get_size (&logging.base);
 
@@ -13692,6 +13699,90 @@ static void logging_flash_test_read_contents_offset_read_in_second_sector (CuTes
 	spi_flash_release (&flash);
 }
 
+static void logging_flash_test_read_contents_offset_read_after_overwrite (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash flash;
+	struct logging_flash logging;
+	int status;
+	uint8_t log_full[LOGGING_FLASH_SECTORS][FLASH_SECTOR_SIZE];
+	const int entry_size = 16 - sizeof (struct logging_entry_header);
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = FLASH_SECTOR_SIZE / entry_len;
+	const int entry_full = entry_len * entry_count;
+	const int offset = (entry_full * 10) + (entry_len * 2);
+	struct logging_entry_header *entry;
+	int i;
+	int j;
+	uint8_t output[entry_len * 4];
+
+	TEST_START;
+
+	memset (log_full, 0xff, sizeof (log_full));
+
+	for (j = 0; j < 8; ++j) {
+		for (i = 0; i < entry_count; ++i) {
+			entry = (struct logging_entry_header*) &log_full[j][i * entry_len];
+			entry->log_magic = 0xCB;
+			entry->length = entry_len;
+			entry->entry_id = (LOGGING_FLASH_SECTORS * entry_count) + i +
+				(j * entry_count);
+		}
+	}
+
+	for (j = 8; j < LOGGING_FLASH_SECTORS; ++j) {
+		for (i = 0; i < entry_count; ++i) {
+			entry = (struct logging_entry_header*) &log_full[j][i * entry_len];
+			entry->log_magic = 0xCB;
+			entry->length = entry_len;
+			entry->entry_id = i + (j * entry_count);
+		}
+	}
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_full[i], FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init (&logging, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The eleventh sector in the log is the third sector on flash.  Only that sector is read. */
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &log_full[2][entry_len * 2],
+		sizeof (output), FLASH_EXP_READ_CMD (0x03, 0x12000 + (entry_len * 2), 0, -1,
+		sizeof (output)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, offset, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (output), status);
+
+	status = testing_validate_array (&log_full[2][entry_len * 2], output, sizeof (output));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
 static void logging_flash_test_read_contents_offset_read_buffered_entries (CuTest *test)
 {
 	struct flash_master_mock flash_mock;
@@ -18652,6 +18743,7 @@ CuSuite* get_logging_flash_suite ()
 	SUITE_ADD_TEST (suite, logging_flash_test_read_contents_partial_read_buffered_entries);
 	SUITE_ADD_TEST (suite, logging_flash_test_read_contents_offset_read_in_first_sector);
 	SUITE_ADD_TEST (suite, logging_flash_test_read_contents_offset_read_in_second_sector);
+	SUITE_ADD_TEST (suite, logging_flash_test_read_contents_offset_read_after_overwrite);
 	SUITE_ADD_TEST (suite, logging_flash_test_read_contents_offset_read_buffered_entries);
 	SUITE_ADD_TEST (suite, logging_flash_test_read_contents_partial_read_with_offset);
 	SUITE_ADD_TEST (suite, logging_flash_test_read_contents_offset_past_end);
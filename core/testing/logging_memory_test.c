@@ -32,6 +32,7 @@ static void logging_memory_test_init (CuTest *test)
 	CuAssertPtrNotNull (test, logging.base.clear);
 	CuAssertPtrNotNull (test, logging.base.get_size);
 	CuAssertPtrNotNull (test, logging.base.read_contents);
+	CuAssertPtrNotNull (test, logging.base.get_max_entry_length);
 
 	status = logging.base.get_size (&logging.base);
 	CuAssertIntEquals (test, 0, status);
@@ -85,6 +86,38 @@ static void logging_memory_test_get_size_null (CuTest *test)
 	logging_memory_release (&logging);
 }
 
+static void logging_memory_test_get_max_entry_length (CuTest *test)
+{
+	struct logging_memory logging;
+	int status;
+
+	TEST_START;
+
+	status = logging_memory_init (&logging, 32, 11);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_max_entry_length (&logging.base);
+	CuAssertIntEquals (test, 11, status);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_get_max_entry_length_null (CuTest *test)
+{
+	struct logging_memory logging;
+	int status;
+
+	TEST_START;
+
+	status = logging_memory_init (&logging, 32, 11);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_max_entry_length (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_memory_release (&logging);
+}
+
 static void logging_memory_test_create_entry (CuTest *test)
 {
 	struct logging_memory logging;
@@ -1166,6 +1199,8 @@ CuSuite* get_logging_memory_suite ()
 	SUITE_ADD_TEST (suite, logging_memory_test_init_null);
 	SUITE_ADD_TEST (suite, logging_memory_test_release_null);
 	SUITE_ADD_TEST (suite, logging_memory_test_get_size_null);
+	SUITE_ADD_TEST (suite, logging_memory_test_get_max_entry_length);
+	SUITE_ADD_TEST (suite, logging_memory_test_get_max_entry_length_null);
 	SUITE_ADD_TEST (suite, logging_memory_test_create_entry);
 	SUITE_ADD_TEST (suite, logging_memory_test_create_entry_multiple);
 	SUITE_ADD_TEST (suite, logging_memory_test_create_entry_full_log);
@@ -0,0 +1,769 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "platform.h"
+#include "testing.h"
+#include "logging/logging_ring.h"
+
+
+static const char *SUITE = "logging_ring";
+
+
+/**
+ * Add an entry to the log and build the expected log contents for the entry.
+ *
+ * @param test The testing framework.
+ * @param logging The log to update.
+ * @param length Length of the entry data.
+ * @param fill Value to use for the entry data.
+ * @param entry_id The expected ID for the entry.
+ * @param expected Output for the expected entry contents.
+ *
+ * @return The length of the expected entry contents.
+ */
+static size_t logging_ring_testing_add_entry (CuTest *test, struct logging_ring *logging,
+	size_t length, uint8_t fill, uint32_t entry_id, uint8_t *expected)
+{
+	struct logging_entry_header header;
+	uint8_t entry[256];
+	int status;
+
+	memset (entry, fill, length);
+
+	header.log_magic = 0xCB;
+	header.length = length + sizeof (header);
+	header.entry_id = entry_id;
+
+	if (expected) {
+		memcpy (expected, &header, sizeof (header));
+		memcpy (&expected[sizeof (header)], entry, length);
+	}
+
+	status = logging->base.create_entry (&logging->base, entry, length);
+	CuAssertIntEquals (test, 0, status);
+
+	return header.length;
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void logging_ring_test_init (CuTest *test)
+{
+	struct logging_ring logging;
+	int status;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, logging.base.create_entry);
+	CuAssertPtrNotNull (test, logging.base.flush);
+	CuAssertPtrNotNull (test, logging.base.clear);
+	CuAssertPtrNotNull (test, logging.base.get_size);
+	CuAssertPtrNotNull (test, logging.base.read_contents);
+	CuAssertPtrNotNull (test, logging.base.get_max_entry_length);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_init_null (CuTest *test)
+{
+	struct logging_ring logging;
+	int status;
+
+	TEST_START;
+
+	status = logging_ring_init (NULL, 64);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_ring_init (&logging, 0);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_ring_init (&logging, sizeof (struct logging_entry_header));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+}
+
+static void logging_ring_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	logging_ring_release (NULL);
+}
+
+static void logging_ring_test_create_entry (CuTest *test)
+{
+	struct logging_ring logging;
+	uint8_t expected[64];
+	uint8_t output[64];
+	size_t expected_len;
+	int status;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	expected_len = logging_ring_testing_add_entry (test, &logging, 10, 0x11, 0, expected);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = testing_validate_array (expected, output, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_create_entry_variable_length (CuTest *test)
+{
+	struct logging_ring logging;
+	uint8_t expected[64];
+	uint8_t output[64];
+	size_t expected_len;
+	int status;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	expected_len = logging_ring_testing_add_entry (test, &logging, 1, 0x11, 0, expected);
+	expected_len += logging_ring_testing_add_entry (test, &logging, 20, 0x22, 1,
+		&expected[expected_len]);
+	expected_len += logging_ring_testing_add_entry (test, &logging, 5, 0x33, 2,
+		&expected[expected_len]);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = testing_validate_array (expected, output, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_create_entry_full_buffer (CuTest *test)
+{
+	struct logging_ring logging;
+	uint8_t expected[64];
+	uint8_t output[64];
+	size_t expected_len;
+	int status;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	expected_len = logging_ring_testing_add_entry (test, &logging,
+		64 - sizeof (struct logging_entry_header), 0x11, 0, expected);
+	CuAssertIntEquals (test, 64, expected_len);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = testing_validate_array (expected, output, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The next entry replaces the only entry in the log. */
+	expected_len = logging_ring_testing_add_entry (test, &logging, 4, 0x22, 1, expected);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = testing_validate_array (expected, output, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_create_entry_log_wrap (CuTest *test)
+{
+	struct logging_ring logging;
+	uint8_t entries[4][32];
+	uint8_t expected[64];
+	uint8_t output[64];
+	size_t entry_len;
+	size_t expected_len;
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 4; i++) {
+		entry_len = logging_ring_testing_add_entry (test, &logging, 10, i, i, entries[i]);
+	}
+
+	/* The first entry was discarded to make room for the last entry at the start of the buffer. */
+	memcpy (expected, entries[1], entry_len);
+	memcpy (&expected[entry_len], entries[2], entry_len);
+	memcpy (&expected[entry_len * 2], entries[3], entry_len);
+	expected_len = entry_len * 3;
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = testing_validate_array (expected, output, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_create_entry_log_wrap_discard_multiple (CuTest *test)
+{
+	struct logging_ring logging;
+	uint8_t entries[5][64];
+	uint8_t expected[64];
+	uint8_t output[64];
+	size_t expected_len;
+	int status;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_ring_testing_add_entry (test, &logging, 10, 0, 0, entries[0]);
+	logging_ring_testing_add_entry (test, &logging, 10, 1, 1, entries[1]);
+	logging_ring_testing_add_entry (test, &logging, 10, 2, 2, entries[2]);
+
+	/* A larger entry requires discarding more than one entry. */
+	expected_len = logging_ring_testing_add_entry (test, &logging, 25, 3, 3, entries[3]);
+
+	memcpy (expected, entries[2], 17);
+	memcpy (&expected[17], entries[3], expected_len);
+	expected_len += 17;
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = testing_validate_array (expected, output, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Discarding the last entry at the end of the buffer stops the data from wrapping. */
+	logging_ring_testing_add_entry (test, &logging, 20, 4, 4, entries[4]);
+
+	memcpy (expected, entries[3], 32);
+	memcpy (&expected[32], entries[4], 27);
+	expected_len = 59;
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = testing_validate_array (expected, output, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_create_entry_log_wrap_many (CuTest *test)
+{
+	struct logging_ring logging;
+	struct logging_entry_header header;
+	uint8_t output[256];
+	size_t length;
+	size_t pos;
+	uint32_t entry_id;
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 200; i++) {
+		logging_ring_testing_add_entry (test, &logging, (i % 30) + 1, i, i, NULL);
+	}
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, logging.base.get_size (&logging.base), status);
+
+	/* The log must contain a sequence of complete entries ending with the last entry. */
+	length = status;
+	pos = 0;
+	entry_id = 0;
+	while (pos < length) {
+		memcpy (&header, &output[pos], sizeof (header));
+		CuAssertIntEquals (test, 0xCB, header.log_magic);
+		CuAssertTrue (test, (pos + header.length) <= length);
+
+		if (pos != 0) {
+			CuAssertIntEquals (test, entry_id + 1, header.entry_id);
+		}
+
+		entry_id = header.entry_id;
+		pos += header.length;
+	}
+
+	CuAssertIntEquals (test, length, pos);
+	CuAssertIntEquals (test, 199, entry_id);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_create_entry_bad_length (CuTest *test)
+{
+	struct logging_ring logging;
+	uint8_t entry[64];
+	int status;
+
+	TEST_START;
+
+	memset (entry, 0x55, sizeof (entry));
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.create_entry (&logging.base, entry, 0);
+	CuAssertIntEquals (test, LOGGING_BAD_ENTRY_LENGTH, status);
+
+	status = logging.base.create_entry (&logging.base, entry,
+		64 - sizeof (struct logging_entry_header) + 1);
+	CuAssertIntEquals (test, LOGGING_BAD_ENTRY_LENGTH, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_create_entry_null (CuTest *test)
+{
+	struct logging_ring logging;
+	uint8_t entry[10];
+	int status;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.create_entry (NULL, entry, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging.base.create_entry (&logging.base, NULL, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_flush (CuTest *test)
+{
+	struct logging_ring logging;
+	int status;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_clear (CuTest *test)
+{
+	struct logging_ring logging;
+	uint8_t expected[64];
+	uint8_t output[64];
+	size_t expected_len;
+	int status;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_ring_testing_add_entry (test, &logging, 10, 0x11, 0, NULL);
+	logging_ring_testing_add_entry (test, &logging, 10, 0x22, 1, NULL);
+
+	status = logging.base.clear (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, 0, status);
+
+	/* Entry IDs restart after the log is cleared. */
+	expected_len = logging_ring_testing_add_entry (test, &logging, 10, 0x33, 0, expected);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, expected_len, status);
+
+	status = testing_validate_array (expected, output, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_clear_null (CuTest *test)
+{
+	struct logging_ring logging;
+	int status;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.clear (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_get_size_null (CuTest *test)
+{
+	struct logging_ring logging;
+	int status;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_get_max_entry_length (CuTest *test)
+{
+	struct logging_ring logging;
+	int status;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_max_entry_length (&logging.base);
+	CuAssertIntEquals (test, 64 - sizeof (struct logging_entry_header), status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_get_max_entry_length_large_log (CuTest *test)
+{
+	struct logging_ring logging;
+	int status;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, UINT16_MAX + 100);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_max_entry_length (&logging.base);
+	CuAssertIntEquals (test, UINT16_MAX - sizeof (struct logging_entry_header), status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_get_max_entry_length_null (CuTest *test)
+{
+	struct logging_ring logging;
+	int status;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_max_entry_length (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_read_contents_offset (CuTest *test)
+{
+	struct logging_ring logging;
+	uint8_t entries[4][32];
+	uint8_t expected[64];
+	uint8_t output[64];
+	size_t entry_len;
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 4; i++) {
+		entry_len = logging_ring_testing_add_entry (test, &logging, 10, i, i, entries[i]);
+	}
+
+	memcpy (expected, entries[1], entry_len);
+	memcpy (&expected[entry_len], entries[2], entry_len);
+	memcpy (&expected[entry_len * 2], entries[3], entry_len);
+
+	/* Read data that spans the end of the buffer. */
+	status = logging.base.read_contents (&logging.base, 20, output, 20);
+	CuAssertIntEquals (test, 20, status);
+
+	status = testing_validate_array (&expected[20], output, 20);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Read data only from the start of the buffer. */
+	status = logging.base.read_contents (&logging.base, 40, output, sizeof (output));
+	CuAssertIntEquals (test, (entry_len * 3) - 40, status);
+
+	status = testing_validate_array (&expected[40], output, (entry_len * 3) - 40);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, entry_len * 3, output, sizeof (output));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_read_contents_null (CuTest *test)
+{
+	struct logging_ring logging;
+	uint8_t output[64];
+	int status;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (NULL, 0, output, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging.base.read_contents (&logging.base, 0, NULL, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_get_spans (CuTest *test)
+{
+	struct logging_ring logging;
+	struct logging_ring_span spans[LOGGING_RING_MAX_SPANS];
+	uint8_t expected[64];
+	size_t expected_len;
+	uint32_t generation;
+	int status;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_ring_get_spans (&logging, 0, spans, &generation);
+	CuAssertIntEquals (test, 0, status);
+
+	expected_len = logging_ring_testing_add_entry (test, &logging, 10, 0x11, 0, expected);
+	expected_len += logging_ring_testing_add_entry (test, &logging, 20, 0x22, 1,
+		&expected[expected_len]);
+
+	status = logging_ring_get_spans (&logging, 0, spans, &generation);
+	CuAssertIntEquals (test, 1, status);
+	CuAssertIntEquals (test, expected_len, spans[0].length);
+
+	status = testing_validate_array (expected, spans[0].data, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Adding entries without discarding any data doesn't invalidate the spans. */
+	logging_ring_testing_add_entry (test, &logging, 5, 0x33, 2, NULL);
+
+	CuAssertIntEquals (test, true, logging_ring_is_generation_current (&logging, generation));
+
+	status = testing_validate_array (expected, spans[0].data, expected_len);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_get_spans_log_wrap (CuTest *test)
+{
+	struct logging_ring logging;
+	struct logging_ring_span spans[LOGGING_RING_MAX_SPANS];
+	uint8_t entries[4][32];
+	uint32_t generation;
+	size_t entry_len;
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 4; i++) {
+		entry_len = logging_ring_testing_add_entry (test, &logging, 10, i, i, entries[i]);
+	}
+
+	status = logging_ring_get_spans (&logging, 0, spans, &generation);
+	CuAssertIntEquals (test, 2, status);
+
+	CuAssertIntEquals (test, entry_len * 2, spans[0].length);
+	status = testing_validate_array (entries[1], spans[0].data, entry_len);
+	status |= testing_validate_array (entries[2], spans[0].data + entry_len, entry_len);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, entry_len, spans[1].length);
+	status = testing_validate_array (entries[3], spans[1].data, entry_len);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Get spans starting in the middle of the log. */
+	status = logging_ring_get_spans (&logging, entry_len + 3, spans, &generation);
+	CuAssertIntEquals (test, 2, status);
+
+	CuAssertIntEquals (test, entry_len - 3, spans[0].length);
+	status = testing_validate_array (&entries[2][3], spans[0].data, entry_len - 3);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, entry_len, spans[1].length);
+
+	status = logging_ring_get_spans (&logging, (entry_len * 2) + 3, spans, &generation);
+	CuAssertIntEquals (test, 1, status);
+
+	CuAssertIntEquals (test, entry_len - 3, spans[0].length);
+	status = testing_validate_array (&entries[3][3], spans[0].data, entry_len - 3);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_ring_get_spans (&logging, entry_len * 3, spans, &generation);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_get_spans_discarded (CuTest *test)
+{
+	struct logging_ring logging;
+	struct logging_ring_span spans[LOGGING_RING_MAX_SPANS];
+	uint32_t generation;
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 3; i++) {
+		logging_ring_testing_add_entry (test, &logging, 10, i, i, NULL);
+	}
+
+	status = logging_ring_get_spans (&logging, 0, spans, &generation);
+	CuAssertIntEquals (test, 1, status);
+
+	CuAssertIntEquals (test, true, logging_ring_is_generation_current (&logging, generation));
+
+	/* Discarding an entry invalidates the spans. */
+	logging_ring_testing_add_entry (test, &logging, 10, 3, 3, NULL);
+
+	CuAssertIntEquals (test, false, logging_ring_is_generation_current (&logging, generation));
+
+	status = logging_ring_get_spans (&logging, 0, spans, &generation);
+	CuAssertIntEquals (test, 2, status);
+
+	CuAssertIntEquals (test, true, logging_ring_is_generation_current (&logging, generation));
+
+	/* Clearing the log also invalidates the spans. */
+	status = logging.base.clear (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, logging_ring_is_generation_current (&logging, generation));
+
+	logging_ring_release (&logging);
+}
+
+static void logging_ring_test_get_spans_null (CuTest *test)
+{
+	struct logging_ring logging;
+	struct logging_ring_span spans[LOGGING_RING_MAX_SPANS];
+	uint32_t generation;
+	int status;
+
+	TEST_START;
+
+	status = logging_ring_init (&logging, 64);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_ring_get_spans (NULL, 0, spans, &generation);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_ring_get_spans (&logging, 0, NULL, &generation);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_ring_get_spans (&logging, 0, spans, NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	CuAssertIntEquals (test, false, logging_ring_is_generation_current (NULL, 0));
+
+	logging_ring_release (&logging);
+}
+
+
+CuSuite* get_logging_ring_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, logging_ring_test_init);
+	SUITE_ADD_TEST (suite, logging_ring_test_init_null);
+	SUITE_ADD_TEST (suite, logging_ring_test_release_null);
+	SUITE_ADD_TEST (suite, logging_ring_test_create_entry);
+	SUITE_ADD_TEST (suite, logging_ring_test_create_entry_variable_length);
+	SUITE_ADD_TEST (suite, logging_ring_test_create_entry_full_buffer);
+	SUITE_ADD_TEST (suite, logging_ring_test_create_entry_log_wrap);
+	SUITE_ADD_TEST (suite, logging_ring_test_create_entry_log_wrap_discard_multiple);
+	SUITE_ADD_TEST (suite, logging_ring_test_create_entry_log_wrap_many);
+	SUITE_ADD_TEST (suite, logging_ring_test_create_entry_bad_length);
+	SUITE_ADD_TEST (suite, logging_ring_test_create_entry_null);
+	SUITE_ADD_TEST (suite, logging_ring_test_flush);
+	SUITE_ADD_TEST (suite, logging_ring_test_clear);
+	SUITE_ADD_TEST (suite, logging_ring_test_clear_null);
+	SUITE_ADD_TEST (suite, logging_ring_test_get_size_null);
+	SUITE_ADD_TEST (suite, logging_ring_test_get_max_entry_length);
+	SUITE_ADD_TEST (suite, logging_ring_test_get_max_entry_length_large_log);
+	SUITE_ADD_TEST (suite, logging_ring_test_get_max_entry_length_null);
+	SUITE_ADD_TEST (suite, logging_ring_test_read_contents_offset);
+	SUITE_ADD_TEST (suite, logging_ring_test_read_contents_null);
+	SUITE_ADD_TEST (suite, logging_ring_test_get_spans);
+	SUITE_ADD_TEST (suite, logging_ring_test_get_spans_log_wrap);
+	SUITE_ADD_TEST (suite, logging_ring_test_get_spans_discarded);
+	SUITE_ADD_TEST (suite, logging_ring_test_get_spans_null);
+
+	return suite;
+}
@@ -0,0 +1,1059 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "platform.h"
+#include "testing.h"
+#include "logging/logging_staged.h"
+#include "logging/logging_memory.h"
+#include "mock/logging_mock.h"
+
+
+static const char *SUITE = "logging_staged";
+
+
+/**
+ * Dependencies for testing staged logs.
+ */
+struct logging_staged_testing {
+	struct logging_mock log;			/**< Mock for the log storing staged entries. */
+	struct logging_staged staged;		/**< The staged log being tested. */
+};
+
+/**
+ * Initialize a staged log for testing.
+ *
+ * @param test The testing framework.
+ * @param logging Testing components to initialize.
+ * @param entry_count The number of entries that can be staged.
+ */
+static void logging_staged_testing_init (CuTest *test, struct logging_staged_testing *logging,
+	size_t entry_count)
+{
+	int status;
+
+	status = logging_mock_init (&logging->log);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&logging->log.mock, logging->log.base.get_max_entry_length, &logging->log,
+		240);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_staged_init (&logging->staged, &logging->log.base, entry_count, 11);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&logging->log.mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release staged log test components and validate all mocks.
+ *
+ * @param test The testing framework.
+ * @param logging Testing components to release.
+ */
+static void logging_staged_testing_release (CuTest *test, struct logging_staged_testing *logging)
+{
+	int status;
+
+	status = logging_mock_validate_and_release (&logging->log);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_staged_release (&logging->staged);
+}
+
+
+/**
+ * Flush request handler that counts the number of requests.
+ *
+ * @param context The request counter.
+ */
+static void logging_staged_testing_flush_request (void *context)
+{
+	int *requests = context;
+
+	(*requests)++;
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void logging_staged_test_init (CuTest *test)
+{
+	struct logging_staged_testing logging;
+
+	TEST_START;
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	CuAssertPtrNotNull (test, logging.staged.base.create_entry);
+	CuAssertPtrNotNull (test, logging.staged.base.flush);
+	CuAssertPtrNotNull (test, logging.staged.base.clear);
+	CuAssertPtrNotNull (test, logging.staged.base.get_size);
+	CuAssertPtrNotNull (test, logging.staged.base.read_contents);
+	CuAssertPtrNotNull (test, logging.staged.base.get_max_entry_length);
+
+	CuAssertIntEquals (test, 0, logging_staged_get_dropped_count (&logging.staged));
+	CuAssertIntEquals (test, 0, logging_staged_get_rejected_count (&logging.staged));
+	CuAssertIntEquals (test, 0, logging_staged_get_staged_count (&logging.staged));
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_init_null (CuTest *test)
+{
+	struct logging_mock log;
+	struct logging_staged logging;
+	int status;
+
+	TEST_START;
+
+	status = logging_mock_init (&log);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_staged_init (NULL, &log.base, 4, 11);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_staged_init (&logging, NULL, 4, 11);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_staged_init (&logging, &log.base, 0, 11);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_staged_init (&logging, &log.base, 4, 0);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_staged_init (&logging, &log.base, 4, UINT16_MAX + 1);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_mock_validate_and_release (&log);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void logging_staged_test_init_entry_too_long (CuTest *test)
+{
+	struct logging_mock log;
+	struct logging_staged logging;
+	int status;
+
+	TEST_START;
+
+	status = logging_mock_init (&log);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&log.mock, log.base.get_max_entry_length, &log, 10);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_staged_init (&logging, &log.base, 4, 11);
+	CuAssertIntEquals (test, LOGGING_BAD_ENTRY_LENGTH, status);
+
+	status = logging_mock_validate_and_release (&log);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void logging_staged_test_init_max_entry_length_error (CuTest *test)
+{
+	struct logging_mock log;
+	struct logging_staged logging;
+	int status;
+
+	TEST_START;
+
+	status = logging_mock_init (&log);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&log.mock, log.base.get_max_entry_length, &log,
+		LOGGING_INVALID_ARGUMENT);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_staged_init (&logging, &log.base, 4, 11);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_mock_validate_and_release (&log);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void logging_staged_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	logging_staged_release (NULL);
+}
+
+static void logging_staged_test_create_entry (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	uint8_t entry[11];
+	int status;
+
+	TEST_START;
+
+	memset (entry, 0x55, sizeof (entry));
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	/* Creating an entry must not access the log. */
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, 5);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 2, logging_staged_get_staged_count (&logging.staged));
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_create_entry_full (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	uint8_t entry[11];
+	int status;
+
+	TEST_START;
+
+	memset (entry, 0x55, sizeof (entry));
+
+	logging_staged_testing_init (test, &logging, 2);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_STAGING_FULL, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_STAGING_FULL, status);
+
+	CuAssertIntEquals (test, 2, logging_staged_get_dropped_count (&logging.staged));
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_create_entry_full_not_power_of_two (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	uint8_t entry[11];
+	int status;
+
+	TEST_START;
+
+	memset (entry, 0x55, sizeof (entry));
+
+	logging_staged_testing_init (test, &logging, 3);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_STAGING_FULL, status);
+
+	CuAssertIntEquals (test, 1, logging_staged_get_dropped_count (&logging.staged));
+	CuAssertIntEquals (test, 3, logging_staged_get_staged_count (&logging.staged));
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_create_entry_null (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	uint8_t entry[11];
+	int status;
+
+	TEST_START;
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = logging.staged.base.create_entry (NULL, entry, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, NULL, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_create_entry_bad_length (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	uint8_t entry[12];
+	int status;
+
+	TEST_START;
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, 0);
+	CuAssertIntEquals (test, LOGGING_BAD_ENTRY_LENGTH, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_BAD_ENTRY_LENGTH, status);
+
+	CuAssertIntEquals (test, 0, logging_staged_get_staged_count (&logging.staged));
+	CuAssertIntEquals (test, 0, logging_staged_get_dropped_count (&logging.staged));
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_flush (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	uint8_t entry1[11];
+	uint8_t entry2[5];
+	int status;
+
+	TEST_START;
+
+	memset (entry1, 0x11, sizeof (entry1));
+	memset (entry2, 0x22, sizeof (entry2));
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry1, sizeof (entry1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry2, sizeof (entry2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (entry1, sizeof (entry1)), MOCK_ARG (sizeof (entry1)));
+	status |= mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (entry2, sizeof (entry2)), MOCK_ARG (sizeof (entry2)));
+	status |= mock_expect (&logging.log.mock, logging.log.base.flush, &logging.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.flush (&logging.staged.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, logging_staged_get_staged_count (&logging.staged));
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_flush_no_entries (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.flush, &logging.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.flush (&logging.staged.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_flush_wrap_around (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	uint8_t entry[4][11];
+	int status;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < 4; i++) {
+		memset (entry[i], i, sizeof (entry[i]));
+	}
+
+	logging_staged_testing_init (test, &logging, 3);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry[0], sizeof (entry[0]));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry[1], sizeof (entry[1]));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (entry[0], sizeof (entry[0])), MOCK_ARG (sizeof (entry[0])));
+	status |= mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (entry[1], sizeof (entry[1])), MOCK_ARG (sizeof (entry[1])));
+	status |= mock_expect (&logging.log.mock, logging.log.base.flush, &logging.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.flush (&logging.staged.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry[2], sizeof (entry[2]));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry[3], sizeof (entry[3]));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (entry[2], sizeof (entry[2])), MOCK_ARG (sizeof (entry[2])));
+	status |= mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (entry[3], sizeof (entry[3])), MOCK_ARG (sizeof (entry[3])));
+	status |= mock_expect (&logging.log.mock, logging.log.base.flush, &logging.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.flush (&logging.staged.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_flush_create_entry_error (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	uint8_t entry1[11];
+	uint8_t entry2[11];
+	int status;
+
+	TEST_START;
+
+	memset (entry1, 0x11, sizeof (entry1));
+	memset (entry2, 0x22, sizeof (entry2));
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry1, sizeof (entry1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry2, sizeof (entry2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (entry1, sizeof (entry1)), MOCK_ARG (sizeof (entry1)));
+	status |= mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log,
+		LOGGING_CREATE_ENTRY_FAILED, MOCK_ARG_PTR_CONTAINS_TMP (entry2, sizeof (entry2)),
+		MOCK_ARG (sizeof (entry2)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.flush (&logging.staged.base);
+	CuAssertIntEquals (test, LOGGING_CREATE_ENTRY_FAILED, status);
+
+	CuAssertIntEquals (test, 1, logging_staged_get_staged_count (&logging.staged));
+
+	status = mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (entry2, sizeof (entry2)), MOCK_ARG (sizeof (entry2)));
+	status |= mock_expect (&logging.log.mock, logging.log.base.flush, &logging.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.flush (&logging.staged.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, logging_staged_get_staged_count (&logging.staged));
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_flush_position_wrap_around (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	uint8_t entry[4][11];
+	size_t start = SIZE_MAX - 1;
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	for (i = 0; i < 4; i++) {
+		memset (entry[i], i, sizeof (entry[i]));
+	}
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	/* Move the ring positions to just before the counters overflow. */
+	atomic_store (&logging.staged.head, start);
+	atomic_store (&logging.staged.tail, start);
+	for (i = 0; i < logging.staged.slot_count; i++) {
+		atomic_store (&logging.staged.sequence[(start + i) & (logging.staged.slot_count - 1)],
+			start + i);
+	}
+
+	for (i = 0; i < 4; i++) {
+		status = logging.staged.base.create_entry (&logging.staged.base, entry[i],
+			sizeof (entry[i]));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry[0], sizeof (entry[0]));
+	CuAssertIntEquals (test, LOGGING_STAGING_FULL, status);
+
+	CuAssertIntEquals (test, 4, logging_staged_get_staged_count (&logging.staged));
+
+	status = 0;
+	for (i = 0; i < 4; i++) {
+		status |= mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log, 0,
+			MOCK_ARG_PTR_CONTAINS_TMP (entry[i], sizeof (entry[i])), MOCK_ARG (sizeof (entry[i])));
+	}
+	status |= mock_expect (&logging.log.mock, logging.log.base.flush, &logging.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.flush (&logging.staged.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, logging_staged_get_staged_count (&logging.staged));
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry[1], sizeof (entry[1]));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, logging_staged_get_staged_count (&logging.staged));
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_flush_entry_rejected (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	uint8_t entry1[11];
+	uint8_t entry2[11];
+	uint8_t entry3[11];
+	int status;
+
+	TEST_START;
+
+	memset (entry1, 0x11, sizeof (entry1));
+	memset (entry2, 0x22, sizeof (entry2));
+	memset (entry3, 0x33, sizeof (entry3));
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry1, sizeof (entry1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry2, sizeof (entry2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry3, sizeof (entry3));
+	CuAssertIntEquals (test, 0, status);
+
+	/* Entries the log will never accept are discarded instead of blocking later entries. */
+	status = mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log,
+		LOGGING_BAD_ENTRY_LENGTH, MOCK_ARG_PTR_CONTAINS_TMP (entry1, sizeof (entry1)),
+		MOCK_ARG (sizeof (entry1)));
+	status |= mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log,
+		LOGGING_ENTRY_RATE_LIMITED, MOCK_ARG_PTR_CONTAINS_TMP (entry2, sizeof (entry2)),
+		MOCK_ARG (sizeof (entry2)));
+	status |= mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (entry3, sizeof (entry3)), MOCK_ARG (sizeof (entry3)));
+	status |= mock_expect (&logging.log.mock, logging.log.base.flush, &logging.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.flush (&logging.staged.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, logging_staged_get_staged_count (&logging.staged));
+	CuAssertIntEquals (test, 2, logging_staged_get_rejected_count (&logging.staged));
+	CuAssertIntEquals (test, 0, logging_staged_get_dropped_count (&logging.staged));
+
+	/* Nothing is left to retry. */
+	status = mock_expect (&logging.log.mock, logging.log.base.flush, &logging.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.flush (&logging.staged.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_flush_error (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.flush, &logging.log,
+		LOGGING_FLUSH_FAILED);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.flush (&logging.staged.base);
+	CuAssertIntEquals (test, LOGGING_FLUSH_FAILED, status);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_flush_null (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = logging.staged.base.flush (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_clear (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	uint8_t entry[11];
+	int status;
+
+	TEST_START;
+
+	memset (entry, 0x55, sizeof (entry));
+
+	logging_staged_testing_init (test, &logging, 1);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_STAGING_FULL, status);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.clear, &logging.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.clear (&logging.staged.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, logging_staged_get_staged_count (&logging.staged));
+	CuAssertIntEquals (test, 0, logging_staged_get_dropped_count (&logging.staged));
+
+	status = mock_expect (&logging.log.mock, logging.log.base.flush, &logging.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.flush (&logging.staged.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_clear_error (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.clear, &logging.log,
+		LOGGING_CLEAR_FAILED);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.clear (&logging.staged.base);
+	CuAssertIntEquals (test, LOGGING_CLEAR_FAILED, status);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_clear_null (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = logging.staged.base.clear (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_get_size (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.get_size, &logging.log, 32);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.get_size (&logging.staged.base);
+	CuAssertIntEquals (test, 32, status);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_get_size_null (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = logging.staged.base.get_size (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_read_contents (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	uint8_t output[32];
+	int status;
+
+	TEST_START;
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.read_contents, &logging.log, 16,
+		MOCK_ARG (4), MOCK_ARG (output), MOCK_ARG (sizeof (output)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.read_contents (&logging.staged.base, 4, output, sizeof (output));
+	CuAssertIntEquals (test, 16, status);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_read_contents_null (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	uint8_t output[32];
+	int status;
+
+	TEST_START;
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = logging.staged.base.read_contents (NULL, 0, output, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging.staged.base.read_contents (&logging.staged.base, 0, NULL, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_get_max_entry_length (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	int status;
+
+	TEST_START;
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = logging.staged.base.get_max_entry_length (&logging.staged.base);
+	CuAssertIntEquals (test, 11, status);
+
+	status = logging.staged.base.get_max_entry_length (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_get_rejected_count_null (CuTest *test)
+{
+	TEST_START;
+
+	CuAssertIntEquals (test, 0, logging_staged_get_rejected_count (NULL));
+}
+
+static void logging_staged_test_get_dropped_count_null (CuTest *test)
+{
+	TEST_START;
+
+	CuAssertIntEquals (test, 0, logging_staged_get_dropped_count (NULL));
+}
+
+static void logging_staged_test_get_staged_count (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	uint8_t entry[11];
+	int status;
+
+	TEST_START;
+
+	memset (entry, 0x55, sizeof (entry));
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	CuAssertIntEquals (test, 0, logging_staged_get_staged_count (&logging.staged));
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 2, logging_staged_get_staged_count (&logging.staged));
+
+	status = mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (entry, sizeof (entry)), MOCK_ARG (sizeof (entry)));
+	status |= mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (entry, sizeof (entry)), MOCK_ARG (sizeof (entry)));
+	status |= mock_expect (&logging.log.mock, logging.log.base.flush, &logging.log, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.flush (&logging.staged.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, logging_staged_get_staged_count (&logging.staged));
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_get_staged_count_null (CuTest *test)
+{
+	TEST_START;
+
+	CuAssertIntEquals (test, 0, logging_staged_get_staged_count (NULL));
+}
+
+static void logging_staged_test_set_flush_watermark (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	uint8_t entry[11];
+	int requests = 0;
+	int status;
+
+	TEST_START;
+
+	memset (entry, 0x55, sizeof (entry));
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = logging_staged_set_flush_watermark (&logging.staged, 2,
+		logging_staged_testing_flush_request, &requests);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, requests);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, requests);
+
+	/* A flush is already pending, so no new requests should be made. */
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, requests);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, requests);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_STAGING_FULL, status);
+	CuAssertIntEquals (test, 1, requests);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_set_flush_watermark_after_flush (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	uint8_t entry[11];
+	int requests = 0;
+	int status;
+
+	TEST_START;
+
+	memset (entry, 0x55, sizeof (entry));
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = logging_staged_set_flush_watermark (&logging.staged, 1,
+		logging_staged_testing_flush_request, &requests);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, requests);
+
+	status = mock_expect (&logging.log.mock, logging.log.base.create_entry, &logging.log, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (entry, sizeof (entry)), MOCK_ARG (sizeof (entry)));
+	status |= mock_expect (&logging.log.mock, logging.log.base.flush, &logging.log, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.flush (&logging.staged.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, requests);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_set_flush_watermark_disable (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	uint8_t entry[11];
+	int requests = 0;
+	int status;
+
+	TEST_START;
+
+	memset (entry, 0x55, sizeof (entry));
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = logging_staged_set_flush_watermark (&logging.staged, 1,
+		logging_staged_testing_flush_request, &requests);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_staged_set_flush_watermark (&logging.staged, 0,
+		logging_staged_testing_flush_request, &requests);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, requests);
+
+	status = logging_staged_set_flush_watermark (&logging.staged, 2, NULL, &requests);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.staged.base.create_entry (&logging.staged.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, requests);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_set_flush_watermark_invalid_arg (CuTest *test)
+{
+	struct logging_staged_testing logging;
+	int requests = 0;
+	int status;
+
+	TEST_START;
+
+	logging_staged_testing_init (test, &logging, 4);
+
+	status = logging_staged_set_flush_watermark (NULL, 2, logging_staged_testing_flush_request,
+		&requests);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_staged_set_flush_watermark (&logging.staged, 5,
+		logging_staged_testing_flush_request, &requests);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_staged_testing_release (test, &logging);
+}
+
+static void logging_staged_test_memory_log (CuTest *test)
+{
+	struct logging_memory memory;
+	struct logging_staged logging;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	uint8_t entry[2][entry_size];
+	uint8_t entry_data[entry_len * 2];
+	uint8_t output[entry_len * 4];
+	struct logging_entry_header *header;
+	uint8_t *pos;
+	int status;
+	int i;
+
+	TEST_START;
+
+	pos = entry_data;
+	for (i = 0; i < 2; i++) {
+		memset (entry[i], i, entry_size);
+
+		header = (struct logging_entry_header*) pos;
+		header->log_magic = 0xCB;
+		header->length = entry_len;
+		header->entry_id = i;
+		pos += sizeof (struct logging_entry_header);
+
+		memcpy (pos, entry[i], entry_size);
+		pos += entry_size;
+	}
+
+	status = logging_memory_init (&memory, 4, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_staged_init (&logging, &memory.base, 4, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.create_entry (&logging.base, entry[0], entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.create_entry (&logging.base, entry[1], entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_staged_release (&logging);
+	logging_memory_release (&memory);
+}
+
+
+CuSuite* get_logging_staged_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, logging_staged_test_init);
+	SUITE_ADD_TEST (suite, logging_staged_test_init_null);
+	SUITE_ADD_TEST (suite, logging_staged_test_init_entry_too_long);
+	SUITE_ADD_TEST (suite, logging_staged_test_init_max_entry_length_error);
+	SUITE_ADD_TEST (suite, logging_staged_test_release_null);
+	SUITE_ADD_TEST (suite, logging_staged_test_create_entry);
+	SUITE_ADD_TEST (suite, logging_staged_test_create_entry_full);
+	SUITE_ADD_TEST (suite, logging_staged_test_create_entry_full_not_power_of_two);
+	SUITE_ADD_TEST (suite, logging_staged_test_create_entry_null);
+	SUITE_ADD_TEST (suite, logging_staged_test_create_entry_bad_length);
+	SUITE_ADD_TEST (suite, logging_staged_test_flush);
+	SUITE_ADD_TEST (suite, logging_staged_test_flush_no_entries);
+	SUITE_ADD_TEST (suite, logging_staged_test_flush_wrap_around);
+	SUITE_ADD_TEST (suite, logging_staged_test_flush_create_entry_error);
+	SUITE_ADD_TEST (suite, logging_staged_test_flush_position_wrap_around);
+	SUITE_ADD_TEST (suite, logging_staged_test_flush_entry_rejected);
+	SUITE_ADD_TEST (suite, logging_staged_test_flush_error);
+	SUITE_ADD_TEST (suite, logging_staged_test_flush_null);
+	SUITE_ADD_TEST (suite, logging_staged_test_clear);
+	SUITE_ADD_TEST (suite, logging_staged_test_clear_error);
+	SUITE_ADD_TEST (suite, logging_staged_test_clear_null);
+	SUITE_ADD_TEST (suite, logging_staged_test_get_size);
+	SUITE_ADD_TEST (suite, logging_staged_test_get_size_null);
+	SUITE_ADD_TEST (suite, logging_staged_test_read_contents);
+	SUITE_ADD_TEST (suite, logging_staged_test_read_contents_null);
+	SUITE_ADD_TEST (suite, logging_staged_test_get_max_entry_length);
+	SUITE_ADD_TEST (suite, logging_staged_test_get_rejected_count_null);
+	SUITE_ADD_TEST (suite, logging_staged_test_get_dropped_count_null);
+	SUITE_ADD_TEST (suite, logging_staged_test_get_staged_count);
+	SUITE_ADD_TEST (suite, logging_staged_test_get_staged_count_null);
+	SUITE_ADD_TEST (suite, logging_staged_test_set_flush_watermark);
+	SUITE_ADD_TEST (suite, logging_staged_test_set_flush_watermark_after_flush);
+	SUITE_ADD_TEST (suite, logging_staged_test_set_flush_watermark_disable);
+	SUITE_ADD_TEST (suite, logging_staged_test_set_flush_watermark_invalid_arg);
+	SUITE_ADD_TEST (suite, logging_staged_test_memory_log);
+
+	return suite;
+}
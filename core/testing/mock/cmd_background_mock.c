@@ -110,6 +110,18 @@ static int cmd_background_mock_get_riot_cert_chain_state (struct cmd_background
 	MOCK_RETURN_NO_ARGS (&mock->mock, cmd_background_mock_get_riot_cert_chain_state, cmd);
 }
 
+static int cmd_background_mock_run_deferred (struct cmd_background *cmd,
+	struct cmd_deferred *deferred)
+{
+	struct cmd_background_mock *mock = (struct cmd_background_mock*) cmd;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN (&mock->mock, cmd_background_mock_run_deferred, cmd, MOCK_ARG_CALL (deferred));
+}
+
 static int cmd_background_mock_func_arg_count (void *func)
 {
 	if (func == cmd_background_mock_unseal_result) {
@@ -118,6 +130,9 @@ static int cmd_background_mock_func_arg_count (void *func)
 	else if (func == cmd_background_mock_unseal_start) {
 		return 2;
 	}
+	else if (func == cmd_background_mock_run_deferred) {
+		return 1;
+	}
 	else {
 		return 0;
 	}
@@ -152,6 +167,9 @@ static const char* cmd_background_mock_func_name_map (void *func)
 	else if (func == cmd_background_mock_get_riot_cert_chain_state) {
 		return "get_riot_cert_chain_state";
 	}
+	else if (func == cmd_background_mock_run_deferred) {
+		return "run_deferred";
+	}
 	else {
 		return "unknown";
 	}
@@ -180,6 +198,12 @@ static const char* cmd_background_mock_arg_name_map (void *func, int arg)
 				return "unseal_status";
 		}
 	}
+	else if (func == cmd_background_mock_run_deferred) {
+		switch (arg) {
+			case 0:
+				return "deferred";
+		}
+	}
 
 	return "unknown";
 }
@@ -217,6 +241,7 @@ int cmd_background_mock_init (struct cmd_background_mock *mock)
 	mock->base.debug_log_fill = cmd_background_mock_debug_log_fill;
 	mock->base.authenticate_riot_certs = cmd_background_mock_authenticate_riot_certs;
 	mock->base.get_riot_cert_chain_state = cmd_background_mock_get_riot_cert_chain_state;
+	mock->base.run_deferred = cmd_background_mock_run_deferred;
 
 	mock->mock.func_arg_count = cmd_background_mock_func_arg_count;
 	mock->mock.func_name_map = cmd_background_mock_func_name_map;
@@ -123,6 +123,19 @@ static int ecc_mock_sign (struct ecc_engine *engine, struct ecc_private_key *key
 		MOCK_ARG_CALL (length), MOCK_ARG_CALL (signature), MOCK_ARG_CALL (sig_length));
 }
 
+static int ecc_mock_precompute_sign (struct ecc_engine *engine, struct ecc_private_key *key,
+	size_t count)
+{
+	struct ecc_engine_mock *mock = (struct ecc_engine_mock*) engine;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN (&mock->mock, ecc_mock_precompute_sign, engine, MOCK_ARG_CALL (key),
+		MOCK_ARG_CALL (count));
+}
+
 static int ecc_mock_verify (struct ecc_engine *engine, struct ecc_public_key *key,
 	const uint8_t *digest, size_t length, const uint8_t *signature, size_t sig_length)
 {
@@ -175,7 +188,8 @@ static int ecc_mock_func_arg_count (void *func)
 		(func == ecc_mock_get_public_key_der)) {
 		return 3;
 	}
-	else if ((func == ecc_mock_generate_key_pair) || (func == ecc_mock_release_key_pair)) {
+	else if ((func == ecc_mock_generate_key_pair) || (func == ecc_mock_release_key_pair) ||
+		(func == ecc_mock_precompute_sign)) {
 		return 2;
 	}
 	else if ((func == ecc_mock_get_signature_max_length) ||
@@ -216,6 +230,9 @@ static const char* ecc_mock_func_name_map (void *func)
 	else if (func == ecc_mock_sign) {
 		return "sign";
 	}
+	else if (func == ecc_mock_precompute_sign) {
+		return "precompute_sign";
+	}
 	else if (func == ecc_mock_verify) {
 		return "verify";
 	}
@@ -340,6 +357,15 @@ static const char* ecc_mock_arg_name_map (void *func, int arg)
 				return "sig_length";
 		}
 	}
+	else if (func == ecc_mock_precompute_sign) {
+		switch (arg) {
+			case 0:
+				return "key";
+
+			case 1:
+				return "count";
+		}
+	}
 	else if (func == ecc_mock_verify) {
 		switch (arg) {
 			case 0:
@@ -416,6 +442,7 @@ int ecc_mock_init (struct ecc_engine_mock *mock)
 	mock->base.get_private_key_der = ecc_mock_get_private_key_der;
 	mock->base.get_public_key_der = ecc_mock_get_public_key_der;
 	mock->base.sign = ecc_mock_sign;
+	mock->base.precompute_sign = ecc_mock_precompute_sign;
 	mock->base.verify = ecc_mock_verify;
 	mock->base.get_shared_secret_max_length = ecc_mock_get_shared_secret_max_length;
 	mock->base.compute_shared_secret = ecc_mock_compute_shared_secret;
@@ -33,6 +33,19 @@ static int firmware_image_mock_verify (struct firmware_image *fw, struct hash_en
 		MOCK_ARG_CALL (rsa));
 }
 
+static int firmware_image_mock_verify_digest (struct firmware_image *fw, struct hash_engine *hash,
+	struct rsa_engine *rsa, const uint8_t *digest, size_t length)
+{
+	struct firmware_image_mock *mock = (struct firmware_image_mock*) fw;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN (&mock->mock, firmware_image_mock_verify_digest, fw, MOCK_ARG_CALL (hash),
+		MOCK_ARG_CALL (rsa), MOCK_ARG_CALL (digest), MOCK_ARG_CALL (length));
+}
+
 static int firmware_image_mock_get_image_size (struct firmware_image *fw)
 {
 	struct firmware_image_mock *mock = (struct firmware_image_mock*) fw;
@@ -73,6 +86,9 @@ static int firmware_image_mock_func_arg_count (void *func)
 	if ((func == firmware_image_mock_load) || (func == firmware_image_mock_verify)) {
 		return 2;
 	}
+	else if (func == firmware_image_mock_verify_digest) {
+		return 4;
+	}
 	else {
 		return 0;
 	}
@@ -86,6 +102,9 @@ static const char* firmware_image_mock_func_name_map (void *func)
 	else if (func == firmware_image_mock_verify) {
 		return "verify";
 	}
+	else if (func == firmware_image_mock_verify_digest) {
+		return "verify_digest";
+	}
 	else if (func == firmware_image_mock_get_image_size) {
 		return "get_image_size";
 	}
@@ -120,6 +139,21 @@ static const char* firmware_image_mock_arg_name_map (void *func, int arg)
 				return "rsa";
 		}
 	}
+	else if (func == firmware_image_mock_verify_digest) {
+		switch (arg) {
+			case 0:
+				return "hash";
+
+			case 1:
+				return "rsa";
+
+			case 2:
+				return "digest";
+
+			case 3:
+				return "length";
+		}
+	}
 
 	return "unknown";
 }
@@ -150,6 +184,7 @@ int firmware_image_mock_init (struct firmware_image_mock *mock)
 
 	mock->base.load = firmware_image_mock_load;
 	mock->base.verify = firmware_image_mock_verify;
+	mock->base.verify_digest = firmware_image_mock_verify_digest;
 	mock->base.get_image_size = firmware_image_mock_get_image_size;
 	mock->base.get_key_manifest = firmware_image_mock_get_key_manifest;
 	mock->base.get_firmware_header = firmware_image_mock_get_firmware_header;
@@ -33,6 +33,19 @@ static int hash_mock_calculate_sha256 (struct hash_engine *engine, const uint8_t
 		MOCK_ARG_CALL (length), MOCK_ARG_CALL (hash), MOCK_ARG_CALL (hash_length));
 }
 
+static int hash_mock_calculate_sha256_multi (struct hash_engine *engine,
+	const struct hash_multi_buffer *buffers, size_t count)
+{
+	struct hash_engine_mock *mock = (struct hash_engine_mock*) engine;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN (&mock->mock, hash_mock_calculate_sha256_multi, engine, MOCK_ARG_CALL (buffers),
+		MOCK_ARG_CALL (count));
+}
+
 static int hash_mock_start_sha1 (struct hash_engine *engine)
 {
 	struct hash_engine_mock *mock = (struct hash_engine_mock*) engine;
@@ -95,7 +108,8 @@ static int hash_mock_func_arg_count (void *func)
 	if ((func == hash_mock_calculate_sha1) || (func == hash_mock_calculate_sha256)) {
 		return 4;
 	}
-	else if ((func == hash_mock_update) || (func == hash_mock_finish)) {
+	else if ((func == hash_mock_calculate_sha256_multi) || (func == hash_mock_update) ||
+		(func == hash_mock_finish)) {
 		return 2;
 	}
 	else {
@@ -111,6 +125,9 @@ static const char* hash_mock_func_name_map (void *func)
 	else if (func == hash_mock_calculate_sha256) {
 		return "calculate_sha256";
 	}
+	else if (func == hash_mock_calculate_sha256_multi) {
+		return "calculate_sha256_multi";
+	}
 	else if (func == hash_mock_start_sha1) {
 		return "start_sha1";
 	}
@@ -163,6 +180,15 @@ static const char* hash_mock_arg_name_map (void *func, int arg)
 				return "hash_length";
 		}
 	}
+	else if (func == hash_mock_calculate_sha256_multi) {
+		switch (arg) {
+			case 0:
+				return "buffers";
+
+			case 1:
+				return "count";
+		}
+	}
 	else if (func == hash_mock_update) {
 		switch (arg) {
 			case 0:
@@ -211,6 +237,7 @@ int hash_mock_init (struct hash_engine_mock *mock)
 
 	mock->base.calculate_sha1 = hash_mock_calculate_sha1;
 	mock->base.calculate_sha256 = hash_mock_calculate_sha256;
+	mock->base.calculate_sha256_multi = hash_mock_calculate_sha256_multi;
 	mock->base.start_sha1 = hash_mock_start_sha1;
 	mock->base.start_sha256 = hash_mock_start_sha256;
 	mock->base.update = hash_mock_update;
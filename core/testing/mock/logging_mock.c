@@ -65,6 +65,17 @@ static int logging_mock_read_contents (struct logging *logging, uint32_t offset,
 		MOCK_ARG_CALL (contents), MOCK_ARG_CALL (length));
 }
 
+static int logging_mock_get_max_entry_length (struct logging *logging)
+{
+	struct logging_mock *mock = (struct logging_mock*) logging;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN_NO_ARGS (&mock->mock, logging_mock_get_max_entry_length, logging);
+}
+
 static int logging_mock_func_arg_count (void *func)
 {
 	if (func == logging_mock_read_contents) {
@@ -95,6 +106,9 @@ static const char* logging_mock_func_name_map (void *func)
 	else if (func == logging_mock_read_contents) {
 		return "read_contents";
 	}
+	else if (func == logging_mock_get_max_entry_length) {
+		return "get_max_entry_length";
+	}
 	else {
 		return "unknown";
 	}
@@ -156,6 +170,7 @@ int logging_mock_init (struct logging_mock *mock)
 	mock->base.clear = logging_mock_clear;
 	mock->base.get_size = logging_mock_get_size;
 	mock->base.read_contents = logging_mock_read_contents;
+	mock->base.get_max_entry_length = logging_mock_get_max_entry_length;
 
 	mock->mock.func_arg_count = logging_mock_func_arg_count;
 	mock->mock.func_name_map = logging_mock_func_name_map;
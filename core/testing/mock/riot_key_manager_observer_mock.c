@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "riot_key_manager_observer_mock.h"
+
+
+static void riot_key_manager_observer_mock_on_cert_chain_changed (
+	struct riot_key_manager_observer *observer)
+{
+	struct riot_key_manager_observer_mock *mock =
+		(struct riot_key_manager_observer_mock*) observer;
+
+	if (mock == NULL) {
+		return;
+	}
+
+	MOCK_VOID_RETURN_NO_ARGS (&mock->mock, riot_key_manager_observer_mock_on_cert_chain_changed,
+		observer);
+}
+
+static int riot_key_manager_observer_mock_func_arg_count (void *func)
+{
+	return 0;
+}
+
+static const char* riot_key_manager_observer_mock_func_name_map (void *func)
+{
+	if (func == riot_key_manager_observer_mock_on_cert_chain_changed) {
+		return "on_cert_chain_changed";
+	}
+	else {
+		return "unknown";
+	}
+}
+
+static const char* riot_key_manager_observer_mock_arg_name_map (void *func, int arg)
+{
+	return "unknown";
+}
+
+/**
+ * Initialize a mock for receiving RIoT certificate chain notifications.
+ *
+ * @param mock The mock to initialize.
+ *
+ * @return 0 if the mock was successfully initialized or an error code.
+ */
+int riot_key_manager_observer_mock_init (struct riot_key_manager_observer_mock *mock)
+{
+	int status;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	memset (mock, 0, sizeof (struct riot_key_manager_observer_mock));
+
+	status = mock_init (&mock->mock);
+	if (status != 0) {
+		return status;
+	}
+
+	mock_set_name (&mock->mock, "riot_key_manager_observer");
+
+	mock->base.on_cert_chain_changed = riot_key_manager_observer_mock_on_cert_chain_changed;
+
+	mock->mock.func_arg_count = riot_key_manager_observer_mock_func_arg_count;
+	mock->mock.func_name_map = riot_key_manager_observer_mock_func_name_map;
+	mock->mock.arg_name_map = riot_key_manager_observer_mock_arg_name_map;
+
+	return 0;
+}
+
+/**
+ * Release the resources used by a RIoT key manager observer mock.
+ *
+ * @param mock The mock to release.
+ */
+void riot_key_manager_observer_mock_release (struct riot_key_manager_observer_mock *mock)
+{
+	if (mock) {
+		mock_release (&mock->mock);
+	}
+}
+
+/**
+ * Validate the expectations on the mock and release the instance.
+ *
+ * @param mock The mock to validate.
+ *
+ * @return 0 if all expectations were met or 1 if not.
+ */
+int riot_key_manager_observer_mock_validate_and_release (
+	struct riot_key_manager_observer_mock *mock)
+{
+	int status = 1;
+
+	if (mock != NULL) {
+		status = mock_validate (&mock->mock);
+		riot_key_manager_observer_mock_release (mock);
+	}
+
+	return status;
+}
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef RIOT_KEY_MANAGER_OBSERVER_MOCK_H_
+#define RIOT_KEY_MANAGER_OBSERVER_MOCK_H_
+
+#include "riot/riot_key_manager_observer.h"
+#include "mock.h"
+
+
+/**
+ * A mock for RIoT certificate chain notifications.
+ */
+struct riot_key_manager_observer_mock {
+	struct riot_key_manager_observer base;	/**< The base observer instance. */
+	struct mock mock;						/**< The base mock interface. */
+};
+
+
+int riot_key_manager_observer_mock_init (struct riot_key_manager_observer_mock *mock);
+void riot_key_manager_observer_mock_release (struct riot_key_manager_observer_mock *mock);
+
+int riot_key_manager_observer_mock_validate_and_release (
+	struct riot_key_manager_observer_mock *mock);
+
+
+#endif /* RIOT_KEY_MANAGER_OBSERVER_MOCK_H_ */
@@ -20,6 +20,17 @@ static int rng_mock_generate_random_buffer (struct rng_engine *engine, size_t ra
 		MOCK_ARG_CALL (buf));
 }
 
+static int rng_mock_reseed (struct rng_engine *engine)
+{
+	struct rng_engine_mock *mock = (struct rng_engine_mock*) engine;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN_NO_ARGS (&mock->mock, rng_mock_reseed, engine);
+}
+
 static int rng_mock_func_arg_count (void *func)
 {
 	if (func == rng_mock_generate_random_buffer) {
@@ -35,6 +46,9 @@ static const char* rng_mock_func_name_map (void *func)
 	if (func == rng_mock_generate_random_buffer) {
 		return "generate_random_buffer";
 	}
+	else if (func == rng_mock_reseed) {
+		return "reseed";
+	}
 	else {
 		return "unknown";
 	}
@@ -80,6 +94,7 @@ int rng_mock_init (struct rng_engine_mock *mock)
 	mock_set_name (&mock->mock, "rng");
 
 	mock->base.generate_random_buffer = rng_mock_generate_random_buffer;
+	mock->base.reseed = rng_mock_reseed;
 
 	mock->mock.func_arg_count = rng_mock_func_arg_count;
 	mock->mock.func_name_map = rng_mock_func_name_map;
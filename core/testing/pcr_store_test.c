@@ -1552,6 +1552,36 @@ static void pcr_store_test_get_tcg_log_small_buffer (CuTest *test)
 	status |= mock_expect_output (&hash.mock, 0, digests[3], PCR_DIGEST_LENGTH, -1);
 	CuAssertIntEquals (test, 0, status);
 
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digests[3], PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digests[2], PCR_DIGEST_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digests[2], PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digests[4], PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digests[1], PCR_DIGEST_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digests[1], PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digests[5], PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digests[0], PCR_DIGEST_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+
 	for (i_measurement = 0; i_measurement < 3; ++i_measurement) {
 		pcr_store_update_digest (&store, PCR_MEASUREMENT (0, i_measurement), digests[i_measurement],
 			PCR_DIGEST_LENGTH);
@@ -1669,6 +1699,36 @@ static void pcr_store_test_get_tcg_log_small_buffer_not_entry_aligned (CuTest *t
 	status |= mock_expect_output (&hash.mock, 0, digests[3], PCR_DIGEST_LENGTH, -1);
 	CuAssertIntEquals (test, 0, status);
 
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digests[3], PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digests[2], PCR_DIGEST_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digests[2], PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digests[4], PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digests[1], PCR_DIGEST_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digests[1], PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digests[5], PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digests[0], PCR_DIGEST_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+
 	for (i_measurement = 0; i_measurement < 3; ++i_measurement) {
 		pcr_store_update_digest (&store, PCR_MEASUREMENT (0, i_measurement), digests[i_measurement],
 			PCR_DIGEST_LENGTH);
@@ -2034,6 +2094,223 @@ static void pcr_store_test_get_tcg_log_compute_fail (CuTest *test)
 	complete_pcr_store_mock_test (test, &store, &hash);
 }
 
+static void pcr_store_test_get_tcg_log_snapshot (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	struct pcr_store_tcg_log_entry buf[2];
+	struct pcr_store_tcg_log_entry exp_buf[2];
+	uint8_t buffer0[PCR_DIGEST_LENGTH] = {0};
+	uint8_t digests[2][PCR_DIGEST_LENGTH];
+	uint8_t extend[2][PCR_DIGEST_LENGTH];
+	size_t chunk = 10;
+	int i_measurement;
+	int status;
+
+	TEST_START;
+
+	memset (digests[0], 0x11, PCR_DIGEST_LENGTH);
+	memset (digests[1], 0x22, PCR_DIGEST_LENGTH);
+	memset (extend[0], 0x33, PCR_DIGEST_LENGTH);
+	memset (extend[1], 0x44, PCR_DIGEST_LENGTH);
+
+	for (i_measurement = 0; i_measurement < 2; ++i_measurement) {
+		exp_buf[i_measurement].header.log_magic = 0xCB;
+		exp_buf[i_measurement].header.length = sizeof (struct pcr_store_tcg_log_entry);
+		exp_buf[i_measurement].header.entry_id = i_measurement;
+		exp_buf[i_measurement].entry.digest_algorithm_id = 0x0B;
+		exp_buf[i_measurement].entry.digest_count = 1;
+		exp_buf[i_measurement].entry.measurement_size = 32;
+		exp_buf[i_measurement].entry.event_type = 0x0A + i_measurement;
+		exp_buf[i_measurement].entry.measurement_type = PCR_MEASUREMENT (i_measurement, 0);
+
+		memcpy (exp_buf[i_measurement].entry.digest, digests[i_measurement], PCR_DIGEST_LENGTH);
+		memcpy (exp_buf[i_measurement].entry.measurement, extend[i_measurement],
+			PCR_DIGEST_LENGTH);
+	}
+
+	setup_pcr_store_mock_test (test, &store, &hash, 1, 1);
+
+	for (i_measurement = 0; i_measurement < 2; ++i_measurement) {
+		status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+		status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+			MOCK_ARG_PTR_CONTAINS (buffer0, PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+		status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+			MOCK_ARG_PTR_CONTAINS (digests[i_measurement], PCR_DIGEST_LENGTH),
+			MOCK_ARG (PCR_DIGEST_LENGTH));
+		status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0,
+			MOCK_ARG_NOT_NULL, MOCK_ARG (PCR_DIGEST_LENGTH));
+		status |= mock_expect_output (&hash.mock, 0, extend[i_measurement], PCR_DIGEST_LENGTH,
+			-1);
+		CuAssertIntEquals (test, 0, status);
+
+		status = pcr_store_update_digest (&store, PCR_MEASUREMENT (i_measurement, 0),
+			digests[i_measurement], PCR_DIGEST_LENGTH);
+		status |= pcr_store_update_event_type (&store, PCR_MEASUREMENT (i_measurement, 0),
+			0x0A + i_measurement);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = pcr_store_get_tcg_log (&store, &hash.base, 0, (uint8_t*) buf, chunk);
+	CuAssertIntEquals (test, chunk, status);
+
+	status = mock_validate (&hash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Later chunks are read from the snapshot. */
+	status = pcr_store_get_tcg_log (&store, &hash.base, chunk, ((uint8_t*) buf) + chunk,
+		sizeof (buf));
+	CuAssertIntEquals (test, sizeof (buf) - chunk, status);
+
+	status = testing_validate_array ((uint8_t*) exp_buf, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
+static void pcr_store_test_get_tcg_log_snapshot_measurement_change (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	struct pcr_store_tcg_log_entry buf[2];
+	uint8_t buffer0[PCR_DIGEST_LENGTH] = {0};
+	uint8_t digest[PCR_DIGEST_LENGTH];
+	uint8_t new_digest[PCR_DIGEST_LENGTH];
+	uint8_t extend[PCR_DIGEST_LENGTH];
+	uint8_t new_extend[PCR_DIGEST_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (digest, 0x11, sizeof (digest));
+	memset (new_digest, 0x22, sizeof (new_digest));
+	memset (extend, 0x33, sizeof (extend));
+	memset (new_extend, 0x44, sizeof (new_extend));
+
+	setup_pcr_store_mock_test (test, &store, &hash, 1, 0);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digest, PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, extend, PCR_DIGEST_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_update_digest (&store, PCR_MEASUREMENT (0, 0), digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_get_tcg_log (&store, &hash.base, 0, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, sizeof (struct pcr_store_tcg_log_entry), status);
+
+	status = testing_validate_array (extend, buf[0].entry.measurement, sizeof (extend));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&hash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Changing the event type updates the snapshot without extending the measurement again. */
+	status = pcr_store_update_event_type (&store, PCR_MEASUREMENT (0, 0), 0x0B);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_get_tcg_log (&store, &hash.base, 0, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, sizeof (struct pcr_store_tcg_log_entry), status);
+	CuAssertIntEquals (test, 0x0B, buf[0].entry.event_type);
+
+	/* Changing the digest regenerates the snapshot with the new measurement. */
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (new_digest, PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, new_extend, PCR_DIGEST_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_update_digest (&store, PCR_MEASUREMENT (0, 0), new_digest,
+		sizeof (new_digest));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_get_tcg_log (&store, &hash.base, 0, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, sizeof (struct pcr_store_tcg_log_entry), status);
+
+	status = testing_validate_array (new_digest, buf[0].entry.digest, sizeof (new_digest));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (new_extend, buf[0].entry.measurement, sizeof (new_extend));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
+static void pcr_store_test_get_tcg_log_snapshot_after_compute_fail (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	struct pcr_store_tcg_log_entry buf[1];
+	uint8_t buffer0[PCR_DIGEST_LENGTH] = {0};
+	uint8_t digest[PCR_DIGEST_LENGTH];
+	uint8_t extend[PCR_DIGEST_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (digest, 0x11, sizeof (digest));
+	memset (extend, 0x33, sizeof (extend));
+
+	setup_pcr_store_mock_test (test, &store, &hash, 1, 0);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, HASH_ENGINE_NO_MEMORY);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_update_digest (&store, PCR_MEASUREMENT (0, 0), digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_get_tcg_log (&store, &hash.base, 0, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_MEMORY, status);
+
+	status = mock_validate (&hash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digest, PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, extend, PCR_DIGEST_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_store_get_tcg_log (&store, &hash.base, 0, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, sizeof (struct pcr_store_tcg_log_entry), status);
+
+	status = testing_validate_array (extend, buf[0].entry.measurement, sizeof (extend));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
+static void pcr_store_test_get_tcg_log_no_measurements (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	struct pcr_store_tcg_log_entry buf[1];
+	int status;
+
+	TEST_START;
+
+	setup_pcr_store_mock_test (test, &store, &hash, 0, 0);
+
+	status = pcr_store_get_tcg_log (&store, &hash.base, 0, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
 static void pcr_store_test_invalidate_measurement (CuTest *test)
 {
 	struct pcr_store store;
@@ -2201,6 +2478,10 @@ CuSuite* get_pcr_store_suite ()
 	SUITE_ADD_TEST (suite, pcr_store_test_get_tcg_log_invalid_offset);
 	SUITE_ADD_TEST (suite, pcr_store_test_get_tcg_log_invalid_arg);
 	SUITE_ADD_TEST (suite, pcr_store_test_get_tcg_log_compute_fail);
+	SUITE_ADD_TEST (suite, pcr_store_test_get_tcg_log_snapshot);
+	SUITE_ADD_TEST (suite, pcr_store_test_get_tcg_log_snapshot_measurement_change);
+	SUITE_ADD_TEST (suite, pcr_store_test_get_tcg_log_snapshot_after_compute_fail);
+	SUITE_ADD_TEST (suite, pcr_store_test_get_tcg_log_no_measurements);
 	SUITE_ADD_TEST (suite, pcr_store_test_invalidate_measurement);
 	SUITE_ADD_TEST (suite, pcr_store_test_invalidate_measurement_explicit);
 	SUITE_ADD_TEST (suite, pcr_store_test_invalidate_measurement_null);
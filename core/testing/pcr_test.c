@@ -55,6 +55,31 @@ static void complete_pcr_mock_test (CuTest *test, struct pcr_bank *pcr,
 	pcr_release (pcr);
 }
 
+/**
+ * Set the expectations for extending a single measurement into the PCR.
+ *
+ * @param test The test framework
+ * @param hash The mock hashing engine
+ * @param prev The current aggregated measurement
+ * @param digest The measurement digest being extended
+ * @param result The new aggregated measurement
+ */
+static void pcr_testing_expect_extend (CuTest *test, struct hash_engine_mock *hash,
+	const uint8_t *prev, const uint8_t *digest, const uint8_t *result)
+{
+	int status;
+
+	status = mock_expect (&hash->mock, hash->base.start_sha256, hash, 0);
+	status |= mock_expect (&hash->mock, hash->base.update, hash, 0,
+		MOCK_ARG_PTR_CONTAINS (prev, PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash->mock, hash->base.update, hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digest, PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash->mock, hash->base.finish, hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash->mock, 0, result, PCR_DIGEST_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+}
+
 /*******************
  * Test cases
  *******************/
@@ -991,6 +1016,333 @@ static void pcr_test_compute_finish_hash_fail (CuTest *test)
 	complete_pcr_mock_test (test, &pcr, &hash);
 }
 
+static void pcr_test_compute_no_changes (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	uint8_t measurement[PCR_DIGEST_LENGTH];
+	uint8_t zero[PCR_DIGEST_LENGTH] = {0};
+	uint8_t digest0[PCR_DIGEST_LENGTH];
+	uint8_t digest1[PCR_DIGEST_LENGTH];
+	uint8_t extend0[PCR_DIGEST_LENGTH];
+	uint8_t extend1[PCR_DIGEST_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (digest0, 0x11, sizeof (digest0));
+	memset (digest1, 0x22, sizeof (digest1));
+	memset (extend0, 0x33, sizeof (extend0));
+	memset (extend1, 0x44, sizeof (extend1));
+
+	setup_pcr_mock_test (test, &pcr, &hash, 2);
+
+	status = pcr_update_digest (&pcr, 0, digest0, sizeof (digest0));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_update_digest (&pcr, 1, digest1, sizeof (digest1));
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_testing_expect_extend (test, &hash, zero, digest0, extend0);
+	pcr_testing_expect_extend (test, &hash, extend0, digest1, extend1);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = testing_validate_array (extend1, measurement, sizeof (extend1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&hash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (measurement, 0, sizeof (measurement));
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = testing_validate_array (extend1, measurement, sizeof (extend1));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
+static void pcr_test_compute_after_update (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	struct pcr_measurement entry;
+	uint8_t measurement[PCR_DIGEST_LENGTH];
+	uint8_t zero[PCR_DIGEST_LENGTH] = {0};
+	uint8_t digest0[PCR_DIGEST_LENGTH];
+	uint8_t digest1[PCR_DIGEST_LENGTH];
+	uint8_t digest2[PCR_DIGEST_LENGTH];
+	uint8_t new_digest[PCR_DIGEST_LENGTH];
+	uint8_t extend0[PCR_DIGEST_LENGTH];
+	uint8_t extend1[PCR_DIGEST_LENGTH];
+	uint8_t extend2[PCR_DIGEST_LENGTH];
+	uint8_t new_extend1[PCR_DIGEST_LENGTH];
+	uint8_t new_extend2[PCR_DIGEST_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (digest0, 0x11, sizeof (digest0));
+	memset (digest1, 0x22, sizeof (digest1));
+	memset (digest2, 0x33, sizeof (digest2));
+	memset (new_digest, 0x44, sizeof (new_digest));
+	memset (extend0, 0x55, sizeof (extend0));
+	memset (extend1, 0x66, sizeof (extend1));
+	memset (extend2, 0x77, sizeof (extend2));
+	memset (new_extend1, 0x88, sizeof (new_extend1));
+	memset (new_extend2, 0x99, sizeof (new_extend2));
+
+	setup_pcr_mock_test (test, &pcr, &hash, 3);
+
+	status = pcr_update_digest (&pcr, 0, digest0, sizeof (digest0));
+	status |= pcr_update_digest (&pcr, 1, digest1, sizeof (digest1));
+	status |= pcr_update_digest (&pcr, 2, digest2, sizeof (digest2));
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_testing_expect_extend (test, &hash, zero, digest0, extend0);
+	pcr_testing_expect_extend (test, &hash, extend0, digest1, extend1);
+	pcr_testing_expect_extend (test, &hash, extend1, digest2, extend2);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 3, status);
+
+	status = mock_validate (&hash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_update_digest (&pcr, 1, new_digest, sizeof (new_digest));
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_testing_expect_extend (test, &hash, extend0, new_digest, new_extend1);
+	pcr_testing_expect_extend (test, &hash, new_extend1, digest2, new_extend2);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 3, status);
+
+	status = testing_validate_array (new_extend2, measurement, sizeof (new_extend2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_get_measurement (&pcr, 0, &entry);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (extend0, entry.measurement, sizeof (extend0));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_get_measurement (&pcr, 1, &entry);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (new_extend1, entry.measurement, sizeof (new_extend1));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
+static void pcr_test_compute_after_update_same_digest (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	uint8_t measurement[PCR_DIGEST_LENGTH];
+	uint8_t zero[PCR_DIGEST_LENGTH] = {0};
+	uint8_t digest0[PCR_DIGEST_LENGTH];
+	uint8_t digest1[PCR_DIGEST_LENGTH];
+	uint8_t extend0[PCR_DIGEST_LENGTH];
+	uint8_t extend1[PCR_DIGEST_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (digest0, 0x11, sizeof (digest0));
+	memset (digest1, 0x22, sizeof (digest1));
+	memset (extend0, 0x33, sizeof (extend0));
+	memset (extend1, 0x44, sizeof (extend1));
+
+	setup_pcr_mock_test (test, &pcr, &hash, 2);
+
+	status = pcr_update_digest (&pcr, 0, digest0, sizeof (digest0));
+	status |= pcr_update_digest (&pcr, 1, digest1, sizeof (digest1));
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_testing_expect_extend (test, &hash, zero, digest0, extend0);
+	pcr_testing_expect_extend (test, &hash, extend0, digest1, extend1);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = mock_validate (&hash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_update_digest (&pcr, 0, digest0, sizeof (digest0));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_update_event_type (&pcr, 1, 0x0A);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = testing_validate_array (extend1, measurement, sizeof (extend1));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
+static void pcr_test_compute_after_update_buffer (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	uint8_t measurement[PCR_DIGEST_LENGTH];
+	uint8_t zero[PCR_DIGEST_LENGTH] = {0};
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t digest0[PCR_DIGEST_LENGTH];
+	uint8_t digest1[PCR_DIGEST_LENGTH];
+	uint8_t extend0[PCR_DIGEST_LENGTH];
+	uint8_t extend1[PCR_DIGEST_LENGTH];
+	uint8_t new_extend1[PCR_DIGEST_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (digest0, 0x11, sizeof (digest0));
+	memset (digest1, 0x22, sizeof (digest1));
+	memset (extend0, 0x33, sizeof (extend0));
+	memset (extend1, 0x44, sizeof (extend1));
+	memset (new_extend1, 0x55, sizeof (new_extend1));
+
+	setup_pcr_mock_test (test, &pcr, &hash, 2);
+
+	status = pcr_update_digest (&pcr, 0, digest0, sizeof (digest0));
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_testing_expect_extend (test, &hash, zero, digest0, extend0);
+	pcr_testing_expect_extend (test, &hash, extend0, zero, extend1);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = mock_validate (&hash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 2, digest1, sizeof (digest1), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_update_buffer (&pcr, &hash.base, 1, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_testing_expect_extend (test, &hash, extend0, digest1, new_extend1);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = testing_validate_array (new_extend1, measurement, sizeof (new_extend1));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
+static void pcr_test_compute_after_invalidate (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	uint8_t measurement[PCR_DIGEST_LENGTH];
+	uint8_t zero[PCR_DIGEST_LENGTH] = {0};
+	uint8_t digest0[PCR_DIGEST_LENGTH];
+	uint8_t digest1[PCR_DIGEST_LENGTH];
+	uint8_t extend0[PCR_DIGEST_LENGTH];
+	uint8_t extend1[PCR_DIGEST_LENGTH];
+	uint8_t new_extend1[PCR_DIGEST_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (digest0, 0x11, sizeof (digest0));
+	memset (digest1, 0x22, sizeof (digest1));
+	memset (extend0, 0x33, sizeof (extend0));
+	memset (extend1, 0x44, sizeof (extend1));
+	memset (new_extend1, 0x55, sizeof (new_extend1));
+
+	setup_pcr_mock_test (test, &pcr, &hash, 2);
+
+	status = pcr_update_digest (&pcr, 0, digest0, sizeof (digest0));
+	status |= pcr_update_digest (&pcr, 1, digest1, sizeof (digest1));
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_testing_expect_extend (test, &hash, zero, digest0, extend0);
+	pcr_testing_expect_extend (test, &hash, extend0, digest1, extend1);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = mock_validate (&hash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_invalidate_measurement_index (&pcr, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_testing_expect_extend (test, &hash, extend0, zero, new_extend1);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = testing_validate_array (new_extend1, measurement, sizeof (new_extend1));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
+static void pcr_test_compute_after_hash_fail (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	uint8_t measurement[PCR_DIGEST_LENGTH];
+	uint8_t zero[PCR_DIGEST_LENGTH] = {0};
+	uint8_t digest0[PCR_DIGEST_LENGTH];
+	uint8_t digest1[PCR_DIGEST_LENGTH];
+	uint8_t extend0[PCR_DIGEST_LENGTH];
+	uint8_t extend1[PCR_DIGEST_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (digest0, 0x11, sizeof (digest0));
+	memset (digest1, 0x22, sizeof (digest1));
+	memset (extend0, 0x33, sizeof (extend0));
+	memset (extend1, 0x44, sizeof (extend1));
+
+	setup_pcr_mock_test (test, &pcr, &hash, 2);
+
+	status = pcr_update_digest (&pcr, 0, digest0, sizeof (digest0));
+	status |= pcr_update_digest (&pcr, 1, digest1, sizeof (digest1));
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_testing_expect_extend (test, &hash, zero, digest0, extend0);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash,
+		HASH_ENGINE_START_SHA256_FAILED);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, HASH_ENGINE_START_SHA256_FAILED, status);
+
+	status = mock_validate (&hash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_testing_expect_extend (test, &hash, extend0, digest1, extend1);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = testing_validate_array (extend1, measurement, sizeof (extend1));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
 static void pcr_test_get_measurement (CuTest *test)
 {
 	struct pcr_bank pcr;
@@ -1367,6 +1719,52 @@ static void pcr_test_invalidate_measurement_index_bad_index (CuTest *test)
 	complete_pcr_mock_test (test, &pcr, &hash);
 }
 
+static void pcr_test_get_generation (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	uint8_t digest[PCR_DIGEST_LENGTH];
+	uint32_t generation;
+	int status;
+
+	TEST_START;
+
+	memset (digest, 0x11, sizeof (digest));
+
+	setup_pcr_mock_test (test, &pcr, &hash, 2);
+
+	generation = pcr_get_generation (&pcr);
+
+	status = pcr_update_digest (&pcr, 1, digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, generation + 1, pcr_get_generation (&pcr));
+
+	status = pcr_update_digest (&pcr, 1, digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, generation + 1, pcr_get_generation (&pcr));
+
+	status = pcr_update_event_type (&pcr, 0, 0x0A);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, generation + 2, pcr_get_generation (&pcr));
+
+	status = pcr_update_event_type (&pcr, 0, 0x0A);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, generation + 2, pcr_get_generation (&pcr));
+
+	status = pcr_invalidate_measurement_index (&pcr, 1);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, generation + 3, pcr_get_generation (&pcr));
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
+static void pcr_test_get_generation_null (CuTest *test)
+{
+	TEST_START;
+
+	CuAssertIntEquals (test, 0, pcr_get_generation (NULL));
+}
+
 
 CuSuite* get_pcr_suite ()
 {
@@ -1406,6 +1804,12 @@ CuSuite* get_pcr_suite ()
 	SUITE_ADD_TEST (suite, pcr_test_compute_hash_fail);
 	SUITE_ADD_TEST (suite, pcr_test_compute_extend_hash_fail);
 	SUITE_ADD_TEST (suite, pcr_test_compute_finish_hash_fail);
+	SUITE_ADD_TEST (suite, pcr_test_compute_no_changes);
+	SUITE_ADD_TEST (suite, pcr_test_compute_after_update);
+	SUITE_ADD_TEST (suite, pcr_test_compute_after_update_same_digest);
+	SUITE_ADD_TEST (suite, pcr_test_compute_after_update_buffer);
+	SUITE_ADD_TEST (suite, pcr_test_compute_after_invalidate);
+	SUITE_ADD_TEST (suite, pcr_test_compute_after_hash_fail);
 	SUITE_ADD_TEST (suite, pcr_test_get_measurement);
 	SUITE_ADD_TEST (suite, pcr_test_get_measurement_explicit);
 	SUITE_ADD_TEST (suite, pcr_test_get_measurement_invalid_arg);
@@ -1423,6 +1827,8 @@ CuSuite* get_pcr_suite ()
 	SUITE_ADD_TEST (suite, pcr_test_invalidate_measurement_index_explicit);
 	SUITE_ADD_TEST (suite, pcr_test_invalidate_measurement_index_null);
 	SUITE_ADD_TEST (suite, pcr_test_invalidate_measurement_index_bad_index);
+	SUITE_ADD_TEST (suite, pcr_test_get_generation);
+	SUITE_ADD_TEST (suite, pcr_test_get_generation_null);
 
 	return suite;
 }
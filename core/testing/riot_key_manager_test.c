@@ -9,6 +9,7 @@
 #include "riot/riot_key_manager.h"
 #include "mock/keystore_mock.h"
 #include "mock/x509_mock.h"
+#include "mock/riot_key_manager_observer_mock.h"
 #include "engines/x509_testing_engine.h"
 #include "engines/ecc_testing_engine.h"
 #include "riot_core_testing.h"
@@ -7153,6 +7154,311 @@ static void riot_key_manager_test_erase_all_certificates_intermediate_ca_error (
 	X509_TESTING_ENGINE_RELEASE (&x509);
 }
 
+static void riot_key_manager_test_verify_stored_certs_notify_observers (CuTest *test)
+{
+	X509_TESTING_ENGINE x509;
+	struct keystore_mock keystore;
+	struct riot_keys keys;
+	struct riot_key_manager manager;
+	struct riot_key_manager_observer_mock observer;
+	int status;
+	uint8_t *dev_id_der = NULL;
+	uint8_t *ca_der = NULL;
+	uint8_t *int_der = NULL;
+
+	TEST_START;
+
+	status = X509_TESTING_ENGINE_INIT (&x509);
+	CuAssertIntEquals (test, 0, status);
+
+	status = keystore_mock_init (&keystore);
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_observer_mock_init (&observer);
+	CuAssertIntEquals (test, 0, status);
+
+	riot_key_manager_testing_alloc_riot_core_keys (test, &keys);
+
+	status = mock_expect (&keystore.mock, keystore.base.load_key, &keystore, KEYSTORE_NO_KEY,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&keystore.mock, 1, &dev_id_der, sizeof (dev_id_der), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_init (&manager, &keystore.base, &keys, &x509.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&keystore.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_add_observer (&manager, &observer.base);
+	CuAssertIntEquals (test, 0, status);
+
+	dev_id_der = platform_malloc (RIOT_CORE_DEVID_SIGNED_CERT_LEN);
+	CuAssertPtrNotNull (test, dev_id_der);
+
+	ca_der = platform_malloc (X509_CERTSS_ECC_CA_NOPL_DER_LEN);
+	CuAssertPtrNotNull (test, ca_der);
+
+	memcpy (dev_id_der, RIOT_CORE_DEVID_SIGNED_CERT, RIOT_CORE_DEVID_SIGNED_CERT_LEN);
+	memcpy (ca_der, X509_CERTSS_ECC_CA_NOPL_DER, X509_CERTSS_ECC_CA_NOPL_DER_LEN);
+
+	status = mock_expect (&keystore.mock, keystore.base.load_key, &keystore, 0, MOCK_ARG (0),
+		MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&keystore.mock, 1, &dev_id_der, sizeof (dev_id_der), -1);
+	status |= mock_expect_output (&keystore.mock, 2, &RIOT_CORE_DEVID_SIGNED_CERT_LEN,
+		sizeof (RIOT_CORE_DEVID_SIGNED_CERT_LEN), -1);
+
+	status |= mock_expect (&keystore.mock, keystore.base.load_key, &keystore, 0, MOCK_ARG (1),
+		MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&keystore.mock, 1, &ca_der, sizeof (ca_der), -1);
+	status |= mock_expect_output (&keystore.mock, 2, &X509_CERTSS_ECC_CA_NOPL_DER_LEN,
+		sizeof (X509_CERTSS_ECC_CA_NOPL_DER_LEN), -1);
+
+	status |= mock_expect (&keystore.mock, keystore.base.load_key, &keystore, KEYSTORE_NO_KEY,
+		MOCK_ARG (2), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&keystore.mock, 1, &int_der, sizeof (int_der), -1);
+
+	status |= mock_expect (&observer.mock, observer.base.on_cert_chain_changed, &observer, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_verify_stored_certs (&manager);
+	CuAssertIntEquals (test, 0, status);
+
+	status = keystore_mock_validate_and_release (&keystore);
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_observer_mock_validate_and_release (&observer);
+	CuAssertIntEquals (test, 0, status);
+
+	riot_key_manager_release (&manager);
+
+	X509_TESTING_ENGINE_RELEASE (&x509);
+}
+
+static void riot_key_manager_test_verify_stored_certs_notify_observers_error (CuTest *test)
+{
+	X509_TESTING_ENGINE x509;
+	struct keystore_mock keystore;
+	struct riot_keys keys;
+	struct riot_key_manager manager;
+	struct riot_key_manager_observer_mock observer;
+	int status;
+	uint8_t *dev_id_der = NULL;
+
+	TEST_START;
+
+	status = X509_TESTING_ENGINE_INIT (&x509);
+	CuAssertIntEquals (test, 0, status);
+
+	status = keystore_mock_init (&keystore);
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_observer_mock_init (&observer);
+	CuAssertIntEquals (test, 0, status);
+
+	riot_key_manager_testing_alloc_riot_core_keys (test, &keys);
+
+	status = mock_expect (&keystore.mock, keystore.base.load_key, &keystore, KEYSTORE_NO_KEY,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&keystore.mock, 1, &dev_id_der, sizeof (dev_id_der), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_init (&manager, &keystore.base, &keys, &x509.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&keystore.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_add_observer (&manager, &observer.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&keystore.mock, keystore.base.load_key, &keystore, KEYSTORE_NO_KEY,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&keystore.mock, 1, &dev_id_der, sizeof (dev_id_der), -1);
+
+	status |= mock_expect (&observer.mock, observer.base.on_cert_chain_changed, &observer, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_verify_stored_certs (&manager);
+	CuAssertIntEquals (test, RIOT_KEY_MANAGER_NO_SIGNED_DEVICE_ID, status);
+
+	status = keystore_mock_validate_and_release (&keystore);
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_observer_mock_validate_and_release (&observer);
+	CuAssertIntEquals (test, 0, status);
+
+	riot_key_manager_release (&manager);
+
+	X509_TESTING_ENGINE_RELEASE (&x509);
+}
+
+static void riot_key_manager_test_remove_observer (CuTest *test)
+{
+	X509_TESTING_ENGINE x509;
+	struct keystore_mock keystore;
+	struct riot_keys keys;
+	struct riot_key_manager manager;
+	struct riot_key_manager_observer_mock observer;
+	int status;
+	uint8_t *dev_id_der = NULL;
+
+	TEST_START;
+
+	status = X509_TESTING_ENGINE_INIT (&x509);
+	CuAssertIntEquals (test, 0, status);
+
+	status = keystore_mock_init (&keystore);
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_observer_mock_init (&observer);
+	CuAssertIntEquals (test, 0, status);
+
+	riot_key_manager_testing_alloc_riot_core_keys (test, &keys);
+
+	status = mock_expect (&keystore.mock, keystore.base.load_key, &keystore, KEYSTORE_NO_KEY,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&keystore.mock, 1, &dev_id_der, sizeof (dev_id_der), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_init (&manager, &keystore.base, &keys, &x509.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&keystore.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_add_observer (&manager, &observer.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_remove_observer (&manager, &observer.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&keystore.mock, keystore.base.load_key, &keystore, KEYSTORE_NO_KEY,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&keystore.mock, 1, &dev_id_der, sizeof (dev_id_der), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_verify_stored_certs (&manager);
+	CuAssertIntEquals (test, RIOT_KEY_MANAGER_NO_SIGNED_DEVICE_ID, status);
+
+	status = keystore_mock_validate_and_release (&keystore);
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_observer_mock_validate_and_release (&observer);
+	CuAssertIntEquals (test, 0, status);
+
+	riot_key_manager_release (&manager);
+
+	X509_TESTING_ENGINE_RELEASE (&x509);
+}
+
+static void riot_key_manager_test_add_observer_null (CuTest *test)
+{
+	X509_TESTING_ENGINE x509;
+	struct keystore_mock keystore;
+	struct riot_keys keys;
+	struct riot_key_manager manager;
+	struct riot_key_manager_observer_mock observer;
+	int status;
+	uint8_t *dev_id_der = NULL;
+
+	TEST_START;
+
+	status = X509_TESTING_ENGINE_INIT (&x509);
+	CuAssertIntEquals (test, 0, status);
+
+	status = keystore_mock_init (&keystore);
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_observer_mock_init (&observer);
+	CuAssertIntEquals (test, 0, status);
+
+	riot_key_manager_testing_alloc_riot_core_keys (test, &keys);
+
+	status = mock_expect (&keystore.mock, keystore.base.load_key, &keystore, KEYSTORE_NO_KEY,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&keystore.mock, 1, &dev_id_der, sizeof (dev_id_der), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_init (&manager, &keystore.base, &keys, &x509.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_add_observer (NULL, &observer.base);
+	CuAssertIntEquals (test, RIOT_KEY_MANAGER_INVALID_ARGUMENT, status);
+
+	status = riot_key_manager_add_observer (&manager, NULL);
+	CuAssertIntEquals (test, OBSERVABLE_INVALID_ARGUMENT, status);
+
+	status = keystore_mock_validate_and_release (&keystore);
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_observer_mock_validate_and_release (&observer);
+	CuAssertIntEquals (test, 0, status);
+
+	riot_key_manager_release (&manager);
+
+	X509_TESTING_ENGINE_RELEASE (&x509);
+}
+
+static void riot_key_manager_test_remove_observer_null (CuTest *test)
+{
+	X509_TESTING_ENGINE x509;
+	struct keystore_mock keystore;
+	struct riot_keys keys;
+	struct riot_key_manager manager;
+	struct riot_key_manager_observer_mock observer;
+	int status;
+	uint8_t *dev_id_der = NULL;
+
+	TEST_START;
+
+	status = X509_TESTING_ENGINE_INIT (&x509);
+	CuAssertIntEquals (test, 0, status);
+
+	status = keystore_mock_init (&keystore);
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_observer_mock_init (&observer);
+	CuAssertIntEquals (test, 0, status);
+
+	riot_key_manager_testing_alloc_riot_core_keys (test, &keys);
+
+	status = mock_expect (&keystore.mock, keystore.base.load_key, &keystore, KEYSTORE_NO_KEY,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&keystore.mock, 1, &dev_id_der, sizeof (dev_id_der), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_init (&manager, &keystore.base, &keys, &x509.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_add_observer (&manager, &observer.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_remove_observer (NULL, &observer.base);
+	CuAssertIntEquals (test, RIOT_KEY_MANAGER_INVALID_ARGUMENT, status);
+
+	status = riot_key_manager_remove_observer (&manager, NULL);
+	CuAssertIntEquals (test, OBSERVABLE_INVALID_ARGUMENT, status);
+
+	status = keystore_mock_validate_and_release (&keystore);
+	CuAssertIntEquals (test, 0, status);
+
+	status = riot_key_manager_observer_mock_validate_and_release (&observer);
+	CuAssertIntEquals (test, 0, status);
+
+	riot_key_manager_release (&manager);
+
+	X509_TESTING_ENGINE_RELEASE (&x509);
+}
+
 
 CuSuite* get_riot_key_manager_suite ()
 {
@@ -7240,6 +7546,11 @@ CuSuite* get_riot_key_manager_suite ()
 	SUITE_ADD_TEST (suite, riot_key_manager_test_erase_all_certificates_device_id_error);
 	SUITE_ADD_TEST (suite, riot_key_manager_test_erase_all_certificates_root_ca_error);
 	SUITE_ADD_TEST (suite, riot_key_manager_test_erase_all_certificates_intermediate_ca_error);
+	SUITE_ADD_TEST (suite, riot_key_manager_test_verify_stored_certs_notify_observers);
+	SUITE_ADD_TEST (suite, riot_key_manager_test_verify_stored_certs_notify_observers_error);
+	SUITE_ADD_TEST (suite, riot_key_manager_test_remove_observer);
+	SUITE_ADD_TEST (suite, riot_key_manager_test_add_observer_null);
+	SUITE_ADD_TEST (suite, riot_key_manager_test_remove_observer_null);
 
 	return suite;
 }
@@ -0,0 +1,763 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "crypto/rng_buffered.h"
+#include "mock/rng_mock.h"
+
+
+static const char *SUITE = "rng_buffered";
+
+
+/**
+ * Fill a buffer with a known pattern to use as random data.
+ *
+ * @param data The buffer to fill.
+ * @param length Length of the buffer.
+ * @param start The value for the first byte in the buffer.
+ */
+static void rng_buffered_testing_fill_pattern (uint8_t *data, size_t length, uint8_t start)
+{
+	size_t i;
+
+	for (i = 0; i < length; i++) {
+		data[i] = start + i;
+	}
+}
+
+/**
+ * Set up the expectation for a block of random data to be generated.
+ *
+ * @param test The testing framework.
+ * @param rng The mock for the source RNG.
+ * @param block The random data that will be generated.
+ */
+static void rng_buffered_testing_expect_block (CuTest *test, struct rng_engine_mock *rng,
+	uint8_t *block)
+{
+	int status;
+
+	status = mock_expect (&rng->mock, rng->base.generate_random_buffer, rng, 0,
+		MOCK_ARG (RNG_BUFFERED_BLOCK_SIZE), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&rng->mock, 1, block, RNG_BUFFERED_BLOCK_SIZE, -1);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Check that a region of the random buffer has been erased.
+ *
+ * @param test The testing framework.
+ * @param engine The buffered RNG to check.
+ * @param length The number of bytes from the start of the buffer that should be erased.
+ */
+static void rng_buffered_testing_check_erased (CuTest *test, struct rng_engine_buffered *engine,
+	size_t length)
+{
+	size_t i;
+
+	for (i = 0; i < length; i++) {
+		CuAssertIntEquals (test, 0, engine->buffer[i]);
+	}
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void rng_buffered_test_init (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	int status;
+
+	TEST_START;
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_init (&engine, &rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, engine.base.generate_random_buffer);
+	CuAssertPtrNotNull (test, engine.base.reseed);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_release (&engine);
+}
+
+static void rng_buffered_test_init_null (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	int status;
+
+	TEST_START;
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_init (NULL, &rng.base);
+	CuAssertIntEquals (test, RNG_ENGINE_INVALID_ARGUMENT, status);
+
+	status = rng_buffered_init (&engine, NULL);
+	CuAssertIntEquals (test, RNG_ENGINE_INVALID_ARGUMENT, status);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void rng_buffered_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	rng_buffered_release (NULL);
+}
+
+static void rng_buffered_test_generate_random_buffer (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	uint8_t block[RNG_BUFFERED_BLOCK_SIZE];
+	uint8_t buffer[16];
+	uint8_t buffer2[16];
+	int status;
+
+	TEST_START;
+
+	rng_buffered_testing_fill_pattern (block, sizeof (block), 1);
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_init (&engine, &rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_testing_expect_block (test, &rng, block);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer), buffer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (block, buffer, sizeof (buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer2), buffer2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (&block[sizeof (buffer)], buffer2, sizeof (buffer2));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, RNG_BUFFERED_BLOCK_SIZE - 32, engine.available);
+	rng_buffered_testing_check_erased (test, &engine, 32);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_release (&engine);
+}
+
+static void rng_buffered_test_generate_random_buffer_multiple_blocks (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	uint8_t block[RNG_BUFFERED_BLOCK_SIZE];
+	uint8_t block2[RNG_BUFFERED_BLOCK_SIZE];
+	uint8_t buffer[RNG_BUFFERED_BLOCK_SIZE - 8];
+	uint8_t buffer2[16];
+	int status;
+
+	TEST_START;
+
+	rng_buffered_testing_fill_pattern (block, sizeof (block), 1);
+	rng_buffered_testing_fill_pattern (block2, sizeof (block2), 0x80);
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_init (&engine, &rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_testing_expect_block (test, &rng, block);
+	rng_buffered_testing_expect_block (test, &rng, block2);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer), buffer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (block, buffer, sizeof (buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer2), buffer2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (&block[sizeof (buffer)], buffer2, 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (block2, &buffer2[8], 8);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, RNG_BUFFERED_BLOCK_SIZE - 8, engine.available);
+	rng_buffered_testing_check_erased (test, &engine, 8);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_release (&engine);
+}
+
+static void rng_buffered_test_generate_random_buffer_large_request (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	uint8_t buffer[RNG_BUFFERED_BLOCK_SIZE + 16];
+	int status;
+
+	TEST_START;
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_init (&engine, &rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0,
+		MOCK_ARG (sizeof (buffer)), MOCK_ARG (buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer), buffer);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, engine.available);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_release (&engine);
+}
+
+static void rng_buffered_test_generate_random_buffer_large_request_partial_block (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	uint8_t block[RNG_BUFFERED_BLOCK_SIZE];
+	uint8_t block2[RNG_BUFFERED_BLOCK_SIZE];
+	uint8_t buffer[16];
+	uint8_t buffer2[RNG_BUFFERED_BLOCK_SIZE + 16];
+	int status;
+
+	TEST_START;
+
+	rng_buffered_testing_fill_pattern (block, sizeof (block), 1);
+	rng_buffered_testing_fill_pattern (block2, sizeof (block2), 0x80);
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_init (&engine, &rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_testing_expect_block (test, &rng, block);
+	rng_buffered_testing_expect_block (test, &rng, block2);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer), buffer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer2), buffer2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (&block[sizeof (buffer)], buffer2,
+		RNG_BUFFERED_BLOCK_SIZE - 16);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (block2, &buffer2[RNG_BUFFERED_BLOCK_SIZE - 16], 32);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, RNG_BUFFERED_BLOCK_SIZE - 32, engine.available);
+	rng_buffered_testing_check_erased (test, &engine, 32);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_release (&engine);
+}
+
+static void rng_buffered_test_generate_random_buffer_null (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	uint8_t buffer[16];
+	int status;
+
+	TEST_START;
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_init (&engine, &rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.generate_random_buffer (NULL, sizeof (buffer), buffer);
+	CuAssertIntEquals (test, RNG_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer), NULL);
+	CuAssertIntEquals (test, RNG_ENGINE_INVALID_ARGUMENT, status);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_release (&engine);
+}
+
+static void rng_buffered_test_generate_random_buffer_error (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	uint8_t block[RNG_BUFFERED_BLOCK_SIZE];
+	uint8_t buffer[16];
+	int status;
+
+	TEST_START;
+
+	rng_buffered_testing_fill_pattern (block, sizeof (block), 1);
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_init (&engine, &rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng,
+		RNG_ENGINE_RANDOM_FAILED, MOCK_ARG (RNG_BUFFERED_BLOCK_SIZE), MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer), buffer);
+	CuAssertIntEquals (test, RNG_ENGINE_RANDOM_FAILED, status);
+
+	CuAssertIntEquals (test, 0, engine.available);
+
+	rng_buffered_testing_expect_block (test, &rng, block);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer), buffer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (block, buffer, sizeof (buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_release (&engine);
+}
+
+static void rng_buffered_test_refill (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	uint8_t block[RNG_BUFFERED_BLOCK_SIZE];
+	uint8_t buffer[16];
+	int status;
+
+	TEST_START;
+
+	rng_buffered_testing_fill_pattern (block, sizeof (block), 1);
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_init (&engine, &rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_testing_expect_block (test, &rng, block);
+
+	status = rng_buffered_refill (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, RNG_BUFFERED_BLOCK_SIZE, engine.available);
+
+	status = rng_buffered_refill (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer), buffer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (block, buffer, sizeof (buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_release (&engine);
+}
+
+static void rng_buffered_test_refill_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = rng_buffered_refill (NULL);
+	CuAssertIntEquals (test, RNG_ENGINE_INVALID_ARGUMENT, status);
+}
+
+static void rng_buffered_test_refill_error (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	int status;
+
+	TEST_START;
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_init (&engine, &rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng,
+		RNG_ENGINE_RANDOM_FAILED, MOCK_ARG (RNG_BUFFERED_BLOCK_SIZE), MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_refill (&engine);
+	CuAssertIntEquals (test, RNG_ENGINE_RANDOM_FAILED, status);
+
+	CuAssertIntEquals (test, 0, engine.available);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_release (&engine);
+}
+
+static void rng_buffered_test_reseed (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	uint8_t block[RNG_BUFFERED_BLOCK_SIZE];
+	uint8_t block2[RNG_BUFFERED_BLOCK_SIZE];
+	uint8_t buffer[16];
+	int status;
+
+	TEST_START;
+
+	rng_buffered_testing_fill_pattern (block, sizeof (block), 1);
+	rng_buffered_testing_fill_pattern (block2, sizeof (block2), 0x80);
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_init (&engine, &rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_testing_expect_block (test, &rng, block);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer), buffer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&rng.mock, rng.base.reseed, &rng, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.reseed (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, engine.available);
+	rng_buffered_testing_check_erased (test, &engine, RNG_BUFFERED_BLOCK_SIZE);
+
+	rng_buffered_testing_expect_block (test, &rng, block2);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer), buffer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (block2, buffer, sizeof (buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_release (&engine);
+}
+
+static void rng_buffered_test_reseed_no_source_reseed (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	uint8_t block[RNG_BUFFERED_BLOCK_SIZE];
+	uint8_t buffer[16];
+	int status;
+
+	TEST_START;
+
+	rng_buffered_testing_fill_pattern (block, sizeof (block), 1);
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng.base.reseed = NULL;
+
+	status = rng_buffered_init (&engine, &rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_testing_expect_block (test, &rng, block);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer), buffer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.reseed (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, engine.available);
+	rng_buffered_testing_check_erased (test, &engine, RNG_BUFFERED_BLOCK_SIZE);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_release (&engine);
+}
+
+static void rng_buffered_test_reseed_null (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	int status;
+
+	TEST_START;
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_init (&engine, &rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.reseed (NULL);
+	CuAssertIntEquals (test, RNG_ENGINE_INVALID_ARGUMENT, status);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_release (&engine);
+}
+
+static void rng_buffered_test_reseed_error (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	int status;
+
+	TEST_START;
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_init (&engine, &rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&rng.mock, rng.base.reseed, &rng, RNG_ENGINE_RESEED_FAILED);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.reseed (&engine.base);
+	CuAssertIntEquals (test, RNG_ENGINE_RESEED_FAILED, status);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_release (&engine);
+}
+
+static void rng_buffered_test_prediction_resistance (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	uint8_t block[RNG_BUFFERED_BLOCK_SIZE];
+	uint8_t buffer[16];
+	int status;
+
+	TEST_START;
+
+	rng_buffered_testing_fill_pattern (block, sizeof (block), 1);
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_init (&engine, &rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_testing_expect_block (test, &rng, block);
+
+	status = rng_buffered_refill (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_set_prediction_resistance (&engine, true);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, engine.available);
+	rng_buffered_testing_check_erased (test, &engine, RNG_BUFFERED_BLOCK_SIZE);
+
+	status = mock_expect (&rng.mock, rng.base.reseed, &rng, 0);
+	status |= mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0,
+		MOCK_ARG (sizeof (buffer)), MOCK_ARG (buffer));
+	status |= mock_expect (&rng.mock, rng.base.reseed, &rng, 0);
+	status |= mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0,
+		MOCK_ARG (sizeof (buffer)), MOCK_ARG (buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer), buffer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer), buffer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_refill (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, engine.available);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_release (&engine);
+}
+
+static void rng_buffered_test_prediction_resistance_no_source_reseed (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	uint8_t buffer[16];
+	int status;
+
+	TEST_START;
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng.base.reseed = NULL;
+
+	status = rng_buffered_init (&engine, &rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_set_prediction_resistance (&engine, true);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&rng.mock, rng.base.generate_random_buffer, &rng, 0,
+		MOCK_ARG (sizeof (buffer)), MOCK_ARG (buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer), buffer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_release (&engine);
+}
+
+static void rng_buffered_test_prediction_resistance_reseed_error (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	uint8_t buffer[16];
+	int status;
+
+	TEST_START;
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_init (&engine, &rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_set_prediction_resistance (&engine, true);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&rng.mock, rng.base.reseed, &rng, RNG_ENGINE_RESEED_FAILED);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer), buffer);
+	CuAssertIntEquals (test, RNG_ENGINE_RESEED_FAILED, status);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_release (&engine);
+}
+
+static void rng_buffered_test_prediction_resistance_disable (CuTest *test)
+{
+	struct rng_engine_mock rng;
+	struct rng_engine_buffered engine;
+	uint8_t block[RNG_BUFFERED_BLOCK_SIZE];
+	uint8_t buffer[16];
+	int status;
+
+	TEST_START;
+
+	rng_buffered_testing_fill_pattern (block, sizeof (block), 1);
+
+	status = rng_mock_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_init (&engine, &rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_set_prediction_resistance (&engine, true);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_buffered_set_prediction_resistance (&engine, false);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_testing_expect_block (test, &rng, block);
+
+	status = engine.base.generate_random_buffer (&engine.base, sizeof (buffer), buffer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (block, buffer, sizeof (buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_mock_validate_and_release (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_buffered_release (&engine);
+}
+
+static void rng_buffered_test_set_prediction_resistance_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = rng_buffered_set_prediction_resistance (NULL, true);
+	CuAssertIntEquals (test, RNG_ENGINE_INVALID_ARGUMENT, status);
+}
+
+
+CuSuite* get_rng_buffered_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, rng_buffered_test_init);
+	SUITE_ADD_TEST (suite, rng_buffered_test_init_null);
+	SUITE_ADD_TEST (suite, rng_buffered_test_release_null);
+	SUITE_ADD_TEST (suite, rng_buffered_test_generate_random_buffer);
+	SUITE_ADD_TEST (suite, rng_buffered_test_generate_random_buffer_multiple_blocks);
+	SUITE_ADD_TEST (suite, rng_buffered_test_generate_random_buffer_large_request);
+	SUITE_ADD_TEST (suite, rng_buffered_test_generate_random_buffer_large_request_partial_block);
+	SUITE_ADD_TEST (suite, rng_buffered_test_generate_random_buffer_null);
+	SUITE_ADD_TEST (suite, rng_buffered_test_generate_random_buffer_error);
+	SUITE_ADD_TEST (suite, rng_buffered_test_refill);
+	SUITE_ADD_TEST (suite, rng_buffered_test_refill_null);
+	SUITE_ADD_TEST (suite, rng_buffered_test_refill_error);
+	SUITE_ADD_TEST (suite, rng_buffered_test_reseed);
+	SUITE_ADD_TEST (suite, rng_buffered_test_reseed_no_source_reseed);
+	SUITE_ADD_TEST (suite, rng_buffered_test_reseed_null);
+	SUITE_ADD_TEST (suite, rng_buffered_test_reseed_error);
+	SUITE_ADD_TEST (suite, rng_buffered_test_prediction_resistance);
+	SUITE_ADD_TEST (suite, rng_buffered_test_prediction_resistance_no_source_reseed);
+	SUITE_ADD_TEST (suite, rng_buffered_test_prediction_resistance_reseed_error);
+	SUITE_ADD_TEST (suite, rng_buffered_test_prediction_resistance_disable);
+	SUITE_ADD_TEST (suite, rng_buffered_test_set_prediction_resistance_null);
+
+	return suite;
+}
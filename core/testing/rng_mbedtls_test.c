@@ -27,6 +27,7 @@ static void rng_mbedtls_test_init (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 
 	CuAssertPtrNotNull (test, engine.base.generate_random_buffer);
+	CuAssertPtrNotNull (test, engine.base.reseed);
 
 	rng_mbedtls_release (&engine);
 }
@@ -125,6 +126,78 @@ static void rng_mbedtls_test_generate_random_buffer_null (CuTest *test)
 	rng_mbedtls_release (&engine);
 }
 
+static void rng_mbedtls_test_reseed (CuTest *test)
+{
+	struct rng_engine_mbedtls engine;
+	uint8_t buffer[32];
+	int status;
+
+	TEST_START;
+
+	status = rng_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.reseed (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.generate_random_buffer (&engine.base, 32, buffer);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_mbedtls_release (&engine);
+}
+
+static void rng_mbedtls_test_reseed_null (CuTest *test)
+{
+	struct rng_engine_mbedtls engine;
+	int status;
+
+	TEST_START;
+
+	status = rng_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.reseed (NULL);
+	CuAssertIntEquals (test, RNG_ENGINE_INVALID_ARGUMENT, status);
+
+	rng_mbedtls_release (&engine);
+}
+
+static void rng_mbedtls_test_prediction_resistance (CuTest *test)
+{
+	struct rng_engine_mbedtls engine;
+	uint8_t buffer[32];
+	int status;
+
+	TEST_START;
+
+	status = rng_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_mbedtls_set_prediction_resistance (&engine, true);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.generate_random_buffer (&engine.base, 32, buffer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = rng_mbedtls_set_prediction_resistance (&engine, false);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.generate_random_buffer (&engine.base, 32, buffer);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_mbedtls_release (&engine);
+}
+
+static void rng_mbedtls_test_set_prediction_resistance_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = rng_mbedtls_set_prediction_resistance (NULL, true);
+	CuAssertIntEquals (test, RNG_ENGINE_INVALID_ARGUMENT, status);
+}
+
 
 CuSuite* get_rng_mbedtls_suite ()
 {
@@ -137,6 +210,10 @@ CuSuite* get_rng_mbedtls_suite ()
 	SUITE_ADD_TEST (suite, rng_mbedtls_test_generate_random_buffer);
 	SUITE_ADD_TEST (suite, rng_mbedtls_test_generate_random_buffer_twice);
 	SUITE_ADD_TEST (suite, rng_mbedtls_test_generate_random_buffer_null);
+	SUITE_ADD_TEST (suite, rng_mbedtls_test_reseed);
+	SUITE_ADD_TEST (suite, rng_mbedtls_test_reseed_null);
+	SUITE_ADD_TEST (suite, rng_mbedtls_test_prediction_resistance);
+	SUITE_ADD_TEST (suite, rng_mbedtls_test_set_prediction_resistance_null);
 
 	return suite;
 }
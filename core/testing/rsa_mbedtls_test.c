@@ -214,6 +214,174 @@ static void rsa_mbedtls_test_sig_verify_bad_signature (CuTest *test)
 	rsa_mbedtls_release (&engine);
 }
 
+static void rsa_mbedtls_test_sig_verify_cached_key (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	int cached;
+	int i;
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST2,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST2, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_NOPE,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	cached = 0;
+	for (i = 0; i < RSA_MBEDTLS_KEY_CACHE_SIZE; i++) {
+		if (engine.key_cache[i].valid) {
+			cached++;
+			CuAssertTrue (test, rsa_same_public_key (&RSA_PUBLIC_KEY, &engine.key_cache[i].key));
+		}
+	}
+	CuAssertIntEquals (test, 1, cached);
+
+	rsa_mbedtls_release (&engine);
+}
+
+static void rsa_mbedtls_test_sig_verify_multiple_keys (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	int i;
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 2; i++) {
+		status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+			RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+		CuAssertIntEquals (test, 0, status);
+
+		status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY2, RSA_SIGNATURE2_TEST,
+			RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+		CuAssertIntEquals (test, 0, status);
+
+		status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY3, RSA_SIGNATURE3_TEST,
+			RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+		CuAssertIntEquals (test, 0, status);
+
+		status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY2, RSA_SIGNATURE_TEST,
+			RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+		CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+	}
+
+	rsa_mbedtls_release (&engine);
+}
+
+static void rsa_mbedtls_test_sig_verify_cache_evict_least_recent (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	struct rsa_public_key key[RSA_MBEDTLS_KEY_CACHE_SIZE];
+	bool found_key;
+	bool found_evicted;
+	int i;
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Use the same modulus with different exponents to generate unique keys. */
+	for (i = 0; i < RSA_MBEDTLS_KEY_CACHE_SIZE; i++) {
+		memcpy (&key[i], &RSA_PUBLIC_KEY, sizeof (key[i]));
+		key[i].exponent = 3 + (i * 2);
+	}
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < (RSA_MBEDTLS_KEY_CACHE_SIZE - 1); i++) {
+		status = engine.base.sig_verify (&engine.base, &key[i], RSA_SIGNATURE_TEST,
+			RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+		CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+	}
+
+	/* Use the first key again so the oldest key is the first of the generated keys. */
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &key[RSA_MBEDTLS_KEY_CACHE_SIZE - 1], RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	found_key = false;
+	found_evicted = false;
+	for (i = 0; i < RSA_MBEDTLS_KEY_CACHE_SIZE; i++) {
+		CuAssertTrue (test, engine.key_cache[i].valid);
+
+		if (rsa_same_public_key (&RSA_PUBLIC_KEY, &engine.key_cache[i].key)) {
+			found_key = true;
+		}
+		if (rsa_same_public_key (&key[0], &engine.key_cache[i].key)) {
+			found_evicted = true;
+		}
+	}
+	CuAssertIntEquals (test, true, found_key);
+	CuAssertIntEquals (test, false, found_evicted);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	rsa_mbedtls_release (&engine);
+}
+
+static void rsa_mbedtls_test_flush_key_cache (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	int i;
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY2, RSA_SIGNATURE2_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	rsa_mbedtls_flush_key_cache (&engine);
+
+	for (i = 0; i < RSA_MBEDTLS_KEY_CACHE_SIZE; i++) {
+		CuAssertTrue (test, !engine.key_cache[i].valid);
+	}
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	rsa_mbedtls_release (&engine);
+}
+
+static void rsa_mbedtls_test_flush_key_cache_null (CuTest *test)
+{
+	TEST_START;
+
+	rsa_mbedtls_flush_key_cache (NULL);
+}
+
 static void rsa_mbedtls_test_init_private_key (CuTest *test)
 {
 	struct rsa_engine_mbedtls engine;
@@ -971,6 +1139,11 @@ CuSuite* get_rsa_mbedtls_suite ()
 	SUITE_ADD_TEST (suite, rsa_mbedtls_test_sig_verify_null);
 	SUITE_ADD_TEST (suite, rsa_mbedtls_test_sig_verify_no_match);
 	SUITE_ADD_TEST (suite, rsa_mbedtls_test_sig_verify_bad_signature);
+	SUITE_ADD_TEST (suite, rsa_mbedtls_test_sig_verify_cached_key);
+	SUITE_ADD_TEST (suite, rsa_mbedtls_test_sig_verify_multiple_keys);
+	SUITE_ADD_TEST (suite, rsa_mbedtls_test_sig_verify_cache_evict_least_recent);
+	SUITE_ADD_TEST (suite, rsa_mbedtls_test_flush_key_cache);
+	SUITE_ADD_TEST (suite, rsa_mbedtls_test_flush_key_cache_null);
 	SUITE_ADD_TEST (suite, rsa_mbedtls_test_init_private_key);
 	SUITE_ADD_TEST (suite, rsa_mbedtls_test_init_private_key_null);
 	SUITE_ADD_TEST (suite, rsa_mbedtls_test_init_private_key_with_public_key);
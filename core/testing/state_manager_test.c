@@ -4426,6 +4426,141 @@ static void state_manager_test_store_non_volatile_state_same_state_bit_error_on_
 	state_manager_release (&manager);
 }
 
+static void state_manager_test_has_pending_non_volatile_state (CuTest *test)
+{
+	struct flash_mock flash;
+	struct state_manager manager;
+	int status;
+	uint16_t state[4] = {0xff82, 0xff82, 0xff82, 0};
+	uint16_t end[4] = {0xffff, 0xffff, 0xffff, 0xffff};
+	uint16_t expected[4] = {0xff83, 0xff83, 0xff83, 0};
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG(8));
+	status |= mock_expect_output (&flash.mock, 1, state, sizeof (state), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x11000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG(8));
+	status |= mock_expect_output (&flash.mock, 1, end, sizeof (end), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG(8));
+	status |= mock_expect_output (&flash.mock, 1, state, sizeof (state), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10008),
+		MOCK_ARG_NOT_NULL, MOCK_ARG(8));
+	status |= mock_expect_output (&flash.mock, 1, end, sizeof (end), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_manager_init (&manager, &flash.base, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Checking for pending state must not access flash. */
+	CuAssertIntEquals (test, false, state_manager_has_pending_non_volatile_state (&manager));
+
+	manager.nv_state = 0xffc3;
+	CuAssertIntEquals (test, true, state_manager_has_pending_non_volatile_state (&manager));
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.write, &flash, sizeof (expected),
+		MOCK_ARG (0x10008), MOCK_ARG_PTR_CONTAINS (&expected, sizeof (expected)),
+		MOCK_ARG (sizeof (expected)));
+
+	status |= flash_mock_expect_erase_flash_sector_verify (&flash, 0x11000, 0x1000);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_manager_store_non_volatile_state (&manager);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, state_manager_has_pending_non_volatile_state (&manager));
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	state_manager_release (&manager);
+}
+
+static void state_manager_test_has_pending_non_volatile_state_write_error (CuTest *test)
+{
+	struct flash_mock flash;
+	struct state_manager manager;
+	int status;
+	uint16_t state[4] = {0xffff, 0xffff, 0xffff, 0xffff};
+	uint16_t expected[4] = {0xffbe, 0xffbe, 0xffbe, 0};
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG(8));
+	status |= mock_expect_output (&flash.mock, 1, state, sizeof (state), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x11000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG(8));
+	status |= mock_expect_output (&flash.mock, 1, state, sizeof (state), 2);
+
+	status |= flash_mock_expect_erase_flash_sector_verify (&flash, 0x10000, 0x1000);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_manager_init (&manager, &flash.base, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.write, &flash, FLASH_WRITE_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (&expected, sizeof (expected)),
+		MOCK_ARG (sizeof (expected)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	manager.nv_state = 0xfffe;
+
+	status = state_manager_store_non_volatile_state (&manager);
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+
+	/* The state was not stored, so it is still pending. */
+	CuAssertIntEquals (test, true, state_manager_has_pending_non_volatile_state (&manager));
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	state_manager_release (&manager);
+}
+
+static void state_manager_test_has_pending_non_volatile_state_null (CuTest *test)
+{
+	TEST_START;
+
+	CuAssertIntEquals (test, false, state_manager_has_pending_non_volatile_state (NULL));
+}
+
 static void state_manager_test_store_non_volatile_state_null (CuTest *test)
 {
 	int status;
@@ -5418,6 +5553,9 @@ CuSuite* get_state_manager_suite ()
 	SUITE_ADD_TEST (suite, state_manager_test_store_non_volatile_state_same_state_read_error);
 	SUITE_ADD_TEST (suite, state_manager_test_store_non_volatile_state_after_blocking);
 	SUITE_ADD_TEST (suite, state_manager_test_block_non_volatile_state_storage_null);
+	SUITE_ADD_TEST (suite, state_manager_test_has_pending_non_volatile_state);
+	SUITE_ADD_TEST (suite, state_manager_test_has_pending_non_volatile_state_write_error);
+	SUITE_ADD_TEST (suite, state_manager_test_has_pending_non_volatile_state_null);
 
 	return suite;
 }
@@ -0,0 +1,511 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "platform.h"
+#include "testing.h"
+#include "logging/trace_buffer.h"
+#include "logging/logging.h"
+
+
+static const char *SUITE = "trace_buffer";
+
+
+/**
+ * Timestamp source for testing that counts up by one for each record.
+ */
+static uint32_t trace_buffer_testing_timestamp_value;
+
+/**
+ * Get a timestamp for a trace record.
+ *
+ * @return The next timestamp value.
+ */
+static uint32_t trace_buffer_testing_timestamp (void)
+{
+	return trace_buffer_testing_timestamp_value++;
+}
+
+/**
+ * Check the contents of a trace record.
+ *
+ * @param test The testing framework.
+ * @param record The record to check.
+ * @param timestamp The expected timestamp.
+ * @param event The expected event ID.
+ * @param phase The expected record type.
+ * @param arg1 The expected first argument.
+ * @param arg2 The expected second argument.
+ */
+static void trace_buffer_testing_check_record (CuTest *test, struct trace_record *record,
+	uint32_t timestamp, uint16_t event, uint8_t phase, uint32_t arg1, uint32_t arg2)
+{
+	CuAssertIntEquals (test, timestamp, record->timestamp);
+	CuAssertIntEquals (test, event, record->event);
+	CuAssertIntEquals (test, phase, record->phase);
+	CuAssertIntEquals (test, 0, record->core);
+	CuAssertIntEquals (test, arg1, record->arg1);
+	CuAssertIntEquals (test, arg2, record->arg2);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void trace_buffer_test_init (CuTest *test)
+{
+	struct trace_record records[4];
+	struct trace_buffer trace;
+	int status;
+
+	TEST_START;
+
+	status = trace_buffer_init (&trace, records, 4, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, trace_buffer_get_count (&trace));
+
+	trace_buffer_release (&trace);
+}
+
+static void trace_buffer_test_init_null (CuTest *test)
+{
+	struct trace_record records[4];
+	struct trace_buffer trace;
+	int status;
+
+	TEST_START;
+
+	status = trace_buffer_init (NULL, records, 4, NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = trace_buffer_init (&trace, NULL, 4, NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = trace_buffer_init (&trace, records, 0, NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+}
+
+static void trace_buffer_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	trace_buffer_release (NULL);
+}
+
+static void trace_buffer_test_add (CuTest *test)
+{
+	struct trace_record records[4];
+	struct trace_record out[4];
+	struct trace_buffer trace;
+	int status;
+
+	TEST_START;
+
+	trace_buffer_testing_timestamp_value = 100;
+
+	status = trace_buffer_init (&trace, records, 4, trace_buffer_testing_timestamp);
+	CuAssertIntEquals (test, 0, status);
+
+	trace_buffer_add (&trace, TRACE_EVENT_HASH, TRACE_PHASE_BEGIN, 1, 2);
+	trace_buffer_add (&trace, TRACE_EVENT_HASH, TRACE_PHASE_END, 3, 4);
+
+	CuAssertIntEquals (test, 2, trace_buffer_get_count (&trace));
+
+	status = trace_buffer_read (&trace, 0, out, 4);
+	CuAssertIntEquals (test, 2, status);
+
+	trace_buffer_testing_check_record (test, &out[0], 100, TRACE_EVENT_HASH, TRACE_PHASE_BEGIN, 1,
+		2);
+	trace_buffer_testing_check_record (test, &out[1], 101, TRACE_EVENT_HASH, TRACE_PHASE_END, 3,
+		4);
+
+	trace_buffer_release (&trace);
+}
+
+static void trace_buffer_test_add_default_timestamp (CuTest *test)
+{
+	struct trace_record records[4];
+	struct trace_record out[4];
+	struct trace_buffer trace;
+	int status;
+
+	TEST_START;
+
+	status = trace_buffer_init (&trace, records, 4, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	trace_buffer_add (&trace, TRACE_EVENT_ECC_SIGN, TRACE_PHASE_BEGIN, 32, 0);
+	platform_msleep (10);
+	trace_buffer_add (&trace, TRACE_EVENT_ECC_SIGN, TRACE_PHASE_END, 32, 0);
+
+	status = trace_buffer_read (&trace, 0, out, 4);
+	CuAssertIntEquals (test, 2, status);
+
+	CuAssertTrue (test, (out[0].timestamp < 10));
+	CuAssertTrue (test, (out[1].timestamp >= 10));
+
+	trace_buffer_release (&trace);
+}
+
+static void trace_buffer_test_add_full_buffer (CuTest *test)
+{
+	struct trace_record records[4];
+	struct trace_record out[4];
+	struct trace_buffer trace;
+	int status;
+	int i;
+
+	TEST_START;
+
+	trace_buffer_testing_timestamp_value = 0;
+
+	status = trace_buffer_init (&trace, records, 4, trace_buffer_testing_timestamp);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 10; i++) {
+		trace_buffer_add (&trace, TRACE_EVENT_FLASH_XFER, TRACE_PHASE_INSTANT, i, 0);
+	}
+
+	CuAssertIntEquals (test, 4, trace_buffer_get_count (&trace));
+
+	status = trace_buffer_read (&trace, 0, out, 4);
+	CuAssertIntEquals (test, 4, status);
+
+	for (i = 0; i < 4; i++) {
+		trace_buffer_testing_check_record (test, &out[i], i + 6, TRACE_EVENT_FLASH_XFER,
+			TRACE_PHASE_INSTANT, i + 6, 0);
+	}
+
+	trace_buffer_release (&trace);
+}
+
+static void trace_buffer_test_add_disabled (CuTest *test)
+{
+	struct trace_record records[4];
+	struct trace_record out[4];
+	struct trace_buffer trace;
+	int status;
+
+	TEST_START;
+
+	trace_buffer_testing_timestamp_value = 0;
+
+	status = trace_buffer_init (&trace, records, 4, trace_buffer_testing_timestamp);
+	CuAssertIntEquals (test, 0, status);
+
+	trace_buffer_add (&trace, TRACE_EVENT_MCTP_RX, TRACE_PHASE_BEGIN, 1, 2);
+
+	trace_buffer_set_enabled (&trace, false);
+	trace_buffer_add (&trace, TRACE_EVENT_MCTP_RX, TRACE_PHASE_END, 1, 2);
+	CuAssertIntEquals (test, 1, trace_buffer_get_count (&trace));
+
+	trace_buffer_set_enabled (&trace, true);
+	trace_buffer_add (&trace, TRACE_EVENT_MCTP_TX, TRACE_PHASE_BEGIN, 3, 4);
+	CuAssertIntEquals (test, 2, trace_buffer_get_count (&trace));
+
+	status = trace_buffer_read (&trace, 0, out, 4);
+	CuAssertIntEquals (test, 2, status);
+
+	trace_buffer_testing_check_record (test, &out[0], 0, TRACE_EVENT_MCTP_RX, TRACE_PHASE_BEGIN, 1,
+		2);
+	trace_buffer_testing_check_record (test, &out[1], 1, TRACE_EVENT_MCTP_TX, TRACE_PHASE_BEGIN, 3,
+		4);
+
+	trace_buffer_release (&trace);
+}
+
+static void trace_buffer_test_add_null (CuTest *test)
+{
+	TEST_START;
+
+	trace_buffer_add (NULL, TRACE_EVENT_HASH, TRACE_PHASE_BEGIN, 0, 0);
+}
+
+static void trace_buffer_test_read_offset (CuTest *test)
+{
+	struct trace_record records[4];
+	struct trace_record out[4];
+	struct trace_buffer trace;
+	int status;
+	int i;
+
+	TEST_START;
+
+	trace_buffer_testing_timestamp_value = 0;
+
+	status = trace_buffer_init (&trace, records, 4, trace_buffer_testing_timestamp);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 6; i++) {
+		trace_buffer_add (&trace, TRACE_EVENT_RSA_VERIFY, TRACE_PHASE_INSTANT, i, 0);
+	}
+
+	status = trace_buffer_read (&trace, 1, out, 4);
+	CuAssertIntEquals (test, 3, status);
+
+	for (i = 0; i < 3; i++) {
+		trace_buffer_testing_check_record (test, &out[i], i + 3, TRACE_EVENT_RSA_VERIFY,
+			TRACE_PHASE_INSTANT, i + 3, 0);
+	}
+
+	status = trace_buffer_read (&trace, 3, out, 4);
+	CuAssertIntEquals (test, 1, status);
+
+	trace_buffer_testing_check_record (test, &out[0], 5, TRACE_EVENT_RSA_VERIFY,
+		TRACE_PHASE_INSTANT, 5, 0);
+
+	status = trace_buffer_read (&trace, 4, out, 4);
+	CuAssertIntEquals (test, 0, status);
+
+	trace_buffer_release (&trace);
+}
+
+static void trace_buffer_test_read_limited_count (CuTest *test)
+{
+	struct trace_record records[4];
+	struct trace_record out[4];
+	struct trace_buffer trace;
+	int status;
+	int i;
+
+	TEST_START;
+
+	trace_buffer_testing_timestamp_value = 0;
+
+	status = trace_buffer_init (&trace, records, 4, trace_buffer_testing_timestamp);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 4; i++) {
+		trace_buffer_add (&trace, TRACE_EVENT_ECC_VERIFY, TRACE_PHASE_INSTANT, i, 0);
+	}
+
+	status = trace_buffer_read (&trace, 1, out, 2);
+	CuAssertIntEquals (test, 2, status);
+
+	for (i = 0; i < 2; i++) {
+		trace_buffer_testing_check_record (test, &out[i], i + 1, TRACE_EVENT_ECC_VERIFY,
+			TRACE_PHASE_INSTANT, i + 1, 0);
+	}
+
+	trace_buffer_release (&trace);
+}
+
+static void trace_buffer_test_read_null (CuTest *test)
+{
+	struct trace_record records[4];
+	struct trace_record out[4];
+	struct trace_buffer trace;
+	int status;
+
+	TEST_START;
+
+	status = trace_buffer_init (&trace, records, 4, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = trace_buffer_read (NULL, 0, out, 4);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = trace_buffer_read (&trace, 0, NULL, 4);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	CuAssertIntEquals (test, 0, trace_buffer_get_count (NULL));
+
+	trace_buffer_release (&trace);
+}
+
+static void trace_buffer_test_clear (CuTest *test)
+{
+	struct trace_record records[4];
+	struct trace_record out[4];
+	struct trace_buffer trace;
+	int status;
+	int i;
+
+	TEST_START;
+
+	trace_buffer_testing_timestamp_value = 0;
+
+	status = trace_buffer_init (&trace, records, 4, trace_buffer_testing_timestamp);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 6; i++) {
+		trace_buffer_add (&trace, TRACE_EVENT_CMD_DISPATCH, TRACE_PHASE_INSTANT, i, 0);
+	}
+
+	trace_buffer_clear (&trace);
+	CuAssertIntEquals (test, 0, trace_buffer_get_count (&trace));
+
+	status = trace_buffer_read (&trace, 0, out, 4);
+	CuAssertIntEquals (test, 0, status);
+
+	trace_buffer_add (&trace, TRACE_EVENT_CMD_DISPATCH, TRACE_PHASE_INSTANT, 10, 0);
+
+	status = trace_buffer_read (&trace, 0, out, 4);
+	CuAssertIntEquals (test, 1, status);
+
+	trace_buffer_testing_check_record (test, &out[0], 6, TRACE_EVENT_CMD_DISPATCH,
+		TRACE_PHASE_INSTANT, 10, 0);
+
+	trace_buffer_release (&trace);
+}
+
+static void trace_buffer_test_clear_null (CuTest *test)
+{
+	TEST_START;
+
+	trace_buffer_clear (NULL);
+	trace_buffer_set_enabled (NULL, false);
+}
+
+static void trace_buffer_test_register (CuTest *test)
+{
+	struct trace_record records[4];
+	struct trace_buffer trace;
+	int status;
+
+	TEST_START;
+
+	status = trace_buffer_init (&trace, records, 4, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, trace_buffer_get_core (0));
+
+	status = trace_buffer_register (&trace, 0);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &trace, trace_buffer_get_core (0));
+
+	status = trace_buffer_register (NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, trace_buffer_get_core (0));
+
+	trace_buffer_release (&trace);
+}
+
+static void trace_buffer_test_register_invalid_core (CuTest *test)
+{
+	struct trace_record records[4];
+	struct trace_buffer trace;
+	int status;
+
+	TEST_START;
+
+	status = trace_buffer_init (&trace, records, 4, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = trace_buffer_register (&trace, -1);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = trace_buffer_register (&trace, TRACE_BUFFER_MAX_CORES);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	CuAssertPtrEquals (test, NULL, trace_buffer_get_core (-1));
+	CuAssertPtrEquals (test, NULL, trace_buffer_get_core (TRACE_BUFFER_MAX_CORES));
+
+	trace_buffer_release (&trace);
+}
+
+static void trace_buffer_test_event (CuTest *test)
+{
+	struct trace_record records[4];
+	struct trace_record out[4];
+	struct trace_buffer trace;
+	int status;
+
+	TEST_START;
+
+	trace_buffer_testing_timestamp_value = 0;
+
+	status = trace_buffer_init (&trace, records, 4, trace_buffer_testing_timestamp);
+	CuAssertIntEquals (test, 0, status);
+
+	trace_buffer_event (TRACE_EVENT_HOST_SOFT_RESET, TRACE_PHASE_BEGIN, 0, 0);
+
+	status = trace_buffer_register (&trace, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	trace_buffer_event (TRACE_EVENT_HOST_SOFT_RESET, TRACE_PHASE_BEGIN, 1, 2);
+	trace_buffer_event (TRACE_EVENT_HOST_SOFT_RESET, TRACE_PHASE_END, 3, 4);
+
+	trace_buffer_register (NULL, 0);
+	trace_buffer_event (TRACE_EVENT_HOST_SOFT_RESET, TRACE_PHASE_END, 5, 6);
+
+	status = trace_buffer_read (&trace, 0, out, 4);
+	CuAssertIntEquals (test, 2, status);
+
+	trace_buffer_testing_check_record (test, &out[0], 0, TRACE_EVENT_HOST_SOFT_RESET,
+		TRACE_PHASE_BEGIN, 1, 2);
+	trace_buffer_testing_check_record (test, &out[1], 1, TRACE_EVENT_HOST_SOFT_RESET,
+		TRACE_PHASE_END, 3, 4);
+
+	trace_buffer_release (&trace);
+}
+
+#ifdef ENABLE_TRACE
+static void trace_buffer_test_event_macros (CuTest *test)
+{
+	struct trace_record records[4];
+	struct trace_record out[4];
+	struct trace_buffer trace;
+	int status;
+
+	TEST_START;
+
+	trace_buffer_testing_timestamp_value = 0;
+
+	status = trace_buffer_init (&trace, records, 4, trace_buffer_testing_timestamp);
+	CuAssertIntEquals (test, 0, status);
+
+	status = trace_buffer_register (&trace, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	TRACE_BEGIN (TRACE_EVENT_HOST_POWER_ON_RESET, 1, 2);
+	TRACE_INSTANT (TRACE_EVENT_PLATFORM, 3, 4);
+	TRACE_END (TRACE_EVENT_HOST_POWER_ON_RESET, 5, 6);
+
+	trace_buffer_register (NULL, 0);
+
+	status = trace_buffer_read (&trace, 0, out, 4);
+	CuAssertIntEquals (test, 3, status);
+
+	trace_buffer_testing_check_record (test, &out[0], 0, TRACE_EVENT_HOST_POWER_ON_RESET,
+		TRACE_PHASE_BEGIN, 1, 2);
+	trace_buffer_testing_check_record (test, &out[1], 1, TRACE_EVENT_PLATFORM,
+		TRACE_PHASE_INSTANT, 3, 4);
+	trace_buffer_testing_check_record (test, &out[2], 2, TRACE_EVENT_HOST_POWER_ON_RESET,
+		TRACE_PHASE_END, 5, 6);
+
+	trace_buffer_release (&trace);
+}
+#endif
+
+
+CuSuite* get_trace_buffer_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, trace_buffer_test_init);
+	SUITE_ADD_TEST (suite, trace_buffer_test_init_null);
+	SUITE_ADD_TEST (suite, trace_buffer_test_release_null);
+	SUITE_ADD_TEST (suite, trace_buffer_test_add);
+	SUITE_ADD_TEST (suite, trace_buffer_test_add_default_timestamp);
+	SUITE_ADD_TEST (suite, trace_buffer_test_add_full_buffer);
+	SUITE_ADD_TEST (suite, trace_buffer_test_add_disabled);
+	SUITE_ADD_TEST (suite, trace_buffer_test_add_null);
+	SUITE_ADD_TEST (suite, trace_buffer_test_read_offset);
+	SUITE_ADD_TEST (suite, trace_buffer_test_read_limited_count);
+	SUITE_ADD_TEST (suite, trace_buffer_test_read_null);
+	SUITE_ADD_TEST (suite, trace_buffer_test_clear);
+	SUITE_ADD_TEST (suite, trace_buffer_test_clear_null);
+	SUITE_ADD_TEST (suite, trace_buffer_test_register);
+	SUITE_ADD_TEST (suite, trace_buffer_test_register_invalid_core);
+	SUITE_ADD_TEST (suite, trace_buffer_test_event);
+#ifdef ENABLE_TRACE
+	SUITE_ADD_TEST (suite, trace_buffer_test_event_macros);
+#endif
+
+	return suite;
+}
@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "attestation_task.h"
+
+
+/**
+ * Task loop for running the attestation scheduler.
+ *
+ * @param data Pointer to the attestation task instance.
+ */
+static void attestation_task_loop (void *data)
+{
+	struct attestation_task *task = (struct attestation_task*) data;
+	int wait;
+
+	while (1) {
+		wait = attestation_scheduler_poll (task->scheduler);
+		if (ROT_IS_ERROR (wait)) {
+			wait = task->scheduler->period_ms;
+		}
+
+		ulTaskNotifyTake (pdTRUE, pdMS_TO_TICKS (wait));
+	}
+}
+
+/**
+ * Initialize and start the task to periodically attest devices.  Buses and devices should be added
+ * to the scheduler before the task is started.
+ *
+ * @param task The attestation task to initialize.
+ * @param scheduler The scheduler for the devices to attest.
+ * @param priority The priority for the attestation task.
+ *
+ * @return Initialization status, 0 if success or an error code.
+ */
+int attestation_task_init (struct attestation_task *task, struct attestation_scheduler *scheduler,
+	UBaseType_t priority)
+{
+	int status;
+
+	if ((task == NULL) || (scheduler == NULL)) {
+		return ATTESTATION_SCHEDULER_INVALID_ARGUMENT;
+	}
+
+	memset (task, 0, sizeof (struct attestation_task));
+
+	task->scheduler = scheduler;
+
+	status = xTaskCreate (attestation_task_loop, "Attest", 2 * 256, task, priority, &task->task);
+	if (status != pdPASS) {
+		task->task = NULL;
+		return ATTESTATION_SCHEDULER_NO_MEMORY;
+	}
+
+	return 0;
+}
+
+/**
+ * Stop and release the attestation task.
+ *
+ * @param task The attestation task to release.
+ */
+void attestation_task_deinit (struct attestation_task *task)
+{
+	if ((task != NULL) && (task->task != NULL)) {
+		vTaskDelete (task->task);
+		memset (task, 0, sizeof (struct attestation_task));
+	}
+}
+
+/**
+ * Wake the attestation task to run the scheduler immediately, such as after triggering attestation
+ * of all devices.
+ *
+ * @param task The attestation task to notify.
+ */
+void attestation_task_notify (struct attestation_task *task)
+{
+	if ((task != NULL) && (task->task != NULL)) {
+		xTaskNotifyGive (task->task);
+	}
+}
@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef ATTESTATION_TASK_H_
+#define ATTESTATION_TASK_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "attestation/attestation_scheduler.h"
+
+
+/**
+ * Task context for periodically attesting devices.
+ */
+struct attestation_task {
+	struct attestation_scheduler *scheduler;		/**< Scheduler for the devices being attested. */
+	TaskHandle_t task;								/**< The task that runs the scheduler. */
+};
+
+
+int attestation_task_init (struct attestation_task *task, struct attestation_scheduler *scheduler,
+	UBaseType_t priority);
+void attestation_task_deinit (struct attestation_task *task);
+
+void attestation_task_notify (struct attestation_task *task);
+
+
+#endif /* ATTESTATION_TASK_H_ */
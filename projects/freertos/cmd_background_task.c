@@ -20,6 +20,7 @@
 #define	CMD_BACKGROUND_DEBUG_LOG_CLEAR	(1U << 3)
 #define	CMD_BACKGROUND_DEBUG_LOG_FILL	(1U << 4)
 #define	CMD_BACKGROUND_AUTH_RIOT		(1U << 5)
+#define	CMD_BACKGROUND_RUN_DEFERRED		(1U << 6)
 
 
 /**
@@ -36,6 +37,31 @@ void cmd_background_task_set_status (struct cmd_background_task *task, int *op_s
 	xSemaphoreGive (task->lock);
 }
 
+/**
+ * Refill the pool of precomputed challenge signatures.  Signatures are precomputed one at a time
+ * so a challenge received in the meantime only waits for a single computation.  If the attestation
+ * ECC engine does not support precomputation, no further attempts will be made.
+ *
+ * @param task The background command task instance.
+ */
+static void cmd_background_task_precompute_signatures (struct cmd_background_task *task)
+{
+	int status;
+
+	if (!task->attestation.precompute) {
+		return;
+	}
+
+	do {
+		status = attestation_slave_precompute_challenge_signatures (task->attestation.attestation,
+			1);
+	} while (status == 1);
+
+	if (status == ATTESTATION_UNSUPPORTED_OPERATION) {
+		task->attestation.precompute = false;
+	}
+}
+
 /**
  * The task function that will run the background commands.
  *
@@ -43,15 +69,36 @@ void cmd_background_task_set_status (struct cmd_background_task *task, int *op_s
  */
 static void cmd_background_task_handler (struct cmd_background_task *task)
 {
+	struct aux_attestation *aux = NULL;
+	TickType_t wait;
 	uint32_t notification;
 	int *op_status;
 	int status;
 
+	if (task->attestation.attestation != NULL) {
+		aux = task->attestation.attestation->aux;
+	}
+
 	do {
-		/* Wait for a signal to perform update action. */
+		/* Wait for a signal to perform update action.  If the attestation key is being cached with
+		 * an idle timeout, wake up periodically to release the key once it expires.  Idle periods
+		 * are also used to replace precomputed challenge signatures that have been consumed. */
 		status = CMD_BACKGROUND_UNSUPPORTED_OP;
 		op_status =  &task->config.config_status;
-		xTaskNotifyWait (pdFALSE, ULONG_MAX, &notification, portMAX_DELAY);
+
+		wait = portMAX_DELAY;
+		if ((aux != NULL) && aux->cache_key && (aux->key_idle_ms != 0)) {
+			wait = pdMS_TO_TICKS (aux->key_idle_ms);
+		}
+		if (task->attestation.precompute && (pdMS_TO_TICKS (CMD_BACKGROUND_PRECOMPUTE_MS) < wait)) {
+			wait = pdMS_TO_TICKS (CMD_BACKGROUND_PRECOMPUTE_MS);
+		}
+
+		if (xTaskNotifyWait (pdFALSE, ULONG_MAX, &notification, wait) != pdTRUE) {
+			aux_attestation_expire_key_cache (aux);
+			cmd_background_task_precompute_signatures (task);
+			continue;
+		}
 
 		if (notification & CMD_BACKGROUND_RUN_UNSEAL) {
 			struct cerberus_protocol_message_unseal *unseal =
@@ -149,6 +196,12 @@ static void cmd_background_task_handler (struct cmd_background_task *task)
 				status = CMD_BACKGROUND_STATUS (RIOT_CERT_STATE_CHAIN_INVALID, status);
 			}
 		}
+		else if (notification & CMD_BACKGROUND_RUN_DEFERRED) {
+			op_status = &task->deferred.deferred_status;
+
+			status = cmd_deferred_execute (task->deferred.deferred);
+			task->deferred.deferred = NULL;
+		}
 		else {
 			debug_log_create_entry (DEBUG_LOG_SEVERITY_WARNING, DEBUG_LOG_COMPONENT_CMD_INTERFACE,
 				CMD_LOGGING_NOTIFICATION_ERROR, notification, 0);
@@ -452,6 +505,38 @@ int cmd_background_task_get_riot_cert_chain_state (struct cmd_background *cmd)
 	return status;
 }
 
+static int cmd_background_task_run_deferred (struct cmd_background *cmd,
+	struct cmd_deferred *deferred)
+{
+	struct cmd_background_task *task = (struct cmd_background_task*) cmd;
+	int status = 0;
+
+	if ((task == NULL) || (deferred == NULL)) {
+		return CMD_BACKGROUND_INVALID_ARGUMENT;
+	}
+
+	if (task->task) {
+		xSemaphoreTake (task->lock, portMAX_DELAY);
+		if (!task->running) {
+			task->deferred.deferred = deferred;
+			task->running = 1;
+			xSemaphoreGive (task->lock);
+			xTaskNotify (task->task, CMD_BACKGROUND_RUN_DEFERRED, eSetBits);
+		}
+		else {
+			status = CMD_BACKGROUND_TASK_BUSY;
+			task->deferred.deferred_status = status;
+			xSemaphoreGive (task->lock);
+		}
+	}
+	else {
+		status = CMD_BACKGROUND_NO_TASK;
+		task->deferred.deferred_status = status;
+	}
+
+	return status;
+}
+
 /**
  * Initialize the task for executing received requests outside of the main command handler.
  *
@@ -483,6 +568,7 @@ int cmd_background_task_init (struct cmd_background_task *task,
 	task->base.unseal_result = cmd_background_task_unseal_result;
 
 	task->attestation.attestation = attestation;
+	task->attestation.precompute = (attestation != NULL);
 	task->attestation.hash = hash;
 	task->attestation.attestation_status = ATTESTATION_CMD_STATUS_NONE_STARTED;
 
@@ -508,6 +594,9 @@ int cmd_background_task_init (struct cmd_background_task *task,
 	task->riot.cert_state = (riot_key_manager_get_root_ca (riot) == NULL) ?
 		RIOT_CERT_STATE_CHAIN_INVALID : RIOT_CERT_STATE_CHAIN_VALID;
 
+	/* Deferred command operations. */
+	task->base.run_deferred = cmd_background_task_run_deferred;
+
 	return 0;
 }
 
@@ -4,6 +4,7 @@
 #ifndef CMD_BACKGROUND_TASK_H_
 #define CMD_BACKGROUND_TASK_H_
 
+#include <stdbool.h>
 #include "FreeRTOS.h"
 #include "semphr.h"
 #include "attestation/attestation_slave.h"
@@ -13,6 +14,14 @@
 #include "riot/riot_key_manager.h"
 
 
+/**
+ * The interval at which the idle task will refill the pool of precomputed challenge signatures.
+ */
+#ifndef CMD_BACKGROUND_PRECOMPUTE_MS
+#define	CMD_BACKGROUND_PRECOMPUTE_MS		1000
+#endif
+
+
 /**
  * The task context for executing attestation requests.
  */
@@ -22,6 +31,7 @@ struct cmd_background_attestation {
 	int attestation_status;							/**< The attestation operation status. */
 	uint8_t *unseal_request;						/**< The current unseal request. */
 	uint8_t key[AUX_ATTESTATION_KEY_256BIT];		/**< Buffer for the unsealed key. */
+	bool precompute;								/**< Flag to precompute challenge signatures when idle. */
 };
 
 /**
@@ -40,6 +50,14 @@ struct cmd_background_riot {
 	int cert_state;									/**< Certificate authentication state. */
 };
 
+/**
+ * The task context for executing deferred command requests.
+ */
+struct cmd_background_deferred {
+	struct cmd_deferred *deferred;					/**< Handler for the request being executed. */
+	int deferred_status;							/**< Status of the last deferred execution. */
+};
+
 /**
  * Task for executing background operations from the command handler.
  */
@@ -51,6 +69,7 @@ struct cmd_background_task {
 	struct cmd_background_attestation attestation;	/**< Attestation command context. */
 	struct cmd_background_config config;			/**< Configuration reset context. */
 	struct cmd_background_riot riot;				/**< RIoT key context. */
+	struct cmd_background_deferred deferred;		/**< Deferred command context. */
 };
 
 
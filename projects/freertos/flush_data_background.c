@@ -9,6 +9,26 @@
 #include "platform.h"
 
 
+/**
+ * Store non-volatile state to flash if it has changed since it was last stored.  Unchanged state is
+ * not stored, so there is no flash access while the system is idle.
+ *
+ * @param state The manager for the state to persist.  This can be null.
+ * @param id Identifier to log if the state could not be stored.
+ */
+static void flush_data_background_store_state (struct state_manager *state, int id)
+{
+	int status;
+
+	if (state && state_manager_has_pending_non_volatile_state (state)) {
+		status = state_manager_store_non_volatile_state (state);
+		if (status != 0) {
+			debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_STATE_MGR,
+				STATE_LOGGING_PERSIST_FAIL, id, status);
+		}
+	}
+}
+
 /**
  * Runs the background persistence task.
  *
@@ -16,43 +36,22 @@
  */
 static void flush_data_background_task (struct flush_data_background *flush_data)
 {
-	int status;
-
 	while (1) {
-		platform_msleep (1000);
+		/* Sleep until either notified that data is ready or the deadline for persisting any
+		 * accumulated changes has passed. */
+		ulTaskNotifyTake (pdTRUE, pdMS_TO_TICKS (FLUSH_DATA_BACKGROUND_DEADLINE_MS));
 
 		xSemaphoreTake (flush_data->lock, portMAX_DELAY);
 
-		if (flush_data->system_state) {
-			status = state_manager_store_non_volatile_state (flush_data->system_state);
-			if (status != 0) {
-				debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_STATE_MGR,
-					STATE_LOGGING_PERSIST_FAIL, 2, status);
-			}
-		}
-
-		if (flush_data->host_state_0) {
-			status = state_manager_store_non_volatile_state (flush_data->host_state_0);
-			if (status != 0) {
-				debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_STATE_MGR,
-					STATE_LOGGING_PERSIST_FAIL, 0, status);
-			}
-		}
-
-		if (flush_data->host_state_1) {
-			status = state_manager_store_non_volatile_state (flush_data->host_state_1);
-			if (status != 0) {
-				debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_STATE_MGR,
-					STATE_LOGGING_PERSIST_FAIL, 1, status);
-			}
-		}
+		flush_data_background_store_state (flush_data->system_state, 2);
+		flush_data_background_store_state (flush_data->host_state_0, 0);
+		flush_data_background_store_state (flush_data->host_state_1, 1);
 
 		if (flush_data->logger) {
 			flush_data->logger->flush (flush_data->logger);
 		}
 
 		xSemaphoreGive (flush_data->lock);
-
 	}
 }
 
@@ -112,3 +111,52 @@ void flush_data_background_release (struct flush_data_background *flush_data)
 		vSemaphoreDelete (flush_data->lock);
 	}
 }
+
+/**
+ * Wake the persistence task to store data immediately instead of waiting for the deadline.
+ *
+ * @param flush_data The persistence task to notify.
+ */
+void flush_data_background_notify (struct flush_data_background *flush_data)
+{
+	if ((flush_data != NULL) && (flush_data->task != NULL)) {
+		xTaskNotifyGive (flush_data->task);
+	}
+}
+
+/**
+ * Wake the persistence task from an interrupt handler to store data immediately instead of waiting
+ * for the deadline.
+ *
+ * @param flush_data The persistence task to notify.
+ * @param task_woken Output indicating if a context switch should be requested before exiting the
+ * interrupt handler.
+ */
+void flush_data_background_notify_from_isr (struct flush_data_background *flush_data,
+	BaseType_t *task_woken)
+{
+	if ((flush_data != NULL) && (flush_data->task != NULL)) {
+		vTaskNotifyGiveFromISR (flush_data->task, task_woken);
+	}
+}
+
+/**
+ * Flush request handler that can be registered with a staged log to wake the persistence task when
+ * enough entries have been staged.  Entries can be staged from interrupt handlers, so the
+ * notification method is selected based on the current execution context.
+ *
+ * @param context The persistence task to notify.
+ */
+void flush_data_background_flush_request (void *context)
+{
+	BaseType_t task_woken = pdFALSE;
+
+	if (xPortIsInsideInterrupt () == pdTRUE) {
+		flush_data_background_notify_from_isr ((struct flush_data_background*) context,
+			&task_woken);
+		portYIELD_FROM_ISR (task_woken);
+	}
+	else {
+		flush_data_background_notify ((struct flush_data_background*) context);
+	}
+}
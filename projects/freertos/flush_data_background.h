@@ -11,6 +11,14 @@
 #include "state_manager/state_manager.h"
 
 
+/**
+ * The longest time data will be held in memory before the background task wakes to persist it.
+ * The task will run sooner if it is notified that data is ready.
+ */
+#ifndef FLUSH_DATA_BACKGROUND_DEADLINE_MS
+#define	FLUSH_DATA_BACKGROUND_DEADLINE_MS		1000
+#endif
+
 /**
  * Background task for flushing log contents to flash and persisting non-volatile state information.
  */
@@ -20,7 +28,7 @@ struct flush_data_background {
 	SemaphoreHandle_t lock;					/**< Synchronization to protect task deletion. */
 	struct state_manager *system_state;		/**< The manager for system state to persist. */
 	struct state_manager *host_state_0;		/**< The manager for host state to persist for port 0. */
-	struct state_manager *host_state_1;		/**< The manager for host state to persist for port 1. */ 
+	struct state_manager *host_state_1;		/**< The manager for host state to persist for port 1. */
 };
 
 int flush_data_background_init (struct flush_data_background *flush_data,
@@ -28,5 +36,10 @@ int flush_data_background_init (struct flush_data_background *flush_data,
 	struct state_manager *host_state_1);
 void flush_data_background_release (struct flush_data_background *flush_data);
 
+void flush_data_background_notify (struct flush_data_background *flush_data);
+void flush_data_background_notify_from_isr (struct flush_data_background *flush_data,
+	BaseType_t *task_woken);
+void flush_data_background_flush_request (void *context);
+
 
 #endif /* FLUSH_DATA_BACKGROUND_H_ */
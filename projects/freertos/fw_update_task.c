@@ -23,9 +23,17 @@ static void fw_update_task_updater (struct fw_update_task *task)
 {
 	uint32_t notification;
 	bool reset = false;
+	bool resume;
 	int status;
 
-	if (task->running == 2) {
+	resume = firmware_update_is_resume_pending (task->updater);
+	if (resume) {
+		/* An update was interrupted before it completed.  Don't touch the images until the update
+		 * has been resumed from the last checkpoint. */
+		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CERBERUS_FW,
+			FIRMWARE_LOGGING_UPDATE_RESUME, 0, 0);
+	}
+	else if (task->running == 2) {
 		/* The system is running from the recovery image, so mark that image as good and restore the
 		 * active image to a functional state. */
 		firmware_update_set_recovery_good (task->updater, true);
@@ -50,7 +58,14 @@ static void fw_update_task_updater (struct fw_update_task *task)
 	}
 
 	xSemaphoreTake (task->lock, portMAX_DELAY);
-	task->running = 0;
+	if (resume) {
+		task->update_status = UPDATE_STATUS_STARTING;
+		task->running = 1;
+		xTaskNotify (xTaskGetCurrentTaskHandle (), RUN_UPDATE_BIT, eSetBits);
+	}
+	else {
+		task->running = 0;
+	}
 	xSemaphoreGive (task->lock);
 
 	do {
@@ -16,7 +16,9 @@
 static void logging_flush_task (struct logging_flush *flush)
 {
 	while (1) {
-		platform_msleep (1000);
+		/* Sleep until either notified that entries are ready or the deadline for writing any
+		 * buffered entries has passed. */
+		ulTaskNotifyTake (pdTRUE, pdMS_TO_TICKS (LOGGING_FLUSH_DEADLINE_MS));
 
 		xSemaphoreTake (flush->lock, portMAX_DELAY);
 		flush->logger->flush (flush->logger);
@@ -72,3 +74,50 @@ void logging_flush_release (struct logging_flush *log_task)
 		vSemaphoreDelete (log_task->lock);
 	}
 }
+
+/**
+ * Wake the logging task to flush the log immediately instead of waiting for the deadline.
+ *
+ * @param log_task The logging task to notify.
+ */
+void logging_flush_notify (struct logging_flush *log_task)
+{
+	if ((log_task != NULL) && (log_task->task != NULL)) {
+		xTaskNotifyGive (log_task->task);
+	}
+}
+
+/**
+ * Wake the logging task from an interrupt handler to flush the log immediately instead of waiting
+ * for the deadline.
+ *
+ * @param log_task The logging task to notify.
+ * @param task_woken Output indicating if a context switch should be requested before exiting the
+ * interrupt handler.
+ */
+void logging_flush_notify_from_isr (struct logging_flush *log_task, BaseType_t *task_woken)
+{
+	if ((log_task != NULL) && (log_task->task != NULL)) {
+		vTaskNotifyGiveFromISR (log_task->task, task_woken);
+	}
+}
+
+/**
+ * Flush request handler that can be registered with a staged log to wake the logging task when
+ * enough entries have been staged.  Entries can be staged from interrupt handlers, so the
+ * notification method is selected based on the current execution context.
+ *
+ * @param context The logging task to notify.
+ */
+void logging_flush_request (void *context)
+{
+	BaseType_t task_woken = pdFALSE;
+
+	if (xPortIsInsideInterrupt () == pdTRUE) {
+		logging_flush_notify_from_isr ((struct logging_flush*) context, &task_woken);
+		portYIELD_FROM_ISR (task_woken);
+	}
+	else {
+		logging_flush_notify ((struct logging_flush*) context);
+	}
+}
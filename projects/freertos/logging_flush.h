@@ -10,6 +10,14 @@
 #include "logging/logging.h"
 
 
+/**
+ * The longest time log entries will be held in memory before the background task wakes to flush
+ * them.  The task will run sooner if it is notified that entries are ready.
+ */
+#ifndef LOGGING_FLUSH_DEADLINE_MS
+#define	LOGGING_FLUSH_DEADLINE_MS		1000
+#endif
+
 /**
  * Background task for flushing log contents to flash.
  */
@@ -23,5 +31,9 @@ struct logging_flush {
 int logging_flush_init (struct logging_flush *log_task, struct logging *logger);
 void logging_flush_release (struct logging_flush *log_task);
 
+void logging_flush_notify (struct logging_flush *log_task);
+void logging_flush_notify_from_isr (struct logging_flush *log_task, BaseType_t *task_woken);
+void logging_flush_request (void *context);
+
 
 #endif /* LOGGING_FLUSH_H_ */
@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "mctp_mux_task.h"
+
+
+/**
+ * Worker loop for processing packets from the multiplexed channels.
+ *
+ * @param data Pointer to the MCTP multiplexer task instance.
+ */
+static void mctp_mux_task_loop (void *data)
+{
+	struct mctp_mux_task *task = (struct mctp_mux_task*) data;
+	int status;
+
+	while (1) {
+		status = cmd_channel_mux_process_next (task->mux);
+		if (status == CMD_CHANNEL_MUX_NO_PACKET) {
+			xSemaphoreTake (task->ready, pdMS_TO_TICKS (MCTP_MUX_TASK_POLL_MS));
+		}
+	}
+}
+
+/**
+ * Initialize and start the worker tasks to process received MCTP messages from multiple command
+ * channels.  Channels must be added to the multiplexer before the workers are started.
+ *
+ * @param task The MCTP multiplexer task to initialize.
+ * @param mux The multiplexer for the channels to service.
+ * @param workers The number of worker tasks to start.  No more than one worker will process
+ * packets for a single command handler at a time, so there is no benefit to having more workers
+ * than channels with independent command handlers.
+ * @param priority The task priority for the workers.
+ *
+ * @return Initialization status, 0 if success or an error code.
+ */
+int mctp_mux_task_init (struct mctp_mux_task *task, struct cmd_channel_mux *mux, int workers,
+	UBaseType_t priority)
+{
+	int status;
+	int i;
+
+	if ((task == NULL) || (mux == NULL) || (workers <= 0) ||
+		(workers > MCTP_MUX_TASK_MAX_WORKERS)) {
+		return CMD_CHANNEL_MUX_INVALID_ARGUMENT;
+	}
+
+	memset (task, 0, sizeof (struct mctp_mux_task));
+
+	task->mux = mux;
+
+	task->ready = xSemaphoreCreateCounting (workers, 0);
+	if (task->ready == NULL) {
+		return CMD_CHANNEL_MUX_NO_MEMORY;
+	}
+
+	for (i = 0; i < workers; i++) {
+		status = xTaskCreate (mctp_mux_task_loop, "MCTP_MUX", 6 * 256, task, priority,
+			&task->worker[i]);
+		if (status != pdPASS) {
+			task->worker[i] = NULL;
+			mctp_mux_task_deinit (task);
+			return CMD_CHANNEL_MUX_NO_MEMORY;
+		}
+
+		task->workers++;
+	}
+
+	return 0;
+}
+
+/**
+ * Stop and release the MCTP multiplexer worker tasks.
+ *
+ * @param task The MCTP multiplexer task to release.
+ */
+void mctp_mux_task_deinit (struct mctp_mux_task *task)
+{
+	int i;
+
+	if (task != NULL) {
+		for (i = 0; i < task->workers; i++) {
+			vTaskDelete (task->worker[i]);
+		}
+
+		vSemaphoreDelete (task->ready);
+		memset (task, 0, sizeof (struct mctp_mux_task));
+	}
+}
+
+/**
+ * Notify the workers that a packet has been received on one of the channels.
+ *
+ * @param task The MCTP multiplexer task to notify.
+ */
+void mctp_mux_task_notify (struct mctp_mux_task *task)
+{
+	if (task != NULL) {
+		xSemaphoreGive (task->ready);
+	}
+}
+
+/**
+ * Notify the workers from an interrupt handler that a packet has been received on one of the
+ * channels.
+ *
+ * @param task The MCTP multiplexer task to notify.
+ * @param task_woken Output indicating if a context switch should be requested before exiting the
+ * interrupt handler.
+ */
+void mctp_mux_task_notify_from_isr (struct mctp_mux_task *task, BaseType_t *task_woken)
+{
+	if (task != NULL) {
+		xSemaphoreGiveFromISR (task->ready, task_woken);
+	}
+}
@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef MCTP_MUX_TASK_H_
+#define MCTP_MUX_TASK_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "cmd_interface/cmd_channel_mux.h"
+
+
+/**
+ * The maximum number of worker tasks that can process packets from the multiplexed channels.
+ */
+#ifndef MCTP_MUX_TASK_MAX_WORKERS
+#define	MCTP_MUX_TASK_MAX_WORKERS			2
+#endif
+
+/**
+ * The amount of time an idle worker will wait before checking the channels for new packets, in
+ * milliseconds.  Channel drivers that call mctp_mux_task_notify when a packet is received will be
+ * serviced without waiting for this timeout.
+ */
+#ifndef MCTP_MUX_TASK_POLL_MS
+#define	MCTP_MUX_TASK_POLL_MS				10
+#endif
+
+
+/**
+ * Task context for processing MCTP messages from multiple command channels with a shared pool of
+ * worker tasks.
+ */
+struct mctp_mux_task {
+	struct cmd_channel_mux *mux;						/**< Multiplexer for the serviced channels. */
+	SemaphoreHandle_t ready;							/**< Signal that packets have been received. */
+	TaskHandle_t worker[MCTP_MUX_TASK_MAX_WORKERS];		/**< Task handles for the workers. */
+	int workers;										/**< Number of workers that were started. */
+};
+
+
+int mctp_mux_task_init (struct mctp_mux_task *task, struct cmd_channel_mux *mux, int workers,
+	UBaseType_t priority);
+void mctp_mux_task_deinit (struct mctp_mux_task *task);
+
+void mctp_mux_task_notify (struct mctp_mux_task *task);
+void mctp_mux_task_notify_from_isr (struct mctp_mux_task *task, BaseType_t *task_woken);
+
+
+#endif /* MCTP_MUX_TASK_H_ */
@@ -18,7 +18,13 @@ static void state_persistence_task (struct state_persistence *persist)
 	int status;
 
 	while (1) {
-		platform_msleep (1000);
+		/* Sleep until the deadline for persisting any accumulated changes has passed. */
+		ulTaskNotifyTake (pdTRUE, pdMS_TO_TICKS (STATE_PERSISTENCE_DEADLINE_MS));
+
+		/* Don't touch flash if nothing has changed since the state was last stored. */
+		if (!state_manager_has_pending_non_volatile_state (persist->state)) {
+			continue;
+		}
 
 		xSemaphoreTake (persist->lock, portMAX_DELAY);
 		status = state_manager_store_non_volatile_state (persist->state);
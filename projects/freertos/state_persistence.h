@@ -10,6 +10,14 @@
 #include "state_manager/state_manager.h"
 
 
+/**
+ * The longest time state changes will be held in memory before the background task wakes to
+ * persist them.
+ */
+#ifndef STATE_PERSISTENCE_DEADLINE_MS
+#define	STATE_PERSISTENCE_DEADLINE_MS		1000
+#endif
+
 /**
  * Background task for persisting non-volatile state information.
  */
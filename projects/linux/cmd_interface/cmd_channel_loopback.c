@@ -0,0 +1,359 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include "platform.h"
+#include "mctp/mctp_protocol.h"
+#include "cmd_channel_loopback.h"
+
+
+/**
+ * Initialize one direction of packet queueing.
+ *
+ * @param queue The queue to initialize.
+ *
+ * @return 0 if the queue was initialized successfully or an error code.
+ */
+static int cmd_channel_loopback_queue_init (struct cmd_channel_loopback_queue *queue)
+{
+	pthread_condattr_t attr;
+	int status;
+
+	/* Timeouts are generated by the platform API, which uses the monotonic clock. */
+	pthread_condattr_init (&attr);
+	pthread_condattr_setclock (&attr, CLOCK_MONOTONIC);
+	status = pthread_cond_init (&queue->changed, &attr);
+	pthread_condattr_destroy (&attr);
+
+	return (status == 0) ? 0 : CMD_CHANNEL_NO_MEMORY;
+}
+
+/**
+ * Add a packet to the end of a queue.  The caller must ensure there is space available.
+ *
+ * @param queue The queue to update.
+ * @param packet The packet to add.
+ */
+static void cmd_channel_loopback_queue_push (struct cmd_channel_loopback_queue *queue,
+	const struct cmd_packet *packet)
+{
+	int tail = (queue->head + queue->count) % CMD_CHANNEL_LOOPBACK_QUEUE_DEPTH;
+
+	memcpy (&queue->packet[tail], packet, sizeof (struct cmd_packet));
+	queue->count++;
+}
+
+/**
+ * Remove the oldest packet from a queue.  The caller must ensure the queue is not empty.
+ *
+ * @param queue The queue to update.
+ * @param packet Output for the removed packet.
+ */
+static void cmd_channel_loopback_queue_pop (struct cmd_channel_loopback_queue *queue,
+	struct cmd_packet *packet)
+{
+	memcpy (packet, &queue->packet[queue->head], sizeof (struct cmd_packet));
+	queue->head = (queue->head + 1) % CMD_CHANNEL_LOOPBACK_QUEUE_DEPTH;
+	queue->count--;
+}
+
+/**
+ * Wait for a queue to change state.  The channel lock must be held by the caller.
+ *
+ * @param loopback The loopback channel.
+ * @param queue The queue to wait on.
+ * @param ms_timeout The timeout that was requested by the caller.
+ * @param timeout The absolute time at which the wait expires.  Only used if ms_timeout is positive.
+ *
+ * @return 0 if the queue changed or ETIMEDOUT if the wait expired.
+ */
+static int cmd_channel_loopback_wait (struct cmd_channel_loopback *loopback,
+	struct cmd_channel_loopback_queue *queue, int ms_timeout, const platform_clock *timeout)
+{
+	if (ms_timeout == 0) {
+		return ETIMEDOUT;
+	}
+	else if (ms_timeout < 0) {
+		return pthread_cond_wait (&queue->changed, &loopback->lock);
+	}
+	else {
+		return pthread_cond_timedwait (&queue->changed, &loopback->lock, timeout);
+	}
+}
+
+static int cmd_channel_loopback_receive_packet (struct cmd_channel *channel,
+	struct cmd_packet *packet, int ms_timeout)
+{
+	struct cmd_channel_loopback *loopback = (struct cmd_channel_loopback*) channel;
+	platform_clock timeout;
+	int status = 0;
+
+	if ((loopback == NULL) || (packet == NULL)) {
+		return CMD_CHANNEL_INVALID_ARGUMENT;
+	}
+
+	if (ms_timeout > 0) {
+		platform_init_timeout (ms_timeout, &timeout);
+	}
+
+	pthread_mutex_lock (&loopback->lock);
+
+	while ((loopback->rx.count == 0) && !loopback->closed && (status == 0)) {
+		status = cmd_channel_loopback_wait (loopback, &loopback->rx, ms_timeout, &timeout);
+	}
+
+	if (loopback->rx.count != 0) {
+		cmd_channel_loopback_queue_pop (&loopback->rx, packet);
+		pthread_cond_broadcast (&loopback->rx.changed);
+		status = 0;
+	}
+	else if (loopback->closed) {
+		status = CMD_CHANNEL_RX_FAILED;
+	}
+	else {
+		status = CMD_CHANNEL_RX_TIMEOUT;
+	}
+
+	pthread_mutex_unlock (&loopback->lock);
+
+	if (status == 0) {
+		/* Start the response timer on reception, the same as for a physical bus. */
+		packet->dest_addr = loopback->address;
+		platform_init_timeout (MCTP_PROTOCOL_MAX_RESPONSE_TIMEOUT_MS, &packet->pkt_timeout);
+		packet->timeout_valid = true;
+	}
+
+	return status;
+}
+
+static int cmd_channel_loopback_send_packet (struct cmd_channel *channel,
+	struct cmd_packet *packet)
+{
+	struct cmd_channel_loopback *loopback = (struct cmd_channel_loopback*) channel;
+	platform_clock timeout;
+	int status = 0;
+
+	if ((loopback == NULL) || (packet == NULL)) {
+		return CMD_CHANNEL_INVALID_ARGUMENT;
+	}
+
+	platform_init_timeout (MCTP_PROTOCOL_MAX_RESPONSE_TIMEOUT_MS, &timeout);
+
+	pthread_mutex_lock (&loopback->lock);
+
+	while ((loopback->tx.count == CMD_CHANNEL_LOOPBACK_QUEUE_DEPTH) && !loopback->closed &&
+		(status == 0)) {
+		status = cmd_channel_loopback_wait (loopback, &loopback->tx,
+			MCTP_PROTOCOL_MAX_RESPONSE_TIMEOUT_MS, &timeout);
+	}
+
+	if (loopback->closed) {
+		status = CMD_CHANNEL_TX_FAILED;
+	}
+	else if (loopback->tx.count == CMD_CHANNEL_LOOPBACK_QUEUE_DEPTH) {
+		status = CMD_CHANNEL_TX_TIMEOUT;
+	}
+	else {
+		cmd_channel_loopback_queue_push (&loopback->tx, packet);
+		pthread_cond_broadcast (&loopback->tx.changed);
+		status = 0;
+	}
+
+	pthread_mutex_unlock (&loopback->lock);
+
+	return status;
+}
+
+/**
+ * Initialize a loopback command channel.
+ *
+ * @param loopback The loopback channel to initialize.
+ * @param id An ID to associate with this command channel.
+ * @param address The SMBus address of the channel.  This is the address that requests must be
+ * sent to.
+ *
+ * @return 0 if the channel was successfully initialized or an error code.
+ */
+int cmd_channel_loopback_init (struct cmd_channel_loopback *loopback, int id, uint8_t address)
+{
+	int status;
+
+	if (loopback == NULL) {
+		return CMD_CHANNEL_INVALID_ARGUMENT;
+	}
+
+	memset (loopback, 0, sizeof (struct cmd_channel_loopback));
+
+	status = cmd_channel_init (&loopback->base, id);
+	if (status != 0) {
+		return status;
+	}
+
+	status = pthread_mutex_init (&loopback->lock, NULL);
+	if (status != 0) {
+		return CMD_CHANNEL_NO_MEMORY;
+	}
+
+	status = cmd_channel_loopback_queue_init (&loopback->rx);
+	if (status != 0) {
+		goto exit_lock;
+	}
+
+	status = cmd_channel_loopback_queue_init (&loopback->tx);
+	if (status != 0) {
+		goto exit_rx;
+	}
+
+	loopback->base.receive_packet = cmd_channel_loopback_receive_packet;
+	loopback->base.send_packet = cmd_channel_loopback_send_packet;
+
+	loopback->address = address;
+
+	return 0;
+
+exit_rx:
+	pthread_cond_destroy (&loopback->rx.changed);
+exit_lock:
+	pthread_mutex_destroy (&loopback->lock);
+	return status;
+}
+
+/**
+ * Release the resources used by a loopback command channel.  No threads can be using the channel.
+ *
+ * @param loopback The loopback channel to release.
+ */
+void cmd_channel_loopback_release (struct cmd_channel_loopback *loopback)
+{
+	if (loopback) {
+		pthread_cond_destroy (&loopback->tx.changed);
+		pthread_cond_destroy (&loopback->rx.changed);
+		pthread_mutex_destroy (&loopback->lock);
+		cmd_channel_release (&loopback->base);
+	}
+}
+
+/**
+ * Inject packets to be received by the command channel.  All packets are queued together, so
+ * packets from a multi-packet message will not be interleaved with packets injected from other
+ * threads.
+ *
+ * @param loopback The loopback channel to inject packets into.
+ * @param packets The packets to inject.
+ * @param num_packets The number of packets to inject.  This cannot be more than
+ * CMD_CHANNEL_LOOPBACK_QUEUE_DEPTH.
+ * @param ms_timeout The amount of time to wait for space in the queue, in milliseconds.  A negative
+ * value will wait forever, and a value of 0 will return immediately.
+ *
+ * @return 0 if the packets were successfully queued or an error code.
+ */
+int cmd_channel_loopback_inject (struct cmd_channel_loopback *loopback,
+	const struct cmd_packet *packets, size_t num_packets, int ms_timeout)
+{
+	platform_clock timeout;
+	int status = 0;
+	size_t i;
+
+	if ((loopback == NULL) || (packets == NULL) || (num_packets == 0) ||
+		(num_packets > CMD_CHANNEL_LOOPBACK_QUEUE_DEPTH)) {
+		return CMD_CHANNEL_INVALID_ARGUMENT;
+	}
+
+	if (ms_timeout > 0) {
+		platform_init_timeout (ms_timeout, &timeout);
+	}
+
+	pthread_mutex_lock (&loopback->lock);
+
+	while (((CMD_CHANNEL_LOOPBACK_QUEUE_DEPTH - loopback->rx.count) < (int) num_packets) &&
+		!loopback->closed && (status == 0)) {
+		status = cmd_channel_loopback_wait (loopback, &loopback->rx, ms_timeout, &timeout);
+	}
+
+	if (loopback->closed) {
+		status = CMD_CHANNEL_TX_FAILED;
+	}
+	else if ((CMD_CHANNEL_LOOPBACK_QUEUE_DEPTH - loopback->rx.count) < (int) num_packets) {
+		status = CMD_CHANNEL_TX_TIMEOUT;
+	}
+	else {
+		for (i = 0; i < num_packets; i++) {
+			cmd_channel_loopback_queue_push (&loopback->rx, &packets[i]);
+		}
+
+		pthread_cond_broadcast (&loopback->rx.changed);
+		status = 0;
+	}
+
+	pthread_mutex_unlock (&loopback->lock);
+
+	return status;
+}
+
+/**
+ * Read a packet that was sent by the command channel.
+ *
+ * @param loopback The loopback channel to read from.
+ * @param packet Output for the packet that was sent.
+ * @param ms_timeout The amount of time to wait for a packet, in milliseconds.  A negative value
+ * will wait forever, and a value of 0 will return immediately.
+ *
+ * @return 0 if a packet was read successfully or an error code.
+ */
+int cmd_channel_loopback_read (struct cmd_channel_loopback *loopback, struct cmd_packet *packet,
+	int ms_timeout)
+{
+	platform_clock timeout;
+	int status = 0;
+
+	if ((loopback == NULL) || (packet == NULL)) {
+		return CMD_CHANNEL_INVALID_ARGUMENT;
+	}
+
+	if (ms_timeout > 0) {
+		platform_init_timeout (ms_timeout, &timeout);
+	}
+
+	pthread_mutex_lock (&loopback->lock);
+
+	while ((loopback->tx.count == 0) && !loopback->closed && (status == 0)) {
+		status = cmd_channel_loopback_wait (loopback, &loopback->tx, ms_timeout, &timeout);
+	}
+
+	if (loopback->tx.count != 0) {
+		cmd_channel_loopback_queue_pop (&loopback->tx, packet);
+		pthread_cond_broadcast (&loopback->tx.changed);
+		status = 0;
+	}
+	else if (loopback->closed) {
+		status = CMD_CHANNEL_RX_FAILED;
+	}
+	else {
+		status = CMD_CHANNEL_RX_TIMEOUT;
+	}
+
+	pthread_mutex_unlock (&loopback->lock);
+
+	return status;
+}
+
+/**
+ * Shut down a loopback channel.  Any threads waiting on the channel will be released, and all
+ * subsequent attempts to send packets will fail.  Packets already queued can still be read.
+ *
+ * @param loopback The loopback channel to shut down.
+ */
+void cmd_channel_loopback_shutdown (struct cmd_channel_loopback *loopback)
+{
+	if (loopback) {
+		pthread_mutex_lock (&loopback->lock);
+
+		loopback->closed = true;
+		pthread_cond_broadcast (&loopback->rx.changed);
+		pthread_cond_broadcast (&loopback->tx.changed);
+
+		pthread_mutex_unlock (&loopback->lock);
+	}
+}
@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef CMD_CHANNEL_LOOPBACK_H_
+#define CMD_CHANNEL_LOOPBACK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "cmd_interface/cmd_channel.h"
+
+
+/**
+ * The maximum number of packets that can be queued in each direction of a loopback channel.
+ */
+#ifndef CMD_CHANNEL_LOOPBACK_QUEUE_DEPTH
+#define	CMD_CHANNEL_LOOPBACK_QUEUE_DEPTH			64
+#endif
+
+
+/**
+ * A fixed-size FIFO of packets for one direction of a loopback channel.
+ */
+struct cmd_channel_loopback_queue {
+	struct cmd_packet packet[CMD_CHANNEL_LOOPBACK_QUEUE_DEPTH];	/**< Storage for queued packets. */
+	int head;												/**< Index of the oldest queued packet. */
+	int count;												/**< Number of packets in the queue. */
+	pthread_cond_t changed;									/**< Signal for queue state changes. */
+};
+
+/**
+ * A command channel that exchanges packets through in-process queues.  Packets injected by a local
+ * requester are received by the command channel, and packets sent by the command channel can be
+ * read back by the requester.  This allows the complete MCTP and command processing stack to be
+ * exercised without any physical bus.
+ */
+struct cmd_channel_loopback {
+	struct cmd_channel base;								/**< The base command channel. */
+	struct cmd_channel_loopback_queue rx;					/**< Packets waiting to be received by the channel. */
+	struct cmd_channel_loopback_queue tx;					/**< Packets sent by the channel. */
+	pthread_mutex_t lock;									/**< Synchronization for the packet queues. */
+	uint8_t address;										/**< SMBus address of the channel. */
+	bool closed;											/**< Flag indicating the channel has been shut down. */
+};
+
+
+int cmd_channel_loopback_init (struct cmd_channel_loopback *loopback, int id, uint8_t address);
+void cmd_channel_loopback_release (struct cmd_channel_loopback *loopback);
+
+int cmd_channel_loopback_inject (struct cmd_channel_loopback *loopback,
+	const struct cmd_packet *packets, size_t num_packets, int ms_timeout);
+int cmd_channel_loopback_read (struct cmd_channel_loopback *loopback, struct cmd_packet *packet,
+	int ms_timeout);
+void cmd_channel_loopback_shutdown (struct cmd_channel_loopback *loopback);
+
+
+#endif /* CMD_CHANNEL_LOOPBACK_H_ */
@@ -0,0 +1,800 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include "platform.h"
+#include "mctp/mctp_protocol.h"
+#include "cmd_interface/cerberus_protocol.h"
+#include "cmd_interface/cerberus_protocol_required_commands.h"
+#include "cmd_interface/cerberus_protocol_optional_commands.h"
+#include "cmd_load_generator.h"
+
+
+/**
+ * The maximum number of packets needed for a single request message.
+ */
+#define	CMD_LOAD_GENERATOR_MAX_PACKETS		\
+	((MCTP_PROTOCOL_MAX_MESSAGE_BODY + MCTP_PROTOCOL_MAX_TRANSMISSION_UNIT - 1) / \
+		MCTP_PROTOCOL_MAX_TRANSMISSION_UNIT)
+
+/**
+ * Amount of time a worker thread will block before checking if the run has been stopped.
+ */
+#define	CMD_LOAD_GENERATOR_POLL_MS			10
+
+
+struct cmd_load_generator_context;
+
+/**
+ * State for a single requester thread.
+ */
+struct cmd_load_generator_requester {
+	struct cmd_load_generator_context *context;	/**< The load generation context. */
+	pthread_t thread;							/**< The requester thread. */
+	bool running;								/**< Flag indicating the thread was started. */
+	uint8_t addr;								/**< SMBus address for the requester. */
+	unsigned int seed;							/**< Random seed for request selection. */
+	uint8_t msg_tag;							/**< Message tag of the outstanding request. */
+	uint8_t msg_type;							/**< Message type of the response being received. */
+	uint8_t response_cmd;						/**< Command code in the response. */
+	uint8_t error_code;							/**< Error code for an error response. */
+	bool pending;								/**< Flag indicating a response is expected. */
+	bool complete;								/**< Flag indicating the response was received. */
+	pthread_cond_t done;						/**< Signal for response completion. */
+	uint32_t *latency_us;						/**< Latency for each completed request. */
+	uint32_t sent[CMD_LOAD_GENERATOR_NUM_COMMANDS];	/**< Requests sent of each type. */
+	uint32_t completed;							/**< Requests that received a response. */
+	uint32_t errors;							/**< Responses that reported an error. */
+	uint32_t timeouts;							/**< Requests with no response. */
+};
+
+/**
+ * Shared context for a load generation run.
+ */
+struct cmd_load_generator_context {
+	struct cmd_channel_loopback *loopback;		/**< The channel used to send requests. */
+	struct mctp_interface *mctp;				/**< The MCTP layer processing requests. */
+	const struct cmd_load_generator_config *config;	/**< Settings for the run. */
+	uint32_t total_weight;						/**< Sum of all request weights. */
+	pthread_mutex_t lock;						/**< Synchronization for response tracking. */
+	pthread_mutex_t pfm_lock;					/**< Ensures a single PFM update is in progress. */
+	volatile bool stop;							/**< Flag to stop worker threads. */
+	struct cmd_load_generator_requester requester[CMD_LOAD_GENERATOR_MAX_THREADS];	/**< Requester state. */
+};
+
+
+/**
+ * Get the default settings for load generation.  The defaults represent a BMC polling for
+ * attestation data while periodically reading logs and updating the PFM.
+ *
+ * @param config The configuration to initialize.
+ */
+void cmd_load_generator_default_config (struct cmd_load_generator_config *config)
+{
+	if (config) {
+		memset (config, 0, sizeof (struct cmd_load_generator_config));
+
+		config->threads = 4;
+		config->requests = 1000;
+		config->weight[CMD_LOAD_GENERATOR_GET_DIGEST] = 40;
+		config->weight[CMD_LOAD_GENERATOR_GET_CERTIFICATE] = 20;
+		config->weight[CMD_LOAD_GENERATOR_CHALLENGE] = 20;
+		config->weight[CMD_LOAD_GENERATOR_READ_LOG] = 10;
+		config->weight[CMD_LOAD_GENERATOR_PFM_UPDATE] = 10;
+		config->device_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+		config->requester_eid = MCTP_PROTOCOL_BMC_EID;
+		config->requester_addr = 0x10;
+		config->pfm_chunk_len = 128;
+		config->pfm_chunks = 4;
+		config->response_timeout_ms = MCTP_PROTOCOL_MAX_CRYPTO_TIMEOUT_MS;
+	}
+}
+
+/**
+ * Get the current time in microseconds.
+ *
+ * @return The current monotonic time.
+ */
+static uint64_t cmd_load_generator_get_time_us (void)
+{
+	struct timespec now;
+
+	clock_gettime (CLOCK_MONOTONIC, &now);
+
+	return ((uint64_t) now.tv_sec * 1000000ULL) + (now.tv_nsec / 1000);
+}
+
+/**
+ * Select the type of the next request based on the configured weights.
+ *
+ * @param context The load generation context.
+ * @param requester The requester that will send the request.
+ *
+ * @return The type of request to send.
+ */
+static enum cmd_load_generator_command cmd_load_generator_select_command (
+	struct cmd_load_generator_context *context, struct cmd_load_generator_requester *requester)
+{
+	uint32_t pick = rand_r (&requester->seed) % context->total_weight;
+	int i;
+
+	for (i = 0; i < CMD_LOAD_GENERATOR_NUM_COMMANDS - 1; i++) {
+		if (pick < context->config->weight[i]) {
+			break;
+		}
+
+		pick -= context->config->weight[i];
+	}
+
+	return (enum cmd_load_generator_command) i;
+}
+
+/**
+ * Construct a Cerberus protocol request message.
+ *
+ * @param context The load generation context.
+ * @param requester The requester that will send the request.
+ * @param command The type of request to construct.
+ * @param msg Output buffer for the request message.
+ *
+ * @return The length of the request message.
+ */
+static size_t cmd_load_generator_build_request (struct cmd_load_generator_context *context,
+	struct cmd_load_generator_requester *requester, enum cmd_load_generator_command command,
+	uint8_t *msg)
+{
+	struct cerberus_protocol_header *header = (struct cerberus_protocol_header*) msg;
+	size_t i;
+
+	memset (msg, 0, MCTP_PROTOCOL_MAX_MESSAGE_BODY);
+	header->msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	header->pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+
+	switch (command) {
+		case CMD_LOAD_GENERATOR_GET_DIGEST: {
+			struct cerberus_protocol_get_certificate_digest *rq =
+				(struct cerberus_protocol_get_certificate_digest*) msg;
+
+			header->command = CERBERUS_PROTOCOL_GET_DIGEST;
+			rq->digest.slot_num = 0;
+			rq->digest.key_alg = ATTESTATION_ECDHE_KEY_EXCHANGE;
+
+			return sizeof (*rq);
+		}
+
+		case CMD_LOAD_GENERATOR_GET_CERTIFICATE: {
+			struct cerberus_protocol_get_certificate *rq =
+				(struct cerberus_protocol_get_certificate*) msg;
+
+			header->command = CERBERUS_PROTOCOL_GET_CERTIFICATE;
+			rq->certificate.slot_num = 0;
+			rq->certificate.cert_num = 0;
+			rq->certificate.offset = 0;
+			rq->certificate.length = 0;
+
+			return sizeof (*rq);
+		}
+
+		case CMD_LOAD_GENERATOR_CHALLENGE: {
+			struct cerberus_protocol_challenge *rq = (struct cerberus_protocol_challenge*) msg;
+
+			header->command = CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE;
+			rq->challenge.slot_num = 0;
+			for (i = 0; i < sizeof (rq->challenge.nonce); i++) {
+				rq->challenge.nonce[i] = rand_r (&requester->seed);
+			}
+
+			return sizeof (*rq);
+		}
+
+		case CMD_LOAD_GENERATOR_READ_LOG:
+		default: {
+			struct cerberus_protocol_get_log *rq = (struct cerberus_protocol_get_log*) msg;
+
+			header->command = CERBERUS_PROTOCOL_READ_LOG;
+			rq->log_type = CERBERUS_PROTOCOL_DEBUG_LOG;
+			rq->offset = 0;
+
+			return sizeof (*rq);
+		}
+	}
+}
+
+/**
+ * Construct one of the requests in a PFM update sequence.
+ *
+ * @param context The load generation context.
+ * @param command The Cerberus command for the request.  This must be one of the PFM update
+ * commands.
+ * @param msg Output buffer for the request message.
+ *
+ * @return The length of the request message.
+ */
+static size_t cmd_load_generator_build_pfm_request (struct cmd_load_generator_context *context,
+	uint8_t command, uint8_t *msg)
+{
+	struct cerberus_protocol_header *header = (struct cerberus_protocol_header*) msg;
+	size_t i;
+
+	memset (msg, 0, MCTP_PROTOCOL_MAX_MESSAGE_BODY);
+	header->msg_type = MCTP_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	header->pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	header->command = command;
+
+	switch (command) {
+		case CERBERUS_PROTOCOL_INIT_PFM_UPDATE: {
+			struct cerberus_protocol_prepare_pfm_update *rq =
+				(struct cerberus_protocol_prepare_pfm_update*) msg;
+
+			rq->port_id = 0;
+			rq->size = context->config->pfm_chunk_len * context->config->pfm_chunks;
+
+			return sizeof (*rq);
+		}
+
+		case CERBERUS_PROTOCOL_COMPLETE_PFM_UPDATE: {
+			struct cerberus_protocol_complete_pfm_update *rq =
+				(struct cerberus_protocol_complete_pfm_update*) msg;
+
+			rq->port_id = 0;
+			rq->activation = 0;
+
+			return sizeof (*rq);
+		}
+
+		case CERBERUS_PROTOCOL_PFM_UPDATE:
+		default: {
+			struct cerberus_protocol_pfm_update *rq = (struct cerberus_protocol_pfm_update*) msg;
+			uint8_t *payload = &rq->payload;
+
+			rq->port_id = 0;
+			for (i = 0; i < context->config->pfm_chunk_len; i++) {
+				payload[i] = i;
+			}
+
+			return sizeof (*rq) - sizeof (rq->payload) + context->config->pfm_chunk_len;
+		}
+	}
+}
+
+/**
+ * Split a request message into MCTP packets.
+ *
+ * @param context The load generation context.
+ * @param requester The requester that will send the request.
+ * @param msg The request message.
+ * @param length Length of the request message.
+ * @param packets Output for the request packets.
+ *
+ * @return The number of packets generated or an error code.
+ */
+static int cmd_load_generator_packetize (struct cmd_load_generator_context *context,
+	struct cmd_load_generator_requester *requester, uint8_t *msg, size_t length,
+	struct cmd_packet *packets)
+{
+	uint8_t msg_type;
+	size_t offset = 0;
+	size_t payload_len;
+	int num_packets = 0;
+	int status;
+
+	while (offset < length) {
+		payload_len = length - offset;
+		if (payload_len > MCTP_PROTOCOL_MAX_TRANSMISSION_UNIT) {
+			payload_len = MCTP_PROTOCOL_MAX_TRANSMISSION_UNIT;
+		}
+
+		status = mctp_protocol_construct (&msg[offset], payload_len, packets[num_packets].data,
+			sizeof (packets[num_packets].data), requester->addr, context->config->device_eid,
+			context->config->requester_eid, (offset == 0), ((offset + payload_len) == length),
+			num_packets % 4, requester->msg_tag, MCTP_PROTOCOL_TO_REQUEST,
+			context->loopback->address, &msg_type);
+		if (ROT_IS_ERROR (status)) {
+			return CMD_LOAD_GENERATOR_BAD_REQUEST;
+		}
+
+		packets[num_packets].pkt_size = status;
+		packets[num_packets].dest_addr = context->loopback->address;
+		packets[num_packets].state = CMD_VALID_PACKET;
+		packets[num_packets].timeout_valid = false;
+
+		offset += payload_len;
+		num_packets++;
+	}
+
+	return num_packets;
+}
+
+/**
+ * Send a single request and wait for the response.  The response latency is recorded if a
+ * response is received.
+ *
+ * @param context The load generation context.
+ * @param requester The requester sending the request.
+ * @param msg The request message.
+ * @param length Length of the request message.
+ *
+ * @return 0 if a successful response was received or an error code.
+ */
+static int cmd_load_generator_send_request (struct cmd_load_generator_context *context,
+	struct cmd_load_generator_requester *requester, uint8_t *msg, size_t length)
+{
+	struct cmd_packet packets[CMD_LOAD_GENERATOR_MAX_PACKETS];
+	platform_clock timeout;
+	uint64_t start;
+	int num_packets;
+	int status;
+
+	num_packets = cmd_load_generator_packetize (context, requester, msg, length, packets);
+	if (ROT_IS_ERROR (num_packets)) {
+		return num_packets;
+	}
+
+	pthread_mutex_lock (&context->lock);
+	requester->pending = true;
+	requester->complete = false;
+	pthread_mutex_unlock (&context->lock);
+
+	platform_init_timeout (context->config->response_timeout_ms, &timeout);
+	start = cmd_load_generator_get_time_us ();
+
+	status = cmd_channel_loopback_inject (context->loopback, packets, num_packets,
+		context->config->response_timeout_ms);
+
+	pthread_mutex_lock (&context->lock);
+
+	while ((status == 0) && !requester->complete) {
+		status = pthread_cond_timedwait (&requester->done, &context->lock, &timeout);
+	}
+
+	if (requester->complete) {
+		requester->latency_us[requester->completed++] =
+			cmd_load_generator_get_time_us () - start;
+
+		if ((requester->response_cmd == CERBERUS_PROTOCOL_ERROR) &&
+			(requester->error_code != CERBERUS_PROTOCOL_NO_ERROR)) {
+			requester->errors++;
+			status = CMD_LOAD_GENERATOR_ERROR_RESPONSE;
+		}
+		else {
+			status = 0;
+		}
+	}
+	else {
+		requester->pending = false;
+		requester->timeouts++;
+		status = CMD_LOAD_GENERATOR_NO_RESPONSE;
+	}
+
+	pthread_mutex_unlock (&context->lock);
+
+	requester->msg_tag = (requester->msg_tag + 1) % 8;
+
+	return status;
+}
+
+/**
+ * Run a PFM update by sending the init request, all data requests, and the complete request.  The
+ * update is stopped at the first request that fails.  Only one PFM update is run at a time, since
+ * the requests from concurrent updates would interfere with each other.
+ *
+ * @param context The load generation context.
+ * @param requester The requester running the update.
+ * @param msg Buffer to use for the request messages.
+ *
+ * @return 0 if the update completed successfully or an error code.
+ */
+static int cmd_load_generator_run_pfm_update (struct cmd_load_generator_context *context,
+	struct cmd_load_generator_requester *requester, uint8_t *msg)
+{
+	size_t length;
+	uint32_t i;
+	int status;
+
+	pthread_mutex_lock (&context->pfm_lock);
+
+	length = cmd_load_generator_build_pfm_request (context, CERBERUS_PROTOCOL_INIT_PFM_UPDATE,
+		msg);
+	status = cmd_load_generator_send_request (context, requester, msg, length);
+
+	for (i = 0; (i < context->config->pfm_chunks) && (status == 0); i++) {
+		length = cmd_load_generator_build_pfm_request (context, CERBERUS_PROTOCOL_PFM_UPDATE,
+			msg);
+		status = cmd_load_generator_send_request (context, requester, msg, length);
+	}
+
+	if (status == 0) {
+		length = cmd_load_generator_build_pfm_request (context,
+			CERBERUS_PROTOCOL_COMPLETE_PFM_UPDATE, msg);
+		status = cmd_load_generator_send_request (context, requester, msg, length);
+	}
+
+	pthread_mutex_unlock (&context->pfm_lock);
+	return status;
+}
+
+/**
+ * Thread that sends requests and waits for the responses.
+ *
+ * @param arg The requester state.
+ */
+static void* cmd_load_generator_requester_thread (void *arg)
+{
+	struct cmd_load_generator_requester *requester = arg;
+	struct cmd_load_generator_context *context = requester->context;
+	uint8_t msg[MCTP_PROTOCOL_MAX_MESSAGE_BODY];
+	enum cmd_load_generator_command command;
+	size_t length;
+	int status;
+	uint32_t i;
+
+	for (i = 0; (i < context->config->requests) && !context->stop; i++) {
+		command = cmd_load_generator_select_command (context, requester);
+		requester->sent[command]++;
+
+		if (command == CMD_LOAD_GENERATOR_PFM_UPDATE) {
+			status = cmd_load_generator_run_pfm_update (context, requester, msg);
+		}
+		else {
+			length = cmd_load_generator_build_request (context, requester, command, msg);
+			status = cmd_load_generator_send_request (context, requester, msg, length);
+		}
+
+		if (status == CMD_LOAD_GENERATOR_BAD_REQUEST) {
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Route a response packet to the requester it is addressed to.
+ *
+ * @param context The load generation context.
+ * @param packet The response packet.
+ */
+static void cmd_load_generator_handle_response (struct cmd_load_generator_context *context,
+	struct cmd_packet *packet)
+{
+	struct cmd_load_generator_requester *requester;
+	struct cerberus_protocol_header *header;
+	uint8_t source_addr;
+	uint8_t src_eid;
+	uint8_t dest_eid;
+	uint8_t *payload;
+	size_t payload_len;
+	uint8_t msg_tag;
+	uint8_t packet_seq;
+	uint8_t crc;
+	bool som;
+	bool eom;
+	int index;
+	int status;
+
+	index = packet->dest_addr - context->config->requester_addr;
+	if ((index < 0) || (index >= context->config->threads)) {
+		return;
+	}
+
+	requester = &context->requester[index];
+
+	pthread_mutex_lock (&context->lock);
+
+	status = mctp_protocol_interpret (packet->data, packet->pkt_size, packet->dest_addr,
+		&source_addr, &som, &eom, &src_eid, &dest_eid, &payload, &payload_len, &msg_tag,
+		&packet_seq, &crc, &requester->msg_type);
+	if ((status == 0) && requester->pending && (msg_tag == requester->msg_tag)) {
+		if (som) {
+			header = (struct cerberus_protocol_header*) payload;
+
+			requester->response_cmd = 0;
+			requester->error_code = CERBERUS_PROTOCOL_NO_ERROR;
+
+			if (payload_len >= sizeof (struct cerberus_protocol_header)) {
+				requester->response_cmd = header->command;
+			}
+			if (payload_len >= sizeof (struct cerberus_protocol_error)) {
+				requester->error_code = ((struct cerberus_protocol_error*) payload)->error_code;
+			}
+		}
+
+		if (eom) {
+			requester->pending = false;
+			requester->complete = true;
+			pthread_cond_signal (&requester->done);
+		}
+	}
+
+	pthread_mutex_unlock (&context->lock);
+}
+
+/**
+ * Thread that reads response packets from the channel.
+ *
+ * @param arg The load generation context.
+ */
+static void* cmd_load_generator_response_thread (void *arg)
+{
+	struct cmd_load_generator_context *context = arg;
+	struct cmd_packet packet;
+	int status;
+
+	while (!context->stop) {
+		status = cmd_channel_loopback_read (context->loopback, &packet,
+			CMD_LOAD_GENERATOR_POLL_MS);
+		if (status == 0) {
+			cmd_load_generator_handle_response (context, &packet);
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Thread that processes requests received by the channel.
+ *
+ * @param arg The load generation context.
+ */
+static void* cmd_load_generator_device_thread (void *arg)
+{
+	struct cmd_load_generator_context *context = arg;
+
+	while (!context->stop) {
+		cmd_channel_receive_and_process (&context->loopback->base, context->mctp,
+			CMD_LOAD_GENERATOR_POLL_MS);
+	}
+
+	return NULL;
+}
+
+/**
+ * Compare two latency values for sorting.
+ */
+static int cmd_load_generator_compare_latency (const void *a, const void *b)
+{
+	uint32_t first = *((const uint32_t*) a);
+	uint32_t second = *((const uint32_t*) b);
+
+	return (first > second) - (first < second);
+}
+
+/**
+ * Aggregate the results from all requester threads.
+ *
+ * @param context The load generation context.
+ * @param results Output for the aggregated results.
+ *
+ * @return 0 if the results were generated successfully or an error code.
+ */
+static int cmd_load_generator_collect_results (struct cmd_load_generator_context *context,
+	struct cmd_load_generator_results *results)
+{
+	uint32_t *latency;
+	uint32_t count = 0;
+	int i;
+	int j;
+
+	for (i = 0; i < context->config->threads; i++) {
+		for (j = 0; j < CMD_LOAD_GENERATOR_NUM_COMMANDS; j++) {
+			results->sent[j] += context->requester[i].sent[j];
+		}
+
+		results->completed += context->requester[i].completed;
+		results->errors += context->requester[i].errors;
+		results->timeouts += context->requester[i].timeouts;
+	}
+
+	if (results->elapsed_us != 0) {
+		results->msgs_per_sec = ((uint64_t) results->completed * 1000000ULL) / results->elapsed_us;
+	}
+
+	if (results->completed == 0) {
+		return 0;
+	}
+
+	latency = platform_malloc (results->completed * sizeof (uint32_t));
+	if (latency == NULL) {
+		return CMD_LOAD_GENERATOR_NO_MEMORY;
+	}
+
+	for (i = 0; i < context->config->threads; i++) {
+		memcpy (&latency[count], context->requester[i].latency_us,
+			context->requester[i].completed * sizeof (uint32_t));
+		count += context->requester[i].completed;
+	}
+
+	qsort (latency, count, sizeof (uint32_t), cmd_load_generator_compare_latency);
+
+	results->latency_p50_us = latency[((count - 1) * 50) / 100];
+	results->latency_p90_us = latency[((count - 1) * 90) / 100];
+	results->latency_p99_us = latency[((count - 1) * 99) / 100];
+	results->latency_max_us = latency[count - 1];
+
+	platform_free (latency);
+
+	return 0;
+}
+
+/**
+ * Generate a stream of concurrent requests through a loopback channel and measure the throughput
+ * and latency of request processing.  A thread is created to process received packets with the
+ * MCTP layer, so the channel must not be serviced by any other thread during the run.
+ *
+ * @param loopback The loopback channel connected to the MCTP layer.
+ * @param mctp The MCTP layer that will process the requests.
+ * @param config Settings for the requests to generate.
+ * @param results Output for the measurements collected during the run.
+ *
+ * @return 0 if the run completed successfully or an error code.  Individual request failures are
+ * reported in the results and do not cause the run to fail.
+ */
+int cmd_load_generator_run (struct cmd_channel_loopback *loopback, struct mctp_interface *mctp,
+	const struct cmd_load_generator_config *config, struct cmd_load_generator_results *results)
+{
+	struct cmd_load_generator_context *context;
+	pthread_condattr_t attr;
+	pthread_t device;
+	pthread_t responder;
+	uint64_t start;
+	size_t max_request;
+	size_t max_messages = 1;
+	int status = 0;
+	int i;
+
+	if ((loopback == NULL) || (mctp == NULL) || (config == NULL) || (results == NULL) ||
+		(config->threads <= 0) || (config->threads > CMD_LOAD_GENERATOR_MAX_THREADS) ||
+		((config->requester_addr + config->threads) > 0x80)) {
+		return CMD_LOAD_GENERATOR_INVALID_ARGUMENT;
+	}
+
+	max_request = sizeof (struct cerberus_protocol_pfm_update) - 1 + config->pfm_chunk_len;
+	if ((max_request > MCTP_PROTOCOL_MAX_MESSAGE_BODY) ||
+		(config->pfm_chunks > (UINT32_MAX / MCTP_PROTOCOL_MAX_MESSAGE_BODY))) {
+		return CMD_LOAD_GENERATOR_INVALID_ARGUMENT;
+	}
+
+	if (config->weight[CMD_LOAD_GENERATOR_PFM_UPDATE] != 0) {
+		/* Each PFM update sends an init and complete request in addition to the data. */
+		max_messages = config->pfm_chunks + 2;
+	}
+
+	memset (results, 0, sizeof (struct cmd_load_generator_results));
+
+	context = platform_calloc (1, sizeof (struct cmd_load_generator_context));
+	if (context == NULL) {
+		return CMD_LOAD_GENERATOR_NO_MEMORY;
+	}
+
+	context->loopback = loopback;
+	context->mctp = mctp;
+	context->config = config;
+
+	for (i = 0; i < CMD_LOAD_GENERATOR_NUM_COMMANDS; i++) {
+		context->total_weight += config->weight[i];
+	}
+
+	if (context->total_weight == 0) {
+		status = CMD_LOAD_GENERATOR_INVALID_ARGUMENT;
+		goto exit;
+	}
+
+	pthread_mutex_init (&context->lock, NULL);
+	pthread_mutex_init (&context->pfm_lock, NULL);
+
+	pthread_condattr_init (&attr);
+	pthread_condattr_setclock (&attr, CLOCK_MONOTONIC);
+
+	for (i = 0; i < config->threads; i++) {
+		context->requester[i].context = context;
+		context->requester[i].addr = config->requester_addr + i;
+		context->requester[i].seed = i + 1;
+		pthread_cond_init (&context->requester[i].done, &attr);
+
+		context->requester[i].latency_us = platform_calloc (config->requests * max_messages,
+			sizeof (uint32_t));
+		if ((context->requester[i].latency_us == NULL) && (config->requests != 0)) {
+			status = CMD_LOAD_GENERATOR_NO_MEMORY;
+		}
+	}
+
+	pthread_condattr_destroy (&attr);
+
+	if (status != 0) {
+		goto exit_requesters;
+	}
+
+	if (pthread_create (&device, NULL, cmd_load_generator_device_thread, context) != 0) {
+		status = CMD_LOAD_GENERATOR_THREAD_FAILED;
+		goto exit_requesters;
+	}
+
+	if (pthread_create (&responder, NULL, cmd_load_generator_response_thread, context) != 0) {
+		status = CMD_LOAD_GENERATOR_THREAD_FAILED;
+		goto exit_device;
+	}
+
+	start = cmd_load_generator_get_time_us ();
+
+	for (i = 0; i < config->threads; i++) {
+		if (pthread_create (&context->requester[i].thread, NULL,
+			cmd_load_generator_requester_thread, &context->requester[i]) != 0) {
+			status = CMD_LOAD_GENERATOR_THREAD_FAILED;
+			context->stop = true;
+			break;
+		}
+
+		context->requester[i].running = true;
+	}
+
+	for (i = 0; i < config->threads; i++) {
+		if (context->requester[i].running) {
+			pthread_join (context->requester[i].thread, NULL);
+		}
+	}
+
+	results->elapsed_us = cmd_load_generator_get_time_us () - start;
+
+	context->stop = true;
+	pthread_join (responder, NULL);
+
+exit_device:
+	context->stop = true;
+	pthread_join (device, NULL);
+
+	if (status == 0) {
+		status = cmd_load_generator_collect_results (context, results);
+	}
+
+exit_requesters:
+	for (i = 0; i < config->threads; i++) {
+		pthread_cond_destroy (&context->requester[i].done);
+		platform_free (context->requester[i].latency_us);
+	}
+
+	pthread_mutex_destroy (&context->lock);
+	pthread_mutex_destroy (&context->pfm_lock);
+
+exit:
+	platform_free (context);
+	return status;
+}
+
+/**
+ * Print a summary of load generation results.
+ *
+ * @param results The results to print.
+ * @param out The stream to write the summary to.
+ */
+void cmd_load_generator_print_results (const struct cmd_load_generator_results *results,
+	FILE *out)
+{
+	static const char *name[CMD_LOAD_GENERATOR_NUM_COMMANDS] = {
+		"GET_DIGEST", "GET_CERTIFICATE", "CHALLENGE", "READ_LOG", "PFM_UPDATE"
+	};
+	int i;
+
+	if ((results == NULL) || (out == NULL)) {
+		return;
+	}
+
+	for (i = 0; i < CMD_LOAD_GENERATOR_NUM_COMMANDS; i++) {
+		fprintf (out, "%-16s %u\n", name[i], results->sent[i]);
+	}
+
+	fprintf (out, "completed        %u\n", results->completed);
+	fprintf (out, "errors           %u\n", results->errors);
+	fprintf (out, "timeouts         %u\n", results->timeouts);
+	fprintf (out, "elapsed          %llu us\n", (unsigned long long) results->elapsed_us);
+	fprintf (out, "throughput       %u msg/s\n", results->msgs_per_sec);
+	fprintf (out, "latency p50      %u us\n", results->latency_p50_us);
+	fprintf (out, "latency p90      %u us\n", results->latency_p90_us);
+	fprintf (out, "latency p99      %u us\n", results->latency_p99_us);
+	fprintf (out, "latency max      %u us\n", results->latency_max_us);
+}
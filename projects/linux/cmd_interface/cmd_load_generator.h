@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef CMD_LOAD_GENERATOR_H_
+#define CMD_LOAD_GENERATOR_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "status/rot_status.h"
+#include "mctp/mctp_interface.h"
+#include "cmd_channel_loopback.h"
+
+
+/**
+ * The maximum number of requester threads that can be used to generate load.
+ */
+#ifndef CMD_LOAD_GENERATOR_MAX_THREADS
+#define	CMD_LOAD_GENERATOR_MAX_THREADS				16
+#endif
+
+
+/**
+ * The types of requests that can be generated.
+ */
+enum cmd_load_generator_command {
+	CMD_LOAD_GENERATOR_GET_DIGEST = 0,				/**< Get certificate digests for slot 0. */
+	CMD_LOAD_GENERATOR_GET_CERTIFICATE,				/**< Get the first certificate in slot 0. */
+	CMD_LOAD_GENERATOR_CHALLENGE,					/**< Attestation challenge with a random nonce. */
+	CMD_LOAD_GENERATOR_READ_LOG,					/**< Read the start of the debug log. */
+	CMD_LOAD_GENERATOR_PFM_UPDATE,					/**< Run a complete PFM update. */
+	CMD_LOAD_GENERATOR_NUM_COMMANDS					/**< The number of request types. */
+};
+
+/**
+ * Settings for a single load generation run.
+ */
+struct cmd_load_generator_config {
+	int threads;									/**< Number of concurrent requester threads. */
+	uint32_t requests;								/**< Number of requests sent by each thread. */
+	uint32_t weight[CMD_LOAD_GENERATOR_NUM_COMMANDS];	/**< Relative frequency of each request type. */
+	uint8_t device_eid;								/**< EID of the device processing requests. */
+	uint8_t requester_eid;							/**< EID used by all requester threads. */
+	uint8_t requester_addr;							/**< SMBus address of the first requester thread.
+														Each thread uses the next address. */
+	size_t pfm_chunk_len;							/**< Amount of data in each PFM update request. */
+	uint32_t pfm_chunks;							/**< Number of data requests in each PFM update. */
+	int response_timeout_ms;						/**< Time to wait for each response. */
+};
+
+/**
+ * Results from a load generation run.  Latencies are measured from the time a request is queued
+ * until the last packet of the response is received.
+ *
+ * A PFM update is a sequence of an init request, the data requests, and a complete request.  Each
+ * request in the sequence is counted separately in the completed, error, and timeout counts.
+ */
+struct cmd_load_generator_results {
+	uint32_t sent[CMD_LOAD_GENERATOR_NUM_COMMANDS];	/**< Number of operations started of each type. */
+	uint32_t completed;								/**< Number of requests that received a response. */
+	uint32_t errors;								/**< Number of responses that reported an error. */
+	uint32_t timeouts;								/**< Number of requests that received no response. */
+	uint64_t elapsed_us;							/**< Total time for the run. */
+	uint32_t msgs_per_sec;							/**< Completed requests per second. */
+	uint32_t latency_p50_us;						/**< Median response latency. */
+	uint32_t latency_p90_us;						/**< 90th percentile response latency. */
+	uint32_t latency_p99_us;						/**< 99th percentile response latency. */
+	uint32_t latency_max_us;						/**< Longest response latency. */
+};
+
+
+void cmd_load_generator_default_config (struct cmd_load_generator_config *config);
+int cmd_load_generator_run (struct cmd_channel_loopback *loopback, struct mctp_interface *mctp,
+	const struct cmd_load_generator_config *config, struct cmd_load_generator_results *results);
+void cmd_load_generator_print_results (const struct cmd_load_generator_results *results,
+	FILE *out);
+
+
+#define	CMD_LOAD_GENERATOR_ERROR(code)		ROT_ERROR (ROT_MODULE_CMD_LOAD_GENERATOR, code)
+
+/**
+ * Error codes that can be generated by the command load generator.
+ */
+enum {
+	CMD_LOAD_GENERATOR_INVALID_ARGUMENT = CMD_LOAD_GENERATOR_ERROR (0x00),	/**< Input parameter is null or not valid. */
+	CMD_LOAD_GENERATOR_NO_MEMORY = CMD_LOAD_GENERATOR_ERROR (0x01),			/**< Memory allocation failed. */
+	CMD_LOAD_GENERATOR_THREAD_FAILED = CMD_LOAD_GENERATOR_ERROR (0x02),		/**< A worker thread could not be started. */
+	CMD_LOAD_GENERATOR_BAD_REQUEST = CMD_LOAD_GENERATOR_ERROR (0x03),		/**< A request could not be constructed. */
+	CMD_LOAD_GENERATOR_NO_RESPONSE = CMD_LOAD_GENERATOR_ERROR (0x04),		/**< No response was received for a request. */
+	CMD_LOAD_GENERATOR_ERROR_RESPONSE = CMD_LOAD_GENERATOR_ERROR (0x05),	/**< The response to a request reported an error. */
+};
+
+
+#endif /* CMD_LOAD_GENERATOR_H_ */
@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stdio.h>
+#include "cmd_interface/cmd_interface.h"
+#include "cmd_stats_linux.h"
+
+
+/**
+ * Write all collected command and channel statistics as CSV.  Command statistics are reported
+ * for every command ID that has been processed, followed by the counters for each registered
+ * command channel.
+ *
+ * @param stats The statistics to dump.
+ * @param out The stream to write the statistics to.
+ *
+ * @return 0 if the statistics were written successfully or an error code.
+ */
+int cmd_stats_linux_dump (struct cmd_stats *stats, FILE *out)
+{
+	struct cmd_stats_command cmd;
+	struct cmd_channel_stats channel;
+	int id;
+	int i;
+
+	if ((stats == NULL) || (out == NULL)) {
+		return CMD_HANDLER_INVALID_ARGUMENT;
+	}
+
+	fprintf (out, "command,requests,failures,total_ms,max_ms");
+	for (i = 0; i < CMD_STATS_LATENCY_BUCKETS; i++) {
+		fprintf (out, ",ge_%ums", (i == 0) ? 0 : (1U << (i - 1)));
+	}
+	fprintf (out, "\n");
+
+	for (id = 0; id < 256; id++) {
+		cmd_stats_get_command (stats, id, &cmd);
+		if (cmd.requests == 0) {
+			continue;
+		}
+
+		fprintf (out, "0x%02x,%u,%u,%u,%u", id, cmd.requests, cmd.failures, cmd.total_time_ms,
+			cmd.max_time_ms);
+		for (i = 0; i < CMD_STATS_LATENCY_BUCKETS; i++) {
+			fprintf (out, ",%u", cmd.latency[i]);
+		}
+		fprintf (out, "\n");
+	}
+
+	fprintf (out, "untracked,%d\n\n", cmd_stats_get_untracked (stats));
+
+	fprintf (out,
+		"channel,rx_packets,rx_errors,rx_timeouts,dropped,overflow,tx_packets,tx_errors,timeouts\n");
+	for (i = 0; i < CMD_STATS_MAX_CHANNELS; i++) {
+		if (cmd_channel_get_stats (stats->channel[i], &channel) != 0) {
+			continue;
+		}
+
+		fprintf (out, "%d,%u,%u,%u,%u,%u,%u,%u,%u\n", stats->channel[i]->id, channel.rx_packets,
+			channel.rx_errors, channel.rx_timeouts, channel.dropped, channel.overflow,
+			channel.tx_packets, channel.tx_errors, channel.timeouts);
+	}
+
+	return (ferror (out)) ? CMD_HANDLER_PROCESS_FAILED : 0;
+}
@@ -0,0 +1,14 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef CMD_STATS_LINUX_H_
+#define CMD_STATS_LINUX_H_
+
+#include <stdio.h>
+#include "cmd_interface/cmd_stats.h"
+
+
+int cmd_stats_linux_dump (struct cmd_stats *stats, FILE *out);
+
+
+#endif /* CMD_STATS_LINUX_H_ */
@@ -374,9 +374,23 @@ static int ecc_openssl_get_public_key_der (struct ecc_engine *engine,
 }
 #endif
 
+/**
+ * Get the curve used by an ECC key.
+ *
+ * @param key The key to query.
+ *
+ * @return The NID for the key curve.
+ */
+static int ecc_openssl_get_curve (struct ecc_private_key *key)
+{
+	return EC_GROUP_get_curve_name (EC_KEY_get0_group ((EC_KEY*) key->context));
+}
+
 static int ecc_openssl_sign (struct ecc_engine *engine, struct ecc_private_key *key,
 	const uint8_t *digest, size_t length, uint8_t *signature, size_t sig_length)
 {
+	struct ecc_engine_openssl *openssl = (struct ecc_engine_openssl*) engine;
+	struct ecc_openssl_sign_precompute *entry;
 	unsigned int out_len;
 	int status;
 
@@ -391,11 +405,58 @@ static int ecc_openssl_sign (struct ecc_engine *engine, struct ecc_private_key *
 
 	ERR_clear_error ();
 
-	status = ECDSA_sign (NID_sha256, digest, length, signature, &out_len, (EC_KEY*) key->context);
+	if ((openssl->sign_pool_count != 0) &&
+		(openssl->sign_pool[openssl->sign_pool_count - 1].curve == ecc_openssl_get_curve (key))) {
+		/* The precomputed values are consumed whether or not the signature succeeds. */
+		openssl->sign_pool_count--;
+		entry = &openssl->sign_pool[openssl->sign_pool_count];
+
+		status = ECDSA_sign_ex (NID_sha256, digest, length, signature, &out_len, entry->k_inv,
+			entry->r, (EC_KEY*) key->context);
+
+		BN_clear_free (entry->k_inv);
+		BN_clear_free (entry->r);
+		entry->k_inv = NULL;
+		entry->r = NULL;
+	}
+	else {
+		status = ECDSA_sign (NID_sha256, digest, length, signature, &out_len,
+			(EC_KEY*) key->context);
+	}
 
 	return (status == 1) ? out_len : -ERR_get_error ();
 }
 
+static int ecc_openssl_precompute_sign (struct ecc_engine *engine, struct ecc_private_key *key,
+	size_t count)
+{
+	struct ecc_engine_openssl *openssl = (struct ecc_engine_openssl*) engine;
+	struct ecc_openssl_sign_precompute *entry;
+	size_t added = 0;
+	int status;
+
+	if ((openssl == NULL) || (key == NULL)) {
+		return ECC_ENGINE_INVALID_ARGUMENT;
+	}
+
+	ERR_clear_error ();
+
+	while ((added < count) && (openssl->sign_pool_count < ECC_OPENSSL_SIGN_POOL_SIZE)) {
+		entry = &openssl->sign_pool[openssl->sign_pool_count];
+
+		status = ECDSA_sign_setup ((EC_KEY*) key->context, NULL, &entry->k_inv, &entry->r);
+		if (status != 1) {
+			return -ERR_get_error ();
+		}
+
+		entry->curve = ecc_openssl_get_curve (key);
+		openssl->sign_pool_count++;
+		added++;
+	}
+
+	return added;
+}
+
 static int ecc_openssl_verify (struct ecc_engine *engine, struct ecc_public_key *key,
 	const uint8_t *digest, size_t length, const uint8_t *signature, size_t sig_length)
 {
@@ -477,6 +538,7 @@ int ecc_openssl_init (struct ecc_engine_openssl *engine)
 	engine->base.get_public_key_der = ecc_openssl_get_public_key_der;
 #endif
 	engine->base.sign = ecc_openssl_sign;
+	engine->base.precompute_sign = ecc_openssl_precompute_sign;
 	engine->base.verify = ecc_openssl_verify;
 #ifdef ECC_ENABLE_ECDH
 	engine->base.get_shared_secret_max_length = ecc_openssl_get_shared_secret_max_length;
@@ -493,5 +555,14 @@ int ecc_openssl_init (struct ecc_engine_openssl *engine)
  */
 void ecc_openssl_release (struct ecc_engine_openssl *engine)
 {
+	size_t i;
 
+	if (engine) {
+		for (i = 0; i < engine->sign_pool_count; i++) {
+			BN_clear_free (engine->sign_pool[i].k_inv);
+			BN_clear_free (engine->sign_pool[i].r);
+		}
+
+		engine->sign_pool_count = 0;
+	}
 }
@@ -4,14 +4,32 @@
 #ifndef ECC_OPENSSL_H_
 #define ECC_OPENSSL_H_
 
+#include <openssl/bn.h>
 #include "crypto/ecc.h"
 
 
+/* Configurable ECC parameters.  Defaults can be overridden in platform_config.h. */
+#ifndef ECC_OPENSSL_SIGN_POOL_SIZE
+#define	ECC_OPENSSL_SIGN_POOL_SIZE		4
+#endif
+
+
+/**
+ * Values precomputed for a single ECDSA signature.
+ */
+struct ecc_openssl_sign_precompute {
+	int curve;					/**< The curve the values were computed for. */
+	BIGNUM *k_inv;				/**< The inverse of the random nonce. */
+	BIGNUM *r;					/**< The signature r value for the random nonce. */
+};
+
 /**
  * An OpenSSL context for ECC operations.
  */
 struct ecc_engine_openssl {
 	struct ecc_engine base;		/**< The base ECC engine. */
+	struct ecc_openssl_sign_precompute sign_pool[ECC_OPENSSL_SIGN_POOL_SIZE];	/**< Precomputed signatures. */
+	size_t sign_pool_count;		/**< Number of precomputed signing values available. */
 };
 
 
@@ -56,6 +56,30 @@ static int hash_openssl_calculate_sha256 (struct hash_engine *engine, const uint
 	return 0;
 }
 
+static int hash_openssl_calculate_sha256_multi (struct hash_engine *engine,
+	const struct hash_multi_buffer *buffers, size_t count)
+{
+	struct hash_engine_openssl *openssl = (struct hash_engine_openssl*) engine;
+	size_t i;
+
+	if ((openssl == NULL) || (buffers == NULL) || (count == 0)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	for (i = 0; i < count; i++) {
+		if ((buffers[i].data == NULL) || (buffers[i].hash == NULL) || (buffers[i].length == 0)) {
+			return HASH_ENGINE_INVALID_ARGUMENT;
+		}
+
+		if (buffers[i].hash_length < SHA256_HASH_LENGTH) {
+			return HASH_ENGINE_HASH_BUFFER_TOO_SMALL;
+		}
+	}
+
+	sha256_multi_calculate (openssl->multi, buffers, count);
+	return 0;
+}
+
 static int hash_openssl_start_sha256 (struct hash_engine *engine)
 {
 	struct hash_engine_openssl *openssl = (struct hash_engine_openssl*) engine;
@@ -190,11 +214,14 @@ int hash_openssl_init (struct hash_engine_openssl *engine)
 	engine->base.start_sha1 = hash_openssl_start_sha1;
 #endif
 	engine->base.calculate_sha256 = hash_openssl_calculate_sha256;
+	engine->base.calculate_sha256_multi = hash_openssl_calculate_sha256_multi;
 	engine->base.start_sha256 = hash_openssl_start_sha256;
 	engine->base.update = hash_openssl_update;
 	engine->base.finish = hash_openssl_finish;
 	engine->base.cancel = hash_openssl_cancel;
 
+	engine->multi = sha256_multi_get_best_impl ();
+
 	return 0;
 }
 
@@ -6,6 +6,7 @@
 
 #include <openssl/sha.h>
 #include "crypto/hash.h"
+#include "sha256_multi.h"
 
 
 /**
@@ -18,6 +19,7 @@ struct hash_engine_openssl {
 #endif
 	SHA256_CTX sha256;			/**< The context for calculating SHA256 incremental hashes. */
 	int active;					/**< The type of initialized context. */
+	enum sha256_multi_impl multi;	/**< The implementation to use for multi-buffer hashing. */
 };
 
 
@@ -23,6 +23,19 @@ static int rng_openssl_generate_random_buffer (struct rng_engine *engine, size_t
 	return 0;
 }
 
+static int rng_openssl_reseed (struct rng_engine *engine)
+{
+	if (engine == NULL) {
+		return RNG_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (!RAND_poll ()) {
+		return RNG_ENGINE_RESEED_FAILED;
+	}
+
+	return 0;
+}
+
 /**
  * Initialize an OpenSSL engine for generating random numbers.
  *
@@ -37,6 +50,7 @@ int rng_openssl_init (struct rng_engine_openssl *engine)
 	}
 
 	engine->base.generate_random_buffer = rng_openssl_generate_random_buffer;
+	engine->base.reseed = rng_openssl_reseed;
 
 	return 0;
 }
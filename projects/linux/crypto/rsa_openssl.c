@@ -297,9 +297,67 @@ err_key:
 	return status;
 }
 
+/**
+ * Get a parsed context for a public key.  Keys that have been recently used are taken from the
+ * engine cache.  Otherwise, the key is parsed and replaces the least recently used cache entry.
+ * The key cache lock must be held.
+ *
+ * @param engine The RSA engine to use for the key.
+ * @param key The public key to load.
+ * @param rsa Output for the parsed key context.  This is owned by the engine and is only valid
+ * while the key cache lock is held.
+ *
+ * @return 0 if the operation was successful or an error code.
+ */
+static int rsa_openssl_get_cached_pubkey (struct rsa_engine_openssl *engine,
+	const struct rsa_public_key *key, RSA **rsa)
+{
+	struct rsa_openssl_key_cache_entry *entry = &engine->key_cache[0];
+	int i;
+	int status;
+
+	engine->key_use++;
+
+	for (i = 0; i < RSA_OPENSSL_KEY_CACHE_SIZE; i++) {
+		if (engine->key_cache[i].rsa && rsa_same_public_key (&engine->key_cache[i].key, key)) {
+			engine->key_cache[i].last_use = engine->key_use;
+			*rsa = engine->key_cache[i].rsa;
+			return 0;
+		}
+	}
+
+	for (i = 0; i < RSA_OPENSSL_KEY_CACHE_SIZE; i++) {
+		if (engine->key_cache[i].rsa == NULL) {
+			entry = &engine->key_cache[i];
+			break;
+		}
+
+		if ((engine->key_use - engine->key_cache[i].last_use) >
+			(engine->key_use - entry->last_use)) {
+			entry = &engine->key_cache[i];
+		}
+	}
+
+	RSA_free (entry->rsa);
+	entry->rsa = NULL;
+
+	status = rsa_openssl_load_pubkey (&entry->rsa, key);
+	if (status != 0) {
+		entry->rsa = NULL;
+		return status;
+	}
+
+	memcpy (&entry->key, key, sizeof (entry->key));
+	entry->last_use = engine->key_use;
+
+	*rsa = entry->rsa;
+	return 0;
+}
+
 static int rsa_openssl_sig_verify (struct rsa_engine *engine, const struct rsa_public_key *key,
 	const uint8_t *signature, size_t sig_length, const uint8_t *match, size_t match_length)
 {
+	struct rsa_engine_openssl *openssl = (struct rsa_engine_openssl*) engine;
 	RSA *rsa;
 	int status;
 
@@ -308,14 +366,20 @@ static int rsa_openssl_sig_verify (struct rsa_engine *engine, const struct rsa_p
 		return RSA_ENGINE_INVALID_ARGUMENT;
 	}
 
-	status = rsa_openssl_load_pubkey (&rsa, key);
+	/* The cached context must stay locked while it is in use so it can't be evicted by a
+	 * concurrent verification. */
+	platform_mutex_lock (&openssl->key_lock);
+
+	status = rsa_openssl_get_cached_pubkey (openssl, key, &rsa);
 	if (status != 0) {
+		platform_mutex_unlock (&openssl->key_lock);
 		return status;
 	}
 
 	status = RSA_verify (NID_sha256, match, match_length, signature, sig_length, rsa);
 
-	RSA_free (rsa);
+	platform_mutex_unlock (&openssl->key_lock);
+
 	return (status == 1) ? 0 : RSA_ENGINE_BAD_SIGNATURE;
 }
 
@@ -343,7 +407,7 @@ int rsa_openssl_init (struct rsa_engine_openssl *engine)
 	engine->base.decrypt = rsa_openssl_decrypt;
 	engine->base.sig_verify = rsa_openssl_sig_verify;
 
-	return 0;
+	return platform_mutex_init (&engine->key_lock);
 }
 
 /**
@@ -353,5 +417,30 @@ int rsa_openssl_init (struct rsa_engine_openssl *engine)
  */
 void rsa_openssl_release (struct rsa_engine_openssl *engine)
 {
+	if (engine) {
+		rsa_openssl_flush_key_cache (engine);
+		platform_mutex_free (&engine->key_lock);
+	}
+}
+
+/**
+ * Discard all parsed public keys cached by an openssl RSA engine.  The next verification with each
+ * key will need to parse the key again.
+ *
+ * @param engine The RSA engine to update.
+ */
+void rsa_openssl_flush_key_cache (struct rsa_engine_openssl *engine)
+{
+	int i;
+
+	if (engine) {
+		platform_mutex_lock (&engine->key_lock);
 
+		for (i = 0; i < RSA_OPENSSL_KEY_CACHE_SIZE; i++) {
+			RSA_free (engine->key_cache[i].rsa);
+			engine->key_cache[i].rsa = NULL;
+		}
+
+		platform_mutex_unlock (&engine->key_lock);
+	}
 }
@@ -4,19 +4,45 @@
 #ifndef RSA_OPENSSL_H_
 #define RSA_OPENSSL_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+#include <openssl/rsa.h>
+#include "platform.h"
 #include "crypto/rsa.h"
 
 
+/**
+ * The number of parsed public keys kept by the engine for signature verification.
+ */
+#ifndef RSA_OPENSSL_KEY_CACHE_SIZE
+#define	RSA_OPENSSL_KEY_CACHE_SIZE		4
+#endif
+
+
+/**
+ * A parsed public key that can be reused for signature verification.
+ */
+struct rsa_openssl_key_cache_entry {
+	struct rsa_public_key key;	/**< The public key loaded in the context. */
+	RSA *rsa;					/**< The parsed key, including cached Montgomery values. */
+	uint32_t last_use;			/**< Usage count when the key was last used. */
+};
+
 /**
  * An openssl context for RSA encryption.
  */
 struct rsa_engine_openssl {
 	struct rsa_engine base;		/**< The base RSA engine. */
+	struct rsa_openssl_key_cache_entry key_cache[RSA_OPENSSL_KEY_CACHE_SIZE];	/**< Recently used public keys. */
+	uint32_t key_use;			/**< Counter for tracking least recently used keys. */
+	platform_mutex key_lock;	/**< Synchronization for the public key cache. */
 };
 
 
 int rsa_openssl_init (struct rsa_engine_openssl *engine);
 void rsa_openssl_release (struct rsa_engine_openssl *engine);
 
+void rsa_openssl_flush_key_cache (struct rsa_engine_openssl *engine);
+
 
 #endif /* RSA_OPENSSL_H_ */
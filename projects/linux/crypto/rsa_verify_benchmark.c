@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "rsa_verify_benchmark.h"
+
+
+/**
+ * Get the current time in microseconds.
+ *
+ * @return The current monotonic time.
+ */
+static uint64_t rsa_verify_benchmark_get_time_us (void)
+{
+	struct timespec now;
+
+	clock_gettime (CLOCK_MONOTONIC, &now);
+
+	return ((uint64_t) now.tv_sec * 1000000ULL) + (now.tv_nsec / 1000);
+}
+
+/**
+ * Measure the rate at which an RSA engine can verify signatures.  Run once with a flush handler
+ * and once without to compare the cost of parsing the key on every verification against reusing a
+ * cached key.
+ *
+ * @param engine The RSA engine to measure.
+ * @param config The verification to run.
+ * @param results Output for the benchmark results.
+ *
+ * @return 0 if the benchmark completed or an error code.  Verification failures are reported in
+ * the results and do not cause the benchmark to fail.
+ */
+int rsa_verify_benchmark_run (struct rsa_engine *engine,
+	const struct rsa_verify_benchmark_config *config, struct rsa_verify_benchmark_results *results)
+{
+	uint64_t start;
+	uint32_t i;
+	int status;
+
+	if ((engine == NULL) || (config == NULL) || (results == NULL) || (config->key == NULL) ||
+		(config->signature == NULL) || (config->digest == NULL) || (config->verifications == 0)) {
+		return RSA_VERIFY_BENCHMARK_INVALID_ARGUMENT;
+	}
+
+	memset (results, 0, sizeof (struct rsa_verify_benchmark_results));
+
+	start = rsa_verify_benchmark_get_time_us ();
+
+	for (i = 0; i < config->verifications; i++) {
+		if (config->flush) {
+			config->flush (engine);
+		}
+
+		status = engine->sig_verify (engine, config->key, config->signature, config->sig_length,
+			config->digest, config->digest_length);
+		if (status == 0) {
+			results->verified++;
+		}
+		else if (status == RSA_ENGINE_NO_MEMORY) {
+			return RSA_VERIFY_BENCHMARK_NO_MEMORY;
+		}
+		else {
+			results->failed++;
+		}
+	}
+
+	results->elapsed_us = rsa_verify_benchmark_get_time_us () - start;
+	if (results->elapsed_us != 0) {
+		results->verify_per_sec =
+			((uint64_t) results->verified * 1000000ULL) / results->elapsed_us;
+	}
+
+	return 0;
+}
+
+/**
+ * Print the results of a signature verification benchmark.
+ *
+ * @param name A label for the benchmark run.
+ * @param results The results to print.
+ * @param out The stream to print to.
+ */
+void rsa_verify_benchmark_print_results (const char *name,
+	const struct rsa_verify_benchmark_results *results, FILE *out)
+{
+	if ((name == NULL) || (results == NULL) || (out == NULL)) {
+		return;
+	}
+
+	fprintf (out, "%s\n", name);
+	fprintf (out, "verified         %u\n", results->verified);
+	fprintf (out, "failed           %u\n", results->failed);
+	fprintf (out, "elapsed          %llu us\n", (unsigned long long) results->elapsed_us);
+	fprintf (out, "throughput       %u verify/s\n", results->verify_per_sec);
+}
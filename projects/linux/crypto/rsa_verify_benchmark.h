@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef RSA_VERIFY_BENCHMARK_H_
+#define RSA_VERIFY_BENCHMARK_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "status/rot_status.h"
+#include "crypto/rsa.h"
+
+
+/**
+ * Settings for a single signature verification benchmark run.
+ */
+struct rsa_verify_benchmark_config {
+	const struct rsa_public_key *key;		/**< The key to use for verification. */
+	const uint8_t *signature;				/**< The signature to verify. */
+	size_t sig_length;						/**< Length of the signature. */
+	const uint8_t *digest;					/**< The digest that was signed. */
+	size_t digest_length;					/**< Length of the digest. */
+	uint32_t verifications;					/**< Number of verifications to run. */
+
+	/**
+	 * Optional handler to discard any parsed keys cached by the engine before each verification.
+	 * If this is null, the engine is free to reuse cached keys across verifications.
+	 *
+	 * @param engine The RSA engine being measured.
+	 */
+	void (*flush) (struct rsa_engine *engine);
+};
+
+/**
+ * Results from a signature verification benchmark run.
+ */
+struct rsa_verify_benchmark_results {
+	uint32_t verified;						/**< Number of signatures successfully verified. */
+	uint32_t failed;						/**< Number of verifications that failed. */
+	uint64_t elapsed_us;					/**< Total time for the run. */
+	uint32_t verify_per_sec;				/**< Successful verifications per second. */
+};
+
+
+int rsa_verify_benchmark_run (struct rsa_engine *engine,
+	const struct rsa_verify_benchmark_config *config, struct rsa_verify_benchmark_results *results);
+void rsa_verify_benchmark_print_results (const char *name,
+	const struct rsa_verify_benchmark_results *results, FILE *out);
+
+
+#define	RSA_VERIFY_BENCHMARK_ERROR(code)		ROT_ERROR (ROT_MODULE_RSA_VERIFY_BENCHMARK, code)
+
+/**
+ * Error codes that can be generated by the RSA verification benchmark.
+ */
+enum {
+	RSA_VERIFY_BENCHMARK_INVALID_ARGUMENT = RSA_VERIFY_BENCHMARK_ERROR (0x00),	/**< Input parameter is null or not valid. */
+	RSA_VERIFY_BENCHMARK_NO_MEMORY = RSA_VERIFY_BENCHMARK_ERROR (0x01),			/**< Memory allocation failed. */
+};
+
+
+#endif /* RSA_VERIFY_BENCHMARK_H_ */
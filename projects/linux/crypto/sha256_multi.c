@@ -0,0 +1,526 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <string.h>
+#include <openssl/sha.h>
+#include "sha256_multi.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define	SHA256_MULTI_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+
+/**
+ * The maximum number of buffers processed in lock-step by any implementation.
+ */
+#define	SHA256_MULTI_MAX_LANES		8
+
+/**
+ * The SHA-256 block size.
+ */
+#define	SHA256_MULTI_BLOCK_SIZE		64
+
+
+#ifdef SHA256_MULTI_X86
+/**
+ * SHA-256 round constants.
+ */
+static const uint32_t SHA256_MULTI_K[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/**
+ * SHA-256 initial hash value.
+ */
+static const uint32_t SHA256_MULTI_IV[8] = {
+	0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+/**
+ * The hashing state for one of the buffers being processed in lock-step.
+ */
+struct sha256_multi_lane {
+	const struct hash_multi_buffer *buffer;			/**< The buffer being hashed.  Null if idle. */
+	const uint8_t *next;							/**< The next full block of buffer data. */
+	size_t full_blocks;								/**< Full blocks of buffer data remaining. */
+	uint8_t tail[SHA256_MULTI_BLOCK_SIZE * 2];		/**< The padded final blocks of the buffer. */
+	int tail_blocks;								/**< Number of padded final blocks. */
+	int tail_next;									/**< The next padded block to process. */
+	uint32_t state[8];								/**< The intermediate hash value. */
+};
+
+/**
+ * Process one block of data for each lane.
+ *
+ * @param lane The lanes to update.
+ * @param block The block of data to process for each lane.
+ */
+typedef void (*sha256_multi_compress) (struct sha256_multi_lane *lane, const uint8_t **block);
+
+/**
+ * Block processed by lanes that have no buffer to hash.  The result is discarded.
+ */
+static const uint8_t SHA256_MULTI_IDLE_BLOCK[SHA256_MULTI_BLOCK_SIZE];
+
+/**
+ * Flags for the detected CPU features.  These are initialized on first use.
+ */
+static int sha256_multi_has_sha = -1;
+static int sha256_multi_has_avx2 = -1;
+
+
+/**
+ * Start hashing a new buffer in a lane.
+ *
+ * @param lane The lane to initialize.
+ * @param buffer The buffer to hash.
+ */
+static void sha256_multi_start_lane (struct sha256_multi_lane *lane,
+	const struct hash_multi_buffer *buffer)
+{
+	size_t remain = buffer->length % SHA256_MULTI_BLOCK_SIZE;
+	uint64_t bits = (uint64_t) buffer->length * 8;
+	size_t end;
+	int i;
+
+	lane->buffer = buffer;
+	lane->next = buffer->data;
+	lane->full_blocks = buffer->length / SHA256_MULTI_BLOCK_SIZE;
+	lane->tail_blocks = ((remain + 9) > SHA256_MULTI_BLOCK_SIZE) ? 2 : 1;
+	lane->tail_next = 0;
+
+	memset (lane->tail, 0, sizeof (lane->tail));
+	memcpy (lane->tail, &buffer->data[buffer->length - remain], remain);
+	lane->tail[remain] = 0x80;
+
+	end = lane->tail_blocks * SHA256_MULTI_BLOCK_SIZE;
+	for (i = 0; i < 8; i++) {
+		lane->tail[end - 1 - i] = (uint8_t) (bits >> (i * 8));
+	}
+
+	memcpy (lane->state, SHA256_MULTI_IV, sizeof (lane->state));
+}
+
+/**
+ * Get the next block to process for a lane.
+ *
+ * @param lane The lane to query.
+ *
+ * @return The next block or null if the lane has no more data to process.
+ */
+static const uint8_t* sha256_multi_next_block (struct sha256_multi_lane *lane)
+{
+	const uint8_t *block;
+
+	if (lane->buffer == NULL) {
+		return NULL;
+	}
+
+	if (lane->full_blocks != 0) {
+		block = lane->next;
+		lane->next += SHA256_MULTI_BLOCK_SIZE;
+		lane->full_blocks--;
+
+		return block;
+	}
+
+	if (lane->tail_next < lane->tail_blocks) {
+		return &lane->tail[SHA256_MULTI_BLOCK_SIZE * lane->tail_next++];
+	}
+
+	return NULL;
+}
+
+/**
+ * Output the hash for a lane that has processed all of its data.  The lane will be idle.
+ *
+ * @param lane The lane to finish.
+ */
+static void sha256_multi_finish_lane (struct sha256_multi_lane *lane)
+{
+	uint8_t *hash = lane->buffer->hash;
+	int i;
+
+	for (i = 0; i < 8; i++) {
+		hash[(i * 4)] = (uint8_t) (lane->state[i] >> 24);
+		hash[(i * 4) + 1] = (uint8_t) (lane->state[i] >> 16);
+		hash[(i * 4) + 2] = (uint8_t) (lane->state[i] >> 8);
+		hash[(i * 4) + 3] = (uint8_t) lane->state[i];
+	}
+
+	lane->buffer = NULL;
+}
+
+/**
+ * Hash a list of buffers in lock-step.  Whenever a lane finishes a buffer, it starts on the next
+ * buffer in the list, so buffers with different lengths don't leave lanes idle.
+ *
+ * @param lanes The number of lanes processed by the compression function.
+ * @param compress The compression function to use.
+ * @param buffers The buffers to hash.
+ * @param count The number of buffers.
+ */
+static void sha256_multi_run (int lanes, sha256_multi_compress compress,
+	const struct hash_multi_buffer *buffers, size_t count)
+{
+	struct sha256_multi_lane lane[SHA256_MULTI_MAX_LANES];
+	const uint8_t *block[SHA256_MULTI_MAX_LANES];
+	size_t next_buffer = 0;
+	int active;
+	int i;
+
+	for (i = 0; i < lanes; i++) {
+		lane[i].buffer = NULL;
+	}
+
+	do {
+		active = 0;
+
+		for (i = 0; i < lanes; i++) {
+			block[i] = sha256_multi_next_block (&lane[i]);
+			if (block[i] == NULL) {
+				if (lane[i].buffer != NULL) {
+					sha256_multi_finish_lane (&lane[i]);
+				}
+
+				if (next_buffer < count) {
+					sha256_multi_start_lane (&lane[i], &buffers[next_buffer++]);
+					block[i] = sha256_multi_next_block (&lane[i]);
+				}
+			}
+
+			if (block[i] != NULL) {
+				active++;
+			}
+			else {
+				block[i] = SHA256_MULTI_IDLE_BLOCK;
+			}
+		}
+
+		if (active != 0) {
+			compress (lane, block);
+		}
+	} while (active != 0);
+}
+
+/**
+ * Apply the message schedule to get the next four words of the message using the SHA extensions.
+ * The message words are stored in a ring of four vectors.
+ */
+#define	SHA256_MULTI_SHANI_SCHEDULE(w, i) \
+	w[(i) & 3] = _mm_sha256msg2_epu32 (_mm_add_epi32 ( \
+		_mm_sha256msg1_epu32 (w[(i) & 3], w[((i) + 1) & 3]), \
+		_mm_alignr_epi8 (w[((i) + 3) & 3], w[((i) + 2) & 3], 4)), w[((i) + 3) & 3])
+
+/**
+ * Execute four SHA-256 rounds using the SHA extensions.
+ */
+#define	SHA256_MULTI_SHANI_ROUNDS(abef, cdgh, w, k) \
+	do { \
+		__m128i msg = _mm_add_epi32 (w, k); \
+		cdgh = _mm_sha256rnds2_epu32 (cdgh, abef, msg); \
+		msg = _mm_shuffle_epi32 (msg, 0x0e); \
+		abef = _mm_sha256rnds2_epu32 (abef, cdgh, msg); \
+	} while (0)
+
+/**
+ * Load the state for a lane into the register layout used by the SHA extensions.
+ */
+#define	SHA256_MULTI_SHANI_LOAD(state, abef, cdgh) \
+	do { \
+		__m128i tmp = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i*) &state[0]), 0xb1); \
+		cdgh = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i*) &state[4]), 0x1b); \
+		abef = _mm_alignr_epi8 (tmp, cdgh, 8); \
+		cdgh = _mm_blend_epi16 (cdgh, tmp, 0xf0); \
+	} while (0)
+
+/**
+ * Store the state for a lane from the register layout used by the SHA extensions.
+ */
+#define	SHA256_MULTI_SHANI_STORE(state, abef, cdgh) \
+	do { \
+		__m128i tmp = _mm_shuffle_epi32 (abef, 0x1b); \
+		cdgh = _mm_shuffle_epi32 (cdgh, 0xb1); \
+		_mm_storeu_si128 ((__m128i*) &state[0], _mm_blend_epi16 (tmp, cdgh, 0xf0)); \
+		_mm_storeu_si128 ((__m128i*) &state[4], _mm_alignr_epi8 (cdgh, tmp, 8)); \
+	} while (0)
+
+/**
+ * Process one block for each of two lanes using the x86 SHA extensions.  The SHA round
+ * instructions have a long latency, so interleaving two independent hashes keeps the execution
+ * units busy while each hash waits for the previous rounds to complete.
+ *
+ * @param lane The lanes to update.
+ * @param block The block of data to process for each lane.
+ */
+__attribute__ ((target ("sha,sse4.1")))
+static void sha256_multi_compress_shani_x2 (struct sha256_multi_lane *lane, const uint8_t **block)
+{
+	const __m128i mask = _mm_set_epi64x (0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+	__m128i abef0;
+	__m128i cdgh0;
+	__m128i abef1;
+	__m128i cdgh1;
+	__m128i save_abef0;
+	__m128i save_cdgh0;
+	__m128i save_abef1;
+	__m128i save_cdgh1;
+	__m128i w0[4];
+	__m128i w1[4];
+	__m128i k;
+	int i;
+
+	SHA256_MULTI_SHANI_LOAD (lane[0].state, abef0, cdgh0);
+	SHA256_MULTI_SHANI_LOAD (lane[1].state, abef1, cdgh1);
+
+	save_abef0 = abef0;
+	save_cdgh0 = cdgh0;
+	save_abef1 = abef1;
+	save_cdgh1 = cdgh1;
+
+#pragma GCC unroll 16
+	for (i = 0; i < 16; i++) {
+		k = _mm_loadu_si128 ((const __m128i*) &SHA256_MULTI_K[i * 4]);
+
+		if (i < 4) {
+			w0[i] = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) &block[0][i * 16]), mask);
+			w1[i] = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) &block[1][i * 16]), mask);
+		}
+		else {
+			SHA256_MULTI_SHANI_SCHEDULE (w0, i);
+			SHA256_MULTI_SHANI_SCHEDULE (w1, i);
+		}
+
+		SHA256_MULTI_SHANI_ROUNDS (abef0, cdgh0, w0[i & 3], k);
+		SHA256_MULTI_SHANI_ROUNDS (abef1, cdgh1, w1[i & 3], k);
+	}
+
+	abef0 = _mm_add_epi32 (abef0, save_abef0);
+	cdgh0 = _mm_add_epi32 (cdgh0, save_cdgh0);
+	abef1 = _mm_add_epi32 (abef1, save_abef1);
+	cdgh1 = _mm_add_epi32 (cdgh1, save_cdgh1);
+
+	SHA256_MULTI_SHANI_STORE (lane[0].state, abef0, cdgh0);
+	SHA256_MULTI_SHANI_STORE (lane[1].state, abef1, cdgh1);
+}
+
+/**
+ * A vector holding one 32-bit word for each of eight lanes.
+ */
+typedef uint32_t sha256_multi_vec __attribute__ ((vector_size (32)));
+
+#define	SHA256_MULTI_ROTR(x, n)		(((x) >> (n)) | ((x) << (32 - (n))))
+#define	SHA256_MULTI_BSIG0(x)		\
+	(SHA256_MULTI_ROTR (x, 2) ^ SHA256_MULTI_ROTR (x, 13) ^ SHA256_MULTI_ROTR (x, 22))
+#define	SHA256_MULTI_BSIG1(x)		\
+	(SHA256_MULTI_ROTR (x, 6) ^ SHA256_MULTI_ROTR (x, 11) ^ SHA256_MULTI_ROTR (x, 25))
+#define	SHA256_MULTI_SSIG0(x)		(SHA256_MULTI_ROTR (x, 7) ^ SHA256_MULTI_ROTR (x, 18) ^ ((x) >> 3))
+#define	SHA256_MULTI_SSIG1(x)		(SHA256_MULTI_ROTR (x, 17) ^ SHA256_MULTI_ROTR (x, 19) ^ ((x) >> 10))
+#define	SHA256_MULTI_CH(x, y, z)	(((x) & (y)) ^ (~(x) & (z)))
+#define	SHA256_MULTI_MAJ(x, y, z)	(((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+
+/**
+ * Process one block for each of eight lanes using AVX2.  Each 32-bit word of the SHA-256 state is
+ * held in a vector with the value for every lane.
+ *
+ * @param lane The lanes to update.
+ * @param block The block of data to process for each lane.
+ */
+__attribute__ ((target ("avx2")))
+static void sha256_multi_compress_avx2_x8 (struct sha256_multi_lane *lane, const uint8_t **block)
+{
+	sha256_multi_vec state[8];
+	sha256_multi_vec w[16];
+	sha256_multi_vec a, b, c, d, e, f, g, h;
+	sha256_multi_vec t1;
+	sha256_multi_vec t2;
+	uint32_t word;
+	int i;
+	int t;
+
+	for (t = 0; t < 8; t++) {
+		for (i = 0; i < 8; i++) {
+			state[t][i] = lane[i].state[t];
+		}
+	}
+
+	a = state[0];
+	b = state[1];
+	c = state[2];
+	d = state[3];
+	e = state[4];
+	f = state[5];
+	g = state[6];
+	h = state[7];
+
+	for (t = 0; t < 64; t++) {
+		if (t < 16) {
+			for (i = 0; i < 8; i++) {
+				memcpy (&word, &block[i][t * 4], sizeof (word));
+				w[t][i] = __builtin_bswap32 (word);
+			}
+		}
+		else {
+			w[t & 15] += SHA256_MULTI_SSIG1 (w[(t - 2) & 15]) + w[(t - 7) & 15] +
+				SHA256_MULTI_SSIG0 (w[(t - 15) & 15]);
+		}
+
+		t1 = h + SHA256_MULTI_BSIG1 (e) + SHA256_MULTI_CH (e, f, g) + SHA256_MULTI_K[t] +
+			w[t & 15];
+		t2 = SHA256_MULTI_BSIG0 (a) + SHA256_MULTI_MAJ (a, b, c);
+
+		h = g;
+		g = f;
+		f = e;
+		e = d + t1;
+		d = c;
+		c = b;
+		b = a;
+		a = t1 + t2;
+	}
+
+	state[0] += a;
+	state[1] += b;
+	state[2] += c;
+	state[3] += d;
+	state[4] += e;
+	state[5] += f;
+	state[6] += g;
+	state[7] += h;
+
+	for (t = 0; t < 8; t++) {
+		for (i = 0; i < 8; i++) {
+			lane[i].state[t] = state[t][i];
+		}
+	}
+}
+
+/**
+ * Check if the CPU supports the SHA extensions.
+ *
+ * @return true if the SHA instructions are available.
+ */
+static bool sha256_multi_cpu_has_sha (void)
+{
+	unsigned int eax;
+	unsigned int ebx;
+	unsigned int ecx;
+	unsigned int edx;
+
+	if (sha256_multi_has_sha < 0) {
+		sha256_multi_has_sha = __get_cpuid_count (7, 0, &eax, &ebx, &ecx, &edx) &&
+			(ebx & (1U << 29)) && __builtin_cpu_supports ("sse4.1");
+	}
+
+	return sha256_multi_has_sha;
+}
+
+/**
+ * Check if the CPU supports AVX2.
+ *
+ * @return true if the AVX2 instructions are available.
+ */
+static bool sha256_multi_cpu_has_avx2 (void)
+{
+	if (sha256_multi_has_avx2 < 0) {
+		sha256_multi_has_avx2 = __builtin_cpu_supports ("avx2") ? 1 : 0;
+	}
+
+	return sha256_multi_has_avx2;
+}
+#endif
+
+/**
+ * Determine if a multi-buffer SHA-256 implementation can be used on the current CPU.
+ *
+ * @param impl The implementation to check.
+ *
+ * @return true if the implementation is supported.
+ */
+bool sha256_multi_is_impl_supported (enum sha256_multi_impl impl)
+{
+	switch (impl) {
+		case SHA256_MULTI_IMPL_SERIAL:
+			return true;
+
+#ifdef SHA256_MULTI_X86
+		case SHA256_MULTI_IMPL_SHANI_X2:
+			return sha256_multi_cpu_has_sha ();
+
+		case SHA256_MULTI_IMPL_AVX2_X8:
+			return sha256_multi_cpu_has_avx2 ();
+#endif
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * Get the fastest multi-buffer SHA-256 implementation supported by the current CPU.
+ *
+ * When the SHA extensions are available, single buffer hashing in OpenSSL already uses them, so
+ * interleaving two buffers is preferred over wider AVX2 lanes.
+ *
+ * @return The implementation to use.
+ */
+enum sha256_multi_impl sha256_multi_get_best_impl (void)
+{
+	if (sha256_multi_is_impl_supported (SHA256_MULTI_IMPL_SHANI_X2)) {
+		return SHA256_MULTI_IMPL_SHANI_X2;
+	}
+	else if (sha256_multi_is_impl_supported (SHA256_MULTI_IMPL_AVX2_X8)) {
+		return SHA256_MULTI_IMPL_AVX2_X8;
+	}
+	else {
+		return SHA256_MULTI_IMPL_SERIAL;
+	}
+}
+
+/**
+ * Calculate SHA-256 hashes for multiple independent buffers.  The buffers are not validated, so
+ * the data for every buffer must be valid and each hash buffer must have space for a SHA-256 hash.
+ *
+ * If the requested implementation is not supported by the current CPU, or there is only a single
+ * buffer to hash, each buffer is hashed individually with OpenSSL.
+ *
+ * @param impl The implementation to use.
+ * @param buffers The buffers to hash.
+ * @param count The number of buffers.
+ */
+void sha256_multi_calculate (enum sha256_multi_impl impl, const struct hash_multi_buffer *buffers,
+	size_t count)
+{
+	size_t i;
+
+	if ((count > 1) && sha256_multi_is_impl_supported (impl)) {
+		switch (impl) {
+#ifdef SHA256_MULTI_X86
+			case SHA256_MULTI_IMPL_SHANI_X2:
+				sha256_multi_run (2, sha256_multi_compress_shani_x2, buffers, count);
+				return;
+
+			case SHA256_MULTI_IMPL_AVX2_X8:
+				sha256_multi_run (8, sha256_multi_compress_avx2_x8, buffers, count);
+				return;
+#endif
+
+			default:
+				break;
+		}
+	}
+
+	for (i = 0; i < count; i++) {
+		SHA256 (buffers[i].data, buffers[i].length, buffers[i].hash);
+	}
+}
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef SHA256_MULTI_H_
+#define SHA256_MULTI_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "crypto/hash.h"
+
+
+/**
+ * Implementations for calculating SHA-256 hashes of multiple independent buffers.
+ */
+enum sha256_multi_impl {
+	SHA256_MULTI_IMPL_SERIAL = 0,		/**< Hash each buffer in turn with OpenSSL. */
+	SHA256_MULTI_IMPL_SHANI_X2,			/**< Interleave two buffers using the x86 SHA extensions. */
+	SHA256_MULTI_IMPL_AVX2_X8,			/**< Hash eight buffers in lock-step in AVX2 vector lanes. */
+};
+
+
+enum sha256_multi_impl sha256_multi_get_best_impl (void);
+bool sha256_multi_is_impl_supported (enum sha256_multi_impl impl);
+
+void sha256_multi_calculate (enum sha256_multi_impl impl, const struct hash_multi_buffer *buffers,
+	size_t count);
+
+
+#endif /* SHA256_MULTI_H_ */
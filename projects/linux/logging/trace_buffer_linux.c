@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+#include "logging/logging.h"
+#include "trace_buffer_linux.h"
+
+
+/**
+ * Names for the core trace events, indexed by event ID.
+ */
+static const char *trace_buffer_linux_event_names[] = {
+	"flash_xfer",
+	"hash",
+	"rsa_decrypt",
+	"rsa_verify",
+	"ecc_sign",
+	"ecc_verify",
+	"mctp_rx",
+	"mctp_tx",
+	"cmd_dispatch",
+	"host_power_on_reset",
+	"host_soft_reset",
+	"host_validate_flash"
+};
+
+/**
+ * Phase identifiers used by the trace event format, indexed by trace record type.
+ */
+static const char trace_buffer_linux_phases[] = {'B', 'E', 'i'};
+
+
+/**
+ * Get a timestamp for a trace record from the monotonic system clock.  This can be used as the
+ * timestamp source for trace buffers.
+ *
+ * @return The current time in microseconds.
+ */
+uint32_t trace_buffer_linux_timestamp (void)
+{
+	struct timespec now;
+
+	clock_gettime (CLOCK_MONOTONIC, &now);
+
+	return (uint32_t) (((uint64_t) now.tv_sec * 1000000) + (now.tv_nsec / 1000));
+}
+
+/**
+ * Write a single trace record as a trace event.
+ *
+ * @param out The stream to write the event to.
+ * @param record The trace record to write.
+ * @param us_per_tick The number of microseconds represented by each timestamp tick.
+ */
+static void trace_buffer_linux_dump_record (FILE *out, const struct trace_record *record,
+	uint32_t us_per_tick)
+{
+	char phase = 'i';
+
+	if (record->phase < sizeof (trace_buffer_linux_phases)) {
+		phase = trace_buffer_linux_phases[record->phase];
+	}
+
+	if (record->event < (sizeof (trace_buffer_linux_event_names) / sizeof (char*))) {
+		fprintf (out, "{\"name\":\"%s\"", trace_buffer_linux_event_names[record->event]);
+	}
+	else {
+		fprintf (out, "{\"name\":\"event_0x%04x\"", record->event);
+	}
+
+	fprintf (out, ",\"ph\":\"%c\",\"ts\":%llu,\"pid\":0,\"tid\":%u", phase,
+		(unsigned long long) record->timestamp * us_per_tick, record->core);
+	if (phase == 'i') {
+		fprintf (out, ",\"s\":\"t\"");
+	}
+
+	fprintf (out, ",\"args\":{\"arg1\":%u,\"arg2\":%u}}", record->arg1, record->arg2);
+}
+
+/**
+ * Write the contents of all registered trace buffers as JSON in the trace event format, which can
+ * be loaded into timeline viewers such as chrome://tracing or Perfetto.  Each core is reported as
+ * a separate thread.
+ *
+ * Tracing should be stopped while the trace is being written.  Otherwise, records added during the
+ * dump can cause other records to be reported more than once.
+ *
+ * @param out The stream to write the trace to.
+ * @param us_per_tick The number of microseconds represented by each timestamp tick.  This is 1 for
+ * trace buffers using trace_buffer_linux_timestamp and 1000 for the default timestamp source.
+ *
+ * @return 0 if the trace was written successfully or an error code.
+ */
+int trace_buffer_linux_dump (FILE *out, uint32_t us_per_tick)
+{
+	struct trace_buffer *trace;
+	struct trace_record records[32];
+	bool first = true;
+	uint32_t offset;
+	int count;
+	int core;
+	int i;
+
+	if ((out == NULL) || (us_per_tick == 0)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	fprintf (out, "{\"traceEvents\":[");
+
+	for (core = 0; core < TRACE_BUFFER_MAX_CORES; core++) {
+		trace = trace_buffer_get_core (core);
+		if (trace == NULL) {
+			continue;
+		}
+
+		offset = 0;
+		do {
+			count = trace_buffer_read (trace, offset, records,
+				sizeof (records) / sizeof (records[0]));
+			for (i = 0; i < count; i++) {
+				fprintf (out, (first) ? "\n" : ",\n");
+				trace_buffer_linux_dump_record (out, &records[i], us_per_tick);
+				first = false;
+			}
+
+			offset += count;
+		} while (count > 0);
+	}
+
+	fprintf (out, "\n]}\n");
+
+	return (ferror (out)) ? LOGGING_READ_CONTENTS_FAILED : 0;
+}
@@ -0,0 +1,17 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef TRACE_BUFFER_LINUX_H_
+#define TRACE_BUFFER_LINUX_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include "logging/trace_buffer.h"
+
+
+uint32_t trace_buffer_linux_timestamp (void);
+
+int trace_buffer_linux_dump (FILE *out, uint32_t us_per_tick);
+
+
+#endif /* TRACE_BUFFER_LINUX_H_ */
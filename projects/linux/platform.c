@@ -141,6 +141,32 @@ int platform_has_timeout_expired (platform_clock *timeout)
 	}
 }
 
+/**
+ * Get the amount of time that elapsed between two clock values.
+ *
+ * @param start The starting time.
+ * @param end The ending time.
+ *
+ * @return The elapsed time, in milliseconds.  If the end time is before the start time, 0 will be
+ * returned.
+ */
+uint32_t platform_get_duration (const platform_clock *start, const platform_clock *end)
+{
+	int64_t duration;
+
+	if ((start == NULL) || (end == NULL)) {
+		return 0;
+	}
+
+	duration = ((int64_t) (end->tv_sec - start->tv_sec) * 1000) +
+		((end->tv_nsec - start->tv_nsec) / 1000000);
+	if (duration < 0) {
+		return 0;
+	}
+
+	return (uint32_t) duration;
+}
+
 
 #define	PLATFORM_MUTEX_ERROR(code)		ROT_ERROR (ROT_MODULE_PLATFORM_MUTEX, code)
 
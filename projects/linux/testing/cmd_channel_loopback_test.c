@@ -0,0 +1,502 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "platform.h"
+#include "cmd_interface/cmd_channel_loopback.h"
+#include "mctp/mctp_interface.h"
+#include "testing/mock/cmd_interface_mock.h"
+
+
+static const char *SUITE = "cmd_channel_loopback";
+
+
+/**
+ * Fill a packet with test data.
+ *
+ * @param packet The packet to fill.
+ * @param value Value to use for the packet data.
+ * @param length The length of the packet.
+ */
+static void cmd_channel_loopback_testing_fill_packet (struct cmd_packet *packet, uint8_t value,
+	size_t length)
+{
+	memset (packet, 0, sizeof (struct cmd_packet));
+	memset (packet->data, value, length);
+	packet->pkt_size = length;
+	packet->state = CMD_VALID_PACKET;
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void cmd_channel_loopback_test_init (CuTest *test)
+{
+	struct cmd_channel_loopback loopback;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_loopback_init (&loopback, 2, 0x41);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, loopback.base.receive_packet);
+	CuAssertPtrNotNull (test, loopback.base.send_packet);
+
+	status = cmd_channel_get_id (&loopback.base);
+	CuAssertIntEquals (test, 2, status);
+
+	cmd_channel_loopback_release (&loopback);
+}
+
+static void cmd_channel_loopback_test_init_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_loopback_init (NULL, 2, 0x41);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+}
+
+static void cmd_channel_loopback_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	cmd_channel_loopback_release (NULL);
+}
+
+static void cmd_channel_loopback_test_inject_and_receive (CuTest *test)
+{
+	struct cmd_channel_loopback loopback;
+	struct cmd_packet tx[2];
+	struct cmd_packet rx;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_loopback_init (&loopback, 2, 0x41);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_loopback_testing_fill_packet (&tx[0], 0x11, 10);
+	cmd_channel_loopback_testing_fill_packet (&tx[1], 0x22, 20);
+
+	status = cmd_channel_loopback_inject (&loopback, tx, 2, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = loopback.base.receive_packet (&loopback.base, &rx, 0);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 10, rx.pkt_size);
+	CuAssertIntEquals (test, 0x41, rx.dest_addr);
+	CuAssertIntEquals (test, CMD_VALID_PACKET, rx.state);
+	CuAssertIntEquals (test, true, rx.timeout_valid);
+	CuAssertIntEquals (test, false, platform_has_timeout_expired (&rx.pkt_timeout));
+
+	status = testing_validate_array (tx[0].data, rx.data, tx[0].pkt_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = loopback.base.receive_packet (&loopback.base, &rx, -1);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 20, rx.pkt_size);
+
+	status = testing_validate_array (tx[1].data, rx.data, tx[1].pkt_size);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_loopback_release (&loopback);
+}
+
+static void cmd_channel_loopback_test_receive_timeout (CuTest *test)
+{
+	struct cmd_channel_loopback loopback;
+	struct cmd_packet rx;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_loopback_init (&loopback, 2, 0x41);
+	CuAssertIntEquals (test, 0, status);
+
+	status = loopback.base.receive_packet (&loopback.base, &rx, 0);
+	CuAssertIntEquals (test, CMD_CHANNEL_RX_TIMEOUT, status);
+
+	status = loopback.base.receive_packet (&loopback.base, &rx, 10);
+	CuAssertIntEquals (test, CMD_CHANNEL_RX_TIMEOUT, status);
+
+	cmd_channel_loopback_release (&loopback);
+}
+
+static void cmd_channel_loopback_test_receive_null (CuTest *test)
+{
+	struct cmd_channel_loopback loopback;
+	struct cmd_packet rx;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_loopback_init (&loopback, 2, 0x41);
+	CuAssertIntEquals (test, 0, status);
+
+	status = loopback.base.receive_packet (NULL, &rx, 0);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	status = loopback.base.receive_packet (&loopback.base, NULL, 0);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	cmd_channel_loopback_release (&loopback);
+}
+
+static void cmd_channel_loopback_test_send_and_read (CuTest *test)
+{
+	struct cmd_channel_loopback loopback;
+	struct cmd_packet tx;
+	struct cmd_packet rx;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_loopback_init (&loopback, 2, 0x41);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_loopback_testing_fill_packet (&tx, 0x33, 30);
+	tx.dest_addr = 0x10;
+
+	status = loopback.base.send_packet (&loopback.base, &tx);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_loopback_read (&loopback, &rx, 0);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 30, rx.pkt_size);
+	CuAssertIntEquals (test, 0x10, rx.dest_addr);
+
+	status = testing_validate_array (tx.data, rx.data, tx.pkt_size);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_loopback_release (&loopback);
+}
+
+static void cmd_channel_loopback_test_send_null (CuTest *test)
+{
+	struct cmd_channel_loopback loopback;
+	struct cmd_packet tx;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_loopback_init (&loopback, 2, 0x41);
+	CuAssertIntEquals (test, 0, status);
+
+	status = loopback.base.send_packet (NULL, &tx);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	status = loopback.base.send_packet (&loopback.base, NULL);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	cmd_channel_loopback_release (&loopback);
+}
+
+static void cmd_channel_loopback_test_send_queue_full (CuTest *test)
+{
+	struct cmd_channel_loopback loopback;
+	struct cmd_packet tx;
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = cmd_channel_loopback_init (&loopback, 2, 0x41);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_loopback_testing_fill_packet (&tx, 0x33, 30);
+
+	for (i = 0; i < CMD_CHANNEL_LOOPBACK_QUEUE_DEPTH; i++) {
+		status = loopback.base.send_packet (&loopback.base, &tx);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = loopback.base.send_packet (&loopback.base, &tx);
+	CuAssertIntEquals (test, CMD_CHANNEL_TX_TIMEOUT, status);
+
+	cmd_channel_loopback_release (&loopback);
+}
+
+static void cmd_channel_loopback_test_read_timeout (CuTest *test)
+{
+	struct cmd_channel_loopback loopback;
+	struct cmd_packet rx;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_loopback_init (&loopback, 2, 0x41);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_loopback_read (&loopback, &rx, 0);
+	CuAssertIntEquals (test, CMD_CHANNEL_RX_TIMEOUT, status);
+
+	status = cmd_channel_loopback_read (&loopback, &rx, 10);
+	CuAssertIntEquals (test, CMD_CHANNEL_RX_TIMEOUT, status);
+
+	cmd_channel_loopback_release (&loopback);
+}
+
+static void cmd_channel_loopback_test_read_null (CuTest *test)
+{
+	struct cmd_channel_loopback loopback;
+	struct cmd_packet rx;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_loopback_init (&loopback, 2, 0x41);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_loopback_read (NULL, &rx, 0);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_loopback_read (&loopback, NULL, 0);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	cmd_channel_loopback_release (&loopback);
+}
+
+static void cmd_channel_loopback_test_inject_queue_full (CuTest *test)
+{
+	struct cmd_channel_loopback loopback;
+	struct cmd_packet tx[2];
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = cmd_channel_loopback_init (&loopback, 2, 0x41);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_loopback_testing_fill_packet (&tx[0], 0x11, 10);
+	cmd_channel_loopback_testing_fill_packet (&tx[1], 0x22, 10);
+
+	for (i = 0; i < CMD_CHANNEL_LOOPBACK_QUEUE_DEPTH - 1; i++) {
+		status = cmd_channel_loopback_inject (&loopback, tx, 1, 0);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	/* There is space for one packet, but both packets must be queued together. */
+	status = cmd_channel_loopback_inject (&loopback, tx, 2, 0);
+	CuAssertIntEquals (test, CMD_CHANNEL_TX_TIMEOUT, status);
+
+	status = cmd_channel_loopback_inject (&loopback, tx, 2, 10);
+	CuAssertIntEquals (test, CMD_CHANNEL_TX_TIMEOUT, status);
+
+	status = cmd_channel_loopback_inject (&loopback, tx, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_loopback_release (&loopback);
+}
+
+static void cmd_channel_loopback_test_inject_null (CuTest *test)
+{
+	struct cmd_channel_loopback loopback;
+	struct cmd_packet tx;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_loopback_init (&loopback, 2, 0x41);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_loopback_testing_fill_packet (&tx, 0x11, 10);
+
+	status = cmd_channel_loopback_inject (NULL, &tx, 1, 0);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_loopback_inject (&loopback, NULL, 1, 0);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_loopback_inject (&loopback, &tx, 0, 0);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_loopback_inject (&loopback, &tx, CMD_CHANNEL_LOOPBACK_QUEUE_DEPTH + 1,
+		0);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	cmd_channel_loopback_release (&loopback);
+}
+
+static void cmd_channel_loopback_test_shutdown (CuTest *test)
+{
+	struct cmd_channel_loopback loopback;
+	struct cmd_packet tx;
+	struct cmd_packet rx;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_loopback_init (&loopback, 2, 0x41);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_loopback_testing_fill_packet (&tx, 0x11, 10);
+
+	status = cmd_channel_loopback_inject (&loopback, &tx, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = loopback.base.send_packet (&loopback.base, &tx);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_channel_loopback_shutdown (&loopback);
+
+	status = cmd_channel_loopback_inject (&loopback, &tx, 1, 0);
+	CuAssertIntEquals (test, CMD_CHANNEL_TX_FAILED, status);
+
+	status = loopback.base.send_packet (&loopback.base, &tx);
+	CuAssertIntEquals (test, CMD_CHANNEL_TX_FAILED, status);
+
+	status = loopback.base.receive_packet (&loopback.base, &rx, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_loopback_read (&loopback, &rx, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = loopback.base.receive_packet (&loopback.base, &rx, -1);
+	CuAssertIntEquals (test, CMD_CHANNEL_RX_FAILED, status);
+
+	status = cmd_channel_loopback_read (&loopback, &rx, -1);
+	CuAssertIntEquals (test, CMD_CHANNEL_RX_FAILED, status);
+
+	cmd_channel_loopback_release (&loopback);
+}
+
+static void cmd_channel_loopback_test_shutdown_null (CuTest *test)
+{
+	TEST_START;
+
+	cmd_channel_loopback_shutdown (NULL);
+}
+
+static void cmd_channel_loopback_test_receive_and_process (CuTest *test)
+{
+	struct cmd_channel_loopback loopback;
+	struct cmd_interface_mock cmd;
+	struct device_manager device_mgr;
+	struct mctp_interface mctp;
+	struct cmd_interface_request request;
+	struct cmd_interface_request response;
+	struct cmd_packet tx;
+	struct cmd_packet rx;
+	uint8_t payload[] = {
+		0x7e,0x14,0x14,0x00,0x01
+	};
+	uint8_t source_addr;
+	uint8_t src_eid;
+	uint8_t dest_eid;
+	uint8_t *data;
+	size_t data_len;
+	uint8_t msg_tag;
+	uint8_t packet_seq;
+	uint8_t crc;
+	uint8_t msg_type;
+	bool som;
+	bool eom;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_loopback_init (&loopback, 0, 0x41);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_mock_init (&cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_init (&device_mgr, 1, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_init (&mctp, &cmd.base, &device_mgr, MCTP_PROTOCOL_PA_ROT_CTRL_EID,
+		CERBERUS_PROTOCOL_MSFT_PCI_VID, CERBERUS_PROTOCOL_PROTOCOL_VERSION);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&tx, 0, sizeof (tx));
+	status = mctp_protocol_construct (payload, sizeof (payload), tx.data, sizeof (tx.data), 0x10,
+		MCTP_PROTOCOL_PA_ROT_CTRL_EID, MCTP_PROTOCOL_BMC_EID, true, true, 0, 1,
+		MCTP_PROTOCOL_TO_REQUEST, 0x41, &msg_type);
+	CuAssertTrue (test, !ROT_IS_ERROR (status));
+	tx.pkt_size = status;
+	tx.state = CMD_VALID_PACKET;
+
+	memset (&request, 0, sizeof (request));
+	memcpy (request.data, payload, sizeof (payload));
+	request.length = sizeof (payload);
+	request.source_eid = MCTP_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_PROTOCOL_PA_ROT_CTRL_EID;
+	request.max_response = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+
+	memcpy (&response, &request, sizeof (response));
+	response.data[5] = 0xaa;
+	response.length = sizeof (payload) + 1;
+
+	status = mock_expect (&cmd.mock, cmd.base.process_request, &cmd, 0,
+		MOCK_ARG_VALIDATOR (cmd_interface_mock_validate_request, &request, sizeof (request)));
+	status |= mock_expect_output (&cmd.mock, 0, &response, sizeof (response), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_loopback_inject (&loopback, &tx, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_receive_and_process (&loopback.base, &mctp, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_loopback_read (&loopback, &rx, 0);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x10, rx.dest_addr);
+
+	status = mctp_protocol_interpret (rx.data, rx.pkt_size, rx.dest_addr, &source_addr, &som,
+		&eom, &src_eid, &dest_eid, &data, &data_len, &msg_tag, &packet_seq, &crc, &msg_type);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x41, source_addr);
+	CuAssertIntEquals (test, true, som);
+	CuAssertIntEquals (test, true, eom);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_BMC_EID, dest_eid);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_PA_ROT_CTRL_EID, src_eid);
+	CuAssertIntEquals (test, 1, msg_tag);
+	CuAssertIntEquals (test, response.length, data_len);
+
+	status = testing_validate_array (response.data, data, response.length);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_mock_validate_and_release (&cmd);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_deinit (&mctp);
+	device_manager_release (&device_mgr);
+	cmd_channel_loopback_release (&loopback);
+}
+
+
+CuSuite* get_cmd_channel_loopback_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, cmd_channel_loopback_test_init);
+	SUITE_ADD_TEST (suite, cmd_channel_loopback_test_init_null);
+	SUITE_ADD_TEST (suite, cmd_channel_loopback_test_release_null);
+	SUITE_ADD_TEST (suite, cmd_channel_loopback_test_inject_and_receive);
+	SUITE_ADD_TEST (suite, cmd_channel_loopback_test_receive_timeout);
+	SUITE_ADD_TEST (suite, cmd_channel_loopback_test_receive_null);
+	SUITE_ADD_TEST (suite, cmd_channel_loopback_test_send_and_read);
+	SUITE_ADD_TEST (suite, cmd_channel_loopback_test_send_null);
+	SUITE_ADD_TEST (suite, cmd_channel_loopback_test_send_queue_full);
+	SUITE_ADD_TEST (suite, cmd_channel_loopback_test_read_timeout);
+	SUITE_ADD_TEST (suite, cmd_channel_loopback_test_read_null);
+	SUITE_ADD_TEST (suite, cmd_channel_loopback_test_inject_queue_full);
+	SUITE_ADD_TEST (suite, cmd_channel_loopback_test_inject_null);
+	SUITE_ADD_TEST (suite, cmd_channel_loopback_test_shutdown);
+	SUITE_ADD_TEST (suite, cmd_channel_loopback_test_shutdown_null);
+	SUITE_ADD_TEST (suite, cmd_channel_loopback_test_receive_and_process);
+
+	return suite;
+}
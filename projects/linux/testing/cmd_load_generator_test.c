@@ -0,0 +1,525 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "testing.h"
+#include "platform.h"
+#include "cmd_interface/cmd_load_generator.h"
+#include "cmd_interface/cerberus_protocol.h"
+
+
+static const char *SUITE = "cmd_load_generator";
+
+
+/**
+ * Command handler that generates fixed responses for load testing.
+ */
+struct cmd_load_generator_testing_handler {
+	struct cmd_interface base;				/**< The base command interface. */
+	int status;								/**< Status to return from request processing. */
+	platform_mutex lock;					/**< Synchronization for the request count. */
+	uint32_t count[256];					/**< Number of requests received for each command. */
+	bool pfm_active;						/**< Flag indicating a PFM update has been started. */
+	bool pfm_bad_sequence;					/**< Flag indicating an out of order PFM update request. */
+};
+
+/**
+ * Response sizes to generate for each command.  Certificates are large enough to require a
+ * multi-packet response.
+ */
+static size_t cmd_load_generator_testing_response_len (uint8_t command)
+{
+	switch (command) {
+		case CERBERUS_PROTOCOL_GET_DIGEST:
+			return sizeof (struct cerberus_protocol_header) + 2 + 32;
+
+		case CERBERUS_PROTOCOL_GET_CERTIFICATE:
+			return sizeof (struct cerberus_protocol_header) + 2 + 600;
+
+		case CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE:
+			return sizeof (struct cerberus_protocol_header) + 80;
+
+		case CERBERUS_PROTOCOL_READ_LOG:
+			return sizeof (struct cerberus_protocol_header) + 200;
+
+		default:
+			return 0;
+	}
+}
+
+static int cmd_load_generator_testing_process_request (struct cmd_interface *intf,
+	struct cmd_interface_request *request)
+{
+	struct cmd_load_generator_testing_handler *handler =
+		(struct cmd_load_generator_testing_handler*) intf;
+	struct cerberus_protocol_header *header = (struct cerberus_protocol_header*) request->data;
+
+	platform_mutex_lock (&handler->lock);
+
+	handler->count[header->command]++;
+
+	switch (header->command) {
+		case CERBERUS_PROTOCOL_INIT_PFM_UPDATE:
+			if (handler->pfm_active) {
+				handler->pfm_bad_sequence = true;
+			}
+			handler->pfm_active = true;
+			break;
+
+		case CERBERUS_PROTOCOL_PFM_UPDATE:
+			if (!handler->pfm_active) {
+				handler->pfm_bad_sequence = true;
+			}
+			break;
+
+		case CERBERUS_PROTOCOL_COMPLETE_PFM_UPDATE:
+			if (!handler->pfm_active) {
+				handler->pfm_bad_sequence = true;
+			}
+			handler->pfm_active = false;
+			break;
+	}
+
+	platform_mutex_unlock (&handler->lock);
+
+	request->length = cmd_load_generator_testing_response_len (header->command);
+	request->new_request = false;
+	request->crypto_timeout = false;
+
+	return handler->status;
+}
+
+/**
+ * Dependencies for running load through the MCTP layer.
+ */
+struct cmd_load_generator_testing {
+	struct cmd_channel_loopback loopback;			/**< The channel to send requests through. */
+	struct cmd_load_generator_testing_handler cmd;	/**< The command handler. */
+	struct device_manager device_mgr;				/**< Device manager for the MCTP layer. */
+	struct mctp_interface mctp;						/**< The MCTP layer. */
+};
+
+/**
+ * Initialize the dependencies for load generation.
+ *
+ * @param test The testing framework.
+ * @param load The testing dependencies to initialize.
+ */
+static void cmd_load_generator_testing_init (CuTest *test, struct cmd_load_generator_testing *load)
+{
+	int status;
+
+	memset (&load->cmd, 0, sizeof (load->cmd));
+	load->cmd.base.process_request = cmd_load_generator_testing_process_request;
+
+	status = platform_mutex_init (&load->cmd.lock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_loopback_init (&load->loopback, 0, 0x41);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_init (&load->device_mgr, 1, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_init (&load->mctp, &load->cmd.base, &load->device_mgr,
+		MCTP_PROTOCOL_PA_ROT_CTRL_EID, CERBERUS_PROTOCOL_MSFT_PCI_VID,
+		CERBERUS_PROTOCOL_PROTOCOL_VERSION);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release the dependencies for load generation.
+ *
+ * @param load The testing dependencies to release.
+ */
+static void cmd_load_generator_testing_release (struct cmd_load_generator_testing *load)
+{
+	mctp_interface_deinit (&load->mctp);
+	device_manager_release (&load->device_mgr);
+	cmd_channel_loopback_release (&load->loopback);
+	platform_mutex_free (&load->cmd.lock);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void cmd_load_generator_test_default_config (CuTest *test)
+{
+	struct cmd_load_generator_config config;
+	int i;
+
+	TEST_START;
+
+	cmd_load_generator_default_config (&config);
+
+	CuAssertTrue (test, (config.threads > 0));
+	CuAssertTrue (test, (config.threads <= CMD_LOAD_GENERATOR_MAX_THREADS));
+	CuAssertTrue (test, (config.requests > 0));
+	CuAssertIntEquals (test, MCTP_PROTOCOL_PA_ROT_CTRL_EID, config.device_eid);
+	CuAssertIntEquals (test, MCTP_PROTOCOL_BMC_EID, config.requester_eid);
+
+	for (i = 0; i < CMD_LOAD_GENERATOR_NUM_COMMANDS; i++) {
+		CuAssertTrue (test, (config.weight[i] > 0));
+	}
+}
+
+static void cmd_load_generator_test_default_config_null (CuTest *test)
+{
+	TEST_START;
+
+	cmd_load_generator_default_config (NULL);
+}
+
+static void cmd_load_generator_test_run (CuTest *test)
+{
+	struct cmd_load_generator_testing load;
+	struct cmd_load_generator_config config;
+	struct cmd_load_generator_results results;
+	uint32_t total = 0;
+	uint32_t pfm_updates;
+	int status;
+	int i;
+
+	TEST_START;
+
+	cmd_load_generator_testing_init (test, &load);
+
+	cmd_load_generator_default_config (&config);
+	config.threads = 4;
+	config.requests = 50;
+	config.pfm_chunk_len = 512;
+
+	status = cmd_load_generator_run (&load.loopback, &load.mctp, &config, &results);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < CMD_LOAD_GENERATOR_NUM_COMMANDS; i++) {
+		total += results.sent[i];
+	}
+
+	pfm_updates = results.sent[CMD_LOAD_GENERATOR_PFM_UPDATE];
+
+	CuAssertIntEquals (test, 200, total);
+	CuAssertIntEquals (test, 200 + (pfm_updates * (config.pfm_chunks + 1)), results.completed);
+	CuAssertIntEquals (test, 0, results.errors);
+	CuAssertIntEquals (test, 0, results.timeouts);
+	CuAssertTrue (test, (results.elapsed_us > 0));
+	CuAssertTrue (test, (results.msgs_per_sec > 0));
+	CuAssertTrue (test, (results.latency_p50_us <= results.latency_p90_us));
+	CuAssertTrue (test, (results.latency_p90_us <= results.latency_p99_us));
+	CuAssertTrue (test, (results.latency_p99_us <= results.latency_max_us));
+
+	CuAssertIntEquals (test, results.sent[CMD_LOAD_GENERATOR_GET_DIGEST],
+		load.cmd.count[CERBERUS_PROTOCOL_GET_DIGEST]);
+	CuAssertIntEquals (test, results.sent[CMD_LOAD_GENERATOR_GET_CERTIFICATE],
+		load.cmd.count[CERBERUS_PROTOCOL_GET_CERTIFICATE]);
+	CuAssertIntEquals (test, results.sent[CMD_LOAD_GENERATOR_CHALLENGE],
+		load.cmd.count[CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE]);
+	CuAssertIntEquals (test, results.sent[CMD_LOAD_GENERATOR_READ_LOG],
+		load.cmd.count[CERBERUS_PROTOCOL_READ_LOG]);
+	CuAssertIntEquals (test, pfm_updates, load.cmd.count[CERBERUS_PROTOCOL_INIT_PFM_UPDATE]);
+	CuAssertIntEquals (test, pfm_updates * config.pfm_chunks,
+		load.cmd.count[CERBERUS_PROTOCOL_PFM_UPDATE]);
+	CuAssertIntEquals (test, pfm_updates, load.cmd.count[CERBERUS_PROTOCOL_COMPLETE_PFM_UPDATE]);
+	CuAssertIntEquals (test, false, load.cmd.pfm_bad_sequence);
+
+	cmd_load_generator_testing_release (&load);
+}
+
+static void cmd_load_generator_test_run_single_command (CuTest *test)
+{
+	struct cmd_load_generator_testing load;
+	struct cmd_load_generator_config config;
+	struct cmd_load_generator_results results;
+	int status;
+
+	TEST_START;
+
+	cmd_load_generator_testing_init (test, &load);
+
+	cmd_load_generator_default_config (&config);
+	memset (config.weight, 0, sizeof (config.weight));
+	config.weight[CMD_LOAD_GENERATOR_GET_CERTIFICATE] = 1;
+	config.threads = 2;
+	config.requests = 20;
+
+	status = cmd_load_generator_run (&load.loopback, &load.mctp, &config, &results);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, results.sent[CMD_LOAD_GENERATOR_GET_DIGEST]);
+	CuAssertIntEquals (test, 40, results.sent[CMD_LOAD_GENERATOR_GET_CERTIFICATE]);
+	CuAssertIntEquals (test, 0, results.sent[CMD_LOAD_GENERATOR_CHALLENGE]);
+	CuAssertIntEquals (test, 0, results.sent[CMD_LOAD_GENERATOR_READ_LOG]);
+	CuAssertIntEquals (test, 0, results.sent[CMD_LOAD_GENERATOR_PFM_UPDATE]);
+	CuAssertIntEquals (test, 40, results.completed);
+	CuAssertIntEquals (test, 0, results.errors);
+	CuAssertIntEquals (test, 0, results.timeouts);
+
+	CuAssertIntEquals (test, 40, load.cmd.count[CERBERUS_PROTOCOL_GET_CERTIFICATE]);
+
+	cmd_load_generator_testing_release (&load);
+}
+
+static void cmd_load_generator_test_run_pfm_update (CuTest *test)
+{
+	struct cmd_load_generator_testing load;
+	struct cmd_load_generator_config config;
+	struct cmd_load_generator_results results;
+	int status;
+
+	TEST_START;
+
+	cmd_load_generator_testing_init (test, &load);
+
+	cmd_load_generator_default_config (&config);
+	memset (config.weight, 0, sizeof (config.weight));
+	config.weight[CMD_LOAD_GENERATOR_PFM_UPDATE] = 1;
+	config.threads = 4;
+	config.requests = 5;
+	config.pfm_chunks = 3;
+
+	status = cmd_load_generator_run (&load.loopback, &load.mctp, &config, &results);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 20, results.sent[CMD_LOAD_GENERATOR_PFM_UPDATE]);
+	CuAssertIntEquals (test, 100, results.completed);
+	CuAssertIntEquals (test, 0, results.errors);
+	CuAssertIntEquals (test, 0, results.timeouts);
+
+	CuAssertIntEquals (test, 20, load.cmd.count[CERBERUS_PROTOCOL_INIT_PFM_UPDATE]);
+	CuAssertIntEquals (test, 60, load.cmd.count[CERBERUS_PROTOCOL_PFM_UPDATE]);
+	CuAssertIntEquals (test, 20, load.cmd.count[CERBERUS_PROTOCOL_COMPLETE_PFM_UPDATE]);
+	CuAssertIntEquals (test, false, load.cmd.pfm_active);
+	CuAssertIntEquals (test, false, load.cmd.pfm_bad_sequence);
+
+	cmd_load_generator_testing_release (&load);
+}
+
+static void cmd_load_generator_test_run_pfm_update_error (CuTest *test)
+{
+	struct cmd_load_generator_testing load;
+	struct cmd_load_generator_config config;
+	struct cmd_load_generator_results results;
+	int status;
+
+	TEST_START;
+
+	cmd_load_generator_testing_init (test, &load);
+	load.cmd.status = CMD_HANDLER_PROCESS_FAILED;
+
+	cmd_load_generator_default_config (&config);
+	memset (config.weight, 0, sizeof (config.weight));
+	config.weight[CMD_LOAD_GENERATOR_PFM_UPDATE] = 1;
+	config.threads = 1;
+	config.requests = 3;
+
+	status = cmd_load_generator_run (&load.loopback, &load.mctp, &config, &results);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The update is stopped when the init request fails. */
+	CuAssertIntEquals (test, 3, results.sent[CMD_LOAD_GENERATOR_PFM_UPDATE]);
+	CuAssertIntEquals (test, 3, results.completed);
+	CuAssertIntEquals (test, 3, results.errors);
+
+	CuAssertIntEquals (test, 3, load.cmd.count[CERBERUS_PROTOCOL_INIT_PFM_UPDATE]);
+	CuAssertIntEquals (test, 0, load.cmd.count[CERBERUS_PROTOCOL_PFM_UPDATE]);
+	CuAssertIntEquals (test, 0, load.cmd.count[CERBERUS_PROTOCOL_COMPLETE_PFM_UPDATE]);
+
+	cmd_load_generator_testing_release (&load);
+}
+
+static void cmd_load_generator_test_run_error_responses (CuTest *test)
+{
+	struct cmd_load_generator_testing load;
+	struct cmd_load_generator_config config;
+	struct cmd_load_generator_results results;
+	int status;
+
+	TEST_START;
+
+	cmd_load_generator_testing_init (test, &load);
+	load.cmd.status = CMD_HANDLER_PROCESS_FAILED;
+
+	cmd_load_generator_default_config (&config);
+	config.threads = 2;
+	config.requests = 10;
+
+	status = cmd_load_generator_run (&load.loopback, &load.mctp, &config, &results);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 20, results.completed);
+	CuAssertIntEquals (test, 20, results.errors);
+	CuAssertIntEquals (test, 0, results.timeouts);
+
+	cmd_load_generator_testing_release (&load);
+}
+
+static void cmd_load_generator_test_run_no_response (CuTest *test)
+{
+	struct cmd_load_generator_testing load;
+	struct cmd_load_generator_config config;
+	struct cmd_load_generator_results results;
+	int status;
+
+	TEST_START;
+
+	cmd_load_generator_testing_init (test, &load);
+
+	cmd_load_generator_default_config (&config);
+	config.threads = 1;
+	config.requests = 2;
+	config.device_eid = MCTP_PROTOCOL_TEST_DEVICE;
+	config.response_timeout_ms = 20;
+
+	status = cmd_load_generator_run (&load.loopback, &load.mctp, &config, &results);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, results.completed);
+	CuAssertIntEquals (test, 0, results.errors);
+	CuAssertIntEquals (test, 2, results.timeouts);
+	CuAssertIntEquals (test, 0, results.latency_max_us);
+
+	cmd_load_generator_testing_release (&load);
+}
+
+static void cmd_load_generator_test_run_null (CuTest *test)
+{
+	struct cmd_load_generator_testing load;
+	struct cmd_load_generator_config config;
+	struct cmd_load_generator_results results;
+	int status;
+
+	TEST_START;
+
+	cmd_load_generator_testing_init (test, &load);
+	cmd_load_generator_default_config (&config);
+
+	status = cmd_load_generator_run (NULL, &load.mctp, &config, &results);
+	CuAssertIntEquals (test, CMD_LOAD_GENERATOR_INVALID_ARGUMENT, status);
+
+	status = cmd_load_generator_run (&load.loopback, NULL, &config, &results);
+	CuAssertIntEquals (test, CMD_LOAD_GENERATOR_INVALID_ARGUMENT, status);
+
+	status = cmd_load_generator_run (&load.loopback, &load.mctp, NULL, &results);
+	CuAssertIntEquals (test, CMD_LOAD_GENERATOR_INVALID_ARGUMENT, status);
+
+	status = cmd_load_generator_run (&load.loopback, &load.mctp, &config, NULL);
+	CuAssertIntEquals (test, CMD_LOAD_GENERATOR_INVALID_ARGUMENT, status);
+
+	cmd_load_generator_testing_release (&load);
+}
+
+static void cmd_load_generator_test_run_bad_config (CuTest *test)
+{
+	struct cmd_load_generator_testing load;
+	struct cmd_load_generator_config config;
+	struct cmd_load_generator_results results;
+	int status;
+
+	TEST_START;
+
+	cmd_load_generator_testing_init (test, &load);
+
+	cmd_load_generator_default_config (&config);
+	config.threads = 0;
+
+	status = cmd_load_generator_run (&load.loopback, &load.mctp, &config, &results);
+	CuAssertIntEquals (test, CMD_LOAD_GENERATOR_INVALID_ARGUMENT, status);
+
+	config.threads = CMD_LOAD_GENERATOR_MAX_THREADS + 1;
+
+	status = cmd_load_generator_run (&load.loopback, &load.mctp, &config, &results);
+	CuAssertIntEquals (test, CMD_LOAD_GENERATOR_INVALID_ARGUMENT, status);
+
+	cmd_load_generator_default_config (&config);
+	memset (config.weight, 0, sizeof (config.weight));
+
+	status = cmd_load_generator_run (&load.loopback, &load.mctp, &config, &results);
+	CuAssertIntEquals (test, CMD_LOAD_GENERATOR_INVALID_ARGUMENT, status);
+
+	cmd_load_generator_default_config (&config);
+	config.pfm_chunk_len = MCTP_PROTOCOL_MAX_MESSAGE_BODY;
+
+	status = cmd_load_generator_run (&load.loopback, &load.mctp, &config, &results);
+	CuAssertIntEquals (test, CMD_LOAD_GENERATOR_INVALID_ARGUMENT, status);
+
+	cmd_load_generator_default_config (&config);
+	config.pfm_chunks = UINT32_MAX;
+
+	status = cmd_load_generator_run (&load.loopback, &load.mctp, &config, &results);
+	CuAssertIntEquals (test, CMD_LOAD_GENERATOR_INVALID_ARGUMENT, status);
+
+	cmd_load_generator_default_config (&config);
+	config.requester_addr = 0x7e;
+
+	status = cmd_load_generator_run (&load.loopback, &load.mctp, &config, &results);
+	CuAssertIntEquals (test, CMD_LOAD_GENERATOR_INVALID_ARGUMENT, status);
+
+	cmd_load_generator_testing_release (&load);
+}
+
+static void cmd_load_generator_test_print_results (CuTest *test)
+{
+	struct cmd_load_generator_results results;
+	FILE *out;
+	char line[64];
+
+	TEST_START;
+
+	memset (&results, 0, sizeof (results));
+	results.completed = 10;
+	results.msgs_per_sec = 1234;
+
+	out = tmpfile ();
+	CuAssertPtrNotNull (test, out);
+
+	cmd_load_generator_print_results (&results, out);
+	rewind (out);
+
+	CuAssertPtrNotNull (test, fgets (line, sizeof (line), out));
+	CuAssertStrEquals (test, "GET_DIGEST       0\n", line);
+
+	while (fgets (line, sizeof (line), out) && (strncmp (line, "throughput", 10) != 0));
+	CuAssertStrEquals (test, "throughput       1234 msg/s\n", line);
+
+	fclose (out);
+}
+
+static void cmd_load_generator_test_print_results_null (CuTest *test)
+{
+	struct cmd_load_generator_results results;
+
+	TEST_START;
+
+	memset (&results, 0, sizeof (results));
+
+	cmd_load_generator_print_results (NULL, stdout);
+	cmd_load_generator_print_results (&results, NULL);
+}
+
+
+CuSuite* get_cmd_load_generator_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, cmd_load_generator_test_default_config);
+	SUITE_ADD_TEST (suite, cmd_load_generator_test_default_config_null);
+	SUITE_ADD_TEST (suite, cmd_load_generator_test_run);
+	SUITE_ADD_TEST (suite, cmd_load_generator_test_run_single_command);
+	SUITE_ADD_TEST (suite, cmd_load_generator_test_run_pfm_update);
+	SUITE_ADD_TEST (suite, cmd_load_generator_test_run_pfm_update_error);
+	SUITE_ADD_TEST (suite, cmd_load_generator_test_run_error_responses);
+	SUITE_ADD_TEST (suite, cmd_load_generator_test_run_no_response);
+	SUITE_ADD_TEST (suite, cmd_load_generator_test_run_null);
+	SUITE_ADD_TEST (suite, cmd_load_generator_test_run_bad_config);
+	SUITE_ADD_TEST (suite, cmd_load_generator_test_print_results);
+	SUITE_ADD_TEST (suite, cmd_load_generator_test_print_results_null);
+
+	return suite;
+}
@@ -14,6 +14,7 @@
 #define	TESTING_RUN_FLASH_UTIL_SUITE
 #define	TESTING_RUN_APP_IMAGE_SUITE
 #define	TESTING_RUN_FIRMWARE_UPDATE_SUITE
+#define	TESTING_RUN_FIRMWARE_UPDATE_JOURNAL_SUITE
 #define	TESTING_RUN_HOST_FW_UTIL_SUITE
 #define	TESTING_RUN_MANIFEST_FLASH_SUITE
 #define	TESTING_RUN_PFM_FLASH_SUITE
@@ -38,8 +39,13 @@
 #define	TESTING_RUN_SPI_FILTER_IRQ_HANDLER_SUITE
 #define	TESTING_RUN_PLATFORM_TIMER_SUITE
 #define	TESTING_RUN_BMC_RECOVERY_SUITE
+#define	TESTING_RUN_LOGGING_COALESCE_SUITE
 #define	TESTING_RUN_LOGGING_FLASH_SUITE
+#define	TESTING_RUN_LOGGING_FLASH_COMPACT_SUITE
 #define	TESTING_RUN_LOGGING_MEMORY_SUITE
+#define	TESTING_RUN_LOGGING_RING_SUITE
+#define	TESTING_RUN_TRACE_BUFFER_SUITE
+#define	TESTING_RUN_LOGGING_STAGED_SUITE
 #define	TESTING_RUN_CHECKSUM_SUITE
 #define	TESTING_RUN_MCTP_INTERFACE_SUITE
 #define	TESTING_RUN_ECC_MBEDTLS_SUITE
@@ -57,7 +63,9 @@
 #define	TESTING_RUN_HOST_IRQ_HANDLER_PFM_CHECK_SUITE
 #define	TESTING_RUN_ATTESTATION_MASTER_SUITE
 #define	TESTING_RUN_ATTESTATION_SLAVE_SUITE
+#define	TESTING_RUN_ATTESTATION_SCHEDULER_SUITE
 #define	TESTING_RUN_RNG_MBEDTLS_SUITE
+#define	TESTING_RUN_RNG_BUFFERED_SUITE
 #define	TESTING_RUN_DEVICE_MANAGER_SUITE
 #define	TESTING_RUN_ECC_RIOT_SUITE
 #define	TESTING_RUN_BASE64_RIOT_SUITE
@@ -85,6 +93,9 @@
 #define	TESTING_RUN_SPI_FILTER_SUITE
 #define	TESTING_RUN_IMAGE_HEADER_SUITE
 #define	TESTING_RUN_CMD_CHANNEL_SUITE
+#define	TESTING_RUN_CMD_STATS_SUITE
+#define	TESTING_RUN_CMD_DEFERRED_SUITE
+#define	TESTING_RUN_CMD_CHANNEL_MUX_SUITE
 #define	TESTING_RUN_FIRMWARE_COMPONENT_SUITE
 #define	TESTING_RUN_FLASH_UPDATER_SUITE
 #define	TESTING_RUN_TPM_SUITE
@@ -112,6 +123,10 @@
 #define	TESTING_RUN_AES_OPENSSL_SUITE
 #define	TESTING_RUN_BASE64_OPENSSL_SUITE
 #define	TESTING_RUN_RNG_OPENSSL_SUITE
+#define	TESTING_RUN_CMD_CHANNEL_LOOPBACK_SUITE
+#define	TESTING_RUN_CMD_LOAD_GENERATOR_SUITE
+#define	TESTING_RUN_TRACE_BUFFER_LINUX_SUITE
+#define	TESTING_RUN_RSA_VERIFY_BENCHMARK_SUITE
 
 
 #include "testing/linux_all_tests.h"
@@ -41,6 +41,7 @@ static void ecc_openssl_test_init (CuTest *test)
 	CuAssertPtrNotNull (test, engine.base.get_private_key_der);
 	CuAssertPtrNotNull (test, engine.base.get_public_key_der);
 	CuAssertPtrNotNull (test, engine.base.sign);
+	CuAssertPtrNotNull (test, engine.base.precompute_sign);
 	CuAssertPtrNotNull (test, engine.base.verify);
 	CuAssertPtrNotNull (test, engine.base.get_shared_secret_max_length);
 	CuAssertPtrNotNull (test, engine.base.compute_shared_secret);
@@ -867,6 +868,237 @@ static void ecc_openssl_test_sign_small_buffer (CuTest *test)
 	ecc_openssl_release (&engine);
 }
 
+static void ecc_openssl_test_precompute_sign_and_verify (CuTest *test)
+{
+	struct ecc_engine_openssl engine;
+	struct ecc_private_key priv_key;
+	struct ecc_public_key pub_key;
+	int status;
+	int out_len;
+	uint8_t out[ECC_DSA_MAX_LENGTH * 2];
+
+	TEST_START;
+
+	status = ecc_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.init_key_pair (&engine.base, (const uint8_t*) ECC_PRIVKEY_DER,
+		ECC_PRIVKEY_DER_LEN, &priv_key, &pub_key);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.precompute_sign (&engine.base, &priv_key, 2);
+	CuAssertIntEquals (test, 2, status);
+	CuAssertIntEquals (test, 2, engine.sign_pool_count);
+
+	out_len = engine.base.sign (&engine.base, &priv_key, SIG_HASH_TEST, SIG_HASH_LEN, out,
+		sizeof (out));
+	CuAssertTrue (test, (out_len > 0));
+	CuAssertIntEquals (test, 1, engine.sign_pool_count);
+
+	status = engine.base.verify (&engine.base, &pub_key, SIG_HASH_TEST, SIG_HASH_LEN, out, out_len);
+	CuAssertIntEquals (test, 0, status);
+
+	out_len = engine.base.sign (&engine.base, &priv_key, SIG_HASH_TEST, SIG_HASH_LEN, out,
+		sizeof (out));
+	CuAssertTrue (test, (out_len > 0));
+	CuAssertIntEquals (test, 0, engine.sign_pool_count);
+
+	status = engine.base.verify (&engine.base, &pub_key, SIG_HASH_TEST, SIG_HASH_LEN, out, out_len);
+	CuAssertIntEquals (test, 0, status);
+
+	/* No precomputed values are left, so signing falls back to a full signature. */
+	out_len = engine.base.sign (&engine.base, &priv_key, SIG_HASH_TEST, SIG_HASH_LEN, out,
+		sizeof (out));
+	CuAssertTrue (test, (out_len > 0));
+	CuAssertIntEquals (test, 0, engine.sign_pool_count);
+
+	status = engine.base.verify (&engine.base, &pub_key, SIG_HASH_TEST, SIG_HASH_LEN, out, out_len);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.release_key_pair (&engine.base, &priv_key, &pub_key);
+
+	ecc_openssl_release (&engine);
+}
+
+static void ecc_openssl_test_precompute_sign_unique_signatures (CuTest *test)
+{
+	struct ecc_engine_openssl engine;
+	struct ecc_private_key priv_key;
+	struct ecc_public_key pub_key;
+	int status;
+	int out_len1;
+	int out_len2;
+	uint8_t out1[ECC_DSA_MAX_LENGTH * 2];
+	uint8_t out2[ECC_DSA_MAX_LENGTH * 2];
+
+	TEST_START;
+
+	status = ecc_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.init_key_pair (&engine.base, (const uint8_t*) ECC_PRIVKEY_DER,
+		ECC_PRIVKEY_DER_LEN, &priv_key, &pub_key);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.precompute_sign (&engine.base, &priv_key, 2);
+	CuAssertIntEquals (test, 2, status);
+
+	out_len1 = engine.base.sign (&engine.base, &priv_key, SIG_HASH_TEST, SIG_HASH_LEN, out1,
+		sizeof (out1));
+	CuAssertTrue (test, (out_len1 > 0));
+
+	out_len2 = engine.base.sign (&engine.base, &priv_key, SIG_HASH_TEST, SIG_HASH_LEN, out2,
+		sizeof (out2));
+	CuAssertTrue (test, (out_len2 > 0));
+
+	status = testing_validate_array (out1, out2, (out_len1 < out_len2) ? out_len1 : out_len2);
+	CuAssertTrue (test, (status != 0));
+
+	status = engine.base.verify (&engine.base, &pub_key, SIG_HASH_TEST, SIG_HASH_LEN, out1,
+		out_len1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.verify (&engine.base, &pub_key, SIG_HASH_TEST, SIG_HASH_LEN, out2,
+		out_len2);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.release_key_pair (&engine.base, &priv_key, &pub_key);
+
+	ecc_openssl_release (&engine);
+}
+
+static void ecc_openssl_test_precompute_sign_multiple_calls (CuTest *test)
+{
+	struct ecc_engine_openssl engine;
+	struct ecc_private_key priv_key;
+	int status;
+
+	TEST_START;
+
+	status = ecc_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.init_key_pair (&engine.base, (const uint8_t*) ECC_PRIVKEY_DER,
+		ECC_PRIVKEY_DER_LEN, &priv_key, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.precompute_sign (&engine.base, &priv_key, 1);
+	CuAssertIntEquals (test, 1, status);
+	CuAssertIntEquals (test, 1, engine.sign_pool_count);
+
+	status = engine.base.precompute_sign (&engine.base, &priv_key, 1);
+	CuAssertIntEquals (test, 1, status);
+	CuAssertIntEquals (test, 2, engine.sign_pool_count);
+
+	status = engine.base.precompute_sign (&engine.base, &priv_key, 0);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, engine.sign_pool_count);
+
+	engine.base.release_key_pair (&engine.base, &priv_key, NULL);
+
+	ecc_openssl_release (&engine);
+}
+
+static void ecc_openssl_test_precompute_sign_pool_full (CuTest *test)
+{
+	struct ecc_engine_openssl engine;
+	struct ecc_private_key priv_key;
+	struct ecc_public_key pub_key;
+	int status;
+	int out_len;
+	uint8_t out[ECC_DSA_MAX_LENGTH * 2];
+
+	TEST_START;
+
+	status = ecc_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.init_key_pair (&engine.base, (const uint8_t*) ECC_PRIVKEY_DER,
+		ECC_PRIVKEY_DER_LEN, &priv_key, &pub_key);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.precompute_sign (&engine.base, &priv_key,
+		ECC_OPENSSL_SIGN_POOL_SIZE + 2);
+	CuAssertIntEquals (test, ECC_OPENSSL_SIGN_POOL_SIZE, status);
+	CuAssertIntEquals (test, ECC_OPENSSL_SIGN_POOL_SIZE, engine.sign_pool_count);
+
+	status = engine.base.precompute_sign (&engine.base, &priv_key, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	out_len = engine.base.sign (&engine.base, &priv_key, SIG_HASH_TEST, SIG_HASH_LEN, out,
+		sizeof (out));
+	CuAssertTrue (test, (out_len > 0));
+	CuAssertIntEquals (test, ECC_OPENSSL_SIGN_POOL_SIZE - 1, engine.sign_pool_count);
+
+	status = engine.base.verify (&engine.base, &pub_key, SIG_HASH_TEST, SIG_HASH_LEN, out, out_len);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.precompute_sign (&engine.base, &priv_key, 2);
+	CuAssertIntEquals (test, 1, status);
+	CuAssertIntEquals (test, ECC_OPENSSL_SIGN_POOL_SIZE, engine.sign_pool_count);
+
+	engine.base.release_key_pair (&engine.base, &priv_key, &pub_key);
+
+	ecc_openssl_release (&engine);
+}
+
+static void ecc_openssl_test_precompute_sign_small_buffer (CuTest *test)
+{
+	struct ecc_engine_openssl engine;
+	struct ecc_private_key priv_key;
+	int status;
+	uint8_t out[ECC_DSA_MAX_LENGTH * 2];
+
+	TEST_START;
+
+	status = ecc_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.init_key_pair (&engine.base, (const uint8_t*) ECC_PRIVKEY_DER,
+		ECC_PRIVKEY_DER_LEN, &priv_key, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.precompute_sign (&engine.base, &priv_key, 1);
+	CuAssertIntEquals (test, 1, status);
+
+	status = engine.base.sign (&engine.base, &priv_key, SIG_HASH_TEST, SIG_HASH_LEN, out,
+		ECC_DSA_MAX_LENGTH - 1);
+	CuAssertIntEquals (test, ECC_ENGINE_SIG_BUFFER_TOO_SMALL, status);
+	CuAssertIntEquals (test, 1, engine.sign_pool_count);
+
+	engine.base.release_key_pair (&engine.base, &priv_key, NULL);
+
+	ecc_openssl_release (&engine);
+}
+
+static void ecc_openssl_test_precompute_sign_null (CuTest *test)
+{
+	struct ecc_engine_openssl engine;
+	struct ecc_private_key priv_key;
+	int status;
+
+	TEST_START;
+
+	status = ecc_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.init_key_pair (&engine.base, (const uint8_t*) ECC_PRIVKEY_DER,
+		ECC_PRIVKEY_DER_LEN, &priv_key, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.precompute_sign (NULL, &priv_key, 1);
+	CuAssertIntEquals (test, ECC_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.precompute_sign (&engine.base, NULL, 1);
+	CuAssertIntEquals (test, ECC_ENGINE_INVALID_ARGUMENT, status);
+
+	CuAssertIntEquals (test, 0, engine.sign_pool_count);
+
+	engine.base.release_key_pair (&engine.base, &priv_key, NULL);
+
+	ecc_openssl_release (&engine);
+}
+
 static void ecc_openssl_test_verify_null (CuTest *test)
 {
 	struct ecc_engine_openssl engine;
@@ -1695,6 +1927,12 @@ CuSuite* get_ecc_openssl_suite ()
 	SUITE_ADD_TEST (suite, ecc_openssl_test_generate_key_pair_null);
 	SUITE_ADD_TEST (suite, ecc_openssl_test_sign_null);
 	SUITE_ADD_TEST (suite, ecc_openssl_test_sign_small_buffer);
+	SUITE_ADD_TEST (suite, ecc_openssl_test_precompute_sign_and_verify);
+	SUITE_ADD_TEST (suite, ecc_openssl_test_precompute_sign_unique_signatures);
+	SUITE_ADD_TEST (suite, ecc_openssl_test_precompute_sign_multiple_calls);
+	SUITE_ADD_TEST (suite, ecc_openssl_test_precompute_sign_pool_full);
+	SUITE_ADD_TEST (suite, ecc_openssl_test_precompute_sign_small_buffer);
+	SUITE_ADD_TEST (suite, ecc_openssl_test_precompute_sign_null);
 	SUITE_ADD_TEST (suite, ecc_openssl_test_verify_null);
 	SUITE_ADD_TEST (suite, ecc_openssl_test_verify_corrupt_signature);
 	SUITE_ADD_TEST (suite, ecc_openssl_test_get_signature_max_length);
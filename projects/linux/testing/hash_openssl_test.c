@@ -5,6 +5,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
+#include <openssl/sha.h>
 #include "testing.h"
 #include "crypto/hash_openssl.h"
 
@@ -12,6 +13,66 @@
 static const char *SUITE = "hash_openssl";
 
 
+/**
+ * Lengths of the buffers used to test multi-buffer hashing.  These cover each of the padding
+ * boundaries for SHA-256.
+ */
+static const size_t HASH_OPENSSL_TESTING_MULTI_LENGTHS[] = {
+	1, 3, 55, 56, 57, 63, 64, 65, 119, 120, 127, 128, 129, 200, 255, 256, 300, 1000, 4096
+};
+
+#define	HASH_OPENSSL_TESTING_MULTI_COUNT	\
+	(sizeof (HASH_OPENSSL_TESTING_MULTI_LENGTHS) / sizeof (HASH_OPENSSL_TESTING_MULTI_LENGTHS[0]))
+
+/**
+ * Calculate multiple SHA-256 hashes with a specific implementation and check the results against
+ * hashes calculated individually.
+ *
+ * @param test The test framework.
+ * @param impl The multi-buffer implementation to use.
+ * @param count The number of buffers to hash.
+ */
+static void hash_openssl_testing_calculate_sha256_multi (CuTest *test, enum sha256_multi_impl impl,
+	size_t count)
+{
+	struct hash_engine_openssl engine;
+	struct hash_multi_buffer buffers[HASH_OPENSSL_TESTING_MULTI_COUNT];
+	uint8_t data[4096 + HASH_OPENSSL_TESTING_MULTI_COUNT];
+	uint8_t hash[HASH_OPENSSL_TESTING_MULTI_COUNT][SHA256_HASH_LENGTH];
+	uint8_t expected[SHA256_HASH_LENGTH];
+	size_t i;
+	int status;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = (uint8_t) (i * 7 + 3);
+	}
+
+	for (i = 0; i < count; i++) {
+		buffers[i].data = &data[i];
+		buffers[i].length = HASH_OPENSSL_TESTING_MULTI_LENGTHS[i];
+		buffers[i].hash = hash[i];
+		buffers[i].hash_length = sizeof (hash[i]);
+	}
+
+	status = hash_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.multi = impl;
+
+	status = engine.base.calculate_sha256_multi (&engine.base, buffers, count);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < count; i++) {
+		SHA256 (buffers[i].data, buffers[i].length, expected);
+
+		status = testing_validate_array (expected, hash[i], sizeof (expected));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	hash_openssl_release (&engine);
+}
+
+
 /*******************
  * Test cases
  *******************/
@@ -28,6 +89,7 @@ static void hash_openssl_test_init (CuTest *test)
 
 	CuAssertPtrNotNull (test, engine.base.calculate_sha1);
 	CuAssertPtrNotNull (test, engine.base.calculate_sha256);
+	CuAssertPtrNotNull (test, engine.base.calculate_sha256_multi);
 	CuAssertPtrNotNull (test, engine.base.start_sha1);
 	CuAssertPtrNotNull (test, engine.base.start_sha256);
 	CuAssertPtrNotNull (test, engine.base.update);
@@ -595,6 +657,130 @@ static void hash_openssl_test_calculate_sha256_small_hash_buffer (CuTest *test)
 	hash_openssl_release (&engine);
 }
 
+static void hash_openssl_test_calculate_sha256_multi (CuTest *test)
+{
+	TEST_START;
+
+	hash_openssl_testing_calculate_sha256_multi (test, sha256_multi_get_best_impl (),
+		HASH_OPENSSL_TESTING_MULTI_COUNT);
+}
+
+static void hash_openssl_test_calculate_sha256_multi_single_buffer (CuTest *test)
+{
+	TEST_START;
+
+	hash_openssl_testing_calculate_sha256_multi (test, sha256_multi_get_best_impl (), 1);
+}
+
+static void hash_openssl_test_calculate_sha256_multi_serial (CuTest *test)
+{
+	TEST_START;
+
+	hash_openssl_testing_calculate_sha256_multi (test, SHA256_MULTI_IMPL_SERIAL,
+		HASH_OPENSSL_TESTING_MULTI_COUNT);
+}
+
+static void hash_openssl_test_calculate_sha256_multi_shani_x2 (CuTest *test)
+{
+	TEST_START;
+
+	if (!sha256_multi_is_impl_supported (SHA256_MULTI_IMPL_SHANI_X2)) {
+		printf ("Skipping SHA extensions test.  Not supported by the CPU.\n");
+		return;
+	}
+
+	hash_openssl_testing_calculate_sha256_multi (test, SHA256_MULTI_IMPL_SHANI_X2,
+		HASH_OPENSSL_TESTING_MULTI_COUNT);
+	hash_openssl_testing_calculate_sha256_multi (test, SHA256_MULTI_IMPL_SHANI_X2, 3);
+}
+
+static void hash_openssl_test_calculate_sha256_multi_avx2_x8 (CuTest *test)
+{
+	TEST_START;
+
+	if (!sha256_multi_is_impl_supported (SHA256_MULTI_IMPL_AVX2_X8)) {
+		printf ("Skipping AVX2 test.  Not supported by the CPU.\n");
+		return;
+	}
+
+	hash_openssl_testing_calculate_sha256_multi (test, SHA256_MULTI_IMPL_AVX2_X8,
+		HASH_OPENSSL_TESTING_MULTI_COUNT);
+	hash_openssl_testing_calculate_sha256_multi (test, SHA256_MULTI_IMPL_AVX2_X8, 5);
+}
+
+static void hash_openssl_test_calculate_sha256_multi_null (CuTest *test)
+{
+	struct hash_engine_openssl engine;
+	struct hash_multi_buffer buffers[2];
+	char *message = "Test";
+	uint8_t hash[2][SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	buffers[0].data = (uint8_t*) message;
+	buffers[0].length = strlen (message);
+	buffers[0].hash = hash[0];
+	buffers[0].hash_length = sizeof (hash[0]);
+	buffers[1] = buffers[0];
+	buffers[1].hash = hash[1];
+
+	status = hash_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha256_multi (NULL, buffers, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.calculate_sha256_multi (&engine.base, NULL, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.calculate_sha256_multi (&engine.base, buffers, 0);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	buffers[1].data = NULL;
+	status = engine.base.calculate_sha256_multi (&engine.base, buffers, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	buffers[1].data = (uint8_t*) message;
+	buffers[1].length = 0;
+	status = engine.base.calculate_sha256_multi (&engine.base, buffers, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	buffers[1].length = strlen (message);
+	buffers[1].hash = NULL;
+	status = engine.base.calculate_sha256_multi (&engine.base, buffers, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_openssl_release (&engine);
+}
+
+static void hash_openssl_test_calculate_sha256_multi_small_hash_buffer (CuTest *test)
+{
+	struct hash_engine_openssl engine;
+	struct hash_multi_buffer buffers[2];
+	char *message = "Test";
+	uint8_t hash[2][SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	buffers[0].data = (uint8_t*) message;
+	buffers[0].length = strlen (message);
+	buffers[0].hash = hash[0];
+	buffers[0].hash_length = sizeof (hash[0]);
+	buffers[1] = buffers[0];
+	buffers[1].hash = hash[1];
+	buffers[1].hash_length = SHA256_HASH_LENGTH - 1;
+
+	status = hash_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha256_multi (&engine.base, buffers, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_BUFFER_TOO_SMALL, status);
+
+	hash_openssl_release (&engine);
+}
+
 
 CuSuite* get_hash_openssl_suite ()
 {
@@ -625,6 +811,13 @@ CuSuite* get_hash_openssl_suite ()
 	SUITE_ADD_TEST (suite, hash_openssl_test_calculate_sha256);
 	SUITE_ADD_TEST (suite, hash_openssl_test_calculate_sha256_null);
 	SUITE_ADD_TEST (suite, hash_openssl_test_calculate_sha256_small_hash_buffer);
+	SUITE_ADD_TEST (suite, hash_openssl_test_calculate_sha256_multi);
+	SUITE_ADD_TEST (suite, hash_openssl_test_calculate_sha256_multi_single_buffer);
+	SUITE_ADD_TEST (suite, hash_openssl_test_calculate_sha256_multi_serial);
+	SUITE_ADD_TEST (suite, hash_openssl_test_calculate_sha256_multi_shani_x2);
+	SUITE_ADD_TEST (suite, hash_openssl_test_calculate_sha256_multi_avx2_x8);
+	SUITE_ADD_TEST (suite, hash_openssl_test_calculate_sha256_multi_null);
+	SUITE_ADD_TEST (suite, hash_openssl_test_calculate_sha256_multi_small_hash_buffer);
 
 	return suite;
 }
@@ -15,6 +15,10 @@
 //#define	TESTING_RUN_AES_OPENSSL_SUITE
 //#define	TESTING_RUN_BASE64_OPENSSL_SUITE
 //#define	TESTING_RUN_RNG_OPENSSL_SUITE
+//#define	TESTING_RUN_CMD_CHANNEL_LOOPBACK_SUITE
+//#define	TESTING_RUN_CMD_LOAD_GENERATOR_SUITE
+//#define	TESTING_RUN_RSA_VERIFY_BENCHMARK_SUITE
+//#define	TESTING_RUN_TRACE_BUFFER_LINUX_SUITE
 
 
 CuSuite* get_hash_openssl_suite (void);
@@ -24,6 +28,10 @@ CuSuite* get_x509_openssl_suite (void);
 CuSuite* get_aes_openssl_suite (void);
 CuSuite* get_base64_openssl_suite (void);
 CuSuite* get_rng_openssl_suite (void);
+CuSuite* get_cmd_channel_loopback_suite (void);
+CuSuite* get_cmd_load_generator_suite (void);
+CuSuite* get_rsa_verify_benchmark_suite (void);
+CuSuite* get_trace_buffer_linux_suite (void);
 
 void linux_teardown (CuTest *test)
 {
@@ -55,6 +63,18 @@ void add_all_linux_tests (CuSuite *suite)
 #ifdef TESTING_RUN_RNG_OPENSSL_SUITE
 	CuSuiteAddSuite (suite, get_rng_openssl_suite ());
 #endif
+#ifdef TESTING_RUN_CMD_CHANNEL_LOOPBACK_SUITE
+	CuSuiteAddSuite (suite, get_cmd_channel_loopback_suite ());
+#endif
+#ifdef TESTING_RUN_CMD_LOAD_GENERATOR_SUITE
+	CuSuiteAddSuite (suite, get_cmd_load_generator_suite ());
+#endif
+#ifdef TESTING_RUN_RSA_VERIFY_BENCHMARK_SUITE
+	CuSuiteAddSuite (suite, get_rsa_verify_benchmark_suite ());
+#endif
+#ifdef TESTING_RUN_TRACE_BUFFER_LINUX_SUITE
+	CuSuiteAddSuite (suite, get_trace_buffer_linux_suite ());
+#endif
 
 	SUITE_ADD_TEST (suite, linux_teardown);
 }
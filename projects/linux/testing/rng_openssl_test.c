@@ -27,6 +27,7 @@ static void rng_openssl_test_init (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 
 	CuAssertPtrNotNull (test, engine.base.generate_random_buffer);
+	CuAssertPtrNotNull (test, engine.base.reseed);
 
 	rng_openssl_release (&engine);
 }
@@ -125,6 +126,42 @@ static void rng_openssl_test_generate_random_buffer_null (CuTest *test)
 	rng_openssl_release (&engine);
 }
 
+static void rng_openssl_test_reseed (CuTest *test)
+{
+	struct rng_engine_openssl engine;
+	uint8_t buffer[32];
+	int status;
+
+	TEST_START;
+
+	status = rng_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.reseed (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.generate_random_buffer (&engine.base, 32, buffer);
+	CuAssertIntEquals (test, 0, status);
+
+	rng_openssl_release (&engine);
+}
+
+static void rng_openssl_test_reseed_null (CuTest *test)
+{
+	struct rng_engine_openssl engine;
+	int status;
+
+	TEST_START;
+
+	status = rng_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.reseed (NULL);
+	CuAssertIntEquals (test, RNG_ENGINE_INVALID_ARGUMENT, status);
+
+	rng_openssl_release (&engine);
+}
+
 
 CuSuite* get_rng_openssl_suite ()
 {
@@ -137,6 +174,8 @@ CuSuite* get_rng_openssl_suite ()
 	SUITE_ADD_TEST (suite, rng_openssl_test_generate_random_buffer);
 	SUITE_ADD_TEST (suite, rng_openssl_test_generate_random_buffer_twice);
 	SUITE_ADD_TEST (suite, rng_openssl_test_generate_random_buffer_null);
+	SUITE_ADD_TEST (suite, rng_openssl_test_reseed);
+	SUITE_ADD_TEST (suite, rng_openssl_test_reseed_null);
 
 	return suite;
 }
@@ -5,6 +5,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
+#include <pthread.h>
 #include "platform.h"
 #include "testing.h"
 #include "testing/rsa_testing.h"
@@ -216,6 +217,225 @@ static void rsa_openssl_test_sig_verify_bad_signature (CuTest *test)
 	rsa_openssl_release (&engine);
 }
 
+static void rsa_openssl_test_sig_verify_cached_key (CuTest *test)
+{
+	struct rsa_engine_openssl engine;
+	int cached;
+	int i;
+	int status;
+
+	TEST_START;
+
+	status = rsa_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST2,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST2, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_NOPE,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	cached = 0;
+	for (i = 0; i < RSA_OPENSSL_KEY_CACHE_SIZE; i++) {
+		if (engine.key_cache[i].rsa != NULL) {
+			cached++;
+			CuAssertTrue (test, rsa_same_public_key (&RSA_PUBLIC_KEY, &engine.key_cache[i].key));
+		}
+	}
+	CuAssertIntEquals (test, 1, cached);
+
+	rsa_openssl_release (&engine);
+}
+
+static void rsa_openssl_test_sig_verify_multiple_keys (CuTest *test)
+{
+	struct rsa_engine_openssl engine;
+	int i;
+	int status;
+
+	TEST_START;
+
+	status = rsa_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 2; i++) {
+		status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+			RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+		CuAssertIntEquals (test, 0, status);
+
+		status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY2, RSA_SIGNATURE2_TEST,
+			RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+		CuAssertIntEquals (test, 0, status);
+
+		status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY3, RSA_SIGNATURE3_TEST,
+			RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+		CuAssertIntEquals (test, 0, status);
+
+		status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY2, RSA_SIGNATURE_TEST,
+			RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+		CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+	}
+
+	rsa_openssl_release (&engine);
+}
+
+static void rsa_openssl_test_sig_verify_cache_evict_least_recent (CuTest *test)
+{
+	struct rsa_engine_openssl engine;
+	struct rsa_public_key key[RSA_OPENSSL_KEY_CACHE_SIZE];
+	bool found_key;
+	bool found_evicted;
+	int i;
+	int status;
+
+	TEST_START;
+
+	status = rsa_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Use the same modulus with different exponents to generate unique keys. */
+	for (i = 0; i < RSA_OPENSSL_KEY_CACHE_SIZE; i++) {
+		memcpy (&key[i], &RSA_PUBLIC_KEY, sizeof (key[i]));
+		key[i].exponent = 3 + (i * 2);
+	}
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < (RSA_OPENSSL_KEY_CACHE_SIZE - 1); i++) {
+		status = engine.base.sig_verify (&engine.base, &key[i], RSA_SIGNATURE_TEST,
+			RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+		CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+	}
+
+	/* Use the first key again so the oldest key is the first of the generated keys. */
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &key[RSA_OPENSSL_KEY_CACHE_SIZE - 1], RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	found_key = false;
+	found_evicted = false;
+	for (i = 0; i < RSA_OPENSSL_KEY_CACHE_SIZE; i++) {
+		CuAssertPtrNotNull (test, engine.key_cache[i].rsa);
+
+		if (rsa_same_public_key (&RSA_PUBLIC_KEY, &engine.key_cache[i].key)) {
+			found_key = true;
+		}
+		if (rsa_same_public_key (&key[0], &engine.key_cache[i].key)) {
+			found_evicted = true;
+		}
+	}
+	CuAssertIntEquals (test, true, found_key);
+	CuAssertIntEquals (test, false, found_evicted);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	rsa_openssl_release (&engine);
+}
+
+static void rsa_openssl_test_flush_key_cache (CuTest *test)
+{
+	struct rsa_engine_openssl engine;
+	int i;
+	int status;
+
+	TEST_START;
+
+	status = rsa_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY2, RSA_SIGNATURE2_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	rsa_openssl_flush_key_cache (&engine);
+
+	for (i = 0; i < RSA_OPENSSL_KEY_CACHE_SIZE; i++) {
+		CuAssertPtrEquals (test, NULL, engine.key_cache[i].rsa);
+	}
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	rsa_openssl_release (&engine);
+}
+
+/**
+ * Thread function to repeatedly verify a signature using a cached key.
+ *
+ * @param arg The RSA engine to use for verification.
+ *
+ * @return The number of verifications that failed.
+ */
+static void* rsa_openssl_testing_verify_thread (void *arg)
+{
+	struct rsa_engine_openssl *engine = (struct rsa_engine_openssl*) arg;
+	intptr_t failed = 0;
+	int i;
+
+	for (i = 0; i < 200; i++) {
+		if (engine->base.sig_verify (&engine->base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+			RSA_ENCRYPT_LEN, SIG_HASH_TEST, SIG_HASH_LEN) != 0) {
+			failed++;
+		}
+	}
+
+	return (void*) failed;
+}
+
+static void rsa_openssl_test_sig_verify_concurrent_flush (CuTest *test)
+{
+	struct rsa_engine_openssl engine;
+	pthread_t thread;
+	void *failed;
+	int i;
+	int status;
+
+	TEST_START;
+
+	status = rsa_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pthread_create (&thread, NULL, rsa_openssl_testing_verify_thread, &engine);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Keys must not be freed while they are in use by another verification. */
+	for (i = 0; i < 200; i++) {
+		rsa_openssl_flush_key_cache (&engine);
+	}
+
+	status = pthread_join (thread, &failed);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, (intptr_t) failed);
+
+	rsa_openssl_release (&engine);
+}
+
+static void rsa_openssl_test_flush_key_cache_null (CuTest *test)
+{
+	TEST_START;
+
+	rsa_openssl_flush_key_cache (NULL);
+}
+
 static void rsa_openssl_test_init_private_key (CuTest *test)
 {
 	struct rsa_engine_openssl engine;
@@ -973,6 +1193,12 @@ CuSuite* get_rsa_openssl_suite ()
 	SUITE_ADD_TEST (suite, rsa_openssl_test_sig_verify_null);
 	SUITE_ADD_TEST (suite, rsa_openssl_test_sig_verify_no_match);
 	SUITE_ADD_TEST (suite, rsa_openssl_test_sig_verify_bad_signature);
+	SUITE_ADD_TEST (suite, rsa_openssl_test_sig_verify_cached_key);
+	SUITE_ADD_TEST (suite, rsa_openssl_test_sig_verify_multiple_keys);
+	SUITE_ADD_TEST (suite, rsa_openssl_test_sig_verify_cache_evict_least_recent);
+	SUITE_ADD_TEST (suite, rsa_openssl_test_flush_key_cache);
+	SUITE_ADD_TEST (suite, rsa_openssl_test_sig_verify_concurrent_flush);
+	SUITE_ADD_TEST (suite, rsa_openssl_test_flush_key_cache_null);
 	SUITE_ADD_TEST (suite, rsa_openssl_test_init_private_key);
 	SUITE_ADD_TEST (suite, rsa_openssl_test_init_private_key_null);
 	SUITE_ADD_TEST (suite, rsa_openssl_test_init_private_key_with_public_key);
@@ -0,0 +1,247 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "crypto/rsa_verify_benchmark.h"
+#include "crypto/rsa_openssl.h"
+#include "crypto/rsa_mbedtls.h"
+#include "testing/rsa_testing.h"
+#include "testing/signature_testing.h"
+
+
+static const char *SUITE = "rsa_verify_benchmark";
+
+
+/**
+ * Flush handler for the mbedTLS RSA engine.
+ *
+ * @param engine The engine to flush.
+ */
+static void rsa_verify_benchmark_testing_flush_mbedtls (struct rsa_engine *engine)
+{
+	rsa_mbedtls_flush_key_cache ((struct rsa_engine_mbedtls*) engine);
+}
+
+/**
+ * Flush handler for the openssl RSA engine.
+ *
+ * @param engine The engine to flush.
+ */
+static void rsa_verify_benchmark_testing_flush_openssl (struct rsa_engine *engine)
+{
+	rsa_openssl_flush_key_cache ((struct rsa_engine_openssl*) engine);
+}
+
+/**
+ * Initialize a benchmark configuration for verifying the test signature.
+ *
+ * @param config The configuration to initialize.
+ * @param verifications The number of verifications to run.
+ */
+static void rsa_verify_benchmark_testing_init_config (struct rsa_verify_benchmark_config *config,
+	uint32_t verifications)
+{
+	memset (config, 0, sizeof (struct rsa_verify_benchmark_config));
+
+	config->key = &RSA_PUBLIC_KEY;
+	config->signature = RSA_SIGNATURE_TEST;
+	config->sig_length = RSA_ENCRYPT_LEN;
+	config->digest = SIG_HASH_TEST;
+	config->digest_length = SIG_HASH_LEN;
+	config->verifications = verifications;
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void rsa_verify_benchmark_test_run_mbedtls (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	struct rsa_verify_benchmark_config config;
+	struct rsa_verify_benchmark_results cached;
+	struct rsa_verify_benchmark_results uncached;
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	rsa_verify_benchmark_testing_init_config (&config, 100);
+
+	status = rsa_verify_benchmark_run (&engine.base, &config, &cached);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 100, cached.verified);
+	CuAssertIntEquals (test, 0, cached.failed);
+
+	config.flush = rsa_verify_benchmark_testing_flush_mbedtls;
+
+	status = rsa_verify_benchmark_run (&engine.base, &config, &uncached);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 100, uncached.verified);
+	CuAssertIntEquals (test, 0, uncached.failed);
+
+	rsa_mbedtls_release (&engine);
+}
+
+static void rsa_verify_benchmark_test_run_openssl (CuTest *test)
+{
+	struct rsa_engine_openssl engine;
+	struct rsa_verify_benchmark_config config;
+	struct rsa_verify_benchmark_results cached;
+	struct rsa_verify_benchmark_results uncached;
+	int status;
+
+	TEST_START;
+
+	status = rsa_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	rsa_verify_benchmark_testing_init_config (&config, 100);
+
+	status = rsa_verify_benchmark_run (&engine.base, &config, &cached);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 100, cached.verified);
+	CuAssertIntEquals (test, 0, cached.failed);
+
+	config.flush = rsa_verify_benchmark_testing_flush_openssl;
+
+	status = rsa_verify_benchmark_run (&engine.base, &config, &uncached);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 100, uncached.verified);
+	CuAssertIntEquals (test, 0, uncached.failed);
+
+	rsa_openssl_release (&engine);
+}
+
+static void rsa_verify_benchmark_test_run_bad_signature (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	struct rsa_verify_benchmark_config config;
+	struct rsa_verify_benchmark_results results;
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	rsa_verify_benchmark_testing_init_config (&config, 10);
+	config.signature = RSA_SIGNATURE_NOPE;
+
+	status = rsa_verify_benchmark_run (&engine.base, &config, &results);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, results.verified);
+	CuAssertIntEquals (test, 10, results.failed);
+	CuAssertIntEquals (test, 0, results.verify_per_sec);
+
+	rsa_mbedtls_release (&engine);
+}
+
+static void rsa_verify_benchmark_test_run_null (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	struct rsa_verify_benchmark_config config;
+	struct rsa_verify_benchmark_results results;
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	rsa_verify_benchmark_testing_init_config (&config, 10);
+
+	status = rsa_verify_benchmark_run (NULL, &config, &results);
+	CuAssertIntEquals (test, RSA_VERIFY_BENCHMARK_INVALID_ARGUMENT, status);
+
+	status = rsa_verify_benchmark_run (&engine.base, NULL, &results);
+	CuAssertIntEquals (test, RSA_VERIFY_BENCHMARK_INVALID_ARGUMENT, status);
+
+	status = rsa_verify_benchmark_run (&engine.base, &config, NULL);
+	CuAssertIntEquals (test, RSA_VERIFY_BENCHMARK_INVALID_ARGUMENT, status);
+
+	config.key = NULL;
+	status = rsa_verify_benchmark_run (&engine.base, &config, &results);
+	CuAssertIntEquals (test, RSA_VERIFY_BENCHMARK_INVALID_ARGUMENT, status);
+
+	rsa_verify_benchmark_testing_init_config (&config, 10);
+	config.signature = NULL;
+	status = rsa_verify_benchmark_run (&engine.base, &config, &results);
+	CuAssertIntEquals (test, RSA_VERIFY_BENCHMARK_INVALID_ARGUMENT, status);
+
+	rsa_verify_benchmark_testing_init_config (&config, 10);
+	config.digest = NULL;
+	status = rsa_verify_benchmark_run (&engine.base, &config, &results);
+	CuAssertIntEquals (test, RSA_VERIFY_BENCHMARK_INVALID_ARGUMENT, status);
+
+	rsa_verify_benchmark_testing_init_config (&config, 0);
+	status = rsa_verify_benchmark_run (&engine.base, &config, &results);
+	CuAssertIntEquals (test, RSA_VERIFY_BENCHMARK_INVALID_ARGUMENT, status);
+
+	rsa_mbedtls_release (&engine);
+}
+
+static void rsa_verify_benchmark_test_print_results (CuTest *test)
+{
+	struct rsa_verify_benchmark_results results;
+	FILE *out;
+	char line[64];
+
+	TEST_START;
+
+	memset (&results, 0, sizeof (results));
+	results.verified = 10;
+	results.verify_per_sec = 1234;
+
+	out = tmpfile ();
+	CuAssertPtrNotNull (test, out);
+
+	rsa_verify_benchmark_print_results ("mbedtls cached", &results, out);
+	rewind (out);
+
+	CuAssertPtrNotNull (test, fgets (line, sizeof (line), out));
+	CuAssertStrEquals (test, "mbedtls cached\n", line);
+
+	CuAssertPtrNotNull (test, fgets (line, sizeof (line), out));
+	CuAssertStrEquals (test, "verified         10\n", line);
+
+	while (fgets (line, sizeof (line), out) && (strncmp (line, "throughput", 10) != 0));
+	CuAssertStrEquals (test, "throughput       1234 verify/s\n", line);
+
+	fclose (out);
+}
+
+static void rsa_verify_benchmark_test_print_results_null (CuTest *test)
+{
+	struct rsa_verify_benchmark_results results;
+
+	TEST_START;
+
+	memset (&results, 0, sizeof (results));
+
+	rsa_verify_benchmark_print_results (NULL, &results, stdout);
+	rsa_verify_benchmark_print_results ("test", NULL, stdout);
+	rsa_verify_benchmark_print_results ("test", &results, NULL);
+}
+
+
+CuSuite* get_rsa_verify_benchmark_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, rsa_verify_benchmark_test_run_mbedtls);
+	SUITE_ADD_TEST (suite, rsa_verify_benchmark_test_run_openssl);
+	SUITE_ADD_TEST (suite, rsa_verify_benchmark_test_run_bad_signature);
+	SUITE_ADD_TEST (suite, rsa_verify_benchmark_test_run_null);
+	SUITE_ADD_TEST (suite, rsa_verify_benchmark_test_print_results);
+	SUITE_ADD_TEST (suite, rsa_verify_benchmark_test_print_results_null);
+
+	return suite;
+}
@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "platform.h"
+#include "logging/logging.h"
+#include "logging/trace_buffer_linux.h"
+
+
+static const char *SUITE = "trace_buffer_linux";
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void trace_buffer_linux_test_timestamp (CuTest *test)
+{
+	uint32_t start;
+	uint32_t end;
+
+	TEST_START;
+
+	start = trace_buffer_linux_timestamp ();
+	platform_msleep (10);
+	end = trace_buffer_linux_timestamp ();
+
+	CuAssertTrue (test, ((end - start) >= 10000));
+}
+
+static void trace_buffer_linux_test_dump (CuTest *test)
+{
+	struct trace_record records[4];
+	struct trace_buffer trace;
+	FILE *out;
+	char line[256];
+	int status;
+
+	TEST_START;
+
+	status = trace_buffer_init (&trace, records, 4, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = trace_buffer_register (&trace, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	trace_buffer_add (&trace, TRACE_EVENT_FLASH_XFER, TRACE_PHASE_BEGIN, 3, 256);
+	trace_buffer_add (&trace, TRACE_EVENT_FLASH_XFER, TRACE_PHASE_END, 3, 0);
+	trace_buffer_add (&trace, TRACE_EVENT_PLATFORM + 1, TRACE_PHASE_INSTANT, 1, 2);
+
+	records[0].timestamp = 5;
+	records[1].timestamp = 7;
+	records[2].timestamp = 9;
+
+	out = tmpfile ();
+	CuAssertPtrNotNull (test, out);
+
+	status = trace_buffer_linux_dump (out, 1000);
+	CuAssertIntEquals (test, 0, status);
+	rewind (out);
+
+	CuAssertPtrNotNull (test, fgets (line, sizeof (line), out));
+	CuAssertStrEquals (test, "{\"traceEvents\":[\n", line);
+
+	CuAssertPtrNotNull (test, fgets (line, sizeof (line), out));
+	CuAssertStrEquals (test,
+		"{\"name\":\"flash_xfer\",\"ph\":\"B\",\"ts\":5000,\"pid\":0,\"tid\":0,"
+		"\"args\":{\"arg1\":3,\"arg2\":256}},\n", line);
+
+	CuAssertPtrNotNull (test, fgets (line, sizeof (line), out));
+	CuAssertStrEquals (test,
+		"{\"name\":\"flash_xfer\",\"ph\":\"E\",\"ts\":7000,\"pid\":0,\"tid\":0,"
+		"\"args\":{\"arg1\":3,\"arg2\":0}},\n", line);
+
+	CuAssertPtrNotNull (test, fgets (line, sizeof (line), out));
+	CuAssertStrEquals (test,
+		"{\"name\":\"event_0x8001\",\"ph\":\"i\",\"ts\":9000,\"pid\":0,\"tid\":0,\"s\":\"t\","
+		"\"args\":{\"arg1\":1,\"arg2\":2}}\n", line);
+
+	CuAssertPtrNotNull (test, fgets (line, sizeof (line), out));
+	CuAssertStrEquals (test, "]}\n", line);
+
+	fclose (out);
+
+	trace_buffer_register (NULL, 0);
+	trace_buffer_release (&trace);
+}
+
+static void trace_buffer_linux_test_dump_no_trace (CuTest *test)
+{
+	FILE *out;
+	char line[64];
+	int status;
+
+	TEST_START;
+
+	out = tmpfile ();
+	CuAssertPtrNotNull (test, out);
+
+	status = trace_buffer_linux_dump (out, 1);
+	CuAssertIntEquals (test, 0, status);
+	rewind (out);
+
+	CuAssertPtrNotNull (test, fgets (line, sizeof (line), out));
+	CuAssertStrEquals (test, "{\"traceEvents\":[\n", line);
+
+	CuAssertPtrNotNull (test, fgets (line, sizeof (line), out));
+	CuAssertStrEquals (test, "]}\n", line);
+
+	fclose (out);
+}
+
+static void trace_buffer_linux_test_dump_invalid_arg (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = trace_buffer_linux_dump (NULL, 1);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = trace_buffer_linux_dump (stdout, 0);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+}
+
+
+CuSuite* get_trace_buffer_linux_suite ()
+{
+	CuSuite *suite = CuSuiteNew ();
+
+	SUITE_ADD_TEST (suite, trace_buffer_linux_test_timestamp);
+	SUITE_ADD_TEST (suite, trace_buffer_linux_test_dump);
+	SUITE_ADD_TEST (suite, trace_buffer_linux_test_dump_no_trace);
+	SUITE_ADD_TEST (suite, trace_buffer_linux_test_dump_invalid_arg);
+
+	return suite;
+}
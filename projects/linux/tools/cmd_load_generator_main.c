@@ -0,0 +1,206 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include "platform.h"
+#include "cmd_interface/cmd_interface.h"
+#include "cmd_interface/cerberus_protocol.h"
+#include "cmd_interface/device_manager.h"
+#include "cmd_interface/cmd_channel_loopback.h"
+#include "cmd_interface/cmd_load_generator.h"
+
+
+/**
+ * SMBus address of the device processing requests.
+ */
+#define	CMD_LOAD_GENERATOR_MAIN_DEVICE_ADDR			0x41
+
+
+/**
+ * Command handler that generates fixed responses for each request.  This removes the cost of
+ * command processing so the results measure the channel and MCTP layers.
+ */
+struct cmd_load_generator_main_handler {
+	struct cmd_interface base;				/**< The base command interface. */
+};
+
+
+/**
+ * Get the length of the response to generate for a command.  Certificates are large enough to
+ * require a multi-packet response.
+ *
+ * @param command The command being processed.
+ *
+ * @return The length of the response.
+ */
+static size_t cmd_load_generator_main_response_len (uint8_t command)
+{
+	switch (command) {
+		case CERBERUS_PROTOCOL_GET_DIGEST:
+			return sizeof (struct cerberus_protocol_header) + 2 + 32;
+
+		case CERBERUS_PROTOCOL_GET_CERTIFICATE:
+			return sizeof (struct cerberus_protocol_header) + 2 + 600;
+
+		case CERBERUS_PROTOCOL_ATTESTATION_CHALLENGE:
+			return sizeof (struct cerberus_protocol_header) + 80;
+
+		case CERBERUS_PROTOCOL_READ_LOG:
+			return sizeof (struct cerberus_protocol_header) + 200;
+
+		default:
+			return 0;
+	}
+}
+
+static int cmd_load_generator_main_process_request (struct cmd_interface *intf,
+	struct cmd_interface_request *request)
+{
+	struct cerberus_protocol_header *header = (struct cerberus_protocol_header*) request->data;
+
+	request->length = cmd_load_generator_main_response_len (header->command);
+	request->new_request = false;
+	request->crypto_timeout = false;
+
+	return 0;
+}
+
+/**
+ * Print the command line options for the tool.
+ *
+ * @param name The name of the executable.
+ */
+static void cmd_load_generator_main_usage (const char *name)
+{
+	fprintf (stderr, "Usage: %s [options]\n", name);
+	fprintf (stderr, "  -t <threads>    Number of concurrent requesters.\n");
+	fprintf (stderr, "  -n <requests>   Number of requests sent by each requester.\n");
+	fprintf (stderr, "  -w <d,c,ch,l,p> Relative weights for GET_DIGEST, GET_CERTIFICATE,\n");
+	fprintf (stderr, "                  CHALLENGE, READ_LOG, and PFM update requests.\n");
+	fprintf (stderr, "  -s <bytes>      Amount of data in each PFM update request.\n");
+	fprintf (stderr, "  -k <chunks>     Number of data requests in each PFM update.\n");
+	fprintf (stderr, "  -T <ms>         Time to wait for each response.\n");
+}
+
+/**
+ * Parse the request weights from the command line.
+ *
+ * @param arg The comma separated list of weights.
+ * @param config The configuration to update.
+ *
+ * @return 0 if the weights were parsed successfully or -1 if the list is not valid.
+ */
+static int cmd_load_generator_main_parse_weights (const char *arg,
+	struct cmd_load_generator_config *config)
+{
+	char *end;
+	int i;
+
+	for (i = 0; i < CMD_LOAD_GENERATOR_NUM_COMMANDS; i++) {
+		config->weight[i] = strtoul (arg, &end, 0);
+		if (end == arg) {
+			return -1;
+		}
+
+		if (i < (CMD_LOAD_GENERATOR_NUM_COMMANDS - 1)) {
+			if (*end != ',') {
+				return -1;
+			}
+			arg = end + 1;
+		}
+	}
+
+	return (*end == '\0') ? 0 : -1;
+}
+
+int main (int argc, char *argv[])
+{
+	struct cmd_load_generator_main_handler handler;
+	struct cmd_channel_loopback loopback;
+	struct device_manager device_mgr;
+	struct mctp_interface mctp;
+	struct cmd_load_generator_config config;
+	struct cmd_load_generator_results results;
+	int opt;
+	int status;
+
+	cmd_load_generator_default_config (&config);
+
+	while ((opt = getopt (argc, argv, "t:n:w:s:k:T:h")) != -1) {
+		switch (opt) {
+			case 't':
+				config.threads = strtol (optarg, NULL, 0);
+				break;
+
+			case 'n':
+				config.requests = strtoul (optarg, NULL, 0);
+				break;
+
+			case 'w':
+				if (cmd_load_generator_main_parse_weights (optarg, &config) != 0) {
+					cmd_load_generator_main_usage (argv[0]);
+					return 1;
+				}
+				break;
+
+			case 's':
+				config.pfm_chunk_len = strtoul (optarg, NULL, 0);
+				break;
+
+			case 'k':
+				config.pfm_chunks = strtoul (optarg, NULL, 0);
+				break;
+
+			case 'T':
+				config.response_timeout_ms = strtol (optarg, NULL, 0);
+				break;
+
+			default:
+				cmd_load_generator_main_usage (argv[0]);
+				return (opt == 'h') ? 0 : 1;
+		}
+	}
+
+	memset (&handler, 0, sizeof (handler));
+	handler.base.process_request = cmd_load_generator_main_process_request;
+
+	status = cmd_channel_loopback_init (&loopback, 0, CMD_LOAD_GENERATOR_MAIN_DEVICE_ADDR);
+	if (status != 0) {
+		fprintf (stderr, "Failed to initialize the loopback channel: 0x%x\n", status);
+		return 1;
+	}
+
+	status = device_manager_init (&device_mgr, 1, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE);
+	if (status != 0) {
+		fprintf (stderr, "Failed to initialize the device manager: 0x%x\n", status);
+		goto release_loopback;
+	}
+
+	status = mctp_interface_init (&mctp, &handler.base, &device_mgr, config.device_eid,
+		CERBERUS_PROTOCOL_MSFT_PCI_VID, CERBERUS_PROTOCOL_PROTOCOL_VERSION);
+	if (status != 0) {
+		fprintf (stderr, "Failed to initialize the MCTP layer: 0x%x\n", status);
+		goto release_device_mgr;
+	}
+
+	status = cmd_load_generator_run (&loopback, &mctp, &config, &results);
+	if (status == 0) {
+		cmd_load_generator_print_results (&results, stdout);
+	}
+	else {
+		fprintf (stderr, "Load generation failed: 0x%x\n", status);
+	}
+
+	mctp_interface_deinit (&mctp);
+release_device_mgr:
+	device_manager_release (&device_mgr);
+release_loopback:
+	cmd_channel_loopback_release (&loopback);
+
+	return (status == 0) ? 0 : 1;
+}